@@ -71,6 +71,30 @@ void KisGradientBenchmark::benchmarkGradient()
 }
 
 
+void KisGradientBenchmark::benchmarkRadialGradient()
+{
+    QBENCHMARK
+    {
+        QLinearGradient grad;
+        grad.setColorAt(0, Qt::white);
+        grad.setColorAt(1.0, Qt::red);
+        KoAbstractGradientSP kograd(KoStopGradient::fromQGradient(&grad));
+        Q_ASSERT(kograd);
+        KisGradientPainter fillPainter(m_device);
+        fillPainter.setGradient(kograd);
+
+        fillPainter.beginTransaction(kundo2_noi18n("Gradient Fill"));
+
+        fillPainter.setOpacityToUnit();
+        fillPainter.setCompositeOpId(COMPOSITE_OVER);
+        // exercises the vectorized radial run processing
+        fillPainter.setGradientShape(KisGradientPainter::GradientShapeRadial);
+        fillPainter.paintGradient(QPointF(GMP_IMAGE_WIDTH / 2, GMP_IMAGE_HEIGHT / 2), QPointF(GMP_IMAGE_WIDTH, GMP_IMAGE_HEIGHT), KisGradientPainter::GradientRepeatNone, 1.0, false, 0, 0, GMP_IMAGE_WIDTH, GMP_IMAGE_HEIGHT);
+
+        fillPainter.deleteTransaction();
+    }
+}
+
 void KisGradientBenchmark::cleanupTestCase()
 {
 
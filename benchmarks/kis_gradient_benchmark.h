@@ -30,6 +30,7 @@ private Q_SLOTS:
     void cleanupTestCase();
     
     void benchmarkGradient();
+    void benchmarkRadialGradient();
     
     
     
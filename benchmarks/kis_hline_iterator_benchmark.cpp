@@ -158,6 +158,27 @@ void KisHLineIteratorBenchmark::benchmarkConstNoMemCpy()
     }
 }
 
+void KisHLineIteratorBenchmark::benchmarkConstSpanIteration()
+{
+    KisPaintDeviceSP dev = new KisPaintDevice(m_colorSpace);
+    dev->fill(0, 0, TEST_IMAGE_WIDTH, TEST_IMAGE_HEIGHT, m_color->data());
+
+    const QRect rect(0, 0, TEST_IMAGE_WIDTH, TEST_IMAGE_HEIGHT);
+    const qint32 pixelSize = m_colorSpace->pixelSize();
+
+    QBENCHMARK{
+        quint32 sum = 0;
+        forEachConstSpan(dev, rect, [&] (const KisConstPixelSpan &span) {
+            const quint8 *ptr = span.data;
+            for (qint32 i = 0; i < span.nPixels; i++) {
+                sum += *ptr;
+                ptr += pixelSize;
+            }
+        });
+        Q_UNUSED(sum);
+    }
+}
+
 void KisHLineIteratorBenchmark::benchmarkTwoIteratorsNoMemCpy(){
     KoColor c(m_colorSpace);
     c.fromQColor(QColor(250,120,0));
@@ -44,6 +44,8 @@ private Q_SLOTS:
     void benchmarkConstNoMemCpy();
     // copy from one device to another
     void benchmarkTwoIteratorsNoMemCpy();
+    // span-based iteration with a per-pixel read inside each span
+    void benchmarkConstSpanIteration();
     
 
     
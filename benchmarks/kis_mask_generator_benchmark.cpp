@@ -10,6 +10,11 @@
 
 #include "kis_circle_mask_generator.h"
 #include "kis_rect_mask_generator.h"
+#include "kis_gauss_circle_mask_generator.h"
+#include "kis_curve_circle_mask_generator.h"
+#include "kis_gauss_rect_mask_generator.h"
+#include "kis_curve_rect_mask_generator.h"
+#include "kis_cubic_curve.h"
 
 void KisMaskGeneratorBenchmark::benchmarkCircle()
 {
@@ -33,7 +38,7 @@ void KisMaskGeneratorBenchmark::benchmarkCircle()
 #include "krita_utils.h"
 
 
-void benchmarkSIMD(qreal fade) {
+void benchmarkSIMDApplicator(KisMaskGenerator *gen) {
     const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
     KisFixedPaintDeviceSP dev = new KisFixedPaintDevice(cs);
     dev->setRect(QRect(0, 0, 1000, 1000));
@@ -43,9 +48,7 @@ void benchmarkSIMD(qreal fade) {
                             0.0, 1.0,
                             500, 500, 0);
 
-    KisCircleMaskGenerator gen(1000, 1.0, fade, fade, 2, false);
-
-    KisBrushMaskApplicatorBase *applicator = gen.applicator();
+    KisBrushMaskApplicatorBase *applicator = gen->applicator();
     applicator->initializeData(&data);
 
     QVector<QRect> rects = KritaUtils::splitRectIntoPatches(dev->bounds(), QSize(63, 63));
@@ -57,6 +60,11 @@ void benchmarkSIMD(qreal fade) {
     }
 }
 
+void benchmarkSIMD(qreal fade) {
+    KisCircleMaskGenerator gen(1000, 1.0, fade, fade, 2, false);
+    benchmarkSIMDApplicator(&gen);
+}
+
 void KisMaskGeneratorBenchmark::benchmarkSIMD_SharpBrush()
 {
     benchmarkSIMD(1.0);
@@ -81,4 +89,54 @@ void KisMaskGeneratorBenchmark::benchmarkSquare()
     }
 }
 
+void KisMaskGeneratorBenchmark::benchmarkCurveCircle()
+{
+    KisCurveCircleMaskGenerator gen(1000, 0.5, 0.5, 0.5, 3, KisCubicCurve(), true);
+    QBENCHMARK{
+        for(int i = -600; i < 600; ++i)
+        {
+            for(int j = -600; j < 600; ++j)
+            {
+                gen.valueAt(i, j);
+            }
+        }
+    }
+}
+
+/**
+ * The vectorized applicator benchmarks for the rest of the mask
+ * generator family; spikes == 2 and no supersampling keep all of
+ * them on the SIMD path, see shouldVectorize()
+ */
+
+void KisMaskGeneratorBenchmark::benchmarkSIMD_GaussCircle()
+{
+    KisGaussCircleMaskGenerator gen(1000, 1.0, 0.5, 0.5, 2, false);
+    benchmarkSIMDApplicator(&gen);
+}
+
+void KisMaskGeneratorBenchmark::benchmarkSIMD_CurveCircle()
+{
+    KisCurveCircleMaskGenerator gen(1000, 1.0, 0.5, 0.5, 2, KisCubicCurve(), false);
+    benchmarkSIMDApplicator(&gen);
+}
+
+void KisMaskGeneratorBenchmark::benchmarkSIMD_Rectangle()
+{
+    KisRectangleMaskGenerator gen(1000, 1.0, 0.5, 0.5, 2, false);
+    benchmarkSIMDApplicator(&gen);
+}
+
+void KisMaskGeneratorBenchmark::benchmarkSIMD_GaussRectangle()
+{
+    KisGaussRectangleMaskGenerator gen(1000, 1.0, 0.5, 0.5, 2, false);
+    benchmarkSIMDApplicator(&gen);
+}
+
+void KisMaskGeneratorBenchmark::benchmarkSIMD_CurveRectangle()
+{
+    KisCurveRectangleMaskGenerator gen(1000, 1.0, 0.5, 0.5, 2, KisCubicCurve(), false);
+    benchmarkSIMDApplicator(&gen);
+}
+
 SIMPLE_TEST_MAIN(KisMaskGeneratorBenchmark)
@@ -18,6 +18,12 @@ private Q_SLOTS:
     void benchmarkSIMD_FadedBrush();
     void benchmarkSquare();
 
+    void benchmarkCurveCircle();
+    void benchmarkSIMD_GaussCircle();
+    void benchmarkSIMD_CurveCircle();
+    void benchmarkSIMD_Rectangle();
+    void benchmarkSIMD_GaussRectangle();
+    void benchmarkSIMD_CurveRectangle();
 };
 
 #endif
@@ -0,0 +1,234 @@
+#!/usr/bin/env python3
+#
+# SPDX-FileCopyrightText: 2026 Krita contributors
+#
+# SPDX-License-Identifier: GPL-2.0-or-later
+#
+# Runs the curated benchmark matrix, collects the QTest benchmark
+# results into one machine-readable JSON file together with hardware
+# metadata, and optionally compares the run against a stored baseline.
+#
+# Typical usage:
+#
+#   # record a baseline on a known-good build
+#   ./krita_perf.py --build-dir <builddir>/benchmarks \
+#                   --output baseline.json
+#
+#   # gate a new build against it; exits non-zero on regression
+#   ./krita_perf.py --build-dir <builddir>/benchmarks \
+#                   --baseline baseline.json --threshold 0.10
+#
+# The `krita_perf` build target runs the script with the defaults.
+
+import argparse
+import datetime
+import json
+import os
+import platform
+import subprocess
+import sys
+import tempfile
+import xml.etree.ElementTree as ElementTree
+
+# The curated matrix. Each entry is the benchmark executable plus the
+# test functions to run; an empty list runs the whole executable. The
+# composition benchmark enumerates colorspace x depth x op by itself,
+# the rest cover the painting and tiles hot paths.
+BENCHMARK_MATRIX = [
+    ("KisCompositionBenchmark", [
+        "testRgb8CompositeOverOptimized",
+        "testRgb8CompositeAlphaDarkenOptimized",
+        "testRgb8CompositeCopyOptimized",
+        "testRgb16CompositeOverOptimized",
+        "testRgb16CompositeAlphaDarkenOptimized",
+        "testRgb16CompositeCopyOptimized",
+        "testRgbF32CompositeOverOptimized",
+        "testRgbF32CompositeAlphaDarkenOptimized",
+        "testRgbF32CompositeCopyOptimized",
+    ]),
+    ("KisDatamanagerBenchmark", []),
+    ("KisHLineIteratorBenchmark", []),
+    ("KisVLineIteratorBenchmark", []),
+    ("KisPainterBenchmark", []),
+    ("KisMaskGeneratorBenchmark", []),
+    ("KisStrokeBenchmark", []),
+]
+
+
+def hardware_metadata():
+    metadata = {
+        "hostname": platform.node(),
+        "platform": platform.platform(),
+        "machine": platform.machine(),
+        "logical_cpus": os.cpu_count(),
+        "timestamp": datetime.datetime.now().astimezone().isoformat(),
+    }
+
+    try:
+        with open("/proc/cpuinfo") as f:
+            for line in f:
+                if line.startswith("model name"):
+                    metadata["cpu_model"] = line.split(":", 1)[1].strip()
+                    break
+    except OSError:
+        pass
+
+    try:
+        pages = os.sysconf("SC_PHYS_PAGES")
+        page_size = os.sysconf("SC_PAGE_SIZE")
+        metadata["total_memory_mib"] = pages * page_size // (1024 * 1024)
+    except (ValueError, OSError):
+        pass
+
+    try:
+        metadata["git_revision"] = subprocess.check_output(
+            ["git", "rev-parse", "HEAD"],
+            cwd=os.path.dirname(os.path.abspath(__file__)),
+            stderr=subprocess.DEVNULL).decode().strip()
+    except (OSError, subprocess.CalledProcessError):
+        pass
+
+    return metadata
+
+
+def find_executable(build_dir, name):
+    for candidate in (os.path.join(build_dir, name),
+                      os.path.join(build_dir, "bin", name),
+                      os.path.join(build_dir, name + ".exe")):
+        if os.path.isfile(candidate) and os.access(candidate, os.X_OK):
+            return candidate
+    return None
+
+
+def parse_qtest_xml(xml_path, executable_name, results):
+    """Collects BenchmarkResult tags of one QTest XML report into
+    results, keyed as executable.function[:data tag]."""
+    tree = ElementTree.parse(xml_path)
+
+    for function in tree.getroot().iter("TestFunction"):
+        for benchmark in function.iter("BenchmarkResult"):
+            key = "%s.%s" % (executable_name, function.get("name"))
+            tag = benchmark.get("tag")
+            if tag and tag != function.get("name"):
+                key += ":" + tag
+
+            iterations = int(benchmark.get("iterations", "1"))
+            value = float(benchmark.get("value", "0"))
+
+            results[key] = {
+                "metric": benchmark.get("metric", "WalltimeMilliseconds"),
+                # QTest reports the total over all iterations
+                "value_per_iteration": value / max(iterations, 1),
+                "iterations": iterations,
+            }
+
+
+def run_benchmarks(build_dir, verbose):
+    results = {}
+    missing = []
+
+    for name, functions in BENCHMARK_MATRIX:
+        executable = find_executable(build_dir, name)
+        if not executable:
+            missing.append(name)
+            continue
+
+        with tempfile.NamedTemporaryFile(suffix=".xml", delete=False) as f:
+            xml_path = f.name
+
+        command = [executable, "-o", "%s,xml" % xml_path] + functions
+        print("running %s" % " ".join([name] + functions), flush=True)
+
+        try:
+            completed = subprocess.run(
+                command,
+                stdout=None if verbose else subprocess.DEVNULL,
+                stderr=None if verbose else subprocess.DEVNULL)
+            if completed.returncode != 0:
+                print("warning: %s exited with code %d"
+                      % (name, completed.returncode), file=sys.stderr)
+
+            parse_qtest_xml(xml_path, name, results)
+        except (OSError, ElementTree.ParseError) as e:
+            print("warning: skipping %s: %s" % (name, e), file=sys.stderr)
+        finally:
+            os.unlink(xml_path)
+
+    if missing:
+        print("warning: benchmarks not found in %s: %s"
+              % (build_dir, ", ".join(missing)), file=sys.stderr)
+
+    return results
+
+
+def compare_to_baseline(results, baseline, threshold):
+    regressions = []
+
+    for key, sample in sorted(results.items()):
+        reference = baseline.get("results", {}).get(key)
+        if not reference:
+            continue
+
+        old = reference["value_per_iteration"]
+        new = sample["value_per_iteration"]
+        if old <= 0:
+            continue
+
+        ratio = new / old
+        marker = ""
+        if ratio > 1.0 + threshold:
+            marker = "  REGRESSION"
+            regressions.append(key)
+        print("%-70s %10.4f -> %10.4f  (%+5.1f%%)%s"
+              % (key, old, new, (ratio - 1.0) * 100.0, marker))
+
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Run the curated Krita benchmark matrix")
+    parser.add_argument("--build-dir", default=".",
+                        help="directory containing the benchmark executables")
+    parser.add_argument("--output", default="krita_perf_results.json",
+                        help="where to write the results JSON")
+    parser.add_argument("--baseline",
+                        help="results JSON of a previous run to compare against")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="relative slowdown that counts as a regression "
+                             "(default: 0.10)")
+    parser.add_argument("--verbose", action="store_true",
+                        help="show the benchmark output")
+    args = parser.parse_args()
+
+    results = run_benchmarks(args.build_dir, args.verbose)
+    if not results:
+        print("error: no benchmark results collected", file=sys.stderr)
+        return 1
+
+    report = {
+        "metadata": hardware_metadata(),
+        "results": results,
+    }
+
+    with open(args.output, "w") as f:
+        json.dump(report, f, indent=2, sort_keys=True)
+        f.write("\n")
+    print("wrote %d results to %s" % (len(results), args.output))
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+
+        regressions = compare_to_baseline(results, baseline, args.threshold)
+        if regressions:
+            print("error: %d benchmark(s) regressed more than %.0f%%"
+                  % (len(regressions), args.threshold * 100.0),
+                  file=sys.stderr)
+            return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,37 @@
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Try to find the zstd compression library.
+#
+# This will define:
+#
+#   Zstd_FOUND        - system has zstd
+#   Zstd_INCLUDE_DIRS - the zstd include directories
+#   Zstd_LIBRARIES    - the libraries needed to use zstd
+
+find_package(PkgConfig QUIET)
+if(PKG_CONFIG_FOUND)
+    pkg_check_modules(PC_ZSTD QUIET libzstd)
+endif()
+
+find_path(Zstd_INCLUDE_DIR
+    NAMES zstd.h
+    HINTS ${PC_ZSTD_INCLUDEDIR} ${PC_ZSTD_INCLUDE_DIRS}
+)
+
+find_library(Zstd_LIBRARY
+    NAMES zstd
+    HINTS ${PC_ZSTD_LIBDIR} ${PC_ZSTD_LIBRARY_DIRS}
+)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(Zstd
+    REQUIRED_VARS Zstd_LIBRARY Zstd_INCLUDE_DIR
+    VERSION_VAR PC_ZSTD_VERSION
+)
+
+if(Zstd_FOUND)
+    set(Zstd_LIBRARIES ${Zstd_LIBRARY})
+    set(Zstd_INCLUDE_DIRS ${Zstd_INCLUDE_DIR})
+endif()
+
+mark_as_advanced(Zstd_INCLUDE_DIR Zstd_LIBRARY)
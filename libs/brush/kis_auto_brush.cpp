@@ -18,6 +18,10 @@
 #include <QBuffer>
 #include <QFile>
 #include <QFileInfo>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
 
 #include <KoColor.h>
 #include <KoColorSpace.h>
@@ -280,6 +284,34 @@ inline void fillPixelOptimized_general(quint8 *color, quint8 *buf, int size, int
     }
 }
 
+namespace {
+
+class MaskBandTask : public QRunnable
+{
+public:
+    MaskBandTask(KisBrushMaskApplicatorBase *applicator,
+                 const QRect &band,
+                 QSemaphore *doneSemaphore)
+        : m_applicator(applicator),
+          m_band(band),
+          m_doneSemaphore(doneSemaphore)
+    {
+        setAutoDelete(false);
+    }
+
+    void run() override {
+        m_applicator->process(m_band);
+        m_doneSemaphore->release();
+    }
+
+private:
+    KisBrushMaskApplicatorBase *m_applicator;
+    QRect m_band;
+    QSemaphore *m_doneSemaphore;
+};
+
+}
+
 void KisAutoBrush::generateMaskAndApplyMaskOrCreateDab(KisFixedPaintDeviceSP dst,
         KisBrush::ColoringInformation* coloringInformation,
         KisDabShape const& shape,
@@ -347,7 +379,55 @@ void KisAutoBrush::generateMaskAndApplyMaskOrCreateDab(KisFixedPaintDeviceSP dst
     const QRect rect(0, 0, dstWidth, dstHeight);
     KisBrushMaskApplicatorBase *applicator = d->shape->applicator();
     applicator->initializeData(&data);
-    applicator->process(rect);
+
+    /**
+     * For really big dabs a single dab no longer fits into one
+     * rendering job nicely, so split the mask into horizontal bands
+     * and process them on the global pool concurrently. The bands
+     * write into disjoint rows of the same buffer, so no
+     * synchronization except the final semaphore is needed. When
+     * randomness or density is active the applicator's random source
+     * is shared state, so we fall back to single-threaded rendering.
+     */
+
+    // below this band size the dispatch overhead eats the speedup
+    const qint64 minPixelsPerBand = 256 * 256;
+
+    const int numBands = qMin(qint64(d->idealThreadCountCached),
+                              qMin(qint64(dstHeight),
+                                   qint64(dstWidth) * dstHeight / minPixelsPerBand));
+
+    if (numBands < 2 ||
+        d->randomness != 0.0 || d->density != 1.0 ||
+        dst->bounds() != rect) {
+
+        applicator->process(rect);
+        return;
+    }
+
+    QSemaphore doneSemaphore;
+    const int bandHeight = (dstHeight + numBands - 1) / numBands;
+
+    QVector<MaskBandTask*> tasks;
+    for (int y = bandHeight; y < dstHeight; y += bandHeight) {
+        const QRect band(0, y, dstWidth, qMin(bandHeight, dstHeight - y));
+        tasks << new MaskBandTask(applicator, band, &doneSemaphore);
+    }
+
+    for (MaskBandTask *task : std::as_const(tasks)) {
+        if (!QThreadPool::globalInstance()->tryStart(task)) {
+            // The pool is saturated (or we are running on one of its
+            // worker threads already), so render the band in place
+            // instead of risking a deadlock on the semaphore
+            task->run();
+        }
+    }
+
+    // the first band is rendered in the calling thread
+    applicator->process(QRect(0, 0, dstWidth, qMin(bandHeight, dstHeight)));
+
+    doneSemaphore.acquire(tasks.size());
+    qDeleteAll(tasks);
 }
 
 void KisAutoBrush::notifyBrushIsGoingToBeClonedForStroke()
@@ -127,6 +127,7 @@ struct KisBrush::Private {
         , autoSpacingActive(false)
         , autoSpacingCoeff(1.0)
         , threadingAllowed(true)
+        , approximateTransformationsAllowed(false)
         , brushPyramid([] (const KisBrush* brush)
                        {
                            return new KisQImagePyramid(brush->brushTipImage());
@@ -149,6 +150,7 @@ struct KisBrush::Private {
           autoSpacingActive(rhs.autoSpacingActive),
           autoSpacingCoeff(rhs.autoSpacingCoeff),
           threadingAllowed(rhs.threadingAllowed),
+          approximateTransformationsAllowed(rhs.approximateTransformationsAllowed),
           brushTipImage(rhs.brushTipImage),
           /**
            * Be careful! The pyramid is shared between two brush objects,
@@ -190,6 +192,7 @@ struct KisBrush::Private {
     bool autoSpacingActive;
     qreal autoSpacingCoeff;
     bool threadingAllowed;
+    bool approximateTransformationsAllowed;
 
     QImage brushTipImage;
     mutable KisLazySharedCacheStorageLinked<KisQImagePyramid, const KisBrush*> brushPyramid;
@@ -600,7 +603,8 @@ void KisBrush::generateMaskAndApplyMaskOrCreateDab(KisFixedPaintDeviceSP dst,
     QImage outputImage = d->brushPyramid.value(this)->createImage(KisDabShape(
                                                                          shape.scale() * d->scale, shape.ratio(),
                                                                          -normalizeAngle(shape.rotation() + d->angle)),
-                                                                     subPixelX, subPixelY);
+                                                                     subPixelX, subPixelY,
+                                                                     d->approximateTransformationsAllowed);
 
     qint32 maskWidth = outputImage.width();
     qint32 maskHeight = outputImage.height();
@@ -700,7 +704,8 @@ KisFixedPaintDeviceSP KisBrush::paintDevice(const KoColorSpace * colorSpace,
     double scale = shape.scale() * d->scale;
 
     QImage outputImage = d->brushPyramid.value(this)->createImage(
-                KisDabShape(scale, shape.ratio(), -angle), subPixelX, subPixelY);
+                KisDabShape(scale, shape.ratio(), -angle), subPixelX, subPixelY,
+                d->approximateTransformationsAllowed);
 
     KisFixedPaintDeviceSP dab = new KisFixedPaintDevice(colorSpace);
     Q_CHECK_PTR(dab);
@@ -763,6 +768,16 @@ bool KisBrush::supportsCaching() const
     return true;
 }
 
+void KisBrush::setApproximateTransformationsAllowed(bool value)
+{
+    d->approximateTransformationsAllowed = value;
+}
+
+bool KisBrush::approximateTransformationsAllowed() const
+{
+    return d->approximateTransformationsAllowed;
+}
+
 void KisBrush::coldInitBrush()
 {
     d->brushPyramid.initialize(this);
@@ -338,6 +338,20 @@ public:
 
     virtual bool supportsCaching() const;
 
+    /**
+     * When enabled, the brush may render its dabs from a cache of
+     * prerotated tip images with the rotation angle and scale
+     * quantized, instead of resampling the tip for every dab. The dab
+     * cache sets this flag at the beginning of a dab fetch, depending
+     * on whether the active precision level tolerates such deviations
+     * (the exact precision level 5 keeps it disabled).
+     *
+     * The flag is a transient painting property like setScale() and
+     * setAngle(): it is not serialized to XML.
+     */
+    virtual void setApproximateTransformationsAllowed(bool value);
+    bool approximateTransformationsAllowed() const;
+
     virtual void coldInitBrush();
 
     static const QString brushTypeMetaDataKey;
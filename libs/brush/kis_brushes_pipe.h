@@ -75,6 +75,12 @@ public:
         }
     }
 
+    void setApproximateTransformationsAllowed(bool value) {
+        Q_FOREACH (QSharedPointer<BrushType> brush, m_brushes) {
+            brush->setApproximateTransformationsAllowed(value);
+        }
+    }
+
     void setSpacing(double spacing) {
         Q_FOREACH (QSharedPointer<BrushType> brush, m_brushes) {
             brush->setSpacing(spacing);
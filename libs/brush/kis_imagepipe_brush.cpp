@@ -492,6 +492,12 @@ void KisImagePipeBrush::setScale(qreal _scale)
     d->brushesPipe.setScale(_scale);
 }
 
+void KisImagePipeBrush::setApproximateTransformationsAllowed(bool value)
+{
+    KisGbrBrush::setApproximateTransformationsAllowed(value);
+    d->brushesPipe.setApproximateTransformationsAllowed(value);
+}
+
 void KisImagePipeBrush::setSpacing(double _spacing)
 {
     KisGbrBrush::setSpacing(_spacing);
@@ -6,6 +6,7 @@
 
 #include "kis_qimage_pyramid.h"
 
+#include <cmath>
 #include <limits>
 #include <QPainter>
 #include <kis_debug.h>
@@ -15,6 +16,12 @@
 
 #define QPAINTER_WORKAROUND_BORDER 1
 
+/**
+ * The budget for the prerotated tip images of one pyramid. The cost of
+ * a cache entry is measured in KiB.
+ */
+#define TRANSFORMED_TIP_CACHE_SIZE_KIB (16 * 1024)
+
 
 KisQImagePyramid::KisQImagePyramid(const QImage &baseImage, bool useSmoothingForEnlarging)
 {
@@ -257,11 +264,67 @@ QSize levelSize = image.size();
     m_levels.append(PyramidLevel(tmp, levelSize));
 }
 
+KisQImagePyramid::TransformedTipCache::TransformedTipCache()
+{
+    cache.setMaxCost(TRANSFORMED_TIP_CACHE_SIZE_KIB);
+}
+
 QImage KisQImagePyramid::createImage(KisDabShape const& shape,
-                                     qreal subPixelX, qreal subPixelY) const
+                                     qreal subPixelX, qreal subPixelY,
+                                     bool allowCachedTransform) const
 {
     if (m_levels.isEmpty()) return QImage();
 
+    if (!allowCachedTransform ||
+        shape.scale() <= 0.0 || shape.ratio() <= 0.005 ||
+        qIsNaN(shape.rotation())) {
+
+        return createImageImpl(shape, subPixelX, subPixelY);
+    }
+
+    const qreal angleStep = M_PI / 180.0;
+
+    TransformedTipKey key;
+    key.scaleBucket = qRound(std::log(shape.scale()) / std::log(1.02));
+    key.ratioBucket = qRound(shape.ratio() * 100.0);
+    key.angleBucket = qRound(shape.rotation() / angleStep);
+    key.subPixelXBucket = qRound(subPixelX * 2.0);
+    key.subPixelYBucket = qRound(subPixelY * 2.0);
+
+    {
+        QMutexLocker l(&m_transformedTipCache->mutex);
+        QImage *cachedImage = m_transformedTipCache->cache.object(key);
+        if (cachedImage) {
+            // QImage is implicitly shared, so returning a copy is cheap
+            return *cachedImage;
+        }
+    }
+
+    /**
+     * The image is rendered with the *quantized* parameters, so that
+     * it exactly matches its key and a later dab requesting a slightly
+     * different angle gets a consistently positioned image.
+     */
+    const KisDabShape quantizedShape(std::pow(1.02, key.scaleBucket),
+                                     key.ratioBucket / 100.0,
+                                     key.angleBucket * angleStep);
+
+    const QImage image = createImageImpl(quantizedShape,
+                                         key.subPixelXBucket * 0.5,
+                                         key.subPixelYBucket * 0.5);
+
+    const int cost = qMax(1, int(image.sizeInBytes() / 1024));
+
+    QMutexLocker l(&m_transformedTipCache->mutex);
+    m_transformedTipCache->cache.insert(key, new QImage(image), cost);
+
+    return image;
+}
+
+QImage KisQImagePyramid::createImageImpl(KisDabShape const& shape,
+                                         qreal subPixelX, qreal subPixelY) const
+{
+
     qreal baseScale = -1.0;
     int level = findNearestLevel(shape.scale(), &baseScale);
 
@@ -7,7 +7,10 @@
 #ifndef __KIS_QIMAGE_PYRAMID_H
 #define __KIS_QIMAGE_PYRAMID_H
 
+#include <QCache>
 #include <QImage>
+#include <QMutex>
+#include <QSharedPointer>
 #include <QVector>
 #include <kis_dab_shape.h>
 #include <kritabrush_export.h>
@@ -26,8 +29,21 @@ public:
 
     static QSizeF characteristicSize(const QSize &originalSize, KisDabShape const&);
 
+    /**
+     * Renders the tip image for the requested shape. When \p
+     * allowCachedTransform is true, the rotation angle, scale and
+     * subpixel shift are quantized and the resulting image is stored
+     * in (and possibly fetched from) a shared LRU cache, so that a
+     * stroke rotating the tip continuously reuses a limited set of
+     * prerotated images instead of resampling the tip for every dab.
+     * The quantization steps match the tolerances of the non-exact
+     * precision levels of the dab cache (1 degree, 2% of scale, half a
+     * pixel), so callers should only enable it when the active
+     * precision level accepts such deviations.
+     */
     QImage createImage(KisDabShape const&,
-                       qreal subPixelX, qreal subPixelY) const;
+                       qreal subPixelX, qreal subPixelY,
+                       bool allowCachedTransform = false) const;
 
     QImage getClosest(QTransform transform, qreal *scale) const;
 
@@ -38,6 +54,9 @@ private:
     int findNearestLevel(qreal scale, qreal *baseScale) const;
     void appendPyramidLevel(const QImage &image);
 
+    QImage createImageImpl(KisDabShape const& shape,
+                           qreal subPixelX, qreal subPixelY) const;
+
     static void calculateParams(KisDabShape const& shape,
                                 qreal subPixelX, qreal subPixelY,
                                 const QSize &originalSize,
@@ -62,6 +81,46 @@ private:
     };
 
     QVector<PyramidLevel> m_levels;
+
+    struct TransformedTipKey {
+        int scaleBucket = 0;
+        int ratioBucket = 0;
+        int angleBucket = 0;
+        int subPixelXBucket = 0;
+        int subPixelYBucket = 0;
+
+        friend bool operator==(const TransformedTipKey &lhs, const TransformedTipKey &rhs) {
+            return lhs.scaleBucket == rhs.scaleBucket &&
+                lhs.ratioBucket == rhs.ratioBucket &&
+                lhs.angleBucket == rhs.angleBucket &&
+                lhs.subPixelXBucket == rhs.subPixelXBucket &&
+                lhs.subPixelYBucket == rhs.subPixelYBucket;
+        }
+
+        friend uint qHash(const TransformedTipKey &key) {
+            return ::qHash(key.scaleBucket) ^
+                (::qHash(key.ratioBucket) << 7) ^
+                (::qHash(key.angleBucket) << 13) ^
+                (::qHash(key.subPixelXBucket) << 19) ^
+                (::qHash(key.subPixelYBucket) << 23);
+        }
+    };
+
+    /**
+     * The cache of prerotated tip images. It is kept behind a shared
+     * pointer because the pyramid itself is copyable (and is shared
+     * between the cloned brushes of one stroke), while QMutex and
+     * QCache are not. Copies of the pyramid share the same cache, in
+     * the same way as they share the (implicitly shared) level images.
+     */
+    struct TransformedTipCache {
+        TransformedTipCache();
+
+        QMutex mutex;
+        QCache<TransformedTipKey, QImage> cache;
+    };
+
+    QSharedPointer<TransformedTipCache> m_transformedTipCache {new TransformedTipCache()};
 };
 
 #endif /* __KIS_QIMAGE_PYRAMID_H */
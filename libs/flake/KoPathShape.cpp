@@ -179,11 +179,18 @@ void KoPathShape::paintPoints(KisHandlePainterHelper &handlesHelper)
 
 QRectF KoPathShape::outlineRect() const
 {
-    return outline().boundingRect();
+    if (!d->outlineIsCached) {
+        outline();
+    }
+    return d->cachedOutlineRect;
 }
 
 QPainterPath KoPathShape::outline() const
 {
+    if (d->outlineIsCached) {
+        return d->cachedOutline;
+    }
+
     QPainterPath path;
     for (auto subpathIt = d->subpaths.constBegin(); subpathIt != d->subpaths.constEnd(); ++subpathIt) {
         const KoSubpath * subpath = *subpathIt;
@@ -244,6 +251,12 @@ QPainterPath KoPathShape::outline() const
         }
     }
 
+    // QPainterPath is implicitly shared, so handing out the cached path
+    // by value doesn't copy the element data
+    d->cachedOutline = path;
+    d->cachedOutlineRect = path.boundingRect();
+    d->outlineIsCached = true;
+
     return path;
 }
 
@@ -1347,8 +1360,17 @@ void KoPathShape::recommendPointSelectionChange(const QList<KoPathPointIndex> &n
     }
 }
 
+void KoPathShape::notifyChanged()
+{
+    // the points were moved directly through KoPathPoint's setters
+    d->outlineIsCached = false;
+    KoShape::notifyChanged();
+}
+
 void KoPathShape::notifyPointsChanged()
 {
+    d->outlineIsCached = false;
+
     Q_FOREACH (KoShape::ShapeChangeListener *listener, listeners()) {
         PointSelectionChangeListener *pointListener = dynamic_cast<PointSelectionChangeListener*>(listener);
         if (pointListener) {
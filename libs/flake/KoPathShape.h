@@ -86,6 +86,8 @@ public:
     QRectF boundingRect() const override;
     /// reimplemented
     QSizeF size() const override;
+    /// reimplemented, drops the cached outline
+    void notifyChanged() override;
 
     QPainterPath pathStroke(const QPen &pen) const;
     /**
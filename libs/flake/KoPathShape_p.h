@@ -40,6 +40,13 @@ public:
 
     KoSubpathList subpaths;
 
+    /// Cached result of KoPathShape::outline() and its bounding rect.
+    /// Invalidated whenever the points change, see
+    /// KoPathShape::notifyPointsChanged() and KoPathShape::notifyChanged().
+    mutable QPainterPath cachedOutline;
+    mutable QRectF cachedOutlineRect;
+    mutable bool outlineIsCached {false};
+
     QMap<KoFlake::MarkerPosition, QExplicitlySharedDataPointer<KoMarker>> markersNew;
     bool autoFillMarkers;
 };
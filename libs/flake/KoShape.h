@@ -954,8 +954,11 @@ public:
 
     /**
      * Update the position of the shape in the tree of the KoShapeManager.
+     *
+     * Subclasses that cache geometry-derived data should reimplement
+     * this to drop their caches (and call the base implementation).
      */
-    void notifyChanged();
+    virtual void notifyChanged();
 
     /**
      * A shape can be in a state that it is doing processing data like loading or text layout.
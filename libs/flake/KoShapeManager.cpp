@@ -487,8 +487,27 @@ void KoShapeManager::preparePaintJobs(PaintJobsOrder &jobsOrder,
 
     QMutexLocker l1(&d->shapesMutex);
 
+    /**
+     * Clone only the subtrees that can actually show up in one of the
+     * requested update rects. Every shape a job may reference is found
+     * through the same r-tree query below, so culling the clone set by
+     * the union of the damage rects cannot lose shapes, while documents
+     * with many shapes no longer pay for cloning all of them on every
+     * small update.
+     */
+    QRectF unionDocUpdateRect;
+    for (auto it = std::begin(jobsOrder.jobs); it != std::end(jobsOrder.jobs); ++it) {
+        unionDocUpdateRect |= it->docUpdateRect;
+    }
+
+    QList<KoShape*> shapesInUpdateRect;
+    {
+        QMutexLocker l(&d->treeMutex);
+        shapesInUpdateRect = d->tree.intersects(unionDocUpdateRect);
+    }
+
     QSet<KoShape*> rootShapesSet;
-    Q_FOREACH (KoShape *shape, d->shapes) {
+    Q_FOREACH (KoShape *shape, shapesInUpdateRect) {
         while (shape->parent() && shape->parent() != excludeRoot) {
             shape = shape->parent();
         }
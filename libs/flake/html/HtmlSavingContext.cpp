@@ -30,6 +30,8 @@ HtmlSavingContext::HtmlSavingContext(QIODevice &shapeDevice)
 
 HtmlSavingContext::~HtmlSavingContext()
 {
+    // the writer buffers its output, push it into the QBuffer
+    d->shapeWriter->flush();
     d->shapeDevice->write(d->shapeBuffer.data());
 }
 
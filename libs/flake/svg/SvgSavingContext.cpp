@@ -74,6 +74,10 @@ SvgSavingContext::~SvgSavingContext()
 {
     d->styleWriter->endElement();
 
+    // the writers buffer their output, push it into the QBuffers
+    d->styleWriter->flush();
+    d->shapeWriter->flush();
+
     if (d->styleDevice) {
         d->styleDevice->write(d->styleBuffer.data());
     } else {
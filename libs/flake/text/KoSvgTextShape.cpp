@@ -902,6 +902,11 @@ void KoSvgTextShape::setPropertiesAtPos(int pos, KoSvgTextProperties properties)
 {
     if (pos < 0 || d->cursorPos.isEmpty()) {
         if (KisForestDetail::size(d->textData)) {
+            if (d->textData.childBegin()->properties == properties) {
+                // setting the same properties again would only trigger
+                // a full (and expensive) relayout of the text
+                return;
+            }
             d->textData.childBegin()->properties = properties;
         }
         notifyChanged();
@@ -912,7 +917,7 @@ void KoSvgTextShape::setPropertiesAtPos(int pos, KoSvgTextProperties properties)
     CharacterResult res = d->result.at(cursorPos.cluster);
     int currentIndex = 0;
     auto it = d->findTextContentElementForIndex(d->textData, currentIndex, res.plaintTextIndex);
-    if (it != d->textData.depthFirstTailEnd()) {
+    if (it != d->textData.depthFirstTailEnd() && !(it->properties == properties)) {
         it->properties = properties;
         notifyChanged();
         shapeChangedPriv(ContentChanged);
@@ -925,16 +930,23 @@ void KoSvgTextShape::mergePropertiesIntoRange(const int startPos,
                                               const QSet<KoSvgTextProperties::PropertyId> removeProperties)
 {
     if ((startPos < 0 && startPos == endPos) || d->cursorPos.isEmpty()) {
+        bool rootChanged = false;
         if (KisForestDetail::size(d->textData)) {
+            const KoSvgTextProperties oldProperties = d->textData.childBegin()->properties;
             Q_FOREACH(KoSvgTextProperties::PropertyId p, properties.properties()) {
                 d->textData.childBegin()->properties.setProperty(p, properties.property(p));
             }
             Q_FOREACH(KoSvgTextProperties::PropertyId p, removeProperties) {
                 d->textData.childBegin()->properties.removeProperty(p);
             }
+            rootChanged = !(d->textData.childBegin()->properties == oldProperties);
+        }
+        // only relayout when the properties actually changed; tools
+        // often re-apply the current values
+        if (rootChanged) {
+            notifyChanged();
+            shapeChangedPriv(ContentChanged);
         }
-        notifyChanged();
-        shapeChangedPriv(ContentChanged);
         return;
     }
     const int startIndex = d->cursorPos.at(startPos).index;
@@ -953,6 +965,8 @@ void KoSvgTextShape::mergePropertiesIntoRange(const int startPos,
         }
 
         if (currentIndex >= startIndex && currentIndex < endIndex) {
+            const KoSvgTextProperties oldElementProperties = it->properties;
+            const KoSvgTextProperties oldRootProperties = d->textData.childBegin()->properties;
             Q_FOREACH(KoSvgTextProperties::PropertyId p, removeProperties) {
                 if (KoSvgTextProperties::propertyIsBlockOnly(p)) {
                     d->textData.childBegin()->properties.removeProperty(p);
@@ -968,7 +982,11 @@ void KoSvgTextShape::mergePropertiesIntoRange(const int startPos,
                 }
             }
 
-            changed = true;
+            // re-applying the values a range already has should not
+            // count as a change, otherwise every sync from the text
+            // tool forces a full relayout
+            changed = changed || !(it->properties == oldElementProperties)
+                    || !(d->textData.childBegin()->properties == oldRootProperties);
         }
         currentIndex += it->numChars(false);
     }
@@ -983,6 +1001,10 @@ void KoSvgTextShape::mergePropertiesIntoRange(const int startPos,
         if (properties.hasProperty(KoSvgTextProperties::StrokeId)) {
             shapeChangedPriv(StrokeChanged);
         }
+    } else if (startIndex != endIndex) {
+        // merge back the elements split at the start of this function;
+        // nothing about them changed
+        KoSvgTextShape::Private::cleanUp(d->textData);
     }
 }
 
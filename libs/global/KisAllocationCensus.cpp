@@ -0,0 +1,178 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisAllocationCensus.h"
+
+#include <atomic>
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QGlobalStatic>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QVector>
+
+Q_GLOBAL_STATIC(KisAllocationCensus, s_instance)
+
+namespace {
+
+/**
+ * Only every Nth event per thread is recorded; the recorded event
+ * then counts for N events of its size. Keeping the counter and the
+ * tag thread-local means the hot path takes no lock at all for the
+ * skipped events.
+ */
+constexpr int samplingFactor = 16;
+
+struct ThreadState {
+    int skipCounter = 0;
+    QString tag;
+};
+
+thread_local ThreadState threadState;
+
+const char *categoryNames[KisAllocationCensus::NumCategories] = {
+    "fixedPaintDevice",
+    "paintDevice",
+    "colorConversion"
+};
+
+} // namespace
+
+struct Q_DECL_HIDDEN KisAllocationCensus::Private
+{
+    Private()
+    {
+        dumpFileName =
+            QString::fromLocal8Bit(qgetenv("KRITA_ALLOCATION_CENSUS"));
+        enabled = !dumpFileName.isEmpty();
+        sessionTimer.start();
+    }
+
+    QString dumpFileName;
+    std::atomic<bool> enabled {false};
+    QElapsedTimer sessionTimer;
+
+    mutable QMutex mutex;
+    QHash<QString, QVector<Counters>> aggregatedCounters;
+};
+
+KisAllocationCensus::Scope::Scope(const QString &tag)
+{
+    if (tag.isEmpty() || !KisAllocationCensus::instance()->isEnabled()) return;
+
+    m_active = true;
+    m_previousTag = threadState.tag;
+    threadState.tag = tag;
+}
+
+KisAllocationCensus::Scope::~Scope()
+{
+    if (!m_active) return;
+
+    threadState.tag = m_previousTag;
+}
+
+KisAllocationCensus::KisAllocationCensus()
+    : m_d(new Private)
+{
+}
+
+KisAllocationCensus::~KisAllocationCensus()
+{
+    if (m_d->enabled && !m_d->dumpFileName.isEmpty()) {
+        dumpJson(m_d->dumpFileName);
+    }
+    delete m_d;
+}
+
+KisAllocationCensus* KisAllocationCensus::instance()
+{
+    return s_instance;
+}
+
+bool KisAllocationCensus::isEnabled() const
+{
+    return m_d->enabled.load(std::memory_order_relaxed);
+}
+
+void KisAllocationCensus::setEnabled(bool value)
+{
+    m_d->enabled.store(value, std::memory_order_relaxed);
+}
+
+void KisAllocationCensus::recordAllocation(Category category, qint64 bytes)
+{
+    if (!isEnabled()) return;
+
+    if (++threadState.skipCounter < samplingFactor) return;
+    threadState.skipCounter = 0;
+
+    const QString tag = !threadState.tag.isEmpty() ?
+        threadState.tag : QStringLiteral("untagged");
+
+    QMutexLocker locker(&m_d->mutex);
+
+    QVector<Counters> &counters = m_d->aggregatedCounters[tag];
+    if (counters.isEmpty()) {
+        counters.resize(NumCategories);
+    }
+
+    counters[category].events += samplingFactor;
+    counters[category].bytes += bytes * samplingFactor;
+}
+
+QMap<QString, QVector<KisAllocationCensus::Counters>> KisAllocationCensus::aggregatedCounters() const
+{
+    QMutexLocker locker(&m_d->mutex);
+
+    QMap<QString, QVector<Counters>> result;
+    for (auto it = m_d->aggregatedCounters.constBegin();
+         it != m_d->aggregatedCounters.constEnd(); ++it) {
+
+        result.insert(it.key(), it.value());
+    }
+    return result;
+}
+
+bool KisAllocationCensus::dumpJson(const QString &fileName) const
+{
+    const QMap<QString, QVector<Counters>> aggregated = aggregatedCounters();
+    const qreal sessionSecs =
+        qMax<qreal>(m_d->sessionTimer.nsecsElapsed() / 1e9, 1e-3);
+
+    QJsonObject tags;
+    for (auto it = aggregated.constBegin(); it != aggregated.constEnd(); ++it) {
+        QJsonObject tag;
+        for (int i = 0; i < NumCategories; i++) {
+            const Counters &counters = it.value()[i];
+
+            QJsonObject category;
+            category["events"] = counters.events;
+            category["bytes"] = counters.bytes;
+            category["bytesPerSecond"] =
+                qint64(counters.bytes / sessionSecs);
+            tag[categoryNames[i]] = category;
+        }
+        tags[it.key()] = tag;
+    }
+
+    QJsonObject root;
+    root["samplingFactor"] = samplingFactor;
+    root["sessionSecs"] = sessionSecs;
+    root["tags"] = tags;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    file.write(QJsonDocument(root).toJson());
+    return true;
+}
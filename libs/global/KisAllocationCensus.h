@@ -0,0 +1,94 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_ALLOCATION_CENSUS_H
+#define KIS_ALLOCATION_CENSUS_H
+
+#include <kritaglobal_export.h>
+
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+/**
+ * Counts the temporary allocations that are invisible in release
+ * builds: fixed paint device buffers, paint device creations and
+ * KoColor conversions. The events are tagged with the name of the
+ * enclosing scope (usually the stroke strategy running on the worker
+ * thread), so the census can tell which brush or filter is churning
+ * the temporaries.
+ *
+ * The recording is sampled: only every Nth event per thread takes the
+ * aggregation lock, and its size is scaled by the sampling factor, so
+ * the reported byte counts are an estimate. The census is disabled by
+ * default; set the KRITA_ALLOCATION_CENSUS environment variable to the
+ * name of an output file to enable it. The aggregated census is dumped
+ * into that file as JSON when the application exits, including a
+ * bytes-per-second rate over the session.
+ */
+class KRITAGLOBAL_EXPORT KisAllocationCensus
+{
+public:
+    enum Category {
+        FixedPaintDevice = 0,
+        PaintDevice,
+        ColorConversion,
+
+        NumCategories
+    };
+
+    struct Counters {
+        /// estimated from the sampled events, see the class comment
+        qint64 events = 0;
+        qint64 bytes = 0;
+    };
+
+    /**
+     * Tags the allocations made by the current thread for the lifetime
+     * of the scope. Scopes nest; the innermost tag wins. A no-op when
+     * the census is disabled or the tag is empty.
+     */
+    class KRITAGLOBAL_EXPORT Scope
+    {
+    public:
+        Scope(const QString &tag);
+        ~Scope();
+
+    private:
+        bool m_active {false};
+        QString m_previousTag;
+    };
+
+public:
+    KisAllocationCensus();
+    ~KisAllocationCensus();
+    static KisAllocationCensus* instance();
+
+    bool isEnabled() const;
+    void setEnabled(bool value);
+
+    /**
+     * Records an allocation of \p bytes in the given category under
+     * the current thread's scope tag. Sampled; safe to call from the
+     * hot paths of multiple threads concurrently. A no-op when the
+     * census is disabled.
+     */
+    void recordAllocation(Category category, qint64 bytes);
+
+    /// Returns the aggregated counters keyed by scope tag
+    QMap<QString, QVector<Counters>> aggregatedCounters() const;
+
+    /**
+     * Dumps the aggregated census into \p fileName as JSON
+     */
+    bool dumpJson(const QString &fileName) const;
+
+private:
+    struct Private;
+    Private * const m_d;
+};
+
+#endif /* KIS_ALLOCATION_CENSUS_H */
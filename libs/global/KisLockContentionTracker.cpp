@@ -0,0 +1,144 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisLockContentionTracker.h"
+
+#include <atomic>
+
+#include <QFile>
+#include <QGlobalStatic>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+Q_GLOBAL_STATIC(KisLockContentionTracker, s_instance)
+
+namespace {
+
+const char *siteNames[KisLockContentionTracker::NumSites] = {
+    "imageBarrier",
+    "tileTableIteratorRead",
+    "tileTableIteratorWrite",
+    "strokesQueue"
+};
+
+} // namespace
+
+struct Q_DECL_HIDDEN KisLockContentionTracker::Private
+{
+    Private()
+    {
+        dumpFileName =
+            QString::fromLocal8Bit(qgetenv("KRITA_LOCK_CONTENTION"));
+        enabled = !dumpFileName.isEmpty();
+        sessionTimer.start();
+    }
+
+    QString dumpFileName;
+    std::atomic<bool> enabled {false};
+    QElapsedTimer sessionTimer;
+
+    std::atomic<qint64> acquisitions[NumSites] {};
+    std::atomic<qint64> contendedAcquisitions[NumSites] {};
+    std::atomic<qint64> totalWaitUsecs[NumSites] {};
+    std::atomic<qint64> maxWaitUsecs[NumSites] {};
+};
+
+KisLockContentionTracker::KisLockContentionTracker()
+    : m_d(new Private)
+{
+}
+
+KisLockContentionTracker::~KisLockContentionTracker()
+{
+    if (m_d->enabled && !m_d->dumpFileName.isEmpty()) {
+        dumpJson(m_d->dumpFileName);
+    }
+    delete m_d;
+}
+
+KisLockContentionTracker* KisLockContentionTracker::instance()
+{
+    return s_instance;
+}
+
+bool KisLockContentionTracker::isEnabled() const
+{
+    return m_d->enabled.load(std::memory_order_relaxed);
+}
+
+void KisLockContentionTracker::setEnabled(bool value)
+{
+    m_d->enabled.store(value, std::memory_order_relaxed);
+}
+
+void KisLockContentionTracker::recordAcquisition(Site site, qint64 waitUsecs, bool contended)
+{
+    m_d->acquisitions[site].fetch_add(1, std::memory_order_relaxed);
+
+    if (!contended) return;
+
+    m_d->contendedAcquisitions[site].fetch_add(1, std::memory_order_relaxed);
+    m_d->totalWaitUsecs[site].fetch_add(waitUsecs, std::memory_order_relaxed);
+
+    qint64 knownMax = m_d->maxWaitUsecs[site].load(std::memory_order_relaxed);
+    while (waitUsecs > knownMax &&
+           !m_d->maxWaitUsecs[site].compare_exchange_weak(
+               knownMax, waitUsecs, std::memory_order_relaxed)) {
+    }
+}
+
+QVector<KisLockContentionTracker::SiteStats> KisLockContentionTracker::stats() const
+{
+    QVector<SiteStats> result;
+    result.resize(NumSites);
+
+    for (int i = 0; i < NumSites; i++) {
+        result[i].acquisitions =
+            m_d->acquisitions[i].load(std::memory_order_relaxed);
+        result[i].contendedAcquisitions =
+            m_d->contendedAcquisitions[i].load(std::memory_order_relaxed);
+        result[i].totalWaitUsecs =
+            m_d->totalWaitUsecs[i].load(std::memory_order_relaxed);
+        result[i].maxWaitUsecs =
+            m_d->maxWaitUsecs[i].load(std::memory_order_relaxed);
+    }
+
+    return result;
+}
+
+bool KisLockContentionTracker::dumpJson(const QString &fileName) const
+{
+    const QVector<SiteStats> recordedStats = stats();
+    const qreal sessionSecs =
+        qMax<qreal>(m_d->sessionTimer.nsecsElapsed() / 1e9, 1e-3);
+
+    QJsonObject sites;
+    for (int i = 0; i < NumSites; i++) {
+        const SiteStats &siteStats = recordedStats[i];
+
+        QJsonObject site;
+        site["acquisitions"] = siteStats.acquisitions;
+        site["contendedAcquisitions"] = siteStats.contendedAcquisitions;
+        site["totalWaitUsecs"] = siteStats.totalWaitUsecs;
+        site["maxWaitUsecs"] = siteStats.maxWaitUsecs;
+        site["avgWaitUsecs"] =
+            siteStats.contendedAcquisitions > 0 ?
+            qreal(siteStats.totalWaitUsecs) / siteStats.contendedAcquisitions : 0.0;
+        sites[siteNames[i]] = site;
+    }
+
+    QJsonObject root;
+    root["sessionSecs"] = sessionSecs;
+    root["sites"] = sites;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    file.write(QJsonDocument(root).toJson());
+    return true;
+}
@@ -0,0 +1,175 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_LOCK_CONTENTION_TRACKER_H
+#define KIS_LOCK_CONTENTION_TRACKER_H
+
+#include <kritaglobal_export.h>
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QReadWriteLock>
+#include <QString>
+#include <QVector>
+
+/**
+ * Measures how long the threads wait on the locks that serialize the
+ * scheduler: the image barrier lock, the iterator lock of the tile
+ * hash table (the table itself is lock-free, the iterator lock is the
+ * only blocking lock left on that path) and the strokes queue mutex.
+ *
+ * The instrumented call sites first try a non-blocking acquisition;
+ * only when that fails is a timer started around the blocking call, so
+ * the uncontended fast path pays nothing but a counter increment. The
+ * counters themselves are relaxed atomics, so reporting takes no lock
+ * either. Tracking is disabled by default; set the
+ * KRITA_LOCK_CONTENTION environment variable to the name of an output
+ * file to enable it. The per-site wait statistics are dumped into that
+ * file as JSON when the application exits.
+ */
+class KRITAGLOBAL_EXPORT KisLockContentionTracker
+{
+public:
+    enum Site {
+        ImageBarrier = 0,
+        TileTableIteratorRead,
+        TileTableIteratorWrite,
+        StrokesQueue,
+
+        NumSites
+    };
+
+    struct SiteStats {
+        qint64 acquisitions = 0;
+        qint64 contendedAcquisitions = 0;
+        qint64 totalWaitUsecs = 0;
+        qint64 maxWaitUsecs = 0;
+    };
+
+public:
+    KisLockContentionTracker();
+    ~KisLockContentionTracker();
+    static KisLockContentionTracker* instance();
+
+    bool isEnabled() const;
+    void setEnabled(bool value);
+
+    /**
+     * Reports one acquisition of the lock guarding \p site. Called by
+     * the tracked lock helpers below; safe to call from multiple
+     * threads concurrently.
+     */
+    void recordAcquisition(Site site, qint64 waitUsecs, bool contended);
+
+    /// Returns the aggregated statistics, indexed by Site
+    QVector<SiteStats> stats() const;
+
+    /**
+     * Dumps the aggregated statistics into \p fileName as JSON
+     */
+    bool dumpJson(const QString &fileName) const;
+
+public:
+    /**
+     * Blocking acquisitions that report their wait to the tracker.
+     * When tracking is disabled they degrade to the plain blocking
+     * call behind a single relaxed atomic load.
+     */
+    static void lockTracked(QMutex *mutex, Site site) {
+        KisLockContentionTracker *tracker = instance();
+
+        if (!tracker->isEnabled()) {
+            mutex->lock();
+        } else if (mutex->tryLock()) {
+            tracker->recordAcquisition(site, 0, false);
+        } else {
+            QElapsedTimer timer;
+            timer.start();
+            mutex->lock();
+            tracker->recordAcquisition(site, timer.nsecsElapsed() / 1000, true);
+        }
+    }
+
+    static void lockForReadTracked(QReadWriteLock *lock, Site site) {
+        KisLockContentionTracker *tracker = instance();
+
+        if (!tracker->isEnabled()) {
+            lock->lockForRead();
+        } else if (lock->tryLockForRead()) {
+            tracker->recordAcquisition(site, 0, false);
+        } else {
+            QElapsedTimer timer;
+            timer.start();
+            lock->lockForRead();
+            tracker->recordAcquisition(site, timer.nsecsElapsed() / 1000, true);
+        }
+    }
+
+    static void lockForWriteTracked(QReadWriteLock *lock, Site site) {
+        KisLockContentionTracker *tracker = instance();
+
+        if (!tracker->isEnabled()) {
+            lock->lockForWrite();
+        } else if (lock->tryLockForWrite()) {
+            tracker->recordAcquisition(site, 0, false);
+        } else {
+            QElapsedTimer timer;
+            timer.start();
+            lock->lockForWrite();
+            tracker->recordAcquisition(site, timer.nsecsElapsed() / 1000, true);
+        }
+    }
+
+private:
+    struct Private;
+    Private * const m_d;
+};
+
+/**
+ * A drop-in replacement for QMutexLocker that reports the wait to
+ * KisLockContentionTracker
+ */
+class KisTrackedMutexLocker
+{
+public:
+    KisTrackedMutexLocker(QMutex *mutex, KisLockContentionTracker::Site site)
+        : m_mutex(mutex)
+    {
+        KisLockContentionTracker::lockTracked(mutex, site);
+    }
+
+    ~KisTrackedMutexLocker() {
+        m_mutex->unlock();
+    }
+
+private:
+    Q_DISABLE_COPY(KisTrackedMutexLocker)
+    QMutex *m_mutex;
+};
+
+/**
+ * A drop-in replacement for QReadLocker that reports the wait to
+ * KisLockContentionTracker
+ */
+class KisTrackedReadLocker
+{
+public:
+    KisTrackedReadLocker(QReadWriteLock *lock, KisLockContentionTracker::Site site)
+        : m_lock(lock)
+    {
+        KisLockContentionTracker::lockForReadTracked(lock, site);
+    }
+
+    ~KisTrackedReadLocker() {
+        m_lock->unlock();
+    }
+
+private:
+    Q_DISABLE_COPY(KisTrackedReadLocker)
+    QReadWriteLock *m_lock;
+};
+
+#endif /* KIS_LOCK_CONTENTION_TRACKER_H */
@@ -0,0 +1,224 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisStrokeLatencyTracer.h"
+
+#include <atomic>
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "kis_assert.h"
+
+Q_GLOBAL_STATIC(KisStrokeLatencyTracer, s_instance)
+
+namespace {
+const char* stageNames[] = {
+    "tablet-event",
+    "dab-queued",
+    "merge-completed",
+    "texture-uploaded",
+    "frame-presented"
+};
+}
+
+struct Q_DECL_HIDDEN KisStrokeLatencyTracer::Private
+{
+    Private()
+    {
+        events.resize(eventsCapacity);
+        timer.start();
+
+        dumpFileName =
+            QString::fromLocal8Bit(qgetenv("KRITA_TRACE_STROKE_LATENCY"));
+        enabled = !dumpFileName.isEmpty();
+    }
+
+    static constexpr int eventsCapacity = 1 << 16;
+
+    QElapsedTimer timer;
+    QString dumpFileName;
+
+    std::atomic<bool> enabled {false};
+    std::atomic<qint64> lastSampleId {0};
+    std::atomic<qint64> watermarks[NumStages] {};
+
+    QVector<Event> events;
+    std::atomic<quint64> eventsHead {0};
+
+    void record(int stage, qint64 sampleId) {
+        Event event;
+        event.sampleId = sampleId;
+        event.stage = stage;
+        event.timeUsecs = timer.nsecsElapsed() / 1000;
+
+        const quint64 index =
+            eventsHead.fetch_add(1, std::memory_order_relaxed);
+        events[index % eventsCapacity] = event;
+    }
+};
+
+KisStrokeLatencyTracer::KisStrokeLatencyTracer()
+    : m_d(new Private)
+{
+}
+
+KisStrokeLatencyTracer::~KisStrokeLatencyTracer()
+{
+    if (m_d->enabled && !m_d->dumpFileName.isEmpty()) {
+        dumpChromeTraceJson(m_d->dumpFileName);
+    }
+    delete m_d;
+}
+
+KisStrokeLatencyTracer* KisStrokeLatencyTracer::instance()
+{
+    return s_instance;
+}
+
+bool KisStrokeLatencyTracer::isEnabled() const
+{
+    return m_d->enabled.load(std::memory_order_relaxed);
+}
+
+void KisStrokeLatencyTracer::setEnabled(bool value)
+{
+    m_d->enabled.store(value, std::memory_order_relaxed);
+}
+
+qint64 KisStrokeLatencyTracer::traceSampleIngested()
+{
+    if (!isEnabled()) return -1;
+
+    const qint64 sampleId =
+        m_d->lastSampleId.fetch_add(1, std::memory_order_relaxed) + 1;
+
+    m_d->watermarks[TabletEvent].store(sampleId, std::memory_order_relaxed);
+    m_d->record(TabletEvent, sampleId);
+
+    return sampleId;
+}
+
+void KisStrokeLatencyTracer::traceStage(Stage stage)
+{
+    if (!isEnabled()) return;
+
+    KIS_SAFE_ASSERT_RECOVER_RETURN(stage > TabletEvent && stage < NumStages);
+
+    const qint64 watermark =
+        m_d->watermarks[stage - 1].load(std::memory_order_relaxed);
+
+    m_d->watermarks[stage].store(watermark, std::memory_order_relaxed);
+    m_d->record(stage, watermark);
+}
+
+QVector<KisStrokeLatencyTracer::Event> KisStrokeLatencyTracer::events() const
+{
+    const quint64 head = m_d->eventsHead.load(std::memory_order_relaxed);
+    const quint64 count = qMin<quint64>(head, Private::eventsCapacity);
+
+    QVector<Event> result;
+    result.reserve(count);
+
+    for (quint64 i = head - count; i < head; i++) {
+        result << m_d->events[i % Private::eventsCapacity];
+    }
+
+    return result;
+}
+
+bool KisStrokeLatencyTracer::dumpChromeTraceJson(const QString &fileName) const
+{
+    const QVector<Event> recordedEvents = events();
+
+    QJsonArray traceEvents;
+
+    /**
+     * One track per pipeline stage, with an instant event for every
+     * recorded timestamp. The watermark is attached as an argument so
+     * the raw stream stays inspectable.
+     */
+    Q_FOREACH (const Event &event, recordedEvents) {
+        QJsonObject object;
+        object["name"] = stageNames[qBound<int>(0, event.stage, NumStages - 1)];
+        object["ph"] = "i";
+        object["s"] = "t";
+        object["pid"] = 1;
+        object["tid"] = event.stage + 1;
+        object["ts"] = event.timeUsecs;
+
+        QJsonObject args;
+        args["sample"] = event.sampleId;
+        object["args"] = args;
+
+        traceEvents.append(object);
+    }
+
+    /**
+     * One async span per sample, from its ingestion to the first
+     * present event whose watermark covers it. Samples whose present
+     * never showed up in the buffer (the trailing ones, or victims of
+     * ring overwrites) are skipped. Both streams are ordered by time
+     * and by sample id, so the join is a linear merge.
+     */
+    QVector<Event> presentEvents;
+    Q_FOREACH (const Event &event, recordedEvents) {
+        if (event.stage == FramePresented) {
+            presentEvents << event;
+        }
+    }
+
+    int presentIndex = 0;
+    Q_FOREACH (const Event &begin, recordedEvents) {
+        if (begin.stage != TabletEvent) continue;
+
+        while (presentIndex < presentEvents.size() &&
+               (presentEvents[presentIndex].sampleId < begin.sampleId ||
+                presentEvents[presentIndex].timeUsecs < begin.timeUsecs)) {
+
+            presentIndex++;
+        }
+
+        if (presentIndex < presentEvents.size()) {
+            const Event &end = presentEvents[presentIndex];
+
+            QJsonObject beginObject;
+            beginObject["name"] = "stroke-sample";
+            beginObject["cat"] = "latency";
+            beginObject["ph"] = "b";
+            beginObject["id"] = begin.sampleId;
+            beginObject["pid"] = 1;
+            beginObject["tid"] = 0;
+            beginObject["ts"] = begin.timeUsecs;
+            traceEvents.append(beginObject);
+
+            QJsonObject endObject;
+            endObject["name"] = "stroke-sample";
+            endObject["cat"] = "latency";
+            endObject["ph"] = "e";
+            endObject["id"] = begin.sampleId;
+            endObject["pid"] = 1;
+            endObject["tid"] = 0;
+            endObject["ts"] = end.timeUsecs;
+            traceEvents.append(endObject);
+        }
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = traceEvents;
+    root["displayTimeUnit"] = "ms";
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    file.write(QJsonDocument(root).toJson());
+    return true;
+}
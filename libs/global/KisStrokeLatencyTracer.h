@@ -0,0 +1,99 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_STROKE_LATENCY_TRACER_H
+#define KIS_STROKE_LATENCY_TRACER_H
+
+#include <kritaglobal_export.h>
+
+#include <QString>
+#include <QVector>
+
+/**
+ * Records timestamps of stroke samples as they travel through the
+ * rendering pipeline, from the tablet event down to the GL present.
+ *
+ * Only the first stage knows the identity of the sample: the tool
+ * allocates an id when the pointer event arrives. The later stages of
+ * the pipeline (dab queue, merger, texture upload, present) batch and
+ * coalesce the work of many samples, so they cannot tell which exact
+ * samples they have just finished. Instead every stage records a
+ * watermark: the id of the newest sample that had passed the previous
+ * stage when the event fired. A sample is therefore known to be
+ * presented by the first present event whose watermark is not smaller
+ * than its id, which is exactly the join performed by the Chrome-trace
+ * export.
+ *
+ * The recording itself is a fixed-size lock-free ring buffer, so the
+ * tracer adds no locks to the workers' hot path. Tracing is disabled
+ * by default; set the KRITA_TRACE_STROKE_LATENCY environment variable
+ * to the name of the output file to enable it. The trace is dumped
+ * into that file when the application exits and can be loaded into
+ * chrome://tracing or Perfetto.
+ */
+class KRITAGLOBAL_EXPORT KisStrokeLatencyTracer
+{
+public:
+    enum Stage {
+        TabletEvent = 0,
+        DabQueued,
+        MergeCompleted,
+        TextureUploaded,
+        FramePresented,
+
+        NumStages
+    };
+
+    struct Event {
+        /// for TabletEvent, the id of the sample; for the other
+        /// stages, the watermark described in the class comment
+        qint64 sampleId = -1;
+        int stage = TabletEvent;
+        qint64 timeUsecs = 0;
+    };
+
+public:
+    KisStrokeLatencyTracer();
+    ~KisStrokeLatencyTracer();
+    static KisStrokeLatencyTracer* instance();
+
+    bool isEnabled() const;
+    void setEnabled(bool value);
+
+    /**
+     * Allocates an id for a new stroke sample and timestamps its
+     * ingestion. Called by the freehand tool when the pointer event
+     * arrives. Returns -1 when tracing is disabled.
+     */
+    qint64 traceSampleIngested();
+
+    /**
+     * Timestamps the given pipeline stage with the watermark of the
+     * previous one. Safe to call from multiple threads concurrently.
+     * A no-op when tracing is disabled.
+     */
+    void traceStage(Stage stage);
+
+    /**
+     * Returns a copy of the recorded events, oldest first. The reads
+     * are not synchronized with the writers, so the most recent
+     * events may be slightly torn; that is acceptable for the
+     * diagnostics this buffer is used for.
+     */
+    QVector<Event> events() const;
+
+    /**
+     * Dumps the recorded events into \p fileName in the Chrome trace
+     * event format
+     */
+    bool dumpChromeTraceJson(const QString &fileName) const;
+
+private:
+    struct Private;
+    Private * const m_d;
+};
+
+#endif /* KIS_STROKE_LATENCY_TRACER_H */
@@ -0,0 +1,190 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisFrameIntervalIndex.h"
+
+#include <algorithm>
+#include <climits>
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QHash>
+#include <QVector>
+#include <QPair>
+
+#include "kis_node.h"
+#include "kis_layer_utils.h"
+#include "kis_keyframe_channel.h"
+#include "kis_scalar_keyframe_channel.h"
+#include "kis_time_span.h"
+
+struct KisFrameIntervalIndex::Private
+{
+    /**
+     * The flattened intervals of one node: the times at which a new
+     * span of identical frames starts, and the (inclusive) spans in
+     * which every frame renders differently from its neighbors.
+     */
+    struct NodeEntry {
+        QVector<int> boundaries;
+        QVector<QPair<int, int>> uniqueSpans;
+    };
+
+    QMutex mutex;
+
+    QHash<const KisNode*, NodeEntry> nodeEntries;
+
+    QVector<int> mergedBoundaries;
+    QVector<QPair<int, int>> mergedUniqueSpans;
+    bool mergedValid = false;
+
+    NodeEntry buildNodeEntry(const KisNode *node);
+    void rebuildMergedIndex(KisNodeSP root);
+};
+
+KisFrameIntervalIndex::KisFrameIntervalIndex()
+    : m_d(new Private)
+{
+}
+
+KisFrameIntervalIndex::~KisFrameIntervalIndex()
+{
+}
+
+KisFrameIntervalIndex::Private::NodeEntry KisFrameIntervalIndex::Private::buildNodeEntry(const KisNode *node)
+{
+    NodeEntry entry;
+
+    Q_FOREACH (const KisKeyframeChannel *channel, node->keyframeChannels()) {
+        QList<int> times = channel->allKeyframeTimes().values();
+        std::sort(times.begin(), times.end());
+
+        Q_FOREACH (int time, times) {
+            entry.boundaries.append(time);
+        }
+
+        /**
+         * Inside a non-constant scalar segment every frame is its own
+         * interval (see KisScalarKeyframeChannel::identicalFrames()).
+         * The segment started by the last keyframe is excluded: the
+         * channel holds its value in the infinite tail.
+         */
+        const KisScalarKeyframeChannel *scalarChannel =
+            qobject_cast<const KisScalarKeyframeChannel*>(channel);
+
+        if (scalarChannel) {
+            for (int i = 0; i < times.size() - 1; i++) {
+                KisScalarKeyframeSP key = scalarChannel->keyframeAt<KisScalarKeyframe>(times[i]);
+
+                if (key && key->interpolationMode() != KisScalarKeyframe::Constant) {
+                    entry.uniqueSpans.append(qMakePair(times[i], times[i + 1] - 1));
+                }
+            }
+        }
+    }
+
+    return entry;
+}
+
+void KisFrameIntervalIndex::Private::rebuildMergedIndex(KisNodeSP root)
+{
+    mergedBoundaries.clear();
+    mergedUniqueSpans.clear();
+
+    QHash<const KisNode*, NodeEntry> visitedEntries;
+
+    KisLayerUtils::recursiveApplyNodes(root,
+        [this, &visitedEntries] (KisNodeSP node) {
+            if (!node->visible() || node->keyframeChannels().isEmpty()) return;
+
+            const KisNode *key = node.data();
+
+            auto it = nodeEntries.constFind(key);
+            const NodeEntry entry =
+                it != nodeEntries.constEnd() ? *it : buildNodeEntry(key);
+
+            visitedEntries.insert(key, entry);
+
+            mergedBoundaries += entry.boundaries;
+            mergedUniqueSpans += entry.uniqueSpans;
+    });
+
+    // entries of removed, hidden or de-animated nodes are dropped
+    nodeEntries = visitedEntries;
+
+    std::sort(mergedUniqueSpans.begin(), mergedUniqueSpans.end());
+
+    /**
+     * Coalesce overlapping unique spans and let their edges act as
+     * ordinary interval boundaries, so that a query outside the spans
+     * never reaches into them.
+     */
+    QVector<QPair<int, int>> coalescedSpans;
+
+    Q_FOREACH (const auto &span, mergedUniqueSpans) {
+        if (!coalescedSpans.isEmpty() && span.first <= coalescedSpans.last().second + 1) {
+            coalescedSpans.last().second = qMax(coalescedSpans.last().second, span.second);
+        } else {
+            coalescedSpans.append(span);
+        }
+
+        mergedBoundaries.append(span.first);
+        mergedBoundaries.append(span.second + 1);
+    }
+
+    mergedUniqueSpans = coalescedSpans;
+
+    std::sort(mergedBoundaries.begin(), mergedBoundaries.end());
+    mergedBoundaries.erase(std::unique(mergedBoundaries.begin(), mergedBoundaries.end()),
+                           mergedBoundaries.end());
+
+    mergedValid = true;
+}
+
+KisTimeSpan KisFrameIntervalIndex::identicalFrames(KisNodeSP root, int time)
+{
+    QMutexLocker locker(&m_d->mutex);
+
+    if (!m_d->mergedValid) {
+        m_d->rebuildMergedIndex(root);
+    }
+
+    auto spanIt = std::upper_bound(m_d->mergedUniqueSpans.constBegin(),
+                                   m_d->mergedUniqueSpans.constEnd(),
+                                   qMakePair(time, INT_MAX));
+
+    if (spanIt != m_d->mergedUniqueSpans.constBegin() &&
+        (spanIt - 1)->second >= time) {
+
+        return KisTimeSpan::fromTimeToTime(time, time);
+    }
+
+    auto boundIt = std::upper_bound(m_d->mergedBoundaries.constBegin(),
+                                    m_d->mergedBoundaries.constEnd(),
+                                    time);
+
+    const int start = boundIt != m_d->mergedBoundaries.constBegin() ? *(boundIt - 1) : 0;
+
+    return boundIt != m_d->mergedBoundaries.constEnd() ?
+        KisTimeSpan::fromTimeToTime(start, *boundIt - 1) :
+        KisTimeSpan::infinite(start);
+}
+
+void KisFrameIntervalIndex::invalidateNode(const KisNode *node)
+{
+    QMutexLocker locker(&m_d->mutex);
+
+    m_d->nodeEntries.remove(node);
+    m_d->mergedValid = false;
+}
+
+void KisFrameIntervalIndex::invalidate()
+{
+    QMutexLocker locker(&m_d->mutex);
+
+    m_d->nodeEntries.clear();
+    m_d->mergedValid = false;
+}
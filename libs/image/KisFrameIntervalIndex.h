@@ -0,0 +1,75 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_FRAME_INTERVAL_INDEX_H
+#define KIS_FRAME_INTERVAL_INDEX_H
+
+#include <QScopedPointer>
+
+#include "kis_types.h"
+#include "kritaimage_export.h"
+
+class KisNode;
+class KisTimeSpan;
+
+/**
+ * @brief A flattened per-image index of keyframe intervals.
+ *
+ * Answers the question "for which span of frames does the image render
+ * identically to frame T" without walking the layer tree. The precise
+ * computation, KisTimeSpan::calculateIdenticalFramesRecursive(), visits
+ * every channel of every node and performs several keyframe map lookups
+ * per channel; timeline scrubbing asks it once per scrub step, so deep
+ * layer trees spend measurable time on pure bookkeeping.
+ *
+ * The index flattens the keyframe times of all visible nodes into one
+ * sorted boundary array (plus a list of spans where scalar interpolation
+ * makes every frame unique), so a query is a couple of binary searches.
+ * Per-node boundary lists are cached and rebuilt individually when that
+ * node's keyframes change; the merged array is reassembled lazily on the
+ * next query.
+ *
+ * The returned span is guaranteed to be a subset of (or equal to) the
+ * result of calculateIdenticalFramesRecursive(), which is always safe
+ * for the callers: at worst a frame is regenerated or re-cached
+ * needlessly.
+ *
+ * All methods are thread-safe: queries come from the GUI thread while
+ * keyframe edits may invalidate the index from the stroke threads.
+ */
+class KRITAIMAGE_EXPORT KisFrameIntervalIndex
+{
+public:
+    KisFrameIntervalIndex();
+    ~KisFrameIntervalIndex();
+
+    /**
+     * Return the span of frames around \p time that render identically
+     * to \p time for all visible nodes under \p root. Rebuilds the
+     * merged index first if any node was invalidated since the last
+     * query.
+     */
+    KisTimeSpan identicalFrames(KisNodeSP root, int time);
+
+    /**
+     * Drop the cached boundaries of \p node. Called when a keyframe of
+     * the node is added, removed or changed.
+     */
+    void invalidateNode(const KisNode *node);
+
+    /**
+     * Drop the whole index. Called on layer tree changes (node
+     * addition, removal or visibility change), where tracking the
+     * affected subtree is not worth the bookkeeping.
+     */
+    void invalidate();
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KIS_FRAME_INTERVAL_INDEX_H
@@ -9,6 +9,7 @@
 
 #include <kis_types.h>
 #include <KisAdaptedLock.h>
+#include <KisLockContentionTracker.h>
 
 template <typename ImagePointer, bool readOnly>
 class KisImageBarrierLockAdapterImpl {
@@ -19,7 +20,20 @@ public:
     }
 
     inline void lock() {
-        m_image->barrierLock(readOnly);
+        KisLockContentionTracker *tracker = KisLockContentionTracker::instance();
+
+        if (!tracker->isEnabled()) {
+            m_image->barrierLock(readOnly);
+        } else if (m_image->tryBarrierLock(readOnly)) {
+            tracker->recordAcquisition(KisLockContentionTracker::ImageBarrier,
+                                       0, false);
+        } else {
+            QElapsedTimer timer;
+            timer.start();
+            m_image->barrierLock(readOnly);
+            tracker->recordAcquisition(KisLockContentionTracker::ImageBarrier,
+                                       timer.nsecsElapsed() / 1000, true);
+        }
     }
 
     inline bool try_lock() {
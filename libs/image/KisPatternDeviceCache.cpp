@@ -0,0 +1,90 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#include "KisPatternDeviceCache.h"
+
+#include <QGlobalStatic>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <KoColorSpace.h>
+#include <KoColorProfile.h>
+
+#include "kis_paint_device.h"
+
+Q_GLOBAL_STATIC(KisPatternDeviceCache, s_instance)
+
+namespace {
+
+/**
+ * QImage::cacheKey() identifies the pixel data of the pattern image:
+ * it stays stable while the pattern holds the same image and changes
+ * whenever the resource is reloaded or replaced, which is exactly the
+ * invalidation we need.
+ */
+QString makeKey(const QImage &image, const KoColorSpace *cs)
+{
+    return QString("%1_%2_%3")
+        .arg(image.cacheKey())
+        .arg(cs->id())
+        .arg(cs->profile() ? cs->profile()->name() : QString());
+}
+
+}
+
+struct KisPatternDeviceCache::Private
+{
+    QMutex lock;
+    QHash<QString, KisPaintDeviceSP> devices;
+
+    /**
+     * A session rarely uses more than a couple of patterns at a time;
+     * the limit only guards against unbounded growth when many
+     * resources are cycled through
+     */
+    static constexpr int maxEntries = 8;
+};
+
+KisPatternDeviceCache::KisPatternDeviceCache()
+    : m_d(new Private)
+{
+}
+
+KisPatternDeviceCache::~KisPatternDeviceCache()
+{
+}
+
+KisPatternDeviceCache* KisPatternDeviceCache::instance()
+{
+    return s_instance;
+}
+
+KisPaintDeviceSP KisPatternDeviceCache::createDevice(KoPatternSP pattern, const KoColorSpace *cs)
+{
+    const QImage image = pattern->pattern();
+    const QString key = makeKey(image, cs);
+
+    QMutexLocker locker(&m_d->lock);
+
+    KisPaintDeviceSP masterDevice = m_d->devices.value(key);
+
+    if (!masterDevice) {
+        masterDevice = new KisPaintDevice(cs, pattern->name());
+        masterDevice->convertFromQImage(image, 0);
+
+        if (m_d->devices.size() >= Private::maxEntries) {
+            m_d->devices.clear();
+        }
+        m_d->devices.insert(key, masterDevice);
+    }
+
+    /**
+     * The clone shares the tile data copy-on-write, so handing it out
+     * costs nothing, while the caller gets a private device object
+     * whose bounds and offset it can safely change
+     */
+    return new KisPaintDevice(*masterDevice);
+}
@@ -0,0 +1,52 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KISPATTERNDEVICECACHE_H
+#define KISPATTERNDEVICECACHE_H
+
+#include "kritaimage_export.h"
+#include "kis_types.h"
+
+#include <KoPattern.h>
+
+#include <QScopedPointer>
+
+class KoColorSpace;
+
+/**
+ * A process-wide cache of patterns converted into paint devices.
+ *
+ * Every pattern fill used to convert the pattern's QImage into the
+ * target colorspace from scratch, which dominates the cost of
+ * texture-fill workflows that fill with the same pattern over and
+ * over. The cache keeps one converted device per (pattern image,
+ * colorspace) pair and hands out cheap COW clones of it, so the
+ * conversion is paid once per pattern and colorspace.
+ */
+class KRITAIMAGE_EXPORT KisPatternDeviceCache
+{
+public:
+    KisPatternDeviceCache();
+    ~KisPatternDeviceCache();
+
+    static KisPatternDeviceCache* instance();
+
+    /**
+     * Returns a paint device holding \p pattern converted to \p cs.
+     *
+     * The returned device is a COW clone private to the caller, so it
+     * may be freely moved, rebounded or wrapped; the pixel data stays
+     * shared with the cache until someone writes to it.
+     */
+    KisPaintDeviceSP createDevice(KoPatternSP pattern, const KoColorSpace *cs);
+
+private:
+    Q_DISABLE_COPY(KisPatternDeviceCache)
+
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif /* KISPATTERNDEVICECACHE_H */
@@ -0,0 +1,42 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#include "KisSwapPrefetchJob.h"
+
+#include "kis_paint_device.h"
+#include "kis_datamanager.h"
+
+KisSwapPrefetchJob::KisSwapPrefetchJob(KisPaintDeviceSP device, const QRect &rect)
+    : m_device(device),
+      m_rect(rect)
+{
+}
+
+bool KisSwapPrefetchJob::overrides(const KisSpontaneousJob *_otherJob)
+{
+    const KisSwapPrefetchJob *otherJob =
+        dynamic_cast<const KisSwapPrefetchJob*>(_otherJob);
+
+    // the viewport has moved on, the newest prefetch request wins
+    return otherJob && otherJob->m_device == m_device;
+}
+
+void KisSwapPrefetchJob::run()
+{
+    const QRect deviceRect =
+        m_rect.translated(-m_device->x(), -m_device->y());
+
+    m_device->dataManager()->prefetchSwappedTiles(deviceRect);
+}
+
+int KisSwapPrefetchJob::levelOfDetail() const
+{
+    return 0;
+}
+
+QString KisSwapPrefetchJob::debugName() const
+{
+    return "KisSwapPrefetchJob";
+}
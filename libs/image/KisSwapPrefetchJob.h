@@ -0,0 +1,41 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KISSWAPPREFETCHJOB_H
+#define KISSWAPPREFETCHJOB_H
+
+#include <QRect>
+
+#include "kis_types.h"
+#include "kis_spontaneous_job.h"
+
+/**
+ * A low-priority job that swaps the tiles of \p device intersecting
+ * \p rect back into memory before they are actually accessed. The
+ * canvas schedules it for the area just outside the viewport while
+ * the user pans, turning synchronous swap-in stalls into background
+ * work.
+ *
+ * The job is a pure hint: it holds no locks while checking which
+ * tiles are swapped out, and tiles evicted again before the real
+ * access are simply re-loaded by the normal path.
+ */
+class KRITAIMAGE_EXPORT KisSwapPrefetchJob : public KisSpontaneousJob
+{
+public:
+    KisSwapPrefetchJob(KisPaintDeviceSP device, const QRect &rect);
+
+    bool overrides(const KisSpontaneousJob *otherJob) override;
+    void run() override;
+    int levelOfDetail() const override;
+
+    QString debugName() const override;
+
+private:
+    KisPaintDeviceSP m_device;
+    QRect m_rect;
+};
+
+#endif // KISSWAPPREFETCHJOB_H
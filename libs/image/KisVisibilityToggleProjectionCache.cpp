@@ -0,0 +1,105 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#include "KisVisibilityToggleProjectionCache.h"
+
+#include "kis_image.h"
+#include "kis_node.h"
+#include "kis_paint_device.h"
+#include "kis_painter.h"
+
+KisVisibilityToggleProjectionCache::KisVisibilityToggleProjectionCache()
+{
+}
+
+KisVisibilityToggleProjectionCache::~KisVisibilityToggleProjectionCache()
+{
+}
+
+KisNodeSP KisVisibilityToggleProjectionCache::trackedNode() const
+{
+    QMutexLocker locker(&m_lock);
+    return m_node.isValid() ? KisNodeSP(m_node) : KisNodeSP();
+}
+
+bool KisVisibilityToggleProjectionCache::hasSnapshot(KisNodeSP node, bool visibility) const
+{
+    QMutexLocker locker(&m_lock);
+    return node && m_node.data() == node.data() && m_projections[int(visibility)];
+}
+
+void KisVisibilityToggleProjectionCache::storeSnapshot(KisNodeSP node, bool visibility, KisPaintDeviceSP projectionSnapshot)
+{
+    QMutexLocker locker(&m_lock);
+
+    if (m_node.data() != node.data()) return;
+
+    m_projections[int(visibility)] = projectionSnapshot;
+}
+
+bool KisVisibilityToggleProjectionCache::tryApply(KisImage *image, KisNodeSP node, bool newVisibility, const QRect &updateRect)
+{
+    QMutexLocker locker(&m_lock);
+
+    if (m_node.data() != node.data()) {
+        m_node = node;
+        m_projections[0].clear();
+        m_projections[1].clear();
+        m_expectToggleUpdate = true;
+        return false;
+    }
+
+    KisPaintDeviceSP cached = m_projections[int(newVisibility)];
+    KisPaintDeviceSP projection = image->projection();
+
+    /**
+     * The cache works on the lod0 plane only: in lodN mode the
+     * regular recomposite takes care of the lod planes
+     */
+    if (!cached ||
+        image->currentLevelOfDetail() != 0 ||
+        *cached->colorSpace() != *projection->colorSpace()) {
+
+        m_expectToggleUpdate = true;
+        return false;
+    }
+
+    /**
+     * Copy only updateRect: a whole-device clone would drop the
+     * projection contents outside the rect whenever the toggled node
+     * covers less than the composited image
+     */
+    KisPainter::copyAreaOptimized(updateRect.topLeft(), cached, projection, updateRect);
+    image->notifyProjectionUpdated(updateRect);
+
+    return true;
+}
+
+void KisVisibilityToggleProjectionCache::notifyProjectionUpdateRequested(KisNode *node)
+{
+    QMutexLocker locker(&m_lock);
+
+    if (m_node.isNull()) return;
+
+    if (m_expectToggleUpdate && m_node.data() == node) {
+        m_expectToggleUpdate = false;
+        return;
+    }
+
+    m_node = 0;
+    m_projections[0].clear();
+    m_projections[1].clear();
+    m_expectToggleUpdate = false;
+}
+
+void KisVisibilityToggleProjectionCache::clear()
+{
+    QMutexLocker locker(&m_lock);
+
+    m_node = 0;
+    m_projections[0].clear();
+    m_projections[1].clear();
+    m_expectToggleUpdate = false;
+}
@@ -0,0 +1,92 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KISVISIBILITYTOGGLEPROJECTIONCACHE_H
+#define KISVISIBILITYTOGGLEPROJECTIONCACHE_H
+
+#include "kritaimage_export.h"
+#include "kis_types.h"
+
+#include <QMutex>
+#include <QRect>
+
+class KisImage;
+
+/**
+ * Caches full image projections for the two visibility states of the
+ * most recently toggled node, so that before/after visibility flips —
+ * which artists use constantly for comparison — become cheap
+ * copy-on-write blits instead of a full recomposite of a deep layer
+ * stack.
+ *
+ * The cache itself is passive: the snapshots are taken by an
+ * idle-time task in the UI layer (\see
+ * KisVisibilityToggleSnapshotStrokeStrategy), which copies the
+ * current projection while the image is quiescent, i.e. when the
+ * projection is guaranteed to be consistent with the node's current
+ * visibility state. KisNodePropertyListCommand consults the cache
+ * when a pure visibility toggle happens; on a hit the cached device
+ * is blitted into the projection and the recomposite is skipped
+ * entirely.
+ *
+ * Consistency is enforced conservatively: every projection update
+ * request that is not the single expected recomposite of the tracked
+ * node drops the snapshots, so any other change to the image falls
+ * back to the normal update path.
+ */
+class KRITAIMAGE_EXPORT KisVisibilityToggleProjectionCache
+{
+public:
+    KisVisibilityToggleProjectionCache();
+    ~KisVisibilityToggleProjectionCache();
+
+    /**
+     * The node whose visibility states are currently being tracked,
+     * i.e. the most recently toggled one. May be null.
+     */
+    KisNodeSP trackedNode() const;
+
+    /**
+     * Returns true if a projection snapshot for \p node in
+     * visibility state \p visibility is already stored
+     */
+    bool hasSnapshot(KisNodeSP node, bool visibility) const;
+
+    /**
+     * Stores \p projectionSnapshot as the projection of the stack
+     * with \p node in visibility state \p visibility. The caller
+     * must guarantee that the snapshot is consistent, i.e. that it
+     * was taken while the image was idle.
+     */
+    void storeSnapshot(KisNodeSP node, bool visibility, KisPaintDeviceSP projectionSnapshot);
+
+    /**
+     * Tries to serve a visibility toggle of \p node from the cache.
+     * On a hit the cached projection is blitted into the image
+     * projection over \p updateRect, the UI is notified and true is
+     * returned: the caller must then skip the regular setDirty()
+     * call. On a miss the node becomes the tracked one and the
+     * recomposite triggered by the caller is expected (and tolerated)
+     * by the consistency tracking.
+     */
+    bool tryApply(KisImage *image, KisNodeSP node, bool newVisibility, const QRect &updateRect);
+
+    /**
+     * Consistency hook called for every projection update request of
+     * the image. Any request that is not the single expected
+     * recomposite after a cache miss invalidates the snapshots.
+     */
+    void notifyProjectionUpdateRequested(KisNode *node);
+
+    void clear();
+
+private:
+    mutable QMutex m_lock;
+    KisNodeWSP m_node;
+    KisPaintDeviceSP m_projections[2];
+    bool m_expectToggleUpdate {false};
+};
+
+#endif // KISVISIBILITYTOGGLEPROJECTIONCACHE_H
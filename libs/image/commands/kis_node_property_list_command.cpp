@@ -13,6 +13,7 @@
 #include "commands/kis_node_property_list_command.h"
 #include "kis_undo_adapter.h"
 #include "kis_layer_properties_icons.h"
+#include "KisVisibilityToggleProjectionCache.h"
 #include "kis_command_ids.h"
 
 // HACK! please refactor out!
@@ -205,7 +206,27 @@ void KisNodePropertyListCommand::doUpdate(const KisBaseNode::PropertyList &oldPr
     } else if (checkOnionSkinChanged(oldPropertyList, newPropertyList)) {
         m_node->setDirtyDontResetAnimationCache(totalUpdateExtent);
     } else {
-        m_node->setDirty(totalUpdateExtent); // TODO check if visibility was actually changed or not
+        const QSet<QString> changed = changedProperties(oldPropertyList, newPropertyList);
+        const bool visibilityOnlyChange =
+            changed.size() == 1 &&
+            *changed.constBegin() == KisLayerPropertiesIcons::visible.id();
+
+        KisImageSP image = m_node->image().toStrongRef();
+
+        /**
+         * Pure visibility flips of the most recently toggled node can
+         * often be served from the idle-time projection cache, which
+         * blits the precomputed projection instead of recompositing
+         * the whole stack over the node's extent.
+         */
+        if (visibilityOnlyChange && image &&
+            image->visibilityToggleProjectionCache()->tryApply(
+                image.data(), m_node, newVisibilityValue, totalUpdateExtent)) {
+
+            // the cached projection has been blitted, no recomposite needed
+        } else {
+            m_node->setDirty(totalUpdateExtent);
+        }
     }
 }
 
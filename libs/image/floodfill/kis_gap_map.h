@@ -124,6 +124,17 @@ public:
         return m_gapSize;
     }
 
+    /** Replace the opacity callback.
+     *
+     *  A cached map outlives the fill that created it, and the callback
+     *  closes over that fill's internal state; a new fill must rebind
+     *  the callback before querying distances.
+     */
+    void setFillOpacityFunc(const FillOpacityFunc& fillOpacityFunc)
+    {
+        m_fillOpacityFunc = fillOpacityFunc;
+    }
+
 #if KIS_GAP_MAP_MEASURE_ELAPSED_TIME
 public:
     quint64 opacityElapsedMillis() const
@@ -197,7 +208,7 @@ private:
     const int m_gapSize;                      ///< Gap size in pixels for this map
     const QSize m_size;                       ///< Size in pixels of the opacity/gap map
     const QSize m_numTiles;                   ///< Map size in tiles
-    const FillOpacityFunc m_fillOpacityFunc;  ///< A callback to get the opacity data from the fill class
+    FillOpacityFunc m_fillOpacityFunc;        ///< A callback to get the opacity data from the fill class
 
     QPoint m_tilePosition;                    ///< The position of the currently computed tile compared to the whole region
     Data* m_tileDataPtr;                      ///< The pointer to the currently computed tile data
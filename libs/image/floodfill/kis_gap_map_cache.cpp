@@ -0,0 +1,30 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_gap_map_cache.h"
+
+#include <kis_paint_device.h>
+
+KisGapMapSP KisGapMapCache::fetch(const FillParams &params) const
+{
+    const bool matches =
+        m_gapMap &&
+        m_params.device == params.device &&
+        m_params.deviceSequenceNumber == params.deviceSequenceNumber &&
+        m_params.gapSize == params.gapSize &&
+        m_params.boundingRect == params.boundingRect &&
+        m_params.threshold == params.threshold &&
+        m_params.opacitySpread == params.opacitySpread &&
+        m_params.seedColor == params.seedColor;
+
+    return matches ? m_gapMap : KisGapMapSP();
+}
+
+void KisGapMapCache::store(const FillParams &params, KisGapMapSP gapMap)
+{
+    m_params = params;
+    m_gapMap = gapMap;
+}
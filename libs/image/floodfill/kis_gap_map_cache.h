@@ -0,0 +1,66 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __KIS_GAP_MAP_CACHE_H
+#define __KIS_GAP_MAP_CACHE_H
+
+#include <kis_types.h>
+#include <kis_shared.h>
+#include <kritaimage_export.h>
+#include <KoColor.h>
+#include <QRect>
+
+#include "kis_gap_map.h"
+
+/**
+ * Keeps the gap map of the most recent gap closing fill alive between
+ * fill invocations, so that consecutive fills over the same lineart
+ * (a typical flatting workflow) reuse the already computed gap distances
+ * instead of rebuilding them from scratch on every click.
+ *
+ * The gap map is not a function of the reference device alone: the
+ * opacity data it is built from also depends on the seed color and on
+ * the threshold/spread settings of the fill. The cache therefore stores
+ * these parameters alongside the map and only hands the map out when
+ * they all match and the device's content has not changed in the
+ * meantime (tracked with the device's sequence number).
+ *
+ * The fill jobs of a stroke run sequentially, so the cache does no
+ * locking; it must not be shared between concurrent strokes.
+ */
+class KRITAIMAGE_EXPORT KisGapMapCache : public KisShared
+{
+public:
+    /** The parameters that the cached gap map's contents depend on. */
+    struct FillParams
+    {
+        KisPaintDeviceSP device;
+        int deviceSequenceNumber {0};
+        int gapSize {0};
+        QRect boundingRect;
+        int threshold {0};
+        int opacitySpread {0};
+        KoColor seedColor;
+    };
+
+    /** Return the cached gap map if it is still valid for \p params,
+     *  otherwise null. The caller must rebind the opacity callback
+     *  before querying the returned map.
+     *  @see KisGapMap::setFillOpacityFunc()
+     */
+    KisGapMapSP fetch(const FillParams &params) const;
+
+    /** Store a freshly built gap map together with the parameters it was
+     *  built with, replacing the previously cached one.
+     */
+    void store(const FillParams &params, KisGapMapSP gapMap);
+
+private:
+    FillParams m_params;
+    KisGapMapSP m_gapMap;
+};
+
+#endif /* __KIS_GAP_MAP_CACHE_H */
@@ -19,6 +19,7 @@
 #include "kis_fill_sanity_checks.h"
 #include <KisColorSelectionPolicies.h>
 #include "kis_gap_map.h"
+#include "kis_gap_map_cache.h"
 #include <queue>
 
 #define MEASURE_FILL_TIME 0
@@ -28,8 +29,6 @@
 
 namespace {
 
-typedef KisSharedPtr<KisGapMap> KisGapMapSP;
-
 /**
  * A work item for the gap closing fill.
  * Can work as a seed point and as a next queued pixel to continue the fill.
@@ -289,6 +288,10 @@ struct Q_DECL_HIDDEN KisScanlineFill::Private
     int closeGap;           ///< try to close gaps up to this size in pixels
     KisGapMapSP gapMapSp;   ///< maintains the distance and opacity maps required for the algorithm
 
+    KisGapMapCacheSP gapMapCache;   ///< optional, shares the gap map between consecutive fills
+    bool gapMapCacheUsable;         ///< true for the fill modes whose gap maps are safe to share
+    KoColor gapMapSeedColor;        ///< part of the cache key; the opacity data depends on it
+
     QRect fillExtent;
 
     // The priority queue is required to correctly handle the fill "expansion" case
@@ -326,6 +329,7 @@ KisScanlineFill::KisScanlineFill(KisPaintDeviceSP device, const QPoint &startPoi
     m_d->threshold = 0;
     m_d->opacitySpread = 0;
     m_d->closeGap = 0;
+    m_d->gapMapCacheUsable = false;
 }
 
 KisScanlineFill::~KisScanlineFill()
@@ -347,6 +351,11 @@ void KisScanlineFill::setCloseGap(int closeGap)
     m_d->closeGap = closeGap;
 }
 
+void KisScanlineFill::setGapMapCache(KisGapMapCacheSP gapMapCache)
+{
+    m_d->gapMapCache = gapMapCache;
+}
+
 QRect KisScanlineFill::fillExtent() const
 {
     return m_d->fillExtent;
@@ -493,12 +502,18 @@ void KisScanlineFill::processLine(KisFillInterval interval, const int rowIncreme
                 currentForwardInterval.start = x;
                 currentForwardInterval.end = x;
                 currentForwardInterval.row = nextRow;
+
+                /**
+                 * The single-pixel seed keeps the vertical range of the
+                 * extent valid for extendedPass(); the rest of the run
+                 * is united in one go when the run is closed.
+                 */
+                m_d->fillExtent = m_d->fillExtent.united(QRect(x, row, 1, 1));
             } else {
                 currentForwardInterval.end = x;
             }
 
             pixelAccessPolicy.fillPixel(pixelPtr, opacity, x, row);
-            m_d->fillExtent = m_d->fillExtent.united(QRect(x, row, 1, 1));
 
             if (x == firstX) {
                 extendedPass(&currentForwardInterval, row, false,
@@ -512,6 +527,9 @@ void KisScanlineFill::processLine(KisFillInterval interval, const int rowIncreme
 
         } else {
             if (currentForwardInterval.isValid()) {
+                m_d->fillExtent = m_d->fillExtent.united(
+                    QRect(currentForwardInterval.start, row,
+                          currentForwardInterval.end - currentForwardInterval.start + 1, 1));
                 m_d->forwardStack.push(currentForwardInterval);
                 currentForwardInterval.invalidate();
             }
@@ -521,6 +539,9 @@ void KisScanlineFill::processLine(KisFillInterval interval, const int rowIncreme
     }
 
     if (currentForwardInterval.isValid()) {
+        m_d->fillExtent = m_d->fillExtent.united(
+            QRect(currentForwardInterval.start, row,
+                  currentForwardInterval.end - currentForwardInterval.start + 1, 1));
         m_d->forwardStack.push(currentForwardInterval);
     }
 }
@@ -647,9 +668,35 @@ void KisScanlineFill::runImpl(DifferencePolicy &differencePolicy,
             return fillOpacity(differencePolicy, selectionPolicy, pixelAccessPolicy, devicePtr, rect);
         };
 
-        // Prime the resources. The computations are made lazily, when distance at a pixel is requested.
-        // Resources are freed automatically when the object is destroyed, that is together with the KisScanlineFill object.
-        m_d->gapMapSp = KisGapMapSP(new KisGapMap(gapSize, m_d->boundingRect, opacityFunc));
+        KisGapMapCache::FillParams cacheParams;
+        const bool tryCache = m_d->gapMapCache && m_d->gapMapCacheUsable;
+
+        if (tryCache) {
+            cacheParams.device = m_d->device;
+            cacheParams.deviceSequenceNumber = m_d->device->sequenceNumber();
+            cacheParams.gapSize = gapSize;
+            cacheParams.boundingRect = m_d->boundingRect;
+            cacheParams.threshold = m_d->threshold;
+            cacheParams.opacitySpread = m_d->opacitySpread;
+            cacheParams.seedColor = m_d->gapMapSeedColor;
+
+            m_d->gapMapSp = m_d->gapMapCache->fetch(cacheParams);
+        }
+
+        if (m_d->gapMapSp) {
+            // A consecutive fill over unchanged content: reuse the already
+            // computed distances. The previous fill's policies are gone,
+            // so the callback must be rebound to ours.
+            m_d->gapMapSp->setFillOpacityFunc(opacityFunc);
+        } else {
+            // Prime the resources. The computations are made lazily, when distance at a pixel is requested.
+            // Resources are freed automatically when the object is destroyed, that is together with the KisScanlineFill object.
+            m_d->gapMapSp = KisGapMapSP(new KisGapMap(gapSize, m_d->boundingRect, opacityFunc));
+
+            if (tryCache) {
+                m_d->gapMapCache->store(cacheParams, m_d->gapMapSp);
+            }
+        }
     }
 
     m_d->fillExtent = QRect();
@@ -721,6 +768,12 @@ void KisScanlineFill::runImpl(DifferencePolicy &differencePolicy,
 #endif
     } while (!m_d->forwardStack.isEmpty());
 
+    if (m_d->gapMapSp) {
+        // The callback references this call's stack-local policies; drop it
+        // so that a cached map cannot call into destroyed objects.
+        m_d->gapMapSp->setFillOpacityFunc(KisGapMap::FillOpacityFunc());
+    }
+
 #if MEASURE_FILL_TIME
     static constexpr quint64 MillisDivisor = 1000000ull;
     const quint64 totalTime = timerTotal.nsecsElapsed();
@@ -871,6 +924,10 @@ void KisScanlineFill::fillSelection(KisPixelSelectionSP pixelSelection)
 
     if (m_d->closeGap > 0) {
         m_d->filledSelectionIterator = pixelSelection->createRandomAccessorNG();
+        // Only this fill mode can share its gap map between fills:
+        // no boundary mask or extra color takes part in the opacity data.
+        m_d->gapMapCacheUsable = true;
+        m_d->gapMapSeedColor = srcColor;
     }
 
     if (softness == 0) {
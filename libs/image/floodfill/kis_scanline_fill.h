@@ -132,6 +132,13 @@ public:
      */
     void setCloseGap(int closeGap);
 
+    /**
+     * Set the cache that keeps the gap map alive between consecutive
+     * gap closing fills. Only used by fillSelection() without a boundary
+     * selection; the other fill modes always build a fresh map.
+     */
+    void setGapMapCache(KisGapMapCacheSP gapMapCache);
+
     /**
      * Returns the extent of the last filled region
      */
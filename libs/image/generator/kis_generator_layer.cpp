@@ -16,6 +16,8 @@
 #include <KoIcon.h>
 #include <kis_icon.h>
 #include "kis_selection.h"
+#include "kis_paint_device.h"
+#include <KoColorSpace.h>
 #include "filter/kis_filter_configuration.h"
 #include "kis_processing_information.h"
 #include <kis_processing_visitor.h>
@@ -42,6 +44,26 @@ struct Q_DECL_HIDDEN KisGeneratorLayer::Private
     KisFilterConfigurationSP preparedForFilter;
     QWeakPointer<boost::none_t> updateCookie;
     QMutex mutex;
+
+    /**
+     * The render of the previously active generator config. Editing a
+     * fill layer constantly switches the config back and forth (live
+     * preview, cancel), and expensive generators (seexpr) take
+     * seconds to re-render at 4k; switching back to a cached config
+     * revives its pixels instead of re-running the generator.
+     *
+     * All three fields are guarded by \ref mutex.
+     */
+    KisPaintDeviceSP cachedDevice;
+    KisFilterConfigurationSP cachedFilter;
+    QRect cachedPreparedRect;
+
+    /// should be called with \ref mutex held
+    void dropConfigCache() {
+        cachedDevice.clear();
+        cachedFilter.clear();
+        cachedPreparedRect = QRect();
+    }
 };
 
 
@@ -75,10 +97,58 @@ void KisGeneratorLayer::setFilter(KisFilterConfigurationSP filterConfig, bool ch
 void KisGeneratorLayer::setFilterWithoutUpdate(KisFilterConfigurationSP filterConfig, bool checkCompareConfig)
 {
     if (filter().isNull() || (!checkCompareConfig || !filter()->compareTo(filterConfig.constData()))) {
+        KisFilterConfigurationSP previousFilter = filter();
+
         KisSelectionBasedLayer::setFilter(filterConfig);
+
+        QRect restoredRect;
+
         {
             QMutexLocker locker(&m_d->mutex);
-            m_d->preparedRect = QRect();
+
+            /**
+             * Archive the render of the outgoing config (a COW copy,
+             * so it is cheap), then check whether the incoming config
+             * matches the previously archived one and revive its
+             * pixels if it does. The swap makes toggling between two
+             * configs (live preview on/off, cancel) hit the cache in
+             * both directions.
+             */
+            KisPaintDeviceSP previousDevice;
+            const QRect previousPreparedRect = m_d->preparedRect;
+
+            if (previousFilter && !previousPreparedRect.isEmpty()) {
+                previousDevice = new KisPaintDevice(*original());
+            }
+
+            if (m_d->cachedDevice && m_d->cachedFilter &&
+                m_d->cachedFilter->compareTo(filterConfig.constData())) {
+
+                original()->makeCloneFromRough(m_d->cachedDevice,
+                                               m_d->cachedDevice->extent());
+                m_d->preparedRect = m_d->cachedPreparedRect;
+                m_d->preparedForFilter = filterConfig;
+
+                restoredRect = m_d->cachedPreparedRect;
+            } else {
+                m_d->preparedRect = QRect();
+            }
+
+            if (previousDevice) {
+                m_d->cachedDevice = previousDevice;
+                m_d->cachedFilter = previousFilter;
+                m_d->cachedPreparedRect = previousPreparedRect;
+            } else {
+                m_d->dropConfigCache();
+            }
+        }
+
+        /**
+         * The revived pixels never pass through the generator stroke,
+         * so the projection must be told about them explicitly
+         */
+        if (!restoredRect.isEmpty()) {
+            setDirtyWithoutUpdate({restoredRect});
         }
     }
 }
@@ -211,6 +281,8 @@ void KisGeneratorLayer::setX(qint32 x)
     {
         QMutexLocker locker(&m_d->mutex);
         m_d->preparedRect = QRect();
+        // the archived render was copied with the old offset
+        m_d->dropConfigCache();
     }
     m_d->updateSignalCompressor.start();
 }
@@ -221,6 +293,8 @@ void KisGeneratorLayer::setY(qint32 y)
     {
         QMutexLocker locker(&m_d->mutex);
         m_d->preparedRect = QRect();
+        // the archived render was copied with the old offset
+        m_d->dropConfigCache();
     }
     m_d->updateSignalCompressor.start();
 }
@@ -252,6 +326,18 @@ void KisGeneratorLayer::resetCacheWithoutUpdate(const KoColorSpace *colorSpace)
     {
         QMutexLocker locker(&m_d->mutex);
         m_d->preparedRect = QRect();
+
+        /**
+         * This method is also called when the update stroke resets
+         * the stale pixels of the previous config, in which case the
+         * archived render stays usable; only a real colorspace change
+         * invalidates it
+         */
+        if (m_d->cachedDevice &&
+            *m_d->cachedDevice->colorSpace() != *colorSpace) {
+
+            m_d->dropConfigCache();
+        }
     }
 }
 
@@ -7,12 +7,16 @@
 
 
 #include <kis_debug.h>
+#include <KisStrokeLatencyTracer.h>
 #include <QBitArray>
+#include <QElapsedTimer>
+#include <climits>
 
 #include <KoChannelInfo.h>
 #include <KoCompositeOpRegistry.h>
 
 #include "kis_node_visitor.h"
+#include "kis_paint_device.h"
 #include "kis_painter.h"
 #include "kis_layer.h"
 #include "kis_group_layer.h"
@@ -175,6 +179,9 @@ void KisAsyncMerger::startMerge(KisBaseRectsWalker &walker, bool notifyClones) {
 
     const bool useTempProjections = walker.needRectVaries();
 
+    QElapsedTimer mergeCostTimer;
+    mergeCostTimer.start();
+
     while(!leafStack.isEmpty()) {
         KisMergeWalker::JobItem item = leafStack.pop();
         KisProjectionLeafSP currentLeaf = item.m_leaf;
@@ -210,6 +217,75 @@ void KisAsyncMerger::startMerge(KisBaseRectsWalker &walker, bool notifyClones) {
         }
 
 
+        if (!m_currentProjection &&
+            item.m_position & KisMergeWalker::N_BELOW_FILTHY &&
+            !(item.m_position & KisMergeWalker::N_TOPMOST) &&
+            item.m_renderFlags == KisRenderPassFlags()) {
+
+            /**
+             * The update starts with a run of leaves that lie below
+             * the filthy node and therefore have not changed since
+             * the previous update of this group. Their composition
+             * can be restored from (or saved into) the checkpoint
+             * instead of being recomposited layer by layer.
+             */
+            QVector<BelowFilthyCheckpoint::LeafKey> belowKeys;
+            QVector<KisProjectionLeafSP> belowRun;
+            bool checkpointPossible = true;
+
+            BelowFilthyCheckpoint::LeafKey key;
+            if (makeLeafKey(currentLeaf, &key)) {
+                belowKeys << key;
+                belowRun << currentLeaf;
+
+                for (int i = leafStack.size() - 1; i >= 0; i--) {
+                    const KisMergeWalker::JobItem &nextItem = leafStack.at(i);
+                    if (!(nextItem.m_position & KisMergeWalker::N_BELOW_FILTHY)) break;
+
+                    if (nextItem.m_position & KisMergeWalker::N_TOPMOST ||
+                        nextItem.m_applyRect != applyRect ||
+                        nextItem.m_renderFlags != item.m_renderFlags ||
+                        !makeLeafKey(nextItem.m_leaf, &key)) {
+
+                        checkpointPossible = false;
+                        break;
+                    }
+
+                    belowKeys << key;
+                    belowRun << nextItem.m_leaf;
+                }
+            } else {
+                checkpointPossible = false;
+            }
+
+            if (checkpointPossible && belowKeys.size() >= 2) {
+                KisProjectionLeafSP parentLeaf = currentLeaf->parent();
+                const int levelOfDetail = walker.levelOfDetail();
+
+                setupProjection(currentLeaf, applyRect, useTempProjections);
+
+                if (m_currentProjection) {
+                    // the first leaf of the run has been popped already
+                    for (int i = 1; i < belowRun.size(); i++) {
+                        leafStack.pop();
+                    }
+
+                    if (checkpointMatches(parentLeaf, levelOfDetail, belowKeys, applyRect)) {
+                        KisPainter::copyAreaOptimized(applyRect.topLeft(),
+                                                      m_belowFilthyCheckpoint.device,
+                                                      m_currentProjection, applyRect);
+                    } else {
+                        Q_FOREACH (KisProjectionLeafSP leaf, belowRun) {
+                            compositeWithProjection(leaf, applyRect);
+                        }
+                        storeCheckpoint(parentLeaf, levelOfDetail, belowKeys, applyRect);
+                    }
+
+                    continue;
+                }
+            }
+        }
+
         if (!m_currentProjection) {
             setupProjection(currentLeaf, applyRect, useTempProjections);
         }
@@ -256,10 +332,27 @@ void KisAsyncMerger::startMerge(KisBaseRectsWalker &walker, bool notifyClones) {
                  walker.levelOfDetail());
     }
 
+    /**
+     * Feed the cost model of the start node. We attribute the cost of
+     * the whole pass (including the composition of the nodes above
+     * and below) to the filthy node, because that is the granularity
+     * at which the update queue plans the jobs for it.
+     */
+    if (walker.startNode()) {
+        const QRect requestedRect = walker.requestedRect();
+        const qint64 kiloPixels =
+            qMax<qint64>(1, qint64(requestedRect.width()) * requestedRect.height() / 1000);
+
+        walker.startNode()->reportProjectionMergeCost(
+            qBound<qint64>(0, mergeCostTimer.nsecsElapsed() / kiloPixels, INT_MAX));
+    }
+
     if(notifyClones) {
         doNotifyClones(walker);
     }
 
+    KisStrokeLatencyTracer::instance()->traceStage(KisStrokeLatencyTracer::MergeCompleted);
+
     if(m_currentProjection) {
         warnImage << "BUG: The walker hasn't reached the root layer!";
         warnImage << "     Start node:" << walker.startNode() << "Requested rect:" << walker.requestedRect();
@@ -326,6 +419,134 @@ bool KisAsyncMerger::compositeWithProjection(KisProjectionLeafSP leaf, const QRe
     return true;
 }
 
+bool KisAsyncMerger::makeLeafKey(KisProjectionLeafSP leaf, BelowFilthyCheckpoint::LeafKey *key)
+{
+    KisPaintDeviceSP projection = leaf->projection();
+    if (!projection) return false;
+
+    key->node = leaf->node();
+    key->projection = projection;
+    key->projectionSequenceNumber = projection->sequenceNumber();
+    key->opacity = leaf->opacity();
+    key->compositeOpId = leaf->node()->compositeOpId();
+    key->channelFlags = leaf->channelFlags();
+    key->visible = leaf->visible();
+
+    return true;
+}
+
+bool KisAsyncMerger::leafKeyMatches(const BelowFilthyCheckpoint::LeafKey &stored,
+                                    const BelowFilthyCheckpoint::LeafKey &current)
+{
+    return stored.node.isValid() &&
+        stored.projection.isValid() &&
+        stored.node == current.node &&
+        stored.projection == current.projection &&
+        stored.projectionSequenceNumber == current.projectionSequenceNumber &&
+        stored.opacity == current.opacity &&
+        stored.compositeOpId == current.compositeOpId &&
+        stored.channelFlags == current.channelFlags &&
+        stored.visible == current.visible;
+}
+
+bool KisAsyncMerger::checkpointMatches(KisProjectionLeafSP parent, int levelOfDetail,
+                                       const QVector<BelowFilthyCheckpoint::LeafKey> &leaves,
+                                       const QRect &rect) const
+{
+    const BelowFilthyCheckpoint &checkpoint = m_belowFilthyCheckpoint;
+
+    if (!checkpoint.device ||
+        !checkpoint.parent.isValid() ||
+        checkpoint.parent != parent->node().data() ||
+        checkpoint.levelOfDetail != levelOfDetail ||
+        checkpoint.leaves.size() != leaves.size()) {
+
+        return false;
+    }
+
+    for (int i = 0; i < leaves.size(); i++) {
+        if (!leafKeyMatches(checkpoint.leaves[i], leaves[i])) return false;
+    }
+
+    return QRegion(rect).subtracted(checkpoint.validRegion).isEmpty();
+}
+
+void KisAsyncMerger::storeCheckpoint(KisProjectionLeafSP parent, int levelOfDetail,
+                                     const QVector<BelowFilthyCheckpoint::LeafKey> &leaves,
+                                     const QRect &rect)
+{
+    BelowFilthyCheckpoint &checkpoint = m_belowFilthyCheckpoint;
+
+    const bool sameParent =
+        checkpoint.parent.isValid() &&
+        checkpoint.parent == parent->node().data() &&
+        checkpoint.levelOfDetail == levelOfDetail;
+
+    /**
+     * When several groups of one update are worth checkpointing we
+     * can cache only one of them, so prefer the group with more
+     * unchanged layers below the filthy node: skipping its composites
+     * saves the most work. A bigger checkpoint for another group is
+     * kept only while it is still restorable, otherwise it would
+     * block smaller, but alive ones forever.
+     */
+    if (!sameParent && checkpoint.device &&
+        checkpoint.leaves.size() > leaves.size()) {
+
+        bool existingStillRestorable = true;
+
+        Q_FOREACH (const BelowFilthyCheckpoint::LeafKey &stored, checkpoint.leaves) {
+            if (!stored.node.isValid() ||
+                !stored.projection.isValid() ||
+                stored.projection->sequenceNumber() != stored.projectionSequenceNumber) {
+
+                existingStillRestorable = false;
+                break;
+            }
+        }
+
+        if (existingStillRestorable) return;
+    }
+
+    bool sameLeaves = sameParent && checkpoint.device &&
+        checkpoint.leaves.size() == leaves.size();
+
+    if (sameLeaves) {
+        for (int i = 0; i < leaves.size(); i++) {
+            if (!leafKeyMatches(checkpoint.leaves[i], leaves[i])) {
+                sameLeaves = false;
+                break;
+            }
+        }
+    }
+
+    if (!sameLeaves) {
+        if (!checkpoint.device) {
+            checkpoint.device = new KisPaintDevice(m_currentProjection->colorSpace());
+        }
+
+        checkpoint.device->prepareClone(m_currentProjection);
+        checkpoint.validRegion = QRegion();
+        checkpoint.parent = parent->node();
+        checkpoint.levelOfDetail = levelOfDetail;
+        checkpoint.leaves = leaves;
+    }
+
+    KisPainter::copyAreaOptimized(rect.topLeft(), m_currentProjection,
+                                  checkpoint.device, rect);
+
+    /**
+     * QRegion operations get slow when the region becomes too
+     * fragmented, so beyond a sane limit it is cheaper to start
+     * accumulating the valid area from scratch
+     */
+    if (checkpoint.validRegion.rectCount() > 1000) {
+        checkpoint.validRegion = QRegion();
+    }
+
+    checkpoint.validRegion += rect;
+}
+
 void KisAsyncMerger::doNotifyClones(KisBaseRectsWalker &walker) {
     KisBaseRectsWalker::CloneNotificationsVector &vector =
         walker.cloneNotifications();
@@ -6,6 +6,11 @@
 #ifndef __KIS_ASYNC_MERGER_H
 #define __KIS_ASYNC_MERGER_H
 
+#include <QBitArray>
+#include <QRegion>
+#include <QString>
+#include <QVector>
+
 #include "kritaimage_export.h"
 #include "kis_types.h"
 #include "KisRenderPassFlags.h"
@@ -25,6 +30,56 @@ private:
     inline bool compositeWithProjection(KisProjectionLeafSP leaf, const QRect &rect);
     inline void doNotifyClones(KisBaseRectsWalker &walker);
 
+private:
+    /**
+     * A cached composition of the N_BELOW_FILTHY leaves of one group.
+     *
+     * When the user paints on a layer, all its siblings below are
+     * composited into the parent's projection again and again for
+     * every dab, even though none of them has changed. The checkpoint
+     * saves this intermediate result right before the filthy leaf is
+     * composited, so the next update of the same area can start from
+     * the saved device and skip the leaves below entirely.
+     *
+     * The checkpoint is valid only as long as the leaves below keep
+     * exactly the same content and compositing parameters, therefore
+     * every leaf is keyed by its projection device's sequence number
+     * and the properties KisLayerProjectionPlane::apply() depends on.
+     */
+    struct BelowFilthyCheckpoint {
+        struct LeafKey {
+            KisNodeWSP node;
+            KisPaintDeviceWSP projection;
+            int projectionSequenceNumber {0};
+            quint8 opacity {0};
+            QString compositeOpId;
+            QBitArray channelFlags;
+            bool visible {false};
+        };
+
+        KisNodeWSP parent;
+        int levelOfDetail {0};
+        QVector<LeafKey> leaves;
+
+        /**
+         * The area of \p device that really contains the composition
+         * of the leaves. It grows as the stroke covers new areas of
+         * the canvas.
+         */
+        QRegion validRegion;
+        KisPaintDeviceSP device;
+    };
+
+    static bool makeLeafKey(KisProjectionLeafSP leaf, BelowFilthyCheckpoint::LeafKey *key);
+    static bool leafKeyMatches(const BelowFilthyCheckpoint::LeafKey &stored,
+                               const BelowFilthyCheckpoint::LeafKey &current);
+    bool checkpointMatches(KisProjectionLeafSP parent, int levelOfDetail,
+                           const QVector<BelowFilthyCheckpoint::LeafKey> &leaves,
+                           const QRect &rect) const;
+    void storeCheckpoint(KisProjectionLeafSP parent, int levelOfDetail,
+                         const QVector<BelowFilthyCheckpoint::LeafKey> &leaves,
+                         const QRect &rect);
+
 private:
     /**
      * The place where intermediate results of layer's merge
@@ -50,6 +105,8 @@ private:
      * setupProjection()
      */
     KisPaintDeviceSP m_cachedPaintDevice;
+
+    BelowFilthyCheckpoint m_belowFilthyCheckpoint;
 };
 
 
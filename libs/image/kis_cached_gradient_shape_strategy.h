@@ -21,6 +21,7 @@ public:
     KisCachedGradientShapeStrategy(const QRect &rc, qreal xStep, qreal yStep, KisGradientShapeStrategy *baseStrategy);
     ~KisCachedGradientShapeStrategy() override;
 
+    using KisGradientShapeStrategy::valueAt;
     double valueAt(double x, double y) const override;
 
 private:
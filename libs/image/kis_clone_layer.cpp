@@ -150,7 +150,18 @@ void KisCloneLayer::copyOriginalToProjection(const KisPaintDeviceSP original,
     QRect copyRect = rect;
     copyRect.translate(-m_d->offset->x(), -m_d->offset->y());
 
-    KisPainter::copyAreaOptimized(rect.topLeft(), original, projection, copyRect);
+    const QPoint offset(m_d->offset->x(), m_d->offset->y());
+
+    /**
+     * When the offset is aligned to the tile grid, the projection can
+     * share the source's tiles copy-on-write instead of deep-copying
+     * them, so N clones of one source reuse its pixel data
+     */
+    if (projection->fastBitBltTranslatedPossible(original, offset)) {
+        projection->fastBitBltTranslated(original, rect, offset);
+    } else {
+        KisPainter::copyAreaOptimized(rect.topLeft(), original, projection, copyRect);
+    }
 }
 
 void KisCloneLayer::setDirtyOriginal(const QRect &rect, bool dontInvalidateFrames)
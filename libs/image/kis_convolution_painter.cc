@@ -126,7 +126,159 @@ void KisConvolutionPainter::setEnginePreference(EnginePreference value)
     m_enginePreference = value;
 }
 
+namespace {
+
+/**
+ * Try to decompose \p matrix into an outer product of a column and a
+ * row vector, that is, check whether the kernel is separable. The
+ * decomposition is accepted only when both vectors are non-negative:
+ * mixed-sign kernels (e.g. edge detection) would need negative
+ * intermediate values, which integer color channels cannot store
+ * between the two passes.
+ */
+bool decomposeSeparableKernel(const Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic> &matrix,
+                              Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic> *colVector,
+                              Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic> *rowVector)
+{
+    const int rows = matrix.rows();
+    const int cols = matrix.cols();
+
+    int pivotRow = 0;
+    int pivotCol = 0;
+    qreal pivot = 0.0;
+
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            if (qAbs(matrix(r, c)) > qAbs(pivot)) {
+                pivot = matrix(r, c);
+                pivotRow = r;
+                pivotCol = c;
+            }
+        }
+    }
+
+    if (qAbs(pivot) < DBL_EPSILON) return false;
+
+    /**
+     * The matrix has rank one exactly when all its 2x2 minors that
+     * contain the pivot vanish
+     */
+    const qreal minorEps = 1e-10 * pivot * pivot;
+
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            if (qAbs(matrix(r, c) * pivot -
+                     matrix(r, pivotCol) * matrix(pivotRow, c)) > minorEps) {
+                return false;
+            }
+        }
+    }
+
+    Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic> col = matrix.col(pivotCol);
+    Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic> row = matrix.row(pivotRow) / pivot;
+
+    const qreal signEps = 1e-10 * qAbs(pivot);
+
+    if ((col.array() < -signEps).any() || (row.array() < -1e-10).any()) {
+        return false;
+    }
+
+    *colVector = col;
+    *rowVector = row;
+    return true;
+}
+
+}
+
 void KisConvolutionPainter::applyMatrix(const KisConvolutionKernelSP kernel, const KisPaintDeviceSP src, QPoint srcPos, QPoint dstPos, QSize areaSize, KisConvolutionBorderOp borderOp)
+{
+    if (!useFFTImplementation(kernel) &&
+        tryApplySeparableMatrix(kernel, src, srcPos, dstPos, areaSize, borderOp)) {
+
+        return;
+    }
+
+    applyMatrixImpl(kernel, src, srcPos, dstPos, areaSize, borderOp);
+}
+
+bool KisConvolutionPainter::tryApplySeparableMatrix(const KisConvolutionKernelSP kernel, const KisPaintDeviceSP src, QPoint srcPos, QPoint dstPos, QSize areaSize, KisConvolutionBorderOp borderOp)
+{
+    /**
+     * The wrapped iterators have their own rules for reading outside
+     * the requested rect, which the expanded intermediate pass would
+     * break. Leave that case to the single-pass worker.
+     */
+    if (src->defaultBounds()->wrapAroundMode() && src->supportsWraproundMode()) {
+        return false;
+    }
+
+    // the two passes only pay off for real 2D kernels
+    if (kernel->width() < 3 || kernel->height() < 3) return false;
+
+    Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic> colVector;
+    Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic> rowVector;
+
+    if (!decomposeSeparableKernel(*kernel->data(), &colVector, &rowVector)) {
+        return false;
+    }
+
+    /**
+     * The horizontal pass calculates a weighted average of the row
+     * (its factor equals the sum of its weights), so the intermediate
+     * result always stays in the range of the channel. The remaining
+     * part of the factor and the offset are applied by the vertical
+     * pass.
+     */
+    const qreal rowSum = rowVector.sum();
+    if (rowSum < DBL_EPSILON) return false;
+
+    const qreal effectiveFactor = kernel->factor() != 0.0 ? kernel->factor() : 1.0;
+
+    KisConvolutionKernelSP kernelHoriz =
+        KisConvolutionKernel::fromMatrix(rowVector, 0, rowSum);
+    KisConvolutionKernelSP kernelVert =
+        KisConvolutionKernel::fromMatrix(colVector, kernel->offset(), effectiveFactor / rowSum);
+
+    const int verticalCenter = kernelVert->height() / 2;
+
+    QRect pass1Rect = QRect(srcPos - QPoint(0, verticalCenter),
+                            areaSize + QSize(0, 2 * verticalCenter));
+
+    if (borderOp == BORDER_REPEAT) {
+        /**
+         * Mirror the dataRect logic of applyMatrixImpl(): outside it
+         * the repeat iterators replicate the border pixels, and a
+         * replicated row convolves horizontally into a copy of the
+         * convolved border row, so the vertical pass can rebuild the
+         * missing rows from the intermediate device for free.
+         */
+        const QRect boundsRect = src->defaultBounds()->bounds();
+        QRect dataRect = QRect(srcPos, areaSize) | boundsRect;
+
+        KIS_SAFE_ASSERT_RECOVER(boundsRect != KisDefaultBounds().bounds()) {
+            dataRect = QRect(srcPos, areaSize) | src->exactBounds();
+        }
+
+        pass1Rect &= dataRect;
+        if (pass1Rect.isEmpty()) return false;
+    }
+
+    KisPaintDeviceSP interm = new KisPaintDevice(src->colorSpace());
+    interm->prepareClone(src);
+
+    KisConvolutionPainter horizPainter(interm, SPATIAL);
+    horizPainter.setChannelFlags(channelFlags());
+    horizPainter.setProgress(progressUpdater());
+    horizPainter.applyMatrixImpl(kernelHoriz, src,
+                                 pass1Rect.topLeft(), pass1Rect.topLeft(),
+                                 pass1Rect.size(), borderOp);
+
+    applyMatrixImpl(kernelVert, interm, srcPos, dstPos, areaSize, borderOp);
+
+    return true;
+}
+
+void KisConvolutionPainter::applyMatrixImpl(const KisConvolutionKernelSP kernel, const KisPaintDeviceSP src, QPoint srcPos, QPoint dstPos, QSize areaSize, KisConvolutionBorderOp borderOp)
 {
     /**
      * Force BORDER_IGNORE op for the wraparound mode,
@@ -93,6 +93,25 @@ private:
 
      bool useFFTImplementation(const KisConvolutionKernelSP kernel) const;
 
+    /**
+     * Apply \p kernel with the selected engine (spatial or FFT) in a
+     * single pass, without trying to split it into two 1D kernels.
+     */
+    void applyMatrixImpl(const KisConvolutionKernelSP kernel, const KisPaintDeviceSP src, QPoint srcPos, QPoint dstPos, QSize areaSize,
+                         KisConvolutionBorderOp borderOp);
+
+    /**
+     * When \p kernel is an outer product of two non-negative 1D
+     * kernels, apply it as a horizontal pass into an intermediate
+     * device followed by a vertical pass (the same scheme
+     * KisGaussianKernel uses), which is O(w + h) per pixel instead of
+     * O(w * h). Returns false when the kernel cannot be decomposed
+     * this way, so the caller should fall back to the single-pass
+     * worker.
+     */
+    bool tryApplySeparableMatrix(const KisConvolutionKernelSP kernel, const KisPaintDeviceSP src, QPoint srcPos, QPoint dstPos, QSize areaSize,
+                                 KisConvolutionBorderOp borderOp);
+
 private:
     EnginePreference m_enginePreference;
 };
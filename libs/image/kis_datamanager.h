@@ -117,10 +117,26 @@ public:
         return ACTUAL_DATAMGR::read(io);
     }
 
+    /**
+     * Reads only the tiles intersecting \p regionOfInterest, skipping
+     * the rest of the stream without decompressing it.
+     */
+    inline bool read(QIODevice *io, const QRect &regionOfInterest) {
+        return ACTUAL_DATAMGR::read(io, regionOfInterest);
+    }
+
     inline void purge(const QRect& area) {
         ACTUAL_DATAMGR::purge(area);
     }
 
+    /**
+     * Returns the list of tiles currently present in the device,
+     * used for cheap change detection by the incremental saving code.
+     */
+    inline QVector<KisTileSP> tilesSnapshot() const {
+        return ACTUAL_DATAMGR::tilesSnapshot();
+    }
+
     /**
      * The tiles may be not allocated directly from the glibc, but
      * instead can be allocated in bigger blobs. After you freed quite
@@ -221,12 +221,12 @@ void KisEdgeDetectionKernel::applyEdgeDetection(KisPaintDeviceSP device,
                                       srcTopLeft,
                                       rect.size(), BORDER_REPEAT);
 
-        KisSequentialIterator yIterator(y_denormalised, rect);
-        KisSequentialIterator xIterator(x_denormalised, rect);
+        KisSequentialConstIterator yIterator(y_denormalised, rect);
+        KisSequentialConstIterator xIterator(x_denormalised, rect);
         KisSequentialIterator finalIt(device, rect);
-        const int pixelSize = device->colorSpace()->pixelSize();
-        const int channels = device->colorSpace()->channelCount();
-        const int alphaPos = device->colorSpace()->alphaPos();
+        const KoColorSpace *cs = device->colorSpace();
+        const int channels = cs->channelCount();
+        const int alphaPos = cs->alphaPos();
         KIS_SAFE_ASSERT_RECOVER_RETURN(alphaPos >= 0);
 
         QVector<float> yNormalised(channels);
@@ -234,9 +234,9 @@ void KisEdgeDetectionKernel::applyEdgeDetection(KisPaintDeviceSP device,
         QVector<float> finalNorm(channels);
 
         while(yIterator.nextPixel() && xIterator.nextPixel() && finalIt.nextPixel()) {
-            device->colorSpace()->normalisedChannelsValue(yIterator.rawData(), yNormalised);
-            device->colorSpace()->normalisedChannelsValue(xIterator.rawData(), xNormalised);
-            device->colorSpace()->normalisedChannelsValue(finalIt.rawData(), finalNorm);
+            cs->normalisedChannelsValue(yIterator.oldRawData(), yNormalised);
+            cs->normalisedChannelsValue(xIterator.oldRawData(), xNormalised);
+            cs->normalisedChannelsValue(finalIt.rawData(), finalNorm);
 
             if (output == pythagorean) {
                 for (int c = 0; c<channels; c++) {
@@ -249,21 +249,17 @@ void KisEdgeDetectionKernel::applyEdgeDetection(KisPaintDeviceSP device,
             }
 
             if (writeToAlpha) {
-                KoColor col(finalIt.rawData(), device->colorSpace());
                 qreal alpha = 0;
 
                 for (int c = 0; c<(channels-1); c++) {
                     alpha = alpha+finalNorm[c];
                 }
 
-                alpha = qMin(alpha/(channels-1), col.opacityF());
-                col.setOpacity(alpha);
-                memcpy(finalIt.rawData(), col.data(), pixelSize);
+                alpha = qMin(alpha/(channels-1), cs->opacityF(finalIt.rawData()));
+                cs->setOpacity(finalIt.rawData(), alpha, 1);
             } else {
-                quint8* f = finalIt.rawData();
                 finalNorm[alphaPos] = 1.0;
-                device->colorSpace()->fromNormalisedChannelsValue(f, finalNorm);
-                memcpy(finalIt.rawData(), f, pixelSize);
+                cs->fromNormalisedChannelsValue(finalIt.rawData(), finalNorm);
             }
 
         }
@@ -290,21 +286,19 @@ void KisEdgeDetectionKernel::applyEdgeDetection(KisPaintDeviceSP device,
             kernelP.applyMatrix(kernel, device,
                                 srcTopLeft, srcTopLeft,
                                 rect.size(), BORDER_REPEAT);
-            KisSequentialIterator iterator(denormalised, rect);
+            KisSequentialConstIterator iterator(denormalised, rect);
             KisSequentialIterator finalIt(device, rect);
-            const int pixelSize = device->colorSpace()->pixelSize();
-            const int channels = device->colorSpace()->colorChannelCount();
+            const KoColorSpace *cs = device->colorSpace();
+            const int channels = cs->colorChannelCount();
             QVector<float> normalised(channels);
             while (iterator.nextPixel() && finalIt.nextPixel()) {
-                device->colorSpace()->normalisedChannelsValue(iterator.rawData(), normalised);
-                KoColor col(finalIt.rawData(), device->colorSpace());
+                cs->normalisedChannelsValue(iterator.oldRawData(), normalised);
                 qreal alpha = 0;
                 for (int c = 0; c<channels; c++) {
                     alpha = alpha+normalised[c];
                 }
-                alpha = qMin(alpha/channels, col.opacityF());
-                col.setOpacity(alpha);
-                memcpy(finalIt.rawData(), col.data(), pixelSize);
+                alpha = qMin(alpha/channels, cs->opacityF(finalIt.rawData()));
+                cs->setOpacity(finalIt.rawData(), alpha, 1);
 
             }
 
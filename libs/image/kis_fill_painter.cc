@@ -35,6 +35,7 @@
 #include "kis_layer.h"
 #include "kis_paint_device.h"
 #include <resources/KoPattern.h>
+#include "KisPatternDeviceCache.h"
 #include "KoColorSpace.h"
 #include "kis_transaction.h"
 #include "kis_pixel_selection.h"
@@ -123,8 +124,8 @@ void KisFillPainter::fillRect(qint32 x1, qint32 y1, qint32 w, qint32 h, const Ko
     if (w < 1) return;
     if (h < 1) return;
 
-    KisPaintDeviceSP patternLayer = new KisPaintDevice(device()->compositionSourceColorSpace(), pattern->name());
-    patternLayer->convertFromQImage(pattern->pattern(), 0);
+    KisPaintDeviceSP patternLayer =
+        KisPatternDeviceCache::instance()->createDevice(pattern, device()->compositionSourceColorSpace());
 
     if (!offset.isNull()) {
         patternLayer->moveTo(offset);
@@ -141,8 +142,8 @@ void KisFillPainter::fillRectNoCompose(const QRect &rc, const KoPatternSP patter
     if (rc.width() < 1) return;
     if (rc.height() < 1) return;
 
-    KisPaintDeviceSP patternLayer = new KisPaintDevice(device()->colorSpace(), pattern->name());
-    patternLayer->convertFromQImage(pattern->pattern(), 0);
+    KisPaintDeviceSP patternLayer =
+        KisPatternDeviceCache::instance()->createDevice(pattern, device()->colorSpace());
 
     fillRectNoCompose(rc.x(), rc.y(), rc.width(), rc.height(), patternLayer, QRect(0, 0, pattern->width(), pattern->height()), transform);
 }
@@ -373,6 +374,7 @@ KisPixelSelectionSP KisFillPainter::createFloodSelection(KisPixelSelectionSP pix
     gc.setThreshold(m_threshold);
     gc.setOpacitySpread(m_useCompositing ? m_opacitySpread : 100);
     gc.setCloseGap(m_closeGap);
+    gc.setGapMapCache(m_gapMapCache);
 
     if (m_regionFillingMode == RegionFillingMode_FloodFill) {
         if (m_useSelectionAsBoundary && !pixelSelection.isNull()) {
@@ -428,25 +430,48 @@ void createSimilarColorsSelectionImpl(KisPixelSelectionSP outSelection,
     KisSequentialConstIterator referenceDeviceIterator(referenceDevice, rect);
     KisSequentialIterator outSelectionIterator(outSelection, rect);
 
+    const int referencePixelSize = referenceDevice->pixelSize();
+
     const int totalNumberOfPixels = rect.width() * rect.height();
     const int numberOfUpdates = 4;
     const int numberOfPixelsPerUpdate = totalNumberOfPixels / numberOfUpdates;
     const int progressIncrement = 100 / numberOfUpdates;
     int numberOfPixelsProcessed = 0;
 
+    /**
+     * The pixels are processed in consecutive runs so that the inner
+     * loops work on raw pointers and the compiler can vectorize the
+     * comparisons; the per-pixel iterator protocol is too opaque for
+     * that.
+     */
+
     if (mask) {
         KisSequentialConstIterator maskIterator(mask, rect);
-        while (referenceDeviceIterator.nextPixel() &&
-               outSelectionIterator.nextPixel() &&
-               maskIterator.nextPixel()) {
-            if (*maskIterator.rawDataConst() != MIN_SELECTED) {
-                *outSelectionIterator.rawData() =
-                    selectionPolicy.opacityFromDifference(
-                        differencePolicy.difference(referenceDeviceIterator.rawDataConst())
-                    );
+        int numConseqPixels = qMin(qMin(referenceDeviceIterator.nConseqPixels(),
+                                        outSelectionIterator.nConseqPixels()),
+                                   maskIterator.nConseqPixels());
+        while (referenceDeviceIterator.nextPixels(numConseqPixels) &&
+               outSelectionIterator.nextPixels(numConseqPixels) &&
+               maskIterator.nextPixels(numConseqPixels)) {
+            numConseqPixels = qMin(qMin(referenceDeviceIterator.nConseqPixels(),
+                                        outSelectionIterator.nConseqPixels()),
+                                   maskIterator.nConseqPixels());
+            const quint8 *referencePtr = referenceDeviceIterator.rawDataConst();
+            const quint8 *maskPtr = maskIterator.rawDataConst();
+            quint8 *outPtr = outSelectionIterator.rawData();
+
+            for (int i = 0; i < numConseqPixels; ++i) {
+                if (maskPtr[i] != MIN_SELECTED) {
+                    outPtr[i] =
+                        selectionPolicy.opacityFromDifference(
+                            differencePolicy.difference(referencePtr)
+                        );
+                }
+                referencePtr += referencePixelSize;
             }
+
             if (updater) {
-                ++numberOfPixelsProcessed;
+                numberOfPixelsProcessed += numConseqPixels;
                 if (numberOfPixelsProcessed > numberOfPixelsPerUpdate) {
                     numberOfPixelsProcessed = 0;
                     updater->setProgress(updater->progress() + progressIncrement);
@@ -454,14 +479,25 @@ void createSimilarColorsSelectionImpl(KisPixelSelectionSP outSelection,
             }
         }
     } else {
-        while (referenceDeviceIterator.nextPixel() &&
-               outSelectionIterator.nextPixel()) {
-            *outSelectionIterator.rawData() =
-                selectionPolicy.opacityFromDifference(
-                    differencePolicy.difference(referenceDeviceIterator.rawDataConst())
-                );
+        int numConseqPixels = qMin(referenceDeviceIterator.nConseqPixels(),
+                                   outSelectionIterator.nConseqPixels());
+        while (referenceDeviceIterator.nextPixels(numConseqPixels) &&
+               outSelectionIterator.nextPixels(numConseqPixels)) {
+            numConseqPixels = qMin(referenceDeviceIterator.nConseqPixels(),
+                                   outSelectionIterator.nConseqPixels());
+            const quint8 *referencePtr = referenceDeviceIterator.rawDataConst();
+            quint8 *outPtr = outSelectionIterator.rawData();
+
+            for (int i = 0; i < numConseqPixels; ++i) {
+                outPtr[i] =
+                    selectionPolicy.opacityFromDifference(
+                        differencePolicy.difference(referencePtr)
+                    );
+                referencePtr += referencePixelSize;
+            }
+
             if (updater) {
-                ++numberOfPixelsProcessed;
+                numberOfPixelsProcessed += numConseqPixels;
                 if (numberOfPixelsProcessed > numberOfPixelsPerUpdate) {
                     numberOfPixelsProcessed = 0;
                     updater->setProgress(updater->progress() + progressIncrement);
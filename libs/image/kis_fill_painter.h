@@ -316,6 +316,14 @@ public:
         return m_closeGap;
     }
 
+    /**
+     * Sets the cache that keeps the gap map of a gap closing fill alive
+     * between consecutive fill operations. @see KisGapMapCache
+     */
+    void setGapMapCache(KisGapMapCacheSP gapMapCache) {
+        m_gapMapCache = gapMapCache;
+    }
+
     bool useCompositing() const {
         return m_useCompositing;
     }
@@ -450,6 +458,7 @@ private:
     int m_threshold;
     int m_opacitySpread;
     int m_closeGap;
+    KisGapMapCacheSP m_gapMapCache;
     int m_width, m_height;
     QRect m_rect;
     bool m_careForSelection;
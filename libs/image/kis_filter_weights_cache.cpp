@@ -0,0 +1,92 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_filter_weights_cache.h"
+
+#include <QGlobalStatic>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <cstring>
+
+#include "kis_filter_weights_buffer.h"
+
+Q_GLOBAL_STATIC(KisFilterWeightsCache, s_instance)
+
+namespace {
+
+/**
+ * The scale factor is keyed by its raw bit pattern, so that only
+ * bit-identical scales share a buffer and the cache can never change
+ * the result of a resampling pass.
+ */
+struct CacheKey {
+    QString filterId;
+    quint64 scaleBits;
+
+    bool operator==(const CacheKey &rhs) const {
+        return scaleBits == rhs.scaleBits && filterId == rhs.filterId;
+    }
+};
+
+uint qHash(const CacheKey &key, uint seed = 0)
+{
+    return ::qHash(key.filterId, seed) ^ ::qHash(key.scaleBits);
+}
+
+// one-off scale factors shouldn't accumulate over a long session;
+// each buffer is small (256 spans of qint16 weights), so the exact
+// limit is not critical
+const int maxCachedBuffers = 64;
+
+}
+
+struct KisFilterWeightsCache::Private
+{
+    QMutex lock;
+    QHash<CacheKey, QSharedPointer<KisFilterWeightsBuffer>> buffers;
+};
+
+KisFilterWeightsCache::KisFilterWeightsCache()
+    : m_d(new Private)
+{
+}
+
+KisFilterWeightsCache::~KisFilterWeightsCache()
+{
+}
+
+KisFilterWeightsCache* KisFilterWeightsCache::instance()
+{
+    return s_instance;
+}
+
+QSharedPointer<KisFilterWeightsBuffer> KisFilterWeightsCache::weights(KisFilterStrategy *filterStrategy, qreal realScale)
+{
+    static_assert(sizeof(qreal) == sizeof(quint64), "the cache key relies on qreal being a 64-bit double");
+
+    CacheKey key;
+    key.filterId = filterStrategy->id();
+    memcpy(&key.scaleBits, &realScale, sizeof(key.scaleBits));
+
+    QMutexLocker locker(&m_d->lock);
+
+    QSharedPointer<KisFilterWeightsBuffer> buffer = m_d->buffers.value(key);
+
+    if (!buffer) {
+        if (m_d->buffers.size() >= maxCachedBuffers) {
+            // in-flight passes keep their buffers alive through the
+            // shared pointer, so dropping the map is safe
+            m_d->buffers.clear();
+        }
+
+        buffer = QSharedPointer<KisFilterWeightsBuffer>::create(filterStrategy, realScale);
+        m_d->buffers.insert(key, buffer);
+    }
+
+    return buffer;
+}
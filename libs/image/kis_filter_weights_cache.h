@@ -0,0 +1,53 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __KIS_FILTER_WEIGHTS_CACHE_H
+#define __KIS_FILTER_WEIGHTS_CACHE_H
+
+#include <QSharedPointer>
+#include <QScopedPointer>
+
+#include "kritaimage_export.h"
+
+class KisFilterStrategy;
+class KisFilterWeightsBuffer;
+
+/**
+ * \class KisFilterWeightsCache
+ *
+ * A process-wide cache of KisFilterWeightsBuffer objects, keyed by
+ * the (filter strategy, scale factor) pair. The weight tables depend
+ * on nothing else, are immutable after construction and are rebuilt
+ * identically for every transform pass and every thumbnail update at
+ * the same scale, so sharing them across passes (and across threads)
+ * is free.
+ *
+ * The scale is matched bit-exactly: a buffer is only ever reused for
+ * precisely the scale it was built for, so cached and uncached passes
+ * produce identical pixels.
+ */
+class KRITAIMAGE_EXPORT KisFilterWeightsCache
+{
+public:
+    KisFilterWeightsCache();
+    ~KisFilterWeightsCache();
+
+    static KisFilterWeightsCache* instance();
+
+    /**
+     * Returns the weights buffer for resampling with \p filterStrategy
+     * at scale \p realScale, building and caching it on first use.
+     * The returned buffer is immutable and may be shared by several
+     * concurrent passes.
+     */
+    QSharedPointer<KisFilterWeightsBuffer> weights(KisFilterStrategy *filterStrategy, qreal realScale);
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif /* __KIS_FILTER_WEIGHTS_CACHE_H */
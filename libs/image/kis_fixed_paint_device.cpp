@@ -9,6 +9,7 @@
 #include <KoColorSpaceRegistry.h>
 #include <KoColor.h>
 #include <KoColorModelStandardIds.h>
+#include <KisAllocationCensus.h>
 #include "kis_debug.h"
 
 KisFixedPaintDevice::KisFixedPaintDevice(const KoColorSpace* colorSpace, KisOptimizedByteArray::MemoryAllocatorSP allocator)
@@ -75,7 +76,14 @@ quint32 KisFixedPaintDevice::pixelSize() const
 
 bool KisFixedPaintDevice::initialize(quint8 defaultValue)
 {
-    m_data.fill(defaultValue, m_bounds.height() * m_bounds.width() * pixelSize());
+    const int referenceSize = m_bounds.height() * m_bounds.width() * pixelSize();
+
+    if (referenceSize > m_data.size()) {
+        KisAllocationCensus::instance()->
+            recordAllocation(KisAllocationCensus::FixedPaintDevice, referenceSize);
+    }
+
+    m_data.fill(defaultValue, referenceSize);
 
     return true;
 }
@@ -85,6 +93,8 @@ void KisFixedPaintDevice::reallocateBufferWithoutInitialization()
     const int referenceSize = m_bounds.height() * m_bounds.width() * pixelSize();
 
     if (referenceSize != m_data.size()) {
+        KisAllocationCensus::instance()->
+            recordAllocation(KisAllocationCensus::FixedPaintDevice, referenceSize);
         m_data.resize(m_bounds.height() * m_bounds.width() * pixelSize());
     }
 }
@@ -94,6 +104,8 @@ void KisFixedPaintDevice::lazyGrowBufferWithoutInitialization()
     const int referenceSize = m_bounds.height() * m_bounds.width() * pixelSize();
 
     if (m_data.size() < referenceSize) {
+        KisAllocationCensus::instance()->
+            recordAllocation(KisAllocationCensus::FixedPaintDevice, referenceSize);
         m_data.resize(referenceSize);
     }
 }
@@ -10,7 +10,12 @@
 #include "kis_convolution_kernel.h"
 #include <kis_convolution_painter.h>
 #include <kis_transaction.h>
+#include <kis_math_toolbox.h>
+#include <kis_default_bounds_base.h>
+#include <KoChannelInfo.h>
+#include <KoUpdater.h>
 #include <QRect>
+#include <QPair>
 
 
 qreal KisGaussianKernel::sigmaFromRadius(qreal radius)
@@ -177,6 +182,326 @@ void KisGaussianKernel::applyGaussian(KisPaintDeviceSP device,
     }
 }
 
+QVector<int> KisGaussianKernel::boxSizesFromRadius(qreal radius)
+{
+    const qreal sigma = sigmaFromRadius(qMax(0.0, radius));
+    const int numBoxes = 3;
+
+    const qreal idealWidth = std::sqrt(12.0 * sigma * sigma / numBoxes + 1.0);
+
+    int lowerWidth = std::floor(idealWidth);
+    if (!(lowerWidth & 0x1)) {
+        lowerWidth--;
+    }
+    lowerWidth = qMax(1, lowerWidth);
+
+    const int upperWidth = lowerWidth + 2;
+
+    const qreal idealLowerPasses =
+        (12.0 * sigma * sigma
+         - numBoxes * lowerWidth * lowerWidth
+         - 4.0 * numBoxes * lowerWidth
+         - 3.0 * numBoxes) /
+        (-4.0 * lowerWidth - 4.0);
+
+    const int lowerPasses = qBound(0, qRound(idealLowerPasses), numBoxes);
+
+    QVector<int> sizes;
+    for (int i = 0; i < numBoxes; i++) {
+        sizes << (i < lowerPasses ? lowerWidth : upperWidth);
+    }
+
+    return sizes;
+}
+
+int KisGaussianKernel::boxBlurHaloFromRadius(qreal radius)
+{
+    int halo = 0;
+
+    if (radius > 0.0) {
+        Q_FOREACH (int size, boxSizesFromRadius(radius)) {
+            halo += size / 2;
+        }
+    }
+
+    return halo;
+}
+
+namespace {
+
+/**
+ * Average \p boxSize consecutive pixels of every line of \p
+ * processRect with a running sum, reading boxSize / 2 pixels around
+ * it. The color channels are premultiplied by alpha for the
+ * averaging, like the convolution workers do, and the reads are
+ * clamped to \p clampRect, which replicates the border pixels the
+ * same way BORDER_REPEAT does. The channels that are not being
+ * blurred are copied to the destination unchanged.
+ */
+void boxBlurLinePass(KisPaintDeviceSP src, KisPaintDeviceSP dst,
+                     const QRect &processRect,
+                     const QRect &clampRect,
+                     int boxSize,
+                     Qt::Orientation orientation,
+                     const QList<KoChannelInfo *> &channels,
+                     const QVector<PtrToDouble> &toDoubleFuncPtr,
+                     const QVector<PtrFromDouble> &fromDoubleFuncPtr,
+                     int alphaPos)
+{
+    const int pixelSize = src->pixelSize();
+    const int numChannels = channels.size();
+    const int halfBox = boxSize / 2;
+
+    const bool horizontal = orientation == Qt::Horizontal;
+
+    const int lineLength = horizontal ? processRect.width() : processRect.height();
+    const int numLines = horizontal ? processRect.height() : processRect.width();
+    const int srcLength = lineLength + 2 * halfBox;
+
+    const int alongMin = horizontal ? clampRect.left() : clampRect.top();
+    const int alongMax = horizontal ? clampRect.right() : clampRect.bottom();
+    const int acrossMin = horizontal ? clampRect.top() : clampRect.left();
+    const int acrossMax = horizontal ? clampRect.bottom() : clampRect.right();
+
+    const int alongStart = (horizontal ? processRect.x() : processRect.y()) - halfBox;
+    const int readStart = qMax(alongStart, alongMin);
+    const int readEnd = qMin(alongStart + srcLength - 1, alongMax);
+    const int headLength = readStart - alongStart;
+    const int readLength = readEnd - readStart + 1;
+
+    KIS_SAFE_ASSERT_RECOVER_RETURN(readLength > 0);
+
+    QVector<quint8> srcLineBuf(srcLength * pixelSize);
+    QVector<quint8> dstLineBuf(lineLength * pixelSize);
+    QVector<qreal> values(srcLength * numChannels);
+    QVector<qreal> sums(numChannels);
+
+    const qreal averagingFactor = 1.0 / boxSize;
+
+    for (int line = 0; line < numLines; line++) {
+        const int across = qBound(acrossMin,
+                                  (horizontal ? processRect.y() : processRect.x()) + line,
+                                  acrossMax);
+
+        quint8 *readBufStart = srcLineBuf.data() + headLength * pixelSize;
+
+        const QRect readRect = horizontal ?
+            QRect(readStart, across, readLength, 1) :
+            QRect(across, readStart, 1, readLength);
+
+        src->readBytes(readBufStart, readRect);
+
+        // replicate the clamped head and tail of the line
+        for (quint8 *ptr = readBufStart - pixelSize; ptr >= srcLineBuf.data(); ptr -= pixelSize) {
+            memcpy(ptr, readBufStart, pixelSize);
+        }
+
+        const quint8 *lastReadPixel = readBufStart + (readLength - 1) * pixelSize;
+        const quint8 *bufEnd = srcLineBuf.data() + srcLength * pixelSize;
+        for (quint8 *ptr = readBufStart + readLength * pixelSize; ptr < bufEnd; ptr += pixelSize) {
+            memcpy(ptr, lastReadPixel, pixelSize);
+        }
+
+        // the channels we do not blur are passed through unchanged
+        memcpy(dstLineBuf.data(), srcLineBuf.constData() + halfBox * pixelSize,
+               lineLength * pixelSize);
+
+        const quint8 *srcPtr = srcLineBuf.constData();
+        qreal *valueIt = values.data();
+        for (int i = 0; i < srcLength; i++, srcPtr += pixelSize, valueIt += numChannels) {
+            const qreal alphaValue = alphaPos >= 0 ?
+                toDoubleFuncPtr[alphaPos](srcPtr, channels[alphaPos]->pos()) : 1.0;
+
+            for (int k = 0; k < numChannels; k++) {
+                valueIt[k] = k == alphaPos ? alphaValue :
+                    toDoubleFuncPtr[k](srcPtr, channels[k]->pos()) * alphaValue;
+            }
+        }
+
+        for (int k = 0; k < numChannels; k++) {
+            qreal sum = 0.0;
+            for (int i = 0; i < boxSize; i++) {
+                sum += values[i * numChannels + k];
+            }
+            sums[k] = sum;
+        }
+
+        quint8 *dstPtr = dstLineBuf.data();
+        for (int i = 0; i < lineLength; i++, dstPtr += pixelSize) {
+            const qreal alphaValue = alphaPos >= 0 ? sums[alphaPos] * averagingFactor : 1.0;
+
+            for (int k = 0; k < numChannels; k++) {
+                qreal value;
+
+                if (k == alphaPos) {
+                    value = alphaValue;
+                } else if (alphaValue != 0.0) {
+                    value = sums[k] * averagingFactor / alphaValue;
+                } else {
+                    value = 0.0;
+                }
+
+                fromDoubleFuncPtr[k](dstPtr, channels[k]->pos(), value);
+            }
+
+            if (i + 1 < lineLength) {
+                const qreal *removeIt = &values[i * numChannels];
+                const qreal *addIt = &values[(i + boxSize) * numChannels];
+                for (int k = 0; k < numChannels; k++) {
+                    sums[k] += addIt[k] - removeIt[k];
+                }
+            }
+        }
+
+        const QRect writeRect = horizontal ?
+            QRect(processRect.x(), processRect.y() + line, lineLength, 1) :
+            QRect(processRect.x() + line, processRect.y(), 1, lineLength);
+
+        dst->writeBytes(dstLineBuf.constData(), writeRect);
+    }
+}
+
+}
+
+void KisGaussianKernel::applyGaussianCascade(KisPaintDeviceSP device,
+                                             const QRect& rect,
+                                             qreal xRadius, qreal yRadius,
+                                             const QBitArray &channelFlags,
+                                             KoUpdater *progressUpdater)
+{
+    QVector<QPair<Qt::Orientation, int>> passes;
+    int horizontalMargin = 0;
+    int verticalMargin = 0;
+
+    if (xRadius > 0.0) {
+        Q_FOREACH (int size, boxSizesFromRadius(xRadius)) {
+            if (size > 1) {
+                passes << qMakePair(Qt::Horizontal, size);
+                horizontalMargin += size / 2;
+            }
+        }
+    }
+
+    if (yRadius > 0.0) {
+        Q_FOREACH (int size, boxSizesFromRadius(yRadius)) {
+            if (size > 1) {
+                passes << qMakePair(Qt::Vertical, size);
+                verticalMargin += size / 2;
+            }
+        }
+    }
+
+    if (passes.isEmpty()) return;
+
+    const KoColorSpace *cs = device->colorSpace();
+
+    QBitArray flags = channelFlags;
+    if (flags.isEmpty()) {
+        flags = QBitArray(cs->channelCount(), true);
+    }
+    KIS_SAFE_ASSERT_RECOVER_RETURN(quint32(flags.size()) == cs->channelCount());
+
+    const QList<KoChannelInfo *> channelInfo = cs->channels();
+    QList<KoChannelInfo *> channels;
+    for (int c = 0; c < channelInfo.size(); c++) {
+        if (flags.testBit(c)) {
+            channels.append(channelInfo[c]);
+        }
+    }
+
+    if (channels.isEmpty()) return;
+
+    int alphaPos = -1;
+    for (int i = 0; i < channels.size(); i++) {
+        if (channels[i]->channelType() == KoChannelInfo::ALPHA) {
+            alphaPos = i;
+        }
+    }
+
+    KisMathToolbox mathToolbox;
+    QVector<PtrToDouble> toDoubleFuncPtr(channels.size());
+    QVector<PtrFromDouble> fromDoubleFuncPtr(channels.size());
+
+    if (!mathToolbox.getToDoubleChannelPtr(channels, toDoubleFuncPtr) ||
+        !mathToolbox.getFromDoubleChannelPtr(channels, fromDoubleFuncPtr)) {
+
+        // fall back to the exact implementation for exotic channel types
+        applyGaussian(device, rect, xRadius, yRadius, channelFlags, progressUpdater);
+        return;
+    }
+
+    const QRect clampRect = rect | device->defaultBounds()->bounds();
+
+    /**
+     * The intermediate passes ping-pong between two scratch devices,
+     * so that only the very last pass writes to the destination and
+     * nothing outside \p rect is ever touched on it. The margins of
+     * the intermediate rects shrink with every pass by the reach of
+     * the boxes that are still to be applied.
+     */
+    KisPaintDeviceSP intermA;
+    KisPaintDeviceSP intermB;
+
+    KisPaintDeviceSP currentSrc = device;
+
+    /**
+     * Only the first pass clamps its reads: it samples the original
+     * device, where the data outside \p clampRect should be
+     * replicated from the border. Every later pass reads exactly the
+     * area its predecessor has written, so its clamp rect is the
+     * predecessor's process rect.
+     */
+    QRect sourceClampRect = clampRect;
+
+    int remainingHorizontalMargin = horizontalMargin;
+    int remainingVerticalMargin = verticalMargin;
+
+    for (int i = 0; i < passes.size(); i++) {
+        const Qt::Orientation orientation = passes[i].first;
+        const int boxSize = passes[i].second;
+
+        QRect processRect;
+
+        if (orientation == Qt::Horizontal) {
+            remainingHorizontalMargin -= boxSize / 2;
+            processRect = rect.adjusted(-remainingHorizontalMargin, -remainingVerticalMargin,
+                                        remainingHorizontalMargin, remainingVerticalMargin);
+        } else {
+            remainingVerticalMargin -= boxSize / 2;
+            processRect = rect.adjusted(0, -remainingVerticalMargin,
+                                        0, remainingVerticalMargin);
+        }
+
+        KisPaintDeviceSP dst;
+
+        if (i == passes.size() - 1) {
+            dst = device;
+        } else if (currentSrc != intermA) {
+            if (!intermA) {
+                intermA = new KisPaintDevice(cs);
+                intermA->prepareClone(device);
+            }
+            dst = intermA;
+        } else {
+            if (!intermB) {
+                intermB = new KisPaintDevice(cs);
+                intermB->prepareClone(device);
+            }
+            dst = intermB;
+        }
+
+        boxBlurLinePass(currentSrc, dst, processRect, sourceClampRect, boxSize, orientation,
+                        channels, toDoubleFuncPtr, fromDoubleFuncPtr, alphaPos);
+
+        currentSrc = dst;
+        sourceClampRect = processRect;
+
+        if (progressUpdater) {
+            progressUpdater->setProgress(100 * (i + 1) / passes.size());
+        }
+    }
+}
+
 Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic>
 KisGaussianKernel::createLoGMatrix(qreal radius, qreal coeff, bool zeroCentered, bool includeWrappedArea)
 {
@@ -12,6 +12,7 @@
 #include "kis_convolution_painter.h"
 
 #include <Eigen/Core>
+#include <QVector>
 
 class QRect;
 
@@ -36,6 +37,19 @@ public:
     static qreal sigmaFromRadius(qreal radius);
     static int kernelSizeFromRadius(qreal radius);
 
+    /**
+     * The widths of the three box blurs whose cascade approximates a
+     * gaussian of the passed radius (the usual "three boxes" scheme
+     * from the SVG filter specification)
+     */
+    static QVector<int> boxSizesFromRadius(qreal radius);
+
+    /**
+     * How many pixels around a rect applyGaussianCascade() reads when
+     * blurring it with the passed radius
+     */
+    static int boxBlurHaloFromRadius(qreal radius);
+
     static void applyGaussian(KisPaintDeviceSP device,
                               const QRect& rect,
                               qreal xRadius, qreal yRadius,
@@ -44,6 +58,19 @@ public:
                               bool createTransaction = false,
                               KisConvolutionBorderOp borderOp = BORDER_REPEAT);
 
+    /**
+     * Approximate a gaussian blur with a cascade of three box blurs
+     * implemented with running sums, so the cost per pixel does not
+     * depend on the radius. The borders are treated like in
+     * BORDER_REPEAT mode. Meant for the cases where a true gaussian
+     * is not required, e.g. repainting under blurred filter masks.
+     */
+    static void applyGaussianCascade(KisPaintDeviceSP device,
+                                     const QRect& rect,
+                                     qreal xRadius, qreal yRadius,
+                                     const QBitArray &channelFlags,
+                                     KoUpdater *progressUpdater);
+
     static Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic> createLoGMatrix(qreal radius, qreal coeff, bool zeroCentered, bool includeWrappedArea);
 
     static void applyLoG(KisPaintDeviceSP device,
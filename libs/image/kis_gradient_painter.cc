@@ -33,6 +33,8 @@
 #include <KisDitherOp.h>
 #include <KoCachedGradient.h>
 
+#include <xsimd_extensions/xsimd.hpp>
+
 namespace
 {
 
@@ -42,7 +44,9 @@ class LinearGradientStrategy : public KisGradientShapeStrategy
 public:
     LinearGradientStrategy(const QPointF& gradientVectorStart, const QPointF& gradientVectorEnd);
 
+    using KisGradientShapeStrategy::valueAt;
     double valueAt(double x, double y) const override;
+    void valueAt(double *dst, double x, double y, qint32 count) const override;
 
 protected:
     double m_normalisedVectorX;
@@ -85,6 +89,24 @@ double LinearGradientStrategy::valueAt(double x, double y) const
     return t;
 }
 
+void LinearGradientStrategy::valueAt(double *dst, double x, double y, qint32 count) const
+{
+    if (m_vectorLength < DBL_EPSILON) {
+        std::fill_n(dst, count, 0.0);
+        return;
+    }
+
+    // the projection of (x + i, y) onto the gradient vector decomposes
+    // into a per-row constant plus the horizontal term, so the column
+    // loop is a trivially vectorizable multiply-add
+    const double rowTerm = (y - m_gradientVectorStart.y()) * m_normalisedVectorY;
+
+    for (qint32 i = 0; i < count; i++) {
+        const double vx = (x + i) - m_gradientVectorStart.x();
+        dst[i] = (vx * m_normalisedVectorX + rowTerm) / m_vectorLength;
+    }
+}
+
 
 class BiLinearGradientStrategy : public LinearGradientStrategy
 {
@@ -92,7 +114,9 @@ class BiLinearGradientStrategy : public LinearGradientStrategy
 public:
     BiLinearGradientStrategy(const QPointF& gradientVectorStart, const QPointF& gradientVectorEnd);
 
+    using LinearGradientStrategy::valueAt;
     double valueAt(double x, double y) const override;
+    void valueAt(double *dst, double x, double y, qint32 count) const override;
 };
 
 BiLinearGradientStrategy::BiLinearGradientStrategy(const QPointF& gradientVectorStart, const QPointF& gradientVectorEnd)
@@ -112,6 +136,18 @@ double BiLinearGradientStrategy::valueAt(double x, double y) const
     return t;
 }
 
+void BiLinearGradientStrategy::valueAt(double *dst, double x, double y, qint32 count) const
+{
+    LinearGradientStrategy::valueAt(dst, x, y, count);
+
+    // Reflect
+    for (qint32 i = 0; i < count; i++) {
+        if (dst[i] < -DBL_EPSILON) {
+            dst[i] = -dst[i];
+        }
+    }
+}
+
 
 class RadialGradientStrategy : public KisGradientShapeStrategy
 {
@@ -119,7 +155,9 @@ class RadialGradientStrategy : public KisGradientShapeStrategy
 public:
     RadialGradientStrategy(const QPointF& gradientVectorStart, const QPointF& gradientVectorEnd);
 
+    using KisGradientShapeStrategy::valueAt;
     double valueAt(double x, double y) const override;
+    void valueAt(double *dst, double x, double y, qint32 count) const override;
 
 protected:
     double m_radius;
@@ -152,6 +190,51 @@ double RadialGradientStrategy::valueAt(double x, double y) const
     return t;
 }
 
+void RadialGradientStrategy::valueAt(double *dst, double x, double y, qint32 count) const
+{
+    if (m_radius < DBL_EPSILON) {
+        std::fill_n(dst, count, 0.0);
+        return;
+    }
+
+    const double dy = y - m_gradientVectorStart.y();
+    const double dy2 = dy * dy;
+
+    qint32 i = 0;
+
+#if defined(HAVE_XSIMD) && !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE)
+    /**
+     * The vector lane evaluates exactly the same multiply, add, sqrt
+     * and divide sequence as the scalar code, so the results are
+     * bit-identical to valueAt(x, y)
+     */
+    using batch_type = xsimd::batch<double>;
+    const qint32 batchSize = qint32(batch_type::size);
+
+    double offsetsArr[batch_type::size];
+    for (qint32 j = 0; j < batchSize; j++) {
+        offsetsArr[j] = double(j);
+    }
+    const batch_type offsets = batch_type::load_unaligned(offsetsArr);
+
+    const batch_type startX(m_gradientVectorStart.x());
+    const batch_type dy2v(dy2);
+    const batch_type radius(m_radius);
+
+    for (; i <= count - batchSize; i += batchSize) {
+        const batch_type px = batch_type(x + i) + offsets;
+        const batch_type dx = px - startX;
+        const batch_type t = xsimd::sqrt(dx * dx + dy2v) / radius;
+        t.store_unaligned(dst + i);
+    }
+#endif
+
+    for (; i < count; i++) {
+        const double dx = (x + i) - m_gradientVectorStart.x();
+        dst[i] = sqrt(dx * dx + dy2) / m_radius;
+    }
+}
+
 
 class SquareGradientStrategy : public KisGradientShapeStrategy
 {
@@ -159,6 +242,7 @@ class SquareGradientStrategy : public KisGradientShapeStrategy
 public:
     SquareGradientStrategy(const QPointF& gradientVectorStart, const QPointF& gradientVectorEnd);
 
+    using KisGradientShapeStrategy::valueAt;
     double valueAt(double x, double y) const override;
 
 protected:
@@ -223,6 +307,7 @@ class ConicalGradientStrategy : public KisGradientShapeStrategy
 public:
     ConicalGradientStrategy(const QPointF& gradientVectorStart, const QPointF& gradientVectorEnd);
 
+    using KisGradientShapeStrategy::valueAt;
     double valueAt(double x, double y) const override;
 
 protected:
@@ -263,6 +348,7 @@ class ConicalSymetricGradientStrategy : public KisGradientShapeStrategy
 public:
     ConicalSymetricGradientStrategy(const QPointF& gradientVectorStart, const QPointF& gradientVectorEnd);
 
+    using KisGradientShapeStrategy::valueAt;
     double valueAt(double x, double y) const override;
 
 protected:
@@ -308,6 +394,7 @@ class SpiralGradientStrategy : public KisGradientShapeStrategy
 public:
    SpiralGradientStrategy(const QPointF& gradientVectorStart, const QPointF& gradientVectorEnd);
 
+   using KisGradientShapeStrategy::valueAt;
    double valueAt(double x, double y) const override;
 
 protected:
@@ -358,6 +445,7 @@ class ReverseSpiralGradientStrategy : public KisGradientShapeStrategy
 public:
    ReverseSpiralGradientStrategy(const QPointF& gradientVectorStart, const QPointF& gradientVectorEnd);
 
+   using KisGradientShapeStrategy::valueAt;
    double valueAt(double x, double y) const override;
 
 protected:
@@ -951,11 +1039,14 @@ public:
 
     const quint8 *colorAt(qreal x, qreal y) const;
 
+    void processRow(quint8 *dst, qint32 x, qint32 y, qint32 count, double *tBuffer) const;
+
 private:
     QSharedPointer<KisGradientShapeStrategy> m_shapeStrategy;
     const GradientRepeatStrategy *m_repeatStrategy {0};
     bool m_reverseGradient {false};
     const KoCachedGradient *m_cachedGradient {0};
+    qint32 m_pixelSize {0};
 };
 
 void NoAntialiasPaintPolicy::setup(const QPointF& gradientVectorStart,
@@ -973,6 +1064,7 @@ void NoAntialiasPaintPolicy::setup(const QPointF& gradientVectorStart,
     m_repeatStrategy = repeatStrategy;
     m_reverseGradient = reverseGradient;
     m_cachedGradient = cachedGradient;
+    m_pixelSize = cachedGradient->colorSpace()->pixelSize();
 }
 
 const quint8 *NoAntialiasPaintPolicy::colorAt(qreal x, qreal y) const
@@ -987,6 +1079,46 @@ const quint8 *NoAntialiasPaintPolicy::colorAt(qreal x, qreal y) const
     return m_cachedGradient->cachedAt(t);
 }
 
+void NoAntialiasPaintPolicy::processRow(quint8 *dst, qint32 x, qint32 y, qint32 count, double *tBuffer) const
+{
+    m_shapeStrategy->valueAt(tBuffer, x, y, count);
+
+    for (qint32 i = 0; i < count; i++) {
+        qreal t = m_repeatStrategy->valueAt(tBuffer[i]);
+
+        if (m_reverseGradient) {
+            t = 1 - t;
+        }
+
+        memcpy(dst, m_cachedGradient->cachedAt(t), m_pixelSize);
+        dst += m_pixelSize;
+    }
+}
+
+/**
+ * The antialiasing policies decide per pixel whether extra blending is
+ * needed, so they just loop over colorAt(). The plain policy overload
+ * below batches the shape math for the whole run instead.
+ */
+template <typename T>
+inline void processGradientRow(const T &paintPolicy, quint8 *dst, qint32 pixelSize,
+                               qint32 x, qint32 y, qint32 count, double *tBuffer)
+{
+    Q_UNUSED(tBuffer);
+
+    for (qint32 i = 0; i < count; i++) {
+        memcpy(dst, paintPolicy.colorAt(x + i, y), pixelSize);
+        dst += pixelSize;
+    }
+}
+
+inline void processGradientRow(const NoAntialiasPaintPolicy &paintPolicy, quint8 *dst, qint32 pixelSize,
+                               qint32 x, qint32 y, qint32 count, double *tBuffer)
+{
+    Q_UNUSED(pixelSize);
+    paintPolicy.processRow(dst, x, y, count, tBuffer);
+}
+
 }
 
 struct Q_DECL_HIDDEN KisGradientPainter::Private
@@ -1298,8 +1430,6 @@ bool KisGradientPainter::paintGradient(const QPointF& gradientVectorStart,
 
         KoCachedGradient cachedGradient(gradient(), qMax(processRect.width(), processRect.height()), mixCs);
 
-        KisSequentialIteratorProgress it(tmp, processRect, progressUpdater());
-
         paintPolicy.setup(gradientVectorStart,
                           gradientVectorEnd,
                           shapeStrategy,
@@ -1308,11 +1438,31 @@ bool KisGradientPainter::paintGradient(const QPointF& gradientVectorStart,
                           reverseGradient,
                           &cachedGradient);
 
-        while (it.nextPixel()) {
-            const quint8 *const pixel {paintPolicy.colorAt(it.x(), it.y())};
-            memcpy(it.rawData(), pixel, mixPixelSize);
+        /**
+         * Iterate over whole tile rows at once, so the shape math can
+         * be computed for the full run and written into the tile
+         * directly instead of paying two virtual calls per pixel
+         */
+        ProxyBasedProgressPolicy progress(progressUpdater());
+        progress.setRange(processRect.top(), processRect.top() + processRect.height());
+
+        QVector<double> tBuffer(processRect.width());
+        KisHLineIteratorSP hit = tmp->createHLineIteratorNG(processRect.x(), processRect.y(), processRect.width());
+
+        for (qint32 y = processRect.top(); y <= processRect.bottom(); y++) {
+            qint32 numContiguousPixels = 0;
+            do {
+                numContiguousPixels = hit->nConseqPixels();
+                processGradientRow(paintPolicy, hit->rawData(), mixPixelSize,
+                                   hit->x(), y, numContiguousPixels, tBuffer.data());
+            } while (hit->nextPixels(numContiguousPixels));
+            hit->nextRow();
+
+            progress.setValue(y + 1);
         }
 
+        progress.setFinished();
+
         KisRandomAccessorSP dstIt = dev->createRandomAccessorNG();
         KisRandomConstAccessorSP srcIt = tmp->createRandomConstAccessorNG();
 
@@ -20,3 +20,10 @@ KisGradientShapeStrategy::KisGradientShapeStrategy(const QPointF& gradientVector
 KisGradientShapeStrategy::~KisGradientShapeStrategy()
 {
 }
+
+void KisGradientShapeStrategy::valueAt(double *dst, double x, double y, qint32 count) const
+{
+    for (qint32 i = 0; i < count; i++) {
+        dst[i] = valueAt(x + i, y);
+    }
+}
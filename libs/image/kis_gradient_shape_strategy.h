@@ -20,6 +20,15 @@ public:
 
     virtual double valueAt(double x, double y) const = 0;
 
+    /**
+     * Compute the gradient parameter for a horizontal run of \p count
+     * pixels starting at (\p x, \p y). The default implementation
+     * just calls valueAt() per pixel; subclasses with cheap
+     * incremental or vectorizable math override it to process the
+     * whole run at once.
+     */
+    virtual void valueAt(double *dst, double x, double y, qint32 count) const;
+
 protected:
     QPointF m_gradientVectorStart;
     QPointF m_gradientVectorEnd;
@@ -46,8 +46,10 @@
 
 #include "kis_image_config.h"
 #include "kis_update_scheduler.h"
+#include "KisVisibilityToggleProjectionCache.h"
 #include "kis_image_signal_router.h"
 #include "kis_image_animation_interface.h"
+#include "KisFrameIntervalIndex.h"
 #include "kis_keyframe_channel.h"
 #include "kis_stroke_strategy.h"
 #include "kis_simple_stroke_strategy.h"
@@ -69,6 +71,7 @@
 #include "kis_composite_progress_proxy.h"
 #include "kis_layer_composition.h"
 #include "kis_wrapped_rect.h"
+#include "KisRegion.h"
 #include "kis_crop_saved_extra_data.h"
 #include "kis_layer_utils.h"
 #include "kis_keyframe_channel.h"
@@ -273,6 +276,7 @@ public:
     KisImageSignalRouter signalRouter;
     KisImageAnimationInterface *animationInterface;
     KisUpdateScheduler scheduler;
+    KisVisibilityToggleProjectionCache visibilityToggleProjectionCache;
     QAtomicInt disableDirtyRequests;
 
     KisCompositeProgressProxy compositeProgressProxy;
@@ -280,6 +284,28 @@ public:
     QPointF axesCenter;
     bool allowMasksOnRootNode = false;
 
+    /**
+     * The last snapshot of the projection published for the lock-free
+     * readers. The outdated flag is raised by every finished composite
+     * pass; the snapshot itself is recreated lazily on the next
+     * projectionSnapshot() call
+     */
+    QMutex projectionSnapshotLock;
+    KisPaintDeviceSP projectionSnapshot;
+    QAtomicInt projectionSnapshotOutdated;
+
+    /**
+     * The region of the image that has changed since the last LoD
+     * planes synchronization. When the region is unknown (initial
+     * state or an overflow), lodSyncDirtyRegionIsInfinite is raised
+     * and the next sync regenerates the planes fully
+     */
+    QMutex lodSyncDirtyRegionLock;
+    QVector<QRect> lodSyncDirtyRegion;
+    bool lodSyncDirtyRegionIsInfinite = true;
+
+    void accumulateLodSyncDirtyRects(const QVector<QRect> &rects);
+
     void requestProjectionUpdateImpl(KisNode *node,
                                      const QVector<QRect> &rects,
                                      const QRect &cropRect,
@@ -584,6 +610,8 @@ void KisImage::nodeHasBeenAdded(KisNode *parent, int index, KisNodeAdditionFlags
        }
     });
 
+    m_d->animationInterface->frameIntervalIndex()->invalidate();
+
     SANITY_CHECK_LOCKED("nodeHasBeenAdded");
     m_d->signalRouter.emitNodeHasBeenAdded(parent, index, flags);
 }
@@ -606,6 +634,8 @@ void KisImage::aboutToRemoveANode(KisNode *parent, int index)
 
     KisNodeGraphListener::aboutToRemoveANode(parent, index);
 
+    m_d->animationInterface->frameIntervalIndex()->invalidate();
+
     SANITY_CHECK_LOCKED("aboutToRemoveANode");
     m_d->signalRouter.emitAboutToRemoveANode(parent, index);
 }
@@ -613,6 +643,11 @@ void KisImage::aboutToRemoveANode(KisNode *parent, int index)
 void KisImage::nodeChanged(KisNode* node)
 {
     KisNodeGraphListener::nodeChanged(node);
+
+    // node property changes (e.g. visibility) affect which keyframes
+    // contribute to the flattened interval index
+    m_d->animationInterface->frameIntervalIndex()->invalidateNode(node);
+
     m_d->signalRouter.emitNodeChanged(node);
 }
 
@@ -1602,6 +1637,25 @@ KisPaintDeviceSP KisImage::projection() const
     return projection;
 }
 
+KisPaintDeviceSP KisImage::projectionSnapshot()
+{
+    QMutexLocker locker(&m_d->projectionSnapshotLock);
+
+    if (!m_d->projectionSnapshot ||
+        m_d->projectionSnapshotOutdated.loadAcquire()) {
+
+        /**
+         * Clear the flag before taking the snapshot: if a composite
+         * pass finishes in the meantime, the next call will simply
+         * republish the snapshot once more
+         */
+        m_d->projectionSnapshotOutdated.storeRelease(0);
+        m_d->projectionSnapshot = projection()->createSnapshot();
+    }
+
+    return m_d->projectionSnapshot;
+}
+
 qint32 KisImage::nlayers() const
 {
     QStringList list;
@@ -2152,6 +2206,14 @@ void KisImage::initialRefreshGraph()
 
 void KisImage::refreshGraphAsync(KisNodeSP root, const QVector<QRect> &rects, const QRect &cropRect, KisProjectionUpdateFlags flags)
 {
+    /**
+     * Full refreshes bypass requestProjectionUpdate(), so the
+     * visibility toggle cache never sees them; drop the snapshots
+     * explicitly so they cannot outlive a projection change driven by
+     * move strokes, layer reordering/removal or frame regeneration.
+     */
+    m_d->visibilityToggleProjectionCache.clear();
+
     if (!root) root = m_d->rootLayer;
 
     QVector<QRect> requestedRects = rects;
@@ -2186,6 +2248,14 @@ void KisImage::refreshGraphAsync(KisNodeSP root, const QVector<QRect> &rects, co
         KIS_SAFE_ASSERT_RECOVER_RETURN(root);
     }
 
+    /**
+     * The refresh will recalculate the projections of the groups,
+     * which are synced into the LoD planes as well. We accumulate the
+     * rects before the filters, because the filters only delay the
+     * updates, not discard them.
+     */
+    m_d->accumulateLodSyncDirtyRects(requestedRects);
+
     /**
      * We iterate through the filters in a reversed way. It makes the most nested filters
      * to execute first.
@@ -2299,6 +2369,8 @@ void KisImage::notifyProjectionUpdated(const QRect &rc)
 {
     KisUpdateTimeMonitor::instance()->reportUpdateFinished(rc);
 
+    m_d->projectionSnapshotOutdated.storeRelease(1);
+
     if (!m_d->disableUIUpdateSignals) {
         int lod = currentLevelOfDetail();
         QRect dirtyRect = !lod ? rc : KisLodTransform::upscaledRect(rc, lod);
@@ -2355,6 +2427,19 @@ void KisImage::KisImagePrivate::
 
 void KisImage::requestProjectionUpdate(KisNode *node, const QVector<QRect> &rects, KisProjectionUpdateFlags flags)
 {
+    /**
+     * Any unexpected recomposite request makes the cached visibility
+     * toggle projections stale
+     */
+    m_d->visibilityToggleProjectionCache.notifyProjectionUpdateRequested(node);
+
+    /**
+     * Remember the changed areas for the next LoD planes
+     * synchronization. The accumulation happens before the filters,
+     * because the filters only delay the updates, not discard them.
+     */
+    m_d->accumulateLodSyncDirtyRects(rects);
+
     /**
      * We iterate through the filters in a reversed way. It makes the most nested filters
      * to execute first.
@@ -2421,6 +2506,7 @@ void KisImage::keyframeChannelHasBeenAdded(KisNode *node, KisKeyframeChannel *ch
 
     channel->connect(channel, SIGNAL(sigAddedKeyframe(const KisKeyframeChannel*, int)), m_d->animationInterface, SIGNAL(sigKeyframeAdded(const KisKeyframeChannel*, int)), Qt::UniqueConnection);
     channel->connect(channel, SIGNAL(sigKeyframeHasBeenRemoved(const KisKeyframeChannel*,int)), m_d->animationInterface, SIGNAL(sigKeyframeRemoved(const KisKeyframeChannel*, int)), Qt::UniqueConnection);
+    channel->connect(channel, SIGNAL(sigKeyframeChanged(const KisKeyframeChannel*,int)), m_d->animationInterface, SIGNAL(sigKeyframeChanged(const KisKeyframeChannel*, int)), Qt::UniqueConnection);
 }
 
 void KisImage::keyframeChannelAboutToBeRemoved(KisNode *node, KisKeyframeChannel *channel)
@@ -2429,6 +2515,7 @@ void KisImage::keyframeChannelAboutToBeRemoved(KisNode *node, KisKeyframeChannel
 
     channel->disconnect(channel, SIGNAL(sigAddedKeyframe(const KisKeyframeChannel*, int)), m_d->animationInterface, SIGNAL(sigKeyframeAdded(const KisKeyframeChannel*, int)));
     channel->disconnect(channel, SIGNAL(sigKeyframeHasBeenRemoved(const KisKeyframeChannel*, int)), m_d->animationInterface, SIGNAL(sigKeyframeRemoved(const KisKeyframeChannel*, int)));
+    channel->disconnect(channel, SIGNAL(sigKeyframeChanged(const KisKeyframeChannel*, int)), m_d->animationInterface, SIGNAL(sigKeyframeChanged(const KisKeyframeChannel*, int)));
 }
 
 QList<KisLayerCompositionSP> KisImage::compositions()
@@ -2557,6 +2644,52 @@ KisLodPreferences KisImage::lodPreferences() const
     return m_d->scheduler.lodPreferences();
 }
 
+void KisImage::KisImagePrivate::accumulateLodSyncDirtyRects(const QVector<QRect> &rects)
+{
+    QMutexLocker locker(&lodSyncDirtyRegionLock);
+
+    if (lodSyncDirtyRegionIsInfinite) return;
+
+    lodSyncDirtyRegion += rects;
+
+    /**
+     * Long painting sessions between the syncs may accumulate a lot
+     * of rects, so compact them from time to time. The approximation
+     * may only grow the rects, which is safe for the sync
+     */
+    if (lodSyncDirtyRegion.size() > 1024) {
+        KisRegion::approximateOverlappingRects(lodSyncDirtyRegion, 256);
+    }
+}
+
+QVector<QRect> KisImage::takeLodSyncDirtyRegion()
+{
+    QMutexLocker locker(&m_d->lodSyncDirtyRegionLock);
+
+    QVector<QRect> rects;
+
+    if (!m_d->lodSyncDirtyRegionIsInfinite) {
+        rects = KisRegion::fromOverlappingRects(m_d->lodSyncDirtyRegion, 256).rects();
+    }
+
+    m_d->lodSyncDirtyRegion.clear();
+    m_d->lodSyncDirtyRegionIsInfinite = false;
+
+    return rects;
+}
+
+void KisImage::restoreLodSyncDirtyRegion(const QVector<QRect> &rects)
+{
+    QMutexLocker locker(&m_d->lodSyncDirtyRegionLock);
+
+    if (rects.isEmpty()) {
+        m_d->lodSyncDirtyRegionIsInfinite = true;
+        m_d->lodSyncDirtyRegion.clear();
+    } else if (!m_d->lodSyncDirtyRegionIsInfinite) {
+        m_d->lodSyncDirtyRegion += rects;
+    }
+}
+
 void KisImage::nodeCollapsedChanged(KisNode * node)
 {
     Q_UNUSED(node);
@@ -2568,6 +2701,11 @@ KisImageAnimationInterface* KisImage::animationInterface() const
     return m_d->animationInterface;
 }
 
+KisVisibilityToggleProjectionCache* KisImage::visibilityToggleProjectionCache() const
+{
+    return &m_d->visibilityToggleProjectionCache;
+}
+
 void KisImage::setProofingConfiguration(KisProofingConfigurationSP proofingConfig)
 {
     m_d->proofingConfig = proofingConfig;
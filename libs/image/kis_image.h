@@ -39,6 +39,7 @@ class KoColorProfile;
 class KisLayerComposition;
 class KisSpontaneousJob;
 class KisImageAnimationInterface;
+class KisVisibilityToggleProjectionCache;
 class KUndo2MagicString;
 class KisProofingConfiguration;
 class KisPaintDevice;
@@ -560,6 +561,19 @@ public:
      */
     KisPaintDeviceSP projection() const;
 
+    /**
+     * Return the last published snapshot of the image projection.
+     * In contrast to projection(), the returned device is immutable:
+     * it shares the tiles with the projection in a copy-on-write
+     * manner and is never touched by the compositing threads again.
+     * Therefore the caller may read it without taking the image
+     * barrier lock and without serializing against the running
+     * strokes. The snapshot is republished lazily after a composite
+     * pass has marked it outdated, so it may lag behind the real
+     * projection by the updates still in flight.
+     */
+    KisPaintDeviceSP projectionSnapshot();
+
     /**
      * Return the number of layers (not other nodes) that are in this
      * image.
@@ -785,8 +799,38 @@ public:
      */
     KisLodPreferences lodPreferences() const;
 
+    /**
+     * \internal
+     * Interface for KisSyncLodCacheStrokeStrategy.
+     *
+     * Fetches (and resets) the region of the image that has changed
+     * since the LoD planes were synchronized the last time. The
+     * returned rects are coalesced and non-overlapping. An empty
+     * vector means "unknown", that is, the planes should be
+     * resynchronized fully.
+     */
+    QVector<QRect> takeLodSyncDirtyRegion();
+
+    /**
+     * \internal
+     * Puts the rects fetched by takeLodSyncDirtyRegion() back into
+     * the accumulator. Called when the synchronization stroke gets
+     * cancelled midway, so that the next sync does not consider the
+     * partially updated planes to be clean.
+     */
+    void restoreLodSyncDirtyRegion(const QVector<QRect> &rects);
+
     KisImageAnimationInterface *animationInterface() const;
 
+    /**
+     * A cache of full-image projections for the two visibility
+     * states of the most recently toggled node. Filled during idle
+     * time by the UI layer and consulted by the visibility toggle
+     * command, so before/after flips become cheap blits.
+     * \see KisVisibilityToggleProjectionCache
+     */
+    KisVisibilityToggleProjectionCache *visibilityToggleProjectionCache() const;
+
     /**
      * @brief setProofingConfiguration, this sets the image's proofing configuration, and signals
      * the proofingConfiguration has changed.
@@ -18,6 +18,7 @@
 #include "kis_time_span.h"
 
 #include <KisLockFrameGenerationLock.h>
+#include "KisFrameIntervalIndex.h"
 #include "kis_post_execution_undo_adapter.h"
 #include "commands_new/kis_switch_current_time_command.h"
 #include "kis_layer_utils.h"
@@ -69,6 +70,8 @@ struct KisImageAnimationInterface::Private
 
     KisSwitchTimeStrokeStrategy::SharedTokenWSP switchToken;
 
+    KisFrameIntervalIndex intervalIndex;
+
     QAtomicInt backgroundFrameGenerationBlocked;
     QMutex frameGenerationLock;
 
@@ -105,6 +108,8 @@ KisImageAnimationInterface::KisImageAnimationInterface(KisImage *image)
     connect(this, &KisImageAnimationInterface::sigInternalRequestTimeSwitch, this, [this](int frame, bool useUndo) {
         this->switchCurrentTimeAsync(frame, useUndo ? STAO_USE_UNDO : STAO_NONE);
     });
+
+    connectIntervalIndexInvalidation();
 }
 
 KisImageAnimationInterface::KisImageAnimationInterface(const KisImageAnimationInterface &rhs, KisImage *newImage)
@@ -113,6 +118,26 @@ KisImageAnimationInterface::KisImageAnimationInterface(const KisImageAnimationIn
     connect(this, &KisImageAnimationInterface::sigInternalRequestTimeSwitch, this, [this](int frame, bool useUndo) {
         this->switchCurrentTimeAsync(frame, useUndo ? STAO_USE_UNDO : STAO_NONE);
     });
+
+    connectIntervalIndexInvalidation();
+}
+
+void KisImageAnimationInterface::connectIntervalIndexInvalidation()
+{
+    /**
+     * Keyframe edits may happen in the stroke threads, while the index
+     * is queried from the GUI thread on every scrub step. The
+     * connections are direct so that the index never serves results
+     * older than the edit; the index itself is thread-safe.
+     */
+    auto invalidateNodeIndex = [this](const KisKeyframeChannel *channel, int time) {
+        Q_UNUSED(time);
+        m_d->intervalIndex.invalidateNode(channel->node().data());
+    };
+
+    connect(this, &KisImageAnimationInterface::sigKeyframeAdded, this, invalidateNodeIndex, Qt::DirectConnection);
+    connect(this, &KisImageAnimationInterface::sigKeyframeRemoved, this, invalidateNodeIndex, Qt::DirectConnection);
+    connect(this, &KisImageAnimationInterface::sigKeyframeChanged, this, invalidateNodeIndex, Qt::DirectConnection);
 }
 
 KisImageAnimationInterface::~KisImageAnimationInterface()
@@ -236,6 +261,16 @@ KisImageWSP KisImageAnimationInterface::image() const
     return m_d->image;
 }
 
+KisTimeSpan KisImageAnimationInterface::identicalFramesAt(int time) const
+{
+    return m_d->intervalIndex.identicalFrames(m_d->image->root(), time);
+}
+
+KisFrameIntervalIndex* KisImageAnimationInterface::frameIntervalIndex() const
+{
+    return &m_d->intervalIndex;
+}
+
 bool KisImageAnimationInterface::externalFrameActive() const
 {
     return m_d->externalFrameActive;
@@ -271,7 +306,7 @@ void KisImageAnimationInterface::switchCurrentTimeAsync(int frameId, SwitchTimeA
     const bool useUndo = options & STAO_USE_UNDO;
     const bool sameFrame = currentUITime() == frameId;
     const bool needsCompositingUpdate = requiresOnionSkinRendering();
-    const KisTimeSpan range = KisTimeSpan::calculateIdenticalFramesRecursive(m_d->image->root(), currentUITime());
+    const KisTimeSpan range = identicalFramesAt(currentUITime());
     const bool needsRegeneration = !range.contains(frameId) || needsCompositingUpdate || (options & STAO_FORCE_REGENERATION);
 
     KisSwitchTimeStrokeStrategy::SharedTokenSP token = m_d->switchToken.toStrongRef();
@@ -19,6 +19,7 @@ class KisKeyframeChannel;
 class KoColor;
 class KisRegion;
 class KisLockFrameGenerationLock;
+class KisFrameIntervalIndex;
 
 namespace KisLayerUtils {
     struct SwitchFrameCommand;
@@ -131,6 +132,23 @@ public:
 
     KisImageWSP image() const;
 
+    /**
+     * Returns the span of frames that render identically to \p time
+     * for all visible nodes of the image. The result comes from a
+     * flattened per-image interval index, which makes the query cheap
+     * enough for per-scrub-step use; it may be a conservative subset
+     * of KisTimeSpan::calculateIdenticalFramesRecursive().
+     *
+     * \see KisFrameIntervalIndex
+     */
+    KisTimeSpan identicalFramesAt(int time) const;
+
+    /**
+     * The index backing identicalFramesAt(). KisImage pokes it
+     * directly when the layer tree changes.
+     */
+    KisFrameIntervalIndex* frameIntervalIndex() const;
+
     int totalLength();
 
     /**
@@ -256,6 +274,7 @@ Q_SIGNALS:
 
     void sigKeyframeAdded(const KisKeyframeChannel* channel, int time);
     void sigKeyframeRemoved(const KisKeyframeChannel* channel, int time);
+    void sigKeyframeChanged(const KisKeyframeChannel* channel, int time);
 
 private:
     // interface for:
@@ -278,6 +297,7 @@ private:
     friend class KisSwitchTimeStrokeStrategy;
     friend class TransformStrokeStrategy;
     void explicitlySetCurrentTime(int frameId);
+    void connectIntervalIndexInvalidation();
     struct Private;
     const QScopedPointer<Private> m_d;
 };
@@ -124,6 +124,16 @@ qreal KisImageConfig::maxMergeCollectAlpha() const
     return m_config.readEntry("maxMergeCollectAlpha", 1.5);
 }
 
+int KisImageConfig::smallUpdateCoalescingArea() const
+{
+    /**
+     * Updates whose united rect stays below this area (one tile by
+     * default) are merged into one walker unconditionally: the walker
+     * setup cost dominates over merging a few extra pixels
+     */
+    return m_config.readEntry("smallUpdateCoalescingArea", 64 * 64);
+}
+
 qreal KisImageConfig::schedulerBalancingRatio() const
 {
     /**
@@ -224,6 +234,61 @@ void KisImageConfig::setMemoryPoolLimitPercent(qreal value)
     m_config.writeEntry("memoryPoolLimitPercent", value);
 }
 
+bool KisImageConfig::useNumaAwareTilePools(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("useNumaAwareTilePools", false) : false;
+}
+
+void KisImageConfig::setUseNumaAwareTilePools(bool value)
+{
+    m_config.writeEntry("useNumaAwareTilePools", value);
+}
+
+QString KisImageConfig::swapCompression(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("swapCompression", QString("LZF")) : QString("LZF");
+}
+
+void KisImageConfig::setSwapCompression(const QString &value)
+{
+    m_config.writeEntry("swapCompression", value);
+}
+
+int KisImageConfig::compressedSwapMemoryLimit(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("compressedSwapMemoryLimit", 256) : 256; // in MiB
+}
+
+void KisImageConfig::setCompressedSwapMemoryLimit(int value)
+{
+    m_config.writeEntry("compressedSwapMemoryLimit", value);
+}
+
+bool KisImageConfig::useHugePagesForSwap(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("useHugePagesForSwap", false) : false;
+}
+
+void KisImageConfig::setUseHugePagesForSwap(bool value)
+{
+    m_config.writeEntry("useHugePagesForSwap", value);
+}
+
+QString KisImageConfig::kraTileCompression(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("kraTileCompression", QString("LZF")) : QString("LZF");
+}
+
+void KisImageConfig::setKraTileCompression(const QString &value)
+{
+    m_config.writeEntry("kraTileCompression", value);
+}
+
 QString KisImageConfig::safelyGetWritableTempLocation(const QString &suffix, const QString &configKey, bool requestDefault) const
 {
 #ifdef Q_OS_MACOS
@@ -315,6 +380,17 @@ void KisImageConfig::setSwapDir(const QString &swapDir)
     m_config.writeEntry("swaplocation", swapDir);
 }
 
+QStringList KisImageConfig::additionalSwapDirs(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("additionalSwapLocations", QStringList()) : QStringList();
+}
+
+void KisImageConfig::setAdditionalSwapDirs(const QStringList &swapDirs)
+{
+    m_config.writeEntry("additionalSwapLocations", swapDirs);
+}
+
 int KisImageConfig::numberOfOnionSkins() const
 {
     return m_config.readEntry("numberOfOnionSkins", 10);
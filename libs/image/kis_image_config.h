@@ -34,6 +34,7 @@ public:
     qreal maxCollectAlpha() const;
     qreal maxMergeAlpha() const;
     qreal maxMergeCollectAlpha() const;
+    int smallUpdateCoalescingArea() const;
     qreal schedulerBalancingRatio() const;
     void setSchedulerBalancingRatio(qreal value);
 
@@ -57,6 +58,51 @@ public:
     void setMemorySoftLimitPercent(qreal value);
     void setMemoryPoolLimitPercent(qreal value);
 
+    /**
+     * Bin the tile data recycling pools per NUMA node and bind the
+     * updater threads to the nodes, so that tile data accessed by a
+     * worker stays local to its socket. Effective on multi-socket
+     * Linux machines only. Requires a restart.
+     */
+    bool useNumaAwareTilePools(bool requestDefault = false) const;
+    void setUseNumaAwareTilePools(bool value);
+
+    /**
+     * Compression used for swapped-out tiles: "LZF" (default) or
+     * "ZSTD" (much better ratios on 16-bit/float tiles; requires a
+     * build with zstd support, silently falls back to LZF otherwise)
+     */
+    QString swapCompression(bool requestDefault = false) const;
+    void setSwapCompression(const QString &value);
+
+    /**
+     * Budget (in MiB of compressed data) for keeping swapped-out
+     * tiles in memory instead of writing them to the swap file.
+     * Mostly holds undo history, which compresses well and is
+     * restored without disk latency when the user actually undoes.
+     * 0 disables the in-memory tier. \see KisSwappedDataStore
+     */
+    int compressedSwapMemoryLimit(bool requestDefault = false) const;
+    void setCompressedSwapMemoryLimit(int value);
+
+    /**
+     * Back the swap file mapping windows with 2 MiB transparent huge
+     * pages to reduce TLB misses during swap-in. Linux-only; when
+     * huge pages are not available the kernel transparently falls
+     * back to normal pages.
+     */
+    bool useHugePagesForSwap(bool requestDefault = false) const;
+    void setUseHugePagesForSwap(bool value);
+
+    /**
+     * Compression used for the tiles written into .kra files.
+     * "LZF" (default) is readable by all Krita versions; "ZSTD"
+     * gives considerably smaller files but makes them unreadable
+     * by versions without zstd support.
+     */
+    QString kraTileCompression(bool requestDefault = false) const;
+    void setKraTileCompression(const QString &value);
+
     static int totalRAM(); // MiB
 
     /**
@@ -66,6 +112,15 @@ public:
     QString swapDir(bool requestDefault = false);
     void setSwapDir(const QString &swapDir);
 
+    /**
+     * @return extra directories the tile swap is striped over, in
+     * addition to swapDir(). Putting them on different physical
+     * drives multiplies the available swap bandwidth. Empty by
+     * default, i.e. all swap data goes to swapDir().
+     */
+    QStringList additionalSwapDirs(bool requestDefault = false) const;
+    void setAdditionalSwapDirs(const QStringList &swapDirs);
+
     int numberOfOnionSkins() const;
     void setNumberOfOnionSkins(int value);
 
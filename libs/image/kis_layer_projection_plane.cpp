@@ -7,10 +7,15 @@
 #include "kis_layer_projection_plane.h"
 
 #include <QBitArray>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRegion>
 #include <KoColorSpace.h>
 #include <KoChannelInfo.h>
 #include <KoCompositeOpRegistry.h>
 #include "kis_painter.h"
+#include "kis_paint_device.h"
+#include "kis_default_bounds_base.h"
 #include "kis_projection_leaf.h"
 #include "kis_cached_paint_device.h"
 #include "kis_sequential_iterator.h"
@@ -20,8 +25,76 @@ struct KisLayerProjectionPlane::Private
 {
     KisLayer *layer;
     KisCachedPaintDevice cachedDevice;
+
+    /**
+     * When the layer's colorspace differs from the colorspace it is
+     * composited into (mixed-depth documents), every bitBlt converts
+     * the source pixels on the fly. The converted projection is
+     * cached here per plane and invalidated by the layer's dirty
+     * rects in recalculate(), so unchanged regions convert once, not
+     * on every recomposite. All fields are guarded by \ref
+     * convertedLock; the cache is only maintained for lod0, the
+     * instant-preview planes keep converting inline.
+     */
+    QMutex convertedLock;
+    KisPaintDeviceSP convertedProjection;
+    KisPaintDeviceSP convertedSource;
+    QRegion convertedValidRegion;
+
+    KisPaintDeviceSP tryGetConvertedProjection(KisPaintDeviceSP src,
+                                               const KoColorSpace *dstCS,
+                                               const QRect &needRect);
+    void invalidateConvertedProjection(const QRect &rect);
 };
 
+KisPaintDeviceSP KisLayerProjectionPlane::Private::tryGetConvertedProjection(KisPaintDeviceSP src,
+                                                                             const KoColorSpace *dstCS,
+                                                                             const QRect &needRect)
+{
+    QMutexLocker l(&convertedLock);
+
+    if (convertedProjection &&
+        (convertedSource != src ||
+         *convertedProjection->colorSpace() != *dstCS)) {
+
+        convertedProjection.clear();
+        convertedValidRegion = QRegion();
+    }
+
+    if (!convertedProjection) {
+        convertedProjection = new KisPaintDevice(dstCS);
+        convertedProjection->setDefaultBounds(src->defaultBounds());
+        convertedSource = src;
+    }
+
+    const QRegion missingRegion =
+        QRegion(needRect) - convertedValidRegion;
+
+    if (!missingRegion.isEmpty()) {
+        KisPainter gc(convertedProjection);
+        gc.setCompositeOpId(COMPOSITE_COPY);
+
+        for (const QRect &rc : missingRegion) {
+            gc.bitBlt(rc.topLeft(), src, rc);
+        }
+
+        convertedValidRegion += needRect;
+    }
+
+    return convertedProjection;
+}
+
+void KisLayerProjectionPlane::Private::invalidateConvertedProjection(const QRect &rect)
+{
+    if (rect.isEmpty()) return;
+
+    QMutexLocker l(&convertedLock);
+
+    if (convertedProjection) {
+        convertedValidRegion -= rect;
+    }
+}
+
 
 KisLayerProjectionPlane::KisLayerProjectionPlane(KisLayer *layer)
     : m_d(new Private)
@@ -35,7 +108,9 @@ KisLayerProjectionPlane::~KisLayerProjectionPlane()
 
 QRect KisLayerProjectionPlane::recalculate(const QRect& rect, KisNodeSP filthyNode, KisRenderPassFlags flags)
 {
-    return m_d->layer->updateProjection(rect, filthyNode, flags);
+    const QRect changedRect = m_d->layer->updateProjection(rect, filthyNode, flags);
+    m_d->invalidateConvertedProjection(rect | changedRect);
+    return changedRect;
 }
 
 void KisLayerProjectionPlane::applyImpl(KisPainter *painter, const QRect &rect, KritaUtils::ThresholdMode thresholdMode)
@@ -56,6 +131,15 @@ void KisLayerProjectionPlane::applyImpl(KisPainter *painter, const QRect &rect,
 
     const QBitArray channelFlags = m_d->layer->projectionLeaf()->channelFlags();
 
+    if (painter->device() &&
+        *device->colorSpace() != *painter->device()->colorSpace() &&
+        device->defaultBounds()->currentLevelOfDetail() == 0) {
+
+        device = m_d->tryGetConvertedProjection(device,
+                                                painter->device()->colorSpace(),
+                                                needRect);
+    }
+
     QScopedPointer<KisCachedPaintDevice::Guard> d1;
 
     if (thresholdMode != KritaUtils::ThresholdNone) {
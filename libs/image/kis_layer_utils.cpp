@@ -713,6 +713,10 @@ namespace Private {
         void populateChildCommands() override {
             KisPainter gc(m_info->dstNode->paintDevice());
 
+            // the merge runs in a single stroke job, so nobody else
+            // writes to the destination device concurrently
+            gc.setParallelBlitting(true);
+
             foreach (KisNodeSP node, m_info->allSrcNodes()) {
                 QRect rc = node->exactBounds() | m_info->image->bounds();
                 node->projectionPlane()->apply(&gc, rc);
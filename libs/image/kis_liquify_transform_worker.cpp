@@ -6,6 +6,10 @@
 
 #include "kis_liquify_transform_worker.h"
 
+#include <QImage>
+#include <QPainter>
+#include <QTransform>
+
 #include <KoColorSpace.h>
 #include "kis_grid_interpolation_tools.h"
 #include "kis_dom_utils.h"
@@ -32,6 +36,27 @@ struct Q_DECL_HIDDEN KisLiquifyTransformWorker::Private
     int pixelPrecision;
     QSize gridSize;
 
+    /**
+     * The range of grid points (in grid coordinates) changed since the
+     * last preview render, and the preview state the next render can
+     * start from. See runOnQImage().
+     */
+    QRect dirtyPointsRect;
+    bool allPointsDirty = true;
+
+    QImage cachedDstImage;
+    QRect cachedDstBounds;
+    qint64 cachedSrcImageKey = 0;
+    QPointF cachedSrcImageOffset;
+    QTransform cachedThumbTransform;
+    QVector<QPointF> cachedTransformedPoints;
+
+    inline void markPointDirty(int pointIndex) {
+        const int col = pointIndex % gridSize.width();
+        const int row = pointIndex / gridSize.width();
+        dirtyPointsRect |= QRect(col, row, 1, 1);
+    }
+
     void preparePoints();
 
     struct MapIndexesOp;
@@ -118,6 +143,8 @@ const QVector<QPointF>& KisLiquifyTransformWorker::originalPoints() const
 
 QVector<QPointF>& KisLiquifyTransformWorker::transformedPoints()
 {
+    // the caller may modify any point through the reference
+    m_d->allPointsDirty = true;
     return m_d->transformedPoints;
 }
 
@@ -174,6 +201,8 @@ void KisLiquifyTransformWorker::translate(const QPointF &offset)
         *it += offset;
         *refIt += offset;
     }
+
+    m_d->allPointsDirty = true;
 }
 
 void KisLiquifyTransformWorker::translateDstSpace(const QPointF &offset)
@@ -184,6 +213,8 @@ void KisLiquifyTransformWorker::translateDstSpace(const QPointF &offset)
     for (; it != end; ++it) {
         *it += offset;
     }
+
+    m_d->allPointsDirty = true;
 }
 
 void KisLiquifyTransformWorker::undoPoints(const QPointF &base,
@@ -212,6 +243,7 @@ void KisLiquifyTransformWorker::undoPoints(const QPointF &base,
         qreal lambda = exp(-0.5 * pow2(dist / sigma));
         lambda *= amount;
         *it = *refIt * lambda + *it * (1.0 - lambda);
+        m_d->markPointDirty(it - m_d->transformedPoints.begin());
     }
 }
 
@@ -237,6 +269,7 @@ processTransformedPixelsBuildUp(ProcessOp op,
 
         const qreal lambda = exp(-0.5 * pow2(dist / sigma));
         *it = op(*it, base, diff, lambda);
+        markPointDirty(it - transformedPoints.begin());
     }
 }
 
@@ -270,6 +303,7 @@ processTransformedPixelsWash(ProcessOp op,
 
         if (kisDistance(dstPt, *refIt) > kisDistance(*it, *refIt)) {
             *it = (1.0 - flow) * (*it) + flow * dstPt;
+            markPointDirty(it - transformedPoints.begin());
         }
     }
 }
@@ -445,6 +479,8 @@ void KisLiquifyTransformWorker::transformSrcAndDst(const QTransform &t)
     for (auto it = m_d->transformedPoints.begin(); it != m_d->transformedPoints.end(); ++it) {
         *it = t.map(*it);
     }
+
+    m_d->allPointsDirty = true;
 }
 
 #include <functional>
@@ -501,16 +537,126 @@ QImage KisLiquifyTransformWorker::runOnQImage(const QImage &srcImage,
 
     QRect dstBoundsI = dstBounds.toAlignedRect();
 
-    QImage dstImage(dstBoundsI.size(), srcImage.format());
-    dstImage.fill(0);
+    /**
+     * A liquify brush stroke moves only the grid points under the
+     * cursor, so between the preview frames we keep the previously
+     * rendered image and repaint only the cells that either moved or
+     * share pixels with the area the moved cells used to cover. Any
+     * change that affects the whole grid (offsetting the worker, a
+     * different source image, zoom or bounds change) falls back to the
+     * full render.
+     */
+    const bool canUpdateIncrementally =
+        !m_d->allPointsDirty &&
+        !m_d->cachedDstImage.isNull() &&
+        m_d->cachedDstBounds == dstBoundsI &&
+        m_d->cachedSrcImageKey == srcImage.cacheKey() &&
+        m_d->cachedSrcImageOffset == srcImageOffset &&
+        m_d->cachedThumbTransform == imageToThumbTransform &&
+        m_d->cachedTransformedPoints.size() == transformedPointsLocal.size();
+
+    QImage dstImage;
+
+    if (canUpdateIncrementally) {
+        dstImage = m_d->cachedDstImage;
+
+        const QRect validCells(0, 0,
+                               m_d->gridSize.width() - 1,
+                               m_d->gridSize.height() - 1);
+
+        // a moved point (col, row) deforms the four cells sharing it
+        const QRect dirtyCells =
+            m_d->dirtyPointsRect.adjusted(-1, -1, 0, 0) & validCells;
+
+        if (!dirtyCells.isEmpty()) {
+            QRectF changedBounds;
+            for (int row = dirtyCells.top(); row <= dirtyCells.bottom() + 1; row++) {
+                for (int col = dirtyCells.left(); col <= dirtyCells.right() + 1; col++) {
+                    const int index = col + row * m_d->gridSize.width();
+                    KisAlgebra2D::accumulateBounds(transformedPointsLocal[index], &changedBounds);
+                    KisAlgebra2D::accumulateBounds(m_d->cachedTransformedPoints[index], &changedBounds);
+                }
+            }
+
+            // compensate for the rounding of the polygon rasterizer
+            const QRect clearRect = changedBounds.toAlignedRect().adjusted(-2, -2, 2, 2);
+
+            {
+                QPainter gc(&dstImage);
+                gc.setCompositionMode(QPainter::CompositionMode_Source);
+                gc.fillRect(clearRect.translated((-dstQImageOffset).toPoint()).adjusted(-1, -1, 1, 1),
+                            Qt::transparent);
+            }
+
+            GridIterationTools::QImagePolygonOp polygonOp(srcImage, dstImage, srcImageOffset, dstQImageOffset);
+            // the clip covers the cleared pixels with a margin, so that
+            // the repainted cells fully refill the cleared area
+            const QPolygonF clearPolygon(QRectF(clearRect.adjusted(-2, -2, 2, 2)));
+
+            for (int row = 0; row < m_d->gridSize.height() - 1; row++) {
+                for (int col = 0; col < m_d->gridSize.width() - 1; col++) {
+                    const QVector<int> polygonPoints =
+                        GridIterationTools::calculateCellIndexes(col, row, m_d->gridSize);
+
+                    const bool isDirtyCell = dirtyCells.contains(col, row);
+
+                    if (!isDirtyCell) {
+                        QRectF cellBounds;
+                        Q_FOREACH (int index, polygonPoints) {
+                            KisAlgebra2D::accumulateBounds(transformedPointsLocal[index], &cellBounds);
+                        }
+
+                        if (!cellBounds.toAlignedRect().adjusted(-2, -2, 2, 2).intersects(clearRect)) {
+                            continue;
+                        }
+                    }
+
+                    QPolygonF srcPolygon;
+                    QPolygonF dstPolygon;
+
+                    Q_FOREACH (int index, polygonPoints) {
+                        srcPolygon << originalPointsLocal[index];
+                        dstPolygon << transformedPointsLocal[index];
+                    }
+
+                    GridIterationTools::adjustAlignedPolygon(srcPolygon);
+                    GridIterationTools::adjustAlignedPolygon(dstPolygon);
+
+                    if (isDirtyCell) {
+                        polygonOp(srcPolygon, dstPolygon);
+                    } else {
+                        /**
+                         * An unchanged cell is repainted only where it
+                         * intersects the cleared area, so the pixels it
+                         * still owns outside of it are left untouched
+                         */
+                        polygonOp(srcPolygon, dstPolygon, dstPolygon.intersected(clearPolygon));
+                    }
+                }
+            }
+        }
+    } else {
+        dstImage = QImage(dstBoundsI.size(), srcImage.format());
+        dstImage.fill(0);
+
+        GridIterationTools::QImagePolygonOp polygonOp(srcImage, dstImage, srcImageOffset, dstQImageOffset);
+        GridIterationTools::RegularGridIndexesOp indexesOp(m_d->gridSize);
+        GridIterationTools::iterateThroughGrid
+            <GridIterationTools::AlwaysCompletePolygonPolicy>(polygonOp, indexesOp,
+                                                              m_d->gridSize,
+                                                              originalPointsLocal,
+                                                              transformedPointsLocal);
+    }
+
+    m_d->cachedDstImage = dstImage;
+    m_d->cachedDstBounds = dstBoundsI;
+    m_d->cachedSrcImageKey = srcImage.cacheKey();
+    m_d->cachedSrcImageOffset = srcImageOffset;
+    m_d->cachedThumbTransform = imageToThumbTransform;
+    m_d->cachedTransformedPoints = transformedPointsLocal;
+    m_d->dirtyPointsRect = QRect();
+    m_d->allPointsDirty = false;
 
-    GridIterationTools::QImagePolygonOp polygonOp(srcImage, dstImage, srcImageOffset, dstQImageOffset);
-    GridIterationTools::RegularGridIndexesOp indexesOp(m_d->gridSize);
-    GridIterationTools::iterateThroughGrid
-        <GridIterationTools::AlwaysCompletePolygonPolicy>(polygonOp, indexesOp,
-                                                          m_d->gridSize,
-                                                          originalPointsLocal,
-                                                          transformedPointsLocal);
     return dstImage;
 }
 
@@ -325,12 +325,14 @@ void KisMathToolbox::waveuntrans(KisMathToolbox::KisWavelet* wav, KisMathToolbox
     }
 }
 
-KisMathToolbox::KisWavelet* KisMathToolbox::fastWaveletTransformation(KisPaintDeviceSP src, const QRect& rect,  KisWavelet* buff)
+KisMathToolbox::KisWavelet* KisMathToolbox::fastWaveletTransformation(KisPaintDeviceSP src, const QRect& rect,  KisWavelet* buff, KisWavelet* wav)
 {
     if (buff == 0) {
         buff = initWavelet(src, rect);
     }
-    KisWavelet* wav = initWavelet(src, rect);
+    if (wav == 0) {
+        wav = initWavelet(src, rect);
+    }
     transformToFR(src, wav, rect);
     wavetrans(wav, buff, wav->size / 2);
 
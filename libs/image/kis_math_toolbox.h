@@ -76,8 +76,11 @@ public:
      * you might want to give a buff to the function if you want to use the same buffer
      * in transformToWavelet and in untransformToWavelet, use initWavelet to initialize
      * the buffer
+     * @param wav if set to 0, the structure holding the coefficients will be
+     * allocated by the function, pass a zero-filled wavelet of the right size
+     * to reuse an existing allocation instead
      */
-    KisWavelet* fastWaveletTransformation(KisPaintDeviceSP src, const QRect&, KisWavelet* buff = 0);
+    KisWavelet* fastWaveletTransformation(KisPaintDeviceSP src, const QRect&, KisWavelet* buff = 0, KisWavelet* wav = 0);
 
     /**
      * This function reconstruct the layer from the information of a wavelet
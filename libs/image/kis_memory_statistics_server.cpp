@@ -83,7 +83,9 @@ qint64 calculateNodeMemoryHiBoundStep(KisNodeSP node,
                                       QSet<KisPaintDevice*> &devices,
                                       qint64 &layersSize,
                                       qint64 &projectionsSize,
-                                      qint64 &lodSize)
+                                      qint64 &lodSize,
+                                      QVector<KisMemoryStatisticsServer::Statistics::NodeStatistics> &nodeStatistics,
+                                      int level)
 {
     qint64 memBound = 0;
 
@@ -91,15 +93,28 @@ qint64 calculateNodeMemoryHiBoundStep(KisNodeSP node,
             node->inherits("KisGroupLayer") ||
             node->inherits("KisAdjustmentLayer");
 
+    const qint64 layersSizeBefore = layersSize;
+    const qint64 projectionsSizeBefore = projectionsSize;
+    const qint64 lodSizeBefore = lodSize;
 
     addDevice(node->paintDevice(), false, devices, memBound, layersSize, projectionsSize, lodSize);
     addDevice(node->original(), originalIsProjection, devices, memBound, layersSize, projectionsSize, lodSize);
     addDevice(node->projection(), true, devices, memBound, layersSize, projectionsSize, lodSize);
 
+    KisMemoryStatisticsServer::Statistics::NodeStatistics nodeStats;
+    nodeStats.name = node->name();
+    nodeStats.level = level;
+    nodeStats.layersSize = layersSize - layersSizeBefore;
+    nodeStats.projectionsSize = projectionsSize - projectionsSizeBefore;
+    nodeStats.lodSize = lodSize - lodSizeBefore;
+    nodeStats.totalSize = memBound;
+    nodeStatistics << nodeStats;
+
     node = node->firstChild();
     while (node) {
         memBound += calculateNodeMemoryHiBoundStep(node, devices,
-                                                   layersSize, projectionsSize, lodSize);
+                                                   layersSize, projectionsSize, lodSize,
+                                                   nodeStatistics, level + 1);
         node = node->nextSibling();
     }
 
@@ -109,7 +124,8 @@ qint64 calculateNodeMemoryHiBoundStep(KisNodeSP node,
 qint64 calculateNodeMemoryHiBound(KisNodeSP node,
                                   qint64 &layersSize,
                                   qint64 &projectionsSize,
-                                  qint64 &lodSize)
+                                  qint64 &lodSize,
+                                  QVector<KisMemoryStatisticsServer::Statistics::NodeStatistics> &nodeStatistics)
 {
     layersSize = 0;
     projectionsSize = 0;
@@ -120,7 +136,9 @@ qint64 calculateNodeMemoryHiBound(KisNodeSP node,
                                           devices,
                                           layersSize,
                                           projectionsSize,
-                                          lodSize);
+                                          lodSize,
+                                          nodeStatistics,
+                                          0);
 }
 
 
@@ -136,7 +154,8 @@ KisMemoryStatisticsServer::fetchMemoryStatistics(KisImageSP image) const
             calculateNodeMemoryHiBound(image->root(),
                                        stats.layersSize,
                                        stats.projectionsSize,
-                                       stats.lodSize);
+                                       stats.lodSize,
+                                       stats.nodeStatistics);
     }
     stats.totalMemorySize = tileStats.totalMemorySize;
     stats.realMemorySize = tileStats.realMemorySize;
@@ -10,6 +10,8 @@
 #include <QtGlobal>
 #include <QObject>
 #include <QScopedPointer>
+#include <QString>
+#include <QVector>
 
 #include "kritaimage_export.h"
 #include "kis_types.h"
@@ -57,6 +59,29 @@ public:
         qint64 tilesHardLimit;
         qint64 tilesSoftLimit;
         qint64 tilesPoolLimit;
+
+        /**
+         * Memory attributed to one node of the image. The sizes cover
+         * only the devices owned by the node itself; a device shared
+         * between several nodes is attributed to the first owner the
+         * traversal meets, so the sizes add up to imageSize without
+         * double-counting.
+         */
+        struct NodeStatistics
+        {
+            QString name;
+            /// depth of the node in the layer stack, for indented display
+            int level = 0;
+
+            qint64 layersSize = 0;
+            qint64 projectionsSize = 0;
+            qint64 lodSize = 0;
+            qint64 totalSize = 0;
+        };
+
+        /// per-node attribution of imageSize, in traversal order
+        /// (root first)
+        QVector<NodeStatistics> nodeStatistics;
     };
 
 
@@ -92,6 +92,13 @@ public:
 
     KisProjectionLeafSP projectionLeaf;
 
+    /**
+     * An EWMA of the measured projection merge cost, in nanoseconds
+     * per kilopixel. Fed by the worker threads of the update
+     * scheduler, so the value is kept in an atomic
+     */
+    QAtomicInt projectionMergeCost;
+
     const KisNode* findSymmetricClone(const KisNode *srcRoot,
                                       const KisNode *dstRoot,
                                       const KisNode *srcTarget);
@@ -251,6 +258,25 @@ KisProjectionLeafSP KisNode::projectionLeaf() const
     return m_d->projectionLeaf;
 }
 
+int KisNode::projectionMergeCost() const
+{
+    return m_d->projectionMergeCost.loadAcquire();
+}
+
+void KisNode::reportProjectionMergeCost(int nsecPerKiloPixel)
+{
+    const int oldCost = m_d->projectionMergeCost.loadAcquire();
+
+    /**
+     * Racy read-modify-write is fine here: a lost update only makes
+     * the average converge a bit slower
+     */
+    const int newCost =
+        oldCost ? oldCost + (nsecPerKiloPixel - oldCost) / 4 : nsecPerKiloPixel;
+
+    m_d->projectionMergeCost.storeRelease(newCost);
+}
+
 void KisNode::setImage(KisImageWSP newImage)
 {
     KisBaseNode::setImage(newImage);
@@ -190,6 +190,24 @@ public:
      */
     virtual KisProjectionLeafSP projectionLeaf() const;
 
+    /**
+     * An exponentially averaged estimate of how expensive it is to
+     * recomposite the projection after a change in this node,
+     * expressed in nanoseconds per kilopixel of the updated area.
+     * Zero means no update has been measured yet.
+     *
+     * The estimate is fed by KisAsyncMerger and used by the update
+     * queue to choose the patch size for the updates of this node: a
+     * clone chain or a heavy layer style may easily cost an order of
+     * magnitude more than a plain paint layer.
+     */
+    int projectionMergeCost() const;
+
+    /**
+     * \internal used by KisAsyncMerger to feed the cost model
+     */
+    void reportProjectionMergeCost(int nsecPerKiloPixel);
+
 
     void setImage(KisImageWSP newImage) override;
 
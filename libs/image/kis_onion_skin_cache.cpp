@@ -25,32 +25,29 @@ struct KisOnionSkinCache::Private
 {
     KisPaintDeviceSP cachedProjection;
 
-    int cacheTime = 0;
     int cacheConfigSeqNo = 0;
-    int framesHash = 0;
+
+    /**
+     * The identity of the skins the cached projection was composed
+     * from: (frameID, opacity) of every contributing keyframe. Keying
+     * the cache on the contributing skins themselves (instead of a
+     * whole-channel hash) keeps the projection alive while the artist
+     * edits the current frame or keyframes outside the skin
+     * neighborhood.
+     */
+    QVector<QPair<int, int>> skinFingerprint;
     QReadWriteLock lock;
 
     bool checkCacheValid(KisPaintDeviceSP source, KisOnionSkinCompositor *compositor) {
-        const KisRasterKeyframeChannel *keyframes = source->keyframeChannel();
-
-        const int time = source->defaultBounds()->currentTime();
-        const KisTimeSpan span = source->keyframeChannel()->identicalFrames(cacheTime);
         const int seqNo = compositor->configSeqNo();
-        const int hash = keyframes->channelHash();
 
-        return span.contains(time) && cacheConfigSeqNo == seqNo && framesHash == hash;
+        return cacheConfigSeqNo == seqNo &&
+            skinFingerprint == compositor->skinFingerprint(source);
     }
 
     void updateCacheMetrics(KisPaintDeviceSP source, KisOnionSkinCompositor *compositor) {
-        const KisRasterKeyframeChannel *keyframes = source->keyframeChannel();
-
-        const int time = source->defaultBounds()->currentTime();
-        const int seqNo = compositor->configSeqNo();
-        const int hash = keyframes->channelHash();
-
-        cacheTime = time;
-        cacheConfigSeqNo = seqNo;
-        framesHash = hash;
+        cacheConfigSeqNo = compositor->configSeqNo();
+        skinFingerprint = compositor->skinFingerprint(source);
     }
 };
 
@@ -175,6 +175,35 @@ void KisOnionSkinCompositor::composite(const KisPaintDeviceSP sourceDevice, KisP
 
 }
 
+QVector<QPair<int, int>> KisOnionSkinCompositor::skinFingerprint(const KisPaintDeviceSP device)
+{
+    QVector<QPair<int, int>> fingerprint;
+
+    KisRasterKeyframeChannel *keyframes = device->keyframeChannel();
+    if (!keyframes) return fingerprint;
+
+    const int time = device->defaultBounds()->currentTime();
+
+    int keyframeTimeBck;
+    int keyframeTimeFwd;
+    keyframeTimeBck = keyframeTimeFwd = keyframes->activeKeyframeTime(time);
+
+    for (int offset = 1; offset <= m_d->numberOfSkins; offset++) {
+        KisRasterKeyframeSP backKeyframe = m_d->getNextFrameToComposite(keyframes, keyframeTimeBck, true);
+        KisRasterKeyframeSP forwardKeyframe = m_d->getNextFrameToComposite(keyframes, keyframeTimeFwd, false);
+
+        if (!backKeyframe.isNull()) {
+            fingerprint << qMakePair(backKeyframe->frameID(), m_d->skinOpacity(-offset));
+        }
+
+        if (!forwardKeyframe.isNull()) {
+            fingerprint << qMakePair(forwardKeyframe->frameID(), m_d->skinOpacity(offset));
+        }
+    }
+
+    return fingerprint;
+}
+
 QRect KisOnionSkinCompositor::calculateFullExtent(const KisPaintDeviceSP device)
 {
     QRect rect;
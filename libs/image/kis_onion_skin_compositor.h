@@ -11,6 +11,8 @@
 #include "kritaimage_export.h"
 
 #include <QObject>
+#include <QVector>
+#include <QPair>
 
 class KRITAIMAGE_EXPORT KisOnionSkinCompositor : public QObject
 {
@@ -29,6 +31,16 @@ public:
 
     QRect updateExtentOnAddition(const KisPaintDeviceSP device, int addedTime);
 
+    /**
+     * Returns the identity of the skins that composite() would paint
+     * for the current time of \p device: the frameID and opacity of
+     * every contributing keyframe, in compositing order. Two equal
+     * fingerprints are guaranteed to produce the same composed planes
+     * (for a fixed tint configuration), which lets KisOnionSkinCache
+     * reuse its projection across edits that don't touch the skins.
+     */
+    QVector<QPair<int, int>> skinFingerprint(const KisPaintDeviceSP device);
+
     int configSeqNo() const;
 
     void setColorLabelFilter(QSet<int> colors);
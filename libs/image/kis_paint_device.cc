@@ -28,6 +28,7 @@
 #include <KoIntegerMaths.h>
 #include <KoMixColorsOp.h>
 #include <KoUpdater.h>
+#include <KisAllocationCensus.h>
 
 #include "kis_image.h"
 #include "kis_random_sub_accessor.h"
@@ -198,6 +199,12 @@ public:
         KIS_SAFE_ASSERT_RECOVER_NOOP(fastBitBltPossible(src));
     }
 
+    void prepareCloneWithContent(KisPaintDeviceSP src)
+    {
+        prepareCloneImpl(src, src->m_d->currentData(), true);
+        KIS_SAFE_ASSERT_RECOVER_NOOP(fastBitBltPossible(src));
+    }
+
     bool fastBitBltPossible(KisPaintDeviceSP src)
     {
         return fastBitBltPossibleImpl(src->m_d->currentData());
@@ -415,10 +422,11 @@ public:
     void uploadFrameData(DataSP srcData, DataSP dstData);
 
     struct LodDataStructImpl;
-    LodDataStruct* createLodDataStruct(int lod);
+    LodDataStruct* createLodDataStruct(int lod, bool seedFromPreviousPlane);
     void updateLodDataStruct(LodDataStruct *dst, const QRect &srcRect);
     void uploadLodDataStruct(LodDataStruct *dst);
     KisRegion regionForLodSyncing() const;
+    bool canSyncLodDataStructIncrementally(int lod) const;
 
     void updateLodDataManager(KisDataManager *srcDataManager,
                               KisDataManager *dstDataManager, const QPoint &srcOffset, const QPoint &dstOffset,
@@ -532,7 +540,7 @@ private:
         return data;
     }
 
-    void prepareCloneImpl(KisPaintDeviceSP src, Data *srcData)
+    void prepareCloneImpl(KisPaintDeviceSP src, Data *srcData, bool copyContent = false)
     {
         /**
          * The result of currentData() depends on the current
@@ -544,7 +552,7 @@ private:
         q->setDefaultBounds(src->defaultBounds());
         q->setSupportsWraparoundMode(src->supportsWraproundMode());
 
-        currentData()->prepareClone(srcData);
+        currentData()->prepareClone(srcData, copyContent);
 
 
         /**
@@ -684,12 +692,48 @@ KisRegion KisPaintDevice::Private::regionForLodSyncing() const
     return srcData->dataManager()->region().translated(srcData->x(), srcData->y());
 }
 
-KisPaintDevice::LodDataStruct* KisPaintDevice::Private::createLodDataStruct(int newLod)
+bool KisPaintDevice::Private::canSyncLodDataStructIncrementally(int lod) const
+{
+    QMutexLocker l(&m_dataSwitchLock);
+
+    /**
+     * When the device is animated, the non-LoD data object changes
+     * together with the current frame, while the LoD plane keeps the
+     * content of the frame it was synced against. We cannot detect
+     * such a switch from the plane's metadata, so animated devices
+     * always do a full resync.
+     */
+    if (!m_frames.isEmpty()) return false;
+
+    Data *srcData = currentNonLodData();
+
+    return m_lodData &&
+        m_lodData->levelOfDetail() == lod &&
+        m_lodData->colorSpace() == srcData->colorSpace() &&
+        m_lodData->x() == KisLodTransform::coordToLodCoord(srcData->x(), lod) &&
+        m_lodData->y() == KisLodTransform::coordToLodCoord(srcData->y(), lod) &&
+        !memcmp(m_lodData->dataManager()->defaultPixel(),
+                srcData->dataManager()->defaultPixel(),
+                srcData->dataManager()->pixelSize());
+}
+
+KisPaintDevice::LodDataStruct* KisPaintDevice::Private::createLodDataStruct(int newLod, bool seedFromPreviousPlane)
 {
     KIS_SAFE_ASSERT_RECOVER_NOOP(newLod > 0);
 
     Data *srcData = currentNonLodData();
 
+    /**
+     * If the existing LoD plane is still valid for \p newLod, seed
+     * the struct with its content (the tiles are shared lazily, so
+     * the copy is cheap). The caller is then responsible for
+     * resyncing every rect changed since the last synchronization.
+     */
+    if (seedFromPreviousPlane && canSyncLodDataStructIncrementally(newLod)) {
+        QMutexLocker l(&m_dataSwitchLock);
+        return new LodDataStructImpl(new Data(q, m_lodData.data(), true));
+    }
+
     Data *lodData = new Data(q, srcData, false);
     LodDataStruct *lodStruct = new LodDataStructImpl(lodData);
 
@@ -1072,6 +1116,10 @@ void KisPaintDevice::init(const KoColorSpace *colorSpace,
     KoColor color = KoColor::createTransparent(colorSpace);
     m_d->init(colorSpace, color.data());
 
+    // count-only event: the tiles are allocated lazily on first write
+    KisAllocationCensus::instance()->
+        recordAllocation(KisAllocationCensus::PaintDevice, 0);
+
     Q_ASSERT(m_d->colorSpace());
 
     setDefaultBounds(defaultBounds);
@@ -1093,6 +1141,10 @@ void KisPaintDevice::makeFullCopyFrom(const KisPaintDevice &rhs, KritaUtils::Dev
     // temporary def. bounds object for the initialization phase only
     m_d->defaultBounds = m_d->transitionalDefaultBounds;
 
+    // count-only event: the cloned tiles are shared copy-on-write
+    KisAllocationCensus::instance()->
+        recordAllocation(KisAllocationCensus::PaintDevice, 0);
+
     // copy data objects with or without frames
     m_d->cloneAllDataObjects(rhs.m_d, copyMode == KritaUtils::CopyAllFrames);
 
@@ -1125,6 +1177,18 @@ void KisPaintDevice::prepareClone(KisPaintDeviceSP src)
 
 void KisPaintDevice::makeCloneFrom(KisPaintDeviceSP src, const QRect &rect)
 {
+    /**
+     * When the rect covers the whole extent of the source, share its
+     * tile directory wholesale instead of walking the tile grid of
+     * the rect: that touches only the tiles that really exist and
+     * never splits the border tiles of the rect into real pixel
+     * copies.
+     */
+    if (rect.contains(src->extent())) {
+        m_d->prepareCloneWithContent(src);
+        return;
+    }
+
     prepareClone(src);
 
     // we guarantee that *this is totally empty, so copy pixels that
@@ -1136,6 +1200,12 @@ void KisPaintDevice::makeCloneFrom(KisPaintDeviceSP src, const QRect &rect)
 
 void KisPaintDevice::makeCloneFromRough(KisPaintDeviceSP src, const QRect &minimalRect)
 {
+    // see the comment in makeCloneFrom()
+    if (minimalRect.contains(src->extent())) {
+        m_d->prepareCloneWithContent(src);
+        return;
+    }
+
     prepareClone(src);
 
     // we guarantee that *this is totally empty, so copy pixels that
@@ -1145,6 +1215,11 @@ void KisPaintDevice::makeCloneFromRough(KisPaintDeviceSP src, const QRect &minim
     fastBitBltRough(src, optimizedRect);
 }
 
+KisPaintDeviceSP KisPaintDevice::createSnapshot() const
+{
+    return new KisPaintDevice(*this, KritaUtils::CopySnapshot, 0);
+}
+
 void KisPaintDevice::setDirty()
 {
     m_d->cache()->invalidate();
@@ -1557,6 +1632,16 @@ bool KisPaintDevice::read(QIODevice *stream)
     return retval;
 }
 
+bool KisPaintDevice::read(QIODevice *stream, const QRect &regionOfInterest)
+{
+    bool retval;
+
+    retval = m_d->dataManager()->read(stream, regionOfInterest);
+    m_d->cache()->invalidate();
+
+    return retval;
+}
+
 void KisPaintDevice::emitColorSpaceChanged()
 {
     Q_EMIT colorSpaceChanged(m_d->colorSpace());
@@ -1978,6 +2063,24 @@ void KisPaintDevice::fastBitBltOldData(KisPaintDeviceSP src, const QRect &rect)
     m_d->currentStrategy()->fastBitBltOldData(src, rect);
 }
 
+bool KisPaintDevice::fastBitBltTranslatedPossible(KisPaintDeviceSP src, const QPoint &offset)
+{
+    return !(offset.x() % KisTileData::WIDTH) &&
+        !(offset.y() % KisTileData::HEIGHT) &&
+        !defaultBounds()->wrapAroundMode() &&
+        m_d->fastBitBltPossible(src);
+}
+
+void KisPaintDevice::fastBitBltTranslated(KisPaintDeviceSP src, const QRect &dstRect, const QPoint &offset)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(fastBitBltTranslatedPossible(src, offset));
+
+    m_d->dataManager()->bitBltTranslated(src->dataManager().data(),
+                                         dstRect.translated(-m_d->x(), -m_d->y()),
+                                         offset);
+    m_d->cache()->invalidate();
+}
+
 void KisPaintDevice::fastBitBltRough(KisPaintDeviceSP src, const QRect &rect)
 {
     m_d->currentStrategy()->fastBitBltRough(src, rect);
@@ -2149,9 +2252,14 @@ KisRegion KisPaintDevice::regionForLodSyncing() const
     return m_d->regionForLodSyncing();
 }
 
-KisPaintDevice::LodDataStruct* KisPaintDevice::createLodDataStruct(int lod)
+bool KisPaintDevice::canSyncLodDataStructIncrementally(int lod) const
+{
+    return m_d->canSyncLodDataStructIncrementally(lod);
+}
+
+KisPaintDevice::LodDataStruct* KisPaintDevice::createLodDataStruct(int lod, bool seedFromPreviousPlane)
 {
-    return m_d->createLodDataStruct(lod);
+    return m_d->createLodDataStruct(lod, seedFromPreviousPlane);
 }
 
 void KisPaintDevice::updateLodDataStruct(LodDataStruct *dst, const QRect &srcRect)
@@ -127,6 +127,14 @@ public:
      */
     bool read(QIODevice *stream);
 
+    /**
+     * Fill this paint device with only the tiles intersecting
+     * \p regionOfInterest, skipping the rest of the stream without
+     * decoding it. Used for loading crops and generating previews of
+     * large documents.
+     */
+    bool read(QIODevice *stream, const QRect &regionOfInterest);
+
 public:
 
     /**
@@ -349,10 +357,22 @@ public:
      */
     void makeCloneFromRough(KisPaintDeviceSP src, const QRect &minimalRect);
 
+    /**
+     * Create a read-only snapshot of the device. The snapshot shares
+     * all the tiles of the current state via copy-on-write, so no
+     * pixel data is copied on creation and the snapshot keeps its
+     * content even when this device is changed afterwards. The
+     * snapshot is detached from the parent node, so it never issues
+     * any updates. Writing to it is technically safe (the shared
+     * tiles would just detach), but defeats its purpose.
+     */
+    KisPaintDeviceSP createSnapshot() const;
+
 
 protected:
     friend class KisPaintDeviceTest;
     friend class DataReaderThread;
+    friend class KisCloneLayer;
 
     /**
      * Checks whether a src paint device can be used as source
@@ -384,6 +404,25 @@ protected:
      */
     void fastBitBltOldData(KisPaintDeviceSP src, const QRect &rect);
 
+    /**
+     * Checks whether \p src can be cloned with
+     * fastBitBltTranslated(): the devices must pass
+     * fastBitBltPossible(), the offset must be aligned to the tile
+     * grid and the device must not be in wrap-around mode
+     */
+    bool fastBitBltTranslatedPossible(KisPaintDeviceSP src, const QPoint &offset);
+
+    /**
+     * Clones \p dstRect from another paint device with the source
+     * shifted by \p offset: dst(x, y) is taken from src(x - dx, y - dy).
+     * Since the offset is aligned to the tile grid, the cloned area
+     * is shared between both paint devices using copy-on-write, just
+     * like in fastBitBlt()
+     *
+     * \see fastBitBltTranslatedPossible
+     */
+    void fastBitBltTranslated(KisPaintDeviceSP src, const QRect &dstRect, const QPoint &offset);
+
     /**
      * Clones rect from another paint device in a rough and fast way.
      * All the tiles touched by rect will be shared, between both
@@ -918,7 +957,25 @@ public:
     };
 
     KisRegion regionForLodSyncing() const;
-    LodDataStruct* createLodDataStruct(int lod);
+
+    /**
+     * Returns true if the LoD plane of the device already holds valid
+     * data for \p lod, so createLodDataStruct() may seed the struct
+     * with the plane's current content and the caller may pass only
+     * the areas changed since the last synchronization to
+     * updateLodDataStruct() instead of the whole
+     * regionForLodSyncing().
+     */
+    bool canSyncLodDataStructIncrementally(int lod) const;
+
+    /**
+     * When \p seedFromPreviousPlane is true (and
+     * canSyncLodDataStructIncrementally() holds), the returned struct
+     * is initialized with the current content of the LoD plane, so
+     * the caller is responsible for updating all the areas changed
+     * since the last synchronization (including the erased ones).
+     */
+    LodDataStruct* createLodDataStruct(int lod, bool seedFromPreviousPlane = false);
     void updateLodDataStruct(LodDataStruct *dst, const QRect &srcRect);
     void uploadLodDataStruct(LodDataStruct *dst);
 
@@ -8,11 +8,18 @@
 #ifndef __KIS_PAINT_DEVICE_DATA_H
 #define __KIS_PAINT_DEVICE_DATA_H
 
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
+
 #include "KisInterstrokeData.h"
 #include "KisSequentialIteratorProgress.h"
 #include "KoAlwaysInline.h"
+#include "kis_algebra_2d.h"
 #include "kis_command_utils.h"
 #include "kundo2command.h"
+#include "tiles3/kis_tile_data_interface.h"
 
 struct DirectDataAccessPolicy {
     DirectDataAccessPolicy(KisDataManager *dataManager, KisIteratorCompleteListener *completionListener)
@@ -164,11 +171,6 @@ public:
                                KUndo2Command *parentCommand,
                                KoUpdater *updater = nullptr)
     {
-        using InternalSequentialConstIterator =
-            KisSequentialIteratorBase<ReadOnlyIteratorPolicy<DirectDataAccessPolicy>, DirectDataAccessPolicy, ProxyBasedProgressPolicy>;
-        using InternalSequentialIterator =
-            KisSequentialIteratorBase<WritableIteratorPolicy<DirectDataAccessPolicy>, DirectDataAccessPolicy, ProxyBasedProgressPolicy>;
-
         if (m_colorSpace == dstColorSpace || *m_colorSpace == *dstColorSpace) {
             return;
         }
@@ -184,27 +186,74 @@ public:
 
 
         if (!rc.isEmpty()) {
-            InternalSequentialConstIterator srcIt(DirectDataAccessPolicy(m_dataManager.data(), cacheInvalidator()), rc, updater);
-            InternalSequentialIterator dstIt(DirectDataAccessPolicy(dstDataManager.data(), cacheInvalidator()), rc, updater);
-
-            int nConseqPixels = srcIt.nConseqPixels();
-
-            // since we are accessing data managers directly, the columns are always aligned
-            KIS_SAFE_ASSERT_RECOVER_NOOP(srcIt.nConseqPixels() == dstIt.nConseqPixels());
-
-            while(srcIt.nextPixels(nConseqPixels) &&
-                  dstIt.nextPixels(nConseqPixels)) {
-
-                nConseqPixels = srcIt.nConseqPixels();
+            struct ConvertBandTask : public QRunnable {
+                ConvertBandTask(KisPaintDeviceData *_q,
+                                KisDataManager *_dstDataManager,
+                                const QRect &_band,
+                                const KoColorSpace *_dstColorSpace,
+                                KoColorConversionTransformation::Intent _renderingIntent,
+                                KoColorConversionTransformation::ConversionFlags _conversionFlags,
+                                QSemaphore *_doneSemaphore)
+                    : q(_q),
+                      dstDataManager(_dstDataManager),
+                      band(_band),
+                      dstColorSpace(_dstColorSpace),
+                      renderingIntent(_renderingIntent),
+                      conversionFlags(_conversionFlags),
+                      doneSemaphore(_doneSemaphore)
+                {
+                }
+
+                void run() override {
+                    // every band owns its transformation, since the backend
+                    // of the shared cached one may keep per-transform state
+                    QScopedPointer<KoColorConversionTransformation> transfo(
+                        q->m_colorSpace->createColorConverter(dstColorSpace, renderingIntent, conversionFlags));
+                    q->convertRectColorSpace(dstDataManager, band,
+                                             dstColorSpace,
+                                             renderingIntent, conversionFlags,
+                                             transfo.data(), nullptr);
+                    doneSemaphore->release();
+                }
+
+            private:
+                KisPaintDeviceData *q;
+                KisDataManager *dstDataManager;
+                QRect band;
+                const KoColorSpace *dstColorSpace;
+                KoColorConversionTransformation::Intent renderingIntent;
+                KoColorConversionTransformation::ConversionFlags conversionFlags;
+                QSemaphore *doneSemaphore;
+            };
+
+            const QVector<QRect> bands = splitIntoConversionBands(rc);
+
+            QSemaphore doneSemaphore;
+
+            for (int i = 1; i < bands.size(); i++) {
+                ConvertBandTask *task =
+                    new ConvertBandTask(this, dstDataManager.data(), bands[i],
+                                        dstColorSpace,
+                                        renderingIntent, conversionFlags,
+                                        &doneSemaphore);
+
+                if (!QThreadPool::globalInstance()->tryStart(task)) {
+                    // the pool is saturated (or we are running on one of
+                    // its worker threads already), so convert the band in
+                    // the calling thread instead of risking a deadlock
+                    task->run();
+                    delete task;
+                }
+            }
 
-                const quint8 *srcData = srcIt.rawDataConst();
-                quint8 *dstData = dstIt.rawData();
+            // the first band is converted in the calling thread, through
+            // the shared transformation pool of KoColorConversionCache
+            convertRectColorSpace(dstDataManager.data(), bands.first(),
+                                  dstColorSpace,
+                                  renderingIntent, conversionFlags,
+                                  nullptr, updater);
 
-                m_colorSpace->convertPixelsTo(srcData, dstData,
-                                              dstColorSpace,
-                                              nConseqPixels,
-                                              renderingIntent, conversionFlags);
-            }
+            doneSemaphore.acquire(bands.size() - 1);
         }
 
         // becomes owned by the parent
@@ -362,6 +411,85 @@ public:
 
 
 private:
+    /**
+     * Convert the pixels of \p rc into \p dstDataManager using \p transfo,
+     * or the shared cached transformation when \p transfo is null
+     */
+    void convertRectColorSpace(KisDataManager *dstDataManager,
+                               const QRect &rc,
+                               const KoColorSpace *dstColorSpace,
+                               KoColorConversionTransformation::Intent renderingIntent,
+                               KoColorConversionTransformation::ConversionFlags conversionFlags,
+                               KoColorConversionTransformation *transfo,
+                               KoUpdater *updater)
+    {
+        using InternalSequentialConstIterator =
+            KisSequentialIteratorBase<ReadOnlyIteratorPolicy<DirectDataAccessPolicy>, DirectDataAccessPolicy, ProxyBasedProgressPolicy>;
+        using InternalSequentialIterator =
+            KisSequentialIteratorBase<WritableIteratorPolicy<DirectDataAccessPolicy>, DirectDataAccessPolicy, ProxyBasedProgressPolicy>;
+
+        InternalSequentialConstIterator srcIt(DirectDataAccessPolicy(m_dataManager.data(), cacheInvalidator()), rc, updater);
+        InternalSequentialIterator dstIt(DirectDataAccessPolicy(dstDataManager, cacheInvalidator()), rc, updater);
+
+        int nConseqPixels = srcIt.nConseqPixels();
+
+        // since we are accessing data managers directly, the columns are always aligned
+        KIS_SAFE_ASSERT_RECOVER_NOOP(srcIt.nConseqPixels() == dstIt.nConseqPixels());
+
+        while(srcIt.nextPixels(nConseqPixels) &&
+              dstIt.nextPixels(nConseqPixels)) {
+
+            nConseqPixels = srcIt.nConseqPixels();
+
+            const quint8 *srcData = srcIt.rawDataConst();
+            quint8 *dstData = dstIt.rawData();
+
+            if (transfo) {
+                transfo->transform(srcData, dstData, nConseqPixels);
+            } else {
+                m_colorSpace->convertPixelsTo(srcData, dstData,
+                                              dstColorSpace,
+                                              nConseqPixels,
+                                              renderingIntent, conversionFlags);
+            }
+        }
+    }
+
+    /**
+     * Split \p rc into bands that can be converted concurrently. The
+     * bands are aligned to the tile grid so that no two workers ever
+     * write to the same row of tiles.
+     */
+    QVector<QRect> splitIntoConversionBands(const QRect &rc) const
+    {
+        QVector<QRect> bands;
+
+        // every band should convert enough pixels to amortize the cost
+        // of creating its own color conversion transformation
+        const qint64 minPixelsPerBand = 64 * 1024;
+        const qint64 area = qint64(rc.width()) * rc.height();
+
+        const int numBands = qMin(qint64(QThread::idealThreadCount()), area / minPixelsPerBand);
+
+        if (numBands < 2) {
+            bands << rc;
+            return bands;
+        }
+
+        const int tileHeight = KisTileData::HEIGHT;
+        const int firstRow = KisAlgebra2D::divideFloor(rc.top(), tileHeight);
+        const int lastRow = KisAlgebra2D::divideFloor(rc.bottom(), tileHeight);
+        const int rowsPerBand = qMax(1, (lastRow - firstRow + numBands) / numBands);
+
+        for (int row = firstRow; row <= lastRow; row += rowsPerBand) {
+            const int top = qMax(rc.top(), row * tileHeight);
+            const int bottom = qMin(rc.bottom(), (row + rowsPerBand) * tileHeight - 1);
+            bands << QRect(rc.left(), top, rc.width(), bottom - top + 1);
+        }
+
+        return bands;
+    }
+
     struct CacheInvalidator : public KisIteratorCompleteListener {
         CacheInvalidator(KisPaintDeviceData *_q) : q(_q) {}
 
@@ -23,8 +23,12 @@
 
 #include <QImage>
 #include <QRect>
+#include <QRunnable>
+#include <QSemaphore>
 #include <QString>
 #include <QStringList>
+#include <QThread>
+#include <QThreadPool>
 #include <kundo2command.h>
 
 #include <kis_debug.h>
@@ -256,11 +260,11 @@ KisPaintDeviceSP KisPainter::convertToAlphaAsPureAlpha(KisPaintDeviceSP src)
     KisSequentialConstIterator srcIt(src, processRect);
     KisSequentialIterator dstIt(dst, processRect);
 
-    while (srcIt.nextPixel() && dstIt.nextPixel()) {
-        const quint8 *srcPtr = srcIt.rawDataConst();
-        quint8 *alpha8Ptr = dstIt.rawData();
+    int nConseqPixels = qMin(srcIt.nConseqPixels(), dstIt.nConseqPixels());
+    while (srcIt.nextPixels(nConseqPixels) && dstIt.nextPixels(nConseqPixels)) {
+        nConseqPixels = qMin(srcIt.nConseqPixels(), dstIt.nConseqPixels());
 
-        *alpha8Ptr = srcCS->opacityU8(srcPtr);
+        srcCS->copyOpacityU8(const_cast<quint8*>(srcIt.rawDataConst()), dstIt.rawData(), nConseqPixels);
     }
 
     return dst;
@@ -655,6 +659,203 @@ void KisPainter::bitBltWithFixedSelection(qint32 dstX, qint32 dstY,
     bitBltWithFixedSelection(dstX, dstY, srcDev, selection, 0, 0, 0, 0, srcWidth, srcHeight);
 }
 
+namespace {
+
+class BitBltBandTask : public QRunnable
+{
+public:
+    BitBltBandTask(KisPaintDeviceSP dstDev,
+                   KisPaintDeviceSP srcDev,
+                   KisSelectionSP selection,
+                   const QString &compositeOpId,
+                   qreal opacity,
+                   qreal flow,
+                   const QBitArray &channelFlags,
+                   KoColorConversionTransformation::Intent renderingIntent,
+                   KoColorConversionTransformation::ConversionFlags conversionFlags,
+                   bool useOldSrcData,
+                   const QRect &dstRect,
+                   const QPoint &srcPoint,
+                   QSemaphore *doneSemaphore)
+        : m_dstDev(dstDev)
+        , m_srcDev(srcDev)
+        , m_selection(selection)
+        , m_compositeOpId(compositeOpId)
+        , m_opacity(opacity)
+        , m_flow(flow)
+        , m_channelFlags(channelFlags)
+        , m_renderingIntent(renderingIntent)
+        , m_conversionFlags(conversionFlags)
+        , m_useOldSrcData(useOldSrcData)
+        , m_dstRect(dstRect)
+        , m_srcPoint(srcPoint)
+        , m_doneSemaphore(doneSemaphore)
+    {
+    }
+
+    void run() override {
+        KisPainter painter(m_dstDev);
+        painter.setCompositeOpId(m_compositeOpId);
+        painter.setOpacityF(m_opacity);
+        painter.setFlow(m_flow);
+        painter.setChannelFlags(m_channelFlags);
+        painter.setRenderingIntent(m_renderingIntent);
+        painter.setColorConversionFlags(m_conversionFlags);
+        if (m_selection) {
+            painter.setSelection(m_selection);
+        }
+
+        const QRect srcRect(m_srcPoint, m_dstRect.size());
+
+        if (m_useOldSrcData) {
+            painter.bitBltOldData(m_dstRect.topLeft(), m_srcDev, srcRect);
+        } else {
+            painter.bitBlt(m_dstRect.topLeft(), m_srcDev, srcRect);
+        }
+
+        m_doneSemaphore->release();
+    }
+
+private:
+    KisPaintDeviceSP m_dstDev;
+    KisPaintDeviceSP m_srcDev;
+    KisSelectionSP m_selection;
+    QString m_compositeOpId;
+    qreal m_opacity;
+    qreal m_flow;
+    QBitArray m_channelFlags;
+    KoColorConversionTransformation::Intent m_renderingIntent;
+    KoColorConversionTransformation::ConversionFlags m_conversionFlags;
+    bool m_useOldSrcData;
+    QRect m_dstRect;
+    QPoint m_srcPoint;
+    QSemaphore *m_doneSemaphore;
+};
+
+}
+
+bool KisPainter::tryBitBltParallel(qint32 dstX, qint32 dstY,
+                                   const KisPaintDeviceSP srcDev,
+                                   qint32 srcX, qint32 srcY,
+                                   qint32 srcWidth, qint32 srcHeight,
+                                   bool useOldSrcData)
+{
+    const int tileHeight = KisTileData::HEIGHT;
+
+    // below this band size the dispatch overhead eats the speedup
+    const qint64 minPixelsPerBand = 256 * 256;
+
+    const qint64 area = qint64(srcWidth) * srcHeight;
+
+    const int numBands = qMin(qint64(QThread::idealThreadCount()),
+                              qMin(qint64(srcHeight / tileHeight),
+                                   area / minPixelsPerBand));
+    if (numBands < 2) return false;
+
+    /**
+     * The bands are aligned to the tile grid of the destination
+     * device, so that no two tasks ever write to the same tile
+     * concurrently. The source device is only read, therefore sharing
+     * its border tiles between the bands is fine.
+     */
+    const int yOffset = d->device->y();
+    const int bandHeight = qMax(1, (srcHeight / numBands) / tileHeight) * tileHeight;
+
+    QVector<QRect> bands;
+    const qint32 dstBottom = dstY + srcHeight - 1;
+    qint32 y = dstY;
+    while (y <= dstBottom) {
+        const qint32 nextBoundary =
+            (KisAlgebra2D::divideFloor(y - yOffset, bandHeight) + 1) * bandHeight + yOffset;
+        const qint32 bottom = qMin(dstBottom, nextBoundary - 1);
+        bands << QRect(dstX, y, srcWidth, bottom - y + 1);
+        y = bottom + 1;
+    }
+
+    if (bands.size() < 2) return false;
+
+    QSemaphore doneSemaphore;
+
+    for (int i = 1; i < bands.size(); i++) {
+        const QRect &band = bands[i];
+
+        BitBltBandTask *task =
+            new BitBltBandTask(d->device, srcDev, d->selection,
+                               d->compositeOpId,
+                               d->paramInfo.opacity,
+                               d->paramInfo.flow,
+                               d->paramInfo.channelFlags,
+                               d->renderingIntent, d->conversionFlags,
+                               useOldSrcData,
+                               band,
+                               QPoint(srcX, srcY + (band.y() - dstY)),
+                               &doneSemaphore);
+
+        if (!QThreadPool::globalInstance()->tryStart(task)) {
+            // The pool is saturated (or we are running on one of its
+            // worker threads already), so composite the band in place
+            // instead of risking a deadlock on the semaphore
+            task->run();
+            delete task;
+        }
+    }
+
+    // the first band is composited in the calling thread
+    BitBltBandTask firstBand(d->device, srcDev, d->selection,
+                             d->compositeOpId,
+                             d->paramInfo.opacity,
+                             d->paramInfo.flow,
+                             d->paramInfo.channelFlags,
+                             d->renderingIntent, d->conversionFlags,
+                             useOldSrcData,
+                             bands.first(),
+                             QPoint(srcX, srcY),
+                             &doneSemaphore);
+    firstBand.run();
+
+    doneSemaphore.acquire(bands.size());
+
+    addDirtyRect(QRect(dstX, dstY, srcWidth, srcHeight));
+    return true;
+}
+
+namespace {
+
+enum MaskRunType {
+    MaskRunEmpty,
+    MaskRunFull,
+    MaskRunPartial
+};
+
+/**
+ * Checks whether an alpha8 selection block is uniformly deselected,
+ * uniformly selected or mixed. Exits on the first pixel proving the
+ * run partial, so mixed blocks (the selection border) cost almost
+ * nothing to classify.
+ */
+MaskRunType classifyMaskRun(const quint8 *data, qint32 rowStride, qint32 rows, qint32 cols)
+{
+    const quint8 first = *data;
+
+    if (first != quint8(MIN_SELECTED) && first != quint8(MAX_SELECTED)) {
+        return MaskRunPartial;
+    }
+
+    for (qint32 y = 0; y < rows; y++) {
+        const quint8 *row = data + y * rowStride;
+
+        for (qint32 x = 0; x < cols; x++) {
+            if (row[x] != first) {
+                return MaskRunPartial;
+            }
+        }
+    }
+
+    return first == quint8(MIN_SELECTED) ? MaskRunEmpty : MaskRunFull;
+}
+
+}
+
 template <bool useOldSrcData>
 void KisPainter::bitBltImpl(qint32 dstX, qint32 dstY,
                             const KisPaintDeviceSP srcDev,
@@ -697,6 +898,14 @@ void KisPainter::bitBltImpl(qint32 dstX, qint32 dstY,
                                    &dstX, &dstY)) return;
     }
 
+    if (d->parallelBlitting &&
+        srcDev != d->device &&
+        !srcDev->defaultBounds()->wrapAroundMode() &&
+        tryBitBltParallel(dstX, dstY, srcDev, srcX, srcY,
+                          srcWidth, srcHeight, useOldSrcData)) {
+        return;
+    }
+
     qint32 dstY_ = dstY;
     qint32 srcY_ = srcY;
     qint32 rowsRemaining = srcHeight;
@@ -714,6 +923,8 @@ void KisPainter::bitBltImpl(qint32 dstX, qint32 dstY,
         KisPaintDeviceSP selectionProjection(d->selection->projection());
         KisRandomConstAccessorSP maskIt = selectionProjection->createRandomConstAccessorNG();
 
+        const bool canClassifyMaskRuns = selectionProjection->pixelSize() == 1;
+
         while (rowsRemaining > 0) {
 
             qint32 dstX_ = dstX;
@@ -737,25 +948,44 @@ void KisPainter::bitBltImpl(qint32 dstX, qint32 dstY,
                 columns = qMin(columns, numContiguousSelColumns);
                 columns = qMin(columns, columnsRemaining);
 
-                qint32 srcRowStride = srcIt->rowStride(srcX_, srcY_);
-                srcIt->moveTo(srcX_, srcY_);
-
-                qint32 dstRowStride = dstIt->rowStride(dstX_, dstY_);
-                dstIt->moveTo(dstX_, dstY_);
-
                 qint32 maskRowStride = maskIt->rowStride(dstX_, dstY_);
                 maskIt->moveTo(dstX_, dstY_);
+                const quint8 *maskRowStart = static_cast<KisRandomAccessor2*>(maskIt.data())->rawData();
+
+                /**
+                 * Classify the selection run covering this block: a
+                 * fully deselected run leaves the destination
+                 * untouched, so the composite (and the copy-on-write
+                 * detach of the destination tile) can be skipped
+                 * entirely, while a fully selected run takes the
+                 * unmasked fast path. The scan is a single pass over
+                 * one byte per pixel with an early exit, much cheaper
+                 * than routing every pixel through the mask
+                 * multiplication of the composite op.
+                 */
+                MaskRunType maskRun = MaskRunPartial;
+                if (canClassifyMaskRuns) {
+                    maskRun = classifyMaskRun(maskRowStart, maskRowStride, rows, columns);
+                }
 
-                d->paramInfo.dstRowStart   = dstIt->rawData();
-                d->paramInfo.dstRowStride  = dstRowStride;
-                // if we don't use the oldRawData, we need to access the rawData of the source device.
-                d->paramInfo.srcRowStart   = useOldSrcData ? srcIt->oldRawData() : static_cast<KisRandomAccessor2*>(srcIt.data())->rawData();
-                d->paramInfo.srcRowStride  = srcRowStride;
-                d->paramInfo.maskRowStart  = static_cast<KisRandomAccessor2*>(maskIt.data())->rawData();
-                d->paramInfo.maskRowStride = maskRowStride;
-                d->paramInfo.rows          = rows;
-                d->paramInfo.cols          = columns;
-                d->colorSpace->bitBlt(srcDev->colorSpace(), d->paramInfo, compositeOp, d->renderingIntent, d->conversionFlags);
+                if (maskRun != MaskRunEmpty) {
+                    qint32 srcRowStride = srcIt->rowStride(srcX_, srcY_);
+                    srcIt->moveTo(srcX_, srcY_);
+
+                    qint32 dstRowStride = dstIt->rowStride(dstX_, dstY_);
+                    dstIt->moveTo(dstX_, dstY_);
+
+                    d->paramInfo.dstRowStart   = dstIt->rawData();
+                    d->paramInfo.dstRowStride  = dstRowStride;
+                    // if we don't use the oldRawData, we need to access the rawData of the source device.
+                    d->paramInfo.srcRowStart   = useOldSrcData ? srcIt->oldRawData() : static_cast<KisRandomAccessor2*>(srcIt.data())->rawData();
+                    d->paramInfo.srcRowStride  = srcRowStride;
+                    d->paramInfo.maskRowStart  = maskRun == MaskRunFull ? 0 : maskRowStart;
+                    d->paramInfo.maskRowStride = maskRun == MaskRunFull ? 0 : maskRowStride;
+                    d->paramInfo.rows          = rows;
+                    d->paramInfo.cols          = columns;
+                    d->colorSpace->bitBlt(srcDev->colorSpace(), d->paramInfo, compositeOp, d->renderingIntent, d->conversionFlags);
+                }
 
                 srcX_ += columns;
                 dstX_ += columns;
@@ -2890,6 +3120,16 @@ KisRunnableStrokeJobsInterface *KisPainter::runnableStrokeJobsInterface() const
     return d->runnableStrokeJobsInterface;
 }
 
+void KisPainter::setParallelBlitting(bool enable)
+{
+    d->parallelBlitting = enable;
+}
+
+bool KisPainter::parallelBlitting() const
+{
+    return d->parallelBlitting;
+}
+
 void KisPainter::renderMirrorMaskSafe(QRect rc, KisFixedPaintDeviceSP dab, bool preserveDab)
 {
     if (!d->mirrorHorizontally && !d->mirrorVertically) return;
@@ -859,6 +859,23 @@ public:
      */
     KisRunnableStrokeJobsInterface* runnableStrokeJobsInterface() const;
 
+    /**
+     * When enabled, bitBlt() splits blits that are larger than an
+     * internal threshold into tile-aligned bands that are composited
+     * in parallel on the global thread pool. The call still returns
+     * only when the whole rect has been composited.
+     *
+     * The mode is off by default, because bitBlt() is usually called
+     * from the update scheduler workers, which saturate all the cores
+     * already. Enable it for big single-threaded blits only, like
+     * merging or flattening layers, and make sure no other thread
+     * accesses the destination area concurrently.
+     */
+    void setParallelBlitting(bool enable);
+
+    /// \see setParallelBlitting()
+    bool parallelBlitting() const;
+
 protected:
     /// Initialize, set everything to '0' or defaults
     void init();
@@ -891,6 +908,12 @@ private:
                         qint32 srcX, qint32 srcY,
                         qint32 srcWidth, qint32 srcHeight);
 
+    bool tryBitBltParallel(qint32 dstX, qint32 dstY,
+                           const KisPaintDeviceSP srcDev,
+                           qint32 srcX, qint32 srcY,
+                           qint32 srcWidth, qint32 srcHeight,
+                           bool useOldSrcData);
+
     inline void compositeOnePixel(quint8 *dst, const KoColor &color);
 
 private:
@@ -60,6 +60,7 @@ struct Q_DECL_HIDDEN KisPainter::Private {
     bool                        mirrorHorizontally {false};
     bool                        mirrorVertically {false};
     bool                        isOpacityUnit {true}; // TODO: move into ParameterInfo
+    bool                        parallelBlitting {false};
     KoCompositeOp::ParameterInfo paramInfo;
     KoColorConversionTransformation::Intent renderingIntent {KoColorConversionTransformation::IntentPerceptual};
     KoColorConversionTransformation::ConversionFlags conversionFlags {KoColorConversionTransformation::Empty};
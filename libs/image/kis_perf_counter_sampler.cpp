@@ -0,0 +1,267 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_perf_counter_sampler.h"
+
+#include <atomic>
+
+#include <QFile>
+#include <QGlobalStatic>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+
+#ifdef Q_OS_LINUX
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+Q_GLOBAL_STATIC(KisPerfCounterSampler, s_instance)
+
+namespace {
+
+enum CounterIndex {
+    Cycles = 0,
+    CacheMisses,
+    BranchMisses,
+
+    NumCounters
+};
+
+/**
+ * The per-thread file descriptors of the perf_event counters. The
+ * counters count only the owning thread, so each worker opens its own
+ * set lazily on the first sampled job.
+ */
+struct ThreadCounters {
+    bool initialized = false;
+    int fds[NumCounters] = {-1, -1, -1};
+
+    ~ThreadCounters() {
+#ifdef Q_OS_LINUX
+        for (int i = 0; i < NumCounters; i++) {
+            if (fds[i] >= 0) {
+                close(fds[i]);
+            }
+        }
+#endif
+    }
+};
+
+thread_local ThreadCounters threadCounters;
+
+#ifdef Q_OS_LINUX
+
+int openCounter(quint64 config)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    // pid = 0, cpu = -1: this thread, on any cpu
+    return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+void ensureThreadCounters()
+{
+    if (threadCounters.initialized) return;
+    threadCounters.initialized = true;
+
+    static const quint64 configs[NumCounters] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES
+    };
+
+    /**
+     * Opening may fail on restricted perf_event_paranoid settings or
+     * inside containers; in that case the sampler silently degrades
+     * to walltime-only aggregation.
+     */
+    for (int i = 0; i < NumCounters; i++) {
+        threadCounters.fds[i] = openCounter(configs[i]);
+    }
+}
+
+bool readThreadCounters(qint64 *values)
+{
+    ensureThreadCounters();
+
+    bool haveCounters = false;
+    for (int i = 0; i < NumCounters; i++) {
+        values[i] = -1;
+        if (threadCounters.fds[i] < 0) continue;
+
+        qint64 value = 0;
+        if (read(threadCounters.fds[i], &value, sizeof(value)) == sizeof(value)) {
+            values[i] = value;
+            haveCounters = true;
+        }
+    }
+    return haveCounters;
+}
+
+#else /* !Q_OS_LINUX */
+
+bool readThreadCounters(qint64 *values)
+{
+    for (int i = 0; i < NumCounters; i++) {
+        values[i] = -1;
+    }
+    return false;
+}
+
+#endif
+
+} // namespace
+
+struct Q_DECL_HIDDEN KisPerfCounterSampler::Private
+{
+    Private()
+    {
+        dumpFileName =
+            QString::fromLocal8Bit(qgetenv("KRITA_PERF_COUNTERS"));
+        enabled = !dumpFileName.isEmpty();
+    }
+
+    QString dumpFileName;
+    std::atomic<bool> enabled {false};
+
+    mutable QMutex mutex;
+    QHash<QString, Counters> aggregatedCounters;
+};
+
+KisPerfCounterSampler::JobScope::JobScope(const QString &strategyName)
+{
+    KisPerfCounterSampler *sampler = KisPerfCounterSampler::instance();
+    if (strategyName.isEmpty() || !sampler->isEnabled()) return;
+
+    m_key = strategyName;
+    m_active = true;
+    readThreadCounters(m_before);
+    m_timer.start();
+}
+
+KisPerfCounterSampler::JobScope::~JobScope()
+{
+    if (!m_active) return;
+
+    const qint64 walltimeUsecs = m_timer.nsecsElapsed() / 1000;
+
+    qint64 after[NumCounters];
+    readThreadCounters(after);
+
+    Counters delta;
+    delta.jobs = 1;
+    delta.walltimeUsecs = walltimeUsecs;
+    if (m_before[Cycles] >= 0 && after[Cycles] >= 0) {
+        delta.cycles = after[Cycles] - m_before[Cycles];
+    }
+    if (m_before[CacheMisses] >= 0 && after[CacheMisses] >= 0) {
+        delta.cacheMisses = after[CacheMisses] - m_before[CacheMisses];
+    }
+    if (m_before[BranchMisses] >= 0 && after[BranchMisses] >= 0) {
+        delta.branchMisses = after[BranchMisses] - m_before[BranchMisses];
+    }
+
+    KisPerfCounterSampler::instance()->reportSample(m_key, delta);
+}
+
+KisPerfCounterSampler::KisPerfCounterSampler()
+    : m_d(new Private)
+{
+}
+
+KisPerfCounterSampler::~KisPerfCounterSampler()
+{
+    if (m_d->enabled && !m_d->dumpFileName.isEmpty()) {
+        dumpJson(m_d->dumpFileName);
+    }
+    delete m_d;
+}
+
+KisPerfCounterSampler* KisPerfCounterSampler::instance()
+{
+    return s_instance;
+}
+
+bool KisPerfCounterSampler::isEnabled() const
+{
+    return m_d->enabled.load(std::memory_order_relaxed);
+}
+
+void KisPerfCounterSampler::setEnabled(bool value)
+{
+    m_d->enabled.store(value, std::memory_order_relaxed);
+}
+
+void KisPerfCounterSampler::reportSample(const QString &key, const Counters &delta)
+{
+    QMutexLocker locker(&m_d->mutex);
+
+    Counters &sum = m_d->aggregatedCounters[key];
+    sum.jobs += delta.jobs;
+    sum.walltimeUsecs += delta.walltimeUsecs;
+
+    if (delta.cycles >= 0) {
+        sum.cycles = qMax<qint64>(sum.cycles, 0) + delta.cycles;
+    }
+    if (delta.cacheMisses >= 0) {
+        sum.cacheMisses = qMax<qint64>(sum.cacheMisses, 0) + delta.cacheMisses;
+    }
+    if (delta.branchMisses >= 0) {
+        sum.branchMisses = qMax<qint64>(sum.branchMisses, 0) + delta.branchMisses;
+    }
+}
+
+QMap<QString, KisPerfCounterSampler::Counters> KisPerfCounterSampler::aggregatedCounters() const
+{
+    QMutexLocker locker(&m_d->mutex);
+
+    QMap<QString, Counters> result;
+    for (auto it = m_d->aggregatedCounters.constBegin();
+         it != m_d->aggregatedCounters.constEnd(); ++it) {
+
+        result.insert(it.key(), it.value());
+    }
+    return result;
+}
+
+bool KisPerfCounterSampler::dumpJson(const QString &fileName) const
+{
+    const QMap<QString, Counters> counters = aggregatedCounters();
+
+    QJsonObject strategies;
+    for (auto it = counters.constBegin(); it != counters.constEnd(); ++it) {
+        QJsonObject object;
+        object["jobs"] = it.value().jobs;
+        object["walltimeUsecs"] = it.value().walltimeUsecs;
+        object["cycles"] = it.value().cycles;
+        object["cacheMisses"] = it.value().cacheMisses;
+        object["branchMisses"] = it.value().branchMisses;
+        strategies[it.key()] = object;
+    }
+
+    QJsonObject root;
+    root["strokeStrategies"] = strategies;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    file.write(QJsonDocument(root).toJson());
+    return true;
+}
@@ -0,0 +1,86 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __KIS_PERF_COUNTER_SAMPLER_H
+#define __KIS_PERF_COUNTER_SAMPLER_H
+
+#include <QElapsedTimer>
+#include <QMap>
+#include <QString>
+
+#include "kritaimage_export.h"
+
+/**
+ * Samples hardware performance counters (cycles, cache misses, branch
+ * misses) around the execution of stroke jobs and aggregates them per
+ * stroke strategy. On Linux the counters are read through perf_event;
+ * where perf_event is unavailable (other platforms, or restricted
+ * perf_event_paranoid settings) only the walltime is recorded, so the
+ * aggregation still tells which strategy the time went to.
+ *
+ * Sampling is disabled by default; set the KRITA_PERF_COUNTERS
+ * environment variable to the name of an output file to enable it.
+ * The aggregated counters are dumped into that file as JSON when the
+ * application exits.
+ */
+class KRITAIMAGE_EXPORT KisPerfCounterSampler
+{
+public:
+    struct Counters {
+        qint64 jobs = 0;
+        qint64 walltimeUsecs = 0;
+
+        /// -1 when the platform provides no hardware counters
+        qint64 cycles = -1;
+        qint64 cacheMisses = -1;
+        qint64 branchMisses = -1;
+    };
+
+    /**
+     * Samples the counters of the current thread for the lifetime of
+     * the scope and reports the deltas under the given strategy name.
+     * A no-op when the sampler is disabled or the name is empty, so
+     * it is safe to keep on the jobs' hot path.
+     */
+    class KRITAIMAGE_EXPORT JobScope
+    {
+    public:
+        JobScope(const QString &strategyName);
+        ~JobScope();
+
+    private:
+        QString m_key;
+        bool m_active {false};
+        qint64 m_before[3];
+        QElapsedTimer m_timer;
+    };
+
+public:
+    KisPerfCounterSampler();
+    ~KisPerfCounterSampler();
+    static KisPerfCounterSampler* instance();
+
+    bool isEnabled() const;
+    void setEnabled(bool value);
+
+    /// Returns the aggregated counters keyed by stroke strategy name
+    QMap<QString, Counters> aggregatedCounters() const;
+
+    /**
+     * Dumps the aggregated counters into \p fileName as JSON
+     */
+    bool dumpJson(const QString &fileName) const;
+
+private:
+    friend class JobScope;
+    void reportSample(const QString &key, const Counters &delta);
+
+private:
+    struct Private;
+    Private * const m_d;
+};
+
+#endif /* __KIS_PERF_COUNTER_SAMPLER_H */
@@ -12,6 +12,10 @@
 #include "kis_perspectivetransform_worker.h"
 
 #include <QMatrix4x4>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
 #include <QTransform>
 #include <QVector3D>
 #include <QPolygonF>
@@ -31,6 +35,7 @@
 #include "kis_painter.h"
 #include "kis_image.h"
 #include "kis_algebra_2d.h"
+#include "tiles3/kis_tile_data.h"
 
 
 KisPerspectiveTransformWorker::KisPerspectiveTransformWorker(KisPaintDeviceSP dev, QPointF center, double aX, double aY, double distance, bool cropDst, KoUpdaterPtr progress)
@@ -143,6 +148,164 @@ struct NearestNeighbourWrapper
     int m_pixelSize;
 };
 
+namespace {
+
+/**
+ * Maps one band of destination rects through the backward transform.
+ * Every task owns its accessors; the shared source device is only
+ * read through the old data interface.
+ */
+template <class SrcAccessorWrapper>
+class PerspectiveBandTask : public QRunnable
+{
+public:
+    PerspectiveBandTask(KisPaintDeviceSP srcDev, KisPaintDeviceSP dstDev,
+                        const QTransform &backwardTransform,
+                        const QRectF &srcClipRect,
+                        bool wrapAround,
+                        const QVector<QRect> &rects,
+                        QSemaphore *doneSemaphore)
+        : m_srcDev(srcDev),
+          m_dstDev(dstDev),
+          m_backwardTransform(backwardTransform),
+          m_srcClipRect(srcClipRect),
+          m_wrapAround(wrapAround),
+          m_rects(rects),
+          m_doneSemaphore(doneSemaphore)
+    {
+    }
+
+    void run() override {
+        SrcAccessorWrapper srcAcc(m_srcDev);
+        KisRandomAccessorSP accessor = m_dstDev->createRandomAccessorNG();
+
+        Q_FOREACH (const QRect &rect, m_rects) {
+            for (int y = rect.y(); y < rect.y() + rect.height(); ++y) {
+                for (int x = rect.x(); x < rect.x() + rect.width(); ++x) {
+
+                    QPointF dstPoint(x, y);
+                    QPointF srcPoint = m_backwardTransform.map(dstPoint);
+
+                    if (m_srcClipRect.contains(srcPoint) || m_wrapAround) {
+                        accessor->moveTo(dstPoint.x(), dstPoint.y());
+                        srcAcc.samplePixel(srcPoint, accessor->rawData());
+                    }
+                }
+            }
+        }
+
+        m_doneSemaphore->release();
+    }
+
+private:
+    KisPaintDeviceSP m_srcDev;
+    KisPaintDeviceSP m_dstDev;
+    QTransform m_backwardTransform;
+    QRectF m_srcClipRect;
+    bool m_wrapAround;
+    QVector<QRect> m_rects;
+    QSemaphore *m_doneSemaphore;
+};
+
+}
+
+template <class SrcAccessorWrapper>
+void KisPerspectiveTransformWorker::transformDstRects(KisPaintDeviceSP srcDev,
+                                                      KisPaintDeviceSP dstDev,
+                                                      const QRectF &srcClipRect,
+                                                      bool wrapAround,
+                                                      const QVector<QRect> &rects)
+{
+    // below this total area the dispatch overhead eats the speedup
+    const qint64 minPixelsPerBand = 256 * 256;
+
+    qint64 area = 0;
+    Q_FOREACH (const QRect &rect, rects) {
+        area += qint64(rect.width()) * rect.height();
+    }
+
+    /**
+     * The bands are aligned to the tile grid of the destination
+     * device, so no two tasks ever write to the same tile
+     * concurrently. The source device is only read through the old
+     * data interface, which stays stable even when srcDev and dstDev
+     * are the same device.
+     */
+    QMap<int, QVector<QRect>> bands;
+
+    if (area / minPixelsPerBand >= 2 && QThread::idealThreadCount() >= 2) {
+        const int tileHeight = KisTileData::HEIGHT;
+        const int yOffset = dstDev->y();
+
+        Q_FOREACH (const QRect &rect, rects) {
+            int y = rect.y();
+            const int bottom = rect.y() + rect.height() - 1;
+
+            while (y <= bottom) {
+                const int bandIndex = KisAlgebra2D::divideFloor(y - yOffset, tileHeight);
+                const int bandBottom = qMin(bottom, (bandIndex + 1) * tileHeight + yOffset - 1);
+                bands[bandIndex] << QRect(rect.x(), y, rect.width(), bandBottom - y + 1);
+                y = bandBottom + 1;
+            }
+        }
+    }
+
+    if (bands.size() >= 2) {
+        QSemaphore doneSemaphore;
+        int numTasks = 0;
+
+        Q_FOREACH (const QVector<QRect> &bandRects, bands) {
+            PerspectiveBandTask<SrcAccessorWrapper> *task =
+                new PerspectiveBandTask<SrcAccessorWrapper>(srcDev, dstDev,
+                                                            m_backwardTransform,
+                                                            srcClipRect, wrapAround,
+                                                            bandRects,
+                                                            &doneSemaphore);
+            numTasks++;
+
+            if (!QThreadPool::globalInstance()->tryStart(task)) {
+                // the pool is saturated (or we are running on one of
+                // its worker threads already), so map the band in the
+                // calling thread
+                task->run();
+                delete task;
+            }
+        }
+
+        KisProgressUpdateHelper progressHelper(m_progressUpdater, 100, numTasks);
+        for (int i = 0; i < numTasks; i++) {
+            doneSemaphore.acquire();
+            progressHelper.step();
+        }
+    } else {
+        int numLines = 0;
+        Q_FOREACH (const QRect &rect, rects) {
+            numLines += rect.height();
+        }
+
+        KisProgressUpdateHelper progressHelper(m_progressUpdater, 100, numLines);
+
+        SrcAccessorWrapper srcAcc(srcDev);
+        KisRandomAccessorSP accessor = dstDev->createRandomAccessorNG();
+
+        Q_FOREACH (const QRect &rect, rects) {
+            for (int y = rect.y(); y < rect.y() + rect.height(); ++y) {
+                for (int x = rect.x(); x < rect.x() + rect.width(); ++x) {
+
+                    QPointF dstPoint(x, y);
+                    QPointF srcPoint = m_backwardTransform.map(dstPoint);
+
+                    if (srcClipRect.contains(srcPoint) || wrapAround) {
+                        accessor->moveTo(dstPoint.x(), dstPoint.y());
+                        srcAcc.samplePixel(srcPoint, accessor->rawData());
+                    }
+                }
+            }
+            progressHelper.step();
+        }
+    }
+}
+
 template <class SrcAccessorWrapper>
 void KisPerspectiveTransformWorker::runImpl()
 {
@@ -167,26 +330,7 @@ void KisPerspectiveTransformWorker::runImpl()
 
     KIS_ASSERT_RECOVER_NOOP(!m_isIdentity);
 
-    KisProgressUpdateHelper progressHelper(m_progressUpdater, 100, m_dstRegion.rectCount());
-
-    SrcAccessorWrapper srcAcc(cloneDevice);
-    KisRandomAccessorSP accessor = m_dev->createRandomAccessorNG();
-
-    Q_FOREACH (const QRect &rect, m_dstRegion.rects()) {
-        for (int y = rect.y(); y < rect.y() + rect.height(); ++y) {
-            for (int x = rect.x(); x < rect.x() + rect.width(); ++x) {
-
-                QPointF dstPoint(x, y);
-                QPointF srcPoint = m_backwardTransform.map(dstPoint);
-
-                if (m_srcRect.contains(srcPoint)) {
-                    accessor->moveTo(dstPoint.x(), dstPoint.y());
-                    srcAcc.samplePixel(srcPoint, accessor->rawData());
-                }
-            }
-        }
-        progressHelper.step();
-    }
+    transformDstRects<SrcAccessorWrapper>(cloneDevice, m_dev, m_srcRect, false, m_dstRegion.rects());
 }
 
 void KisPerspectiveTransformWorker::run(SampleType sampleType)
@@ -213,25 +357,9 @@ void KisPerspectiveTransformWorker::runPartialDst(KisPaintDeviceSP srcDev,
         gc.setCompositeOpId(COMPOSITE_COPY);
         gc.bitBlt(dstRect.topLeft(), srcDev, m_backwardTransform.mapRect(dstRect));
     } else {
-        KisProgressUpdateHelper progressHelper(m_progressUpdater, 100, dstRect.height());
-
-        KisRandomSubAccessorSP srcAcc = srcDev->createRandomSubAccessor();
-        KisRandomAccessorSP accessor = dstDev->createRandomAccessorNG();
-
-        for (int y = dstRect.y(); y < dstRect.y() + dstRect.height(); ++y) {
-            for (int x = dstRect.x(); x < dstRect.x() + dstRect.width(); ++x) {
-
-                QPointF dstPoint(x, y);
-                QPointF srcPoint = m_backwardTransform.map(dstPoint);
-
-                if (srcClipRect.contains(srcPoint) || srcDev->defaultBounds()->wrapAroundMode()) {
-                    accessor->moveTo(dstPoint.x(), dstPoint.y());
-                    srcAcc->moveTo(srcPoint.x(), srcPoint.y());
-                    srcAcc->sampledOldRawData(accessor->rawData());
-                }
-            }
-            progressHelper.step();
-        }
+        transformDstRects<BilinearWrapper>(srcDev, dstDev, srcClipRect,
+                                           srcDev->defaultBounds()->wrapAroundMode(),
+                                           {dstRect});
     }
 }
 
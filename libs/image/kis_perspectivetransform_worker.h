@@ -54,6 +54,18 @@ private:
     template <class SrcAccessorPolicy>
     void runImpl();
 
+    /**
+     * Maps the \p rects of \p dstDev from \p srcDev using the
+     * backward transform. Big jobs are decomposed into bands of tile
+     * rows and processed on the global thread pool.
+     */
+    template <class SrcAccessorPolicy>
+    void transformDstRects(KisPaintDeviceSP srcDev,
+                           KisPaintDeviceSP dstDev,
+                           const QRectF &srcClipRect,
+                           bool wrapAround,
+                           const QVector<QRect> &rects);
+
 private:
     KisPaintDeviceSP m_dev;
     KoUpdaterPtr m_progressUpdater;
@@ -169,11 +169,11 @@ void KisPixelSelection::copyAlphaFrom(KisPaintDeviceSP src, const QRect &process
     KisSequentialConstIterator srcIt(src, processRect);
     KisSequentialIterator dstIt(this, processRect);
 
-    while (srcIt.nextPixel() && dstIt.nextPixel()) {
-        const quint8 *srcPtr = srcIt.rawDataConst();
-        quint8 *alpha8Ptr = dstIt.rawData();
+    int nConseqPixels = qMin(srcIt.nConseqPixels(), dstIt.nConseqPixels());
+    while (srcIt.nextPixels(nConseqPixels) && dstIt.nextPixels(nConseqPixels)) {
+        nConseqPixels = qMin(srcIt.nConseqPixels(), dstIt.nConseqPixels());
 
-        *alpha8Ptr = srcCS->opacityU8(srcPtr);
+        srcCS->copyOpacityU8(const_cast<quint8*>(srcIt.rawDataConst()), dstIt.rawData(), nConseqPixels);
     }
 
     m_d->outlineCacheValid = false;
@@ -420,10 +420,15 @@ QVector<QPolygon> KisPixelSelection::outline() const
         selectionExtent &= defaultBounds()->bounds();
     }
 
-    qint32 xOffset = selectionExtent.x();
-    qint32 yOffset = selectionExtent.y();
-    qint32 width = selectionExtent.width();
-    qint32 height = selectionExtent.height();
+    return outline(selectionExtent);
+}
+
+QVector<QPolygon> KisPixelSelection::outline(const QRect &rect) const
+{
+    qint32 xOffset = rect.x();
+    qint32 yOffset = rect.y();
+    qint32 width = rect.width();
+    qint32 height = rect.height();
 
     KisOutlineGenerator generator(colorSpace(), MIN_SELECTED);
     // If the selection is small using a buffer is much faster
@@ -500,6 +505,45 @@ void KisPixelSelection::recalculateOutlineCache()
     m_d->outlineCacheValid = true;
 }
 
+void KisPixelSelection::recalculateOutlineCache(const QRect &rect)
+{
+    QMutexLocker locker(&m_d->outlineCacheMutex);
+
+    /**
+     * An invalid cache is regenerated as a whole by the next full
+     * recalculation request, so there is nothing to splice into here
+     */
+    if (!m_d->outlineCacheValid) return;
+
+    QRect updateRect = rect;
+    if (*defaultPixel().data() != MIN_SELECTED) {
+        updateRect &= defaultBounds()->bounds();
+    }
+
+    if (updateRect.isEmpty()) return;
+
+    /**
+     * The cache stores the filled region of the selection, so cutting
+     * the edited rect out of it and uniting the freshly traced region
+     * of the same rect yields the up-to-date path. The pixels outside
+     * the rect are unchanged, therefore the seams between the two
+     * parts cancel out during the union.
+     */
+    QPainterPath rectPath;
+    rectPath.addRect(updateRect);
+
+    QPainterPath tracedPath;
+    Q_FOREACH (const QPolygon &polygon, outline(updateRect)) {
+        tracedPath.addPolygon(polygon);
+
+        // see the comment in recalculateOutlineCache()
+        tracedPath.closeSubpath();
+    }
+
+    m_d->outlineCache = (m_d->outlineCache - rectPath) + tracedPath;
+    m_d->thumbnailImageValid = false;
+}
+
 bool KisPixelSelection::thumbnailImageValid() const
 {
     return m_d->thumbnailImageValid;
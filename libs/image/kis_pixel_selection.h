@@ -104,6 +104,12 @@ public:
      */
     QVector<QPolygon> outline() const;
 
+    /**
+     * @brief outline returns the outline of the selection limited to \p rect
+     * @return a vector of polygons that can be used to draw the outline
+     */
+    QVector<QPolygon> outline(const QRect &rect) const;
+
     /**
      * Overridden from KisPaintDevice to handle outline cache moves
      */
@@ -115,6 +121,16 @@ public:
     bool outlineCacheValid() const override;
     void recalculateOutlineCache() override;
 
+    /**
+     * Incrementally update a valid outline cache after an edit that
+     * changed the pixels inside \p rect only: the rect is cut out of
+     * the cached path and the outline re-traced inside it is spliced
+     * back in. When the cache is not valid the call is a no-op, the
+     * cache will be regenerated as a whole by the next full
+     * recalculation.
+     */
+    void recalculateOutlineCache(const QRect &rect);
+
     void setOutlineCache(const QPainterPath &cache);
     void invalidateOutlineCache();
 
@@ -22,6 +22,7 @@ public:
                                       qreal exponent);
     ~KisPolygonalGradientShapeStrategy() override;
 
+    using KisGradientShapeStrategy::valueAt;
     double valueAt(double x, double y) const override;
 
     static QPointF testingCalculatePathCenter(int numSamples, const QPainterPath &path, qreal exponent, bool searchForMax);
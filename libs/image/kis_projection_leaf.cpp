@@ -282,19 +282,23 @@ bool KisProjectionLeaf::visible() const
 {
     if (m_d->isTemporaryHidden || isDroppedNode()) return false;
 
-    // TODO: check opacity as well!
+    /**
+     * A pass-through group is never rendered itself: its children are
+     * hoisted into the parent's leaf sequence instead. Bail out
+     * before the ancestor walk below, which is pure overhead for the
+     * (numerous) group leaves of a deeply nested organization.
+     */
+    if (m_d->checkThisPassThrough()) return false;
 
-    bool hiddenByParentPassThrough = false;
+    // TODO: check opacity as well!
 
     KisNodeSP node = m_d->node->parent();
     while (node && node->projectionLeaf()->m_d->checkThisPassThrough()) {
-        hiddenByParentPassThrough |= !node->visible();
+        if (!node->visible()) return false;
         node = node->parent();
     }
 
-    return (m_d->node->visible(false) || m_d->node->isIsolatedRoot()) &&
-        !m_d->checkThisPassThrough() &&
-        !hiddenByParentPassThrough;
+    return m_d->node->visible(false) || m_d->node->isIsolatedRoot();
 }
 
 quint8 KisProjectionLeaf::opacity() const
@@ -566,31 +566,34 @@ void KisGrowSelectionFilter::process(KisPixelSelectionSP pixelSelection, const Q
         * in both filters
         */
 
-    quint8  **buf;  // caches the region's pixel data
-    quint8  **max;  // caches the largest values for each column
+    const qint32 width = rect.width();
+    const qint32 rowStride = width + 2 * m_xRadius;
+
+    quint8 **buf;     // caches the region's pixel data
+    quint8 **rowMax;  // rowMax[j][x] caches the largest value of the
+                      // column of pixels (x, y - j) .. (x, y + j)
 
-    max = new quint8* [rect.width() + 2 * m_xRadius];
     buf = new quint8* [m_yRadius + 1];
     for (qint32 i = 0; i < m_yRadius + 1; i++) {
-        buf[i] = new quint8[rect.width()];
+        buf[i] = new quint8[width];
     }
-    quint8* buffer = new quint8[(rect.width() + 2 * m_xRadius) *(m_yRadius + 1)];
-    for (qint32 i = 0; i < rect.width() + 2 * m_xRadius; i++) {
-        if (i < m_xRadius)
-            max[i] = buffer;
-        else if (i < rect.width() + m_xRadius)
-            max[i] = &buffer[(m_yRadius + 1) * (i - m_xRadius)];
-        else
-            max[i] = &buffer[(m_yRadius + 1) * (rect.width() + m_xRadius - 1)];
 
-        for (qint32 j = 0; j < m_xRadius + 1; j++)
-            max[i][j] = 0;
+    /**
+     * The column maximums are stored as contiguous scanlines (one per
+     * window size) instead of per-column arrays, so that the update
+     * pass below becomes a plain bytewise maximum of whole scanlines,
+     * which the compiler turns into SIMD code.
+     */
+    quint8* buffer = new quint8[rowStride * (m_yRadius + 1)];
+    memset(buffer, 0, rowStride * (m_yRadius + 1));
+    rowMax = new quint8* [m_yRadius + 1];
+    for (qint32 j = 0; j < m_yRadius + 1; j++) {
+        /* offset the rows by m_xRadius so their range
+            is [-m_xRadius] to [region->w + m_xRadius] */
+        rowMax[j] = &buffer[rowStride * j] + m_xRadius;
     }
-    /* offset the max pointer by m_xRadius so the range of the array
-        is [-m_xRadius] to [region->w + m_xRadius] */
-    max += m_xRadius;
 
-    quint8* out = new quint8[ rect.width()];  // holds the new scan line we are computing
+    quint8* out = new quint8[width];  // holds the new scan line we are computing
 
     qint32* circ = new qint32[ 2 * m_xRadius + 1 ]; // holds the y coords of the filter's mask
     computeBorder(circ, m_xRadius, m_yRadius);
@@ -599,34 +602,45 @@ void KisGrowSelectionFilter::process(KisPixelSelectionSP pixelSelection, const Q
         is [-m_xRadius] to [m_xRadius] */
     circ += m_xRadius;
 
-    memset(buf[0], 0, rect.width());
+    memset(buf[0], 0, width);
     for (qint32 i = 0; i < m_yRadius && i < rect.height(); i++) { // load top of image
-        pixelSelection->readBytes(buf[i + 1], rect.x(), rect.y() + i, rect.width(), 1);
+        pixelSelection->readBytes(buf[i + 1], rect.x(), rect.y() + i, width, 1);
     }
 
-    for (qint32 x = 0; x < rect.width() ; x++) { // set up max for top of image
-        max[x][0] = 0;         // buf[0][x] is always 0
-        max[x][1] = buf[1][x]; // MAX (buf[1][x], max[x][0]) always = buf[1][x]
-        for (qint32 j = 2; j < m_yRadius + 1; j++) {
-            max[x][j] = MAX(buf[j][x], max[x][j-1]);
+    // set up rowMax for top of image
+    memset(rowMax[0], 0, width);      // buf[0][x] is always 0
+    memcpy(rowMax[1], buf[1], width); // MAX (buf[1][x], rowMax[0][x]) always = buf[1][x]
+    for (qint32 j = 2; j < m_yRadius + 1; j++) {
+        for (qint32 x = 0; x < width; x++) {
+            rowMax[j][x] = MAX(buf[j][x], rowMax[j-1][x]);
         }
     }
 
     for (qint32 y = 0; y < rect.height(); y++) {
         rotatePointers(buf, m_yRadius + 1);
         if (y < rect.height() - (m_yRadius))
-            pixelSelection->readBytes(buf[m_yRadius], rect.x(), rect.y() + y + m_yRadius, rect.width(), 1);
+            pixelSelection->readBytes(buf[m_yRadius], rect.x(), rect.y() + y + m_yRadius, width, 1);
         else
-            memset(buf[m_yRadius], 0, rect.width());
-        for (qint32 x = 0; x < rect.width(); x++) { /* update max array */
-            for (qint32 i = m_yRadius; i > 0; i--) {
-                max[x][i] = MAX(MAX(max[x][i - 1], buf[i - 1][x]), buf[i][x]);
+            memset(buf[m_yRadius], 0, width);
+        for (qint32 j = m_yRadius; j > 0; j--) { /* update the column maximums */
+            const quint8 *prevMax = rowMax[j - 1]; // still holds the previous scanline's values
+            const quint8 *bufAbove = buf[j - 1];
+            const quint8 *bufBelow = buf[j];
+            quint8 *dst = rowMax[j];
+
+            for (qint32 x = 0; x < width; x++) {
+                dst[x] = MAX(MAX(prevMax[x], bufAbove[x]), bufBelow[x]);
             }
-            max[x][0] = buf[0][x];
         }
-        qint32 last_max = max[0][circ[-1]];
+        memcpy(rowMax[0], buf[0], width);
+        for (qint32 j = 0; j < m_yRadius + 1; j++) {
+            /* pixels to the left of the region replicate the first
+                column; pixels to the right of it stay empty */
+            memset(rowMax[j] - m_xRadius, rowMax[j][0], m_xRadius);
+        }
+        qint32 last_max = rowMax[circ[-1]][0];
         qint32 last_index = 1;
-        for (qint32 x = 0; x < rect.width(); x++) { /* render scan line */
+        for (qint32 x = 0; x < width; x++) { /* render scan line */
             last_index--;
             if (last_index >= 0) {
                 if (last_max == 255)
@@ -634,32 +648,31 @@ void KisGrowSelectionFilter::process(KisPixelSelectionSP pixelSelection, const Q
                 else {
                     last_max = 0;
                     for (qint32 i = m_xRadius; i >= 0; i--)
-                        if (last_max < max[x + i][circ[i]]) {
-                            last_max = max[x + i][circ[i]];
+                        if (last_max < rowMax[circ[i]][x + i]) {
+                            last_max = rowMax[circ[i]][x + i];
                             last_index = i;
                         }
                     out[x] = last_max;
                 }
             } else {
                 last_index = m_xRadius;
-                last_max = max[x + m_xRadius][circ[m_xRadius]];
+                last_max = rowMax[circ[m_xRadius]][x + m_xRadius];
                 for (qint32 i = m_xRadius - 1; i >= -m_xRadius; i--)
-                    if (last_max < max[x + i][circ[i]]) {
-                        last_max = max[x + i][circ[i]];
+                    if (last_max < rowMax[circ[i]][x + i]) {
+                        last_max = rowMax[circ[i]][x + i];
                         last_index = i;
                     }
                 out[x] = last_max;
             }
         }
-        pixelSelection->writeBytes(out, rect.x(), rect.y() + y, rect.width(), 1);
+        pixelSelection->writeBytes(out, rect.x(), rect.y() + y, width, 1);
     }
-    /* undo the offsets to the pointers so we can free the malloced memory */
+    /* undo the offset to the pointer so we can free the malloced memory */
     circ -= m_xRadius;
-    max -= m_xRadius;
 
     delete[] circ;
     delete[] buffer;
-    delete[] max;
+    delete[] rowMax;
     for (qint32 i = 0; i < m_yRadius + 1; i++)
         delete[] buf[i];
     delete[] buf;
@@ -696,44 +709,44 @@ void KisShrinkSelectionFilter::process(KisPixelSelectionSP pixelSelection, const
         we are passed are identical to the edge pixels.
         If edge_lock is false, we assume that pixels outside the region are 0
     */
-    quint8  **buf;  // caches the region's pixels
-    quint8  **max;  // caches the smallest values for each column
+    const qint32 width = rect.width();
+    const qint32 rowStride = width + 2 * m_xRadius;
+
+    quint8  **buf;     // caches the region's pixels
+    quint8  **rowMin;  // rowMin[j][x] caches the smallest value of the
+                       // column of pixels (x, y - j) .. (x, y + j)
     qint32    last_max, last_index;
 
-    max = new quint8* [rect.width() + 2 * m_xRadius];
     buf = new quint8* [m_yRadius + 1];
     for (qint32 i = 0; i < m_yRadius + 1; i++) {
-        buf[i] = new quint8[rect.width()];
+        buf[i] = new quint8[width];
     }
 
-    qint32 buffer_size = (rect.width() + 2 * m_xRadius + 1) * (m_yRadius + 1);
-    quint8* buffer = new quint8[buffer_size];
+    /**
+     * The column minimums are stored as contiguous scanlines (one per
+     * window size) instead of per-column arrays, so that the update
+     * pass below becomes a plain bytewise minimum of whole scanlines,
+     * which the compiler turns into SIMD code.
+     */
+    quint8* buffer = new quint8[rowStride * (m_yRadius + 1)];
 
+    /* pixels outside the region are full (and thus never shrink the
+        selection) with edge lock, and empty without it; the right
+        border keeps these initial values, the left one is refreshed
+        every scanline for the edge lock case */
     if (m_edgeLock)
-        memset(buffer, 255, buffer_size);
+        memset(buffer, 255, rowStride * (m_yRadius + 1));
     else
-        memset(buffer, 0, buffer_size);
+        memset(buffer, 0, rowStride * (m_yRadius + 1));
 
-    for (qint32 i = 0; i < rect.width() + 2 * m_xRadius; i++) {
-        if (i < m_xRadius)
-            if (m_edgeLock)
-                max[i] = buffer;
-            else
-                max[i] = &buffer[(m_yRadius + 1) * (rect.width() + m_xRadius)];
-        else if (i < rect.width() + m_xRadius)
-            max[i] = &buffer[(m_yRadius + 1) * (i - m_xRadius)];
-        else if (m_edgeLock)
-            max[i] = &buffer[(m_yRadius + 1) * (rect.width() + m_xRadius - 1)];
-        else
-            max[i] = &buffer[(m_yRadius + 1) * (rect.width() + m_xRadius)];
+    rowMin = new quint8* [m_yRadius + 1];
+    for (qint32 j = 0; j < m_yRadius + 1; j++) {
+        /* offset the rows by m_xRadius so their range
+            is [-m_xRadius] to [region->w + m_xRadius] */
+        rowMin[j] = &buffer[rowStride * j] + m_xRadius;
     }
-    if (!m_edgeLock)
-        for (qint32 j = 0 ; j < m_xRadius + 1; j++) max[0][j] = 0;
-
-    // offset the max pointer by m_xRadius so the range of the array is [-m_xRadius] to [region->w + m_xRadius]
-    max += m_xRadius;
 
-    quint8* out = new quint8[rect.width()]; // holds the new scan line we are computing
+    quint8* out = new quint8[width]; // holds the new scan line we are computing
 
     qint32* circ = new qint32[2 * m_xRadius + 1]; // holds the y coords of the filter's mask
 
@@ -743,39 +756,52 @@ void KisShrinkSelectionFilter::process(KisPixelSelectionSP pixelSelection, const
     circ += m_xRadius;
 
     for (qint32 i = 0; i < m_yRadius && i < rect.height(); i++) // load top of image
-        pixelSelection->readBytes(buf[i + 1], rect.x(), rect.y() + i, rect.width(), 1);
+        pixelSelection->readBytes(buf[i + 1], rect.x(), rect.y() + i, width, 1);
 
     if (m_edgeLock)
-        memcpy(buf[0], buf[1], rect.width());
+        memcpy(buf[0], buf[1], width);
     else
-        memset(buf[0], 0, rect.width());
+        memset(buf[0], 0, width);
 
 
-    for (qint32 x = 0; x < rect.width(); x++) { // set up max for top of image
-        max[x][0] = buf[0][x];
-        for (qint32 j = 1; j < m_yRadius + 1; j++)
-            max[x][j] = MIN(buf[j][x], max[x][j-1]);
+    // set up rowMin for top of image
+    memcpy(rowMin[0], buf[0], width);
+    for (qint32 j = 1; j < m_yRadius + 1; j++) {
+        for (qint32 x = 0; x < width; x++) {
+            rowMin[j][x] = MIN(buf[j][x], rowMin[j-1][x]);
+        }
     }
 
     for (qint32 y = 0; y < rect.height(); y++) {
         rotatePointers(buf, m_yRadius + 1);
         if (y < rect.height() - m_yRadius)
-            pixelSelection->readBytes(buf[m_yRadius], rect.x(), rect.y() + y + m_yRadius, rect.width(), 1);
+            pixelSelection->readBytes(buf[m_yRadius], rect.x(), rect.y() + y + m_yRadius, width, 1);
         else if (m_edgeLock)
-            memcpy(buf[m_yRadius], buf[m_yRadius - 1], rect.width());
+            memcpy(buf[m_yRadius], buf[m_yRadius - 1], width);
         else
-            memset(buf[m_yRadius], 0, rect.width());
+            memset(buf[m_yRadius], 0, width);
+
+        for (qint32 j = m_yRadius; j > 0; j--) { // update the column minimums
+            const quint8 *prevMin = rowMin[j - 1]; // still holds the previous scanline's values
+            const quint8 *bufAbove = buf[j - 1];
+            const quint8 *bufBelow = buf[j];
+            quint8 *dst = rowMin[j];
 
-        for (qint32 x = 0 ; x < rect.width(); x++) { // update max array
-            for (qint32 i = m_yRadius; i > 0; i--) {
-                max[x][i] = MIN(MIN(max[x][i - 1], buf[i - 1][x]), buf[i][x]);
+            for (qint32 x = 0; x < width; x++) {
+                dst[x] = MIN(MIN(prevMin[x], bufAbove[x]), bufBelow[x]);
             }
-            max[x][0] = buf[0][x];
         }
-        last_max =  max[0][circ[-1]];
+        memcpy(rowMin[0], buf[0], width);
+        if (m_edgeLock) {
+            // pixels to the left of the region replicate the first column
+            for (qint32 j = 0; j < m_yRadius + 1; j++) {
+                memset(rowMin[j] - m_xRadius, rowMin[j][0], m_xRadius);
+            }
+        }
+        last_max =  rowMin[circ[-1]][0];
         last_index = 0;
 
-        for (qint32 x = 0 ; x < rect.width(); x++) { // render scan line
+        for (qint32 x = 0 ; x < width; x++) { // render scan line
             last_index--;
             if (last_index >= 0) {
                 if (last_max == 0)
@@ -783,33 +809,32 @@ void KisShrinkSelectionFilter::process(KisPixelSelectionSP pixelSelection, const
                 else {
                     last_max = 255;
                     for (qint32 i = m_xRadius; i >= 0; i--)
-                        if (last_max > max[x + i][circ[i]]) {
-                            last_max = max[x + i][circ[i]];
+                        if (last_max > rowMin[circ[i]][x + i]) {
+                            last_max = rowMin[circ[i]][x + i];
                             last_index = i;
                         }
                     out[x] = last_max;
                 }
             } else {
                 last_index = m_xRadius;
-                last_max = max[x + m_xRadius][circ[m_xRadius]];
+                last_max = rowMin[circ[m_xRadius]][x + m_xRadius];
                 for (qint32 i = m_xRadius - 1; i >= -m_xRadius; i--)
-                    if (last_max > max[x + i][circ[i]]) {
-                        last_max = max[x + i][circ[i]];
+                    if (last_max > rowMin[circ[i]][x + i]) {
+                        last_max = rowMin[circ[i]][x + i];
                         last_index = i;
                     }
                 out[x] = last_max;
             }
         }
-        pixelSelection->writeBytes(out, rect.x(), rect.y() + y, rect.width(), 1);
+        pixelSelection->writeBytes(out, rect.x(), rect.y() + y, width, 1);
     }
 
-    // undo the offsets to the pointers so we can free the malloced memory
+    // undo the offset to the pointer so we can free the malloced memory
     circ -= m_xRadius;
-    max -= m_xRadius;
 
     delete[] circ;
     delete[] buffer;
-    delete[] max;
+    delete[] rowMin;
     for (qint32 i = 0; i < m_yRadius + 1; i++)
         delete[] buf[i];
     delete[] buf;
@@ -9,9 +9,14 @@
 #include <QMutexLocker>
 #include <QVector>
 
+#include <cmath>
+
+#include "kis_node.h"
 #include "kis_image_config.h"
 #include "kis_full_refresh_walker.h"
 #include "kis_spontaneous_job.h"
+#include "kis_algebra_2d.h"
+#include "tiles3/kis_tile_data.h"
 
 
 //#define ENABLE_DEBUG_JOIN
@@ -68,6 +73,8 @@ void KisSimpleUpdateQueue::updateSettings()
     m_maxCollectAlpha = config.maxCollectAlpha();
     m_maxMergeAlpha = config.maxMergeAlpha();
     m_maxMergeCollectAlpha = config.maxMergeCollectAlpha();
+    m_smallUpdateCoalescingArea = config.smallUpdateCoalescingArea();
+    m_maxNumberOfThreads = config.maxNumberOfThreads();
 }
 
 int KisSimpleUpdateQueue::overrideLevelOfDetail() const
@@ -79,6 +86,8 @@ void KisSimpleUpdateQueue::processQueue(KisUpdaterContext &updaterContext)
 {
     updaterContext.lock();
 
+    splitQueuedJobs(updaterContext);
+
     while(updaterContext.hasSpareThread() &&
           processOneJob(updaterContext));
 
@@ -146,6 +155,100 @@ bool KisSimpleUpdateQueue::processOneJob(KisUpdaterContext &updaterContext)
     return jobAdded;
 }
 
+void KisSimpleUpdateQueue::splitQueuedJobs(KisUpdaterContext &updaterContext)
+{
+    QMutexLocker locker(&m_lock);
+
+    /**
+     * The jobs were already split into patches of a reasonable size
+     * when they were added, but at the tail of an update pass there
+     * may still be fewer of them than we have idle threads, e.g. when
+     * tryMergeJob() coalesced neighbouring updates. A running walker
+     * cannot be subdivided anymore, so keep halving the biggest
+     * *queued* walkers until every spare thread has something to pick
+     * up (or the pieces become as small as a single tile row/column).
+     */
+
+    qint32 numMergeJobs = 0;
+    qint32 numStrokeJobs = 0;
+    updaterContext.getJobsSnapshot(numMergeJobs, numStrokeJobs);
+
+    qint32 numSpareThreads =
+        updaterContext.threadsLimit() - numMergeJobs - numStrokeJobs;
+
+    const int currentLevelOfDetail = updaterContext.currentLevelOfDetail();
+
+    qint32 numQueuedJobs = 0;
+    Q_FOREACH (KisBaseRectsWalkerSP item, m_updatesList) {
+        if (currentLevelOfDetail < 0 ||
+            currentLevelOfDetail == item->levelOfDetail()) {
+
+            numQueuedJobs++;
+        }
+    }
+
+    while (numQueuedJobs > 0 && numQueuedJobs < numSpareThreads) {
+        KisBaseRectsWalkerSP candidate;
+        qint64 candidateArea = 0;
+        int candidateIndex = -1;
+
+        for (int i = 0; i < m_updatesList.size(); i++) {
+            KisBaseRectsWalkerSP item = m_updatesList[i];
+
+            if (currentLevelOfDetail >= 0 &&
+                currentLevelOfDetail != item->levelOfDetail()) continue;
+
+            if (item->type() == KisBaseRectsWalker::UNSUPPORTED) continue;
+
+            const QRect rc = item->requestedRect();
+            if (qMax(rc.width(), rc.height()) < 2 * KisTileData::WIDTH) continue;
+
+            const qint64 area = qint64(rc.width()) * rc.height();
+            if (area > candidateArea) {
+                candidate = item;
+                candidateArea = area;
+                candidateIndex = i;
+            }
+        }
+
+        if (!candidate) break;
+
+        /**
+         * Cut along the longer side, aligning the seam to the tile
+         * grid so that the two concurrent mergers don't ping-pong the
+         * border tiles between each other
+         */
+        const QRect rc = candidate->requestedRect();
+        QRect firstHalf;
+        QRect secondHalf;
+
+        if (rc.width() >= rc.height()) {
+            const qint32 mid = KisAlgebra2D::divideFloor(rc.left() + rc.width() / 2,
+                                                         KisTileData::WIDTH) * KisTileData::WIDTH;
+            firstHalf = QRect(rc.left(), rc.top(), mid - rc.left(), rc.height());
+            secondHalf = QRect(mid, rc.top(), rc.left() + rc.width() - mid, rc.height());
+        } else {
+            const qint32 mid = KisAlgebra2D::divideFloor(rc.top() + rc.height() / 2,
+                                                         KisTileData::HEIGHT) * KisTileData::HEIGHT;
+            firstHalf = QRect(rc.left(), rc.top(), rc.width(), mid - rc.top());
+            secondHalf = QRect(rc.left(), mid, rc.width(), rc.top() + rc.height() - mid);
+        }
+
+        KisBaseRectsWalkerSP walker =
+            createWalker(candidate->type(), candidate->cropRect(),
+                         candidate->clonesDontInvalidateFrames());
+
+        m_overrideLevelOfDetail = candidate->levelOfDetail();
+        walker->collectRects(candidate->startNode(), secondHalf);
+        candidate->collectRects(candidate->startNode(), firstHalf);
+        m_overrideLevelOfDetail = -1;
+
+        m_updatesList.insert(candidateIndex + 1, walker);
+
+        numQueuedJobs++;
+    }
+}
+
 void KisSimpleUpdateQueue::addUpdateJob(KisNodeSP node, const QVector<QRect> &rects, const QRect &cropRect, int levelOfDetail, KisProjectionUpdateFlags flags)
 {
     KisBaseRectsWalker::UpdateType type =
@@ -165,7 +268,26 @@ void KisSimpleUpdateQueue::addFullRefreshJob(KisNodeSP node, const QVector<QRect
         KisBaseRectsWalker::FULL_REFRESH :
         KisBaseRectsWalker::FULL_REFRESH_NO_FILTHY;
 
-    addJob(node, rects, cropRect, levelOfDetail,
+    /**
+     * A full refresh recomposes the whole node stack, so the fixed
+     * cost of a walker (a traversal of the entire node graph) is much
+     * higher than for an incremental update. Instead of the generic
+     * square patches the requested area is planned into tile-aligned
+     * column bands, just enough to saturate the threads of the
+     * updater context: the bands are disjoint, so the mergers run
+     * concurrently, and every completed band publishes its part of
+     * the canvas right away.
+     */
+    QVector<QRect> bandedRects;
+    Q_FOREACH (const QRect &rc, rects) {
+        if (rc.width() > m_patchWidth || rc.height() > m_patchHeight) {
+            bandedRects << splitIntoColumnBands(rc);
+        } else {
+            bandedRects.append(rc);
+        }
+    }
+
+    addJob(node, bandedRects, cropRect, levelOfDetail,
            type,
            flags.testFlag(KisProjectionUpdateFlag::DontInvalidateFrames));
 }
@@ -191,54 +313,101 @@ void KisSimpleUpdateQueue::addJob(KisNodeSP node, const QVector<QRect> &rects,
     Q_FOREACH (const QRect &rc, rects) {
         if (rc.isEmpty()) continue;
 
-        KisBaseRectsWalkerSP walker;
-
         if(trySplitJob(node, rc, cropRect, levelOfDetail, type, dontInvalidateFrames)) continue;
         if(tryMergeJob(node, rc, cropRect, levelOfDetail, type, dontInvalidateFrames)) continue;
 
-        if (type == KisBaseRectsWalker::UPDATE) {
-            KisMergeWalker::Flags flags = KisMergeWalker::DEFAULT;
-            if (dontInvalidateFrames) {
-                flags |= KisMergeWalker::CLONES_DONT_INVALIDATE_FRAMES;
-            }
+        KisBaseRectsWalkerSP walker =
+            createWalker(type, cropRect, dontInvalidateFrames);
 
-            walker = new KisMergeWalker(cropRect, flags);
+        walker->collectRects(node, rc);
+        walkers.append(walker);
+    }
+
+    if (!walkers.isEmpty()) {
+        m_lock.lock();
+        m_updatesList.append(walkers);
+        m_lock.unlock();
+    }
+}
+
+KisBaseRectsWalkerSP KisSimpleUpdateQueue::createWalker(KisBaseRectsWalker::UpdateType type,
+                                                        const QRect &cropRect,
+                                                        bool dontInvalidateFrames)
+{
+    KisBaseRectsWalkerSP walker;
+
+    if (type == KisBaseRectsWalker::UPDATE) {
+        KisMergeWalker::Flags flags = KisMergeWalker::DEFAULT;
+        if (dontInvalidateFrames) {
+            flags |= KisMergeWalker::CLONES_DONT_INVALIDATE_FRAMES;
         }
-        else if (type == KisBaseRectsWalker::FULL_REFRESH)  {
-            KisFullRefreshWalker::Flags flags = KisFullRefreshWalker::None;
-            if (dontInvalidateFrames) {
-                flags |= KisFullRefreshWalker::ClonesDontInvalidateFrames;
-            }
 
-            walker = new KisFullRefreshWalker(cropRect, flags);
+        walker = new KisMergeWalker(cropRect, flags);
+    }
+    else if (type == KisBaseRectsWalker::FULL_REFRESH)  {
+        KisFullRefreshWalker::Flags flags = KisFullRefreshWalker::None;
+        if (dontInvalidateFrames) {
+            flags |= KisFullRefreshWalker::ClonesDontInvalidateFrames;
         }
-        else if (type == KisBaseRectsWalker::UPDATE_NO_FILTHY) {
-            KisMergeWalker::Flags flags = KisMergeWalker::NO_FILTHY;
-            if (dontInvalidateFrames) {
-                flags |= KisMergeWalker::CLONES_DONT_INVALIDATE_FRAMES;
-            }
 
-            walker = new KisMergeWalker(cropRect, flags);
+        walker = new KisFullRefreshWalker(cropRect, flags);
+    }
+    else if (type == KisBaseRectsWalker::UPDATE_NO_FILTHY) {
+        KisMergeWalker::Flags flags = KisMergeWalker::NO_FILTHY;
+        if (dontInvalidateFrames) {
+            flags |= KisMergeWalker::CLONES_DONT_INVALIDATE_FRAMES;
         }
-        else if (type == KisBaseRectsWalker::FULL_REFRESH_NO_FILTHY)  {
-            KisFullRefreshWalker::Flags flags = KisFullRefreshWalker::NoFilthyMode;
-            if (dontInvalidateFrames) {
-                flags |= KisFullRefreshWalker::ClonesDontInvalidateFrames;
-            }
 
-            walker = new KisFullRefreshWalker(cropRect, KisFullRefreshWalker::NoFilthyMode);
+        walker = new KisMergeWalker(cropRect, flags);
+    }
+    else if (type == KisBaseRectsWalker::FULL_REFRESH_NO_FILTHY)  {
+        KisFullRefreshWalker::Flags flags = KisFullRefreshWalker::NoFilthyMode;
+        if (dontInvalidateFrames) {
+            flags |= KisFullRefreshWalker::ClonesDontInvalidateFrames;
         }
-        /* else if(type == KisBaseRectsWalker::UNSUPPORTED) fatalKrita; */
 
-        walker->collectRects(node, rc);
-        walkers.append(walker);
+        walker = new KisFullRefreshWalker(cropRect, flags);
     }
+    /* else if(type == KisBaseRectsWalker::UNSUPPORTED) fatalKrita; */
 
-    if (!walkers.isEmpty()) {
-        m_lock.lock();
-        m_updatesList.append(walkers);
-        m_lock.unlock();
+    return walker;
+}
+
+QVector<QRect> KisSimpleUpdateQueue::splitIntoColumnBands(const QRect &rc) const
+{
+    QVector<QRect> bands;
+
+    if (rc.isEmpty()) return bands;
+
+    /**
+     * Twice as many bands as threads: when the bands carry an unequal
+     * amount of work (which is common, e.g. when the detail of the
+     * image is localized), the threads that finish early pick up the
+     * remaining bands instead of idling
+     */
+    const qint32 idealNumBands = 2 * m_maxNumberOfThreads;
+
+    qint32 bandWidth = (rc.width() + idealNumBands - 1) / idealNumBands;
+    bandWidth = (bandWidth + KisTileData::WIDTH - 1) /
+        KisTileData::WIDTH * KisTileData::WIDTH;
+
+    qint32 x = rc.left();
+    const qint32 right = rc.left() + rc.width();
+
+    while (x < right) {
+        /**
+         * The seams are aligned to the tile grid, so that the
+         * concurrent mergers don't share the border tiles
+         */
+        qint32 seam = KisAlgebra2D::divideFloor(x, KisTileData::WIDTH) *
+            KisTileData::WIDTH + bandWidth;
+        seam = qMin(seam, right);
+
+        bands.append(QRect(x, rc.top(), seam - x, rc.height()));
+        x = seam;
     }
+
+    return bands;
 }
 
 void KisSimpleUpdateQueue::addSpontaneousJob(KisSpontaneousJob *spontaneousJob)
@@ -280,23 +449,78 @@ bool KisSimpleUpdateQueue::trySplitJob(KisNodeSP node, const QRect& rc,
                                        KisBaseRectsWalker::UpdateType type,
                                        bool dontInvalidateFrames)
 {
-    if(rc.width() <= m_patchWidth || rc.height() <= m_patchHeight)
+    /**
+     * Full refresh jobs have already been planned into column bands
+     * by addFullRefreshJob(), the generic patch splitting would only
+     * chop the bands back into squares
+     */
+    if (type == KisBaseRectsWalker::FULL_REFRESH ||
+        type == KisBaseRectsWalker::FULL_REFRESH_NO_FILTHY) {
+
+        return false;
+    }
+
+    qint32 patchWidth = m_patchWidth;
+    qint32 patchHeight = m_patchHeight;
+
+    /**
+     * When the cost model has measurements for this node, size the
+     * patches so that compositing one of them takes roughly
+     * idealPatchMergeNsec: cheap line-art layers get bigger patches
+     * (less per-walker overhead), while clone chains and heavy layer
+     * styles get smaller ones that balance better over the threads.
+     * The patch edge is kept aligned to the tile grid.
+     */
+    const int mergeCost = node->projectionMergeCost();
+    if (mergeCost > 0) {
+        // aim at ~4ms per patch, which matches the default patch
+        // size at a typical merge cost
+        const qint64 idealPatchMergeNsec = 4000000;
+
+        const qint64 idealArea = 1000 * idealPatchMergeNsec / mergeCost;
+        qint32 patchSize = qint32(std::sqrt(qreal(idealArea)));
+        patchSize = qBound<qint32>(4 * KisTileData::WIDTH,
+                                   patchSize / KisTileData::WIDTH * KisTileData::WIDTH,
+                                   32 * KisTileData::WIDTH);
+        patchWidth = patchHeight = patchSize;
+    }
+
+    /**
+     * Filter masks with big kernels read (and multi-pass filters like
+     * gaussian blur recompute) a halo around every patch they are
+     * merged in, so for a halo H and patch edge P every update pass
+     * does roughly ((P + 2H)^2 - P^2) / P^2 of extra work. Raise the
+     * patch size to keep the halo a small fraction of the patch:
+     * P >= 8H bounds the overhead at about 30%.
+     */
+    const qint32 halo = estimateProjectionHalo(node);
+    if (halo > 0) {
+        qint32 minPatchSize =
+            (8 * halo + KisTileData::WIDTH - 1) /
+            KisTileData::WIDTH * KisTileData::WIDTH;
+        minPatchSize = qMin(minPatchSize, qint32(32 * KisTileData::WIDTH));
+
+        patchWidth = qMax(patchWidth, minPatchSize);
+        patchHeight = qMax(patchHeight, minPatchSize);
+    }
+
+    if(rc.width() <= patchWidth || rc.height() <= patchHeight)
         return false;
 
     // a bit of recursive splitting...
 
-    qint32 firstCol = rc.x() / m_patchWidth;
-    qint32 firstRow = rc.y() / m_patchHeight;
+    qint32 firstCol = rc.x() / patchWidth;
+    qint32 firstRow = rc.y() / patchHeight;
 
-    qint32 lastCol = (rc.x() + rc.width()) / m_patchWidth;
-    qint32 lastRow = (rc.y() + rc.height()) / m_patchHeight;
+    qint32 lastCol = (rc.x() + rc.width()) / patchWidth;
+    qint32 lastRow = (rc.y() + rc.height()) / patchHeight;
 
     QVector<QRect> splitRects;
 
     for(qint32 i = firstRow; i <= lastRow; i++) {
         for(qint32 j = firstCol; j <= lastCol; j++) {
-            QRect maxPatchRect(j * m_patchWidth, i * m_patchHeight,
-                               m_patchWidth, m_patchHeight);
+            QRect maxPatchRect(j * patchWidth, i * patchHeight,
+                               patchWidth, patchHeight);
             QRect patchRect = rc & maxPatchRect;
             splitRects.append(patchRect);
         }
@@ -308,6 +532,42 @@ bool KisSimpleUpdateQueue::trySplitJob(KisNodeSP node, const QRect& rc,
     return true;
 }
 
+qint32 KisSimpleUpdateQueue::estimateProjectionHalo(KisNodeSP node)
+{
+    const QRect probeRect(0, 0, KisTileData::WIDTH, KisTileData::HEIGHT);
+
+    QRect changeRect = probeRect;
+
+    if (node->inherits("KisMask")) {
+        changeRect = node->changeRect(probeRect, KisNode::N_ABOVE_FILTHY);
+    } else {
+        /**
+         * Accumulate the halos of the node's effect masks the same
+         * way masksChangeRect() does during the merge
+         */
+        KisNodeSP mask = node->firstChild();
+        while (mask) {
+            if (mask->inherits("KisEffectMask") && mask->visible()) {
+                changeRect = mask->changeRect(changeRect, KisNode::N_ABOVE_FILTHY);
+            }
+            mask = mask->nextSibling();
+        }
+    }
+
+    /**
+     * A mask with an active selection may also crop the change rect,
+     * in which case the margins below become negative; such a mask
+     * needs no halo compensation
+     */
+    const qint32 halo =
+        qMax(qMax(probeRect.left() - changeRect.left(),
+                  changeRect.right() - probeRect.right()),
+             qMax(probeRect.top() - changeRect.top(),
+                  changeRect.bottom() - probeRect.bottom()));
+
+    return qMax(0, halo);
+}
+
 bool KisSimpleUpdateQueue::tryMergeJob(KisNodeSP node, const QRect& rc,
                                        const QRect& cropRect,
                                        int levelOfDetail,
@@ -402,6 +662,21 @@ bool KisSimpleUpdateQueue::joinRects(QRect& baseRect,
 
     qint64 newWork = qint64(unitedRect.width()) * unitedRect.height();
 
+    /**
+     * Bursts of tiny updates (sub-tile dabs of a small brush) spend
+     * most of their time on the per-walker setup cost, not on merging
+     * pixels. Coalesce them unconditionally while the united rect
+     * stays within the configured area budget: the amount of extra
+     * pixels we can merge is bounded by the budget, while every
+     * avoided walker saves a full node-graph traversal.
+     */
+    if (newWork <= m_smallUpdateCoalescingArea) {
+        DEBUG_JOIN(baseRect, newRect, qreal(newWork) / baseWork);
+
+        baseRect = unitedRect;
+        return true;
+    }
+
     qreal alpha = qreal(newWork) / baseWork;
 
     if(alpha < maxAlpha) {
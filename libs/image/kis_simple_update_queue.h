@@ -57,6 +57,33 @@ protected:
     bool trySplitJob(KisNodeSP node, const QRect& rc, const QRect& cropRect, int levelOfDetail, KisBaseRectsWalker::UpdateType type, bool dontInvalidateFrames);
     bool tryMergeJob(KisNodeSP node, const QRect& rc, const QRect& cropRect, int levelOfDetail, KisBaseRectsWalker::UpdateType type, bool dontInvalidateFrames);
 
+    /**
+     * When the context has more idle threads than we have queued
+     * walkers, subdivides the biggest queued walkers in two along the
+     * tile grid, so that the tail of the update pass is not dominated
+     * by a single large job. Should be called with the context locked.
+     */
+    void splitQueuedJobs(KisUpdaterContext &updaterContext);
+
+    KisBaseRectsWalkerSP createWalker(KisBaseRectsWalker::UpdateType type, const QRect &cropRect, bool dontInvalidateFrames);
+
+    /**
+     * Estimates the halo (in pixels) by which the effect masks of
+     * \p node expand an update rect, e.g. the kernel radius of a blur
+     * filter mask. Used by trySplitJob() to size the patches so that
+     * the halo stays a small fraction of every patch.
+     */
+    static qint32 estimateProjectionHalo(KisNodeSP node);
+
+    /**
+     * Partitions \p rc into tile-aligned column bands, about twice as
+     * many as the updater context has threads. Used for planning full
+     * refresh jobs, whose per-walker setup cost (a traversal of the
+     * whole node graph) makes the generic square patches too
+     * fine-grained.
+     */
+    QVector<QRect> splitIntoColumnBands(const QRect &rc) const;
+
     void collectJobs(KisBaseRectsWalkerSP &baseWalker, QRect baseRect,
                      const qreal maxAlpha);
     bool joinRects(QRect& baseRect, const QRect& newRect, qreal maxAlpha);
@@ -96,6 +123,19 @@ protected:
      */
     qreal m_maxMergeCollectAlpha;
 
+    /**
+     * Updates whose united rect is not bigger than this area are
+     * coalesced regardless of the alpha coefficients
+     */
+    int m_smallUpdateCoalescingArea;
+
+    /**
+     * The number of threads the updater context is configured to
+     * run. Full refresh jobs are planned into about twice as many
+     * column bands.
+     */
+    int m_maxNumberOfThreads;
+
     int m_overrideLevelOfDetail;
 };
 
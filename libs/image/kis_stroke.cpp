@@ -259,6 +259,11 @@ bool KisStroke::canForgetAboutMe() const
     return m_strokeStrategy->canForgetAboutMe();
 }
 
+bool KisStroke::yieldsToNewStrokes() const
+{
+    return m_strokeStrategy->yieldsToNewStrokes();
+}
+
 bool KisStroke::isAsynchronouslyCancellable() const
 {
     return m_strokeStrategy->isAsynchronouslyCancellable();
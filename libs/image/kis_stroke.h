@@ -59,6 +59,7 @@ public:
     bool supportsWrapAroundMode() const;
     int worksOnLevelOfDetail() const;
     bool canForgetAboutMe() const;
+    bool yieldsToNewStrokes() const;
     bool isAsynchronouslyCancellable() const;
     bool clearsRedoOnStart() const;
     qreal balancingRatioOverride() const;
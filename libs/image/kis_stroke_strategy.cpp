@@ -16,6 +16,7 @@ KisStrokeStrategy::KisStrokeStrategy(const QLatin1String &id, const KUndo2MagicS
       m_clearsRedoOnStart(true),
       m_requestsOtherStrokesToEnd(true),
       m_canForgetAboutMe(false),
+      m_yieldsToNewStrokes(false),
       m_asynchronouslyCancellable(true),
       m_needsExplicitCancel(false),
       m_forceLodModeIfPossible(false),
@@ -32,6 +33,7 @@ KisStrokeStrategy::KisStrokeStrategy(const KisStrokeStrategy &rhs)
       m_clearsRedoOnStart(rhs.m_clearsRedoOnStart),
       m_requestsOtherStrokesToEnd(rhs.m_requestsOtherStrokesToEnd),
       m_canForgetAboutMe(rhs.m_canForgetAboutMe),
+      m_yieldsToNewStrokes(rhs.m_yieldsToNewStrokes),
       m_asynchronouslyCancellable(rhs.m_asynchronouslyCancellable),
       m_needsExplicitCancel(rhs.m_needsExplicitCancel),
       m_forceLodModeIfPossible(rhs.m_forceLodModeIfPossible),
@@ -219,6 +221,16 @@ void KisStrokeStrategy::setCanForgetAboutMe(bool value)
     m_canForgetAboutMe = value;
 }
 
+bool KisStrokeStrategy::yieldsToNewStrokes() const
+{
+    return m_yieldsToNewStrokes;
+}
+
+void KisStrokeStrategy::setYieldsToNewStrokes(bool value)
+{
+    m_yieldsToNewStrokes = value;
+}
+
 bool KisStrokeStrategy::isAsynchronouslyCancellable() const
 {
     return m_asynchronouslyCancellable;
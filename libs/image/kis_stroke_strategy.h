@@ -97,6 +97,20 @@ public:
      */
     bool canForgetAboutMe() const;
 
+    /**
+     * Returns true if the strokes that are started while this stroke
+     * is still waiting in the queue are allowed to overtake it. Such
+     * a stroke basically forms a background lane: a long-running
+     * regeneration (e.g. a colorize mask update) should not delay
+     * interactive strokes the user starts in the meantime.
+     *
+     * The stroke must not depend on its position in the undo
+     * sequence, i.e. it should create no undo commands.
+     *
+     * Default is 'false'.
+     */
+    bool yieldsToNewStrokes() const;
+
     /**
      * Returns true if the stroke can be cancelled by the
      * engine, e.g. when the user presses Esc key or
@@ -169,6 +183,7 @@ protected:
     void setClearsRedoOnStart(bool value);
     void setRequestsOtherStrokesToEnd(bool value);
     void setCanForgetAboutMe(bool value);
+    void setYieldsToNewStrokes(bool value);
     void setAsynchronouslyCancellable(bool value);
     void setNeedsExplicitCancel(bool value);
 
@@ -199,6 +214,7 @@ private:
     bool m_clearsRedoOnStart;
     bool m_requestsOtherStrokesToEnd;
     bool m_canForgetAboutMe;
+    bool m_yieldsToNewStrokes;
     bool m_asynchronouslyCancellable;
     bool m_needsExplicitCancel;
     bool m_forceLodModeIfPossible;
@@ -9,6 +9,7 @@
 #include <QQueue>
 #include <QMutex>
 #include <QMutexLocker>
+#include <KisLockContentionTracker.h>
 #include "kis_stroke.h"
 #include "kis_updater_context.h"
 #include "kis_stroke_job_strategy.h"
@@ -101,6 +102,7 @@ struct Q_DECL_HIDDEN KisStrokesQueue::Private {
     std::pair<StrokesQueueIterator, StrokesQueueIterator> currentLodRange();
     StrokesQueueIterator findNewLod0Pos();
     StrokesQueueIterator findNewLodNPos(KisStrokeSP lodN);
+    StrokesQueueIterator findNewLegacyPos(KisStrokeStrategy *strokeStrategy);
     bool shouldWrapInSuspendUpdatesStroke();
 
     void switchDesiredLevelOfDetail(bool forced);
@@ -261,9 +263,38 @@ StrokesQueueIterator KisStrokesQueue::Private::findNewLodNPos(KisStrokeSP lodN)
     return it;
 }
 
+StrokesQueueIterator KisStrokesQueue::Private::findNewLegacyPos(KisStrokeStrategy *strokeStrategy)
+{
+    StrokesQueueIterator it = strokesQueue.end();
+
+    if (strokeStrategy->yieldsToNewStrokes()) return it;
+
+    /**
+     * A new stroke may overtake the queued background strokes (e.g.
+     * pending colorize mask regenerations), so that a long background
+     * operation does not delay interactive work. It may never
+     * overtake the stroke that is in execution though: its jobs are
+     * already in the updater context and the queue head must stay in
+     * place until they finish.
+     */
+    while (it != strokesQueue.begin()) {
+        StrokesQueueIterator prev = std::prev(it);
+        KisStrokeSP stroke = *prev;
+
+        if (!stroke->yieldsToNewStrokes() || !stroke->isEnded()) break;
+
+        // the head stroke may be in execution already
+        if (prev == strokesQueue.begin() && currentStrokeLoaded) break;
+
+        it = prev;
+    }
+
+    return it;
+}
+
 KisStrokeId KisStrokesQueue::startLodNUndoStroke(KisStrokeStrategy *strokeStrategy)
 {
-    QMutexLocker locker(&m_d->mutex);
+    KisTrackedMutexLocker locker(&m_d->mutex, KisLockContentionTracker::StrokesQueue);
 
     KIS_SAFE_ASSERT_RECOVER_NOOP(!m_d->lodNNeedsSynchronization);
     KIS_SAFE_ASSERT_RECOVER_NOOP(m_d->desiredLevelOfDetail > 0);
@@ -280,7 +311,7 @@ KisStrokeId KisStrokesQueue::startLodNUndoStroke(KisStrokeStrategy *strokeStrate
 
 KisStrokeId KisStrokesQueue::startStroke(KisStrokeStrategy *strokeStrategy)
 {
-    QMutexLocker locker(&m_d->mutex);
+    KisTrackedMutexLocker locker(&m_d->mutex, KisLockContentionTracker::StrokesQueue);
 
     KisStrokeSP stroke;
     KisStrokeStrategy* lodBuddyStrategy;
@@ -324,7 +355,7 @@ KisStrokeId KisStrokesQueue::startStroke(KisStrokeStrategy *strokeStrategy)
 
     } else {
         stroke = KisStrokeSP(new KisStroke(strokeStrategy, KisStroke::LEGACY, 0));
-        m_d->strokesQueue.enqueue(stroke);
+        m_d->strokesQueue.insert(m_d->findNewLegacyPos(strokeStrategy), stroke);
     }
 
     KisStrokeId id(stroke);
@@ -341,7 +372,7 @@ KisStrokeId KisStrokesQueue::startStroke(KisStrokeStrategy *strokeStrategy)
 
 void KisStrokesQueue::addJob(KisStrokeId id, KisStrokeJobData *data)
 {
-    QMutexLocker locker(&m_d->mutex);
+    KisTrackedMutexLocker locker(&m_d->mutex, KisLockContentionTracker::StrokesQueue);
 
     KisStrokeSP stroke = id.toStrongRef();
     KIS_SAFE_ASSERT_RECOVER_RETURN(stroke);
@@ -360,7 +391,7 @@ void KisStrokesQueue::addJob(KisStrokeId id, KisStrokeJobData *data)
 
 void KisStrokesQueue::addMutatedJobs(KisStrokeId id, const QVector<KisStrokeJobData *> list)
 {
-    QMutexLocker locker(&m_d->mutex);
+    KisTrackedMutexLocker locker(&m_d->mutex, KisLockContentionTracker::StrokesQueue);
 
     KisStrokeSP stroke = id.toStrongRef();
     KIS_SAFE_ASSERT_RECOVER_RETURN(stroke);
@@ -370,7 +401,7 @@ void KisStrokesQueue::addMutatedJobs(KisStrokeId id, const QVector<KisStrokeJobD
 
 void KisStrokesQueue::endStroke(KisStrokeId id)
 {
-    QMutexLocker locker(&m_d->mutex);
+    KisTrackedMutexLocker locker(&m_d->mutex, KisLockContentionTracker::StrokesQueue);
 
     KisStrokeSP stroke = id.toStrongRef();
     KIS_SAFE_ASSERT_RECOVER_RETURN(stroke);
@@ -385,7 +416,7 @@ void KisStrokesQueue::endStroke(KisStrokeId id)
 
 bool KisStrokesQueue::cancelStroke(KisStrokeId id)
 {
-    QMutexLocker locker(&m_d->mutex);
+    KisTrackedMutexLocker locker(&m_d->mutex, KisLockContentionTracker::StrokesQueue);
 
     KisStrokeSP stroke = id.toStrongRef();
     if(stroke) {
@@ -415,7 +446,7 @@ bool KisStrokesQueue::tryCancelCurrentStrokeAsync()
 {
     bool anythingCanceled = false;
 
-    QMutexLocker locker(&m_d->mutex);
+    KisTrackedMutexLocker locker(&m_d->mutex, KisLockContentionTracker::StrokesQueue);
 
     /**
      * We cancel only ended strokes. This is done to avoid
@@ -477,7 +508,7 @@ UndoResult KisStrokesQueue::tryUndoLastStrokeAsync()
 {
     UndoResult result = UNDO_FAIL;
 
-    QMutexLocker locker(&m_d->mutex);
+    KisTrackedMutexLocker locker(&m_d->mutex, KisLockContentionTracker::StrokesQueue);
 
     KisStrokeSP lastStroke;
     KisStrokeSP lastBuddy;
@@ -590,7 +621,8 @@ void KisStrokesQueue::processQueue(KisUpdaterContext &updaterContext,
                                    bool externalJobsPending)
 {
     updaterContext.lock();
-    m_d->mutex.lock();
+    KisLockContentionTracker::lockTracked(&m_d->mutex,
+                                          KisLockContentionTracker::StrokesQueue);
 
     while(updaterContext.hasSpareThread() &&
           processOneJob(updaterContext,
@@ -617,7 +649,7 @@ qreal KisStrokesQueue::balancingRatioOverride() const
 
 KisLodPreferences KisStrokesQueue::lodPreferences() const
 {
-    QMutexLocker locker(&m_d->mutex);
+    KisTrackedMutexLocker locker(&m_d->mutex, KisLockContentionTracker::StrokesQueue);
 
     /**
      * The desired level of detail might have not been activated due to
@@ -628,7 +660,7 @@ KisLodPreferences KisStrokesQueue::lodPreferences() const
 
 void KisStrokesQueue::setLodPreferences(const KisLodPreferences &value)
 {
-    QMutexLocker locker(&m_d->mutex);
+    KisTrackedMutexLocker locker(&m_d->mutex, KisLockContentionTracker::StrokesQueue);
 
     m_d->lodPreferences = value;
 
@@ -642,13 +674,13 @@ void KisStrokesQueue::setLodPreferences(const KisLodPreferences &value)
 
 bool KisStrokesQueue::isEmpty() const
 {
-    QMutexLocker locker(&m_d->mutex);
+    KisTrackedMutexLocker locker(&m_d->mutex, KisLockContentionTracker::StrokesQueue);
     return m_d->strokesQueue.isEmpty();
 }
 
 qint32 KisStrokesQueue::sizeMetric() const
 {
-    QMutexLocker locker(&m_d->mutex);
+    KisTrackedMutexLocker locker(&m_d->mutex, KisLockContentionTracker::StrokesQueue);
     if(m_d->strokesQueue.isEmpty()) return 0;
 
     // just a rough approximation
@@ -678,20 +710,20 @@ void KisStrokesQueue::Private::switchDesiredLevelOfDetail(bool forced)
 
 void KisStrokesQueue::explicitRegenerateLevelOfDetail()
 {
-    QMutexLocker locker(&m_d->mutex);
+    KisTrackedMutexLocker locker(&m_d->mutex, KisLockContentionTracker::StrokesQueue);
     m_d->switchDesiredLevelOfDetail(true);
 }
 
 void KisStrokesQueue::notifyUFOChangedImage()
 {
-    QMutexLocker locker(&m_d->mutex);
+    KisTrackedMutexLocker locker(&m_d->mutex, KisLockContentionTracker::StrokesQueue);
 
     m_d->forceResetLodAndCloseCurrentLodRange();
 }
 
 void KisStrokesQueue::debugDumpAllStrokes()
 {
-    QMutexLocker locker(&m_d->mutex);
+    KisTrackedMutexLocker locker(&m_d->mutex, KisLockContentionTracker::StrokesQueue);
 
     qDebug() <<"===";
     Q_FOREACH (KisStrokeSP stroke, m_d->strokesQueue) {
@@ -727,7 +759,7 @@ KisPostExecutionUndoAdapter *KisStrokesQueue::lodNPostExecutionUndoAdapter() con
 
 KUndo2MagicString KisStrokesQueue::currentStrokeName() const
 {
-    QMutexLocker locker(&m_d->mutex);
+    KisTrackedMutexLocker locker(&m_d->mutex, KisLockContentionTracker::StrokesQueue);
     if(m_d->strokesQueue.isEmpty()) return KUndo2MagicString();
 
     return m_d->strokesQueue.head()->name();
@@ -735,7 +767,7 @@ KUndo2MagicString KisStrokesQueue::currentStrokeName() const
 
 bool KisStrokesQueue::hasOpenedStrokes() const
 {
-    QMutexLocker locker(&m_d->mutex);
+    KisTrackedMutexLocker locker(&m_d->mutex, KisLockContentionTracker::StrokesQueue);
     return m_d->openedStrokesCounter;
 }
 
@@ -16,6 +16,9 @@
 struct KisSyncLodCacheStrokeStrategy::Private
 {
     KisImageWSP image;
+
+    QVector<QRect> dirtySyncRects;
+    bool tookDirtySyncRects = false;
 };
 
 KisSyncLodCacheStrokeStrategy::KisSyncLodCacheStrokeStrategy(KisImageWSP image, bool forgettable)
@@ -30,6 +33,7 @@ KisSyncLodCacheStrokeStrategy::KisSyncLodCacheStrokeStrategy(KisImageWSP image,
      */
     enableJob(KisSimpleStrokeStrategy::JOB_INIT, true, KisStrokeJobData::BARRIER, KisStrokeJobData::EXCLUSIVE);
     enableJob(KisSimpleStrokeStrategy::JOB_DOSTROKE);
+    enableJob(KisSimpleStrokeStrategy::JOB_CANCEL, true, KisStrokeJobData::BARRIER, KisStrokeJobData::EXCLUSIVE);
 
     setRequestsOtherStrokesToEnd(false);
     setClearsRedoOnStart(false);
@@ -42,18 +46,32 @@ KisSyncLodCacheStrokeStrategy::~KisSyncLodCacheStrokeStrategy()
 
 void KisSyncLodCacheStrokeStrategy::initStrokeCallback()
 {
+    m_d->dirtySyncRects = m_d->image->takeLodSyncDirtyRegion();
+    m_d->tookDirtySyncRects = true;
+
     QVector<KisStrokeJobData *> jobs;
-    createJobsData(jobs, m_d->image->root(), m_d->image.data(), m_d->image->currentLevelOfDetail());
+    createJobsData(jobs, m_d->image->root(), m_d->image.data(), m_d->image->currentLevelOfDetail(), {}, m_d->dirtySyncRects);
     addMutatedJobs(jobs);
 }
 
+void KisSyncLodCacheStrokeStrategy::cancelStrokeCallback()
+{
+    /**
+     * The planes have been updated only partially (or not at all),
+     * so the consumed region should not be considered synced
+     */
+    if (m_d->tookDirtySyncRects && m_d->image) {
+        m_d->image->restoreLodSyncDirtyRegion(m_d->dirtySyncRects);
+    }
+}
+
 QList<KisStrokeJobData*> KisSyncLodCacheStrokeStrategy::createJobsData(KisImageWSP /*_image*/)
 {
     // all the jobs are populates in the init job
     return {};
 }
 
-void KisSyncLodCacheStrokeStrategy::createJobsData(QVector<KisStrokeJobData *> &jobs, KisNodeSP imageRoot, KisUpdatesFacade *updatesFacade, int levelOfDetail, KisPaintDeviceList extraDevices)
+void KisSyncLodCacheStrokeStrategy::createJobsData(QVector<KisStrokeJobData *> &jobs, KisNodeSP imageRoot, KisUpdatesFacade *updatesFacade, int levelOfDetail, KisPaintDeviceList extraDevices, const QVector<QRect> &dirtySyncRects)
 {
     using KisLayerUtils::recursiveApplyNodes;
     using KritaUtils::splitRegionIntoPatches;
@@ -73,13 +91,29 @@ void KisSyncLodCacheStrokeStrategy::createJobsData(QVector<KisStrokeJobData *> &
 
     KritaUtils::makeContainerUnique(deviceList);
 
+    /**
+     * Decide upfront which devices can reuse their LoD plane. The
+     * decision is stable, because the plane may change only inside
+     * the strokes, and we are called either from the init job of the
+     * sync stroke or from the stroke that owns the devices.
+     */
+    QSet<KisPaintDevice*> incrementalSyncDevices;
+
+    if (!dirtySyncRects.isEmpty()) {
+        Q_FOREACH (KisPaintDeviceSP device, deviceList) {
+            if (device->canSyncLodDataStructIncrementally(levelOfDetail)) {
+                incrementalSyncDevices.insert(device.data());
+            }
+        }
+    }
+
     KritaUtils::addJobBarrierNoCancel(jobs, [updatesFacade] () {
         updatesFacade->blockUpdates();
     });
 
-    KritaUtils::addJobBarrier(jobs, [sharedData, deviceList, levelOfDetail] () mutable {
+    KritaUtils::addJobBarrier(jobs, [sharedData, deviceList, levelOfDetail, incrementalSyncDevices] () mutable {
         Q_FOREACH (KisPaintDeviceSP device, deviceList) {
-            sharedData->insert(device, toQShared(device->createLodDataStruct(levelOfDetail)));
+            sharedData->insert(device, toQShared(device->createLodDataStruct(levelOfDetail, incrementalSyncDevices.contains(device.data()))));
         }
     });
 
@@ -87,7 +121,27 @@ void KisSyncLodCacheStrokeStrategy::createJobsData(QVector<KisStrokeJobData *> &
 
     Q_FOREACH (KisPaintDeviceSP device, deviceList) {
         KisRegion region = device->regionForLodSyncing();
-        QVector<QRect> rects = splitRegionIntoPatches(region, optimalPatchSize());
+
+        QVector<QRect> rects;
+
+        if (incrementalSyncDevices.contains(device.data())) {
+
+            /**
+             * The LoD plane of the device is still valid, so
+             * createLodDataStruct() will seed the struct with its
+             * content and only the areas changed since the last sync
+             * need to be regenerated. Mind that we should not clip
+             * the dirty rects against regionForLodSyncing(): the
+             * areas erased since the last sync are not present in the
+             * region anymore, but still must be re-downsampled to
+             * overwrite the seeded content.
+             */
+            Q_FOREACH (const QRect &dirtyRect, dirtySyncRects) {
+                rects += KritaUtils::splitRectIntoPatches(dirtyRect, optimalPatchSize());
+            }
+        } else {
+            rects = splitRegionIntoPatches(region, optimalPatchSize());
+        }
 
         Q_FOREACH (const QRect &rc, rects) {
             KritaUtils::addJobConcurrent(jobs, [sharedData, device, rc] () mutable {
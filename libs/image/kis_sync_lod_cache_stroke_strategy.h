@@ -22,10 +22,18 @@ public:
 
     static QList<KisStrokeJobData*> createJobsData(KisImageWSP image);
 
-    static void createJobsData(QVector<KisStrokeJobData *> &jobs, KisNodeSP imageRoot, KisUpdatesFacade *updatesFacade, int levelOfDetail, KisPaintDeviceList extraDevices = {});
+    /**
+     * \p dirtySyncRects limits the amount of data resynced for the
+     * devices whose LoD plane can be updated incrementally (see
+     * KisPaintDevice::canSyncLodDataStructIncrementally()). An empty
+     * vector means the changed region is unknown and the planes are
+     * regenerated fully.
+     */
+    static void createJobsData(QVector<KisStrokeJobData *> &jobs, KisNodeSP imageRoot, KisUpdatesFacade *updatesFacade, int levelOfDetail, KisPaintDeviceList extraDevices = {}, const QVector<QRect> &dirtySyncRects = {});
 
 private:
     void initStrokeCallback() override;
+    void cancelStrokeCallback() override;
 
 private:
     struct Private;
@@ -138,7 +138,15 @@ void KisTransactionData::endTransaction()
 
         DEBUG_ACTION("Transaction ended");
         m_d->transactionFinished = true;
-        m_d->savedDataManager->commit();
+
+        /**
+         * The commit is deferred: the per-tile walk over the changed
+         * area is postponed until the next history operation on the
+         * device (a new transaction, undo/redo or purging), which
+         * always happens in a worker thread. This way ending a huge
+         * transaction doesn't delay the end of the stroke.
+         */
+        m_d->savedDataManager->commitDeferred();
         m_d->newOffset = QPoint(m_d->device->x(), m_d->device->y());
         m_d->defaultPixelChanged = m_d->oldDefaultPixel != m_d->device->defaultPixel();
 
@@ -202,7 +210,22 @@ void KisTransactionData::possiblyResetOutlineCache()
         (pixelSelection =
          dynamic_cast<KisPixelSelection*>(m_d->device.data()))) {
 
-        pixelSelection->invalidateOutlineCache();
+        /**
+         * When the transaction only changed pixels, its memento knows
+         * the changed extent, so the cached outline can be updated
+         * incrementally instead of being re-traced from scratch
+         */
+        if (m_d->memento &&
+            m_d->newOffset == m_d->oldOffset &&
+            !m_d->defaultPixelChanged) {
+
+            const QRect changedRect =
+                m_d->memento->extent().translated(m_d->device->x(),
+                                                  m_d->device->y());
+            pixelSelection->recalculateOutlineCache(changedRect);
+        } else {
+            pixelSelection->invalidateOutlineCache();
+        }
     }
 }
 
@@ -76,6 +76,12 @@ public:
         if (!staticCacheDevice ||
             *staticCacheDevice->colorSpace() != *cs) {
 
+            if (staticCacheDevice) {
+                // the colorspace has changed, archived renders
+                // are in the old colorspace, drop them as well
+                renderHistory.clear();
+            }
+
             staticCacheDevice = new KisPaintDevice(cs);
             staticCacheDevice->setDefaultBounds(defaultBounds);
         }
@@ -93,6 +99,43 @@ public:
         KIS_SAFE_ASSERT_RECOVER_NOOP(!staticCacheIsOverridden);
     }
 
+    /**
+     * Try to revive a render archived in the scrubbing history. If the
+     * currently cached render is valid but belongs to different params
+     * (the playhead has moved), it is archived instead of being thrown
+     * away, so scrubbing back to its frame can revive it later.
+     */
+    bool tryReuseCachedRender(KisTransformMaskParamsInterfaceSP currentParams) {
+        QWriteLocker l(&m_lock);
+
+        if (staticCacheIsOverridden) return true;
+
+        if (staticCacheValid &&
+            paramsForStaticImage &&
+            paramsForStaticImage->compareTransform(currentParams)) {
+
+            return true;
+        }
+
+        archiveCurrentRenderImpl();
+        staticCacheValid = false;
+        paramsForStaticImage.clear();
+
+        for (int i = 0; i < renderHistory.size(); i++) {
+            if (renderHistory[i].params->compareTransform(currentParams)) {
+                const HistoryEntry entry = renderHistory.takeAt(i);
+
+                staticCacheDevice = entry.device;
+                paramsForStaticImage = entry.params;
+                staticCacheValid = true;
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
     void overrideStaticCacheDevice(KisPaintDeviceSP device)
     {
         KIS_SAFE_ASSERT_RECOVER_RETURN(staticCacheDevice);
@@ -112,18 +155,54 @@ public:
         }
     }
 
-    void invalidateDeviceCache() {
+    void invalidateDeviceCache(bool keepRenderHistory = false) {
+        QWriteLocker l(&m_lock);
+
+        if (!keepRenderHistory) {
+            // the source content has changed, so the archived
+            // renders are stale as well
+            renderHistory.clear();
+        }
+
         staticCacheValid = false;
         paramsForStaticImage.clear();
         KIS_SAFE_ASSERT_RECOVER_NOOP(!staticCacheIsOverridden);
     }
 
 private:
+    void archiveCurrentRenderImpl() {
+        // must be called under m_lock held for write
+        if (!staticCacheValid || staticCacheIsOverridden ||
+            !staticCacheDevice || !paramsForStaticImage) {
+
+            return;
+        }
+
+        renderHistory.prepend({staticCacheDevice, paramsForStaticImage});
+        while (renderHistory.size() > maxRenderHistorySize) {
+            renderHistory.removeLast();
+        }
+
+        /**
+         * Detach the device: the next recalculation allocates a fresh
+         * one, so it cannot clobber the archived pixels
+         */
+        staticCacheDevice.clear();
+    }
+
+private:
+    struct HistoryEntry {
+        KisPaintDeviceSP device;
+        KisTransformMaskParamsInterfaceSP params;
+    };
+    static constexpr int maxRenderHistorySize = 4;
+
     mutable QReadWriteLock m_lock;
     bool staticCacheIsOverridden {false};
     bool staticCacheValid = {false};
     KisPaintDeviceSP staticCacheDevice;
     KisTransformMaskParamsInterfaceSP paramsForStaticImage;
+    QVector<HistoryEntry> renderHistory;
 };
 
 struct AccumulatedRectStorage
@@ -479,12 +558,29 @@ QRect KisTransformMask::decorateRect(KisPaintDeviceSP &src,
         /// cause an infinite loop
         !flags.testFlag(KisRenderPassFlag::NoTransformMaskUpdates)) {
 
-        if (m_d->testingInterface) {
-            m_d->testingInterface->notifyDecorateRectTriggeredStaticImageUpdate();
+        /**
+         * When the invalidation is caused by the playhead moving (the
+         * source content is untouched, only the baked params differ),
+         * first check the scrubbing history: revisiting an already
+         * rendered frame revives its archived render instead of
+         * scheduling a full regeneration.
+         */
+        const bool sourceContentChanged =
+            maskPos == N_FILTHY || maskPos == N_ABOVE_FILTHY;
+
+        bool reusedCachedRender = false;
+        if (!sourceContentChanged && m_d->paramsHolder->isAnimated()) {
+            reusedCachedRender = m_d->staticCache.tryReuseCachedRender(params);
         }
 
-        m_d->staticCache.invalidateDeviceCache();
-        m_d->updateSignalCompressor.start();
+        if (!reusedCachedRender) {
+            if (m_d->testingInterface) {
+                m_d->testingInterface->notifyDecorateRectTriggeredStaticImageUpdate();
+            }
+
+            m_d->staticCache.invalidateDeviceCache(!sourceContentChanged);
+            m_d->updateSignalCompressor.start();
+        }
     }
 
     if (m_d->recalculatingStaticImage) {
@@ -13,6 +13,10 @@
 #include <qmath.h>
 #include <klocalizedstring.h>
 
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
 #include <QTransform>
 
 #include <KoColorSpace.h>
@@ -27,9 +31,12 @@
 #include "kis_filter_strategy.h"
 #include "kis_painter.h"
 #include "kis_filter_weights_applicator.h"
+#include "kis_filter_weights_cache.h"
 #include "kis_progress_update_helper.h"
 #include "kis_pixel_selection.h"
 #include "kis_image.h"
+#include "kis_algebra_2d.h"
+#include "tiles3/kis_tile_data.h"
 
 
 KisTransformWorker::KisTransformWorker(KisPaintDeviceSP dev,
@@ -171,6 +178,87 @@ template <> void calcDimensions <KisVLineIteratorSP>
 
 }
 
+template <class iter> qint32 lineAxisTileSize();
+
+template <> qint32 lineAxisTileSize <KisHLineIteratorSP> ()
+{
+    return KisTileData::HEIGHT;
+}
+
+template <> qint32 lineAxisTileSize <KisVLineIteratorSP> ()
+{
+    return KisTileData::WIDTH;
+}
+
+template <class iter> qint32 lineAxisOffset(KisPaintDevice *dev);
+
+template <> qint32 lineAxisOffset <KisHLineIteratorSP> (KisPaintDevice *dev)
+{
+    return dev->y();
+}
+
+template <> qint32 lineAxisOffset <KisVLineIteratorSP> (KisPaintDevice *dev)
+{
+    return dev->x();
+}
+
+namespace {
+
+/**
+ * Resamples a consecutive strip of lines of one transform pass. Each
+ * line reads and writes only itself (shear merely shifts the pixels
+ * along the line), so the strips are fully independent even though
+ * src and dst are the same device.
+ */
+template <class T>
+class TransformPassStripTask : public QRunnable
+{
+public:
+    TransformPassStripTask(KisFilterWeightsApplicator *applicator,
+                           KisFilterWeightsBuffer *buf,
+                           qreal filterSupport,
+                           qint32 srcStart, qint32 srcLen,
+                           qint32 firstLine, qint32 numLines,
+                           QSemaphore *doneSemaphore)
+        : m_applicator(applicator),
+          m_buf(buf),
+          m_filterSupport(filterSupport),
+          m_srcStart(srcStart),
+          m_srcLen(srcLen),
+          m_firstLine(firstLine),
+          m_numLines(numLines),
+          m_doneSemaphore(doneSemaphore)
+    {
+        // the worker fetches dstBounds() after the task has finished
+        setAutoDelete(false);
+    }
+
+    void run() override {
+        for (int i = m_firstLine; i < m_firstLine + m_numLines; i++) {
+            KisFilterWeightsApplicator::LinePos srcPos(m_srcStart, m_srcLen);
+            m_dstBounds.unite(m_applicator->processLine<T>(srcPos, i, m_buf, m_filterSupport));
+        }
+        m_doneSemaphore->release();
+    }
+
+    KisFilterWeightsApplicator::LinePos dstBounds() const {
+        return m_dstBounds;
+    }
+
+private:
+    KisFilterWeightsApplicator *m_applicator;
+    KisFilterWeightsBuffer *m_buf;
+    qreal m_filterSupport;
+    qint32 m_srcStart;
+    qint32 m_srcLen;
+    qint32 m_firstLine;
+    qint32 m_numLines;
+    QSemaphore *m_doneSemaphore;
+    KisFilterWeightsApplicator::LinePos m_dstBounds;
+};
+
+}
+
 template <class iter>
 void updateBounds(QRect &boundRect,
                   const KisFilterWeightsApplicator::LinePos &newBounds);
@@ -200,20 +288,88 @@ void KisTransformWorker::transformPass(KisPaintDevice *src, KisPaintDevice *dst,
     qint32 srcStart, srcLen, firstLine, numLines;
     calcDimensions<T>(m_boundRect, srcStart, srcLen, firstLine, numLines);
 
-    KisProgressUpdateHelper progressHelper(m_progressUpdater, portion, numLines);
-    KisFilterWeightsBuffer buf(filterStrategy, qAbs(floatscale));
+    QSharedPointer<KisFilterWeightsBuffer> buf =
+        KisFilterWeightsCache::instance()->weights(filterStrategy, qAbs(floatscale));
+
+    // both the weights buffer and the applicator are immutable during
+    // the pass, so they are shared by all the strip tasks
     KisFilterWeightsApplicator applicator(src, dst, floatscale, shear, dx, clampToEdge);
+    const qreal filterSupport = filterStrategy->support(buf->weightsPositionScale().toFloat());
 
     KisFilterWeightsApplicator::LinePos dstBounds;
 
-    for (int i = firstLine; i < firstLine + numLines; i++) {
-        KisFilterWeightsApplicator::LinePos dstPos;
-        KisFilterWeightsApplicator::LinePos srcPos(srcStart, srcLen);
+    // below this strip area the dispatch overhead eats the speedup
+    const qint64 minPixelsPerStrip = 256 * 256;
+    const qint32 tileSize = lineAxisTileSize<T>();
+    const qint64 area = qint64(srcLen) * numLines;
 
-        dstPos = applicator.processLine<T>(srcPos, i, &buf, filterStrategy->support(buf.weightsPositionScale().toFloat()));
-        dstBounds.unite(dstPos);
+    const int numStrips = qMin(qint64(QThread::idealThreadCount()),
+                               qMin(qint64(numLines / tileSize),
+                                    area / minPixelsPerStrip));
 
-        progressHelper.step();
+    QVector<QPair<qint32, qint32>> strips; // (firstLine, numLines)
+
+    if (numStrips >= 2) {
+        /**
+         * The strips are aligned to the tile grid of the device, so
+         * that no two tasks ever touch the same tile concurrently.
+         */
+        const qint32 axisOffset = lineAxisOffset<T>(dst);
+        const qint32 stripSize = qMax(1, (numLines / numStrips) / tileSize) * tileSize;
+
+        const qint32 lastLine = firstLine + numLines - 1;
+        qint32 line = firstLine;
+        while (line <= lastLine) {
+            const qint32 nextBoundary =
+                (KisAlgebra2D::divideFloor(line - axisOffset, stripSize) + 1) * stripSize + axisOffset;
+            const qint32 stripEnd = qMin(lastLine, nextBoundary - 1);
+            strips << qMakePair(line, stripEnd - line + 1);
+            line = stripEnd + 1;
+        }
+    }
+
+    if (strips.size() >= 2) {
+        QSemaphore doneSemaphore;
+        QVector<TransformPassStripTask<T>*> tasks;
+
+        for (int i = 0; i < strips.size(); i++) {
+            TransformPassStripTask<T> *task =
+                new TransformPassStripTask<T>(&applicator, buf.data(), filterSupport,
+                                              srcStart, srcLen,
+                                              strips[i].first, strips[i].second,
+                                              &doneSemaphore);
+            tasks << task;
+
+            if (!QThreadPool::globalInstance()->tryStart(task)) {
+                // the pool is saturated (or we are running on one of
+                // its worker threads already), so resample the strip
+                // in the calling thread
+                task->run();
+            }
+        }
+
+        KisProgressUpdateHelper progressHelper(m_progressUpdater, portion, tasks.size());
+        for (int i = 0; i < tasks.size(); i++) {
+            doneSemaphore.acquire();
+            progressHelper.step();
+        }
+
+        for (int i = 0; i < tasks.size(); i++) {
+            dstBounds.unite(tasks[i]->dstBounds());
+            delete tasks[i];
+        }
+    } else {
+        KisProgressUpdateHelper progressHelper(m_progressUpdater, portion, numLines);
+
+        for (int i = firstLine; i < firstLine + numLines; i++) {
+            KisFilterWeightsApplicator::LinePos dstPos;
+            KisFilterWeightsApplicator::LinePos srcPos(srcStart, srcLen);
+
+            dstPos = applicator.processLine<T>(srcPos, i, buf.data(), filterSupport);
+            dstBounds.unite(dstPos);
+
+            progressHelper.step();
+        }
     }
 
     updateBounds<T>(m_boundRect, dstBounds);
@@ -175,6 +175,12 @@ typedef KisSharedPtr<KisGenerator> KisGeneratorSP;
 class KisConvolutionKernel;
 typedef KisSharedPtr<KisConvolutionKernel> KisConvolutionKernelSP;
 
+class KisGapMap;
+typedef KisSharedPtr<KisGapMap> KisGapMapSP;
+
+class KisGapMapCache;
+typedef KisSharedPtr<KisGapMapCache> KisGapMapCacheSP;
+
 class KisAnnotation;
 typedef KisSharedPtr<KisAnnotation> KisAnnotationSP;
 typedef QVector<KisAnnotationSP> vKisAnnotationSP;
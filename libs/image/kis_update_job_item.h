@@ -9,6 +9,7 @@
 
 #include <atomic>
 
+#include <QElapsedTimer>
 #include <QRunnable>
 #include <QReadWriteLock>
 
@@ -17,6 +18,10 @@
 #include "kis_base_rects_walker.h"
 #include "kis_async_merger.h"
 #include "kis_updater_context.h"
+#include "kis_update_time_monitor.h"
+#include "kis_perf_counter_sampler.h"
+#include <KisAllocationCensus.h>
+#include "tiles3/kis_numa_topology.h"
 #include <KoAlwaysInline.h>
 
 //#define DEBUG_JOBS_SEQUENCE
@@ -46,6 +51,10 @@ public:
     }
 
     void run() override {
+        // when NUMA-aware tile pools are enabled, keep the worker
+        // on one node so its tile data stays local (no-op otherwise)
+        KisNumaTopology::bindCurrentThreadRoundRobin();
+
         runImpl();
 
         // notify that the job is exiting and wake everybody
@@ -71,9 +80,31 @@ private:
          * so we switch from "done" state into "running" again.
          */
 
+        KisUpdateTimeMonitor *timeMonitor = KisUpdateTimeMonitor::instance();
+
         while (1) {
             KIS_SAFE_ASSERT_RECOVER_RETURN(isRunning());
 
+            const bool traceTiming = timeMonitor->jobTimingTracingEnabled();
+            KisUpdateTimeMonitor::JobTimingSample sample;
+            QElapsedTimer execTimer;
+
+            if (traceTiming) {
+                sample.queueWaitUsecs = m_queuedTimer.nsecsElapsed() / 1000;
+
+                if (m_atomicType == Type::MERGE) {
+                    sample.jobType = KisUpdateTimeMonitor::JobTimingSample::Merge;
+                    sample.walkerType = m_walker ? int(m_walker->type()) : -1;
+                    sample.dirtyArea = qint64(m_changeRect.width()) * m_changeRect.height();
+                } else {
+                    sample.jobType = m_atomicType == Type::STROKE ?
+                        KisUpdateTimeMonitor::JobTimingSample::Stroke :
+                        KisUpdateTimeMonitor::JobTimingSample::Spontaneous;
+                }
+
+                execTimer.start();
+            }
+
             if(m_exclusive) {
                 m_updaterContext->m_exclusiveJobLock.lockForWrite();
             } else {
@@ -97,10 +128,35 @@ private:
                     }
 #endif
 
+                    /**
+                     * Aggregates hardware counters per stroke strategy
+                     * when the opt-in sampling mode is active, see
+                     * KisPerfCounterSampler
+                     */
+                    KisPerfCounterSampler::JobScope perfScope(
+                        m_atomicType == Type::STROKE &&
+                        KisPerfCounterSampler::instance()->isEnabled() ?
+                            m_runnableJob->debugName() : QString());
+
+                    /**
+                     * Tags the temporary allocations of the job with
+                     * the stroke strategy name when the opt-in census
+                     * is active, see KisAllocationCensus
+                     */
+                    KisAllocationCensus::Scope censusScope(
+                        m_atomicType == Type::STROKE &&
+                        KisAllocationCensus::instance()->isEnabled() ?
+                            m_runnableJob->debugName() : QString());
+
                     m_runnableJob->run();
                 }
             }
 
+            if (traceTiming) {
+                sample.execUsecs = execTimer.nsecsElapsed() / 1000;
+                timeMonitor->reportJobExecuted(sample);
+            }
+
             setDone();
 
             m_updaterContext->doSomeUsefulWork();
@@ -149,6 +205,8 @@ public:
         m_exclusive = false;
         m_runnableJob = 0;
 
+        m_queuedTimer.start();
+
         const Type oldState = m_atomicType.exchange(Type::MERGE);
         return oldState == Type::EMPTY;
     }
@@ -164,6 +222,8 @@ public:
         m_walker = 0;
         m_accessRect = m_changeRect = QRect();
 
+        m_queuedTimer.start();
+
         const Type oldState = m_atomicType.exchange(Type::STROKE);
         return oldState == Type::EMPTY;
     }
@@ -178,6 +238,8 @@ public:
         m_walker = 0;
         m_accessRect = m_changeRect = QRect();
 
+        m_queuedTimer.start();
+
         const Type oldState = m_atomicType.exchange(Type::SPONTANEOUS);
         return oldState == Type::EMPTY;
     }
@@ -259,6 +321,12 @@ private:
      */
     QRect m_accessRect;
     QRect m_changeRect;
+
+    /**
+     * Measures the time the job spends in the slot before execution,
+     * \see KisUpdateTimeMonitor::JobTimingSample
+     */
+    QElapsedTimer m_queuedTimer;
 };
 
 
@@ -20,6 +20,11 @@
 #include <QElapsedTimer>
 
 #include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <atomic>
 
 #include <kis_debug.h>
 #include <KisPortingUtils.h>
@@ -76,8 +81,12 @@ struct Q_DECL_HIDDEN KisUpdateTimeMonitor::Private
           loggingEnabled(false)
     {
         loggingEnabled = KisImageConfig(true).enablePerfLog();
+        jobTimingTracingEnabled = loggingEnabled;
+        jobSamples.resize(jobSamplesCapacity);
     }
 
+    static constexpr int jobSamplesCapacity = 1024;
+
     QHash<void*, StrokeTicket*> preliminaryTickets;
     QSet<StrokeTicket*> finishedTickets;
 
@@ -93,6 +102,10 @@ struct Q_DECL_HIDDEN KisUpdateTimeMonitor::Private
     KisPaintOpPresetSP preset;
 
     bool loggingEnabled;
+
+    QVector<KisUpdateTimeMonitor::JobTimingSample> jobSamples;
+    std::atomic<quint64> jobSamplesHead {0};
+    std::atomic<bool> jobTimingTracingEnabled {false};
 };
 
 KisUpdateTimeMonitor::KisUpdateTimeMonitor()
@@ -196,6 +209,67 @@ void KisUpdateTimeMonitor::printValues()
     logFile.close();
 }
 
+bool KisUpdateTimeMonitor::jobTimingTracingEnabled() const
+{
+    return m_d->jobTimingTracingEnabled.load(std::memory_order_relaxed);
+}
+
+void KisUpdateTimeMonitor::setJobTimingTracingEnabled(bool value)
+{
+    m_d->jobTimingTracingEnabled.store(value, std::memory_order_relaxed);
+}
+
+void KisUpdateTimeMonitor::reportJobExecuted(const JobTimingSample &sample)
+{
+    const quint64 index =
+        m_d->jobSamplesHead.fetch_add(1, std::memory_order_relaxed);
+
+    m_d->jobSamples[index % Private::jobSamplesCapacity] = sample;
+}
+
+QVector<KisUpdateTimeMonitor::JobTimingSample> KisUpdateTimeMonitor::jobTimingSamples() const
+{
+    const quint64 head = m_d->jobSamplesHead.load(std::memory_order_relaxed);
+    const quint64 count = qMin<quint64>(head, Private::jobSamplesCapacity);
+
+    QVector<JobTimingSample> result;
+    result.reserve(count);
+
+    for (quint64 i = head - count; i < head; i++) {
+        result << m_d->jobSamples[i % Private::jobSamplesCapacity];
+    }
+
+    return result;
+}
+
+bool KisUpdateTimeMonitor::dumpJobTimingsJson(const QString &fileName) const
+{
+    static const char* jobTypeNames[] = {"merge", "stroke", "spontaneous"};
+
+    QJsonArray samples;
+
+    Q_FOREACH (const JobTimingSample &sample, jobTimingSamples()) {
+        QJsonObject object;
+        object["jobType"] = jobTypeNames[qBound(0, sample.jobType, 2)];
+        object["walkerType"] = sample.walkerType;
+        object["queueWaitUsecs"] = sample.queueWaitUsecs;
+        object["execUsecs"] = sample.execUsecs;
+        object["dirtyArea"] = sample.dirtyArea;
+        samples.append(object);
+    }
+
+    QJsonObject root;
+    root["updateJobs"] = samples;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    file.write(QJsonDocument(root).toJson());
+    return true;
+}
+
 void KisUpdateTimeMonitor::reportJobStarted(void *key)
 {
     if (!m_d->loggingEnabled) return;
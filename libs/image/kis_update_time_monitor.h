@@ -12,12 +12,39 @@
 
 
 #include <QVector>
+#include <QString>
 class QPointF;
 class QRect;
 
 
 class KRITAIMAGE_EXPORT KisUpdateTimeMonitor
 {
+public:
+    /**
+     * A snapshot of timing data for one job executed by the updater
+     * context. The samples are kept in a fixed-size lock-free ring
+     * buffer, so the recording adds no locks to the workers' hot path.
+     */
+    struct JobTimingSample {
+        enum JobType {
+            Merge = 0,
+            Stroke,
+            Spontaneous
+        };
+
+        int jobType = Merge;
+
+        /// KisBaseRectsWalker::UpdateType of merge jobs, -1 otherwise
+        int walkerType = -1;
+
+        /// time between the job being put into its slot and its execution
+        qint64 queueWaitUsecs = 0;
+        qint64 execUsecs = 0;
+
+        /// area of the change rect of merge jobs, 0 otherwise
+        qint64 dirtyArea = 0;
+    };
+
 public:
     KisUpdateTimeMonitor();
     ~KisUpdateTimeMonitor();
@@ -34,6 +61,32 @@ public:
     void reportJobFinished(void *key, const QVector<QRect> &rects);
     void reportUpdateFinished(const QRect &rect);
 
+    /**
+     * Whether per-job timing samples should be recorded. Defaults to
+     * the state of the performance logging option in the config.
+     */
+    bool jobTimingTracingEnabled() const;
+    void setJobTimingTracingEnabled(bool value);
+
+    /**
+     * Pushes one sample into the ring buffer. Safe to call from
+     * multiple worker threads concurrently.
+     */
+    void reportJobExecuted(const JobTimingSample &sample);
+
+    /**
+     * Returns a copy of the recorded samples, oldest first. The reads
+     * are not synchronized with the writers, so the most recent
+     * samples may be slightly torn; that is acceptable for the
+     * diagnostics this buffer is used for.
+     */
+    QVector<JobTimingSample> jobTimingSamples() const;
+
+    /**
+     * Dumps the recorded samples into \p fileName as JSON
+     */
+    bool dumpJobTimingsJson(const QString &fileName) const;
+
 
 private:
     struct Private;
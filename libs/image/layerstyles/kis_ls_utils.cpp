@@ -33,6 +33,29 @@
 
 namespace KisLsUtils
 {
+    namespace {
+        /**
+         * Applies a 256-entry lookup table over the selection in
+         * whole-span strides instead of pixel-by-pixel, see the
+         * stride mode of KisSequentialIterator
+         */
+        void applyLookupTable(KisPixelSelectionSP selection,
+                              const QRect &applyRect,
+                              const quint8 *table)
+        {
+            KisSequentialIterator dstIt(selection, applyRect);
+
+            int numConseqPixels = dstIt.nConseqPixels();
+            while (dstIt.nextPixels(numConseqPixels)) {
+                numConseqPixels = dstIt.nConseqPixels();
+                quint8 *pixelPtr = dstIt.rawData();
+
+                for (int i = 0; i < numConseqPixels; i++) {
+                    pixelPtr[i] = table[pixelPtr[i]];
+                }
+            }
+        }
+    }
 
     QRect growSelectionUniform(KisPixelSelectionSP selection, int growSize, const QRect &applyRect)
     {
@@ -73,22 +96,20 @@ namespace KisLsUtils
 
     void findEdge(KisPixelSelectionSP selection, const QRect &applyRect, const bool edgeHidden)
     {
-        KisSequentialIterator dstIt(selection, applyRect);
-
         if (edgeHidden) {
-            while(dstIt.nextPixel()) {
-                quint8 *pixelPtr = dstIt.rawData();
-
-                *pixelPtr =
-                    (*pixelPtr < 24) ?
-                    *pixelPtr * 10 : 0xFF;
-
+            quint8 edgeTable[256];
+            for (int i = 0; i < 256; i++) {
+                edgeTable[i] = i < 24 ? i * 10 : 0xFF;
             }
+
+            applyLookupTable(selection, applyRect, edgeTable);
         } else {
-            while(dstIt.nextPixel()) {
-                quint8 *pixelPtr = dstIt.rawData();
-                *pixelPtr = 0xFF;
+            KisSequentialIterator dstIt(selection, applyRect);
 
+            int numConseqPixels = dstIt.nConseqPixels();
+            while (dstIt.nextPixels(numConseqPixels)) {
+                numConseqPixels = dstIt.nConseqPixels();
+                memset(dstIt.rawData(), 0xFF, numConseqPixels);
             }
         }
     }
@@ -289,12 +310,7 @@ namespace KisLsUtils
             rangeTable[i] = qMin(value, quint8(255));
         }
 
-        KisSequentialIterator dstIt(selection, applyRect);
-
-        while (dstIt.nextPixel()) {
-            quint8 *pixelPtr = dstIt.rawData();
-            *pixelPtr = rangeTable[*pixelPtr];
-        }
+        applyLookupTable(selection, applyRect, rangeTable);
     }
 
     void applyContourCorrection(KisPixelSelectionSP selection,
@@ -343,11 +359,7 @@ namespace KisLsUtils
             }
         }
 
-        KisSequentialIterator dstIt(selection, applyRect);
-        while (dstIt.nextPixel()) {
-            quint8 *pixelPtr = dstIt.rawData();
-            *pixelPtr = contour[*pixelPtr];
-        }
+        applyLookupTable(selection, applyRect, contour);
     }
 
     void knockOutSelection(KisPixelSelectionSP selection,
@@ -23,6 +23,7 @@
 #include "kis_random_accessor_ng.h"
 
 #include <boost/heap/fibonacci_heap.hpp>
+#include <array>
 #include <set>
 
 using namespace KisLazyFillTools;
@@ -58,7 +59,13 @@ struct FillGroup {
         QMap<qint32, std::multiset<QPoint, CompareQPoints>> conflictWithGroup;
     };
 
-    QMap<int, LevelData> levels;
+    /**
+     * The levels are indexed directly by the heightmap value. A flat array
+     * keeps the per-neighbour lookups in visitNeighbour() allocation-free,
+     * which is what the whole flood loop is made of. Untouched levels are
+     * just default-initialized entries with zero edge sizes.
+     */
+    std::array<LevelData, 256> levels;
 };
 
 using GroupLevelPair = QPair<qint32, quint8>;
@@ -625,10 +632,13 @@ void KisWatershedWorker::Private::processQueue(qint32 _backgroundGroupId)
     QElapsedTimer tt; tt.start();
 
 
-    // TODO: lazy initialization of the iterator's position
-    // TODO: reuse iterators if possible!
-    groupIt = groupsMap->createRandomAccessorNG();
-    levelIt = heightMap->createRandomConstAccessorNG();
+    // the queue is processed multiple times during the conflict
+    // resolution, so keep the accessors (and their cached tiles)
+    // between the runs
+    if (!groupIt) {
+        groupIt = groupsMap->createRandomAccessorNG();
+        levelIt = heightMap->createRandomConstAccessorNG();
+    }
     backgroundGroupId = _backgroundGroupId;
     backgroundGroupColor = groups[backgroundGroupId].colorIndex;
     recolorMode = backgroundGroupId > 1;
@@ -699,9 +709,6 @@ void KisWatershedWorker::Private::processQueue(qint32 _backgroundGroupId)
 
     }
 
-    // cleanup iterators
-    groupIt.clear();
-    levelIt.clear();
     backgroundGroupId = 0;
     backgroundGroupColor = -1;
     recolorMode = false;
@@ -766,8 +773,13 @@ void KisWatershedWorker::Private::updateNarrowRegionMetrics()
     for (qint32 i = 0; i < groups.size(); i++) {
         FillGroup &group = groups[i];
 
-        for (auto levelIt = group.levels.begin(); levelIt != group.levels.end(); ++levelIt) {
-            FillGroup::LevelData &l = levelIt.value();
+        for (int level = 0; level < int(group.levels.size()); level++) {
+            FillGroup::LevelData &l = group.levels[level];
+
+            if (l.totalEdgeSize() <= 0) {
+                l.narrowRegion = false;
+                continue;
+            }
 
             const qreal areaToPerimeterRatio = qreal(l.numFilledPixels) / l.totalEdgeSize();
             l.narrowRegion = areaToPerimeterRatio < 2.0;
@@ -783,12 +795,12 @@ QVector<GroupLevelPair> KisWatershedWorker::Private::calculateConflictingPairs()
     for (qint32 i = 0; i < groups.size(); i++) {
         FillGroup &group = groups[i];
 
-        for (auto levelIt = group.levels.begin(); levelIt != group.levels.end(); ++levelIt) {
-            FillGroup::LevelData &l = levelIt.value();
+        for (int level = 0; level < int(group.levels.size()); level++) {
+            FillGroup::LevelData &l = group.levels[level];
 
             for (auto conflictIt = l.conflictWithGroup.begin(); conflictIt != l.conflictWithGroup.end(); ++conflictIt) {
                 if (!conflictIt->empty()) {
-                    result.append(GroupLevelPair(i, levelIt.key()));
+                    result.append(GroupLevelPair(i, quint8(level)));
                     break;
                 }
             }
@@ -931,11 +943,10 @@ void KisWatershedWorker::Private::dumpGroupMaps()
 
         quint8 level = *heightIt.rawDataConst();
 
-        if (groups[*srcPtr].levels.contains(level)) {
-            const FillGroup::LevelData &l = groups[*srcPtr].levels[level];
-
-            const int edgeLength = l.totalEdgeSize();
+        const FillGroup::LevelData &l = groups[*srcPtr].levels[level];
+        const int edgeLength = l.totalEdgeSize();
 
+        if (edgeLength > 0) {
             *dstPedgeIt.rawData() = 255.0 * qreal(l.positiveEdgeSize) / (edgeLength);
             *dstNedgeIt.rawData() = 255.0 * qreal(l.negativeEdgeSize) / (edgeLength);
             *dstFedgeIt.rawData() = 255.0 * qreal(l.foreignEdgeSize) / (edgeLength);
@@ -89,6 +89,10 @@ KisColorizeStrokeStrategy::KisColorizeStrokeStrategy(KisPaintDeviceSP src,
     setNeedsExplicitCancel(true);
     setRequestsOtherStrokesToEnd(false);
     setClearsRedoOnStart(false);
+
+    // the update creates no undo data, so the strokes started
+    // while it is still pending may safely overtake it
+    setYieldsToNewStrokes(true);
 }
 
 KisColorizeStrokeStrategy::KisColorizeStrokeStrategy(const KisColorizeStrokeStrategy &rhs, int levelOfDetail)
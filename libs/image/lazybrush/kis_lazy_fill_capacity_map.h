@@ -44,6 +44,7 @@ public:
           m_bLabelRect(m_bLabelImage->exactBounds() & boundingRect),
           m_colorSpace(mainImage->colorSpace()),
           m_pixelSize(m_colorSpace->pixelSize()),
+          m_k(2 * (m_mainRect.width() + m_mainRect.height())),
           m_graph(m_mainRect,
                   m_aLabelImage->regionExact() & boundingRect,
                   m_bLabelImage->regionExact() & boundingRect)
@@ -60,8 +61,7 @@ public:
     }
 
     int maxCapacity() const {
-        const int k  = 2 * (m_mainRect.width() + m_mainRect.height());
-        return k + 1;
+        return m_k + 1;
     }
 
     friend value_type get(type &map,
@@ -98,8 +98,9 @@ public:
             Q_ASSERT(!srcLabelA && !srcLabelB);
 
 
-            // TODO: precalculate!
-            const int k  = 2 * (map.m_mainRect.width() + map.m_mainRect.height());
+            // get() runs once per edge visited by the max-flow search,
+            // so the saturation constant is precalculated in the constructor
+            const int k = map.m_k;
 
             static const int unitValue = 256;
 
@@ -156,6 +157,7 @@ private:
 
     const KoColorSpace *m_colorSpace;
     int m_pixelSize;
+    const int m_k;
     KisRandomConstAccessorSP m_mainAccessor;
     KisRandomConstAccessorSP m_aAccessor;
     KisRandomConstAccessorSP m_bAccessor;
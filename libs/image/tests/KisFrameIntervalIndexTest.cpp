@@ -0,0 +1,101 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisFrameIntervalIndexTest.h"
+
+#include "kis_image_animation_interface.h"
+#include "kis_keyframe_channel.h"
+#include "kis_scalar_keyframe_channel.h"
+#include "kis_time_span.h"
+
+void KisFrameIntervalIndexTest::init()
+{
+    m_image = new KisImage(0, 100, 100, nullptr, "image");
+    m_layer = new KisPaintLayer(m_image, "layer1", OPACITY_OPAQUE_U8);
+    m_image->addNode(m_layer);
+}
+
+void KisFrameIntervalIndexTest::testRasterBoundaries()
+{
+    KisKeyframeChannel *channel = m_layer->getKeyframeChannel(KisKeyframeChannel::Raster.id(), true);
+    channel->addKeyframe(0);
+    channel->addKeyframe(10);
+    channel->addKeyframe(20);
+
+    KisImageAnimationInterface *animInterface = m_image->animationInterface();
+
+    QCOMPARE(animInterface->identicalFramesAt(5), KisTimeSpan::fromTimeToTime(0, 9));
+    QCOMPARE(animInterface->identicalFramesAt(12), KisTimeSpan::fromTimeToTime(10, 19));
+    QCOMPARE(animInterface->identicalFramesAt(25), KisTimeSpan::infinite(20));
+
+    // for raster-only images the index is exact
+    for (int time = 0; time < 30; time += 3) {
+        QCOMPARE(animInterface->identicalFramesAt(time),
+                 KisTimeSpan::calculateIdenticalFramesRecursive(m_image->root(), time));
+    }
+}
+
+void KisFrameIntervalIndexTest::testInvalidationOnKeyframeEdit()
+{
+    KisKeyframeChannel *channel = m_layer->getKeyframeChannel(KisKeyframeChannel::Raster.id(), true);
+    channel->addKeyframe(0);
+    channel->addKeyframe(20);
+
+    KisImageAnimationInterface *animInterface = m_image->animationInterface();
+
+    QCOMPARE(animInterface->identicalFramesAt(5), KisTimeSpan::fromTimeToTime(0, 19));
+
+    channel->addKeyframe(10);
+    QCOMPARE(animInterface->identicalFramesAt(5), KisTimeSpan::fromTimeToTime(0, 9));
+
+    channel->removeKeyframe(10);
+    QCOMPARE(animInterface->identicalFramesAt(5), KisTimeSpan::fromTimeToTime(0, 19));
+}
+
+void KisFrameIntervalIndexTest::testHiddenLayersAreIgnored()
+{
+    KisKeyframeChannel *channel1 = m_layer->getKeyframeChannel(KisKeyframeChannel::Raster.id(), true);
+    channel1->addKeyframe(0);
+    channel1->addKeyframe(10);
+
+    KisPaintLayerSP layer2 = new KisPaintLayer(m_image, "layer2", OPACITY_OPAQUE_U8);
+    m_image->addNode(layer2);
+
+    KisKeyframeChannel *channel2 = layer2->getKeyframeChannel(KisKeyframeChannel::Raster.id(), true);
+    channel2->addKeyframe(0);
+    channel2->addKeyframe(5);
+
+    KisImageAnimationInterface *animInterface = m_image->animationInterface();
+
+    QCOMPARE(animInterface->identicalFramesAt(7), KisTimeSpan::fromTimeToTime(5, 9));
+
+    layer2->setVisible(false);
+    QCOMPARE(animInterface->identicalFramesAt(7), KisTimeSpan::fromTimeToTime(0, 9));
+
+    layer2->setVisible(true);
+    QCOMPARE(animInterface->identicalFramesAt(7), KisTimeSpan::fromTimeToTime(5, 9));
+}
+
+void KisFrameIntervalIndexTest::testScalarInterpolatedSegments()
+{
+    KisKeyframeChannel *channel = m_layer->getKeyframeChannel(KisKeyframeChannel::Opacity.id(), true);
+    channel->addKeyframe(0);
+    channel->addKeyframe(10);
+
+    KisImageAnimationInterface *animInterface = m_image->animationInterface();
+
+    channel->keyframeAt<KisScalarKeyframe>(0)->setInterpolationMode(KisScalarKeyframe::Linear);
+
+    // every frame of an interpolated segment is its own interval
+    QCOMPARE(animInterface->identicalFramesAt(4), KisTimeSpan::fromTimeToTime(4, 4));
+    QCOMPARE(animInterface->identicalFramesAt(0), KisTimeSpan::fromTimeToTime(0, 0));
+    QCOMPARE(animInterface->identicalFramesAt(12), KisTimeSpan::infinite(10));
+
+    channel->keyframeAt<KisScalarKeyframe>(0)->setInterpolationMode(KisScalarKeyframe::Constant);
+    QCOMPARE(animInterface->identicalFramesAt(4), KisTimeSpan::fromTimeToTime(0, 9));
+}
+
+SIMPLE_TEST_MAIN(KisFrameIntervalIndexTest)
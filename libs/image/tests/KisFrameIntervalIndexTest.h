@@ -0,0 +1,33 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_FRAME_INTERVAL_INDEX_TEST_H
+#define KIS_FRAME_INTERVAL_INDEX_TEST_H
+
+#include <simpletest.h>
+
+#include "kis_image.h"
+#include "kis_paint_layer.h"
+
+class KisFrameIntervalIndexTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+
+    void init();
+
+    void testRasterBoundaries();
+    void testInvalidationOnKeyframeEdit();
+    void testHiddenLayersAreIgnored();
+    void testScalarInterpolatedSegments();
+
+private:
+    KisImageSP m_image;
+    KisPaintLayerSP m_layer;
+};
+
+#endif
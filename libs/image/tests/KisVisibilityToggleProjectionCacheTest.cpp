@@ -0,0 +1,61 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#include "KisVisibilityToggleProjectionCacheTest.h"
+
+#include <KoColor.h>
+#include <KoColorSpaceRegistry.h>
+
+#include "kis_image.h"
+#include "kis_paint_device.h"
+#include "kis_paint_layer.h"
+#include "KisVisibilityToggleProjectionCache.h"
+#include "kistest.h"
+
+void KisVisibilityToggleProjectionCacheTest::testPartialHitPreservesSurroundings()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, 128, 128, cs, "visibility toggle cache test");
+    KisPaintLayerSP layer = new KisPaintLayer(image, "layer", OPACITY_OPAQUE_U8);
+
+    const KoColor background(Qt::red, cs);
+    const KoColor cachedColor(Qt::green, cs);
+    const QRect imageRect = image->bounds();
+
+    // the toggled node covers only a part of the image
+    const QRect updateRect(0, 0, 64, 64);
+
+    KisPaintDeviceSP projection = image->projection();
+    projection->fill(imageRect, background);
+
+    KisVisibilityToggleProjectionCache cache;
+
+    // the first toggle only starts tracking the node
+    QVERIFY(!cache.tryApply(image.data(), layer, true, updateRect));
+
+    KisPaintDeviceSP snapshot = new KisPaintDevice(cs);
+    snapshot->fill(imageRect, cachedColor);
+    cache.storeSnapshot(layer, true, snapshot);
+    QVERIFY(cache.hasSnapshot(layer, true));
+
+    // the second toggle is served from the cache
+    QVERIFY(cache.tryApply(image.data(), layer, true, updateRect));
+
+    // the cached pixels are blitted over updateRect only, the rest
+    // of the projection survives the hit
+    KoColor actual(cs);
+
+    projection->pixel(10, 10, &actual);
+    QCOMPARE(actual, cachedColor);
+    projection->pixel(63, 63, &actual);
+    QCOMPARE(actual, cachedColor);
+
+    projection->pixel(64, 64, &actual);
+    QCOMPARE(actual, background);
+    projection->pixel(100, 100, &actual);
+    QCOMPARE(actual, background);
+}
+
+KISTEST_MAIN(KisVisibilityToggleProjectionCacheTest)
@@ -0,0 +1,18 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KISVISIBILITYTOGGLEPROJECTIONCACHETEST_H
+#define KISVISIBILITYTOGGLEPROJECTIONCACHETEST_H
+
+#include <simpletest.h>
+
+class KisVisibilityToggleProjectionCacheTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testPartialHitPreservesSurroundings();
+};
+
+#endif // KISVISIBILITYTOGGLEPROJECTIONCACHETEST_H
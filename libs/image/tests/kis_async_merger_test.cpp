@@ -122,6 +122,93 @@ void KisAsyncMergerTest::testMerger()
 }
 
 
+    /*
+      +-----------+
+      |root       |
+      | paint 3   |
+      | paint 2   |
+      | paint 1   |
+      +-----------+
+     */
+
+void KisAsyncMergerTest::testBelowFilthyCheckpoint()
+{
+    const KoColorSpace *colorSpace = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, 300, 300, colorSpace, "checkpoint test");
+
+    KisLayerSP paintLayer1 = new KisPaintLayer(image, "paint1", OPACITY_OPAQUE_U8);
+    KisLayerSP paintLayer2 = new KisPaintLayer(image, "paint2", 128);
+    KisLayerSP paintLayer3 = new KisPaintLayer(image, "paint3", OPACITY_OPAQUE_U8);
+
+    image->addNode(paintLayer1, image->rootLayer());
+    image->addNode(paintLayer2, image->rootLayer());
+    image->addNode(paintLayer3, image->rootLayer());
+
+    paintLayer1->paintDevice()->fill(QRect(0, 0, 300, 300), KoColor(Qt::red, colorSpace));
+    paintLayer2->paintDevice()->fill(QRect(50, 50, 200, 200), KoColor(Qt::green, colorSpace));
+
+    const QRect cropRect(image->bounds());
+
+    KisMergeWalker walker(cropRect);
+    KisAsyncMerger merger;
+
+    // the first pass composites the layers below the filthy one
+    // from scratch and saves the checkpoint
+    QRect dabRect1(60, 60, 100, 100);
+    paintLayer3->paintDevice()->fill(dabRect1, KoColor(Qt::blue, colorSpace));
+    walker.collectRects(paintLayer3, dabRect1);
+    merger.startMerge(walker);
+
+    // the second pass hits the same area and must restore
+    // the layers below from the checkpoint
+    QRect dabRect2(80, 80, 60, 60);
+    paintLayer3->paintDevice()->fill(dabRect2, KoColor(Qt::yellow, colorSpace));
+    walker.collectRects(paintLayer3, dabRect2);
+    merger.startMerge(walker);
+
+    QImage checkpointedProjection =
+        image->rootLayer()->projection()->convertToQImage(0, cropRect);
+
+    {
+        KisFullRefreshWalker refreshWalker(cropRect);
+        KisAsyncMerger refreshMerger;
+        refreshWalker.collectRects(image->rootLayer(), cropRect);
+        refreshMerger.startMerge(refreshWalker);
+    }
+
+    QImage referenceProjection =
+        image->rootLayer()->projection()->convertToQImage(0, cropRect);
+
+    QPoint pt;
+    QVERIFY(TestUtil::compareQImages(pt, checkpointedProjection, referenceProjection));
+
+    // changing a layer below the filthy one must invalidate
+    // the checkpoint
+    const QRect belowChangeRect(70, 70, 30, 30);
+    paintLayer1->paintDevice()->fill(belowChangeRect, KoColor(Qt::cyan, colorSpace));
+    walker.collectRects(paintLayer1, belowChangeRect);
+    merger.startMerge(walker);
+
+    walker.collectRects(paintLayer3, dabRect2);
+    merger.startMerge(walker);
+
+    QImage invalidatedProjection =
+        image->rootLayer()->projection()->convertToQImage(0, cropRect);
+
+    {
+        KisFullRefreshWalker refreshWalker(cropRect);
+        KisAsyncMerger refreshMerger;
+        refreshWalker.collectRects(image->rootLayer(), cropRect);
+        refreshMerger.startMerge(refreshWalker);
+    }
+
+    referenceProjection =
+        image->rootLayer()->projection()->convertToQImage(0, cropRect);
+
+    QVERIFY(TestUtil::compareQImages(pt, invalidatedProjection, referenceProjection));
+}
+
+
 /**
  * This in not fully automated test for child obliging in KisAsyncMerger.
  * It just checks whether devices are shared. To check if the merger
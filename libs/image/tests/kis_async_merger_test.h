@@ -17,6 +17,7 @@ private Q_SLOTS:
     void init();
 
     void testMerger();
+    void testBelowFilthyCheckpoint();
     void debugObligeChild();
     void testFullRefreshWithClones();
     void testSubgraphingWithoutUpdatingParent();
@@ -163,6 +163,55 @@ void KisConvolutionPainterTest::testSymmConvolution()
     QCOMPARE(resultData, initialData);
 }
 
+void KisConvolutionPainterTest::testSeparableConvolution()
+{
+    QImage qimage(QString(FILES_DATA_DIR) + '/' + "hakonepa.png");
+    QRect imageRect = qimage.rect();
+
+    KisPaintDeviceSP devFast = new KisPaintDevice(KoColorSpaceRegistry::instance()->rgb8());
+    devFast->setDefaultBounds(new TestUtil::TestingTimedDefaultBounds(imageRect));
+    devFast->convertFromQImage(qimage, 0, 0, 0);
+
+    KisPaintDeviceSP devRef = new KisPaintDevice(KoColorSpaceRegistry::instance()->rgb8());
+    devRef->setDefaultBounds(new TestUtil::TestingTimedDefaultBounds(imageRect));
+    devRef->convertFromQImage(qimage, 0, 0, 0);
+
+    // an outer product of two non-negative 1D kernels, so applyMatrix()
+    // is expected to take the separable two-pass path automatically
+    Eigen::Matrix<qreal, 5, 1> vert;
+    vert << 1, 4, 6, 4, 1;
+    Eigen::Matrix<qreal, 1, 5> horiz;
+    horiz << 1, 2, 4, 2, 1;
+
+    Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic> filter = vert * horiz;
+
+    KisConvolutionKernelSP kernel =
+        KisConvolutionKernel::fromMatrix(filter, 0, filter.sum());
+
+    KisConvolutionPainter gcFast(devFast, KisConvolutionPainter::SPATIAL);
+    gcFast.beginTransaction();
+    gcFast.applyMatrix(kernel, devFast, imageRect.topLeft(), imageRect.topLeft(), imageRect.size());
+    gcFast.deleteTransaction();
+
+    KisConvolutionPainter gcRef(devRef, KisConvolutionPainter::SPATIAL);
+    gcRef.beginTransaction();
+    gcRef.applyMatrixImpl(kernel, devRef, imageRect.topLeft(), imageRect.topLeft(), imageRect.size(), BORDER_REPEAT);
+    gcRef.deleteTransaction();
+
+    QImage resultFast = devFast->convertToQImage(0, 0, 0, imageRect.width(), imageRect.height());
+    QImage resultRef = devRef->convertToQImage(0, 0, 0, imageRect.width(), imageRect.height());
+
+    QPoint errpoint;
+
+    // the intermediate pass rounds its result to the channel precision,
+    // so the passes may differ from the single-pass worker by one step
+    if (!TestUtil::compareQImages(errpoint, resultRef, resultFast, 1, 1)) {
+        resultFast.save("separable_convolution_result.png");
+        resultRef.save("separable_convolution_expected.png");
+        QFAIL(QString("Separable convolution differs from the single-pass one, first different pixel: %1,%2 ").arg(errpoint.x()).arg(errpoint.y()).toLatin1());
+    }
+}
+
 void KisConvolutionPainterTest::testAsymmConvolutionImp(QBitArray channelFlags)
 {
     qreal offset = 0.0;
@@ -450,6 +499,36 @@ void KisConvolutionPainterTest::testGaussianDetailsFFTW()
     testGaussianDetails(true);
 }
 
+void KisConvolutionPainterTest::testGaussianCascade()
+{
+    const QRect imageRect(0, 0, 100, 100);
+
+    KisPaintDeviceSP dev = new KisPaintDevice(KoColorSpaceRegistry::instance()->rgb8());
+    dev->setDefaultBounds(new TestUtil::TestingTimedDefaultBounds(imageRect));
+
+    const KoColor color(QColor(120, 60, 200, 190), dev->colorSpace());
+    dev->fill(imageRect, color);
+
+    QImage referenceImage =
+        dev->convertToQImage(0, imageRect.x(), imageRect.y(), imageRect.width(), imageRect.height());
+
+    QBitArray channelFlags =
+        KoColorSpaceRegistry::instance()->rgb8()->channelFlags(true, true);
+
+    // a box cascade must keep a uniform image uniform, both for the
+    // color channels and for the (premultiplied) alpha
+    KisGaussianKernel::applyGaussianCascade(dev, imageRect, 7, 7, channelFlags, 0);
+
+    QImage resultImage =
+        dev->convertToQImage(0, imageRect.x(), imageRect.y(), imageRect.width(), imageRect.height());
+
+    QPoint errpoint;
+    if (!TestUtil::compareQImages(errpoint, referenceImage, resultImage, 1, 1)) {
+        resultImage.save("gaussian_cascade_result.png");
+        QFAIL(QString("Box blur cascade changed a uniform image, first different pixel: %1,%2 ").arg(errpoint.x()).arg(errpoint.y()).toLatin1());
+    }
+}
+
 #include "kis_transaction.h"
 
 void KisConvolutionPainterTest::testDilate()
@@ -31,6 +31,8 @@ private Q_SLOTS:
     void testIdentityConvolution();
     void testSymmConvolution();
 
+    void testSeparableConvolution();
+
     void testAsymmAllChannels();
     void testAsymmSkipRed();
     void testAsymmSkipGreen();
@@ -47,6 +49,8 @@ private Q_SLOTS:
     void testGaussianDetailsSpatial();
     void testGaussianDetailsFFTW();
 
+    void testGaussianCascade();
+
     void testDilate();
     void testErode();
 
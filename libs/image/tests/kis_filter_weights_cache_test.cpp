@@ -0,0 +1,61 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_filter_weights_cache_test.h"
+
+#include <simpletest.h>
+
+#include "kis_filter_strategy.h"
+#include "kis_filter_weights_buffer.h"
+#include "kis_filter_weights_cache.h"
+
+void KisFilterWeightsCacheTest::testBufferReuse()
+{
+    KisBilinearFilterStrategy bilinear;
+    KisLanczos3FilterStrategy lanczos;
+
+    QSharedPointer<KisFilterWeightsBuffer> b1 =
+        KisFilterWeightsCache::instance()->weights(&bilinear, 0.5);
+    QSharedPointer<KisFilterWeightsBuffer> b2 =
+        KisFilterWeightsCache::instance()->weights(&bilinear, 0.5);
+
+    // the same (filter, scale) pair shares one buffer
+    QVERIFY(b1 == b2);
+
+    // a different scale or filter gets its own buffer
+    QVERIFY(KisFilterWeightsCache::instance()->weights(&bilinear, 0.25) != b1);
+    QVERIFY(KisFilterWeightsCache::instance()->weights(&lanczos, 0.5) != b1);
+}
+
+void KisFilterWeightsCacheTest::testCachedWeightsMatchFreshBuffer()
+{
+    KisLanczos3FilterStrategy lanczos;
+    const qreal scale = 0.73;
+
+    QSharedPointer<KisFilterWeightsBuffer> cached =
+        KisFilterWeightsCache::instance()->weights(&lanczos, scale);
+    KisFilterWeightsBuffer fresh(&lanczos, scale);
+
+    QCOMPARE(cached->maxSpan(), fresh.maxSpan());
+    QCOMPARE(cached->weightsPositionScale(), fresh.weightsPositionScale());
+
+    for (int i = 0; i < 256; i++) {
+        KisFixedPoint pos;
+        pos.from256Frac(i);
+
+        KisFilterWeightsBuffer::FilterWeights *w1 = cached->weights(pos);
+        KisFilterWeightsBuffer::FilterWeights *w2 = fresh.weights(pos);
+
+        QCOMPARE(w1->span, w2->span);
+        QCOMPARE(w1->centerIndex, w2->centerIndex);
+
+        for (int j = 0; j < w1->span; j++) {
+            QCOMPARE(w1->weight[j], w2->weight[j]);
+        }
+    }
+}
+
+SIMPLE_TEST_MAIN(KisFilterWeightsCacheTest)
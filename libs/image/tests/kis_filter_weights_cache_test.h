@@ -0,0 +1,20 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __KIS_FILTER_WEIGHTS_CACHE_TEST_H
+#define __KIS_FILTER_WEIGHTS_CACHE_TEST_H
+
+#include <simpletest.h>
+
+class KisFilterWeightsCacheTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testBufferReuse();
+    void testCachedWeightsMatchFreshBuffer();
+};
+
+#endif /* __KIS_FILTER_WEIGHTS_CACHE_TEST_H */
@@ -374,6 +374,38 @@ void KisImageTest::testCloneImage()
     }
 }
 
+void KisImageTest::testProjectionSnapshot()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, IMAGE_WIDTH, IMAGE_HEIGHT, cs, "snapshot test");
+
+    KisLayerSP paint1 = new KisPaintLayer(image, "paint1", OPACITY_OPAQUE_U8);
+    image->addNode(paint1, image->root());
+
+    paint1->paintDevice()->fill(image->bounds(), KoColor(Qt::red, cs));
+    image->initialRefreshGraph();
+
+    KisPaintDeviceSP snapshot = image->projectionSnapshot();
+    const QImage refImage = image->projection()->convertToQImage(0, image->bounds());
+    QCOMPARE(snapshot->convertToQImage(0, image->bounds()), refImage);
+
+    // no composite pass has finished since, so the snapshot is reused
+    QVERIFY(image->projectionSnapshot() == snapshot);
+
+    paint1->paintDevice()->fill(QRect(0, 0, 64, 64), KoColor(Qt::green, cs));
+    image->refreshGraphAsync();
+    image->waitForDone();
+
+    // the already published snapshot is immutable...
+    QCOMPARE(snapshot->convertToQImage(0, image->bounds()), refImage);
+
+    // ...while the republished one sees the finished pass
+    KisPaintDeviceSP snapshot2 = image->projectionSnapshot();
+    QVERIFY(snapshot2 != snapshot);
+    QCOMPARE(snapshot2->convertToQImage(0, image->bounds()),
+             image->projection()->convertToQImage(0, image->bounds()));
+}
+
 void KisImageTest::testLayerComposition()
 {
     KisImageSP image = new KisImage(0, IMAGE_WIDTH, IMAGE_WIDTH, 0, "layer tests");
@@ -23,6 +23,7 @@ private Q_SLOTS:
     void testAssignImageProfile();
     void testGlobalSelection();
     void testCloneImage();
+    void testProjectionSnapshot();
     void testLayerComposition();
 
     void testFlattenLayer();
@@ -462,6 +462,60 @@ void KisIteratorNGTest::sequentialIteratorWithProgressIncomplete()
     QCOMPARE(proxy.value(), proxy.max());
 }
 
+void KisIteratorNGTest::spanIter(const KoColorSpace * colorSpace)
+{
+    KisPaintDeviceSP dev = new KisPaintDevice(colorSpace);
+
+    // a rect deliberately not aligned to the tile grid
+    const QRect rect(10, 10, 147, 52);
+
+    KoColor c(QColor(100, 200, 50), colorSpace);
+
+    forEachSpan(dev, rect, [&] (const KisPixelSpan &span) {
+        QCOMPARE(span.pixelSize, qint32(colorSpace->pixelSize()));
+
+        quint8 *ptr = span.data;
+        for (qint32 i = 0; i < span.nPixels; i++) {
+            memcpy(ptr, c.data(), span.pixelSize);
+            ptr += span.pixelSize;
+        }
+    });
+
+    QCOMPARE(dev->exactBounds(), rect);
+
+    qint64 numPixels = 0;
+
+    forEachConstSpan(dev, rect, [&] (const KisConstPixelSpan &span) {
+        QVERIFY(span.nPixels > 0);
+        QVERIFY(span.x >= rect.left());
+        QVERIFY(span.x + span.nPixels - 1 <= rect.right());
+        QVERIFY(span.y >= rect.top());
+        QVERIFY(span.y <= rect.bottom());
+
+        const quint8 *ptr = span.data;
+        for (qint32 i = 0; i < span.nPixels; i++) {
+            QVERIFY(memcmp(ptr, c.data(), span.pixelSize) == 0);
+            ptr += span.pixelSize;
+        }
+
+        numPixels += span.nPixels;
+    });
+
+    QCOMPARE(numPixels, qint64(rect.width()) * rect.height());
+
+    { // empty rect should never enter the functor
+        forEachConstSpan(dev, QRect(), [&] (const KisConstPixelSpan &span) {
+            Q_UNUSED(span);
+            QVERIFY(0 && "we should never enter the loop");
+        });
+    }
+}
+
+void KisIteratorNGTest::spanIter()
+{
+    allCsApplicator(&KisIteratorNGTest::spanIter);
+}
+
 void KisIteratorNGTest::hLineIter()
 {
     allCsApplicator(&KisIteratorNGTest::hLineIter);
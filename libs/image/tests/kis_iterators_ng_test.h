@@ -24,6 +24,7 @@ private:
     void writeBytes(const KoColorSpace * cs);
     void fill(const KoColorSpace * cs);
     void sequentialIter(const KoColorSpace * colorSpace);
+    void spanIter(const KoColorSpace * colorSpace);
     void hLineIter(const KoColorSpace * cs);
     void randomAccessor(const KoColorSpace * cs);
 
@@ -35,6 +36,7 @@ private Q_SLOTS:
     void sequentialIter();
     void sequentialIteratorWithProgress();
     void sequentialIteratorWithProgressIncomplete();
+    void spanIter();
     void hLineIter();
     void randomAccessor();
 };
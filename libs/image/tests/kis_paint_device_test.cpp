@@ -379,6 +379,40 @@ void KisPaintDeviceTest::testMakeClone()
     }
 }
 
+void KisPaintDeviceTest::testCreateSnapshot()
+{
+    QImage image(QString(FILES_DATA_DIR) + '/' + "hakonepa.png");
+
+    const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisPaintDeviceSP srcDev = new KisPaintDevice(cs);
+    srcDev->convertFromQImage(image, 0);
+
+    const QRect fullRect = srcDev->exactBounds();
+    QPoint errpoint;
+
+    KisPaintDeviceSP snapshot = srcDev->createSnapshot();
+
+    QVERIFY(*snapshot->colorSpace() == *srcDev->colorSpace());
+    QCOMPARE(snapshot->exactBounds(), fullRect);
+
+    QImage srcImage = srcDev->convertToQImage(0, fullRect);
+    QImage snapshotImage = snapshot->convertToQImage(0, fullRect);
+    if (!TestUtil::compareQImages(errpoint, snapshotImage, srcImage)) {
+        QFAIL(QString("Snapshot doesn't match the source, first different pixel: %1,%2 \n").arg(errpoint.x()).arg(errpoint.y()).toLatin1());
+    }
+
+    // the shared tiles are copy-on-write, so changing the source
+    // device must not be visible in the snapshot
+    KisPainter gc(srcDev);
+    gc.fill(0, 0, fullRect.width(), fullRect.height(), KoColor(Qt::red, cs));
+    gc.end();
+
+    snapshotImage = snapshot->convertToQImage(0, fullRect);
+    if (!TestUtil::compareQImages(errpoint, snapshotImage, srcImage)) {
+        QFAIL(QString("Snapshot changed after the source was overwritten, first different pixel: %1,%2 \n").arg(errpoint.x()).arg(errpoint.y()).toLatin1());
+    }
+}
+
 void KisPaintDeviceTest::testThumbnail()
 {
     QImage image(QString(FILES_DATA_DIR) + '/' + "hakonepa.png");
@@ -1538,6 +1572,62 @@ void KisPaintDeviceTest::testLodDevice()
                                   "lod", "lod1-offset-6-14"));
 }
 
+void KisPaintDeviceTest::testLodDeviceIncrementalSync()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+    TestingLodDefaultBounds *bounds = new TestingLodDefaultBounds();
+    dev->setDefaultBounds(bounds);
+
+    KisPaintDeviceSP refDev = new KisPaintDevice(cs);
+    TestingLodDefaultBounds *refBounds = new TestingLodDefaultBounds();
+    refDev->setDefaultBounds(refBounds);
+
+    fillGradientDevice(dev, QRect(50,50,30,30));
+    fillGradientDevice(refDev, QRect(50,50,30,30));
+
+    // no LoD plane exists yet
+    QVERIFY(!dev->canSyncLodDataStructIncrementally(1));
+
+    bounds->testingSetLevelOfDetail(1);
+    syncLodCache(dev, 1);
+    bounds->testingSetLevelOfDetail(0);
+
+    QVERIFY(dev->canSyncLodDataStructIncrementally(1));
+    QVERIFY(!dev->canSyncLodDataStructIncrementally(2));
+
+    // change one area and erase another one
+    fillGradientDevice(dev, QRect(50,50,10,10), true);
+    dev->clear(QRect(70,70,10,10));
+
+    fillGradientDevice(refDev, QRect(50,50,10,10), true);
+    refDev->clear(QRect(70,70,10,10));
+
+    // sync only the changed rects into the seeded struct
+    bounds->testingSetLevelOfDetail(1);
+    {
+        KisPaintDevice::LodDataStruct *s = dev->createLodDataStruct(1, true);
+        dev->updateLodDataStruct(s, QRect(50,50,10,10));
+        dev->updateLodDataStruct(s, QRect(70,70,10,10));
+        dev->uploadLodDataStruct(s);
+        delete s;
+    }
+
+    refBounds->testingSetLevelOfDetail(1);
+    syncLodCache(refDev, 1);
+
+    QCOMPARE(dev->convertToQImage(0,0,0,100,100),
+             refDev->convertToQImage(0,0,0,100,100));
+
+    bounds->testingSetLevelOfDetail(0);
+
+    // a changed default pixel invalidates the plane
+    KoColor green(Qt::green, cs);
+    dev->setDefaultPixel(green);
+    QVERIFY(!dev->canSyncLodDataStructIncrementally(1));
+}
+
 void KisPaintDeviceTest::benchmarkLod1Generation()
 {
     const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
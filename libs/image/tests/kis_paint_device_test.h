@@ -30,6 +30,7 @@ private Q_SLOTS:
     void testRoundtripConversion();
     void testFastBitBlt();
     void testMakeClone();
+    void testCreateSnapshot();
     void testBltPerformance();
     void testColorSpaceConversion();
     void testDeviceDuplication();
@@ -53,6 +54,7 @@ private Q_SLOTS:
 
     void testLodTransform();
     void testLodDevice();
+    void testLodDeviceIncrementalSync();
     void benchmarkLod1Generation();
     void benchmarkLod2Generation();
     void benchmarkLod3Generation();
@@ -469,6 +469,48 @@ void KisPainterTest::testBitBltOldData()
     srcGc.deleteTransaction();
 }
 
+void KisPainterTest::testParallelBitBlt()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+
+    KisPaintDeviceSP src = new KisPaintDevice(cs);
+
+    // fill the source with a non-uniform pattern so that band
+    // boundaries of the parallel path would show up as differences
+    {
+        KisSequentialIterator it(src, QRect(0, 0, 1024, 1024));
+        while (it.nextPixel()) {
+            KoColor c(QColor(it.x() % 255, it.y() % 255, (it.x() + it.y()) % 255), cs);
+            memcpy(it.rawData(), c.data(), cs->pixelSize());
+        }
+    }
+
+    // a rect deliberately not aligned to the tile grid
+    const QRect blitRect(3, 5, 1000, 1013);
+
+    KisPaintDeviceSP dstSerial = new KisPaintDevice(cs);
+    {
+        KisPainter gc(dstSerial);
+        gc.setCompositeOpId(COMPOSITE_OVER);
+        gc.bitBlt(blitRect.topLeft(), src, blitRect);
+    }
+
+    KisPaintDeviceSP dstParallel = new KisPaintDevice(cs);
+    {
+        KisPainter gc(dstParallel);
+        gc.setCompositeOpId(COMPOSITE_OVER);
+        gc.setParallelBlitting(true);
+        QVERIFY(gc.parallelBlitting());
+        gc.bitBlt(blitRect.topLeft(), src, blitRect);
+    }
+
+    QPoint errpoint;
+    if (!TestUtil::comparePaintDevices(errpoint, dstSerial, dstParallel)) {
+        QFAIL(QString("Parallel bitBlt differs from serial at %1,%2")
+              .arg(errpoint.x()).arg(errpoint.y()).toLatin1());
+    }
+}
+
 #include "kis_paint_device_debug_utils.h"
 #include "KisRenderedDab.h"
 
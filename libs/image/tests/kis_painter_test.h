@@ -39,6 +39,7 @@ private Q_SLOTS:
     void testSelectionBitBltEraseCompositeOp();
 
     void testBitBltOldData();
+    void testParallelBitBlt();
 
     void testMassiveBltFixedSingleTile();
     void testMassiveBltFixedMultiTile();
@@ -16,6 +16,10 @@
 #include "kis_perspectivetransform_worker.h"
 #include "kis_transaction.h"
 
+#include <KoColorSpaceRegistry.h>
+#include "kis_paint_device.h"
+#include "kis_random_accessor_ng.h"
+
 
 class PerspectiveWorkerTester : public TestUtil::QImageBasedTest
 {
@@ -60,4 +64,48 @@ void KisPerspectiveTransformWorkerTest::testSimpleTransform()
     t.checkLayer("simple_transform");
 }
 
+void KisPerspectiveTransformWorkerTest::testParallelRunPartialDst()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+
+    const QRect srcRect(0, 0, 1200, 1200);
+    KisPaintDeviceSP src = new KisPaintDevice(cs);
+
+    KisRandomAccessorSP it = src->createRandomAccessorNG();
+    for (int y = srcRect.y(); y < srcRect.y() + srcRect.height(); y++) {
+        for (int x = srcRect.x(); x < srcRect.x() + srcRect.width(); x++) {
+            it->moveTo(x, y);
+            *reinterpret_cast<quint32*>(it->rawData()) =
+                0xFF000000 | quint32((x * 7 + y * 13) & 0xFFFFFF);
+        }
+    }
+
+    QTransform transform(1.1, 0.02, 1e-4,
+                         -0.03, 0.9, 5e-5,
+                         13.7, -21.3, 1.0);
+
+    KisPerspectiveTransformWorker worker(0, transform, true, 0);
+
+    // one big call goes through the banded parallel path...
+    KisPaintDeviceSP dstParallel = new KisPaintDevice(cs);
+    worker.runPartialDst(src, dstParallel, srcRect);
+
+    // ...while thin strips stay below the threshold and run serially
+    KisPaintDeviceSP dstSerial = new KisPaintDevice(cs);
+    for (int y = srcRect.y(); y < srcRect.y() + srcRect.height(); y += 40) {
+        worker.runPartialDst(src, dstSerial, QRect(srcRect.x(), y, srcRect.width(), 40));
+    }
+
+    QImage parallelImage = dstParallel->convertToQImage(0, srcRect);
+    QImage serialImage = dstSerial->convertToQImage(0, srcRect);
+
+    QPoint errpoint;
+    if (!TestUtil::compareQImages(errpoint, serialImage, parallelImage)) {
+        serialImage.save("perspective_parallel_expected.png");
+        parallelImage.save("perspective_parallel_result.png");
+        QFAIL(QString("Parallel perspective mapping diverged from the serial one, first different pixel: %1,%2")
+              .arg(errpoint.x()).arg(errpoint.y()).toLatin1());
+    }
+}
+
 SIMPLE_TEST_MAIN(KisPerspectiveTransformWorkerTest)
@@ -318,9 +318,26 @@ void KisPixelSelectionTest::testOutlineCacheTransactions()
     QCOMPARE(psel1->outlineCache().boundingRect(), QRectF(10,10,90,90));
 
     {
+        // an empty transaction changes no pixels, so the cache
+        // survives the commit untouched
         KisTransaction t(psel1);
         t.end();
-        QVERIFY(!psel1->outlineCacheValid());
+        QVERIFY(psel1->outlineCacheValid());
+        QCOMPARE(psel1->outlineCache().boundingRect(), QRectF(10,10,90,90));
+    }
+
+    {
+        KisTransaction t(psel1);
+
+        // paints past the cache, the commit has to splice the painted
+        // area back into it
+        KisPainter gc(psel1);
+        gc.fill(150, 10, 50, 90, KoColor(Qt::white, KoColorSpaceRegistry::instance()->rgb8()));
+
+        t.end();
+
+        QVERIFY(psel1->outlineCacheValid());
+        QCOMPARE(psel1->outlineCache().boundingRect(), QRectF(10,10,190,90));
     }
 
     psel1->clear();
@@ -12,6 +12,7 @@
 #include <floodfill/kis_scanline_fill.h>
 #include <floodfill/kis_fill_interval.h>
 #include <floodfill/kis_fill_interval_map.h>
+#include <floodfill/kis_gap_map_cache.h>
 
 #include <KoColor.h>
 #include <KoColorSpace.h>
@@ -356,4 +357,56 @@ void KisScanlineFillTest::testGapClosingFill()
     testGapClosingFillGeneral(QPoint(147, 97), 32);
 }
 
+void KisScanlineFillTest::testGapClosingFillWithCache()
+{
+    const KoColorSpace* cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+
+    QImage srcImage(TestUtil::fetchDataFileLazy("close_gap_low.png"));
+    QVERIFY(!srcImage.isNull());
+
+    QRect imageRect = srcImage.rect();
+
+    dev->convertFromQImage(srcImage, 0, 0, 0);
+
+    KisGapMapCacheSP cache = new KisGapMapCache();
+
+    // Consecutive fills sharing the cache must produce exactly
+    // the same selections as independent fills.
+    const QVector<QPoint> seeds({QPoint(103, 94), QPoint(43, 30)});
+
+    Q_FOREACH (const QPoint &seed, seeds) {
+        KisPixelSelectionSP referenceSelection = new KisPixelSelection(new KisSelectionDefaultBounds(dev));
+        {
+            KisScanlineFill gc(dev, seed, imageRect);
+            gc.setThreshold(1);
+            gc.setOpacitySpread(100);
+            gc.setCloseGap(3);
+            gc.fillSelection(referenceSelection);
+        }
+
+        KisPixelSelectionSP cachedSelection = new KisPixelSelection(new KisSelectionDefaultBounds(dev));
+        {
+            KisScanlineFill gc(dev, seed, imageRect);
+            gc.setThreshold(1);
+            gc.setOpacitySpread(100);
+            gc.setCloseGap(3);
+            gc.setGapMapCache(cache);
+            gc.fillSelection(cachedSelection);
+        }
+
+        QCOMPARE(cachedSelection->selectedExactRect(), referenceSelection->selectedExactRect());
+
+        QImage cachedImage =
+            cachedSelection->convertToQImage(0,
+                                             imageRect.x(), imageRect.y(),
+                                             imageRect.width(), imageRect.height());
+        QImage referenceImage =
+            referenceSelection->convertToQImage(0,
+                                                imageRect.x(), imageRect.y(),
+                                                imageRect.width(), imageRect.height());
+        QCOMPARE(cachedImage, referenceImage);
+    }
+}
+
 SIMPLE_TEST_MAIN(KisScanlineFillTest)
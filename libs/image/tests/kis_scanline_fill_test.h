@@ -28,6 +28,7 @@ private Q_SLOTS:
     void testExternalFill();
 
     void testGapClosingFill();
+    void testGapClosingFillWithCache();
 
 private:
     void testFillGeneral(const QVector<KisFillInterval> &initialBackwardIntervals,
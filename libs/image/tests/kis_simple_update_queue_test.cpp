@@ -22,6 +22,7 @@
 
 #include "kis_update_job_item.h"
 #include "kis_simple_update_queue.h"
+#include "kis_image_config.h"
 #include "scheduler_utils.h"
 #include <KisGlobalResourcesInterface.h>
 
@@ -112,32 +113,125 @@ void KisSimpleUpdateQueueTest::testSplit(bool useFullRefresh)
 
     QRect dirtyRect1(0,0,1000,1000);
 
+    // the number of bands of a full refresh depends on the
+    // configured number of threads, so fix it for the test
+    KisImageConfig config(false);
+    const int oldNumberOfThreads = config.maxNumberOfThreads();
+    config.setMaxNumberOfThreads(4);
+
     KisTestableSimpleUpdateQueue queue;
     KisWalkersList& walkersList = queue.getWalkersList();
 
     if(!useFullRefresh) {
         queue.addUpdateJob(paintLayer, dirtyRect1, imageRect, 0);
+
+        QCOMPARE(walkersList.size(), 4);
+
+        QVERIFY(checkWalker(walkersList[0], QRect(0,0,512,512)));
+        QVERIFY(checkWalker(walkersList[1], QRect(512,0,488,512)));
+        QVERIFY(checkWalker(walkersList[2], QRect(0,512,512,488)));
+        QVERIFY(checkWalker(walkersList[3], QRect(512,512,488,488)));
     }
     else {
         queue.addFullRefreshJob(paintLayer, dirtyRect1, imageRect, 0);
-    }
 
-    QCOMPARE(walkersList.size(), 4);
+        // 2 * 4 threads => 8 column bands of 128px (the last one is cropped)
 
-    QVERIFY(checkWalker(walkersList[0], QRect(0,0,512,512)));
-    QVERIFY(checkWalker(walkersList[1], QRect(512,0,488,512)));
-    QVERIFY(checkWalker(walkersList[2], QRect(0,512,512,488)));
-    QVERIFY(checkWalker(walkersList[3], QRect(512,512,488,488)));
+        QCOMPARE(walkersList.size(), 8);
+
+        for (int i = 0; i < walkersList.size(); i++) {
+            const qint32 x = i * 128;
+            QVERIFY(checkWalker(walkersList[i],
+                                QRect(x, 0, qMin(128, 1000 - x), 1000)));
+        }
+    }
+
+    const int numWalkers = walkersList.size();
 
     queue.optimize();
 
     //must change nothing
 
-    QCOMPARE(walkersList.size(), 4);
-    QVERIFY(checkWalker(walkersList[0], QRect(0,0,512,512)));
-    QVERIFY(checkWalker(walkersList[1], QRect(512,0,488,512)));
-    QVERIFY(checkWalker(walkersList[2], QRect(0,512,512,488)));
-    QVERIFY(checkWalker(walkersList[3], QRect(512,512,488,488)));
+    QCOMPARE(walkersList.size(), numWalkers);
+
+    config.setMaxNumberOfThreads(oldNumberOfThreads);
+}
+
+void KisSimpleUpdateQueueTest::testSplitForIdleThreads()
+{
+    QRect imageRect(0,0,512,512);
+
+    const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, imageRect.width(), imageRect.height(), cs, "merge test");
+
+    KisPaintLayerSP paintLayer = new KisPaintLayer(image, "test", OPACITY_OPAQUE_U8);
+
+    image->barrierLock();
+    image->addNode(paintLayer);
+    image->unlock();
+
+    /**
+     * The rect fits into a single patch, so it stays a single walker
+     * in the queue; with four idle threads processQueue() is expected
+     * to halve it twice before dispatching
+     */
+    QRect dirtyRect(0,0,512,512);
+
+    KisTestableSimpleUpdateQueue queue;
+    KisTestableUpdaterContext context(4);
+
+    queue.addUpdateJob(paintLayer, dirtyRect, imageRect, 0);
+    QCOMPARE(queue.getWalkersList().size(), 1);
+
+    queue.processQueue(context);
+
+    QVector<KisUpdateJobItem*> jobs = context.getJobs();
+
+    QCOMPARE(jobs.size(), 4);
+    QVERIFY(checkWalker(jobs[0]->walker(), QRect(0,0,256,256)));
+    QVERIFY(checkWalker(jobs[1]->walker(), QRect(0,256,256,256)));
+    QVERIFY(checkWalker(jobs[2]->walker(), QRect(256,0,256,256)));
+    QVERIFY(checkWalker(jobs[3]->walker(), QRect(256,256,256,256)));
+
+    QVERIFY(queue.getWalkersList().isEmpty());
+}
+
+void KisSimpleUpdateQueueTest::testTinyUpdatesCoalescing()
+{
+    QRect imageRect(0,0,512,512);
+
+    const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, imageRect.width(), imageRect.height(), cs, "merge test");
+
+    KisPaintLayerSP paintLayer = new KisPaintLayer(image, "test", OPACITY_OPAQUE_U8);
+
+    image->barrierLock();
+    image->addNode(paintLayer);
+    image->unlock();
+
+    KisTestableSimpleUpdateQueue queue;
+    KisWalkersList& walkersList = queue.getWalkersList();
+
+    /**
+     * Distant tiny dabs would never pass the alpha test (the united
+     * rect is an order of magnitude bigger than the dabs themselves),
+     * but they fit into the coalescing budget of one tile, so they
+     * should share a single walker
+     */
+    queue.addUpdateJob(paintLayer, QRect(10,10,5,5), imageRect, 0);
+    queue.addUpdateJob(paintLayer, QRect(40,40,5,5), imageRect, 0);
+
+    QCOMPARE(walkersList.size(), 1);
+    QVERIFY(checkWalker(walkersList[0], QRect(10,10,35,35)));
+
+    /**
+     * Tiny dabs whose united rect exceeds the budget still go
+     * through the usual alpha test and stay separate
+     */
+    queue.addUpdateJob(paintLayer, QRect(200,200,2,2), imageRect, 0);
+    queue.addUpdateJob(paintLayer, QRect(400,400,2,2), imageRect, 0);
+
+    QCOMPARE(walkersList.size(), 3);
 }
 
 void KisSimpleUpdateQueueTest::testChecksum()
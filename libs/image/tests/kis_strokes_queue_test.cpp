@@ -158,6 +158,80 @@ void KisStrokesQueueTest::testExclusiveStrokes()
     QCOMPARE(queue.needsExclusiveAccess(), false);
 }
 
+namespace {
+struct KisYieldingTestingStrokeStrategy : KisTestingStrokeStrategy
+{
+    KisYieldingTestingStrokeStrategy(const QLatin1String &prefix)
+        : KisTestingStrokeStrategy(prefix, false, true)
+    {
+        setYieldsToNewStrokes(true);
+    }
+};
+}
+
+void KisStrokesQueueTest::testYieldingStrokes()
+{
+    KisStrokesQueue queue;
+    KisTestableUpdaterContext context(2);
+    QVector<KisUpdateJobItem*> jobs;
+
+    /**
+     * A pending yielding stroke is overtaken by a stroke
+     * started after it
+     */
+    KisStrokeId bgId = queue.startStroke(new KisYieldingTestingStrokeStrategy(QLatin1String("bg_")));
+    queue.addJob(bgId, new KisStrokeJobData(KisStrokeJobData::CONCURRENT));
+    queue.endStroke(bgId);
+
+    KisStrokeId id = queue.startStroke(new KisTestingStrokeStrategy(QLatin1String("brush_"), false, true));
+    queue.addJob(id, new KisStrokeJobData(KisStrokeJobData::CONCURRENT));
+    queue.endStroke(id);
+
+    queue.processQueue(context, false);
+
+    jobs = context.getJobs();
+    COMPARE_NAME(jobs[0], "brush_dab");
+    VERIFY_EMPTY(jobs[1]);
+
+    context.clear();
+    queue.processQueue(context, false);
+
+    jobs = context.getJobs();
+    COMPARE_NAME(jobs[0], "bg_dab");
+    VERIFY_EMPTY(jobs[1]);
+
+    context.clear();
+    queue.processQueue(context, false);
+    QVERIFY(queue.isEmpty());
+
+    /**
+     * A yielding stroke that has already started execution
+     * is not overtaken anymore
+     */
+    bgId = queue.startStroke(new KisYieldingTestingStrokeStrategy(QLatin1String("bg_")));
+    queue.addJob(bgId, new KisStrokeJobData(KisStrokeJobData::CONCURRENT));
+    queue.addJob(bgId, new KisStrokeJobData(KisStrokeJobData::CONCURRENT));
+    queue.endStroke(bgId);
+
+    context.clear();
+    queue.processQueue(context, false);
+
+    jobs = context.getJobs();
+    COMPARE_NAME(jobs[0], "bg_dab");
+    COMPARE_NAME(jobs[1], "bg_dab");
+
+    id = queue.startStroke(new KisTestingStrokeStrategy(QLatin1String("brush_"), false, true));
+    queue.addJob(id, new KisStrokeJobData(KisStrokeJobData::CONCURRENT));
+    queue.endStroke(id);
+
+    context.clear();
+    queue.processQueue(context, false);
+
+    jobs = context.getJobs();
+    COMPARE_NAME(jobs[0], "brush_dab");
+    VERIFY_EMPTY(jobs[1]);
+}
+
 void KisStrokesQueueTest::testBarrierStrokeJobs()
 {
     KisStrokesQueue queue;
@@ -19,6 +19,7 @@ private Q_SLOTS:
     void testSequentialJobs();
     void testConcurrentSequentialBarrier();
     void testExclusiveStrokes();
+    void testYieldingStrokes();
     void testBarrierStrokeJobs();
     void testStrokesOverlapping();
     void testImmediateCancel();
@@ -749,6 +749,74 @@ void KisTransformWorkerTest::testScaleUp5times()
     QCOMPARE(rc.height(), qCeil(image.height() * SCALE));
 }
 
+void fillColumnPattern(KisPaintDeviceSP dev, const QRect &rc)
+{
+    KisRandomAccessorSP it = dev->createRandomAccessorNG();
+
+    for (int y = rc.y(); y < rc.y() + rc.height(); y++) {
+        for (int x = rc.x(); x < rc.x() + rc.width(); x++) {
+            it->moveTo(x, y);
+            *reinterpret_cast<quint32*>(it->rawData()) = 0xFF000000 | quint32(0x010101 * (x % 251));
+        }
+    }
+}
+
+void KisTransformWorkerTest::testXScaleParallelStrips()
+{
+    TestUtil::TestProgressBar bar;
+    KoProgressUpdater pu(&bar);
+
+    const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisFilterStrategy * filter = new KisBicubicFilterStrategy();
+
+    /**
+     * The pattern depends on the column only, so every row goes
+     * through exactly the same resampling. The tall device is big
+     * enough to be split into tile-aligned strips and resampled on the
+     * thread pool, while the short one stays below the threshold and
+     * takes the serial path, giving us a reference to compare against.
+     */
+    const QRect tallRect(0, 0, 1024, 1024);
+    const QRect shortRect(0, 0, 1024, 16);
+
+    KisPaintDeviceSP tallDev = new KisPaintDevice(cs);
+    KisPaintDeviceSP shortDev = new KisPaintDevice(cs);
+
+    fillColumnPattern(tallDev, tallRect);
+    fillColumnPattern(shortDev, shortRect);
+
+    KisTransformWorker tw1(tallDev, 0.7312, 1.0,
+                           0.0, 0.0,
+                           0.0,
+                           0, 0, pu.startSubtask(), filter);
+    tw1.run();
+
+    KisTransformWorker tw2(shortDev, 0.7312, 1.0,
+                           0.0, 0.0,
+                           0.0,
+                           0, 0, pu.startSubtask(), filter);
+    tw2.run();
+
+    const QRect tallBounds = tallDev->exactBounds();
+    const QRect shortBounds = shortDev->exactBounds();
+
+    QCOMPARE(tallBounds.x(), shortBounds.x());
+    QCOMPARE(tallBounds.width(), shortBounds.width());
+
+    QImage reference = shortDev->convertToQImage(0,
+                                                 shortBounds.x(),
+                                                 shortBounds.y() + shortBounds.height() / 2,
+                                                 shortBounds.width(), 1);
+
+    QVector<int> rows;
+    rows << tallBounds.top() + 1 << tallBounds.center().y() << tallBounds.bottom() - 1;
+
+    Q_FOREACH (int y, rows) {
+        QImage row = tallDev->convertToQImage(0, tallBounds.x(), y, tallBounds.width(), 1);
+        QCOMPARE(row, reference);
+    }
+}
+
 void KisTransformWorkerTest::rotate90Left()
 {
     const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
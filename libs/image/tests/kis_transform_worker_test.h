@@ -40,6 +40,7 @@ private Q_SLOTS:
     void testMatrices();
     void testRotationSpecialCases();
     void testScaleUp5times();
+    void testXScaleParallelStrips();
     void rotate90Left();
     void rotate90Right();
     void rotate180();
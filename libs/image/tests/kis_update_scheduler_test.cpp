@@ -374,6 +374,11 @@ void KisUpdateSchedulerTest::testBlockUpdates()
 
 #include "kis_update_time_monitor.h"
 
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
 void KisUpdateSchedulerTest::testTimeMonitor()
 {
     QVector<QRect> dirtyRects;
@@ -401,6 +406,46 @@ void KisUpdateSchedulerTest::testTimeMonitor()
     KisUpdateTimeMonitor::instance()->endStrokeMeasure();
 }
 
+void KisUpdateSchedulerTest::testJobTimingSamples()
+{
+    KisUpdateTimeMonitor *monitor = KisUpdateTimeMonitor::instance();
+
+    // overflow the ring buffer, only the newest samples should survive
+    const int numSamples = 1500;
+
+    for (int i = 0; i < numSamples; i++) {
+        KisUpdateTimeMonitor::JobTimingSample sample;
+        sample.jobType = KisUpdateTimeMonitor::JobTimingSample::Merge;
+        sample.walkerType = 0;
+        sample.queueWaitUsecs = i;
+        sample.execUsecs = 2 * i;
+        sample.dirtyArea = 64 * 64;
+        monitor->reportJobExecuted(sample);
+    }
+
+    QVector<KisUpdateTimeMonitor::JobTimingSample> samples =
+        monitor->jobTimingSamples();
+
+    QCOMPARE(samples.size(), 1024);
+    QCOMPARE(samples.first().queueWaitUsecs, qint64(numSamples - 1024));
+    QCOMPARE(samples.last().queueWaitUsecs, qint64(numSamples - 1));
+    QCOMPARE(samples.last().execUsecs, qint64(2 * (numSamples - 1)));
+
+    const QString fileName = "update_job_timings.json";
+    QVERIFY(monitor->dumpJobTimingsJson(fileName));
+
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    QCOMPARE(doc.object()["updateJobs"].toArray().size(), 1024);
+
+    file.close();
+    file.remove();
+}
+
 void KisUpdateSchedulerTest::testLodSync()
 {
     KisImageSP image = buildTestingImage();
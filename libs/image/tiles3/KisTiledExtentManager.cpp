@@ -9,6 +9,8 @@
 
 #include <QMutex>
 #include <QVector>
+#include <QtAlgorithms>
+#include <cstring>
 #include "kis_tile_data_interface.h"
 #include "kis_assert.h"
 #include "kis_global.h"
@@ -21,12 +23,14 @@ KisTiledExtentManager::Data::Data()
     m_capacity = InitialBufferSize;
     m_offset = 1;
     m_buffer = new QAtomicInt[m_capacity];
+    m_summary = new quint64[m_capacity >> 6]();
 }
 
 KisTiledExtentManager::Data::~Data()
 {
     QWriteLocker lock(&m_migrationLock);
     delete[] m_buffer;
+    delete[] m_summary;
 }
 
 bool KisTiledExtentManager::Data::add(qint32 index)
@@ -61,6 +65,7 @@ bool KisTiledExtentManager::Data::add(qint32 index)
                 needsUpdateExtent = true;
 
                 m_buffer[currentIndex].storeRelease(1);
+                updateSummaryBit(currentIndex);
             } else {
                 m_buffer[currentIndex].storeRelease(oldValue + 1);
             }
@@ -100,6 +105,13 @@ bool KisTiledExtentManager::Data::remove(qint32 index)
         rl.unlock();
         QWriteLocker wl(&m_extentLock);
 
+        /**
+         * The counter may have been incremented back by a concurrent
+         * add() while we were relocking, so derive the bit from the
+         * current counter value instead of clearing it blindly
+         */
+        updateSummaryBit(currentIndex);
+
         if (m_min == index) updateMin();
         if (m_max == index) updateMax();
 
@@ -118,6 +130,7 @@ void KisTiledExtentManager::Data::replace(const QVector<qint32> &indexes)
     for (qint32 i = 0; i < m_capacity; ++i) {
         m_buffer[i].storeRelaxed(0);
     }
+    memset(m_summary, 0, (m_capacity >> 6) * sizeof(quint64));
 
     m_min = qint32_MAX;
     m_max = qint32_MIN;
@@ -136,6 +149,7 @@ void KisTiledExtentManager::Data::clear()
     for (qint32 i = 0; i < m_capacity; ++i) {
         m_buffer[i].storeRelaxed(0);
     }
+    memset(m_summary, 0, (m_capacity >> 6) * sizeof(quint64));
 
     m_min = qint32_MAX;
     m_max = qint32_MIN;
@@ -167,6 +181,7 @@ void KisTiledExtentManager::Data::unsafeAdd(qint32 index)
     }
 
     if (!m_buffer[currentIndex].fetchAndAddRelaxed(1)) {
+        m_summary[currentIndex >> 6] |= quint64(1) << (currentIndex & 63);
         if (m_min > index) m_min = index;
         if (m_max < index) m_max = index;
         ++m_count;
@@ -198,6 +213,19 @@ void KisTiledExtentManager::Data::unsafeMigrate(qint32 index)
 
         delete[] m_buffer;
         m_buffer = newBuffer;
+
+        // the entries have shifted by an arbitrary amount of bits,
+        // so just rebuild the summary bitmap from the counters
+        quint64 *newSummary = new quint64[m_capacity >> 6]();
+
+        for (qint32 i = 0; i < m_capacity; ++i) {
+            if (m_buffer[i].loadRelaxed() > 0) {
+                newSummary[i >> 6] |= quint64(1) << (i & 63);
+            }
+        }
+
+        delete[] m_summary;
+        m_summary = newSummary;
     }
 }
 
@@ -211,15 +239,21 @@ void KisTiledExtentManager::Data::updateMin()
 {
     KIS_SAFE_ASSERT_RECOVER_NOOP(m_min != qint32_MAX);
 
-    qint32 start = m_min + m_offset;
+    const qint32 start = m_min + m_offset;
+    const qint32 numWords = m_capacity >> 6;
 
-    for (qint32 i = start; i < m_capacity; ++i) {
-        qint32 current = m_buffer[i].loadRelaxed();
+    qint32 wordIndex = start >> 6;
+    quint64 word = m_summary[wordIndex] & (~quint64(0) << (start & 63));
 
-        if (current > 0) {
+    while (true) {
+        if (word) {
+            const qint32 i = (wordIndex << 6) + qCountTrailingZeroBits(word);
             m_min = i - m_offset;
             return;
         }
+
+        if (++wordIndex >= numWords) break;
+        word = m_summary[wordIndex];
     }
 
     m_min = qint32_MAX;
@@ -229,20 +263,34 @@ void KisTiledExtentManager::Data::updateMax()
 {
     KIS_SAFE_ASSERT_RECOVER_NOOP(m_min != qint32_MIN);
 
-    qint32 start = m_max + m_offset;
+    const qint32 start = m_max + m_offset;
 
-    for (qint32 i = start; i >= 0; --i) {
-        qint32 current = m_buffer[i].loadRelaxed();
+    qint32 wordIndex = start >> 6;
+    quint64 word = m_summary[wordIndex] & (~quint64(0) >> (63 - (start & 63)));
 
-        if (current > 0) {
+    while (true) {
+        if (word) {
+            const qint32 i = (wordIndex << 6) + 63 - qCountLeadingZeroBits(word);
             m_max = i - m_offset;
             return;
         }
+
+        if (--wordIndex < 0) break;
+        word = m_summary[wordIndex];
     }
 
     m_max = qint32_MIN;
 }
 
+void KisTiledExtentManager::Data::updateSummaryBit(qint32 currentIndex)
+{
+    if (m_buffer[currentIndex].loadAcquire() > 0) {
+        m_summary[currentIndex >> 6] |= quint64(1) << (currentIndex & 63);
+    } else {
+        m_summary[currentIndex >> 6] &= ~(quint64(1) << (currentIndex & 63));
+    }
+}
+
 KisTiledExtentManager::KisTiledExtentManager()
 {
     QWriteLocker l(&m_extentLock);
@@ -295,6 +343,11 @@ void KisTiledExtentManager::clear()
 
     QWriteLocker lock(&m_extentLock);
     m_currentExtent = QRect();
+
+    m_approximateX.storeRelaxed(0);
+    m_approximateY.storeRelaxed(0);
+    m_approximateWidth.storeRelaxed(0);
+    m_approximateHeight.storeRelaxed(0);
 }
 
 QRect KisTiledExtentManager::extent() const
@@ -303,6 +356,14 @@ QRect KisTiledExtentManager::extent() const
     return m_currentExtent;
 }
 
+QRect KisTiledExtentManager::approximateExtent() const
+{
+    return QRect(m_approximateX.loadRelaxed(),
+                 m_approximateY.loadRelaxed(),
+                 m_approximateWidth.loadRelaxed(),
+                 m_approximateHeight.loadRelaxed());
+}
+
 void KisTiledExtentManager::updateExtent()
 {
     qint32 minX, width, minY, height;
@@ -333,4 +394,9 @@ void KisTiledExtentManager::updateExtent()
 
     QWriteLocker lock(&m_extentLock);
     m_currentExtent = QRect(minX, minY, width, height);
+
+    m_approximateX.storeRelaxed(minX);
+    m_approximateY.storeRelaxed(minY);
+    m_approximateWidth.storeRelaxed(width);
+    m_approximateHeight.storeRelaxed(height);
 }
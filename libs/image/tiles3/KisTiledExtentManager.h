@@ -42,6 +42,7 @@ class KRITAIMAGE_EXPORT KisTiledExtentManager
         inline void migrate(qint32 index);
         inline void updateMin();
         inline void updateMax();
+        inline void updateSummaryBit(qint32 currentIndex);
 
     private:
         qint32 m_min;
@@ -50,6 +51,16 @@ class KRITAIMAGE_EXPORT KisTiledExtentManager
         qint32 m_capacity;
         qint32 m_count;
         QAtomicInt *m_buffer;
+
+        /**
+         * A one-bit-per-index summary of m_buffer: bit i is set iff
+         * m_buffer[i] > 0. Lets updateMin()/updateMax() skip 64 empty
+         * indexes per word instead of probing the counters one by
+         * one, which makes shrinking the extent after big erases
+         * effectively O(capacity / 64). The bitmap is only read and
+         * written under a write-locked m_extentLock.
+         */
+        quint64 *m_summary;
         QReadWriteLock m_migrationLock;
     };
 
@@ -62,6 +73,16 @@ public:
     void clear();
     QRect extent() const;
 
+    /**
+     * A lock-free snapshot of the extent for consumers that only
+     * need a hint, e.g. for scheduling decisions. The components
+     * are read without any synchronization, so the returned rect
+     * may lag behind concurrent modifications or even mix the
+     * coordinates of two of them. Use extent() whenever an exact
+     * answer is needed.
+     */
+    QRect approximateExtent() const;
+
 private:
     void updateExtent();
     friend class KisTiledDataManagerTest;
@@ -69,6 +90,10 @@ private:
 private:
     mutable QReadWriteLock m_extentLock;
     QRect m_currentExtent;
+    QAtomicInt m_approximateX;
+    QAtomicInt m_approximateY;
+    QAtomicInt m_approximateWidth;
+    QAtomicInt m_approximateHeight;
     Data m_colsData;
     Data m_rowsData;
 };
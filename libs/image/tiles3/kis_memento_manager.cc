@@ -62,8 +62,9 @@
 #define namedTransactionInProgress() ((bool)m_currentMemento)
 
 KisMementoManager::KisMementoManager()
-    : m_index(0),
+    : m_index(new KisMementoItemHashTable(0)),
       m_headsHashTable(0),
+      m_pendingIndex(0),
       m_registrationBlocked(false)
 {
     /**
@@ -73,11 +74,14 @@ KisMementoManager::KisMementoManager()
 }
 
 KisMementoManager::KisMementoManager(const KisMementoManager& rhs)
-    : m_index(rhs.m_index, 0),
+    : m_index(new KisMementoItemHashTable(*rhs.m_index, 0)),
         m_revisions(rhs.m_revisions),
         m_cancelledRevisions(rhs.m_cancelledRevisions),
         m_headsHashTable(rhs.m_headsHashTable, 0),
         m_currentMemento(rhs.m_currentMemento),
+        m_pendingIndex(rhs.m_pendingIndex ?
+                       new KisMementoItemHashTable(*rhs.m_pendingIndex, 0) : 0),
+        m_pendingMemento(rhs.m_pendingMemento),
         m_registrationBlocked(rhs.m_registrationBlocked)
 {
     Q_ASSERT_X(!m_registrationBlocked,
@@ -87,8 +91,9 @@ KisMementoManager::KisMementoManager(const KisMementoManager& rhs)
 
 KisMementoManager::~KisMementoManager()
 {
-    // Nothing to be done here. Happily...
-    // Everything is done by QList and KisSharedPtr...
+    // Everything else is done by QList and KisSharedPtr...
+    delete m_pendingIndex;
+    delete m_index;
     DEBUG_LOG_SIMPLE_ACTION("died\n");
 }
 
@@ -116,12 +121,12 @@ void KisMementoManager::registerTileChange(KisTile *tile)
 
     DEBUG_LOG_TILE_ACTION("reg. [C]", tile, tile->col(), tile->row());
 
-    KisMementoItemSP mi = m_index.getExistingTile(tile->col(), tile->row());
+    KisMementoItemSP mi = m_index->getExistingTile(tile->col(), tile->row());
 
     if(!mi) {
         mi = new KisMementoItem();
         mi->changeTile(tile);
-        m_index.addTile(mi);
+        m_index->addTile(mi);
 
         if(namedTransactionInProgress()) {
             m_currentMemento->updateExtent(mi->col(), mi->row(), &m_currentMementoExtentLock);
@@ -139,7 +144,7 @@ void KisMementoManager::registerTileDeleted(KisTile *tile)
 
     DEBUG_LOG_TILE_ACTION("reg. [D]", tile, tile->col(), tile->row());
 
-    KisMementoItemSP mi = m_index.getExistingTile(tile->col(), tile->row());
+    KisMementoItemSP mi = m_index->getExistingTile(tile->col(), tile->row());
 
     if(!mi) {
         mi = new KisMementoItem();
@@ -148,7 +153,7 @@ void KisMementoManager::registerTileDeleted(KisTile *tile)
         mi->deleteTile(tile, defaultTileData);
         defaultTileData->deref();
 
-        m_index.addTile(mi);
+        m_index->addTile(mi);
 
         if(namedTransactionInProgress()) {
             m_currentMemento->updateExtent(mi->col(), mi->row(), &m_currentMementoExtentLock);
@@ -163,28 +168,14 @@ void KisMementoManager::registerTileDeleted(KisTile *tile)
     }
 }
 
-void KisMementoManager::commit()
+void KisMementoManager::commitRevision(KisMementoItemHashTable *index, KisMemento *memento)
 {
-    if (m_index.isEmpty()) {
-        if(namedTransactionInProgress()) {
-            //warnTiles << "Named Transaction is empty";
-            /**
-             * We still need to continue commit, because
-             * a named transaction may be reverted by the user
-             */
-        }
-        else {
-            m_currentMemento = 0;
-            return;
-        }
-    }
-
     KisMementoItemList revisionList;
     KisMementoItemSP mi;
     KisMementoItemSP parentMI;
     bool newTile;
 
-    KisMementoItemHashTableIterator iter(&m_index);
+    KisMementoItemHashTableIterator iter(index);
     while ((mi = iter.tile())) {
         parentMI = m_headsHashTable.getTileLazy(mi->col(), mi->row(), newTile);
 
@@ -200,11 +191,48 @@ void KisMementoManager::commit()
 
     KisHistoryItem hItem;
     hItem.itemList = revisionList;
-    hItem.memento = m_currentMemento.data();
+    hItem.memento = memento;
     m_revisions.append(hItem);
+}
+
+void KisMementoManager::flushDeferredCommit()
+{
+    if (!m_pendingIndex) return;
+
+    commitRevision(m_pendingIndex, m_pendingMemento.data());
+
+    delete m_pendingIndex;
+    m_pendingIndex = 0;
+    m_pendingMemento = 0;
+
+    DEBUG_DUMP_MESSAGE("DEFERRED_COMMIT_DONE");
+
+    // Waking up pooler to prepare copies for us
+    KisTileDataStore::instance()->kickPooler();
+}
+
+void KisMementoManager::commit()
+{
+    flushDeferredCommit();
+
+    if (m_index->isEmpty()) {
+        if(namedTransactionInProgress()) {
+            //warnTiles << "Named Transaction is empty";
+            /**
+             * We still need to continue commit, because
+             * a named transaction may be reverted by the user
+             */
+        }
+        else {
+            m_currentMemento = 0;
+            return;
+        }
+    }
+
+    commitRevision(m_index, m_currentMemento.data());
 
     m_currentMemento = 0;
-    KIS_ASSERT(m_index.isEmpty());
+    KIS_ASSERT(m_index->isEmpty());
 
     DEBUG_DUMP_MESSAGE("COMMIT_DONE");
 
@@ -212,6 +240,30 @@ void KisMementoManager::commit()
     KisTileDataStore::instance()->kickPooler();
 }
 
+void KisMementoManager::commitDeferred()
+{
+    if (m_index->isEmpty() && !namedTransactionInProgress()) {
+        m_currentMemento = 0;
+        return;
+    }
+
+    flushDeferredCommit();
+
+    /**
+     * Detach the INDEX as-is. The tiles continue to be owned by the
+     * memento items, so the only thing we postpone is linking them
+     * into the heads hash table and the revisions list. Any further
+     * tile registrations go into the fresh INDEX and will form the
+     * next revision, exactly as if commit() had been called here.
+     */
+    m_pendingIndex = m_index;
+    m_pendingMemento = m_currentMemento;
+    m_index = new KisMementoItemHashTable(0);
+    m_currentMemento = 0;
+
+    DEBUG_DUMP_MESSAGE("COMMIT_DEFERRED");
+}
+
 KisTileSP KisMementoManager::getCommittedTile(qint32 col, qint32 row, bool &existingTile)
 {
     /**
@@ -241,7 +293,7 @@ KisMementoSP KisMementoManager::getMemento()
      * But in places with "consistent history", e.g. in layer's paint
      * device, such usage will cause undo corruption.
      */
-    // KIS_SAFE_ASSERT_RECOVER_NOOP(m_index.isEmpty());
+    // KIS_SAFE_ASSERT_RECOVER_NOOP(m_index->isEmpty());
 
     // Clear redo() information
     m_cancelledRevisions.clear();
@@ -321,7 +373,7 @@ void KisMementoManager::rollback(KisTileHashTable *ht, KisMementoSP memento)
 
 void KisMementoManager::rollforward(KisTileHashTable *ht, KisMementoSP memento)
 {
-    KIS_SAFE_ASSERT_RECOVER_RETURN(m_index.isEmpty());
+    KIS_SAFE_ASSERT_RECOVER_RETURN(m_index->isEmpty());
 
     if (!m_cancelledRevisions.size()) return;
 
@@ -340,7 +392,7 @@ void KisMementoManager::rollforward(KisTileHashTable *ht, KisMementoSP memento)
         if (mi->type() == KisMementoItem::CHANGED)
             ht->addTile(mi->tile(this));
 
-        m_index.addTile(mi);
+        m_index->addTile(mi);
     }
     // see comment in rollback()
 
@@ -352,6 +404,9 @@ void KisMementoManager::rollforward(KisTileHashTable *ht, KisMementoSP memento)
 
 void KisMementoManager::purgeHistory(KisMementoSP oldestMemento)
 {
+    // the purged revision may still be pending after commitDeferred()
+    flushDeferredCommit();
+
     if (m_currentMemento == oldestMemento) {
         commit();
     }
@@ -401,7 +456,7 @@ void KisMementoManager::resetRevisionHistory(KisMementoItemList list)
 void KisMementoManager::setDefaultTileData(KisTileData *defaultTileData)
 {
     m_headsHashTable.setDefaultTileData(defaultTileData);
-    m_index.setDefaultTileData(defaultTileData);
+    m_index->setDefaultTileData(defaultTileData);
 }
 
 void KisMementoManager::debugPrintInfo()
@@ -409,7 +464,7 @@ void KisMementoManager::debugPrintInfo()
     printf("KisMementoManager stats:\n");
     printf("Index list\n");
     KisMementoItemSP mi;
-    KisMementoItemHashTableIteratorConst iter(&m_index);
+    KisMementoItemHashTableIteratorConst iter(m_index);
 
     while ((mi = iter.tile())) {
         mi->debugPrintInfo();
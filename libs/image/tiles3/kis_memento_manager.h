@@ -75,6 +75,16 @@ public:
      */
     void commit();
 
+    /**
+     * A cheap, O(1) version of commit(). The INDEX is detached into
+     * a pending slot instead of being walked right away; the actual
+     * per-tile work is postponed until the next operation touching
+     * the history (a new transaction, undo/redo or purging). Since
+     * all these operations run on the worker threads, the deferred
+     * walk never delays the end of the current stroke.
+     */
+    void commitDeferred();
+
     /**
      * Undo and Redo stuff respectively.
      *
@@ -116,6 +126,8 @@ public:
 protected:
     qint32 findRevisionByMemento(KisMementoSP memento) const;
     void resetRevisionHistory(KisMementoItemList list);
+    void commitRevision(KisMementoItemHashTable *index, KisMemento *memento);
+    void flushDeferredCommit();
 
 protected:
     /**
@@ -124,7 +136,7 @@ protected:
      * we have the only memento item for a tile
      * per commit efficiently
      */
-    KisMementoItemHashTable m_index;
+    KisMementoItemHashTable *m_index;
 
     /**
      * Main list that stores every commit ever done
@@ -149,6 +161,16 @@ protected:
     KisMementoSP m_currentMemento;
     QMutex m_currentMementoExtentLock;
 
+    /**
+     * INDEX of the revision detached by commitDeferred() and not yet
+     * walked into m_revisions. At most one revision may be pending,
+     * because any followup history operation starts with flushing it
+     *
+     * \see commitDeferred()
+     */
+    KisMementoItemHashTable *m_pendingIndex;
+    KisMementoSP m_pendingMemento;
+
     /**
      * The flag that blocks registration of changes on tiles.
      * This is a temporary state of the memento manager, that
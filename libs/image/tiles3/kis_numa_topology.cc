@@ -0,0 +1,141 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_numa_topology.h"
+
+#include <QAtomicInt>
+#include <QVector>
+
+#include <kis_debug.h>
+#include <kis_image_config.h>
+
+#ifdef Q_OS_LINUX
+#include <QDir>
+#include <QFile>
+#include <sched.h>
+#endif
+
+namespace
+{
+
+struct NumaTopology {
+    int numNodes = 1;
+
+#ifdef Q_OS_LINUX
+    /// cpu index -> node index, folded into KisNumaTopology::MAX_NODES
+    QVector<int> cpuToNode;
+    /// node index -> affinity mask with the cpus of that node
+    QVector<cpu_set_t> nodeMasks;
+#endif
+
+    bool enabled = false;
+
+    NumaTopology()
+    {
+        enabled = KisImageConfig(true).useNumaAwareTilePools();
+        if (!enabled) return;
+
+#ifdef Q_OS_LINUX
+        QDir nodesDir("/sys/devices/system/node");
+        const QStringList nodes =
+            nodesDir.entryList(QStringList() << "node[0-9]*", QDir::Dirs);
+
+        if (nodes.size() < 2) return;
+
+        numNodes = qMin(nodes.size(), KisNumaTopology::MAX_NODES);
+        nodeMasks.resize(numNodes);
+
+        for (int i = 0; i < numNodes; i++) {
+            CPU_ZERO(&nodeMasks[i]);
+        }
+
+        Q_FOREACH (const QString &node, nodes) {
+            const int nodeIndex =
+                qBound(0, node.mid(4).toInt() % KisNumaTopology::MAX_NODES,
+                       numNodes - 1);
+
+            QFile cpuList(nodesDir.filePath(node + "/cpulist"));
+            if (!cpuList.open(QIODevice::ReadOnly)) continue;
+
+            // the format is a comma-separated list of ranges: "0-7,16-23"
+            Q_FOREACH (const QByteArray &range,
+                       cpuList.readAll().trimmed().split(',')) {
+
+                const int dashPos = range.indexOf('-');
+                const int first = dashPos >= 0 ? range.left(dashPos).toInt() : range.toInt();
+                const int last = dashPos >= 0 ? range.mid(dashPos + 1).toInt() : first;
+
+                for (int cpu = first; cpu <= last; cpu++) {
+                    if (cpu >= cpuToNode.size()) {
+                        cpuToNode.resize(cpu + 1);
+                    }
+                    cpuToNode[cpu] = nodeIndex;
+                    CPU_SET(cpu, &nodeMasks[nodeIndex]);
+                }
+            }
+        }
+
+        dbgImage << "NUMA-aware tile pools enabled:" << numNodes << "nodes";
+#endif
+    }
+};
+
+const NumaTopology& topology()
+{
+    static NumaTopology topology;
+    return topology;
+}
+
+} // namespace
+
+namespace KisNumaTopology
+{
+
+bool isActive()
+{
+    return topology().enabled && topology().numNodes > 1;
+}
+
+int numNodes()
+{
+    return topology().numNodes;
+}
+
+int currentNode()
+{
+    if (!isActive()) return 0;
+
+#ifdef Q_OS_LINUX
+    const int cpu = sched_getcpu();
+    if (cpu >= 0 && cpu < topology().cpuToNode.size()) {
+        return topology().cpuToNode[cpu];
+    }
+#endif
+
+    return 0;
+}
+
+void bindCurrentThreadRoundRobin()
+{
+    if (!isActive()) return;
+
+#ifdef Q_OS_LINUX
+    static QAtomicInt nextNode;
+    static thread_local bool bound = false;
+
+    if (bound) return;
+    bound = true;
+
+    const int node = nextNode.fetchAndAddRelaxed(1) % topology().numNodes;
+    cpu_set_t mask = topology().nodeMasks[node];
+
+    if (sched_setaffinity(0, sizeof(mask), &mask)) {
+        warnKrita << "WARNING: failed to bind an updater thread to NUMA node" << node;
+    }
+#endif
+}
+
+} // namespace KisNumaTopology
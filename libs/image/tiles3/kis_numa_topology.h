@@ -0,0 +1,66 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_NUMA_TOPOLOGY_H_
+#define KIS_NUMA_TOPOLOGY_H_
+
+#include "kritaimage_export.h"
+
+/**
+ * A tiny helper for NUMA-aware tile pool binning.
+ *
+ * On multi-socket workstations the tile engine suffers from
+ * cross-node memory traffic when an updater thread reuses a tile
+ * data buffer that was first touched on the other socket. To avoid
+ * that we keep a separate recycling pool per NUMA node and let each
+ * thread push/pop buffers from the pool of the node it is currently
+ * running on (see KisTileData::allocateData()).
+ *
+ * The topology is discovered lazily from sysfs on Linux. On other
+ * platforms (or when the detection fails) the helper degrades to a
+ * single node, which makes the per-node pools behave exactly like
+ * the old global one.
+ *
+ * The whole feature is guarded by
+ * KisImageConfig::useNumaAwareTilePools(), which defaults to off.
+ */
+namespace KisNumaTopology
+{
+    /**
+     * The pools are statically sized, so the number of supported
+     * nodes is capped. Nodes above the limit are folded into node 0.
+     */
+    static constexpr int MAX_NODES = 8;
+
+    /**
+     * Whether the NUMA-aware mode is both enabled in the config
+     * and the machine actually has more than one memory node.
+     */
+    KRITAIMAGE_EXPORT bool isActive();
+
+    /**
+     * Number of detected memory nodes, in the range [1, MAX_NODES]
+     */
+    KRITAIMAGE_EXPORT int numNodes();
+
+    /**
+     * The node the calling thread is currently running on. Returns 0
+     * when NUMA-aware mode is inactive, so it can be used as a pool
+     * index unconditionally.
+     */
+    KRITAIMAGE_EXPORT int currentNode();
+
+    /**
+     * Softly binds the calling thread to the CPUs of one NUMA node,
+     * chosen round-robin over the detected nodes. Used by the updater
+     * context workers so that first-touch allocation keeps their tile
+     * data node-local. No-op when NUMA-aware mode is inactive, and
+     * binds each thread only once.
+     */
+    KRITAIMAGE_EXPORT void bindCurrentThreadRoundRobin();
+}
+
+#endif /* KIS_NUMA_TOPOLOGY_H_ */
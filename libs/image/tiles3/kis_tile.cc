@@ -257,6 +257,13 @@ void KisTile::lockForWrite()
 #endif
     }
 
+    /**
+     * Whether we detached a fresh copy or got exclusive access to
+     * the old data, the caller is free to modify it from now on, so
+     * any cached content checksum is potentially stale.
+     */
+    m_tileData->invalidateContentChecksum();
+
     DEBUG_LOG_ACTION("lock [W]");
 }
 
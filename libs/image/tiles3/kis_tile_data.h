@@ -26,6 +26,11 @@ inline quint8* KisTileData::data() const {
 void KisTileData::setData(const quint8 *data) {
     Q_ASSERT(m_data);
     memcpy(m_data, data, m_pixelSize*WIDTH*HEIGHT);
+    invalidateContentChecksum();
+}
+
+inline void KisTileData::invalidateContentChecksum() {
+    m_checksumValid.storeRelease(0);
 }
 
 inline quint32 KisTileData::pixelSize() const {
@@ -96,6 +101,27 @@ inline void KisTileData::setSwapChunk(KisChunk chunk) {
     m_swapChunk = chunk;
 }
 
+inline int KisTileData::swapStripeIndex() const {
+    return m_swapStripeIndex;
+}
+inline void KisTileData::setSwapStripeIndex(int index) {
+    m_swapStripeIndex = index;
+}
+
+inline QByteArray KisTileData::compressedData() const {
+    return m_compressedData;
+}
+inline void KisTileData::setCompressedData(const QByteArray &data) {
+    m_compressedData = data;
+}
+
+inline std::list<KisTileData*>::iterator KisTileData::memoryTierPosition() const {
+    return m_memoryTierPosition;
+}
+inline void KisTileData::setMemoryTierPosition(std::list<KisTileData*>::iterator position) {
+    m_memoryTierPosition = position;
+}
+
 inline bool KisTileData::mementoed() const {
     return m_mementoFlag;
 }
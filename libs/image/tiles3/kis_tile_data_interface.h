@@ -10,6 +10,9 @@
 
 #include <QReadWriteLock>
 #include <QAtomicInt>
+#include <QByteArray>
+
+#include <list>
 
 #include "kis_lockless_stack.h"
 #include "swap/kis_chunk_allocator.h"
@@ -153,6 +156,50 @@ public:
     inline KisChunk swapChunk() const;
     inline void setSwapChunk(KisChunk chunk);
 
+    /**
+     * The index of the swap stripe (i.e. swap file) the
+     * chunk belongs to. \see KisSwappedDataStore
+     */
+    inline int swapStripeIndex() const;
+    inline void setSwapStripeIndex(int index);
+
+    /**
+     * When the tile data is swapped out into the in-memory
+     * compressed tier instead of the swap file, this buffer holds
+     * the compressed bytes (a null array otherwise).
+     * \see KisSwappedDataStore
+     */
+    inline QByteArray compressedData() const;
+    inline void setCompressedData(const QByteArray &data);
+
+    /**
+     * The position of the tile data in the in-memory tier's
+     * eviction queue. Only valid while compressedData() is
+     * non-null; makes removing the entry on swap-in O(1).
+     * \see KisSwappedDataStore
+     */
+    inline std::list<KisTileData*>::iterator memoryTierPosition() const;
+    inline void setMemoryTierPosition(std::list<KisTileData*>::iterator position);
+
+    /**
+     * Returns a 64-bit checksum of the tile's pixel content. The
+     * value is computed lazily on the first request and cached until
+     * the data is opened for writing, so repeated snapshots of an
+     * unchanged document hash every unique tile data only once.
+     * Tiles sharing their data through COW share the cached value as
+     * well.
+     *
+     * The caller must keep the data swapped in (i.e. hold the tile
+     * locked for read) while calling this method.
+     */
+    quint64 contentChecksum() const;
+
+    /**
+     * Drops the cached checksum. Called whenever the data becomes
+     * writable, \see KisTile::lockForWrite()
+     */
+    inline void invalidateContentChecksum();
+
     /**
      * Show whether a tile data is a part of history
      */
@@ -252,6 +299,20 @@ private:
      */
     KisChunk m_swapChunk;
 
+    /**
+     * Which of the (possibly striped) swap files the
+     * chunk lives in. Used by KisSwappedDataStore.
+     */
+    int m_swapStripeIndex = 0;
+
+    /**
+     * Compressed content of the tile while it lives in the
+     * in-memory tier of the swap, and the position of the entry
+     * in the tier's eviction queue. Used by KisSwappedDataStore.
+     */
+    QByteArray m_compressedData;
+    std::list<KisTileData*>::iterator m_memoryTierPosition;
+
 
     /**
      * The flag is set by KisMementoItem to show this
@@ -289,6 +350,14 @@ private:
      */
     mutable quint8* m_data;
 
+    /**
+     * Cached content checksum, \see contentChecksum(). The flag is
+     * atomic so that concurrent readers racing with the (idempotent)
+     * computation see either "invalid" or a fully written value.
+     */
+    mutable QAtomicInt m_checksumValid;
+    mutable quint64 m_checksum {0};
+
     /**
      * How many tiles/mementoes use
      * this tiledata through COW?
@@ -305,7 +374,11 @@ private:
     //qint32 m_timeStamp;
 
     KisTileDataStore *m_store;
-    static SimpleCache m_cache;
+    /**
+     * One recycling cache per NUMA node; all but the first are
+     * used only when KisNumaTopology::isActive() returns true
+     */
+    static SimpleCache m_cache[];
 
 public:
     static const qint32 WIDTH;
@@ -103,6 +103,22 @@ KisTileDataStore::MemoryStatistics KisTileDataStore::memoryStatistics()
     return stats;
 }
 
+KisTileDataStore::TileStatistics KisTileDataStore::tileStatistics() const
+{
+    const qint64 metricCoeff = qint64(KisTileData::WIDTH) * KisTileData::HEIGHT;
+
+    TileStatistics stats;
+    stats.allocations = m_statAllocations.loadRelaxed();
+    stats.poolHits = m_statPoolHits.loadRelaxed();
+    stats.poolMisses = m_statPoolMisses.loadRelaxed();
+    stats.swapOuts = m_statSwapOuts.loadRelaxed();
+    stats.swapIns = m_statSwapIns.loadRelaxed();
+    stats.rawSwapSize = m_statRawSwapMetric.loadRelaxed() * metricCoeff;
+    stats.compressedSwapSize = m_swappedStore.totalSwapMemoryUsed();
+
+    return stats;
+}
+
 void KisTileDataStore::tryForceUpdateMemoryStatisticsWhileIdle()
 {
     // in case the pooler is disabled, we should force it
@@ -168,6 +184,7 @@ KisTileData *KisTileDataStore::allocTileData(qint32 pixelSize, const quint8 *def
 {
     KisTileData *td = new KisTileData(pixelSize, defPixel, this);
     registerTileData(td);
+    m_statAllocations.fetchAndAddRelaxed(1);
     return td;
 }
 
@@ -178,15 +195,18 @@ KisTileData *KisTileDataStore::duplicateTileData(KisTileData *rhs)
     if (rhs->m_clonesStack.pop(td)) {
         DEBUG_PRECLONE_ACTION("+ Pre-clone HIT", rhs, td);
         DEBUG_COUNT_PRECLONE_HIT(rhs);
+        m_statPoolHits.fetchAndAddRelaxed(1);
     } else {
         rhs->blockSwapping();
         td = new KisTileData(*rhs);
         rhs->unblockSwapping();
         DEBUG_PRECLONE_ACTION("- Pre-clone #MISS#", rhs, td);
         DEBUG_COUNT_PRECLONE_MISS(rhs);
+        m_statPoolMisses.fetchAndAddRelaxed(1);
     }
 
     registerTileData(td);
+    m_statAllocations.fetchAndAddRelaxed(1);
     return td;
 }
 
@@ -201,6 +221,7 @@ void KisTileDataStore::freeTileData(KisTileData *td)
 
     if (!td->data()) {
         m_swappedStore.forgetTileData(td);
+        m_statRawSwapMetric.fetchAndAddRelaxed(-qint64(td->pixelSize()));
     } else {
         unregisterTileDataImp(td);
     }
@@ -245,6 +266,8 @@ void KisTileDataStore::ensureTileDataLoaded(KisTileData *td)
 
             m_swappedStore.swapInTileData(td);
             registerTileDataImp(td);
+            m_statSwapIns.fetchAndAddRelaxed(1);
+            m_statRawSwapMetric.fetchAndAddRelaxed(-qint64(td->pixelSize()));
 
             td->m_swapLock.unlock();
         }
@@ -271,6 +294,8 @@ bool KisTileDataStore::trySwapTileData(KisTileData *td)
     if (td->data()) {
         if (m_swappedStore.trySwapOutTileData(td)) {
             unregisterTileDataImp(td);
+            m_statSwapOuts.fetchAndAddRelaxed(1);
+            m_statRawSwapMetric.fetchAndAddRelaxed(td->pixelSize());
             result = true;
         }
     }
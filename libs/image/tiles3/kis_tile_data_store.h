@@ -47,6 +47,37 @@ public:
     MemoryStatistics memoryStatistics();
     void tryForceUpdateMemoryStatisticsWhileIdle();
 
+    /**
+     * Lightweight activity counters of the store, maintained with
+     * relaxed atomic increments on the tile hot paths. The counters
+     * grow monotonically since the start of the session; consumers
+     * that want per-interval rates should keep the previous snapshot
+     * and subtract.
+     */
+    struct TileStatistics {
+        /// number of tile datas created (including pre-clones)
+        qint64 allocations = 0;
+
+        /// duplications served from the pooler's pre-clone stack
+        qint64 poolHits = 0;
+        /// duplications that had to copy the tile synchronously
+        qint64 poolMisses = 0;
+
+        /// tiles compressed and pushed out to the swap; every
+        /// eviction (the clock-sweep passes included) is counted here
+        qint64 swapOuts = 0;
+        /// tiles decompressed back on access
+        qint64 swapIns = 0;
+
+        /// uncompressed size of the tiles currently in the swap
+        qint64 rawSwapSize = 0;
+        /// bytes the same tiles actually occupy in the swap file,
+        /// so rawSwapSize / compressedSwapSize is the compression ratio
+        qint64 compressedSwapSize = 0;
+    };
+
+    TileStatistics tileStatistics() const;
+
     /**
      * Returns total number of tiles present: in memory
      * or in a swap file
@@ -69,6 +100,16 @@ public:
         m_swapper.checkFreeMemory();
     }
 
+    /**
+     * Re-compresses historical (undo-only) tile data into the swap,
+     * freeing up to \p maxMetricToFree of the memory metric.
+     * \see KisTileDataSwapper::compactHistoricalTiles()
+     */
+    inline qint64 compactHistoricalTiles(qint64 maxMetricToFree)
+    {
+        return m_swapper.compactHistoricalTiles(maxMetricToFree);
+    }
+
     /**
      * \see m_memoryMetric
      */
@@ -167,6 +208,16 @@ private:
     QAtomicInt m_memoryMetric;
     QAtomicInt m_counter;
     QAtomicInt m_clockIndex;
+
+    /// \see TileStatistics
+    QAtomicInteger<qint64> m_statAllocations;
+    QAtomicInteger<qint64> m_statPoolHits;
+    QAtomicInteger<qint64> m_statPoolMisses;
+    QAtomicInteger<qint64> m_statSwapOuts;
+    QAtomicInteger<qint64> m_statSwapIns;
+    /// memory metric (\see m_memoryMetric) of the swapped-out tiles
+    QAtomicInteger<qint64> m_statRawSwapMetric;
+
     ConcurrentMap<int, KisTileData*> m_tileDataMap;
     QReadWriteLock m_iteratorLock;
 };
@@ -70,6 +70,19 @@ public:
      *                     and it is not a lazily created default wrapper tile
      */
     TileTypeSP getReadOnlyTileLazy(qint32 col, qint32 row, bool &existingTile);
+
+    /**
+     * A batch version of getReadOnlyTileLazy(): fetches all the
+     * tiles of a rectangular tile-grid area in one pass, taking the
+     * table lock only once instead of once per tile. The tiles are
+     * stored row-major into \p tiles, which must have room for
+     * \p numCols * \p numRows entries. Missing tiles are returned as
+     * default-data wrapper tiles, just like in getReadOnlyTileLazy().
+     */
+    void getReadOnlyTilesBatch(qint32 col, qint32 row,
+                               qint32 numCols, qint32 numRows,
+                               TileTypeSP *tiles);
+
     void addTile(TileTypeSP tile);
     bool deleteTile(TileTypeSP tile);
     bool deleteTile(qint32 col, qint32 row);
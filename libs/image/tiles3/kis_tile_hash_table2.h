@@ -12,6 +12,7 @@
 #include "3rdparty/lock_free_map/concurrent_map.h"
 #include "kis_tile.h"
 #include "kis_debug.h"
+#include <KisLockContentionTracker.h>
 
 #define SANITY_CHECK
 
@@ -82,6 +83,20 @@ public:
      *                     and it is not a lazily created default wrapper tile
      */
     TileTypeSP getReadOnlyTileLazy(qint32 col, qint32 row, bool &existingTile);
+
+    /**
+     * A batch version of getReadOnlyTileLazy(): fetches all the
+     * tiles of a rectangular tile-grid area in one pass, taking the
+     * raw-pointer lock of the garbage collector only once instead of
+     * once per tile. The tiles are stored row-major into \p tiles,
+     * which must have room for \p numCols * \p numRows entries.
+     * Missing tiles are returned as default-data wrapper tiles, just
+     * like in getReadOnlyTileLazy().
+     */
+    void getReadOnlyTilesBatch(qint32 col, qint32 row,
+                               qint32 numCols, qint32 numRows,
+                               TileTypeSP *tiles);
+
     void addTile(TileTypeSP tile);
     bool deleteTile(TileTypeSP tile);
     bool deleteTile(qint32 col, qint32 row);
@@ -158,7 +173,8 @@ private:
         TileType *tile = 0;
 
         {
-            QReadLocker locker(&m_iteratorLock);
+            KisTrackedReadLocker locker(&m_iteratorLock,
+                                        KisLockContentionTracker::TileTableIteratorRead);
             m_map.getGC().lockRawPointerAccess();
             tile = m_map.assign(idx, item.data());
         }
@@ -223,7 +239,8 @@ public:
 
     KisTileHashTableIteratorTraits2(KisTileHashTableTraits2<T> *ht) : m_ht(ht)
     {
-        m_ht->m_iteratorLock.lockForWrite();
+        KisLockContentionTracker::lockForWriteTracked(
+            &m_ht->m_iteratorLock, KisLockContentionTracker::TileTableIteratorWrite);
         m_iter.setMap(m_ht->m_map);
     }
 
@@ -359,7 +376,8 @@ typename KisTileHashTableTraits2<T>::TileTypeSP KisTileHashTableTraits2<T>::getT
 
         // iterator lock should be taken **before**
         // the pointers are locked
-        m_iteratorLock.lockForRead();
+        KisLockContentionTracker::lockForReadTracked(
+            &m_iteratorLock, KisLockContentionTracker::TileTableIteratorRead);
 
         // and now lock raw-pointers again
         m_map.getGC().lockRawPointerAccess();
@@ -433,6 +451,38 @@ typename KisTileHashTableTraits2<T>::TileTypeSP KisTileHashTableTraits2<T>::getR
     return tile;
 }
 
+template <class T>
+void KisTileHashTableTraits2<T>::getReadOnlyTilesBatch(qint32 col, qint32 row,
+                                                       qint32 numCols, qint32 numRows,
+                                                       TileTypeSP *tiles)
+{
+    m_map.getGC().lockRawPointerAccess();
+
+    TileTypeSP *it = tiles;
+    for (qint32 j = 0; j < numRows; j++) {
+        for (qint32 i = 0; i < numCols; i++, it++) {
+            const quint32 idx = calculateHashSafe(col + i, row + j);
+            *it = idx ? m_map.get(idx) : TileTypeSP();
+        }
+    }
+
+    m_map.getGC().unlockRawPointerAccess();
+
+    // wrap the missing tiles into detached default-data tiles
+    // outside the raw-pointer lock
+    it = tiles;
+    for (qint32 j = 0; j < numRows; j++) {
+        for (qint32 i = 0; i < numCols; i++, it++) {
+            if (!*it) {
+                QReadLocker locker(&m_defaultPixelDataLock);
+                *it = new TileType(col + i, row + j, m_defaultTileData, 0);
+            }
+        }
+    }
+
+    m_map.getGC().update();
+}
+
 template <class T>
 void KisTileHashTableTraits2<T>::addTile(TileTypeSP tile)
 {
@@ -263,6 +263,28 @@ KisTileHashTableTraits<T>::getReadOnlyTileLazy(qint32 col, qint32 row, bool &exi
     return tile;
 }
 
+template<class T>
+void KisTileHashTableTraits<T>::getReadOnlyTilesBatch(qint32 col, qint32 row,
+                                                      qint32 numCols, qint32 numRows,
+                                                      TileTypeSP *tiles)
+{
+    QReadLocker locker(&m_lock);
+
+    TileTypeSP *it = tiles;
+    for (qint32 j = 0; j < numRows; j++) {
+        for (qint32 i = 0; i < numCols; i++, it++) {
+            const qint32 idx = calculateHash(col + i, row + j);
+            TileTypeSP tile = getTile(col + i, row + j, idx);
+
+            if (!tile) {
+                tile = new TileType(col + i, row + j, m_defaultTileData, 0);
+            }
+
+            *it = tile;
+        }
+    }
+}
+
 template<class T>
 void KisTileHashTableTraits<T>::addTile(TileTypeSP tile)
 {
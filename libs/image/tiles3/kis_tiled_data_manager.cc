@@ -6,7 +6,12 @@
  *  SPDX-License-Identifier: GPL-2.0-or-later
  */
 
+#include <QBuffer>
 #include <QRect>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
 #include <QVector>
 
 #include "kis_tile.h"
@@ -97,6 +102,125 @@ void KisTiledDataManager::setDefaultPixelImpl(const quint8 *defaultPixel)
     memcpy(m_defaultPixel, defaultPixel, pixelSize());
 }
 
+namespace {
+
+/**
+ * A KisPaintDeviceWriter that collects the written bytes into a memory
+ * buffer instead of a store. Used by the parallel save path to let the
+ * compression workers produce ready-made byte streams.
+ */
+struct BufferPaintDeviceWriter : KisPaintDeviceWriter {
+    bool write(const QByteArray &data) override {
+        buffer.append(data);
+        return true;
+    }
+    bool write(const char *data, qint64 length) override {
+        buffer.append(data, length);
+        return true;
+    }
+
+    QByteArray buffer;
+};
+
+/**
+ * Compresses a batch of tiles into a memory buffer on a pool thread, so
+ * that the strictly sequential store-writing stage only has to dump
+ * ready-made bytes. Every task owns a private compressor, because the
+ * compressors keep internal streaming buffers.
+ */
+class TileCompressionTask : public QRunnable
+{
+public:
+    TileCompressionTask(const QVector<KisTileSP> &tiles, QSemaphore *doneSemaphore)
+        : m_tiles(tiles),
+          m_doneSemaphore(doneSemaphore)
+    {
+        setAutoDelete(false);
+    }
+
+    void run() override {
+        KisAbstractTileCompressorSP compressor =
+            KisTileCompressorFactory::create(KisTiledDataManager::CURRENT_VERSION);
+
+        m_success = true;
+
+        Q_FOREACH (KisTileSP tile, m_tiles) {
+            if (!compressor->writeTile(tile, m_writer)) {
+                m_success = false;
+                break;
+            }
+        }
+
+        m_doneSemaphore->release();
+    }
+
+    bool success() const {
+        return m_success;
+    }
+
+    const QByteArray& buffer() const {
+        return m_writer.buffer;
+    }
+
+private:
+    QVector<KisTileSP> m_tiles;
+    BufferPaintDeviceWriter m_writer;
+    QSemaphore *m_doneSemaphore;
+    bool m_success = false;
+};
+
+/**
+ * Decompresses a batch of tiles on a pool thread. The buffer holds the
+ * tiles exactly as stored -- header line plus compressed data -- so
+ * the task can replay them through a private compressor. The tile hash
+ * table supports concurrent insertion, that is its normal mode of
+ * operation during rendering.
+ */
+class TileDecompressionTask : public QRunnable
+{
+public:
+    TileDecompressionTask(const QByteArray &buffer, int numTiles, KisTiledDataManager *dm, QSemaphore *doneSemaphore)
+        : m_buffer(buffer),
+          m_numTiles(numTiles),
+          m_dm(dm),
+          m_doneSemaphore(doneSemaphore)
+    {
+        setAutoDelete(false);
+    }
+
+    void run() override {
+        KisAbstractTileCompressorSP compressor =
+            KisTileCompressorFactory::create(KisTiledDataManager::CURRENT_VERSION);
+
+        QBuffer stream(&m_buffer);
+        stream.open(QIODevice::ReadOnly);
+
+        m_success = true;
+
+        for (int i = 0; i < m_numTiles; i++) {
+            if (!compressor->readTile(&stream, m_dm)) {
+                m_success = false;
+                break;
+            }
+        }
+
+        m_doneSemaphore->release();
+    }
+
+    bool success() const {
+        return m_success;
+    }
+
+private:
+    QByteArray m_buffer;
+    int m_numTiles;
+    KisTiledDataManager *m_dm;
+    QSemaphore *m_doneSemaphore;
+    bool m_success = false;
+};
+
+}
+
 bool KisTiledDataManager::write(KisPaintDeviceWriter &store)
 {
     QReadLocker locker(&m_lock);
@@ -116,21 +240,94 @@ bool KisTiledDataManager::write(KisPaintDeviceWriter &store)
     KisTileHashTableConstIterator iter(m_hashTable);
     KisTileSP tile;
 
-    KisAbstractTileCompressorSP compressor =
-        KisTileCompressorFactory::create(CURRENT_VERSION);
+    /**
+     * Tile compression dominates the cost of saving, while the store
+     * itself only accepts sequential writes. Therefore the tiles are
+     * compressed in batches on the global thread pool and the resulting
+     * buffers are written to the store in batch order. The number of
+     * batches in flight is limited to keep the memory overhead bounded
+     * on huge devices. The tiles are self-describing (every tile header
+     * carries its own coordinates), so the resulting file is readable
+     * by the old sequential loader.
+     */
+    const int tilesPerBatch = 16;
+    const int maxBatchesInFlight = 4 * QThread::idealThreadCount();
+
+    if (retval &&
+        m_hashTable->numTiles() >= 4 * tilesPerBatch &&
+        QThread::idealThreadCount() >= 2) {
 
-    while ((tile = iter.tile())) {
-        retval = compressor->writeTile(tile, store);
-        if (!retval) {
-            warnFile << "Failed to write tile";
-            break;
+        QVector<KisTileSP> batch;
+        batch.reserve(tilesPerBatch);
+
+        bool tilesLeft = true;
+
+        while (tilesLeft && retval) {
+            QSemaphore doneSemaphore;
+            QVector<TileCompressionTask*> tasks;
+
+            while (int(tasks.size()) < maxBatchesInFlight) {
+                batch.clear();
+
+                while (batch.size() < tilesPerBatch && (tile = iter.tile())) {
+                    batch.append(tile);
+                    iter.next();
+                }
+
+                if (batch.isEmpty()) {
+                    tilesLeft = false;
+                    break;
+                }
+
+                TileCompressionTask *task =
+                    new TileCompressionTask(batch, &doneSemaphore);
+                tasks.append(task);
+
+                if (!QThreadPool::globalInstance()->tryStart(task)) {
+                    // the pool is saturated (or we are running on one
+                    // of its worker threads already), so compress the
+                    // batch in the calling thread
+                    task->run();
+                }
+            }
+
+            doneSemaphore.acquire(tasks.size());
+
+            Q_FOREACH (TileCompressionTask *task, tasks) {
+                if (retval) {
+                    retval = task->success() &&
+                        store.write(task->buffer().constData(),
+                                    task->buffer().size());
+                    if (!retval) {
+                        warnFile << "Failed to write a tile batch";
+                    }
+                }
+            }
+
+            qDeleteAll(tasks);
+        }
+    } else if (retval) {
+        KisAbstractTileCompressorSP compressor =
+            KisTileCompressorFactory::create(CURRENT_VERSION);
+
+        while ((tile = iter.tile())) {
+            retval = compressor->writeTile(tile, store);
+            if (!retval) {
+                warnFile << "Failed to write tile";
+                break;
+            }
+            iter.next();
         }
-        iter.next();
     }
 
     return retval;
 }
 bool KisTiledDataManager::read(QIODevice *stream)
+{
+    return read(stream, QRect());
+}
+
+bool KisTiledDataManager::read(QIODevice *stream, const QRect &regionOfInterest)
 {
     clear();
 
@@ -164,13 +361,108 @@ bool KisTiledDataManager::read(QIODevice *stream)
         numTiles = line.toUInt();
     }
 
-    KisAbstractTileCompressorSP compressor =
-        KisTileCompressorFactory::create(tilesVersion);
+    /**
+     * Mirrors the batched write path: the stream is still consumed
+     * sequentially, slicing off batches of tiles in their stored form,
+     * and the thread pool decompresses the batches into the hash
+     * table. Only the current version qualifies -- its tile headers
+     * carry the data size, so a batch can be sliced off without
+     * decompressing anything.
+     */
+    const int tilesPerBatch = 16;
+    const int maxBatchesInFlight = 4 * QThread::idealThreadCount();
 
     bool readSuccess = true;
-    for (quint32 i = 0; i < numTiles; i++) {
-        if (!compressor->readTile(stream, this)) {
-            readSuccess = false;
+
+    /**
+     * A region of interest also routes through the slicing loop: the
+     * headers are scanned either way, and that is what makes skipping
+     * the other tiles possible.
+     */
+    const bool useBatchedLoading =
+        tilesVersion == CURRENT_VERSION &&
+        (!regionOfInterest.isEmpty() ||
+         (numTiles >= quint32(4 * tilesPerBatch) &&
+          QThread::idealThreadCount() >= 2));
+
+    if (useBatchedLoading) {
+
+        const qint32 maxTileHeaderLength = 79; // Legacy magic
+
+        quint32 tilesRemaining = numTiles;
+
+        while (tilesRemaining > 0 && readSuccess) {
+            QSemaphore doneSemaphore;
+            QVector<TileDecompressionTask*> tasks;
+
+            while (int(tasks.size()) < maxBatchesInFlight &&
+                   tilesRemaining > 0 && readSuccess) {
+
+                QByteArray batchBuffer;
+                int batchSize = 0;
+
+                while (batchSize < tilesPerBatch && tilesRemaining > 0) {
+                    const QByteArray header = stream->readLine(maxTileHeaderLength);
+                    const QList<QByteArray> headerItems = header.trimmed().split(',');
+
+                    if (headerItems.size() != 4) {
+                        // a broken header means we lost the stream
+                        // position, there is no way to resync
+                        readSuccess = false;
+                        break;
+                    }
+
+                    const qint32 dataSize = headerItems.last().toInt();
+
+                    if (!regionOfInterest.isEmpty()) {
+                        const qint32 x = headerItems.at(0).toInt();
+                        const qint32 y = headerItems.at(1).toInt();
+                        const QRect tileRect(x, y, KisTileData::WIDTH, KisTileData::HEIGHT);
+
+                        if (!tileRect.intersects(regionOfInterest)) {
+                            stream->skip(dataSize);
+                            tilesRemaining--;
+                            continue;
+                        }
+                    }
+
+                    batchBuffer.append(header);
+                    batchBuffer.append(stream->read(dataSize));
+
+                    batchSize++;
+                    tilesRemaining--;
+                }
+
+                if (!batchSize) break;
+
+                TileDecompressionTask *task =
+                    new TileDecompressionTask(batchBuffer, batchSize, this, &doneSemaphore);
+                tasks.append(task);
+
+                if (!QThreadPool::globalInstance()->tryStart(task)) {
+                    // the pool is saturated (or we are running on one
+                    // of its worker threads already), so decompress
+                    // the batch in the calling thread
+                    task->run();
+                }
+            }
+
+            doneSemaphore.acquire(tasks.size());
+
+            Q_FOREACH (TileDecompressionTask *task, tasks) {
+                readSuccess &= task->success();
+            }
+
+            qDeleteAll(tasks);
+        }
+    } else {
+        KisAbstractTileCompressorSP compressor =
+            KisTileCompressorFactory::create(tilesVersion);
+
+        for (quint32 i = 0; i < numTiles; i++) {
+            if (!compressor->readTile(stream, this)) {
+                readSuccess = false;
+            }
         }
     }
 
@@ -178,6 +470,46 @@ bool KisTiledDataManager::read(QIODevice *stream)
     return readSuccess;
 }
 
+QVector<KisTileSP> KisTiledDataManager::tilesSnapshot() const
+{
+    QReadLocker locker(&m_lock);
+
+    QVector<KisTileSP> tiles;
+    tiles.reserve(m_hashTable->numTiles());
+
+    KisTileHashTableConstIterator iter(m_hashTable);
+    KisTileSP tile;
+
+    while ((tile = iter.tile())) {
+        tiles.append(tile);
+        iter.next();
+    }
+
+    return tiles;
+}
+
+QVector<KisTiledDataManager::TileChecksum> KisTiledDataManager::tileContentChecksums() const
+{
+    QReadLocker locker(&m_lock);
+
+    QVector<TileChecksum> checksums;
+    checksums.reserve(m_hashTable->numTiles());
+
+    KisTileHashTableConstIterator iter(m_hashTable);
+    KisTileSP tile;
+
+    while ((tile = iter.tile())) {
+        // the read lock keeps the data swapped in while we hash it
+        tile->lockForRead();
+        checksums.append({tile->col(), tile->row(),
+                          tile->tileData()->contentChecksum()});
+        tile->unlockForRead();
+        iter.next();
+    }
+
+    return checksums;
+}
+
 bool KisTiledDataManager::writeTilesHeader(KisPaintDeviceWriter &store, quint32 numTiles)
 {
     QString buffer;
@@ -338,10 +670,13 @@ void KisTiledDataManager::clear(QRect clearRect, const quint8 *clearPixel)
 
     const quint32 rowStride = KisTileData::WIDTH * pixelSize;
 
-    // Generate one row
+    /**
+     * One row of the clear pixel, generated lazily: when the rect is
+     * tile-aligned only the shared-tile-data path below is taken and
+     * the row buffer is never needed
+     */
     quint8 *clearPixelData = 0;
     quint32 maxRunLength = qMin(clearRect.width(), KisTileData::WIDTH);
-    clearPixelData = duplicatePixel(maxRunLength, clearPixel);
 
     KisTileData *td = 0;
     if (!pixelBytesAreDefault &&
@@ -375,6 +710,10 @@ void KisTiledDataManager::clear(QRect clearRect, const quint8 *clearPixel)
                      m_extentManager.notifyTileAdded(column, row);
                  }
             } else {
+                if (!clearPixelData) {
+                    clearPixelData = duplicatePixel(maxRunLength, clearPixel);
+                }
+
                 const qint32 lineSize = clearTileRect.width() * pixelSize;
                 qint32 rowsRemaining = clearTileRect.height();
 
@@ -557,6 +896,88 @@ void KisTiledDataManager::bitBltRoughImpl(KisTiledDataManager *srcDM, const QRec
     }
 }
 
+void KisTiledDataManager::bitBltTranslated(KisTiledDataManager *srcDM, const QRect &dstRect, const QPoint &alignedOffset)
+{
+    if (dstRect.isEmpty()) return;
+
+    KIS_SAFE_ASSERT_RECOVER_RETURN(!(alignedOffset.x() % KisTileData::WIDTH));
+    KIS_SAFE_ASSERT_RECOVER_RETURN(!(alignedOffset.y() % KisTileData::HEIGHT));
+
+    const qint32 columnOffset = alignedOffset.x() / KisTileData::WIDTH;
+    const qint32 rowOffset = alignedOffset.y() / KisTileData::HEIGHT;
+
+    const qint32 pixelSize = this->pixelSize();
+    const bool defaultPixelsCoincide =
+        !memcmp(srcDM->defaultPixel(), m_defaultPixel, pixelSize);
+
+    const quint32 rowStride = KisTileData::WIDTH * pixelSize;
+
+    qint32 firstColumn = xToCol(dstRect.left());
+    qint32 lastColumn = xToCol(dstRect.right());
+
+    qint32 firstRow = yToRow(dstRect.top());
+    qint32 lastRow = yToRow(dstRect.bottom());
+
+    for (qint32 row = firstRow; row <= lastRow; ++row) {
+        for (qint32 column = firstColumn; column <= lastColumn; ++column) {
+
+            bool srcTileExists = false;
+
+            KisTileSP srcTile = srcDM->getReadOnlyTileLazy(column - columnOffset,
+                                                           row - rowOffset,
+                                                           srcTileExists);
+
+            QRect tileRect(column*KisTileData::WIDTH, row*KisTileData::HEIGHT,
+                           KisTileData::WIDTH, KisTileData::HEIGHT);
+            QRect cloneTileRect = dstRect & tileRect;
+
+            if (cloneTileRect == tileRect) {
+                 // Clone whole tile
+                 const bool wasDeleted =
+                     m_hashTable->deleteTile(column, row);
+
+                 if (srcTileExists || !defaultPixelsCoincide) {
+                     srcTile->lockForRead();
+                     KisTileData *td = srcTile->tileData();
+                     KisTileSP clonedTile = KisTileSP(new KisTile(column, row, td, m_mementoManager));
+                     srcTile->unlockForRead();
+
+                     m_hashTable->addTile(clonedTile);
+
+                     if (!wasDeleted) {
+                         m_extentManager.notifyTileAdded(column, row);
+                     }
+                 } else if (wasDeleted) {
+                     m_extentManager.notifyTileRemoved(column, row);
+                 }
+
+            } else {
+                const qint32 lineSize = cloneTileRect.width() * pixelSize;
+                qint32 rowsRemaining = cloneTileRect.height();
+
+                KisTileDataWrapper tw(this,
+                                      cloneTileRect.left(),
+                                      cloneTileRect.top(),
+                                      KisTileDataWrapper::WRITE);
+                srcTile->lockForRead();
+                // the in-tile shift is the same in both tiles because
+                // the offset is aligned to the tile grid
+                const quint8* srcTileIt = srcTile->data() + tw.offset();
+                quint8* dstTileIt = tw.data();
+
+                while (rowsRemaining > 0) {
+                    memcpy(dstTileIt, srcTileIt, lineSize);
+                    srcTileIt += rowStride;
+                    dstTileIt += rowStride;
+                    rowsRemaining--;
+                }
+
+                srcTile->unlockForRead();
+            }
+        }
+    }
+}
+
 void KisTiledDataManager::bitBlt(KisTiledDataManager *srcDM, const QRect &rect)
 {
     bitBltImpl<false>(srcDM, rect);
@@ -593,6 +1014,7 @@ void KisTiledDataManager::setExtent(QRect newRect)
 
     KisTileSP tile;
     QRect tileRect;
+    QVector<quint8> defaultRow;
     {
         KisTileHashTableIterator iter(m_hashTable);
 
@@ -608,18 +1030,40 @@ void KisTiledDataManager::setExtent(QRect newRect)
                 intersection.translate(- tileRect.topLeft());
 
                 const qint32 pixelSize = this->pixelSize();
+                const qint32 rowStride = KisTileData::WIDTH * pixelSize;
+
+                /**
+                 * A row of default pixels shared by all the boundary
+                 * tiles; the cleared areas are contiguous spans, so
+                 * they can be overwritten with row-wise memcpy instead
+                 * of testing every pixel against the kept rect
+                 */
+                if (defaultRow.isEmpty()) {
+                    defaultRow.resize(rowStride);
+                    for (int x = 0; x < KisTileData::WIDTH; x++) {
+                        memcpy(defaultRow.data() + x * pixelSize, m_defaultPixel, pixelSize);
+                    }
+                }
 
                 tile->lockForWrite();
                 quint8* data = tile->data();
-                quint8* ptr;
 
-                /* FIXME: make it faster */
                 for (int y = 0; y < KisTileData::HEIGHT; y++) {
-                    for (int x = 0; x < KisTileData::WIDTH; x++) {
-                        if (!intersection.contains(x, y)) {
-                            ptr = data + pixelSize * (y * KisTileData::WIDTH + x);
-                            memcpy(ptr, m_defaultPixel, pixelSize);
-                        }
+                    quint8 *row = data + y * rowStride;
+
+                    if (y < intersection.top() || y > intersection.bottom()) {
+                        memcpy(row, defaultRow.constData(), rowStride);
+                        continue;
+                    }
+
+                    if (intersection.left() > 0) {
+                        memcpy(row, defaultRow.constData(),
+                               intersection.left() * pixelSize);
+                    }
+                    if (intersection.right() < KisTileData::WIDTH - 1) {
+                        memcpy(row + (intersection.right() + 1) * pixelSize,
+                               defaultRow.constData(),
+                               (KisTileData::WIDTH - 1 - intersection.right()) * pixelSize);
                     }
                 }
                 tile->unlockForWrite();
@@ -660,6 +1104,11 @@ QRect KisTiledDataManager::extent() const
     return m_extentManager.extent();
 }
 
+QRect KisTiledDataManager::approximateExtent() const
+{
+    return m_extentManager.approximateExtent();
+}
+
 KisRegion KisTiledDataManager::region() const
 {
     QVector<QRect> rects;
@@ -691,6 +1140,34 @@ void KisTiledDataManager::writeBytes(const quint8 *data,
     writeBytesBody(data, x, y, width, height, dataRowStride);
 }
 
+void KisTiledDataManager::prefetchSwappedTiles(const QRect &pixelRect) const
+{
+    if (pixelRect.isEmpty()) return;
+
+    QReadLocker locker(&m_lock);
+
+    const qint32 firstCol = xToCol(pixelRect.left());
+    const qint32 firstRow = yToRow(pixelRect.top());
+    const qint32 numCols = xToCol(pixelRect.right()) - firstCol + 1;
+    const qint32 numRows = yToRow(pixelRect.bottom()) - firstRow + 1;
+
+    QVector<KisTileSP> tiles(numCols * numRows);
+    getReadOnlyTilesBatch(firstCol, firstRow, numCols, numRows, tiles.data());
+
+    Q_FOREACH (KisTileSP tile, tiles) {
+        /**
+         * The unlocked check for swapped-out data is racy on
+         * purpose: prefetching is only a hint, a tile that gets
+         * swapped in or out concurrently is handled correctly by
+         * the usual locking path on first real access
+         */
+        if (!tile->tileData()->data()) {
+            tile->lockForRead();
+            tile->unlockForRead();
+        }
+    }
+}
+
 void KisTiledDataManager::readBytes(quint8 *data,
                                     qint32 x, qint32 y,
                                     qint32 width, qint32 height,
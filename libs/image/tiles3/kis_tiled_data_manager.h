@@ -121,6 +121,30 @@ public:
         return m_hashTable->getReadOnlyTileLazy(col, row, existingTile);
     }
 
+    /**
+     * Fetches all the tiles of a rectangular tile-grid area in one
+     * pass, taking the hash table synchronization cost once instead
+     * of once per tile. The tiles are stored row-major into \p tiles
+     * (room for \p numCols * \p numRows entries). Only read-only
+     * fetches can be batched: writable fetches have to go through
+     * getTile() one by one because of the COW and extent bookkeeping.
+     */
+    inline void getReadOnlyTilesBatch(qint32 col, qint32 row,
+                                      qint32 numCols, qint32 numRows,
+                                      KisTileSP *tiles) const
+    {
+        m_hashTable->getReadOnlyTilesBatch(col, row, numCols, numRows, tiles);
+    }
+
+    /**
+     * Forces the tiles intersecting \p pixelRect that were swapped
+     * out back into memory. Used by the predictive swap-in stage:
+     * a low-priority background job prefetches the area just outside
+     * the canvas viewport, so panning over a partially swapped
+     * document doesn't stall on synchronous decompression.
+     */
+    void prefetchSwappedTiles(const QRect &pixelRect) const;
+
     inline KisTileSP getOldTile(qint32 col, qint32 row, bool &existingTile) {
         KisTileSP tile = m_mementoManager->getCommittedTile(col, row, existingTile);
         return tile ? tile : getReadOnlyTileLazy(col, row, existingTile);
@@ -152,6 +176,25 @@ public:
         m_mementoManager->commit();
     }
 
+    /**
+     * The same as commit(), but the expensive part of the commit is
+     * postponed until the next operation touching the history. Used
+     * to keep the end-of-stroke latency independent of the stroke
+     * size.
+     *
+     * \see KisMementoManager::commitDeferred()
+     */
+    void commitDeferred() {
+        QWriteLocker locker(&m_lock);
+
+        KisMementoSP memento = m_mementoManager->currentMemento();
+        if(memento) {
+            memento->saveNewDefaultPixel(m_defaultPixel, m_pixelSize);
+        }
+
+        m_mementoManager->commitDeferred();
+    }
+
     void rollback(KisMementoSP memento) {
         commit();
 
@@ -199,6 +242,16 @@ protected:
     bool write(KisPaintDeviceWriter &store);
     bool read(QIODevice *stream);
 
+    /**
+     * Like read(), but fills the data manager with only the tiles
+     * intersecting \p regionOfInterest. Current-version streams carry
+     * the data size of every tile in its header, so the remaining
+     * tiles are skipped without decompressing anything; thumbnailers
+     * and crop loaders use this to avoid a full decode. An empty rect
+     * loads everything, legacy streams ignore the region.
+     */
+    bool read(QIODevice *stream, const QRect &regionOfInterest);
+
     void purge(const QRect& area);
 
     inline quint32 pixelSize() const {
@@ -212,6 +265,49 @@ public:
     void  extent(qint32 &x, qint32 &y, qint32 &w, qint32 &h) const;
     void  setExtent(qint32 x, qint32 y, qint32 w, qint32 h);
     QRect extent() const;
+
+    /**
+     * Returns the list of tiles currently present in the device.
+     *
+     * The tiles share their data with the device in a copy-on-write
+     * manner, so as long as the returned tiles are referenced, two
+     * snapshots refer to the same pixel content iff their coordinates
+     * and tile-data pointers match. This is used for cheap change
+     * detection by the incremental saving code.
+     */
+    QVector<KisTileSP> tilesSnapshot() const;
+
+    /**
+     * A content-addressed description of one tile of the device,
+     * \see tileContentChecksums()
+     */
+    struct TileChecksum {
+        qint32 col;
+        qint32 row;
+        quint64 checksum;
+    };
+
+    /**
+     * Returns the (col, row, checksum) triple of every tile currently
+     * present in the device. Two versions of a document can be diffed
+     * by comparing the lists: tiles whose checksum did not change have
+     * the same pixel content and don't need to be transferred or
+     * re-saved.
+     *
+     * The checksums are cached inside the shared tile data and
+     * invalidated on write access, so calling this repeatedly on a
+     * mostly unchanged device only hashes the tiles that were
+     * actually touched in between. \see KisTileData::contentChecksum()
+     */
+    QVector<TileChecksum> tileContentChecksums() const;
+
+    /**
+     * A lock-free (and therefore possibly slightly outdated) variant
+     * of extent() for heuristic consumers like the update scheduler.
+     * \see KisTiledExtentManager::approximateExtent()
+     */
+    QRect approximateExtent() const;
+
     void  setExtent(QRect newRect);
 
     KisRegion region() const;
@@ -235,6 +331,14 @@ public:
      */
     void bitBltOldData(KisTiledDataManager *srcDM, const QRect &rect);
 
+    /**
+     * The same as \ref bitBlt(), but the source is read with a
+     * translation: dst(x, y) is taken from src(x - dx, y - dy). The
+     * offset must be aligned to the tile grid, which is what keeps
+     * whole-tile copy-on-write sharing possible.
+     */
+    void bitBltTranslated(KisTiledDataManager *srcDM, const QRect &dstRect, const QPoint &alignedOffset);
+
     /**
      * Clones rect from another datamanager in a rough and fast way.
      * All the tiles touched by rect will be shared, between both
@@ -85,6 +85,8 @@ void KisTiledDataManager::readBytesBody(quint8 *data,
     width  = width < 0  ? 0 : width;
     height = height < 0 ? 0 : height;
 
+    if (!width || !height) return;
+
     qint32 dataY = 0;
     qint32 imageY = y;
     qint32 rowsRemaining = height;
@@ -94,6 +96,19 @@ void KisTiledDataManager::readBytesBody(quint8 *data,
         dataRowStride = pixelSize * width;
     }
 
+    /**
+     * Batch-fetch all the tiles covered by the rect up front: the
+     * hash table lookup path is taken once for the whole rect
+     * instead of once per tile
+     */
+    const qint32 firstCol = xToCol(x);
+    const qint32 firstRow = yToRow(y);
+    const qint32 numCols = xToCol(x + width - 1) - firstCol + 1;
+    const qint32 numRows = yToRow(y + height - 1) - firstRow + 1;
+
+    QVector<KisTileSP> tiles(numCols * numRows);
+    getReadOnlyTilesBatch(firstCol, firstRow, numCols, numRows, tiles.data());
+
     while (rowsRemaining > 0) {
 
         qint32 dataX = 0;
@@ -112,9 +127,16 @@ void KisTiledDataManager::readBytesBody(quint8 *data,
             qint32 columnsToWork = qMin(numContiguousImageColumns,
                                         columnsRemaining);
 
-            // XXX: Ugly const cast because of the old pixelPtr design copied from tiles1.
-            KisTileDataWrapper tw(const_cast<KisTiledDataManager*>(this), imageX, imageY, KisTileDataWrapper::READ);
-            quint8 *tileIt = tw.data();
+            const qint32 tileIndex =
+                (yToRow(imageY) - firstRow) * numCols + (xToCol(imageX) - firstCol);
+            KisTileSP tile = tiles.at(tileIndex);
+
+            const qint32 xInTile = imageX - tile->col() * KisTileData::WIDTH;
+            const qint32 yInTile = imageY - tile->row() * KisTileData::HEIGHT;
+
+            tile->lockForRead();
+            quint8 *tileIt = tile->data() +
+                    (xInTile + yInTile * KisTileData::WIDTH) * pixelSize;
 
 
             const qint32 tileRowStride = rowStride(imageX, imageY);
@@ -130,6 +152,8 @@ void KisTiledDataManager::readBytesBody(quint8 *data,
                 dataIt += dataRowStride;
             }
 
+            tile->unlockForRead();
+
             imageX += columnsToWork;
             dataX += columnsToWork;
             columnsRemaining -= columnsToWork;
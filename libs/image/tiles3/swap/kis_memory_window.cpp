@@ -9,10 +9,23 @@
 
 #include <QDir>
 
+#ifdef Q_OS_LINUX
+#include <sys/mman.h>
+#endif
+
 #define SWP_PREFIX "KRITA_SWAP_FILE_XXXXXX"
 
-KisMemoryWindow::KisMemoryWindow(const QString &swapDir, quint64 writeWindowSize)
-    : m_readWindowEx(writeWindowSize / 4),
+namespace {
+/**
+ * The size of a transparent huge page on all the architectures
+ * we care about
+ */
+const quint64 hugePageSize = 2 * MiB;
+}
+
+KisMemoryWindow::KisMemoryWindow(const QString &swapDir, quint64 writeWindowSize, bool useHugePages)
+    : m_useHugePages(useHugePages),
+      m_readWindowEx(writeWindowSize / 4),
       m_writeWindowEx(writeWindowSize)
 {
     m_valid = true;
@@ -85,7 +98,21 @@ bool KisMemoryWindow::adjustWindow(const KisChunkData &requestedChunk,
             windowSize = requestedChunk.size();
         }
 
-        adjustingWindow->chunk.setChunk(requestedChunk.m_begin, windowSize);
+        quint64 windowBegin = requestedChunk.m_begin;
+
+        /**
+         * Align the window to huge page boundaries, so that the
+         * kernel can actually back the mapping with 2 MiB pages.
+         * The chunk offsets are not affected: calculatePointer()
+         * compensates for the moved window start.
+         */
+        if (m_useHugePages) {
+            const quint64 alignmentShift = windowBegin & (hugePageSize - 1);
+            windowBegin -= alignmentShift;
+            windowSize = (windowSize + alignmentShift + hugePageSize - 1) & ~(hugePageSize - 1);
+        }
+
+        adjustingWindow->chunk.setChunk(windowBegin, windowSize);
 
         if(adjustingWindow->chunk.m_end >= (quint64)m_file.size()) {
             // Align by 32 bytes
@@ -132,6 +159,19 @@ bool KisMemoryWindow::adjustWindow(const KisChunkData &requestedChunk,
         if (!adjustingWindow->window) {
             return false;
         }
+
+#ifdef Q_OS_LINUX
+        /**
+         * This is only advice: when no huge pages are available (or
+         * THP is disabled system-wide) the kernel keeps using 4k
+         * pages and we lose nothing.
+         */
+        if (m_useHugePages) {
+            madvise(adjustingWindow->window,
+                    adjustingWindow->chunk.size(),
+                    MADV_HUGEPAGE);
+        }
+#endif
     }
 
 	return true;
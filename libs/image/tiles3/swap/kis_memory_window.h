@@ -20,8 +20,14 @@ public:
     /**
      * @param swapDir If the dir doesn't exist, it'll be created, if it's empty QDir::tempPath will be used.
      * @param writeWindowSize write window size.
+     * @param useHugePages align the mapping windows to 2 MiB boundaries
+     *        and advise the kernel to back them with transparent huge
+     *        pages. Reduces TLB pressure during swap-in on big
+     *        windows. Linux-only, silently ignored elsewhere.
      */
-    KisMemoryWindow(const QString &swapDir, quint64 writeWindowSize = DEFAULT_WINDOW_SIZE);
+    KisMemoryWindow(const QString &swapDir,
+                    quint64 writeWindowSize = DEFAULT_WINDOW_SIZE,
+                    bool useHugePages = false);
     ~KisMemoryWindow();
 
     inline quint8* getReadChunkPtr(KisChunk readChunk) {
@@ -63,6 +69,7 @@ private:
     QTemporaryFile m_file;
 
     bool m_valid;
+    bool m_useHugePages;
     MappingWindow m_readWindowEx;
     MappingWindow m_writeWindowEx;
 };
@@ -9,30 +9,70 @@
 #include "kis_memory_window.h"
 #include "kis_image_config.h"
 
+#include <QFileInfo>
+
 #include "kis_tile_compressor_2.h"
 
 //#define COMPRESSOR_VERSION 2
 
 KisSwappedDataStore::KisSwappedDataStore()
-    : m_totalSwapMemoryUsed(0)
+    : m_memoryTierLimit(0),
+      m_memoryTierUsed(0),
+      m_nextStripe(0),
+      m_totalSwapMemoryUsed(0)
 {
     KisImageConfig config(true);
+    m_memoryTierLimit = qint64(config.compressedSwapMemoryLimit()) * MiB;
     const quint64 maxSwapSize = config.maxSwapSize() * MiB;
-    const quint64 swapSlabSize = config.swapSlabSize() * MiB;
-    const quint64 swapWindowSize = config.swapWindowSize() * MiB;
+    quint64 swapSlabSize = config.swapSlabSize() * MiB;
+    quint64 swapWindowSize = config.swapWindowSize() * MiB;
+
+    const bool useHugePages = config.useHugePagesForSwap();
+    if (useHugePages) {
+        // both sizes are in whole MiBs already, so just round
+        // them up to the next huge page multiple
+        const quint64 hugePageSize = 2 * MiB;
+        swapSlabSize = (swapSlabSize + hugePageSize - 1) & ~(hugePageSize - 1);
+        swapWindowSize = (swapWindowSize + hugePageSize - 1) & ~(hugePageSize - 1);
+    }
+
+    QStringList swapDirs;
+    swapDirs << config.swapDir();
+
+    Q_FOREACH (const QString &dir, config.additionalSwapDirs()) {
+        const QFileInfo info(dir);
+
+        if (!dir.isEmpty() && info.isDir() && info.isWritable()) {
+            swapDirs << dir;
+        } else {
+            qWarning() << "Additional swap location is not a writable directory, skipping it:" << dir;
+        }
+    }
 
-    m_allocator = new KisChunkAllocator(swapSlabSize, maxSwapSize);
-    m_swapSpace = new KisMemoryWindow(config.swapDir(), swapWindowSize);
+    // the configured limit is the total over all stripes
+    const quint64 maxStripeSize = maxSwapSize / swapDirs.size();
 
-    // FIXME: use a factory after the patch is committed
-    m_compressor = new KisTileCompressor2();
+    Q_FOREACH (const QString &dir, swapDirs) {
+        Stripe stripe;
+        stripe.allocator = new KisChunkAllocator(swapSlabSize, maxStripeSize);
+        stripe.swapSpace = new KisMemoryWindow(dir, swapWindowSize, useHugePages);
+        m_stripes << stripe;
+    }
+
+    // the swapper always uses a fast compression level: it sits
+    // right on the painting critical path under memory pressure
+    m_compressor = new KisTileCompressor2(config.swapCompression(),
+                                          1 /* zstd: KisZstdCompression::FAST_LEVEL */);
 }
 
 KisSwappedDataStore::~KisSwappedDataStore()
 {
     delete m_compressor;
-    delete m_swapSpace;
-    delete m_allocator;
+
+    Q_FOREACH (const Stripe &stripe, m_stripes) {
+        delete stripe.swapSpace;
+        delete stripe.allocator;
+    }
 }
 
 quint64 KisSwappedDataStore::numTiles() const
@@ -40,7 +80,13 @@ quint64 KisSwappedDataStore::numTiles() const
     // We are not acquiring the lock here...
     // Hope QLinkedList will ensure atomic access to it's size...
 
-    return m_allocator->numChunks();
+    quint64 numTiles = 0;
+
+    Q_FOREACH (const Stripe &stripe, m_stripes) {
+        numTiles += stripe.allocator->numChunks();
+    }
+
+    return numTiles;
 }
 
 bool KisSwappedDataStore::trySwapOutTileData(KisTileData *td)
@@ -61,22 +107,82 @@ bool KisSwappedDataStore::trySwapOutTileData(KisTileData *td)
     qint32 bytesWritten;
     m_compressor->compressTileData(td, (quint8*) m_buffer.data(), m_buffer.size(), bytesWritten);
 
-    KisChunk chunk = m_allocator->getChunk(bytesWritten);
-    quint8 *ptr = m_swapSpace->getWriteChunkPtr(chunk);
+    /**
+     * First try to keep the compressed data in the in-memory tier,
+     * evicting its oldest entries into the swap file when the
+     * budget is exceeded. Only when the tier cannot take the data
+     * (zero budget or eviction failure) it goes to the file
+     * directly.
+     */
+    if (m_memoryTierLimit > 0) {
+        while (m_memoryTierUsed + bytesWritten > m_memoryTierLimit &&
+               !m_memoryTierQueue.empty()) {
+
+            if (!evictOldestToFile()) break;
+        }
+
+        if (m_memoryTierUsed + bytesWritten <= m_memoryTierLimit) {
+            td->setCompressedData(QByteArray(m_buffer.constData(), bytesWritten));
+            td->setMemoryTierPosition(
+                m_memoryTierQueue.insert(m_memoryTierQueue.end(), td));
+            m_memoryTierUsed += bytesWritten;
+
+            td->releaseMemory();
+            return true;
+        }
+    }
+
+    if (!writeCompressedToFile(td, (quint8*) m_buffer.data(), bytesWritten)) {
+        return false;
+    }
+
+    td->releaseMemory();
+    return true;
+}
+
+bool KisSwappedDataStore::writeCompressedToFile(KisTileData *td, const quint8 *data, qint32 size)
+{
+    /**
+     * Round-robin over the stripes: consecutive swap-outs land on
+     * different drives, so their writeback proceeds in parallel
+     */
+    const int stripeIndex = m_nextStripe;
+    m_nextStripe = (m_nextStripe + 1) % m_stripes.size();
+    const Stripe &stripe = m_stripes.at(stripeIndex);
+
+    KisChunk chunk = stripe.allocator->getChunk(size);
+    quint8 *ptr = stripe.swapSpace->getWriteChunkPtr(chunk);
     if (!ptr) {
         qWarning() << "swap out of tile failed";
         return false;
     }
-    memcpy(ptr, m_buffer.data(), bytesWritten);
+    memcpy(ptr, data, size);
 
-    td->releaseMemory();
     td->setSwapChunk(chunk);
+    td->setSwapStripeIndex(stripeIndex);
 
     m_totalSwapMemoryUsed += chunk.size();
 
     return true;
 }
 
+bool KisSwappedDataStore::evictOldestToFile()
+{
+    KisTileData *td = m_memoryTierQueue.front();
+    const QByteArray compressedData = td->compressedData();
+
+    if (!writeCompressedToFile(td, (const quint8*) compressedData.constData(),
+                               compressedData.size())) {
+        return false;
+    }
+
+    m_memoryTierQueue.pop_front();
+    m_memoryTierUsed -= compressedData.size();
+    td->setCompressedData(QByteArray());
+
+    return true;
+}
+
 void KisSwappedDataStore::swapInTileData(KisTileData *td)
 {
     Q_ASSERT(!td->data());
@@ -84,35 +190,60 @@ void KisSwappedDataStore::swapInTileData(KisTileData *td)
 
     // see comment in swapOutTileData()
 
+    const QByteArray compressedData = td->compressedData();
+    if (!compressedData.isNull()) {
+        m_memoryTierQueue.erase(td->memoryTierPosition());
+        m_memoryTierUsed -= compressedData.size();
+        td->setCompressedData(QByteArray());
+
+        td->allocateMemory();
+        m_compressor->decompressTileData((quint8*) compressedData.constData(),
+                                         compressedData.size(), td);
+        return;
+    }
+
     KisChunk chunk = td->swapChunk();
+    const Stripe &stripe = m_stripes.at(td->swapStripeIndex());
     m_totalSwapMemoryUsed -= chunk.size();
 
     td->allocateMemory();
     td->setSwapChunk(KisChunk());
 
-    quint8 *ptr = m_swapSpace->getReadChunkPtr(chunk);
+    quint8 *ptr = stripe.swapSpace->getReadChunkPtr(chunk);
     Q_ASSERT(ptr);
     m_compressor->decompressTileData(ptr, chunk.size(), td);
-    m_allocator->freeChunk(chunk);
+    stripe.allocator->freeChunk(chunk);
 }
 
 void KisSwappedDataStore::forgetTileData(KisTileData *td)
 {
     QMutexLocker locker(&m_lock);
 
+    const QByteArray compressedData = td->compressedData();
+    if (!compressedData.isNull()) {
+        m_memoryTierQueue.erase(td->memoryTierPosition());
+        m_memoryTierUsed -= compressedData.size();
+        td->setCompressedData(QByteArray());
+        return;
+    }
+
     m_totalSwapMemoryUsed -= td->swapChunk().size();
 
-    m_allocator->freeChunk(td->swapChunk());
+    m_stripes.at(td->swapStripeIndex()).allocator->freeChunk(td->swapChunk());
     td->setSwapChunk(KisChunk());
 }
 
 qint64 KisSwappedDataStore::totalSwapMemoryUsed() const
 {
-    return m_totalSwapMemoryUsed;
+    // the in-memory tier counts as swap occupancy as well: its
+    // content is invisible to the tile store's memory metric
+    return m_totalSwapMemoryUsed + m_memoryTierUsed;
 }
 
 void KisSwappedDataStore::debugStatistics()
 {
-    m_allocator->sanityCheck();
-    m_allocator->debugFragmentation();
+    Q_FOREACH (const Stripe &stripe, m_stripes) {
+        stripe.allocator->sanityCheck();
+        stripe.allocator->debugFragmentation();
+    }
 }
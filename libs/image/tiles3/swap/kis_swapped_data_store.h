@@ -11,6 +11,9 @@
 
 #include <QMutex>
 #include <QByteArray>
+#include <QVector>
+
+#include <list>
 
 
 class QMutex;
@@ -31,8 +34,13 @@ public:
     quint64 numTiles() const;
 
     /**
-     * Swap out the data stored in the \a td to the swap file
-     * and free memory occupied by td->data().
+     * Swap out the data stored in the \a td and free memory
+     * occupied by td->data(). The compressed data first goes into
+     * an in-memory tier (bounded by
+     * KisImageConfig::compressedSwapMemoryLimit()), whose oldest
+     * entries overflow into the swap file; undo history therefore
+     * usually stays in RAM in compressed form and is restored
+     * without disk latency.
      * LOCKING: the lock on the tile data should be taken
      *          by the caller before making a call.
      */
@@ -64,12 +72,46 @@ public:
      */
     void debugStatistics();
 
+private:
+    /**
+     * Writes \p size compressed bytes of \p td into one of the swap
+     * files and records the chunk in the tile data
+     */
+    bool writeCompressedToFile(KisTileData *td, const quint8 *data, qint32 size);
+
+    /**
+     * Moves the oldest entry of the in-memory tier into the swap file
+     */
+    bool evictOldestToFile();
+
 private:
     QByteArray m_buffer;
     KisAbstractTileCompressor *m_compressor;
 
-    KisChunkAllocator *m_allocator;
-    KisMemoryWindow *m_swapSpace;
+    /**
+     * The in-memory tier of the swap: tile data whose compressed
+     * content is kept in its compressedData() buffer, in eviction
+     * (FIFO) order. m_memoryTierUsed counts the compressed bytes
+     * held this way.
+     */
+    std::list<KisTileData*> m_memoryTierQueue;
+    qint64 m_memoryTierLimit;
+    qint64 m_memoryTierUsed;
+
+    /**
+     * The swap can be striped over several directories (ideally on
+     * different physical drives), each stripe owning its own swap
+     * file and chunk allocator. New tile data is distributed over
+     * the stripes round-robin; the stripe a tile data was written
+     * to is remembered in KisTileData::swapStripeIndex().
+     */
+    struct Stripe {
+        KisChunkAllocator *allocator;
+        KisMemoryWindow *swapSpace;
+    };
+
+    QVector<Stripe> m_stripes;
+    int m_nextStripe;
 
     QMutex m_lock;
 
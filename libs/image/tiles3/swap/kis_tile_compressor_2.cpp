@@ -7,22 +7,69 @@
 #include "kis_tile_compressor_2.h"
 #include "kis_lzf_compression.h"
 #include <QIODevice>
+#include "kis_debug.h"
 #include "kis_paint_device_writer.h"
-#define TILE_DATA_SIZE(pixelSize) ((pixelSize) * KisTileData::WIDTH * KisTileData::HEIGHT)
 
-const QString KisTileCompressor2::m_compressionName = "LZF";
+#include <config-zstd.h>
+#ifdef HAVE_ZSTD
+#include "kis_zstd_compression.h"
+#endif
+
+#define TILE_DATA_SIZE(pixelSize) ((pixelSize) * KisTileData::WIDTH * KisTileData::HEIGHT)
 
 
-KisTileCompressor2::KisTileCompressor2()
+KisTileCompressor2::KisTileCompressor2(const QString &compressionName, int compressionLevel)
+    : m_compressionName(compressionName),
+      m_auxCompression(0)
 {
-    m_compression = new KisLzfCompression();
+    m_compression = createCompression(compressionName, compressionLevel);
+
+    if (!m_compression) {
+        warnKrita << "WARNING: compression" << compressionName
+                  << "is not available in this build, falling back to LZF";
+        m_compressionName = QStringLiteral("LZF");
+        m_compression = new KisLzfCompression();
+    }
 }
 
 KisTileCompressor2::~KisTileCompressor2()
 {
+    delete m_auxCompression;
     delete m_compression;
 }
 
+KisAbstractCompression* KisTileCompressor2::createCompression(const QString &name, int level)
+{
+    if (name == "LZF") {
+        return new KisLzfCompression();
+    }
+
+#ifdef HAVE_ZSTD
+    if (name == "ZSTD") {
+        return new KisZstdCompression(level >= 0 ? level : KisZstdCompression::FAST_LEVEL);
+    }
+#else
+    Q_UNUSED(level);
+#endif
+
+    return 0;
+}
+
+KisAbstractCompression* KisTileCompressor2::compressionForName(const QString &name)
+{
+    if (name == m_compressionName) {
+        return m_compression;
+    }
+
+    if (name != m_auxCompressionName) {
+        delete m_auxCompression;
+        m_auxCompression = createCompression(name, -1);
+        m_auxCompressionName = name;
+    }
+
+    return m_auxCompression;
+}
+
 bool KisTileCompressor2::writeTile(KisTileSP tile, KisPaintDeviceWriter &store)
 {
     const qint32 tileDataSize = TILE_DATA_SIZE(tile->pixelSize());
@@ -63,7 +110,12 @@ bool KisTileCompressor2::readTile(QIODevice *stream, KisTiledDataManager *dm)
         qint32 dataSize = headerItems.takeFirst().toInt();
 
         Q_ASSERT(headerItems.isEmpty());
-        Q_ASSERT(compressionName == m_compressionName);
+
+        KisAbstractCompression *compression = compressionForName(compressionName);
+        if (!compression) {
+            warnFile << "Failed to read a tile compressed with unsupported method" << compressionName;
+            return false;
+        }
 
         qint32 row = yToRow(dm, y);
         qint32 col = xToCol(dm, x);
@@ -73,7 +125,7 @@ bool KisTileCompressor2::readTile(QIODevice *stream, KisTiledDataManager *dm)
         stream->read(m_streamingBuffer.data(), dataSize);
 
         tile->lockForWrite();
-        bool res = decompressTileData((quint8*)m_streamingBuffer.data(), dataSize, tile->tileData());
+        bool res = decompressTileDataImpl((quint8*)m_streamingBuffer.data(), dataSize, tile->tileData(), compression);
         tile->unlockForWrite();
         return res;
     }
@@ -137,6 +189,14 @@ void KisTileCompressor2::compressTileData(KisTileData *tileData,
 bool KisTileCompressor2::decompressTileData(quint8 *buffer,
                                             qint32 bufferSize,
                                             KisTileData *tileData)
+{
+    return decompressTileDataImpl(buffer, bufferSize, tileData, m_compression);
+}
+
+bool KisTileCompressor2::decompressTileDataImpl(quint8 *buffer,
+                                                qint32 bufferSize,
+                                                KisTileData *tileData,
+                                                KisAbstractCompression *compression)
 {
     const qint32 pixelSize = tileData->pixelSize();
     const qint32 tileDataSize = TILE_DATA_SIZE(pixelSize);
@@ -145,8 +205,8 @@ bool KisTileCompressor2::decompressTileData(quint8 *buffer,
         prepareWorkBuffers(tileDataSize);
 
         qint32 bytesWritten;
-        bytesWritten = m_compression->decompress(buffer + 1, bufferSize - 1,
-                                                 (quint8*)m_linearizationBuffer.data(), tileDataSize);
+        bytesWritten = compression->decompress(buffer + 1, bufferSize - 1,
+                                               (quint8*)m_linearizationBuffer.data(), tileDataSize);
         if (bytesWritten == tileDataSize) {
             KisAbstractCompression::delinearizeColors((quint8*)m_linearizationBuffer.data(),
                                                       tileData->data(),
@@ -14,7 +14,18 @@ class KisAbstractCompression;
 class KRITAIMAGE_EXPORT KisTileCompressor2 : public KisAbstractTileCompressor
 {
 public:
-    KisTileCompressor2();
+    /**
+     * \p compressionName selects the compression backend used for
+     * *writing* tiles: "LZF" (default, compatible with all Krita
+     * versions) or "ZSTD" (needs a build with zstd support).
+     * Reading transparently supports both, the backend is chosen
+     * per tile from the name stored in the tile header.
+     *
+     * \p compressionLevel is a backend-specific level, -1 means
+     * the backend's default.
+     */
+    KisTileCompressor2(const QString &compressionName = QStringLiteral("LZF"),
+                       int compressionLevel = -1);
     ~KisTileCompressor2() override;
 
     bool writeTile(KisTileSP tile, KisPaintDeviceWriter &store) override;
@@ -37,6 +48,12 @@ private:
     void prepareWorkBuffers(qint32 tileDataSize);
     void prepareStreamingBuffer(qint32 tileDataSize);
 
+    static KisAbstractCompression* createCompression(const QString &name, int level);
+    KisAbstractCompression* compressionForName(const QString &name);
+    bool decompressTileDataImpl(quint8 *buffer, qint32 bufferSize,
+                                KisTileData *tileData,
+                                KisAbstractCompression *compression);
+
 private:
     static const qint8 RAW_DATA_FLAG = 0;
     static const qint8 COMPRESSED_DATA_FLAG = 1;
@@ -46,7 +63,15 @@ private:
     QByteArray m_compressionBuffer;
     QByteArray m_streamingBuffer;
     KisAbstractCompression *m_compression;
-    static const QString m_compressionName;
+    QString m_compressionName;
+
+    /**
+     * A lazily created fallback backend for reading streams whose
+     * tiles were written with a different compression than the one
+     * configured for writing
+     */
+    KisAbstractCompression *m_auxCompression;
+    QString m_auxCompressionName;
 };
 
 #endif /* __KIS_TILE_COMPRESSOR_2_H */
@@ -7,6 +7,7 @@
 #ifndef __KIS_TILE_COMPRESSOR_FACTORY_H
 #define __KIS_TILE_COMPRESSOR_FACTORY_H
 
+#include "kis_image_config.h"
 #include "tiles3/swap/kis_legacy_tile_compressor.h"
 #include "tiles3/swap/kis_tile_compressor_2.h"
 
@@ -19,7 +20,13 @@ public:
             return KisAbstractTileCompressorSP(new KisLegacyTileCompressor());
             break;
         case 2:
-            return KisAbstractTileCompressorSP(new KisTileCompressor2());
+            /**
+             * The compression name only affects writing; reading
+             * picks the backend per tile from the stored headers
+             */
+            return KisAbstractTileCompressorSP(
+                new KisTileCompressor2(KisImageConfig(true).kraTileCompression(),
+                                       9 /* zstd: KisZstdCompression::HIGH_LEVEL */));
             break;
         default:
             qFatal("Unknown version of the tiles");
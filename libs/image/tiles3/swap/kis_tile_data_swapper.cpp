@@ -223,6 +223,17 @@ qint64 KisTileDataSwapper::pass(qint64 needToFreeMetric)
     return freedMetric;
 }
 
+qint64 KisTileDataSwapper::compactHistoricalTiles(qint64 needToFreeMetric)
+{
+    /**
+     * The soft strategy only touches historical (mementoed and
+     * unused) tile data, so actively painted tiles are never
+     * affected by the compaction
+     */
+    QMutexLocker locker(&m_d->cycleLock);
+    return pass<SoftSwapStrategy>(needToFreeMetric);
+}
+
 void KisTileDataSwapper::testingRereadConfig()
 {
     m_d->limits = KisStoreLimits();
@@ -28,6 +28,18 @@ public:
     void terminateSwapper();
     void checkFreeMemory();
 
+    /**
+     * Swaps out (and thereby re-compresses with the swap compressor)
+     * up to \p needToFreeMetric worth of historical tile data, that
+     * is, old memento revisions that are only needed for undo.
+     * Unlike the usual swap cycle this runs regardless of the memory
+     * limits; it is driven by the idle tasks manager to keep long
+     * painting sessions inside physical RAM.
+     *
+     * Returns the actually freed memory metric.
+     */
+    qint64 compactHistoricalTiles(qint64 needToFreeMetric);
+
     void testingRereadConfig();
 
 private:
@@ -0,0 +1,72 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_zstd_compression.h"
+
+#include <zstd.h>
+
+#include "kis_debug.h"
+
+struct KisZstdCompression::Private {
+    /**
+     * Reusing the contexts avoids the per-tile allocation cost
+     * inside zstd. The compressor objects are never shared between
+     * threads (each swapper/saver owns its own instance), so no
+     * locking is needed here.
+     */
+    ZSTD_CCtx *compressContext;
+    ZSTD_DCtx *decompressContext;
+    int level;
+};
+
+KisZstdCompression::KisZstdCompression(int level)
+    : m_d(new Private)
+{
+    m_d->compressContext = ZSTD_createCCtx();
+    m_d->decompressContext = ZSTD_createDCtx();
+    m_d->level = level;
+}
+
+KisZstdCompression::~KisZstdCompression()
+{
+    ZSTD_freeCCtx(m_d->compressContext);
+    ZSTD_freeDCtx(m_d->decompressContext);
+    delete m_d;
+}
+
+qint32 KisZstdCompression::compress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength)
+{
+    const size_t result = ZSTD_compressCCtx(m_d->compressContext,
+                                            output, outputLength,
+                                            input, inputLength,
+                                            m_d->level);
+
+    if (ZSTD_isError(result)) {
+        warnKrita << "WARNING: zstd compression failed:" << ZSTD_getErrorName(result);
+        return 0;
+    }
+
+    return qint32(result);
+}
+
+qint32 KisZstdCompression::decompress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength)
+{
+    const size_t result = ZSTD_decompressDCtx(m_d->decompressContext,
+                                              output, outputLength,
+                                              input, inputLength);
+
+    if (ZSTD_isError(result)) {
+        warnKrita << "WARNING: zstd decompression failed:" << ZSTD_getErrorName(result);
+        return 0;
+    }
+
+    return qint32(result);
+}
+
+qint32 KisZstdCompression::outputBufferSize(qint32 dataSize)
+{
+    return qint32(ZSTD_compressBound(dataSize));
+}
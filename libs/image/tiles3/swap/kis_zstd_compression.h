@@ -0,0 +1,50 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __KIS_ZSTD_COMPRESSION_H
+#define __KIS_ZSTD_COMPRESSION_H
+
+#include "kis_abstract_compression.h"
+
+/**
+ * A zstd-based implementation of the abstract compression interface.
+ *
+ * Compared to KisLzfCompression it gives much better ratios on
+ * 16-bit integer and float tiles, which keeps the swap file and the
+ * saved .kra files significantly smaller. The compression level is
+ * configurable: the swapper uses a fast level to stay off the
+ * painting critical path, while .kra saving can afford a high level.
+ *
+ * Only compiled when zstd is found at configuration time
+ * (HAVE_ZSTD), see KisTileCompressor2::createCompression().
+ */
+class KRITAIMAGE_EXPORT KisZstdCompression : public KisAbstractCompression
+{
+public:
+    /**
+     * A cheap level for the swapper hot path
+     */
+    static constexpr int FAST_LEVEL = 1;
+
+    /**
+     * A slower level for one-off .kra saving
+     */
+    static constexpr int HIGH_LEVEL = 9;
+
+    KisZstdCompression(int level = FAST_LEVEL);
+    ~KisZstdCompression() override;
+
+    qint32 compress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength) override;
+    qint32 decompress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength) override;
+
+    qint32 outputBufferSize(qint32 dataSize) override;
+
+private:
+    struct Private;
+    Private * const m_d;
+};
+
+#endif /* __KIS_ZSTD_COMPRESSION_H */
@@ -30,12 +30,18 @@ private Q_SLOTS:
     void testLzfRoundTrip();
     void testLzfOverflow();
 
+    void testZstdRoundTrip();
+    void testZstdOverflow();
+
     void benchmarkMemCpy();
 
     void benchmarkCompressionLzf();
     void benchmarkCompressionLzfTwoPass();
     void benchmarkDecompressionLzf();
     void benchmarkDecompressionLzfTwoPass();
+
+    void benchmarkCompressionZstd();
+    void benchmarkDecompressionZstd();
 };
 
 #endif /* KIS_COMPRESSION_TESTS_H */
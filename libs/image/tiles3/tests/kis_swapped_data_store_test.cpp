@@ -68,6 +68,55 @@ void KisSwappedDataStoreTest::testRoundTrip()
         delete tileDataList[i];
 }
 
+void KisSwappedDataStoreTest::testInMemoryTier()
+{
+    const qint32 pixelSize = 1;
+    const quint8 defaultPixel = 128;
+    const qint32 NUM_TILES = 1000;
+
+    KisImageConfig config(false);
+    config.setMaxSwapSize(40);
+    config.setSwapSlabSize(1);
+    config.setSwapWindowSize(1);
+
+    // small enough that most of the tiles overflow into the swap file
+    config.setCompressedSwapMemoryLimit(1);
+
+    KisSwappedDataStore store;
+
+    QRandomGenerator rng(10);
+    QVector<QByteArray> expectedContent;
+    QList<KisTileData*> tileDataList;
+
+    for(qint32 i = 0; i < NUM_TILES; i++) {
+        KisTileData *td = new KisTileData(pixelSize, &defaultPixel, KisTileDataStore::instance());
+
+        // incompressible content, so the tier's budget actually overflows
+        for(qint32 j = 0; j < TILESIZE; j++) {
+            td->data()[j] = quint8(rng.generate());
+        }
+        expectedContent.append(QByteArray((const char*) td->data(), TILESIZE));
+        tileDataList.append(td);
+
+        // FIXME: take a lock of the tile data
+        QVERIFY(store.trySwapOutTileData(td));
+    }
+
+    store.debugStatistics();
+
+    for(qint32 i = 0; i < NUM_TILES; i++) {
+        KisTileData *td = tileDataList[i];
+        QVERIFY(!td->data());
+
+        // FIXME: take a lock of the tile data
+        store.swapInTileData(td);
+        QVERIFY(!memcmp(td->data(), expectedContent[i].constData(), TILESIZE));
+    }
+
+    for(qint32 i = 0; i < NUM_TILES; i++)
+        delete tileDataList[i];
+}
+
 void KisSwappedDataStoreTest::processTileData(qint32 column, KisTileData *td, KisSwappedDataStore &store)
 {
     if(td->data()) {
@@ -20,6 +20,7 @@ private:
 
 private Q_SLOTS:
     void testRoundTrip();
+    void testInMemoryTier();
     void testRandomAccess();
 
 };
@@ -10,6 +10,7 @@
 #include <QRandomGenerator>
 
 #include "tiles3/kis_tiled_data_manager.h"
+#include "kis_datamanager.h"
 
 #include "tiles_test_utils.h"
 #include "config-limit-long-tests.h"
@@ -339,6 +340,48 @@ void KisTiledDataManagerTest::testBitBltRough()
     delete[] buffer;
 }
 
+void KisTiledDataManagerTest::testBitBltTranslated()
+{
+    quint8 defaultPixel = 0;
+    KisTiledDataManager srcDM(1, &defaultPixel);
+    KisTiledDataManager dstDM(1, &defaultPixel);
+
+    quint8 oddPixel1 = 128;
+    quint8 oddPixel2 = 129;
+
+    const QPoint offset(64, 128);
+
+    QRect srcRect(0,0,512,512);
+    QRect dstRect = srcRect.translated(offset);
+    QRect srcCloneRect(81,80,250,250);
+    QRect dstCloneRect = srcCloneRect.translated(offset);
+
+    srcDM.clear(srcRect, &oddPixel1);
+    dstDM.clear(dstRect, &oddPixel2);
+
+    dstDM.bitBltTranslated(&srcDM, dstCloneRect, offset);
+
+    quint8 *buffer = new quint8[dstRect.width()*dstRect.height()];
+
+    dstDM.readBytes(buffer, dstRect.x(), dstRect.y(), dstRect.width(), dstRect.height());
+
+    QVERIFY(checkHole(buffer, oddPixel1, dstCloneRect,
+                      oddPixel2, dstRect));
+
+    delete[] buffer;
+
+    // The fully covered destination tiles must share data with the
+    // source tiles shifted by one column and two rows
+    for (qint32 row = 4; row <= 6; row++) {
+        for (qint32 col = 3; col <= 5; col++) {
+            KisTileSP srcTile = srcDM.getTile(col - 1, row - 2, false);
+            KisTileSP dstTile = dstDM.getTile(col, row, false);
+
+            QCOMPARE(dstTile->tileData(), srcTile->tileData());
+        }
+    }
+}
+
 void KisTiledDataManagerTest::testTransactions()
 {
     quint8 defaultPixel = 0;
@@ -390,6 +433,61 @@ void KisTiledDataManagerTest::testTransactions()
 
 }
 
+void KisTiledDataManagerTest::testDeferredCommit()
+{
+    quint8 defaultPixel = 0;
+    KisTiledDataManager dm(1, &defaultPixel);
+
+    quint8 oddPixel1 = 128;
+    quint8 oddPixel2 = 129;
+
+    KisTileSP tile00;
+    KisTileSP oldTile00;
+
+    // The first transaction ends with a deferred commit
+    KisMementoSP memento1 = dm.getMemento();
+    dm.clear(0, 0, 64, 64, &oddPixel1);
+    dm.commitDeferred();
+
+    tile00 = dm.getTile(0, 0, false);
+    QVERIFY(memoryIsFilled(oddPixel1, tile00->data(), TILESIZE));
+    tile00 = 0;
+
+    // The next transaction flushes the pending revision on start
+    KisMementoSP memento2 = dm.getMemento();
+    dm.clear(0, 0, 64, 64, &oddPixel2);
+
+    tile00 = dm.getTile(0, 0, false);
+    oldTile00 = dm.getOldTile(0, 0);
+    QVERIFY(memoryIsFilled(oddPixel2, tile00->data(), TILESIZE));
+    QVERIFY(memoryIsFilled(oddPixel1, oldTile00->data(), TILESIZE));
+    tile00 = oldTile00 = 0;
+
+    dm.commitDeferred();
+
+    // Undoing while a revision is still pending flushes it first
+    dm.rollback(memento2);
+    tile00 = dm.getTile(0, 0, false);
+    QVERIFY(memoryIsFilled(oddPixel1, tile00->data(), TILESIZE));
+    tile00 = 0;
+
+    dm.rollback(memento1);
+    tile00 = dm.getTile(0, 0, false);
+    QVERIFY(memoryIsFilled(defaultPixel, tile00->data(), TILESIZE));
+    tile00 = 0;
+
+    // Redoing walks over the flushed revisions as usual
+    dm.rollforward(memento1);
+    tile00 = dm.getTile(0, 0, false);
+    QVERIFY(memoryIsFilled(oddPixel1, tile00->data(), TILESIZE));
+    tile00 = 0;
+
+    dm.rollforward(memento2);
+    tile00 = dm.getTile(0, 0, false);
+    QVERIFY(memoryIsFilled(oddPixel2, tile00->data(), TILESIZE));
+    tile00 = 0;
+}
+
 void KisTiledDataManagerTest::testPurgeHistory()
 {
     quint8 defaultPixel = 0;
@@ -464,6 +562,135 @@ void KisTiledDataManagerTest::testPurgeHistory()
     dm.purgeHistory(memento4);
 }
 
+void KisTiledDataManagerTest::testParallelWriteRoundTrip()
+{
+    quint8 defaultPixel = 0;
+    KisDataManager srcDM(1, &defaultPixel);
+
+    quint8 oddPixel1 = 128;
+    quint8 oddPixel2 = 129;
+
+    /**
+     * 12 * 12 = 144 tiles, which is enough to trigger the batched
+     * parallel save path in write()
+     */
+    const QRect fillRect(0, 0, 768, 768);
+    const QRect oddRect(128, 192, 64, 64);
+
+    srcDM.clear(fillRect.x(), fillRect.y(),
+                fillRect.width(), fillRect.height(), &oddPixel1);
+    srcDM.clear(oddRect.x(), oddRect.y(),
+                oddRect.width(), oddRect.height(), &oddPixel2);
+
+    KoStoreFake fakeStore;
+    KisFakePaintDeviceWriter writer(&fakeStore);
+
+    QVERIFY(srcDM.write(writer));
+
+    fakeStore.startReading();
+
+    KisDataManager dstDM(1, &defaultPixel);
+    QVERIFY(dstDM.read(fakeStore.device()));
+
+    QCOMPARE(dstDM.extent(), srcDM.extent());
+
+    const int bufferSize = fillRect.width() * fillRect.height();
+    quint8 *buffer = new quint8[bufferSize];
+
+    dstDM.readBytes(buffer, fillRect.x(), fillRect.y(),
+                    fillRect.width(), fillRect.height());
+
+    QVERIFY(checkHole(buffer,
+                      oddPixel2, oddRect,
+                      oddPixel1, fillRect));
+
+    delete[] buffer;
+}
+
+void KisTiledDataManagerTest::testRegionOfInterestRead()
+{
+    quint8 defaultPixel = 0;
+    KisDataManager srcDM(1, &defaultPixel);
+
+    quint8 oddPixel1 = 128;
+
+    const QRect fillRect(0, 0, 768, 768);
+    srcDM.clear(fillRect.x(), fillRect.y(),
+                fillRect.width(), fillRect.height(), &oddPixel1);
+
+    KoStoreFake fakeStore;
+    KisFakePaintDeviceWriter writer(&fakeStore);
+
+    QVERIFY(srcDM.write(writer));
+
+    fakeStore.startReading();
+
+    // spans tiles (1,1) to (3,3)
+    const QRect roi(100, 100, 150, 150);
+    const QRect expectedExtent(64, 64, 192, 192);
+
+    KisDataManager dstDM(1, &defaultPixel);
+    QVERIFY(dstDM.read(fakeStore.device(), roi));
+
+    QCOMPARE(dstDM.extent(), expectedExtent);
+
+    quint8 pixel = 0;
+
+    dstDM.readBytes(&pixel, 100, 100, 1, 1);
+    QCOMPARE(pixel, oddPixel1);
+
+    dstDM.readBytes(&pixel, 700, 700, 1, 1);
+    QCOMPARE(pixel, defaultPixel);
+}
+
+void KisTiledDataManagerTest::testTileContentChecksums()
+{
+    quint8 defaultPixel = 0;
+    KisTiledDataManager dm(1, &defaultPixel);
+
+    quint8 oddPixel1 = 128;
+    quint8 oddPixel2 = 129;
+
+    // tiles (0,0) and (1,0), same content
+    dm.clear(0, 0, 128, 64, &oddPixel1);
+
+    typedef KisTiledDataManager::TileChecksum TileChecksum;
+
+    // both tiles live in row 0, so indexing by column is enough here
+    auto checksumByCol = [](const QVector<TileChecksum> &checksums, qint32 col) {
+        Q_FOREACH (const TileChecksum &entry, checksums) {
+            if (entry.col == col && entry.row == 0) {
+                return entry.checksum;
+            }
+        }
+        return quint64(0);
+    };
+
+    QVector<TileChecksum> checksums = dm.tileContentChecksums();
+    QCOMPARE(checksums.size(), 2);
+
+    const quint64 oldChecksum0 = checksumByCol(checksums, 0);
+    const quint64 oldChecksum1 = checksumByCol(checksums, 1);
+
+    // identical content hashes identically
+    QCOMPARE(oldChecksum0, oldChecksum1);
+
+    // modify tile (1,0) only
+    dm.setPixel(64, 0, &oddPixel2);
+
+    checksums = dm.tileContentChecksums();
+    QCOMPARE(checksums.size(), 2);
+    QCOMPARE(checksumByCol(checksums, 0), oldChecksum0);
+    QVERIFY(checksumByCol(checksums, 1) != oldChecksum1);
+
+    // a clone shares the tiles and therefore the checksums
+    KisTiledDataManager clone(dm);
+    QVector<TileChecksum> cloneChecksums = clone.tileContentChecksums();
+    QCOMPARE(cloneChecksums.size(), 2);
+    QCOMPARE(checksumByCol(cloneChecksums, 0), checksumByCol(checksums, 0));
+    QCOMPARE(checksumByCol(cloneChecksums, 1), checksumByCol(checksums, 1));
+}
+
 void KisTiledDataManagerTest::testUndoSetDefaultPixel()
 {
     quint8 defaultPixel = 0;
@@ -37,8 +37,13 @@ private Q_SLOTS:
     void testVersionedBitBlt();
     void testBitBltOldData();
     void testBitBltRough();
+    void testBitBltTranslated();
     void testTransactions();
+    void testDeferredCommit();
     void testPurgeHistory();
+    void testParallelWriteRoundTrip();
+    void testRegionOfInterestRead();
+    void testTileContentChecksums();
     void testUndoSetDefaultPixel();
 
     void benchmarkReadOnlyTileLazy();
@@ -57,6 +57,7 @@
 #include <InfoObject.h>
 #include <Node.h>
 #include <Selection.h>
+#include <ThumbnailRequest.h>
 #include <LibKisUtils.h>
 
 #include "kis_animation_importer.h"
@@ -485,6 +486,38 @@ QByteArray Document::pixelData(int x, int y, int w, int h) const
     return ba;
 }
 
+bool Document::readPixelData(int x, int y, int w, int h, QByteArray &buffer) const
+{
+    return readPixelData({QRect(x, y, w, h)}, buffer);
+}
+
+bool Document::readPixelData(const QList<QRect> &rects, QByteArray &buffer) const
+{
+    if (!d->document) return false;
+    KisImageSP image = d->document->image();
+    if (!image) return false;
+
+    KisPaintDeviceSP dev = image->projection();
+
+    qint64 totalBytes = 0;
+    Q_FOREACH (const QRect &rc, rects) {
+        if (rc.isEmpty()) return false;
+        totalBytes += qint64(rc.width()) * rc.height() * dev->pixelSize();
+    }
+
+    if (buffer.size() < totalBytes) {
+        buffer.resize(totalBytes);
+    }
+
+    quint8 *ptr = reinterpret_cast<quint8*>(buffer.data());
+    Q_FOREACH (const QRect &rc, rects) {
+        dev->readBytes(ptr, rc.x(), rc.y(), rc.width(), rc.height());
+        ptr += qint64(rc.width()) * rc.height() * dev->pixelSize();
+    }
+
+    return true;
+}
+
 bool Document::close()
 {
     bool retval = d->document->closePath(false);
@@ -810,6 +843,21 @@ QImage Document::thumbnail(int w, int h) const
     return d->document->generatePreview(QSize(w, h)).toImage();
 }
 
+ThumbnailRequest *Document::thumbnailsAsync(const QList<Node*> &nodes, int w, int h) const
+{
+    if (!d->document || !d->document->image()) return 0;
+
+    QList<KisNodeSP> kisnodes;
+    kisnodes.reserve(nodes.size());
+
+    Q_FOREACH (Node *node, nodes) {
+        if (!node || !node->node()) return 0;
+        kisnodes << node->node();
+    }
+
+    return new ThumbnailRequest(d->document->image(), kisnodes, w, h);
+}
+
 
 void Document::lock()
 {
@@ -8,6 +8,8 @@
 
 #include <QFileInfo>
 
+#include <QRect>
+
 #include "kritalibkis_export.h"
 #include "libkis.h"
 
@@ -409,6 +411,34 @@ public Q_SLOTS:
      */
     QByteArray pixelData(int x, int y, int w, int h) const;
 
+    /**
+     * @brief readPixelData reads the given rectangle from the image projection into @p buffer,
+     * reusing its allocation when it is already big enough. The pixel data has the same layout
+     * and channel order as the data returned by pixelData().
+     *
+     * Export scripts that read many tiles can keep one buffer alive across the calls and avoid
+     * paying an allocation and a copy per tile.
+     *
+     * @param x x position from where to start reading
+     * @param y y position from where to start reading
+     * @param w row length to read
+     * @param h number of rows to read
+     * @param buffer the byte array to fill; it is only resized when it is too small
+     * @return true if the pixel data was read successfully
+     */
+    bool readPixelData(int x, int y, int w, int h, QByteArray &buffer) const;
+
+    /**
+     * @brief readPixelData reads several rectangles from the image projection into @p buffer
+     * with a single call. The rectangles are concatenated in the order of @p rects, each one
+     * laid out row-first like the data returned by pixelData().
+     *
+     * @param rects the rectangles to read
+     * @param buffer the byte array to fill; it is only resized when it is too small
+     * @return true if the pixel data was read successfully
+     */
+    bool readPixelData(const QList<QRect> &rects, QByteArray &buffer) const;
+
     /**
      * @brief close Close the document: remove it from Krita's internal list of documents and
      * close all views. If the document is modified, you should save it first. There will be
@@ -716,6 +746,17 @@ print(root.childNodes())
      */
     QImage thumbnail(int w, int h) const;
 
+    /**
+     * @brief thumbnailsAsync schedule thumbnails of the given dimensions for a whole
+     * list of nodes to be rendered in the background in a single batch, instead of
+     * rendering them one by one on the calling thread with Node.thumbnail().
+     * @param nodes the nodes to generate thumbnails for; they must belong to this document
+     * @return a ThumbnailRequest that delivers the thumbnails through its signals, in
+     * the same order as the given node list. The caller takes ownership of the request.
+     * Returns 0 if the document is invalid.
+     */
+    ThumbnailRequest *thumbnailsAsync(const QList<Node*> &nodes, int w, int h) const;
+
 
     /**
      * [low-level] Lock the image without waiting for all the internal job queues are processed
@@ -8,6 +8,8 @@
 #include <QPointer>
 #include <QVariant>
 #include <QStringList>
+#include <QFuture>
+#include <QtConcurrent>
 
 #include <ksharedconfig.h>
 #include <kconfiggroup.h>
@@ -25,6 +27,7 @@
 #include <kactioncollection.h>
 #include <KisPart.h>
 #include <KisMainWindow.h>
+#include <KisMimeDatabase.h>
 #include <KisDocument.h>
 #include <kis_image.h>
 #include <kis_action.h>
@@ -43,6 +46,7 @@
 #include <KisBrushServerProvider.h>
 #include <kis_action_registry.h>
 #include <kis_icon_utils.h>
+#include <tiles3/kis_tile_data_store.h>
 
 #include <KisResourceModel.h>
 #include <KisGlobalResourcesInterface.h>
@@ -146,6 +150,47 @@ QList<Document *> Krita::documents() const
     return ret;
 }
 
+bool Krita::exportBatch(const QList<Document *> &documents, const QStringList &filenames, const InfoObject &exportConfiguration)
+{
+    if (documents.size() != filenames.size()) {
+        return false;
+    }
+
+    QVector<QFuture<bool>> futures;
+
+    for (int i = 0; i < documents.size(); i++) {
+        KisDocument *document = documents[i] ? documents[i]->document().data() : 0;
+        if (!document) {
+            return false;
+        }
+
+        // the exports run on worker threads, so no dialogs can be shown
+        document->setFileBatchMode(true);
+
+        const QString filename = filenames[i];
+        const QByteArray outputFormat = KisMimeDatabase::mimeTypeForFile(filename, false).toLatin1();
+
+        // every export gets its own copy of the configuration: the
+        // filters amend it with properties of the exported image
+        KisPropertiesConfigurationSP configuration =
+            new KisPropertiesConfiguration(*exportConfiguration.configuration());
+
+        futures << QtConcurrent::run(
+            [document, filename, outputFormat, configuration] () {
+                return document->exportDocumentSync(filename, outputFormat, configuration);
+            });
+    }
+
+    bool result = true;
+
+    for (QFuture<bool> &future : futures) {
+        future.waitForFinished();
+        result &= future.result();
+    }
+
+    return result;
+}
+
 QStringList Krita::filters() const
 {
     QStringList ls = KisFilterRegistry::instance()->keys();
@@ -377,6 +422,22 @@ QString Krita::readSetting(const QString &group, const QString &name, const QStr
     return grp.readEntry(name, defaultValue);
 }
 
+QMap<QString, qint64> Krita::tileStatistics() const
+{
+    const KisTileDataStore::TileStatistics stats =
+        KisTileDataStore::instance()->tileStatistics();
+
+    QMap<QString, qint64> map;
+    map["allocations"] = stats.allocations;
+    map["poolHits"] = stats.poolHits;
+    map["poolMisses"] = stats.poolMisses;
+    map["swapOuts"] = stats.swapOuts;
+    map["swapIns"] = stats.swapIns;
+    map["rawSwapSize"] = stats.rawSwapSize;
+    map["compressedSwapSize"] = stats.compressedSwapSize;
+    return map;
+}
+
 QIcon Krita::icon(QString &iconName) const
 {
     return KisIconUtils::loadIcon(iconName);
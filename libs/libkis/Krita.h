@@ -78,6 +78,24 @@ public Q_SLOTS:
      */
     QList<Document*> documents() const;
 
+    /**
+     * @brief exportBatch exports several documents in parallel, one
+     * file per document. The exports run on the global thread pool, so
+     * the number of conversions running at once is bounded by the
+     * number of cores; the remaining jobs wait in the queue. Every
+     * document is switched to batch mode, no dialogs are shown. A
+     * document may appear in the list only once.
+     *
+     * @param documents the documents to export
+     * @param filenames one output file per document; the file
+     *        extension determines the export format
+     * @param exportConfiguration the export settings, applied to every
+     *        file. See Document.exportImage for the per-format
+     *        properties.
+     * @return true if all exports succeeded
+     */
+    bool exportBatch(const QList<Document*> &documents, const QStringList &filenames, const InfoObject &exportConfiguration);
+
     /**
      * @return a list of all the dockers
      */
@@ -304,6 +322,24 @@ add_document_to_window()
      */
     QString readSetting(const QString &group, const QString &name, const QString &defaultValue);
 
+    /**
+     * @brief tileStatistics activity counters of the internal tile store.
+     * @return a map with the counters, all monotonically growing since the
+     * start of the session:
+     * <ul>
+     * <li>allocations: number of tile datas created</li>
+     * <li>poolHits: tile duplications served from the pooler's pre-clone stack</li>
+     * <li>poolMisses: tile duplications that had to copy synchronously</li>
+     * <li>swapOuts: tiles compressed and pushed out to the swap</li>
+     * <li>swapIns: tiles decompressed back on access</li>
+     * <li>rawSwapSize: uncompressed size of the tiles currently in the swap</li>
+     * <li>compressedSwapSize: bytes the same tiles occupy in the swap file</li>
+     * </ul>
+     * Scripts that want per-interval rates should keep the previous map
+     * and subtract.
+     */
+    QMap<QString, qint64> tileStatistics() const;
+
     /**
      * @brief icon
      * This allows you to get icons from Krita's internal icons.
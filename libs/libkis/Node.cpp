@@ -51,6 +51,8 @@
 #include "Channel.h"
 #include "Filter.h"
 #include "Selection.h"
+#include "StrokeSession.h"
+#include "ThumbnailRequest.h"
 
 #include "GroupLayer.h"
 #include "CloneLayer.h"
@@ -557,6 +559,37 @@ QByteArray Node::pixelData(int x, int y, int w, int h) const
     return ba;
 }
 
+bool Node::readPixelData(int x, int y, int w, int h, QByteArray &buffer) const
+{
+    return readPixelData({QRect(x, y, w, h)}, buffer);
+}
+
+bool Node::readPixelData(const QList<QRect> &rects, QByteArray &buffer) const
+{
+    if (!d->node) return false;
+
+    KisPaintDeviceSP dev = d->node->paintDevice();
+    if (!dev) return false;
+
+    qint64 totalBytes = 0;
+    Q_FOREACH (const QRect &rc, rects) {
+        if (rc.isEmpty()) return false;
+        totalBytes += qint64(rc.width()) * rc.height() * dev->pixelSize();
+    }
+
+    if (buffer.size() < totalBytes) {
+        buffer.resize(totalBytes);
+    }
+
+    quint8 *ptr = reinterpret_cast<quint8*>(buffer.data());
+    Q_FOREACH (const QRect &rc, rects) {
+        dev->readBytes(ptr, rc.x(), rc.y(), rc.width(), rc.height());
+        ptr += qint64(rc.width()) * rc.height() * dev->pixelSize();
+    }
+
+    return true;
+}
+
 QByteArray Node::pixelDataAtTime(int x, int y, int w, int h, int time) const
 {
     QByteArray ba;
@@ -612,6 +645,32 @@ bool Node::setPixelData(QByteArray value, int x, int y, int w, int h)
     return true;
 }
 
+bool Node::setPixelData(QByteArray value, const QList<QRect> &rects)
+{
+    if (!d->node) return false;
+    KisPaintDeviceSP dev = d->node->paintDevice();
+    if (!dev) return false;
+
+    qint64 totalBytes = 0;
+    Q_FOREACH (const QRect &rc, rects) {
+        if (rc.isEmpty()) return false;
+        totalBytes += qint64(rc.width()) * rc.height() * dev->colorSpace()->pixelSize();
+    }
+
+    if (value.length() < totalBytes) {
+        qWarning() << "Node::setPixelData: not enough data to write to the paint device";
+        return false;
+    }
+
+    const quint8 *ptr = (const quint8*)value.constData();
+    Q_FOREACH (const QRect &rc, rects) {
+        dev->writeBytes(ptr, rc.x(), rc.y(), rc.width(), rc.height());
+        ptr += qint64(rc.width()) * rc.height() * dev->colorSpace()->pixelSize();
+    }
+
+    return true;
+}
+
 QRect Node::bounds() const
 {
     if (!d->node) return QRect();
@@ -750,6 +809,12 @@ QImage Node::thumbnail(int w, int h)
     return d->node->createThumbnail(w, h);
 }
 
+ThumbnailRequest *Node::thumbnailAsync(int w, int h)
+{
+    if (!d->node) return 0;
+    return new ThumbnailRequest(d->image, {d->node}, w, h);
+}
+
 QString Node::layerStyleToAsl()
 {
     if (!d->node) return QString();
@@ -883,6 +948,16 @@ void Node::paintLine(const QPointF pointOne, const QPointF pointTwo, double pres
     helper.paintLine(pointOneInfo, pointTwoInfo);
 }
 
+StrokeSession *Node::startStroke(const QString &strokeStyle)
+{
+    if (paintAbility() != "PAINT") {
+        dbgScript << "Script attempted to use Node::startStroke() on an unpaintable node, ignoring.";
+        return 0;
+    }
+
+    return new StrokeSession(d->image, node(), strokeStyle);
+}
+
 
 void Node::paintRectangle(const QRectF &rect, const QString strokeStyle, const QString fillStyle)
 {
@@ -10,6 +10,8 @@
 
 #include <kis_types.h>
 
+#include <QRect>
+
 #include "kritalibkis_export.h"
 #include "libkis.h"
 
@@ -367,6 +369,34 @@ public Q_SLOTS:
      */
     QByteArray pixelData(int x, int y, int w, int h) const;
 
+    /**
+     * @brief readPixelData reads the given rectangle from the Node into @p buffer, reusing its
+     * allocation when it is already big enough. The pixel data has the same layout and channel
+     * order as the data returned by pixelData().
+     *
+     * Scripts that read many tiles can keep one buffer alive across the calls and avoid paying
+     * an allocation and a copy per tile.
+     *
+     * @param x x position from where to start reading
+     * @param y y position from where to start reading
+     * @param w row length to read
+     * @param h number of rows to read
+     * @param buffer the byte array to fill; it is only resized when it is too small
+     * @return true if the pixel data was read successfully
+     */
+    bool readPixelData(int x, int y, int w, int h, QByteArray &buffer) const;
+
+    /**
+     * @brief readPixelData reads several rectangles from the Node into @p buffer with a single
+     * call. The rectangles are concatenated in the order of @p rects, each one laid out
+     * row-first like the data returned by pixelData().
+     *
+     * @param rects the rectangles to read
+     * @param buffer the byte array to fill; it is only resized when it is too small
+     * @return true if the pixel data was read successfully
+     */
+    bool readPixelData(const QList<QRect> &rects, QByteArray &buffer) const;
+
     /**
      * @brief pixelDataAtTime a basic function to get pixeldata from an animated node at a given time.
      * @param x the position from the left to start reading.
@@ -447,6 +477,19 @@ public Q_SLOTS:
      */
     bool setPixelData(QByteArray value, int x, int y, int w, int h);
 
+    /**
+     * @brief setPixelData writes the given bytes into several rectangles of the Node with a
+     * single call. The rectangles are read from @p value in the order of @p rects, each one
+     * laid out row-first, matching the layout produced by readPixelData() for the same list.
+     * The same restrictions as for the single-rectangle setPixelData() apply.
+     *
+     * @param value the byte array representing the pixels of all rectangles, concatenated.
+     * There must be enough bytes available for the sum of the rectangle sizes.
+     * @param rects the rectangles to write
+     * @return true if writing the pixeldata worked
+     */
+    bool setPixelData(QByteArray value, const QList<QRect> &rects);
+
     /**
      * @brief bounds return the exact bounds of the node's paint device
      * @return the bounds, or an empty QRect if the node has no paint device or is empty.
@@ -547,6 +590,15 @@ public Q_SLOTS:
      */
     QImage thumbnail(int w, int h);
 
+    /**
+     * @brief thumbnailAsync schedule a thumbnail of the given dimensions to be rendered
+     * in the background, instead of rendering it synchronously on the calling thread
+     * like thumbnail() does. The thumbnail is sized like the one returned by thumbnail().
+     * @return a ThumbnailRequest that delivers the thumbnail through its signals. The
+     * caller takes ownership of the request. Returns 0 if the node is invalid.
+     */
+    ThumbnailRequest *thumbnailAsync(int w, int h);
+
     /**
      * @brief layerStyleToAsl retrieve the current layer's style in ASL format.
      * @return a QString in ASL format representing the layer style.
@@ -677,6 +729,24 @@ public Q_SLOTS:
     void paintPath(const QPainterPath &path,
                    const QString strokeStyle = PaintingResources::defaultStrokeStyle,
                    const QString fillStyle = PaintingResources::defaultFillStyle);
+
+    /**
+     * @brief startStroke open a brush stroke on this node with the current brush preset.
+     *
+     * Unlike paintLine(), which starts and ends a full stroke for every segment, the
+     * returned session keeps a single stroke open so that batches of segments can be
+     * submitted directly to the image's stroke system. See StrokeSession.
+     * @param strokeStyle color to paint with, one of:
+     * <ul>
+     * <li>ForegroundColor</li>
+     * <li>BackgroundColor</li>
+     * </ul>
+     * Default is ForegroundColor.
+     * @return a StrokeSession for the opened stroke. The caller takes ownership of the
+     * session. Returns 0 if the node cannot be painted on with the current brush preset.
+     */
+    StrokeSession *startStroke(const QString &strokeStyle = PaintingResources::defaultStrokeStyle);
+
     /**
      * @brief paintAbility can be used to determine whether this node can be painted on with the current brush preset.
      * @return QString, one of the following:
@@ -0,0 +1,153 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+#include "StrokeSession.h"
+
+#include "KisView.h"
+#include "KisPart.h"
+#include "KisMainWindow.h"
+#include "KisViewManager.h"
+#include "kis_canvas_resource_provider.h"
+
+#include <kis_debug.h>
+#include <kis_image.h>
+#include <kis_painter.h>
+#include <kundo2magicstring.h>
+#include <kis_resources_snapshot.h>
+#include <brushengine/kis_paint_information.h>
+#include <strokes/KisFreehandStrokeInfo.h>
+#include <strokes/freehand_stroke.h>
+#include "KisAsynchronousStrokeUpdateHelper.h"
+
+#include "PaintingResources.h"
+
+struct StrokeSession::Private
+{
+    KisImageWSP image;
+    KisStrokeId strokeId;
+    KisPaintInformation lastPaintInformation;
+    bool hasLastPosition = false;
+    bool active = false;
+
+    KisPaintInformation makePaintInformation(const QPointF &point, qreal pressure, int timeMsec) const;
+    void paintSegment(const KisPaintInformation &pi);
+};
+
+KisPaintInformation StrokeSession::Private::makePaintInformation(const QPointF &point, qreal pressure, int timeMsec) const
+{
+    KisPaintInformation pi;
+    pi.setPos(point);
+    pi.setPressure(pressure);
+
+    if (timeMsec >= 0) {
+        pi.setCurrentTime(timeMsec);
+    }
+
+    return pi;
+}
+
+void StrokeSession::Private::paintSegment(const KisPaintInformation &pi)
+{
+    KisImageSP imageSP = image;
+    if (!imageSP) return;
+
+    if (hasLastPosition) {
+        imageSP->addJob(strokeId, new FreehandStrokeStrategy::Data(0, lastPaintInformation, pi));
+    }
+
+    lastPaintInformation = pi;
+    hasLastPosition = true;
+}
+
+StrokeSession::StrokeSession(KisImageSP image, KisNodeSP node, const QString &strokeStyle, QObject *parent)
+    : QObject(parent)
+    , d(new Private)
+{
+    d->image = image;
+
+    // need to grab the resource provider, like PaintingResources::createHelper() does
+    KisView *activeView = KisPart::instance()->currentMainwindow()->activeView();
+    KoCanvasResourceProvider *resourceManager = activeView->viewManager()->canvasResourceProvider()->resourceManager();
+
+    KisResourcesSnapshotSP resources =
+        new KisResourcesSnapshot(image,
+                                 node,
+                                 resourceManager);
+
+    resources->setStrokeStyle(KisPainter::StrokeStyleBrush);
+    resources->setFillStyle(KisPainter::FillStyleNone);
+
+    if (strokeStyle == "BackgroundColor") {
+        const KoColor fgColor = resources->currentFgColor();
+        const KoColor bgColor = resources->currentBgColor();
+        resources->setFGColorOverride(bgColor);
+        resources->setBGColorOverride(fgColor);
+    } else if (strokeStyle != PaintingResources::defaultStrokeStyle) {
+        dbgScript << "Script tried to open a stroke session with invalid strokeStyle" << strokeStyle
+                  << ", ignoring and using" << PaintingResources::defaultStrokeStyle << ".";
+    }
+
+    KisFreehandStrokeInfo *strokeInfo = new KisFreehandStrokeInfo();
+
+    KisStrokeStrategy *stroke =
+        new FreehandStrokeStrategy(resources, strokeInfo, kundo2_i18n("Scripted Brush Stroke"));
+
+    d->strokeId = image->startStroke(stroke);
+    d->active = true;
+}
+
+StrokeSession::~StrokeSession()
+{
+    end();
+    delete d;
+}
+
+bool StrokeSession::isActive() const
+{
+    return d->active;
+}
+
+void StrokeSession::moveTo(const QPointF &point, qreal pressure, int timeMsec)
+{
+    if (!d->active) return;
+
+    d->lastPaintInformation = d->makePaintInformation(point, pressure, timeMsec);
+    d->hasLastPosition = true;
+}
+
+void StrokeSession::paintTo(const QPointF &point, qreal pressure, int timeMsec)
+{
+    if (!d->active) return;
+
+    d->paintSegment(d->makePaintInformation(point, pressure, timeMsec));
+}
+
+void StrokeSession::paintPoints(const QList<QPointF> &points, const QList<qreal> &pressures, const QList<int> &timesMsec)
+{
+    if (!d->active) return;
+
+    for (int i = 0; i < points.size(); i++) {
+        const qreal pressure =
+            !pressures.isEmpty() ? pressures[qMin(i, pressures.size() - 1)] : 0.5;
+        const int timeMsec =
+            !timesMsec.isEmpty() ? timesMsec[qMin(i, timesMsec.size() - 1)] : -1;
+
+        d->paintSegment(d->makePaintInformation(points[i], pressure, timeMsec));
+    }
+}
+
+void StrokeSession::end()
+{
+    if (!d->active) return;
+
+    d->active = false;
+
+    KisImageSP imageSP = d->image;
+    if (!imageSP) return;
+
+    imageSP->addJob(d->strokeId,
+        new KisAsynchronousStrokeUpdateHelper::UpdateData(true));
+    imageSP->endStroke(d->strokeId);
+}
@@ -0,0 +1,90 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+#ifndef LIBKIS_STROKESESSION_H
+#define LIBKIS_STROKESESSION_H
+
+#include <QObject>
+#include <QPointF>
+
+#include <kis_types.h>
+
+#include "kritalibkis_export.h"
+#include "libkis.h"
+
+/**
+ * The StrokeSession class represents a single open brush stroke on a
+ * node, painted with the current brush preset.
+ *
+ * Node.paintLine() starts and ends a complete stroke for every segment,
+ * which creates one undo entry per segment and pays the full stroke
+ * setup cost each time. A StrokeSession keeps one stroke open instead:
+ * the stroke is started when the session is created, segments are
+ * submitted directly to the image's stroke system in batches, and the
+ * stroke is ended by end() or by deleting the session. The whole
+ * session forms a single undo entry and runs at engine speed, without
+ * going through the GUI event queue.
+ *
+ * Segment points are given in image coordinates. Pressure values range
+ * from 0.0 to 1.0. Timestamps are in milliseconds from the start of the
+ * stroke and drive the speed sensors of the brush preset; when they are
+ * omitted the timing information stays unset, like with Node.paintLine().
+ */
+class KRITALIBKIS_EXPORT StrokeSession : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(StrokeSession)
+
+public:
+    explicit StrokeSession(KisImageSP image, KisNodeSP node, const QString &strokeStyle, QObject *parent = 0);
+    ~StrokeSession() override;
+
+public Q_SLOTS:
+
+    /**
+     * @return true while the stroke is open, false after end() has
+     * been called.
+     */
+    bool isActive() const;
+
+    /**
+     * @brief moveTo lift the brush and move it to the given position
+     * without painting. The next paintTo() segment starts here.
+     */
+    void moveTo(const QPointF &point, qreal pressure = 0.5, int timeMsec = -1);
+
+    /**
+     * @brief paintTo paint a single segment from the current position
+     * to the given position.
+     */
+    void paintTo(const QPointF &point, qreal pressure = 0.5, int timeMsec = -1);
+
+    /**
+     * @brief paintPoints submit a whole batch of positions in one call.
+     * The first position is connected to the current brush position,
+     * and every following position continues the polyline.
+     * @param points the positions to paint through
+     * @param pressures optional per-point pressures; when the list is
+     * shorter than the point list the last pressure is reused
+     * @param timesMsec optional per-point timestamps in milliseconds
+     */
+    void paintPoints(const QList<QPointF> &points,
+                     const QList<qreal> &pressures = QList<qreal>(),
+                     const QList<int> &timesMsec = QList<int>());
+
+    /**
+     * @brief end finish the stroke and schedule the final canvas
+     * update. Call Document.waitForDone() afterwards if you need the
+     * result before reading pixels back. Deleting the session has the
+     * same effect.
+     */
+    void end();
+
+private:
+    struct Private;
+    Private *const d;
+};
+
+#endif // LIBKIS_STROKESESSION_H
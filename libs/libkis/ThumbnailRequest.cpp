@@ -0,0 +1,154 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+#include "ThumbnailRequest.h"
+
+#include <kis_assert.h>
+#include <kis_image.h>
+#include <kis_node.h>
+
+#include <KisIdleTaskStrokeStrategy.h>
+#include <KisRunnableStrokeJobUtils.h>
+#include <KisRunnableStrokeJobsInterface.h>
+
+namespace {
+
+struct ThumbnailRequestStroke : KisIdleTaskStrokeStrategy
+{
+    Q_OBJECT
+public:
+
+    ThumbnailRequestStroke(QList<KisNodeSP> nodes, int w, int h)
+        : KisIdleTaskStrokeStrategy(QLatin1String("libkis-thumbnails-stroke"), kundo2_i18n("Update layer thumbnails"))
+        , m_nodes(nodes)
+        , m_width(w)
+        , m_height(h)
+    {
+    }
+
+    void initStrokeCallback() override
+    {
+        KisIdleTaskStrokeStrategy::initStrokeCallback();
+
+        using KritaUtils::addJobConcurrent;
+
+        QVector<KisRunnableStrokeJobData*> jobs;
+
+        for (int i = 0; i < m_nodes.size(); i++) {
+            KisNodeSP node = m_nodes[i];
+
+            addJobConcurrent(jobs, [node, i, this] () {
+                this->sigThumbnailGenerated(i, node->createThumbnail(m_width, m_height));
+            });
+        }
+
+        runnableJobsInterface()->addRunnableJobs(jobs);
+    }
+
+    void cancelStrokeCallback() override
+    {
+        KisIdleTaskStrokeStrategy::cancelStrokeCallback();
+        Q_EMIT sigRequestCancelled();
+    }
+
+Q_SIGNALS:
+    void sigThumbnailGenerated(int index, const QImage &thumbnail);
+    void sigRequestCancelled();
+
+private:
+    QList<KisNodeSP> m_nodes;
+    int m_width;
+    int m_height;
+};
+
+} // namespace
+
+struct ThumbnailRequest::Private
+{
+    QVector<QImage> thumbnails;
+    bool finished = false;
+    bool cancelled = false;
+};
+
+ThumbnailRequest::ThumbnailRequest(KisImageSP image, QList<KisNodeSP> nodes, int w, int h, QObject *parent)
+    : QObject(parent)
+    , d(new Private)
+{
+    d->thumbnails.resize(nodes.size());
+
+    if (!image || nodes.isEmpty()) {
+        d->finished = true;
+        return;
+    }
+
+    ThumbnailRequestStroke *stroke = new ThumbnailRequestStroke(nodes, w, h);
+    connect(stroke, SIGNAL(sigThumbnailGenerated(int, QImage)), SLOT(slotThumbnailGenerated(int, QImage)));
+    connect(stroke, SIGNAL(sigIdleTaskFinished()), SLOT(slotFinished()));
+    connect(stroke, SIGNAL(sigRequestCancelled()), SLOT(slotCancelled()));
+
+    KisStrokeId strokeId = image->startStroke(stroke);
+    image->endStroke(strokeId);
+}
+
+ThumbnailRequest::~ThumbnailRequest()
+{
+    delete d;
+}
+
+int ThumbnailRequest::count() const
+{
+    return d->thumbnails.size();
+}
+
+bool ThumbnailRequest::isFinished() const
+{
+    return d->finished;
+}
+
+bool ThumbnailRequest::isCancelled() const
+{
+    return d->cancelled;
+}
+
+QImage ThumbnailRequest::thumbnail(int index) const
+{
+    return index >= 0 && index < d->thumbnails.size() ?
+        d->thumbnails[index] : QImage();
+}
+
+QList<QImage> ThumbnailRequest::thumbnails() const
+{
+    QList<QImage> result;
+    result.reserve(d->thumbnails.size());
+
+    Q_FOREACH (const QImage &thumbnail, d->thumbnails) {
+        result << thumbnail;
+    }
+
+    return result;
+}
+
+void ThumbnailRequest::slotThumbnailGenerated(int index, const QImage &thumbnail)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(index >= 0 && index < d->thumbnails.size());
+
+    d->thumbnails[index] = thumbnail;
+    Q_EMIT thumbnailGenerated(index, thumbnail);
+}
+
+void ThumbnailRequest::slotFinished()
+{
+    d->finished = true;
+    Q_EMIT finished();
+}
+
+void ThumbnailRequest::slotCancelled()
+{
+    d->finished = true;
+    d->cancelled = true;
+    Q_EMIT cancelled();
+}
+
+#include "ThumbnailRequest.moc"
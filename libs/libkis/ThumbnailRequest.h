@@ -0,0 +1,105 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+#ifndef LIBKIS_THUMBNAILREQUEST_H
+#define LIBKIS_THUMBNAILREQUEST_H
+
+#include <QObject>
+#include <QImage>
+
+#include <kis_types.h>
+
+#include "kritalibkis_export.h"
+#include "libkis.h"
+
+/**
+ * The ThumbnailRequest class represents an asynchronous thumbnail
+ * rendering request for one or more nodes of the same image.
+ *
+ * The thumbnails are rendered in the background through the image's
+ * idle-task stroke machinery, so requesting them does not block the
+ * GUI thread the way Node.thumbnail() does. Connect to the
+ * thumbnailGenerated() and finished() signals to receive the results,
+ * or poll isFinished() and fetch them with thumbnails().
+ *
+ * Like any idle-task stroke, the request can be cancelled by the image
+ * when the user starts a real stroke. In that case cancelled() is
+ * emitted and the thumbnails that were not generated yet stay null;
+ * re-issue the request if you still need them.
+ */
+class KRITALIBKIS_EXPORT ThumbnailRequest : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(ThumbnailRequest)
+
+public:
+    explicit ThumbnailRequest(KisImageSP image, QList<KisNodeSP> nodes, int w, int h, QObject *parent = 0);
+    ~ThumbnailRequest() override;
+
+public Q_SLOTS:
+
+    /**
+     * @return the number of thumbnails this request will generate.
+     */
+    int count() const;
+
+    /**
+     * @return true once all thumbnails have been generated, or the
+     * request has been cancelled.
+     */
+    bool isFinished() const;
+
+    /**
+     * @return true if the request was cancelled by the image before
+     * all thumbnails could be generated.
+     */
+    bool isCancelled() const;
+
+    /**
+     * @brief thumbnail retrieve a single generated thumbnail.
+     * @param index the position of the node in the requested node list
+     * @return the thumbnail, or a null QImage if it has not been
+     * generated yet.
+     */
+    QImage thumbnail(int index) const;
+
+    /**
+     * @brief thumbnails retrieve all generated thumbnails, in the same
+     * order as the requested node list. Thumbnails that have not been
+     * generated yet are null.
+     */
+    QList<QImage> thumbnails() const;
+
+Q_SIGNALS:
+
+    /**
+     * @brief emitted every time a single thumbnail has been generated.
+     * @param index the position of the node in the requested node list
+     * @param thumbnail the rendered thumbnail
+     */
+    void thumbnailGenerated(int index, const QImage &thumbnail);
+
+    /**
+     * @brief emitted when all thumbnails have been generated.
+     */
+    void finished();
+
+    /**
+     * @brief emitted when the image cancelled the request, e.g. because
+     * the user started painting.
+     */
+    void cancelled();
+
+private Q_SLOTS:
+    void slotThumbnailGenerated(int index, const QImage &thumbnail);
+    void slotFinished();
+    void slotCancelled();
+
+private:
+    struct Private;
+    Private *const d;
+};
+
+#endif // LIBKIS_THUMBNAILREQUEST_H
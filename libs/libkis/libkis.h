@@ -25,6 +25,8 @@ class Node;
 class Notifier;
 class Resource;
 class Scratchpad;
+class StrokeSession;
+class ThumbnailRequest;
 class Selection;
 class View;
 class Extension;
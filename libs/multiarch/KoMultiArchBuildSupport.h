@@ -44,7 +44,19 @@ auto createOptimizedClass(Args &&...param)
 
 #ifdef Q_PROCESSOR_X86
 
+    /**
+     * The AVX-512 tier requires BW (byte/word) support, which is
+     * the baseline of all desktop AVX-512 implementations and is
+     * needed for the 8/16-bit channel kernels. The tier is covered
+     * by the same user-visible switch as AVX/AVX2.
+     */
     if (!disableAVXOptimizations &&
+        xsimd::available_architectures().avx512bw) {
+
+        return FactoryType::template create<xsimd::avx512bw>(
+            std::forward<Args>(param)...);
+
+    } else if (!disableAVXOptimizations &&
         xsimd::available_architectures().fma3_avx2) {
 
         return FactoryType::template create<xsimd::fma3<xsimd::avx2>>(
@@ -10,6 +10,8 @@
 
 #include <type_traits>
 
+#include <QVector>
+
 #include "DebugPigment.h"
 #include "KoConfig.h"
 
@@ -22,9 +24,89 @@
 #include <KoColorSpaceMaths.h>
 #include <KoColorSpaceTraits.h>
 
+#include <xsimd_extensions/xsimd.hpp>
+
 #include "KisDitherOp.h"
 #include "KisDitherMaths.h"
 
+#if defined(HAVE_XSIMD) && !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE)
+
+namespace KisDitherOpDetail
+{
+using float_v = xsimd::batch<float>;
+using int_v = xsimd::batch<int>;
+
+/**
+ * Streamed conversions between a native channel type and the normalized
+ * float representation the dithering math runs in. Only the types
+ * listed here get a vectorized kernel; the others (e.g. half) take the
+ * scalar path.
+ */
+template<typename T>
+struct ChannelStreamer {
+    static constexpr bool supported = false;
+};
+
+template<>
+struct ChannelStreamer<quint8> {
+    static constexpr bool supported = true;
+
+    static inline float_v loadNormalized(const quint8 *src)
+    {
+        return xsimd::batch_cast<float>(xsimd::load_and_extend<int_v>(src)) * (1.0f / 255.0f);
+    }
+
+    static inline void storeNormalized(float_v c, quint8 *dst)
+    {
+        c = xsimd::min(xsimd::max(c, float_v(0.0f)), float_v(1.0f));
+        const int_v v = xsimd::nearbyint_as_int(c * 255.0f);
+        qint32 tmp[int_v::size];
+        v.store_unaligned(tmp);
+        for (size_t i = 0; i < int_v::size; ++i) {
+            dst[i] = quint8(tmp[i]);
+        }
+    }
+};
+
+template<>
+struct ChannelStreamer<quint16> {
+    static constexpr bool supported = true;
+
+    static inline float_v loadNormalized(const quint16 *src)
+    {
+        return xsimd::batch_cast<float>(xsimd::load_and_extend<int_v>(src)) * (1.0f / 65535.0f);
+    }
+
+    static inline void storeNormalized(float_v c, quint16 *dst)
+    {
+        c = xsimd::min(xsimd::max(c, float_v(0.0f)), float_v(1.0f));
+        const int_v v = xsimd::nearbyint_as_int(c * 65535.0f);
+        qint32 tmp[int_v::size];
+        v.store_unaligned(tmp);
+        for (size_t i = 0; i < int_v::size; ++i) {
+            dst[i] = quint16(tmp[i]);
+        }
+    }
+};
+
+template<>
+struct ChannelStreamer<float> {
+    static constexpr bool supported = true;
+
+    static inline float_v loadNormalized(const float *src)
+    {
+        return float_v::load_unaligned(src);
+    }
+
+    static inline void storeNormalized(float_v c, float *dst)
+    {
+        c.store_unaligned(dst);
+    }
+};
+} // namespace KisDitherOpDetail
+
+#endif // HAVE_XSIMD
+
 template<typename srcCSTraits, typename dstCSTraits, DitherType dType> class KisDitherOpImpl : public KisDitherOp
 {
     using srcChannelsType = typename srcCSTraits::channels_type;
@@ -137,6 +219,15 @@ private:
     template<DitherType t = dType, typename std::enable_if<t != DITHER_NONE, void>::type * = nullptr>
     inline void ditherImpl(const quint8 *srcRowStart, int srcRowStride, quint8 *dstRowStart, int dstRowStride, int x, int y, int columns, int rows) const
     {
+#if defined(HAVE_XSIMD) && !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE)
+        if constexpr (srcCSTraits::channels_nb == dstCSTraits::channels_nb
+                      && KisDitherOpDetail::ChannelStreamer<srcChannelsType>::supported
+                      && KisDitherOpDetail::ChannelStreamer<dstChannelsType>::supported) {
+            ditherRowsVector(srcRowStart, srcRowStride, dstRowStart, dstRowStride, x, y, columns, rows);
+            return;
+        }
+#endif
+
         const quint8 *nativeSrc = srcRowStart;
         quint8 *nativeDst = dstRowStart;
 
@@ -164,6 +255,68 @@ private:
         }
     }
 
+#if defined(HAVE_XSIMD) && !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE)
+    template<DitherType t = dType, typename std::enable_if<t != DITHER_NONE, void>::type * = nullptr>
+    inline void ditherRowsVector(const quint8 *srcRowStart, int srcRowStride, quint8 *dstRowStart, int dstRowStride, int x, int y, int columns, int rows) const
+    {
+        using float_v = KisDitherOpDetail::float_v;
+        using SrcStreamer = KisDitherOpDetail::ChannelStreamer<srcChannelsType>;
+        using DstStreamer = KisDitherOpDetail::ChannelStreamer<dstChannelsType>;
+
+        constexpr int channels = int(srcCSTraits::channels_nb);
+        constexpr int period = factorPeriod();
+        constexpr int blockLength = period * channels;
+
+        const int rowLength = columns * channels;
+        const float s = scale();
+
+        QVector<float> rowFactors(rowLength);
+
+        const quint8 *nativeSrc = srcRowStart;
+        quint8 *nativeDst = dstRowStart;
+
+        for (int a = 0; a < rows; ++a) {
+            /**
+             * Expand one period of the threshold matrix for this row
+             * (replicated across channels) and tile it over the whole
+             * row, so the inner loop needs no per-pixel index math.
+             * The matrices are periodic, so factor(x + b, ...) equals
+             * factor(x + b % period, ...).
+             */
+            float periodRow[blockLength];
+            for (int px = 0; px < period; ++px) {
+                const float f = factor(x + px, y + a);
+                for (int ch = 0; ch < channels; ++ch) {
+                    periodRow[px * channels + ch] = f;
+                }
+            }
+            for (int i = 0; i < rowLength; i += blockLength) {
+                memcpy(rowFactors.data() + i, periodRow, size_t(qMin(blockLength, rowLength - i)) * sizeof(float));
+            }
+
+            const srcChannelsType *srcPtr = srcCSTraits::nativeArray(nativeSrc);
+            dstChannelsType *dstPtr = dstCSTraits::nativeArray(nativeDst);
+            const float *factorPtr = rowFactors.constData();
+
+            int i = 0;
+            for (; i <= rowLength - int(float_v::size); i += int(float_v::size)) {
+                float_v c = SrcStreamer::loadNormalized(srcPtr + i);
+                const float_v f = float_v::load_unaligned(factorPtr + i);
+                c = c + (f - c) * s;
+                DstStreamer::storeNormalized(c, dstPtr + i);
+            }
+            for (; i < rowLength; ++i) {
+                float c = KoColorSpaceMaths<srcChannelsType, float>::scaleToA(srcPtr[i]);
+                c = KisDitherMaths::apply_dither(c, factorPtr[i], s);
+                dstPtr[i] = KoColorSpaceMaths<float, dstChannelsType>::scaleToA(c);
+            }
+
+            nativeSrc += srcRowStride;
+            nativeDst += dstRowStride;
+        }
+    }
+#endif
+
     template<typename U = typename dstCSTraits::channels_type, typename std::enable_if<!std::numeric_limits<U>::is_integer, void>::type * = nullptr> constexpr float scale() const
     {
         return 0.f; // no dithering for floating point
@@ -183,6 +336,16 @@ private:
     {
         return KisDitherMaths::dither_factor_blue_noise_64(x, y);
     }
+
+    template<DitherType t = dType, typename std::enable_if<t == DITHER_BAYER, void>::type * = nullptr> static constexpr int factorPeriod()
+    {
+        return 8;
+    }
+
+    template<DitherType t = dType, typename std::enable_if<t == DITHER_BLUE_NOISE, void>::type * = nullptr> static constexpr int factorPeriod()
+    {
+        return 64;
+    }
 };
 
 template<typename srcCSTraits, class dstCSTraits> inline void addDitherOpsByDepth(KoColorSpace *cs, const KoID &dstDepth)
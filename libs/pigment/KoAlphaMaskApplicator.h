@@ -48,6 +48,22 @@ struct KoAlphaMaskApplicator : public KoAlphaMaskApplicatorBase
                 _alpha_pos_>::
                 fillGrayBrushWithColor(dst, brush, brushColor, nPixels);
     }
+
+    void copyOpacityU8(quint8 *pixels, quint8 *alpha, qint32 nPixels) const override {
+        KoColorSpaceTrait<
+                _channels_type_,
+                _channels_nb_,
+                _alpha_pos_>::
+                copyOpacityU8(pixels, alpha, nPixels);
+    }
+
+    void applyAlphaU8Mask(quint8 *pixels, const quint8 *alpha, qint32 nPixels) const override {
+        KoColorSpaceTrait<
+                _channels_type_,
+                _channels_nb_,
+                _alpha_pos_>::
+                applyAlphaU8Mask(pixels, alpha, nPixels);
+    }
 };
 
 #if defined(HAVE_XSIMD) && !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE)
@@ -151,6 +167,44 @@ struct KoAlphaMaskApplicator<
         KoColorSpaceTrait<quint8, 4, 3>::
                 fillGrayBrushWithColor(dst, brush, brushColor, block2);
     }
+
+    void copyOpacityU8(quint8 *pixels, quint8 *alpha, qint32 nPixels) const override {
+        /**
+         * For U8 the alpha channel needs no rescaling, so the extraction
+         * is a plain strided byte gather that the compiler vectorizes on
+         * its own; going through lane shuffles would not beat it.
+         */
+        const quint8 *alphaSrc = pixels + alphaPos;
+
+        for (qint32 i = 0; i < nPixels; i++) {
+            alpha[i] = alphaSrc[i * numChannels];
+        }
+    }
+
+    void applyAlphaU8Mask(quint8 *pixels, const quint8 *alpha, qint32 nPixels) const override {
+        const int block1 = nPixels / static_cast<int>(float_v::size);
+        const int block2 = nPixels % static_cast<int>(float_v::size);
+        const int vectorPixelStride = numChannels * static_cast<int>(float_v::size);
+
+        const quint32 colorChannelsMask = 0x00FFFFFF;
+
+        for (int i = 0; i < block1; i++) {
+            const uint_v maskAlpha = xsimd::bitwise_cast_compat<unsigned int>(
+                xsimd::load_and_extend<int_v>(alpha));
+
+            auto data_i = uint_v::load_unaligned(reinterpret_cast<const quint32 *>(pixels));
+
+            const uint_v pixelAlpha_i = multiply(data_i >> 24, maskAlpha);
+            data_i = (data_i & colorChannelsMask) | (pixelAlpha_i << 24);
+            data_i.store_unaligned(reinterpret_cast<typename uint_v::value_type *>(pixels));
+
+            pixels += vectorPixelStride;
+            alpha += float_v::size;
+        }
+
+        KoColorSpaceTrait<quint8, 4, 3>::
+                applyAlphaU8Mask(pixels, alpha, block2);
+    }
 };
 
 #endif /* HAVE_XSIMD */
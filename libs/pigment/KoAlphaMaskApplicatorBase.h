@@ -24,7 +24,17 @@ public:
                                                           qint32 nPixels) const = 0;
     virtual void fillGrayBrushWithColor(quint8 *dst, const QRgb *brush, quint8 *brushColor, qint32 nPixels) const = 0;
 
-
+    /**
+     * Extract the alpha channel of \p nPixels pixels into a packed
+     * U8 plane \p alpha
+     */
+    virtual void copyOpacityU8(quint8 *pixels, quint8 *alpha, qint32 nPixels) const = 0;
+
+    /**
+     * Multiply the alpha channel of \p nPixels pixels by the packed
+     * U8 plane \p alpha
+     */
+    virtual void applyAlphaU8Mask(quint8 *pixels, const quint8 *alpha, qint32 nPixels) const = 0;
 };
 
 #endif // KOALPHAMASKAPPLICATORBASE_H
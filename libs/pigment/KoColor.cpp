@@ -20,6 +20,7 @@
 #include "KoColorSpace.h"
 #include "KoColorSpaceRegistry.h"
 #include "KoChannelInfo.h"
+#include "KisAllocationCensus.h"
 #include "kis_assert.h"
 #include "kis_dom_utils.h"
 
@@ -121,6 +122,9 @@ KoColor::KoColor(const KoColor &src, const KoColorSpace * colorSpace)
     memset(m_data, 0, m_size);
 
     src.colorSpace()->convertPixelsTo(src.m_data, m_data, colorSpace, 1, KoColorConversionTransformation::internalRenderingIntent(), KoColorConversionTransformation::internalConversionFlags());
+
+    KisAllocationCensus::instance()->
+        recordAllocation(KisAllocationCensus::ColorConversion, m_size);
 }
 
 bool KoColor::operator==(const KoColor &other) const {
@@ -151,6 +155,9 @@ void KoColor::convertTo(const KoColorSpace * cs, KoColorConversionTransformation
     memcpy(m_data, data, size);
     m_size = size;
     m_colorSpace = KoColorSpaceRegistry::instance()->permanentColorspace(cs);
+
+    KisAllocationCensus::instance()->
+        recordAllocation(KisAllocationCensus::ColorConversion, m_size);
 }
 
 void KoColor::convertTo(const KoColorSpace * cs)
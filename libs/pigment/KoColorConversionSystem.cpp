@@ -7,7 +7,12 @@
 #include "KoColorConversionSystem.h"
 #include "KoColorConversionSystem_p.h"
 
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
 #include <QHash>
+#include <QSaveFile>
+#include <QStandardPaths>
 #include <QString>
 
 #include "KoColorConversionAlphaTransformation.h"
@@ -17,6 +22,17 @@
 #include "KoCopyColorConversionTransformation.h"
 #include "KoMultipleColorConversionTransformation.h"
 
+namespace {
+
+const quint32 pathCacheMagic = 0x4B434350; // 'KCCP'
+const quint32 pathCacheVersion = 1;
+
+QString pathCacheFileName()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/colorconversionpaths.cache";
+}
+
+}
 
 KoColorConversionSystem::KoColorConversionSystem(RegistryInterface *registryInterface)
     : d(new Private(registryInterface))
@@ -25,6 +41,7 @@ KoColorConversionSystem::KoColorConversionSystem(RegistryInterface *registryInte
 
 KoColorConversionSystem::~KoColorConversionSystem()
 {
+    savePathCache();
     qDeleteAll(d->graph);
     qDeleteAll(d->vertexes);
     delete d;
@@ -111,6 +128,13 @@ void KoColorConversionSystem::insertColorSpace(const KoColorSpaceFactory* csf)
             v->setFactoryFromSrc(cctf);
         }
     }
+    // The new connections may offer better conversion routes, so any
+    // path memoized so far is potentially stale
+    QMutexLocker locker(&d->pathCacheMutex);
+    if (!d->pathCache.isEmpty()) {
+        d->pathCache.clear();
+        d->pathCacheDirty = true;
+    }
 }
 
 void KoColorConversionSystem::insertColorProfile(const KoColorProfile* _profile)
@@ -155,6 +179,11 @@ void KoColorConversionSystem::insertColorProfile(const KoColorProfile* _profile)
             }
         }
     }
+    QMutexLocker locker(&d->pathCacheMutex);
+    if (!d->pathCache.isEmpty()) {
+        d->pathCache.clear();
+        d->pathCacheDirty = true;
+    }
 }
 
 const KoColorSpace* KoColorConversionSystem::defaultColorSpaceForNode(const Node* node) const
@@ -430,6 +459,28 @@ KoColorConversionSystem::Path KoColorConversionSystem::findBestPath(const KoColo
     KIS_ASSERT(srcNode);
     KIS_ASSERT(dstNode);
 
+    QMutexLocker locker(&d->pathCacheMutex);
+
+    if (!d->pathCacheLoaded) {
+        loadPathCache();
+    }
+
+    const Private::PathCacheKey cacheKey(srcNode->key(), dstNode->key());
+    QHash<Private::PathCacheKey, Path>::ConstIterator it = d->pathCache.constFind(cacheKey);
+    if (it != d->pathCache.constEnd()) {
+        return it.value();
+    }
+
+    Path path = findBestPathImpl(srcNode, dstNode);
+    if (!path.isEmpty()) {
+        d->pathCache.insert(cacheKey, path);
+        d->pathCacheDirty = true;
+    }
+    return path;
+}
+
+KoColorConversionSystem::Path KoColorConversionSystem::findBestPathImpl(const KoColorConversionSystem::Node* srcNode, const KoColorConversionSystem::Node* dstNode) const
+{
     dbgPigmentCCS << "Find best path between " << srcNode->id() << " and  " << dstNode->id();
 
     PathQualityChecker pQC(qMin(srcNode->referenceDepth, dstNode->referenceDepth));
@@ -506,3 +557,125 @@ KoColorConversionSystem::Path KoColorConversionSystem::findBestPath(const KoColo
     errorPigment << "No path from " << srcNode->id() << " to " << dstNode->id() << " found not ";
     return currentBestPath;
 }
+
+uint KoColorConversionSystem::graphFingerprint() const
+{
+    // The sum makes the fingerprint independent of the plugin loading
+    // order, which is allowed to differ between sessions
+    uint fingerprint = ::qHash(d->vertexes.size());
+    Q_FOREACH (Vertex* v, d->vertexes) {
+        fingerprint += ::qHash(v->srcNode->id() + "->" + v->dstNode->id());
+    }
+    return fingerprint;
+}
+
+KoColorConversionSystem::Path KoColorConversionSystem::resolvePathFromKeys(const QVector<NodeKey> &keys) const
+{
+    Path path;
+    for (int i = 0; i < keys.size() - 1; i++) {
+        const Node* srcNode = nodeFor(keys[i]);
+        const Node* dstNode = nodeFor(keys[i + 1]);
+        if (!srcNode || !srcNode->isInitialized || !dstNode || !dstNode->isInitialized) {
+            return Path();
+        }
+        Vertex* connection = 0;
+        Q_FOREACH (Vertex* v, srcNode->outputVertexes) {
+            if (v->dstNode == dstNode) {
+                connection = v;
+                break;
+            }
+        }
+        if (!connection) {
+            return Path();
+        }
+        path.appendVertex(connection);
+    }
+    if (!path.isEmpty()) {
+        // The verdict is recomputed instead of being stored, in case the
+        // quality criteria change between releases
+        PathQualityChecker pQC(qMin(path.startNode()->referenceDepth, path.endNode()->referenceDepth));
+        path.isGood = pQC.isGoodPath(path);
+    }
+    return path;
+}
+
+void KoColorConversionSystem::loadPathCache() const
+{
+    d->pathCacheLoaded = true;
+
+    QFile file(pathCacheFileName());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QDataStream stream(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint32 fingerprint = 0;
+    quint32 pathCount = 0;
+    stream >> magic >> version >> fingerprint;
+    if (stream.status() != QDataStream::Ok
+            || magic != pathCacheMagic
+            || version != pathCacheVersion
+            || fingerprint != graphFingerprint()) {
+        dbgPigmentCCS << "Discarding stale conversion path cache " << file.fileName();
+        return;
+    }
+    stream >> pathCount;
+    for (quint32 i = 0; i < pathCount; i++) {
+        quint32 nodeCount = 0;
+        stream >> nodeCount;
+        QVector<NodeKey> keys;
+        keys.reserve(nodeCount);
+        for (quint32 j = 0; j < nodeCount; j++) {
+            QString modelId;
+            QString depthId;
+            QString profileName;
+            stream >> modelId >> depthId >> profileName;
+            keys.append(NodeKey(modelId, depthId, profileName));
+        }
+        if (stream.status() != QDataStream::Ok) {
+            dbgPigmentCCS << "Truncated conversion path cache " << file.fileName();
+            return;
+        }
+        if (keys.size() < 2) {
+            continue;
+        }
+        Path path = resolvePathFromKeys(keys);
+        if (!path.isEmpty()) {
+            d->pathCache.insert(Private::PathCacheKey(keys.first(), keys.last()), path);
+        }
+    }
+    dbgPigmentCCS << "Loaded " << d->pathCache.size() << " memoized conversion paths";
+}
+
+void KoColorConversionSystem::savePathCache() const
+{
+    QMutexLocker locker(&d->pathCacheMutex);
+
+    if (!d->pathCacheDirty) {
+        return;
+    }
+
+    QDir().mkpath(QStandardPaths::writableLocation(QStandardPaths::CacheLocation));
+    QSaveFile file(pathCacheFileName());
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream << pathCacheMagic << pathCacheVersion << graphFingerprint();
+    stream << quint32(d->pathCache.size());
+    for (QHash<Private::PathCacheKey, Path>::ConstIterator it = d->pathCache.constBegin(); it != d->pathCache.constEnd(); ++it) {
+        const Path &path = it.value();
+        stream << quint32(path.length() + 1);
+        const Node* startNode = path.startNode();
+        stream << startNode->modelId << startNode->depthId << startNode->profileName;
+        Q_FOREACH (Vertex* v, path.vertexes) {
+            stream << v->dstNode->modelId << v->dstNode->depthId << v->dstNode->profileName;
+        }
+    }
+    if (file.commit()) {
+        d->pathCacheDirty = false;
+    }
+}
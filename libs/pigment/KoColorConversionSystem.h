@@ -17,6 +17,7 @@ class KoID;
 
 #include <QList>
 #include <QPair>
+#include <QVector>
 
 #include "kritapigment_export.h"
 
@@ -163,9 +164,37 @@ private:
      */
     Vertex* createVertex(Node* srcNode, Node* dstNode);
     /**
-     * looks for the best path between two nodes
+     * looks for the best path between two nodes, using the memoized
+     * paths of this and previous sessions when possible
      */
     Path findBestPath(const Node* srcNode, const Node* dstNode) const;
+    /**
+     * runs the actual graph search, ignoring the memoized paths
+     */
+    Path findBestPathImpl(const Node* srcNode, const Node* dstNode) const;
+    /**
+     * Load the conversion paths memoized by previous sessions. The
+     * on-disk cache is discarded wholesale when the graph fingerprint
+     * doesn't match, that is when the set of installed color spaces,
+     * profiles or conversion links has changed.
+     */
+    void loadPathCache() const;
+    /**
+     * Write the memoized conversion paths to disk so that the next
+     * session can skip the graph searches.
+     */
+    void savePathCache() const;
+    /**
+     * @return a checksum of all the vertexes of the graph, used to
+     * detect stale on-disk path caches
+     */
+    uint graphFingerprint() const;
+    /**
+     * Rebuild a path from the list of node keys it passes through, or
+     * return an empty path if the nodes are not connected that way in
+     * the current graph.
+     */
+    Path resolvePathFromKeys(const QVector<NodeKey> &keys) const;
     /**
      * Delete all the paths of the list given in argument.
      */
@@ -16,6 +16,7 @@
 #include <boost/operators.hpp>
 
 #include <QList>
+#include <QMutex>
 
 enum NodeCapability {
     None = 0x0,
@@ -328,6 +329,20 @@ struct Q_DECL_HIDDEN KoColorConversionSystem::Private {
     QHash<NodeKey, Node*> graph;
     QList<Vertex*> vertexes;
     RegistryInterface *registryInterface;
+
+    typedef QPair<NodeKey, NodeKey> PathCacheKey;
+
+    /**
+     * Memoized results of findBestPath(). The graph search is repeated
+     * on every transformation creation and grows with the number of
+     * installed profiles, so successful searches are remembered here
+     * and written to disk on shutdown (see savePathCache()), which lets
+     * the next session skip the searches entirely.
+     */
+    mutable QHash<PathCacheKey, Path> pathCache;
+    mutable QMutex pathCacheMutex;
+    mutable bool pathCacheLoaded {false};
+    mutable bool pathCacheDirty {false};
 };
 
 struct PathQualityChecker {
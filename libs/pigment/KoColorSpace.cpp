@@ -35,6 +35,10 @@
 #include <QBitArray>
 #include <QPolygonF>
 #include <QPointF>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
 
 
 KoColorSpace::KoColorSpace()
@@ -70,6 +74,7 @@ KoColorSpace::~KoColorSpace()
         delete op;
     }
     d->compositeOps.clear();
+    d->compositeOpFactories.clear();
     for (const auto& map: d->ditherOps) {
         qDeleteAll(map);
     }
@@ -319,11 +324,20 @@ bool KoColorSpace::hasCompositeOp(const QString& id, const KoColorSpace *srcSpac
     if (srcSpace && preferCompositionInSourceColorSpace() && srcSpace->hasCompositeOp(id)) {
         return true;
     }
-    return d->compositeOps.contains(id);
+    QMutexLocker locker(&d->compositeOpsLock);
+    return d->compositeOps.contains(id) || d->compositeOpFactories.contains(id);
 }
 
 QList<KoCompositeOp*> KoColorSpace::compositeOps() const
 {
+    QMutexLocker locker(&d->compositeOpsLock);
+
+    // enumeration (e.g. by the blending mode selectors) needs the full
+    // catalogue, so materialize all pending factories first
+    Q_FOREACH (const QString &id, d->compositeOpFactories.keys()) {
+        d->materializeCompositeOp(id);
+    }
+
     return d->compositeOps.values();
 }
 
@@ -376,23 +390,33 @@ const KoCompositeOp * KoColorSpace::compositeOp(const QString & id, const KoColo
             return op;
         }
     }
-    const QHash<QString, KoCompositeOp*>::ConstIterator it = d->compositeOps.constFind(id);
-    if (it != d->compositeOps.constEnd()) {
-        return it.value();
-    }
-    else {
-        warnPigment << "Asking for nonexistent composite operation " << id << ", returning " << COMPOSITE_OVER;
-        return d->compositeOps.value(COMPOSITE_OVER);
+    QMutexLocker locker(&d->compositeOpsLock);
+
+    if (const KoCompositeOp *op = d->materializeCompositeOp(id)) {
+        return op;
     }
+
+    warnPigment << "Asking for nonexistent composite operation " << id << ", returning " << COMPOSITE_OVER;
+    return d->materializeCompositeOp(COMPOSITE_OVER);
 }
 
 void KoColorSpace::addCompositeOp(const KoCompositeOp * op)
 {
     if (op->colorSpace()->id() == id()) {
+        QMutexLocker locker(&d->compositeOpsLock);
+        d->compositeOpFactories.remove(op->id());
         d->compositeOps.insert(op->id(), const_cast<KoCompositeOp*>(op));
     }
 }
 
+void KoColorSpace::addCompositeOpFactory(const QString &id, std::function<KoCompositeOp*()> factory)
+{
+    QMutexLocker locker(&d->compositeOpsLock);
+    if (!d->compositeOps.contains(id)) {
+        d->compositeOpFactories.insert(id, std::move(factory));
+    }
+}
+
 void KoColorSpace::transparentColor(quint8 *dst, quint32 nPixels) const
 {
     memset(dst, 0, pixelSize() * nPixels);
@@ -476,6 +500,108 @@ bool KoColorSpace::convertPixelsTo(const quint8 * src,
     return true;
 }
 
+namespace {
+
+class ConvertPixelsTask : public QRunnable
+{
+public:
+    ConvertPixelsTask(const KoColorSpace *srcColorSpace,
+                      const quint8 *src,
+                      quint8 *dst,
+                      const KoColorSpace *dstColorSpace,
+                      quint32 numPixels,
+                      KoColorConversionTransformation::Intent renderingIntent,
+                      KoColorConversionTransformation::ConversionFlags conversionFlags,
+                      QSemaphore *doneSemaphore)
+        : m_srcColorSpace(srcColorSpace)
+        , m_src(src)
+        , m_dst(dst)
+        , m_dstColorSpace(dstColorSpace)
+        , m_numPixels(numPixels)
+        , m_renderingIntent(renderingIntent)
+        , m_conversionFlags(conversionFlags)
+        , m_doneSemaphore(doneSemaphore)
+    {
+    }
+
+    void run() override {
+        // every task owns its transformation, since the backend of the
+        // shared cached one may keep per-transform state
+        QScopedPointer<KoColorConversionTransformation> transfo(
+            m_srcColorSpace->createColorConverter(m_dstColorSpace, m_renderingIntent, m_conversionFlags));
+        transfo->transform(m_src, m_dst, m_numPixels);
+        m_doneSemaphore->release();
+    }
+
+private:
+    const KoColorSpace *m_srcColorSpace;
+    const quint8 *m_src;
+    quint8 *m_dst;
+    const KoColorSpace *m_dstColorSpace;
+    quint32 m_numPixels;
+    KoColorConversionTransformation::Intent m_renderingIntent;
+    KoColorConversionTransformation::ConversionFlags m_conversionFlags;
+    QSemaphore *m_doneSemaphore;
+};
+
+}
+
+bool KoColorSpace::parallelConvertPixelsTo(const quint8 * src,
+                                           quint8 * dst,
+                                           const KoColorSpace * dstColorSpace,
+                                           quint32 numPixels,
+                                           KoColorConversionTransformation::Intent renderingIntent,
+                                           KoColorConversionTransformation::ConversionFlags conversionFlags) const
+{
+    // Below this chunk size the creation of the per-thread
+    // transformations costs more than the conversion itself
+    const quint32 minPixelsPerTask = 64 * 1024;
+
+    const int numTasks = qMin(quint32(QThread::idealThreadCount()), numPixels / minPixelsPerTask);
+
+    if (numTasks < 2 || *this == *dstColorSpace) {
+        return convertPixelsTo(src, dst, dstColorSpace, numPixels, renderingIntent, conversionFlags);
+    }
+
+    const quint32 pixelsPerTask = numPixels / numTasks;
+    const quint32 srcPixelSize = pixelSize();
+    const quint32 dstPixelSize = dstColorSpace->pixelSize();
+
+    QSemaphore doneSemaphore;
+
+    quint32 firstPixel = pixelsPerTask;
+    for (int i = 1; i < numTasks; i++) {
+        const quint32 taskPixels =
+            i == numTasks - 1 ? numPixels - firstPixel : pixelsPerTask;
+
+        ConvertPixelsTask *task =
+            new ConvertPixelsTask(this,
+                                  src + firstPixel * srcPixelSize,
+                                  dst + firstPixel * dstPixelSize,
+                                  dstColorSpace,
+                                  taskPixels,
+                                  renderingIntent, conversionFlags,
+                                  &doneSemaphore);
+
+        if (!QThreadPool::globalInstance()->tryStart(task)) {
+            // The pool is saturated (or we are running on one of its
+            // worker threads already), so convert the chunk in place
+            // instead of risking a deadlock on the semaphore
+            task->run();
+            delete task;
+        }
+
+        firstPixel += taskPixels;
+    }
+
+    // The first chunk is converted in the calling thread, through the
+    // shared transformation pool of KoColorConversionCache
+    convertPixelsTo(src, dst, dstColorSpace, pixelsPerTask, renderingIntent, conversionFlags);
+
+    doneSemaphore.acquire(numTasks - 1);
+    return true;
+}
+
 KoColorConversionTransformation * KoColorSpace::createProofingTransform(const KoColorSpace *dstColorSpace, const KoColorSpace *proofingSpace, KoColorConversionTransformation::Intent renderingIntent, KoColorConversionTransformation::Intent proofingIntent, bool bpcFirstTransform, quint8 *gamutWarning, double adaptationState, KoColorConversionTransformation::ConversionFlags displayConversionFlags) const
 {
     if (!d->iccEngine) {
@@ -865,7 +991,7 @@ QImage KoColorSpace::convertToQImage(const quint8 *data, qint32 width, qint32 he
     const KoColorSpace * dstCS = KoColorSpaceRegistry::instance()->rgb8(dstProfile);
 
     if (data)
-        this->convertPixelsTo(const_cast<quint8 *>(data), img.bits(), dstCS, width * height, renderingIntent, conversionFlags);
+        this->parallelConvertPixelsTo(const_cast<quint8 *>(data), img.bits(), dstCS, width * height, renderingIntent, conversionFlags);
 
     return img;
 }
@@ -9,6 +9,7 @@
 #define KOCOLORSPACE_H
 
 #include <climits>
+#include <functional>
 
 #include <QImage>
 #include <QHash>
@@ -256,6 +257,15 @@ public:
      */
     virtual void addCompositeOp(const KoCompositeOp * op);
 
+    /**
+     * Register a factory that creates the composite op with the given id
+     * the first time it is actually requested. Compared to addCompositeOp()
+     * this defers the construction of rarely used blend modes, which keeps
+     * colorspace instantiation at startup cheap. The factory is invoked at
+     * most once; the created op is cached and owned by the colorspace.
+     */
+    void addCompositeOpFactory(const QString &id, std::function<KoCompositeOp*()> factory);
+
     /**
      * Returns true if the colorspace supports channel values outside the
      * (normalised) range 0 to 1.
@@ -394,6 +404,26 @@ public:
                                  KoColorConversionTransformation::Intent renderingIntent,
                                  KoColorConversionTransformation::ConversionFlags conversionFlags) const;
 
+    /**
+     * Convert a byte array of srcLen pixels *src to the specified color
+     * space and put the converted bytes into the prepared byte array
+     * *dst, splitting the work across the threads of the global thread
+     * pool. Each worker thread creates its own color conversion
+     * transformation, so the restrictions of convertPixelsTo() on
+     * sharing a transformation between threads do not apply here.
+     *
+     * Buffers too small to amortize the cost of the extra
+     * transformations are converted in the calling thread with
+     * convertPixelsTo().
+     *
+     * Returns false if the conversion failed, true if it succeeded
+     */
+    virtual bool parallelConvertPixelsTo(const quint8 * src,
+                                         quint8 * dst, const KoColorSpace * dstColorSpace,
+                                         quint32 numPixels,
+                                         KoColorConversionTransformation::Intent renderingIntent,
+                                         KoColorConversionTransformation::ConversionFlags conversionFlags) const;
+
     /**
      * @brief createProofingTransform
      * Create a proofing transform. This is a two part transform that can also do gamut checks.
@@ -109,7 +109,7 @@ public:
     }
 
     void copyOpacityU8(quint8* src, quint8 *dst, qint32 nPixels) const override {
-        _CSTrait::copyOpacityU8(src, dst, nPixels);
+        m_alphaMaskApplicator->copyOpacityU8(src, dst, nPixels);
     }
 
     void multiplyAlpha(quint8 * pixels, quint8 alpha, qint32 nPixels) const override {
@@ -117,7 +117,7 @@ public:
     }
 
     void applyAlphaU8Mask(quint8 * pixels, const quint8 * alpha, qint32 nPixels) const override {
-        _CSTrait::applyAlphaU8Mask(pixels, alpha, nPixels);
+        m_alphaMaskApplicator->applyAlphaU8Mask(pixels, alpha, nPixels);
     }
 
     void applyInverseAlphaU8Mask(quint8 * pixels, const quint8 * alpha, qint32 nPixels) const override {
@@ -43,3 +43,10 @@ const KoChannelInfo::enumChannelValueType KoColorSpaceMathsTraits<quint32>::chan
 
 const Ko::FullLut< KoIntegerToFloat<quint16>, float, quint16> KoLuts::Uint16ToFloat;
 const Ko::FullLut< KoIntegerToFloat<quint8>, float, quint8> KoLuts::Uint8ToFloat;
+
+#ifdef HAVE_OPENEXR
+const Ko::FullLut< KoHalfToUint8, quint8, quint16> KoLuts::HalfToUint8;
+const Ko::FullLut< KoHalfToUint16, quint16, quint16> KoLuts::HalfToUint16;
+const Ko::FullLut< KoIntegerToHalf<quint8>, half, quint8> KoLuts::Uint8ToHalf;
+const Ko::FullLut< KoIntegerToHalf<quint16>, half, quint16> KoLuts::Uint16ToHalf;
+#endif
@@ -189,10 +189,51 @@ struct KoIntegerToFloat {
   }
 };
 
+#ifdef HAVE_OPENEXR
+/**
+ * Functors for the half-float conversion tables. A half has only 65536
+ * bit patterns, so the conversions can be tabulated over the raw bits;
+ * each functor reproduces the arithmetic it replaces exactly.
+ */
+struct KoHalfToUint8 {
+  inline quint8 operator()(quint16 halfBits) const
+  {
+    half a;
+    a.setBits(halfBits);
+    half v = a * 255;
+    return (quint8)(CLAMP(v, 0, 255));
+  }
+};
+
+struct KoHalfToUint16 {
+  inline quint16 operator()(quint16 halfBits) const
+  {
+    half a;
+    a.setBits(halfBits);
+    double v = a * 0xFFFF;
+    return (quint16)(CLAMP(v, 0, 0xFFFF));
+  }
+};
+
+template<typename _T_>
+struct KoIntegerToHalf {
+  inline half operator()(_T_ a) const
+  {
+    return a * (1.0 / KoColorSpaceMathsTraits<_T_>::max);
+  }
+};
+#endif
+
 struct KoLuts {
 
   static KRITAPIGMENT_EXPORT const Ko::FullLut< KoIntegerToFloat<quint16>, float, quint16> Uint16ToFloat;
   static KRITAPIGMENT_EXPORT const Ko::FullLut< KoIntegerToFloat<quint8>, float, quint8> Uint8ToFloat;
+#ifdef HAVE_OPENEXR
+  static KRITAPIGMENT_EXPORT const Ko::FullLut< KoHalfToUint8, quint8, quint16> HalfToUint8;
+  static KRITAPIGMENT_EXPORT const Ko::FullLut< KoHalfToUint16, quint16, quint16> HalfToUint16;
+  static KRITAPIGMENT_EXPORT const Ko::FullLut< KoIntegerToHalf<quint8>, half, quint8> Uint8ToHalf;
+  static KRITAPIGMENT_EXPORT const Ko::FullLut< KoIntegerToHalf<quint16>, half, quint16> Uint16ToHalf;
+#endif
 };
 
 /**
@@ -544,26 +585,24 @@ inline half KoColorSpaceMaths<float, half>::scaleToA(float a)
 template<>
 inline quint8 KoColorSpaceMaths<half, quint8>::scaleToA(half a)
 {
-    half v = a * 255;
-    return (quint8)(CLAMP(v, 0, 255));
+    return KoLuts::HalfToUint8(a.bits());
 }
 
 template<>
 inline half KoColorSpaceMaths<quint8, half>::scaleToA(quint8 a)
 {
-    return a *(1.0 / 255.0);
+    return KoLuts::Uint8ToHalf(a);
 }
 template<>
 inline quint16 KoColorSpaceMaths<half, quint16>::scaleToA(half a)
 {
-    double v = a * 0xFFFF;
-    return (quint16)(CLAMP(v, 0, 0xFFFF));
+    return KoLuts::HalfToUint16(a.bits());
 }
 
 template<>
 inline half KoColorSpaceMaths<quint16, half>::scaleToA(quint16 a)
 {
-    return a *(1.0 / 0xFFFF);
+    return KoLuts::Uint16ToHalf(a);
 }
 
 template<>
@@ -14,6 +14,9 @@
 #include <QPair>
 #include <QThreadStorage>
 #include <QPolygonF>
+#include <QMutex>
+
+#include <functional>
 
 struct Q_DECL_HIDDEN KoColorSpace::Private {
     /**
@@ -39,10 +42,39 @@ struct Q_DECL_HIDDEN KoColorSpace::Private {
     };
 
 
+    /**
+     * Looks up a composite op, constructing it from its registered
+     * factory if it hasn't been materialized yet. Returns null if
+     * neither an op nor a factory with this id is known.
+     *
+     * Must be called with compositeOpsLock held.
+     */
+    KoCompositeOp *materializeCompositeOp(const QString &id)
+    {
+        const QHash<QString, KoCompositeOp*>::ConstIterator it = compositeOps.constFind(id);
+        if (it != compositeOps.constEnd()) {
+            return it.value();
+        }
+
+        const auto factoryIt = compositeOpFactories.constFind(id);
+        if (factoryIt == compositeOpFactories.constEnd()) {
+            return nullptr;
+        }
+
+        KoCompositeOp *op = factoryIt.value()();
+        compositeOpFactories.remove(id);
+        if (op) {
+            compositeOps.insert(id, op);
+        }
+        return op;
+    }
+
     QString id;
     quint32 idNumber;
     QString name;
     QHash<QString, KoCompositeOp*> compositeOps;
+    QHash<QString, std::function<KoCompositeOp*()>> compositeOpFactories;
+    mutable QMutex compositeOpsLock;
     QList<KoChannelInfo *> channels;
     KoMixColorsOp* mixColorsOp;
     KoConvolutionOp* convolutionOp;
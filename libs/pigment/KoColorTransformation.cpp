@@ -12,6 +12,18 @@ KoColorTransformation::~KoColorTransformation()
 {
 }
 
+void KoColorTransformation::transform(const quint8 *srcRowStart, qint32 srcRowStride, quint8 *dstRowStart, qint32 dstRowStride, qint32 columns, qint32 rows) const
+{
+    const quint8 *src = srcRowStart;
+    quint8 *dst = dstRowStart;
+
+    for (qint32 y = 0; y < rows; ++y) {
+        transform(src, dst, columns);
+        src += srcRowStride;
+        dst += dstRowStride;
+    }
+}
+
 QList<QString> KoColorTransformation::parameters() const
 {
     return QList<QString>();
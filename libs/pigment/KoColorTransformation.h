@@ -46,6 +46,30 @@ public:
      */
     virtual void transform(const quint8 *src, quint8 *dst, qint32 nPixels) const = 0;
 
+    /**
+     * This function applies the transformation on a rectangular block of
+     * pixels, given as rows of packed pixels with a stride in bytes
+     * between the starts of consecutive rows.
+     *
+     * The default implementation processes the block row by row through
+     * transform(). Implementations with a per-call setup cost should
+     * override it so the cost is paid once per block instead of once per
+     * row.
+     *
+     * @param srcRowStart a pointer to the first source row
+     * @param srcRowStride the byte distance between consecutive source rows
+     * @param dstRowStart a pointer to the first destination row
+     * @param dstRowStride the byte distance between consecutive destination rows
+     * @param columns the number of pixels per row
+     * @param rows the number of rows
+     *
+     * The source and destination may point to the same pixels; overrides
+     * may use that to take an in-place fast path.
+     */
+    virtual void transform(const quint8 *srcRowStart, qint32 srcRowStride,
+                           quint8 *dstRowStart, qint32 dstRowStride,
+                           qint32 columns, qint32 rows) const;
+
     /**
      * @return the list of parameters
      */
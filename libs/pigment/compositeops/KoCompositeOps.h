@@ -56,6 +56,21 @@ struct OptimizedOpsSelector
     static KoCompositeOp* createCopyOp(const KoColorSpace *cs) {
         return new KoCompositeOpCopy2<Traits>(cs);
     }
+
+    /**
+     * Unlike the ops above, the vectorized separable blend modes
+     * exist only for a few pixel formats; returning null here makes
+     * the caller fall back to the generic scalar implementation
+     */
+    static KoCompositeOp* createMultiplyOp(const KoColorSpace *cs) {
+        Q_UNUSED(cs);
+        return nullptr;
+    }
+
+    static KoCompositeOp* createScreenOp(const KoColorSpace *cs) {
+        Q_UNUSED(cs);
+        return nullptr;
+    }
 };
 
 template<>
@@ -73,6 +88,14 @@ struct OptimizedOpsSelector<KoBgrU8Traits>
     static KoCompositeOp* createCopyOp(const KoColorSpace *cs) {
         return KoOptimizedCompositeOpFactory::createCopyOp32(cs);
     }
+
+    static KoCompositeOp* createMultiplyOp(const KoColorSpace *cs) {
+        return KoOptimizedCompositeOpFactory::createMultiplyOp32(cs);
+    }
+
+    static KoCompositeOp* createScreenOp(const KoColorSpace *cs) {
+        return KoOptimizedCompositeOpFactory::createScreenOp32(cs);
+    }
 };
 
 template<>
@@ -89,6 +112,12 @@ struct OptimizedOpsSelector<KoLabU8Traits>
     static KoCompositeOp* createCopyOp(const KoColorSpace *cs) {
         return KoOptimizedCompositeOpFactory::createCopyOp32(cs);
     }
+    static KoCompositeOp* createMultiplyOp(const KoColorSpace *cs) {
+        return KoOptimizedCompositeOpFactory::createMultiplyOp32(cs);
+    }
+    static KoCompositeOp* createScreenOp(const KoColorSpace *cs) {
+        return KoOptimizedCompositeOpFactory::createScreenOp32(cs);
+    }
 };
 
 template<>
@@ -106,6 +135,12 @@ struct OptimizedOpsSelector<KoRgbF32Traits>
     static KoCompositeOp* createCopyOp(const KoColorSpace *cs) {
         return KoOptimizedCompositeOpFactory::createCopyOp128(cs);
     }
+    static KoCompositeOp* createMultiplyOp(const KoColorSpace *cs) {
+        return KoOptimizedCompositeOpFactory::createMultiplyOp128(cs);
+    }
+    static KoCompositeOp* createScreenOp(const KoColorSpace *cs) {
+        return KoOptimizedCompositeOpFactory::createScreenOp128(cs);
+    }
 };
 
 template<>
@@ -123,6 +158,12 @@ struct OptimizedOpsSelector<KoBgrU16Traits>
     static KoCompositeOp* createCopyOp(const KoColorSpace *cs) {
         return KoOptimizedCompositeOpFactory::createCopyOpU64(cs);
     }
+    static KoCompositeOp* createMultiplyOp(const KoColorSpace *cs) {
+        return KoOptimizedCompositeOpFactory::createMultiplyOpU64(cs);
+    }
+    static KoCompositeOp* createScreenOp(const KoColorSpace *cs) {
+        return KoOptimizedCompositeOpFactory::createScreenOpU64(cs);
+    }
 };
 
 
@@ -135,29 +176,40 @@ struct AddGeneralOps<Traits, true>
      static constexpr bool IsIntegerSpace = std::numeric_limits<Arg>::is_integer;
 
      template<CompositeFunc func>
-     static void add(KoColorSpace* cs, const QString& id, const QString& category) {
+     static KoCompositeOp* create(KoColorSpace* cs, const QString& id, const QString& category) {
         if constexpr (std::is_base_of_v<KoCmykTraits<typename Traits::channels_type>, Traits>) {
             if (useSubtractiveBlendingForCmykColorSpaces()) {
-                cs->addCompositeOp(new KoCompositeOpGenericSC<Traits, func, KoSubtractiveBlendingPolicy<Traits>>(cs, id, category));
-            } else {
-                cs->addCompositeOp(new KoCompositeOpGenericSC<Traits, func, KoAdditiveBlendingPolicy<Traits>>(cs, id, category));
+                return new KoCompositeOpGenericSC<Traits, func, KoSubtractiveBlendingPolicy<Traits>>(cs, id, category);
             }
-        } else {
-            cs->addCompositeOp(new KoCompositeOpGenericSC<Traits, func, KoAdditiveBlendingPolicy<Traits>>(cs, id, category));
         }
+        return new KoCompositeOpGenericSC<Traits, func, KoAdditiveBlendingPolicy<Traits>>(cs, id, category);
      }
 
      template<typename Functor>
-     static void add(KoColorSpace* cs, const QString& id, const QString& category) {
+     static KoCompositeOp* create(KoColorSpace* cs, const QString& id, const QString& category) {
          if constexpr (std::is_base_of_v<KoCmykTraits<typename Traits::channels_type>, Traits>) {
              if (useSubtractiveBlendingForCmykColorSpaces()) {
-                 cs->addCompositeOp(new KoCompositeOpGenericSCFunctor<Traits, Functor, KoSubtractiveBlendingPolicy<Traits>>(cs, id, category));
-             } else {
-                 cs->addCompositeOp(new KoCompositeOpGenericSCFunctor<Traits, Functor, KoAdditiveBlendingPolicy<Traits>>(cs, id, category));
+                 return new KoCompositeOpGenericSCFunctor<Traits, Functor, KoSubtractiveBlendingPolicy<Traits>>(cs, id, category);
              }
-         } else {
-             cs->addCompositeOp(new KoCompositeOpGenericSCFunctor<Traits, Functor, KoAdditiveBlendingPolicy<Traits>>(cs, id, category));
          }
+         return new KoCompositeOpGenericSCFunctor<Traits, Functor, KoAdditiveBlendingPolicy<Traits>>(cs, id, category);
+     }
+
+     // the generic blend modes are only materialized on first use; eagerly
+     // instantiating the whole catalogue for every registered colorspace
+     // noticeably slows down startup
+     template<CompositeFunc func>
+     static void add(KoColorSpace* cs, const QString& id, const QString& category) {
+        cs->addCompositeOpFactory(id, [cs, id, category]() {
+            return create<func>(cs, id, category);
+        });
+     }
+
+     template<typename Functor>
+     static void add(KoColorSpace* cs, const QString& id, const QString& category) {
+         cs->addCompositeOpFactory(id, [cs, id, category]() {
+             return create<Functor>(cs, id, category);
+         });
      }
 
      static void add(KoColorSpace* cs) {
@@ -168,28 +220,30 @@ struct AddGeneralOps<Traits, true>
          cs->addCompositeOp(OptimizedOpsSelector<Traits>::createCopyOp(cs));
          cs->addCompositeOp(new KoCompositeOpErase<Traits>(cs));
 
-         if constexpr (std::is_base_of_v<KoCmykTraits<typename Traits::channels_type>, Traits>) {
-            if (useSubtractiveBlendingForCmykColorSpaces()) {
-                cs->addCompositeOp(new KoCompositeOpBehind<Traits, KoSubtractiveBlendingPolicy<Traits>>(cs));
-            } else {
-                cs->addCompositeOp(new KoCompositeOpBehind<Traits, KoAdditiveBlendingPolicy<Traits>>(cs));
+         cs->addCompositeOpFactory(COMPOSITE_BEHIND, [cs]() -> KoCompositeOp* {
+            if constexpr (std::is_base_of_v<KoCmykTraits<typename Traits::channels_type>, Traits>) {
+                if (useSubtractiveBlendingForCmykColorSpaces()) {
+                    return new KoCompositeOpBehind<Traits, KoSubtractiveBlendingPolicy<Traits>>(cs);
+                }
             }
-         } else {
-            cs->addCompositeOp(new KoCompositeOpBehind<Traits, KoAdditiveBlendingPolicy<Traits>>(cs));
-         }
-
-         cs->addCompositeOp(new KoCompositeOpDestinationIn<Traits>(cs));
-         cs->addCompositeOp(new KoCompositeOpDestinationAtop<Traits>(cs));
-
-         if constexpr (std::is_base_of_v<KoCmykTraits<typename Traits::channels_type>, Traits>) {
-            if (useSubtractiveBlendingForCmykColorSpaces()) {
-                cs->addCompositeOp(new KoCompositeOpGreater<Traits, KoSubtractiveBlendingPolicy<Traits>>(cs));
-            } else {
-                cs->addCompositeOp(new KoCompositeOpGreater<Traits, KoAdditiveBlendingPolicy<Traits>>(cs));
+            return new KoCompositeOpBehind<Traits, KoAdditiveBlendingPolicy<Traits>>(cs);
+         });
+
+         cs->addCompositeOpFactory(COMPOSITE_DESTINATION_IN, [cs]() -> KoCompositeOp* {
+            return new KoCompositeOpDestinationIn<Traits>(cs);
+         });
+         cs->addCompositeOpFactory(COMPOSITE_DESTINATION_ATOP, [cs]() -> KoCompositeOp* {
+            return new KoCompositeOpDestinationAtop<Traits>(cs);
+         });
+
+         cs->addCompositeOpFactory(COMPOSITE_GREATER, [cs]() -> KoCompositeOp* {
+            if constexpr (std::is_base_of_v<KoCmykTraits<typename Traits::channels_type>, Traits>) {
+                if (useSubtractiveBlendingForCmykColorSpaces()) {
+                    return new KoCompositeOpGreater<Traits, KoSubtractiveBlendingPolicy<Traits>>(cs);
+                }
             }
-         } else {
-            cs->addCompositeOp(new KoCompositeOpGreater<Traits, KoAdditiveBlendingPolicy<Traits>>(cs));
-         }
+            return new KoCompositeOpGreater<Traits, KoAdditiveBlendingPolicy<Traits>>(cs);
+         });
 
          add<CFOverlay<Arg>        >(cs, COMPOSITE_OVERLAY       , KoCompositeOp::categoryMix());
          add<CFGrainMerge<Arg>     >(cs, COMPOSITE_GRAIN_MERGE   , KoCompositeOp::categoryMix());
@@ -216,7 +270,12 @@ struct AddGeneralOps<Traits, true>
          add<&cfPenumbraC<Arg>     >(cs, COMPOSITE_PENUMBRAC     , KoCompositeOp::categoryMix());
          add<&cfPenumbraD<Arg>     >(cs, COMPOSITE_PENUMBRAD     , KoCompositeOp::categoryMix());
 
-         add<&cfScreen<Arg>      >(cs, COMPOSITE_SCREEN      , KoCompositeOp::categoryLight());
+         cs->addCompositeOpFactory(COMPOSITE_SCREEN, [cs]() -> KoCompositeOp* {
+             if (KoCompositeOp *op = OptimizedOpsSelector<Traits>::createScreenOp(cs)) {
+                 return op;
+             }
+             return create<&cfScreen<Arg>>(cs, COMPOSITE_SCREEN, KoCompositeOp::categoryLight());
+         });
 
          add<FunctorWithSDRClampPolicy<CFColorDodge, Arg>>(cs, COMPOSITE_DODGE, KoCompositeOp::categoryLight());
          if constexpr (!IsIntegerSpace) {
@@ -258,7 +317,12 @@ struct AddGeneralOps<Traits, true>
          add<&cfAddition<Arg>        >(cs, COMPOSITE_ADD             , KoCompositeOp::categoryArithmetic());
          add<&cfSubtract<Arg>        >(cs, COMPOSITE_SUBTRACT        , KoCompositeOp::categoryArithmetic());
          add<CFInverseSubtract<Arg>  >(cs, COMPOSITE_INVERSE_SUBTRACT, KoCompositeOp::categoryArithmetic());
-         add<&cfMultiply<Arg>        >(cs, COMPOSITE_MULT            , KoCompositeOp::categoryArithmetic());
+         cs->addCompositeOpFactory(COMPOSITE_MULT, [cs]() -> KoCompositeOp* {
+             if (KoCompositeOp *op = OptimizedOpsSelector<Traits>::createMultiplyOp(cs)) {
+                 return op;
+             }
+             return create<&cfMultiply<Arg>>(cs, COMPOSITE_MULT, KoCompositeOp::categoryArithmetic());
+         });
          add<CFDivide<Arg>           >(cs, COMPOSITE_DIVIDE          , KoCompositeOp::categoryArithmetic());
 
          add<&cfModulo<Arg>               >(cs, COMPOSITE_MOD                , KoCompositeOp::categoryModulo());
@@ -298,7 +362,9 @@ struct AddGeneralOps<Traits, true>
          add<CFFrect<Arg>   >(cs, COMPOSITE_FRECT  , KoCompositeOp::categoryQuadratic());
          add<&cfFhyrd<Arg>  >(cs, COMPOSITE_FHYRD  , KoCompositeOp::categoryQuadratic());
 
-         cs->addCompositeOp(new KoCompositeOpDissolve<Traits>(cs, KoCompositeOp::categoryMisc()));
+         cs->addCompositeOpFactory(COMPOSITE_DISSOLVE, [cs]() -> KoCompositeOp* {
+             return new KoCompositeOpDissolve<Traits>(cs, KoCompositeOp::categoryMisc());
+         });
      }
 };
 
@@ -319,14 +385,23 @@ struct AddRGBOps<Traits, true>
 
     template<typename Functor>
     static void add(KoColorSpace* cs, const QString& id, const QString& category) {
-        cs->addCompositeOp(new KoCompositeOpGenericHSLFunctor<Traits, Functor>(cs, id, category));
+        cs->addCompositeOpFactory(id, [cs, id, category]() -> KoCompositeOp* {
+            return new KoCompositeOpGenericHSLFunctor<Traits, Functor>(cs, id, category);
+        });
+    }
+
+    template<qint32 channel_pos>
+    static void addCopyChannel(KoColorSpace* cs, const QString& id) {
+        cs->addCompositeOpFactory(id, [cs, id]() -> KoCompositeOp* {
+            return new KoCompositeOpCopyChannel<Traits, channel_pos>(cs, id, KoCompositeOp::categoryMisc());
+        });
     }
 
     static void add(KoColorSpace* cs) {
 
-        cs->addCompositeOp(new KoCompositeOpCopyChannel<Traits,red_pos  >(cs, COMPOSITE_COPY_RED  , KoCompositeOp::categoryMisc()));
-        cs->addCompositeOp(new KoCompositeOpCopyChannel<Traits,green_pos>(cs, COMPOSITE_COPY_GREEN, KoCompositeOp::categoryMisc()));
-        cs->addCompositeOp(new KoCompositeOpCopyChannel<Traits,blue_pos >(cs, COMPOSITE_COPY_BLUE , KoCompositeOp::categoryMisc()));
+        addCopyChannel<red_pos  >(cs, COMPOSITE_COPY_RED);
+        addCopyChannel<green_pos>(cs, COMPOSITE_COPY_GREEN);
+        addCopyChannel<blue_pos >(cs, COMPOSITE_COPY_BLUE);
 
         add<CFTangentNormalmap<channels_type> >(cs, COMPOSITE_TANGENT_NORMALMAP  , KoCompositeOp::categoryMisc());
         add<CFReorientedNormalMapCombine<channels_type>>(cs, COMPOSITE_COMBINE_NORMAL, KoCompositeOp::categoryMisc());
@@ -397,15 +472,14 @@ struct AddGeneralAlphaOps<Traits, true>
 
     static void add(KoColorSpace* cs, const QString& id, const QString& category)
     {
-        if constexpr (std::is_base_of_v<KoCmykTraits<typename Traits::channels_type>, Traits>) {
-            if (useSubtractiveBlendingForCmykColorSpaces()) {
-                cs->addCompositeOp(new KoCompositeOpGenericSCAlpha<Traits, compositeFunc, KoSubtractiveBlendingPolicy<Traits>>(cs, id, category));
-            } else {
-                cs->addCompositeOp(new KoCompositeOpGenericSCAlpha<Traits, compositeFunc, KoAdditiveBlendingPolicy<Traits>>(cs, id, category));
+        cs->addCompositeOpFactory(id, [cs, id, category]() -> KoCompositeOp* {
+            if constexpr (std::is_base_of_v<KoCmykTraits<typename Traits::channels_type>, Traits>) {
+                if (useSubtractiveBlendingForCmykColorSpaces()) {
+                    return new KoCompositeOpGenericSCAlpha<Traits, compositeFunc, KoSubtractiveBlendingPolicy<Traits>>(cs, id, category);
+                }
             }
-        } else {
-            cs->addCompositeOp(new KoCompositeOpGenericSCAlpha<Traits, compositeFunc, KoAdditiveBlendingPolicy<Traits>>(cs, id, category));
-        }
+            return new KoCompositeOpGenericSCAlpha<Traits, compositeFunc, KoAdditiveBlendingPolicy<Traits>>(cs, id, category);
+        });
     }
 
     static void add(KoColorSpace* cs)
@@ -78,3 +78,33 @@ KoCompositeOp* KoOptimizedCompositeOpFactory::createCopyOpU64(const KoColorSpace
 {
     return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpCopyU64> >(cs);
 }
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createMultiplyOp32(const KoColorSpace *cs)
+{
+    return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpMultiply32> >(cs);
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createMultiplyOpU64(const KoColorSpace *cs)
+{
+    return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpMultiplyU64> >(cs);
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createMultiplyOp128(const KoColorSpace *cs)
+{
+    return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpMultiply128> >(cs);
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createScreenOp32(const KoColorSpace *cs)
+{
+    return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpScreen32> >(cs);
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createScreenOpU64(const KoColorSpace *cs)
+{
+    return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpScreenU64> >(cs);
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createScreenOp128(const KoColorSpace *cs)
+{
+    return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpScreen128> >(cs);
+}
@@ -13,6 +13,7 @@
 #include "KoOptimizedCompositeOpOver32.h"
 #include "KoOptimizedCompositeOpOver128.h"
 #include "KoOptimizedCompositeOpCopy128.h"
+#include "KoOptimizedCompositeOpGeneric.h"
 
 #include <KoCompositeOpRegistry.h>
 
@@ -124,4 +125,58 @@ KoCompositeOp *KoOptimizedCompositeOpFactoryPerArch<
     return new KoOptimizedCompositeOpAlphaDarkenCreamyU64<xsimd::current_arch>(param);
 }
 
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpMultiply32>::create<
+    xsimd::current_arch>(const KoColorSpace *param)
+{
+    return new KoOptimizedCompositeOpMultiply32<xsimd::current_arch>(param);
+}
+
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpMultiplyU64>::create<
+    xsimd::current_arch>(const KoColorSpace *param)
+{
+    return new KoOptimizedCompositeOpMultiplyU64<xsimd::current_arch>(param);
+}
+
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpMultiply128>::create<
+    xsimd::current_arch>(const KoColorSpace *param)
+{
+    return new KoOptimizedCompositeOpMultiply128<xsimd::current_arch>(param);
+}
+
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpScreen32>::create<
+    xsimd::current_arch>(const KoColorSpace *param)
+{
+    return new KoOptimizedCompositeOpScreen32<xsimd::current_arch>(param);
+}
+
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpScreenU64>::create<
+    xsimd::current_arch>(const KoColorSpace *param)
+{
+    return new KoOptimizedCompositeOpScreenU64<xsimd::current_arch>(param);
+}
+
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpScreen128>::create<
+    xsimd::current_arch>(const KoColorSpace *param)
+{
+    return new KoOptimizedCompositeOpScreen128<xsimd::current_arch>(param);
+}
+
 #endif // XSIMD_UNIVERSAL_BUILD_PASS
@@ -49,6 +49,24 @@ class KoOptimizedCompositeOpCopyU64;
 template<typename _impl>
 class KoOptimizedCompositeOpCopy32;
 
+template<typename _impl>
+class KoOptimizedCompositeOpMultiply32;
+
+template<typename _impl>
+class KoOptimizedCompositeOpMultiplyU64;
+
+template<typename _impl>
+class KoOptimizedCompositeOpMultiply128;
+
+template<typename _impl>
+class KoOptimizedCompositeOpScreen32;
+
+template<typename _impl>
+class KoOptimizedCompositeOpScreenU64;
+
+template<typename _impl>
+class KoOptimizedCompositeOpScreen128;
+
 template<template<typename I> class CompositeOp>
 struct KoOptimizedCompositeOpFactoryPerArch {
     template<typename _impl>
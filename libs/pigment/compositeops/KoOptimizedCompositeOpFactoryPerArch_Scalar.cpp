@@ -12,6 +12,10 @@
 #include "KoAlphaDarkenParamsWrapper.h"
 #include "KoCompositeOpOver.h"
 #include "KoCompositeOpCopy2.h"
+#include "KoCompositeOpGeneric.h"
+#include "KoCompositeOpFunctions.h"
+#include "KoCompositeOpRegistry.h"
+#include "KoColorSpaceBlendingPolicy.h"
 
 template<>
 template<>
@@ -121,3 +125,57 @@ KoCompositeOp *KoOptimizedCompositeOpFactoryPerArch<
     return new KoCompositeOpAlphaDarken<KoBgrU16Traits, KoAlphaDarkenParamsWrapperCreamy>(param);
 }
 
+
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpMultiply32>::create<
+    xsimd::generic>(const KoColorSpace *param)
+{
+    return new KoCompositeOpGenericSC<KoBgrU8Traits, &cfMultiply<quint8>, KoAdditiveBlendingPolicy<KoBgrU8Traits>>(param, COMPOSITE_MULT, KoCompositeOp::categoryArithmetic());
+}
+
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpMultiplyU64>::create<
+    xsimd::generic>(const KoColorSpace *param)
+{
+    return new KoCompositeOpGenericSC<KoBgrU16Traits, &cfMultiply<quint16>, KoAdditiveBlendingPolicy<KoBgrU16Traits>>(param, COMPOSITE_MULT, KoCompositeOp::categoryArithmetic());
+}
+
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpMultiply128>::create<
+    xsimd::generic>(const KoColorSpace *param)
+{
+    return new KoCompositeOpGenericSC<KoRgbF32Traits, &cfMultiply<float>, KoAdditiveBlendingPolicy<KoRgbF32Traits>>(param, COMPOSITE_MULT, KoCompositeOp::categoryArithmetic());
+}
+
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpScreen32>::create<
+    xsimd::generic>(const KoColorSpace *param)
+{
+    return new KoCompositeOpGenericSC<KoBgrU8Traits, &cfScreen<quint8>, KoAdditiveBlendingPolicy<KoBgrU8Traits>>(param, COMPOSITE_SCREEN, KoCompositeOp::categoryLight());
+}
+
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpScreenU64>::create<
+    xsimd::generic>(const KoColorSpace *param)
+{
+    return new KoCompositeOpGenericSC<KoBgrU16Traits, &cfScreen<quint16>, KoAdditiveBlendingPolicy<KoBgrU16Traits>>(param, COMPOSITE_SCREEN, KoCompositeOp::categoryLight());
+}
+
+template<>
+template<>
+KoCompositeOp *
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpScreen128>::create<
+    xsimd::generic>(const KoColorSpace *param)
+{
+    return new KoCompositeOpGenericSC<KoRgbF32Traits, &cfScreen<float>, KoAdditiveBlendingPolicy<KoRgbF32Traits>>(param, COMPOSITE_SCREEN, KoCompositeOp::categoryLight());
+}
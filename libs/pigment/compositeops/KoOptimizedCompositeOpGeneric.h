@@ -0,0 +1,313 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOOPTIMIZEDCOMPOSITEOPGENERIC_H_
+#define KOOPTIMIZEDCOMPOSITEOPGENERIC_H_
+
+#include "KoCompositeOpBase.h"
+#include "KoCompositeOpRegistry.h"
+#include "KoColorSpaceMaths.h"
+#include "KoStreamedMath.h"
+
+/**
+ * Vectorized counterparts of the separable blend modes that are
+ * normally routed through KoCompositeOpGenericSC. A functor supplies
+ * the per-channel blend formula once, templated over the value type,
+ * so the same expression is instantiated both for xsimd batches and
+ * for plain floats (used in the scalar head/tail path).
+ *
+ * The functors work on *raw-scale* channel values, the same scale
+ * PixelWrapper reads them in: [0, 255] for U8, [0, 65535] for U16 and
+ * [0, 1] (unclamped) for F32. Formulas that multiply two channel
+ * values must therefore renormalize by the inverse unit value.
+ */
+
+template<typename channels_type>
+struct KoMultiplyCompositeFunctor {
+    static QString id() {
+        return COMPOSITE_MULT;
+    }
+
+    static QString category() {
+        return KoCompositeOp::categoryArithmetic();
+    }
+
+    template<typename T>
+    static ALWAYS_INLINE T composeChannels(T src, T dst) {
+        const float unitValueRec =
+            1.0f / float(KoColorSpaceMathsTraits<channels_type>::unitValue);
+        return src * dst * unitValueRec;
+    }
+};
+
+template<typename channels_type>
+struct KoScreenCompositeFunctor {
+    static QString id() {
+        return COMPOSITE_SCREEN;
+    }
+
+    static QString category() {
+        return KoCompositeOp::categoryLight();
+    }
+
+    template<typename T>
+    static ALWAYS_INLINE T composeChannels(T src, T dst) {
+        const float unitValueRec =
+            1.0f / float(KoColorSpaceMathsTraits<channels_type>::unitValue);
+        return src + dst - src * dst * unitValueRec;
+    }
+};
+
+/**
+ * The compositor implements the same math as the general branch of
+ * KoCompositeOpGenericSCFunctor::composeColorChannels for an additive
+ * blending policy:
+ *
+ *   newAlpha = dstAlpha + (1 - dstAlpha) * srcAlpha
+ *   result   = (srcAlpha * dstAlpha       * f(src, dst) +
+ *               srcAlpha * (1 - dstAlpha) * src +
+ *               dstAlpha * (1 - srcAlpha) * dst) / newAlpha
+ *
+ * The formula is branchless and degenerates to exactly the special
+ * cases the scalar implementation handles separately (fully opaque
+ * or fully transparent source/destination), so the vector path needs
+ * no per-lane branching at all.
+ */
+template<typename channels_type, typename Functor, bool alphaLocked, bool allChannelsFlag>
+struct GenericSeparableCompositor {
+    struct ParamsWrapper {
+        ParamsWrapper(const KoCompositeOp::ParameterInfo& params)
+            : channelFlags(params.channelFlags)
+        {
+        }
+        const QBitArray &channelFlags;
+    };
+
+    template<bool haveMask, bool src_aligned, typename _impl>
+    static ALWAYS_INLINE void compositeVector(const quint8 *src, quint8 *dst, const quint8 *mask, float opacity, const ParamsWrapper &oparams)
+    {
+        using float_v = typename KoStreamedMath<_impl>::float_v;
+        using float_m = typename float_v::batch_bool_type;
+
+        Q_UNUSED(oparams);
+
+        float_v src_alpha;
+        float_v src_c1;
+        float_v src_c2;
+        float_v src_c3;
+
+        PixelWrapper<channels_type, _impl> dataWrapper;
+        dataWrapper.read(src, src_c1, src_c2, src_c3, src_alpha);
+
+        const float_v opacity_norm_vec(opacity);
+        src_alpha *= opacity_norm_vec;
+
+        if (haveMask) {
+            const float_v uint8MaxRec1((float)1.0 / 255);
+            float_v mask_vec = KoStreamedMath<_impl>::fetch_mask_8(mask);
+            src_alpha *= mask_vec * uint8MaxRec1;
+        }
+
+        const float_v zeroValue(0.0f);
+        if (xsimd::all(src_alpha == zeroValue)) {
+            return;
+        }
+
+        float_v dst_alpha;
+        float_v dst_c1;
+        float_v dst_c2;
+        float_v dst_c3;
+
+        dataWrapper.read(dst, dst_c1, dst_c2, dst_c3, dst_alpha);
+
+        const float_v oneValue(1.0f);
+        const float_v new_alpha = dst_alpha + (oneValue - dst_alpha) * src_alpha;
+
+        const float_v weightBoth = src_alpha * dst_alpha;
+        const float_v weightSrc = src_alpha - weightBoth;
+        const float_v weightDst = dst_alpha - weightBoth;
+
+        /**
+         * new_alpha is zero only when both source and destination
+         * are fully transparent; keep the old (meaningless) colors
+         * there, like the scalar implementation does
+         */
+        const float_m zeroAlphaMask = (new_alpha == zeroValue);
+        float_v recip = oneValue / new_alpha;
+        recip = xsimd::set_zero(recip, zeroAlphaMask);
+
+        float_v c1 = (weightBoth * Functor::composeChannels(src_c1, dst_c1) + weightSrc * src_c1 + weightDst * dst_c1) * recip;
+        float_v c2 = (weightBoth * Functor::composeChannels(src_c2, dst_c2) + weightSrc * src_c2 + weightDst * dst_c2) * recip;
+        float_v c3 = (weightBoth * Functor::composeChannels(src_c3, dst_c3) + weightSrc * src_c3 + weightDst * dst_c3) * recip;
+
+        c1 = xsimd::select(zeroAlphaMask, dst_c1, c1);
+        c2 = xsimd::select(zeroAlphaMask, dst_c2, c2);
+        c3 = xsimd::select(zeroAlphaMask, dst_c3, c3);
+
+        dataWrapper.write(dst, c1, c2, c3, new_alpha);
+    }
+
+    template<bool haveMask, typename _impl>
+    static ALWAYS_INLINE void compositeOnePixelScalar(const quint8 *src,
+                                                      quint8 *dst,
+                                                      const quint8 *mask,
+                                                      float opacity,
+                                                      const ParamsWrapper &oparams)
+    {
+        const qint32 alpha_pos = 3;
+
+        const auto *s = reinterpret_cast<const channels_type*>(src);
+        auto *d = reinterpret_cast<channels_type*>(dst);
+
+        float srcAlpha = s[alpha_pos];
+        PixelWrapper<channels_type, _impl>::normalizeAlpha(srcAlpha);
+        srcAlpha *= opacity;
+
+        if (haveMask) {
+            const float uint8Rec1 = 1.0f / 255.0f;
+            srcAlpha *= float(*mask) * uint8Rec1;
+        }
+
+        if (srcAlpha == 0.0f) {
+            return;
+        }
+
+        float dstAlpha = d[alpha_pos];
+        PixelWrapper<channels_type, _impl>::normalizeAlpha(dstAlpha);
+
+        if (alphaLocked) {
+            if (dstAlpha != 0.0f) {
+                for (qint32 i = 0; i < 3; i++) {
+                    if (allChannelsFlag || oparams.channelFlags.at(i)) {
+                        const float result = Functor::composeChannels(float(s[i]), float(d[i]));
+                        d[i] = PixelWrapper<channels_type, _impl>::lerpMixedUintFloat(d[i], PixelWrapper<channels_type, _impl>::roundFloatToUint(result), srcAlpha);
+                    }
+                }
+            }
+            return;
+        }
+
+        const float newAlpha = dstAlpha + (1.0f - dstAlpha) * srcAlpha;
+        if (newAlpha == 0.0f) {
+            return;
+        }
+
+        const float weightBoth = srcAlpha * dstAlpha;
+        const float weightSrc = srcAlpha - weightBoth;
+        const float weightDst = dstAlpha - weightBoth;
+        const float recip = 1.0f / newAlpha;
+
+        for (qint32 i = 0; i < 3; i++) {
+            if (allChannelsFlag || oparams.channelFlags.at(i)) {
+                const float result =
+                    (weightBoth * Functor::composeChannels(float(s[i]), float(d[i])) +
+                     weightSrc * float(s[i]) +
+                     weightDst * float(d[i])) * recip;
+
+                d[i] = PixelWrapper<channels_type, _impl>::roundFloatToUint(result);
+            }
+        }
+
+        float denormalizedAlpha = newAlpha;
+        PixelWrapper<channels_type, _impl>::denormalizeAlpha(denormalizedAlpha);
+        d[alpha_pos] = PixelWrapper<channels_type, _impl>::roundFloatToUint(denormalizedAlpha);
+    }
+};
+
+/**
+ * An optimized version of the generic separable composite op for
+ * colorspaces with the alpha channel placed at the last position of
+ * the pixel: C1_C2_C3_A. The blend formula is provided by \p Functor.
+ */
+template<typename _impl, typename channels_type, typename Functor>
+class KoOptimizedCompositeOpGenericSeparable : public KoCompositeOp
+{
+    static constexpr int pixelSize = 4 * sizeof(channels_type);
+
+public:
+    KoOptimizedCompositeOpGenericSeparable(const KoColorSpace* cs)
+        : KoCompositeOp(cs, Functor::id(), Functor::category()) {}
+
+    using KoCompositeOp::composite;
+
+    void composite(const KoCompositeOp::ParameterInfo& params) const override
+    {
+        if(params.maskRowStart) {
+            composite<true>(params);
+        } else {
+            composite<false>(params);
+        }
+    }
+
+    template <bool haveMask>
+    inline void composite(const KoCompositeOp::ParameterInfo& params) const {
+        if (params.channelFlags.isEmpty() ||
+            params.channelFlags == QBitArray(4, true)) {
+
+            KoStreamedMath<_impl>::template genericComposite<haveMask, false, GenericSeparableCompositor<channels_type, Functor, false, true>, pixelSize>(params);
+        } else {
+            const bool allChannelsFlag =
+                params.channelFlags.at(0) &&
+                params.channelFlags.at(1) &&
+                params.channelFlags.at(2);
+
+            const bool alphaLocked =
+                !params.channelFlags.at(3);
+
+            if (allChannelsFlag && alphaLocked) {
+                KoStreamedMath<_impl>::template genericComposite_novector<haveMask, false, GenericSeparableCompositor<channels_type, Functor, true, true>, pixelSize>(params);
+            } else if (!allChannelsFlag && !alphaLocked) {
+                KoStreamedMath<_impl>::template genericComposite_novector<haveMask, false, GenericSeparableCompositor<channels_type, Functor, false, false>, pixelSize>(params);
+            } else /*if (!allChannelsFlag && alphaLocked) */{
+                KoStreamedMath<_impl>::template genericComposite_novector<haveMask, false, GenericSeparableCompositor<channels_type, Functor, true, false>, pixelSize>(params);
+            }
+        }
+    }
+};
+
+template<typename _impl>
+class KoOptimizedCompositeOpMultiply32 : public KoOptimizedCompositeOpGenericSeparable<_impl, quint8, KoMultiplyCompositeFunctor<quint8>>
+{
+public:
+    using KoOptimizedCompositeOpGenericSeparable<_impl, quint8, KoMultiplyCompositeFunctor<quint8>>::KoOptimizedCompositeOpGenericSeparable;
+};
+
+template<typename _impl>
+class KoOptimizedCompositeOpMultiplyU64 : public KoOptimizedCompositeOpGenericSeparable<_impl, quint16, KoMultiplyCompositeFunctor<quint16>>
+{
+public:
+    using KoOptimizedCompositeOpGenericSeparable<_impl, quint16, KoMultiplyCompositeFunctor<quint16>>::KoOptimizedCompositeOpGenericSeparable;
+};
+
+template<typename _impl>
+class KoOptimizedCompositeOpMultiply128 : public KoOptimizedCompositeOpGenericSeparable<_impl, float, KoMultiplyCompositeFunctor<float>>
+{
+public:
+    using KoOptimizedCompositeOpGenericSeparable<_impl, float, KoMultiplyCompositeFunctor<float>>::KoOptimizedCompositeOpGenericSeparable;
+};
+
+template<typename _impl>
+class KoOptimizedCompositeOpScreen32 : public KoOptimizedCompositeOpGenericSeparable<_impl, quint8, KoScreenCompositeFunctor<quint8>>
+{
+public:
+    using KoOptimizedCompositeOpGenericSeparable<_impl, quint8, KoScreenCompositeFunctor<quint8>>::KoOptimizedCompositeOpGenericSeparable;
+};
+
+template<typename _impl>
+class KoOptimizedCompositeOpScreenU64 : public KoOptimizedCompositeOpGenericSeparable<_impl, quint16, KoScreenCompositeFunctor<quint16>>
+{
+public:
+    using KoOptimizedCompositeOpGenericSeparable<_impl, quint16, KoScreenCompositeFunctor<quint16>>::KoOptimizedCompositeOpGenericSeparable;
+};
+
+template<typename _impl>
+class KoOptimizedCompositeOpScreen128 : public KoOptimizedCompositeOpGenericSeparable<_impl, float, KoScreenCompositeFunctor<float>>
+{
+public:
+    using KoOptimizedCompositeOpGenericSeparable<_impl, float, KoScreenCompositeFunctor<float>>::KoOptimizedCompositeOpGenericSeparable;
+};
+
+#endif // KOOPTIMIZEDCOMPOSITEOPGENERIC_H_
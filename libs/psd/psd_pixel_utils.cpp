@@ -9,6 +9,9 @@
 
 #include <QIODevice>
 #include <QMap>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThreadPool>
 #include <QtEndian>
 #include <QtGlobal>
 
@@ -16,6 +19,7 @@
 #include <KoColorSpaceMaths.h>
 #include <KoColorSpaceTraits.h>
 #include <colorspaces/KoAlphaColorSpace.h>
+#include <kis_algebra_2d.h>
 #include <kis_global.h>
 #include <kis_iterator_ng.h>
 
@@ -298,7 +302,7 @@ void readAlphaMaskPixelCommon(int channelSize, const QMap<quint16, QByteArray> &
     }
 }
 
-QMap<quint16, QByteArray> fetchChannelsBytes(QIODevice &io, QVector<ChannelInfo *> channelInfoRecords, int row, int width, int channelSize, bool processMasks)
+QMap<quint16, QByteArray> fetchCompressedChannelsBytes(QIODevice &io, QVector<ChannelInfo *> channelInfoRecords, int row, int width, int channelSize, bool processMasks)
 {
     const int uncompressedLength = width * channelSize;
 
@@ -316,14 +320,12 @@ QMap<quint16, QByteArray> fetchChannelsBytes(QIODevice &io, QVector<ChannelInfo
             channelInfo->channelOffset += uncompressedLength;
         } else if (channelInfo->compressionType == psd_compression_type::RLE) {
             int rleLength = channelInfo->rleRowLengths[row];
-            QByteArray compressedBytes = io.read(rleLength);
-            QByteArray uncompressedBytes = Compression::uncompress(uncompressedLength, compressedBytes, channelInfo->compressionType);
-            channelBytes.insert(channelInfo->channelId, uncompressedBytes);
+            channelBytes.insert(channelInfo->channelId, io.read(rleLength));
             channelInfo->channelOffset += rleLength;
         } else {
             QString error = QString("Unsupported Compression mode: %1")
                                 .arg(static_cast<std::uint16_t>(channelInfo->compressionType));
-            dbgFile << "ERROR: fetchChannelsBytes:" << error;
+            dbgFile << "ERROR: fetchCompressedChannelsBytes:" << error;
             throw KisAslReaderUtils::ASLParseException(error);
         }
     }
@@ -331,8 +333,88 @@ QMap<quint16, QByteArray> fetchChannelsBytes(QIODevice &io, QVector<ChannelInfo
     return channelBytes;
 }
 
+QMap<quint16, QByteArray> decompressChannelsBytes(const QMap<quint16, QByteArray> &compressedBytes,
+                                                  const QMap<quint16, psd_compression_type> &compressionTypes,
+                                                  int uncompressedLength)
+{
+    QMap<quint16, QByteArray> channelBytes;
+
+    auto it = compressedBytes.constBegin();
+    for (; it != compressedBytes.constEnd(); ++it) {
+        if (compressionTypes[it.key()] == psd_compression_type::RLE) {
+            channelBytes.insert(it.key(), Compression::uncompress(uncompressedLength, it.value(), psd_compression_type::RLE));
+        } else {
+            channelBytes.insert(it.key(), it.value());
+        }
+    }
+
+    return channelBytes;
+}
+
 using PixelFunc = std::function<void(int, const QMap<quint16, QByteArray> &, int, quint8 *)>;
 
+/**
+ * Decompresses and converts one band of rows of a layer. The bands are
+ * aligned to the tile grid of the destination device, so concurrent
+ * tasks never write-access the same tiles.
+ */
+class DecodeBandTask : public QRunnable
+{
+public:
+    DecodeBandTask(KisPaintDeviceSP dev,
+                   const QRect &bandRect,
+                   const QVector<QMap<quint16, QByteArray>> *compressedRows,
+                   int firstRow,
+                   const QMap<quint16, psd_compression_type> *compressionTypes,
+                   int channelSize,
+                   PixelFunc pixelFunc,
+                   QSemaphore *doneSemaphore)
+        : m_dev(dev),
+          m_bandRect(bandRect),
+          m_compressedRows(compressedRows),
+          m_firstRow(firstRow),
+          m_compressionTypes(compressionTypes),
+          m_channelSize(channelSize),
+          m_pixelFunc(pixelFunc),
+          m_doneSemaphore(doneSemaphore)
+    {
+        setAutoDelete(false);
+    }
+
+    void run() override {
+        const int uncompressedLength = m_bandRect.width() * m_channelSize;
+
+        KisHLineIteratorSP it = m_dev->createHLineIteratorNG(m_bandRect.left(), m_bandRect.top(), m_bandRect.width());
+        for (int i = 0; i < m_bandRect.height(); i++) {
+            const QMap<quint16, QByteArray> channelBytes =
+                decompressChannelsBytes(m_compressedRows->at(m_firstRow + i), *m_compressionTypes, uncompressedLength);
+
+            for (int col = 0; col < m_bandRect.width(); col++) {
+                m_pixelFunc(m_channelSize, channelBytes, col, it->rawData());
+                it->nextPixel();
+            }
+
+            /// don't write-access the row right after the
+            /// the end of the read area
+            if (i < m_bandRect.height() - 1) {
+                it->nextRow();
+            }
+        }
+
+        m_doneSemaphore->release();
+    }
+
+private:
+    KisPaintDeviceSP m_dev;
+    QRect m_bandRect;
+    const QVector<QMap<quint16, QByteArray>> *m_compressedRows;
+    int m_firstRow;
+    const QMap<quint16, psd_compression_type> *m_compressionTypes;
+    int m_channelSize;
+    PixelFunc m_pixelFunc;
+    QSemaphore *m_doneSemaphore;
+};
+
 void readCommon(KisPaintDeviceSP dev,
                 QIODevice &io,
                 const QRect &layerRect,
@@ -383,23 +465,55 @@ void readCommon(KisPaintDeviceSP dev,
         }
 
     } else {
-        KisHLineIteratorSP it = dev->createHLineIteratorNG(layerRect.left(), layerRect.top(), layerRect.width());
-        for (int i = 0; i < layerRect.height(); i++) {
-            QMap<quint16, QByteArray> channelBytes;
+        /**
+         * RLE rows are stored and decoded independently, so only the
+         * file access has to stay sequential: one pass collects the
+         * compressed rows, then the thread pool decompresses and
+         * converts them in bands. On layer-heavy files the
+         * decompression and pixel conversion dominate loading time.
+         */
+        const int height = layerRect.height();
+
+        QMap<quint16, psd_compression_type> compressionTypes;
+        Q_FOREACH (ChannelInfo *info, infoRecords) {
+            if (!processMasks && info->channelId < -1)
+                continue;
+            compressionTypes.insert(info->channelId, info->compressionType);
+        }
 
-            channelBytes = fetchChannelsBytes(io, infoRecords, i, layerRect.width(), channelSize, processMasks);
+        QVector<QMap<quint16, QByteArray>> compressedRows;
+        compressedRows.reserve(height);
 
-            for (int col = 0; col < layerRect.width(); col++) {
-                pixelFunc(channelSize, channelBytes, col, it->rawData());
-                it->nextPixel();
-            }
+        for (int i = 0; i < height; i++) {
+            compressedRows.append(fetchCompressedChannelsBytes(io, infoRecords, i, layerRect.width(), channelSize, processMasks));
+        }
 
-            /// don't write-access the row right after the
-            /// the end of the read area
-            if (i < layerRect.height() - 1) {
-                it->nextRow();
+        // matches the tile height of the destination device
+        const int bandHeight = 64;
+
+        QSemaphore doneSemaphore;
+        QVector<DecodeBandTask *> tasks;
+
+        int row = 0;
+        while (row < height) {
+            const int absY = layerRect.top() + row;
+            const int nextTileBoundary = (KisAlgebra2D::divideFloor(absY, bandHeight) + 1) * bandHeight;
+            const int rows = qMin(height - row, nextTileBoundary - absY);
+
+            const QRect bandRect(layerRect.left(), absY, layerRect.width(), rows);
+
+            DecodeBandTask *task = new DecodeBandTask(dev, bandRect, &compressedRows, row, &compressionTypes, channelSize, pixelFunc, &doneSemaphore);
+            tasks << task;
+
+            if (!QThreadPool::globalInstance()->tryStart(task)) {
+                task->run();
             }
+
+            row += rows;
         }
+
+        doneSemaphore.acquire(tasks.size());
+        qDeleteAll(tasks);
     }
 }
 
@@ -221,6 +221,25 @@ QImage KisBundleStorage::thumbnail() const
     return d->bundle->image();
 }
 
+QDateTime KisBundleStorage::timestamp()
+{
+    QDateTime timestamp = KisStoragePlugin::timestamp();
+
+    // Modified versions of bundled resources are stored in a sidecar
+    // folder next to the bundle, so they do not touch the modification
+    // time of the bundle file itself.
+    QDirIterator it(location() + "_modified", QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        const QDateTime fileTimestamp = it.fileInfo().lastModified();
+        if (fileTimestamp > timestamp) {
+            timestamp = fileTimestamp;
+        }
+    }
+
+    return timestamp;
+}
+
 QStringList KisBundleStorage::metaDataKeys() const
 {
 
@@ -29,6 +29,7 @@ public:
     QSharedPointer<KisResourceStorage::ResourceIterator> resources(const QString &resourceType) override;
     QSharedPointer<KisResourceStorage::TagIterator> tags(const QString &resourceType) override;
     QImage thumbnail() const override;
+    QDateTime timestamp() override;
     QStringList metaDataKeys() const override;
     QVariant metaData(const QString &key) const override;
 
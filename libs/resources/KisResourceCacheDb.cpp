@@ -60,6 +60,25 @@ QString changeToEmptyIfNull(QString s)
     return s.isNull() ? QString("") : s;
 }
 
+// Tune the connection for the thousands of small statements a bundle
+// import issues. WAL mode turns every commit into a sequential append,
+// and relaxed fsync is safe here: the cache can always be rebuilt from
+// the storages themselves.
+void applyConnectionSettings(QSqlDatabase &db)
+{
+    QSqlQuery q(db);
+
+    if (!q.exec("PRAGMA journal_mode = WAL;")) {
+        qWarning() << "Could not switch the resource cache database to WAL mode" << q.lastError();
+    }
+    if (!q.exec("PRAGMA synchronous = NORMAL;")) {
+        qWarning() << "Could not relax the resource cache database sync mode" << q.lastError();
+    }
+    if (!q.exec("PRAGMA temp_store = MEMORY;")) {
+        qWarning() << "Could not move the resource cache temp store to memory" << q.lastError();
+    }
+}
+
 bool updateSchemaVersion()
 {
     QFile f(":/fill_version_information.sql");
@@ -114,6 +133,8 @@ QSqlError createDatabase(const QString &location)
         return db.lastError();
     }
 
+    applyConnectionSettings(db);
+
     // will be filled correctly later
     QVersionNumber oldSchemaVersionNumber;
     QVersionNumber newSchemaVersionNumber = QVersionNumber::fromString(KisResourceCacheDb::databaseVersion);
@@ -259,6 +280,7 @@ QSqlError createDatabase(const QString &location)
                     db.close();
                     QFile::remove(location + "/" + KisResourceCacheDb::resourceCacheDbFilename);
                     db.open();
+                    applyConnectionSettings(db);
                 }
             }
 
@@ -443,19 +465,26 @@ int KisResourceCacheDb::resourceIdForResource(const QString &resourceFileName, c
 {
     //qDebug() << "resourceIdForResource" << resourceName << resourceFileName << resourceType << storageLocation;
 
-    QSqlQuery q;
+    // This lookup runs once per resource version during storage
+    // synchronization, so the statements are prepared only once and
+    // reused for the rest of the session.
+    static QSqlQuery q;
+    static bool prepared = false;
 
-    if (!q.prepare("SELECT resources.id\n"
-                   "FROM   resources\n"
-                   ",      resource_types\n"
-                   ",      storages\n"
-                   "WHERE  resources.resource_type_id = resource_types.id\n"
-                   "AND    storages.id = resources.storage_id\n"
-                   "AND    storages.location = :storage_location\n"
-                   "AND    resource_types.name = :resource_type\n"
-                   "AND    resources.filename = :filename\n")) {
-        qWarning() << "Could not read and prepare resourceIdForResource" << q.lastError();
-        return -1;
+    if (!prepared) {
+        if (!q.prepare("SELECT resources.id\n"
+                       "FROM   resources\n"
+                       ",      resource_types\n"
+                       ",      storages\n"
+                       "WHERE  resources.resource_type_id = resource_types.id\n"
+                       "AND    storages.id = resources.storage_id\n"
+                       "AND    storages.location = :storage_location\n"
+                       "AND    resource_types.name = :resource_type\n"
+                       "AND    resources.filename = :filename\n")) {
+            qWarning() << "Could not read and prepare resourceIdForResource" << q.lastError();
+            return -1;
+        }
+        prepared = true;
     }
 
     q.bindValue(":filename", resourceFileName);
@@ -468,38 +497,50 @@ int KisResourceCacheDb::resourceIdForResource(const QString &resourceFileName, c
     }
 
     if (q.first()) {
-        return q.value(0).toInt();
+        const int id = q.value(0).toInt();
+        q.finish();
+        return id;
     }
+    q.finish();
 
     // couldn't be found in the `resources` table, but can still be in versioned_resources
 
-    if (!q.prepare("SELECT versioned_resources.resource_id\n"
-                   "FROM   resources\n"
-                   ",      resource_types\n"
-                   ",      versioned_resources\n"
-                   ",      storages\n"
-                   "WHERE  resources.resource_type_id = resource_types.id\n"    // join resources and resource_types by resource id
-                   "AND    versioned_resources.resource_id = resources.id\n"    // join versioned_resources and resources by resource id
-                   "AND    storages.id = versioned_resources.storage_id\n"      // join storages and versioned_resources by storage id
-                   "AND    storages.location = :storage_location\n"             // storage location must be the same as asked for
-                   "AND    resource_types.name = :resource_type\n"              // resource type must be the same as asked for
-                   "AND    versioned_resources.filename = :filename\n")) {      // filename must be the same as asked for
-        qWarning() << "Could not read and prepare resourceIdForResource (in versioned resources)" << q.lastError();
+    static QSqlQuery versionedQ;
+    static bool versionedPrepared = false;
+
+    if (!versionedPrepared) {
+        if (!versionedQ.prepare("SELECT versioned_resources.resource_id\n"
+                                "FROM   resources\n"
+                                ",      resource_types\n"
+                                ",      versioned_resources\n"
+                                ",      storages\n"
+                                "WHERE  resources.resource_type_id = resource_types.id\n"    // join resources and resource_types by resource id
+                                "AND    versioned_resources.resource_id = resources.id\n"    // join versioned_resources and resources by resource id
+                                "AND    storages.id = versioned_resources.storage_id\n"      // join storages and versioned_resources by storage id
+                                "AND    storages.location = :storage_location\n"             // storage location must be the same as asked for
+                                "AND    resource_types.name = :resource_type\n"              // resource type must be the same as asked for
+                                "AND    versioned_resources.filename = :filename\n")) {      // filename must be the same as asked for
+            qWarning() << "Could not read and prepare resourceIdForResource (in versioned resources)" << versionedQ.lastError();
+            return -1;
+        }
+        versionedPrepared = true;
+    }
+
+    versionedQ.bindValue(":filename", resourceFileName);
+    versionedQ.bindValue(":resource_type", resourceType);
+    versionedQ.bindValue(":storage_location", changeToEmptyIfNull(storageLocation));
+
+    if (!versionedQ.exec()) {
+        qWarning() << "Could not query resourceIdForResource (in versioned resources)" << versionedQ.boundValues() << versionedQ.lastError();
         return -1;
     }
 
-    q.bindValue(":filename", resourceFileName);
-    q.bindValue(":resource_type", resourceType);
-    q.bindValue(":storage_location", changeToEmptyIfNull(storageLocation));
-
-    if (!q.exec()) {
-        qWarning() << "Could not query resourceIdForResource (in versioned resources)" << q.boundValues() << q.lastError();
-        return -1;
-    }
-
-    if (q.first()) {
-        return q.value(0).toInt();
+    if (versionedQ.first()) {
+        const int id = versionedQ.value(0).toInt();
+        versionedQ.finish();
+        return id;
     }
+    versionedQ.finish();
 
     // commenting out, because otherwise it spams the console on every new resource in the local resources folder
     // qWarning() << "Could not find resource" << resourceName << resourceFileName << resourceType << storageLocation;
@@ -569,23 +610,30 @@ bool KisResourceCacheDb::addResourceVersionImpl(int resourceId, QDateTime timest
 
     Q_ASSERT(resource->version() >= 0);
 
-    QSqlQuery q;
-    r = q.prepare("INSERT INTO versioned_resources \n"
-                  "(resource_id, storage_id, version, filename, timestamp, md5sum)\n"
-                  "VALUES\n"
-                  "( :resource_id\n"
-                  ", (SELECT id \n"
-                  "   FROM   storages \n"
-                  "   WHERE  location = :storage_location)\n"
-                  ", :version\n"
-                  ", :filename\n"
-                  ", :timestamp\n"
-                  ", :md5sum\n"
-                  ");");
+    // Reuse the prepared statement: this insert runs once per resource
+    // version when a whole storage is imported.
+    static QSqlQuery q;
+    static bool prepared = false;
 
-    if (!r) {
-        qWarning() << "Could not prepare addResourceVersion statement" << q.lastError();
-        return r;
+    if (!prepared) {
+        r = q.prepare("INSERT INTO versioned_resources \n"
+                      "(resource_id, storage_id, version, filename, timestamp, md5sum)\n"
+                      "VALUES\n"
+                      "( :resource_id\n"
+                      ", (SELECT id \n"
+                      "   FROM   storages \n"
+                      "   WHERE  location = :storage_location)\n"
+                      ", :version\n"
+                      ", :filename\n"
+                      ", :timestamp\n"
+                      ", :md5sum\n"
+                      ");");
+
+        if (!r) {
+            qWarning() << "Could not prepare addResourceVersion statement" << q.lastError();
+            return r;
+        }
+        prepared = true;
     }
 
     q.bindValue(":resource_id", resourceId);
@@ -1733,6 +1781,26 @@ bool KisResourceCacheDb::synchronizeStorage(KisResourceStorageSP storage)
 
     storage->setStorageId(q.value("id").toInt());
 
+    /// For single-archive storages the modification time covers every
+    /// resource inside, so when it hasn't changed since the last run we
+    /// can skip the per-resource comparison entirely. Folder storages
+    /// are excluded: the folder's own mtime does not change when a
+    /// nested file is edited.
+
+    const bool timestampCoversContents =
+            storage->type() == KisResourceStorage::StorageType::Bundle ||
+            storage->type() == KisResourceStorage::StorageType::AdobeBrushLibrary ||
+            storage->type() == KisResourceStorage::StorageType::AdobeStyleLibrary;
+
+    // we use the same lower precision as the storages table
+    const qint64 storageTimestamp = storage->timestamp().toSecsSinceEpoch();
+
+    if (timestampCoversContents && q.value("timestamp").toLongLong() == storageTimestamp) {
+        QSqlDatabase::database().commit();
+        debugResource << "Storage" << storage->location() << "is unchanged, skipping synchronization";
+        return true;
+    }
+
     /// We compare resource versions one-by-one because the storage may have multiple
     /// versions of them
 
@@ -1960,6 +2028,24 @@ bool KisResourceCacheDb::synchronizeStorage(KisResourceStorageSP storage)
         }
     }
 
+    /// Remember the timestamp the storage had when we started scanning
+    /// it, so an unchanged storage can be skipped on the next run. Any
+    /// modification made while we were scanning bumps the file's mtime
+    /// past this value and forces a resync.
+    if (success) {
+        QSqlQuery updateTimestamp;
+        if (!updateTimestamp.prepare("UPDATE storages\n"
+                                     "SET    timestamp = :timestamp\n"
+                                     "WHERE  id = :id")) {
+            qWarning() << "Could not prepare update storage timestamp statement" << updateTimestamp.lastError();
+        }
+        updateTimestamp.bindValue(":timestamp", storageTimestamp);
+        updateTimestamp.bindValue(":id", storage->storageId());
+        if (!updateTimestamp.exec()) {
+            qWarning() << "Could not execute update storage timestamp statement" << updateTimestamp.boundValues() << updateTimestamp.lastError();
+        }
+    }
+
     QSqlDatabase::database().commit();
     debugResource << "Synchronizing the storages took" << t.elapsed() << "milliseconds for" << storage->location();
 
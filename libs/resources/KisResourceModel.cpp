@@ -23,6 +23,7 @@
 #include <KisGlobalResourcesInterface.h>
 
 #include "KisResourceQueryMapper.h"
+#include "KisResourceThumbnailCache.h"
 
 struct KisAllResourcesModel::Private {
     QSqlQuery resourcesQuery;
@@ -80,6 +81,10 @@ KisAllResourcesModel::KisAllResourcesModel(const QString &resourceType, QObject
     d->resourcesQuery.bindValue(":resource_type", d->resourceType);
 
     resetQuery();
+
+    // warm up the thumbnail cache in the background, so the choosers
+    // don't have to decode the thumbnails row by row while scrolling
+    KisResourceThumbnailCache::instance()->prefetchResourceType(d->resourceType);
 }
 
 KisAllResourcesModel::~KisAllResourcesModel()
@@ -6,13 +6,20 @@
 
 #include "KisResourceThumbnailCache.h"
 
+#include <QBuffer>
 #include <QMap>
 #include <QModelIndex>
+#include <QRunnable>
+#include <QSet>
 #include <QSize>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QThreadPool>
 
 #include <KisResourceLocator.h>
 #include <KisResourceModel.h>
 
+#include <kis_debug.h>
 #include <kis_global.h>
 
 Q_GLOBAL_STATIC(KisResourceThumbnailCache, s_instance);
@@ -45,11 +52,46 @@ namespace
 {
 using ResourceKey = QPair<QString, QString>;
 using ThumbnailCacheT = QMap<ImageScalingParameters, QImage>;
+
+/**
+ * Decodes one thumbnail PNG on a pool thread and delivers the result
+ * back to the cache on the gui thread via a queued invocation.
+ */
+class ThumbnailDecodeTask : public QRunnable
+{
+public:
+    ThumbnailDecodeTask(KisResourceThumbnailCache *cache, const ResourceKey &key, const QByteArray &data)
+        : m_cache(cache)
+        , m_key(key)
+        , m_data(data)
+    {
+    }
+
+    void run() override {
+        QImage image;
+        QBuffer buf(&m_data);
+        buf.open(QBuffer::ReadOnly);
+        image.load(&buf, "PNG");
+
+        if (!image.isNull()) {
+            QMetaObject::invokeMethod(m_cache, "insertPrefetchedImage", Qt::QueuedConnection,
+                                      Q_ARG(QString, m_key.first),
+                                      Q_ARG(QString, m_key.second),
+                                      Q_ARG(QImage, image));
+        }
+    }
+
+private:
+    KisResourceThumbnailCache *m_cache;
+    ResourceKey m_key;
+    QByteArray m_data;
+};
 } // namespace
 
 struct KisResourceThumbnailCache::Private {
     QMap<ResourceKey, ThumbnailCacheT> scaledThumbnailCache;
     QMap<ResourceKey, QImage> originalImageCache;
+    QSet<QString> prefetchedResourceTypes;
 
     QImage getExactMatch(const ResourceKey &key, ImageScalingParameters param) const;
     QImage getOriginal(const ResourceKey &key) const;
@@ -164,6 +206,69 @@ void KisResourceThumbnailCache::remove(const QPair<QString, QString> &key)
     }
 }
 
+void KisResourceThumbnailCache::prefetchResourceType(const QString &resourceType)
+{
+    if (m_d->prefetchedResourceTypes.contains(resourceType)) {
+        return;
+    }
+    m_d->prefetchedResourceTypes.insert(resourceType);
+
+    QSqlQuery q;
+    if (!q.prepare("SELECT storages.location\n"
+                   ",      resources.filename\n"
+                   ",      resources.thumbnail\n"
+                   "FROM   resources\n"
+                   ",      resource_types\n"
+                   ",      storages\n"
+                   "WHERE  resources.resource_type_id = resource_types.id\n"
+                   "AND    resources.storage_id = storages.id\n"
+                   "AND    resource_types.name = :resource_type")) {
+        qWarning() << "Could not prepare thumbnail prefetch query" << q.lastError();
+        return;
+    }
+
+    q.bindValue(":resource_type", resourceType);
+
+    if (!q.exec()) {
+        qWarning() << "Could not execute thumbnail prefetch query" << q.boundValues() << q.lastError();
+        return;
+    }
+
+    while (q.next()) {
+        const QString storageLocation =
+            KisResourceLocator::instance()->makeStorageLocationAbsolute(q.value(0).toString());
+        const QString filename = q.value(1).toString();
+
+        const ResourceKey key = m_d->key(storageLocation, resourceType, filename);
+        if (m_d->containsOriginal(key)) {
+            continue;
+        }
+
+        const QByteArray data = q.value(2).toByteArray();
+        if (data.isEmpty()) {
+            continue;
+        }
+
+        // the tasks only touch their private copy of the png data, the
+        // cache itself is updated on the gui thread in
+        // insertPrefetchedImage()
+        QThreadPool::globalInstance()->start(new ThumbnailDecodeTask(this, key, data));
+    }
+}
+
+void KisResourceThumbnailCache::insertPrefetchedImage(const QString &storageLocation, const QString &resourceTypeAndFilename, const QImage &image)
+{
+    const ResourceKey key = qMakePair(storageLocation, resourceTypeAndFilename);
+
+    // the gui thread may have decoded the thumbnail on demand while the
+    // task was still queued
+    if (m_d->containsOriginal(key)) {
+        return;
+    }
+
+    m_d->insertOriginal(key, image);
+}
+
 QImage KisResourceThumbnailCache::getImage(const QModelIndex &index,
                                            const QSize size,
                                            Qt::AspectRatioMode aspectMode,
@@ -8,14 +8,16 @@
 #define __KISRESOURCETHUMBNAILCACHE_H_
 
 #include <QImage>
+#include <QObject>
 #include <QScopedPointer>
 
 #include "kritaresources_export.h"
 
 class QModelIndex;
 
-class KRITARESOURCES_EXPORT KisResourceThumbnailCache
+class KRITARESOURCES_EXPORT KisResourceThumbnailCache : public QObject
 {
+    Q_OBJECT
 public:
     KisResourceThumbnailCache();
     ~KisResourceThumbnailCache();
@@ -27,6 +29,18 @@ public:
                     Qt::AspectRatioMode aspectMode = Qt::IgnoreAspectRatio,
                     Qt::TransformationMode transformMode = Qt::FastTransformation);
 
+    /**
+     * Decode the thumbnails of all resources of \p resourceType on the
+     * thread pool and feed them into the cache, so the views don't have
+     * to decode them one by one on the gui thread during the first
+     * scroll through a chooser. Every resource type is prefetched only
+     * once; subsequent calls are no-ops.
+     */
+    void prefetchResourceType(const QString &resourceType);
+
+private Q_SLOTS:
+    void insertPrefetchedImage(const QString &storageLocation, const QString &resourceTypeAndFilename, const QImage &image);
+
 private:
     friend class KisResourceQueryMapper;
     friend class KisResourceLocator;
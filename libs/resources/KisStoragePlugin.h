@@ -50,7 +50,11 @@ public:
     virtual QStringList metaDataKeys() const { return QStringList(); }
     virtual QVariant metaData(const QString &key) const { Q_UNUSED(key); return QString(); }
 
-    QDateTime timestamp();
+    /// The last modification time of the storage as a whole. The
+    /// default implementation returns the modification time of the
+    /// storage's file or folder; subclasses should reimplement this
+    /// if resources can change without touching that file itself.
+    virtual QDateTime timestamp();
 
     virtual bool isValid() const;
 
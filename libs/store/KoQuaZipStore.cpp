@@ -19,11 +19,14 @@
 #include <QTextCodec>
 #include <QByteArray>
 #include <QBuffer>
+#include <QFile>
 
 #include <KConfig>
 #include <KSharedConfig>
 #include <KConfigGroup>
 
+#include <limits>
+
 struct KoQuaZipStore::Private {
 
     Private() {}
@@ -37,6 +40,12 @@ struct KoQuaZipStore::Private {
     bool usingSaveFile {false};
     QByteArray cache;
     QBuffer buffer;
+
+    // read mode only: the archive file mapped into memory, see the
+    // file-name constructor
+    QFile *mappedFile {0};
+    QByteArray mappedView;
+    QBuffer *mappedBuffer {0};
 };
 
 
@@ -46,7 +55,42 @@ KoQuaZipStore::KoQuaZipStore(const QString &_filename, KoStore::Mode _mode, cons
 {
     Q_D(KoStore);
     d->localFileName = _filename;
-    dd->archive = new QuaZip(_filename);
+
+    /**
+     * In Read mode the whole archive is mapped into memory and QuaZip
+     * reads from the mapping, so decompressing an entry pulls its
+     * input straight from the page cache instead of going through
+     * buffered file reads -- document loading used to spend a
+     * noticeable share of its time in those store-layer copies.
+     * QByteArray limits the view to 2 GiB; larger archives (and a
+     * failed map()) fall back to plain file access.
+     */
+    if (_mode == Read) {
+        dd->mappedFile = new QFile(_filename);
+
+        uchar *mappedData = 0;
+        if (dd->mappedFile->open(QIODevice::ReadOnly) &&
+            dd->mappedFile->size() > 0 &&
+            dd->mappedFile->size() < std::numeric_limits<int>::max()) {
+
+            mappedData = dd->mappedFile->map(0, dd->mappedFile->size());
+        }
+
+        if (mappedData) {
+            dd->mappedView = QByteArray::fromRawData(reinterpret_cast<const char*>(mappedData), dd->mappedFile->size());
+            dd->mappedBuffer = new QBuffer();
+            dd->mappedBuffer->setBuffer(&dd->mappedView);
+            dd->archive = new QuaZip(dd->mappedBuffer);
+        } else {
+            delete dd->mappedFile;
+            dd->mappedFile = 0;
+        }
+    }
+
+    if (!dd->archive) {
+        dd->archive = new QuaZip(_filename);
+    }
+
     init(appIdentification);
 
 }
@@ -76,6 +120,10 @@ KoQuaZipStore::~KoQuaZipStore()
     if (dd->currentFile) {
         delete dd->currentFile;
     }
+
+    // the mapped view must outlive the archive reading from it
+    delete dd->mappedBuffer;
+    delete dd->mappedFile;
 }
 
 void KoQuaZipStore::setCompressionEnabled(bool enabled)
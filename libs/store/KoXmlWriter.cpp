@@ -14,7 +14,11 @@
 #include "../global/kis_dom_utils.h"
 
 static const int s_indentBufferLength = 100;
-static const int s_escapeBufferLen = 10000;
+// Size of the internal write buffer. Saving a .kra maindoc with
+// thousands of nodes and keyframes produces hundreds of thousands of
+// tiny tokens; batching them into chunks of this size keeps the
+// QIODevice (and the syscalls behind it) out of the profile.
+static const int s_outputBufferLength = 65536;
 
 class Q_DECL_HIDDEN KoXmlWriter::Private
 {
@@ -26,7 +30,7 @@ public:
 
     ~Private() {
         delete[] indentBuffer;
-        delete[] escapeBuffer;
+        delete[] outputBuffer;
         //TODO: look at if we must delete "dev". For me we must delete it otherwise we will leak it
     }
 
@@ -36,7 +40,8 @@ public:
 
     char* indentBuffer; // maybe make it static, but then it needs a K_GLOBAL_STATIC
     // and would eat 1K all the time... Maybe refcount it :)
-    char* escapeBuffer; // can't really be static if we want to be thread-safe
+    char* outputBuffer; // batches the many tiny tokens into large device writes
+    int outputBufferPos {0};
 };
 
 KoXmlWriter::KoXmlWriter(QIODevice* dev, int indentLevel)
@@ -46,7 +51,7 @@ KoXmlWriter::KoXmlWriter(QIODevice* dev, int indentLevel)
     memset(d->indentBuffer, ' ', s_indentBufferLength);
     *d->indentBuffer = '\n'; // write newline before indentation, in one go
 
-    d->escapeBuffer = new char[s_escapeBufferLen];
+    d->outputBuffer = new char[s_outputBufferLength];
     if (!d->dev->isOpen())
         d->dev->open(QIODevice::WriteOnly);
 
@@ -54,6 +59,7 @@ KoXmlWriter::KoXmlWriter(QIODevice* dev, int indentLevel)
 
 KoXmlWriter::~KoXmlWriter()
 {
+    flush();
     delete d;
 }
 
@@ -80,6 +86,16 @@ void KoXmlWriter::endDocument()
     // just to do exactly like QDom does (newline at end of file).
     writeChar('\n');
     Q_ASSERT(d->tags.isEmpty());
+    flush();
+}
+
+// TODO check return value!!!
+void KoXmlWriter::flush()
+{
+    if (d->outputBufferPos > 0) {
+        d->dev->write(d->outputBuffer, d->outputBufferPos);
+        d->outputBufferPos = 0;
+    }
 }
 
 // returns the value of indentInside of the parent
@@ -146,8 +162,8 @@ void KoXmlWriter::addCompleteElement(QIODevice* indev)
     while (!indev->atEnd()) {
         buffer = indev->readLine();
 
-        d->dev->write(indentBuf);
-        d->dev->write(buffer);
+        writeBytes(indentBuf.constData(), indentBuf.size());
+        writeBytes(buffer.constData(), buffer.size());
     }
 
     if (!wasOpen) {
@@ -180,33 +196,22 @@ void KoXmlWriter::endElement()
 
 void KoXmlWriter::addTextNode(const QByteArray& cstr)
 {
-    // Same as the const char* version below, but here we know the size
     prepareForTextNode();
-    char* escaped = escapeForXML(cstr.constData(), cstr.size());
-    writeCString(escaped);
-    if (escaped != d->escapeBuffer)
-        delete[] escaped;
+    writeEscaped(cstr.constData());
 }
 
 void KoXmlWriter::addTextNode(const char* cstr)
 {
     prepareForTextNode();
-    char* escaped = escapeForXML(cstr, -1);
-    writeCString(escaped);
-    if (escaped != d->escapeBuffer)
-        delete[] escaped;
+    writeEscaped(cstr);
 }
 
 void KoXmlWriter::addAttribute(const char* attrName, const QByteArray& value)
 {
-    // Same as the const char* one, but here we know the size
     writeChar(' ');
     writeCString(attrName);
     writeCString("=\"");
-    char* escaped = escapeForXML(value.constData(), value.size());
-    writeCString(escaped);
-    if (escaped != d->escapeBuffer)
-        delete[] escaped;
+    writeEscaped(value.constData());
     writeChar('"');
 }
 
@@ -215,10 +220,7 @@ void KoXmlWriter::addAttribute(const char* attrName, const char* value)
     writeChar(' ');
     writeCString(attrName);
     writeCString("=\"");
-    char* escaped = escapeForXML(value, -1);
-    writeCString(escaped);
-    if (escaped != d->escapeBuffer)
-        delete[] escaped;
+    writeEscaped(value);
     writeChar('"');
 }
 
@@ -235,82 +237,55 @@ void KoXmlWriter::addAttribute(const char* attrName, float value)
 void KoXmlWriter::writeIndent()
 {
     // +1 because of the leading '\n'
-    d->dev->write(d->indentBuffer, qMin(d->tags.size() + d->baseIndentLevel + 1,
-                                        s_indentBufferLength));
+    writeBytes(d->indentBuffer, qMin(d->tags.size() + d->baseIndentLevel + 1,
+                                     s_indentBufferLength));
 }
 
 
-// In case of a reallocation (ret value != d->buffer), the caller owns the return value,
-// it must delete it (with [])
-char* KoXmlWriter::escapeForXML(const char* source, int length = -1) const
+void KoXmlWriter::writeEscaped(const char* source)
 {
-    // we're going to be pessimistic on char length; so lets make the outputLength less
-    // the amount one char can take: 6
-    char* destBoundary = d->escapeBuffer + s_escapeBufferLen - 6;
-    char* destination = d->escapeBuffer;
-    char* output = d->escapeBuffer;
+    // Scan for the next character that needs special handling and
+    // write out everything before it in one go. Most strings (numbers,
+    // uuids, attribute keywords) contain nothing to escape at all, so
+    // they are appended to the output buffer in a single bulk copy
+    // instead of going through a char-by-char copy into a side buffer.
+    const char* runStart = source;
     const char* src = source; // src moves, source remains
     for (;;) {
-        if (destination >= destBoundary) {
-            // When we come to realize that our escaped string is going to
-            // be bigger than the escape buffer (this shouldn't happen very often...),
-            // we drop the idea of using it, and we allocate a bigger buffer.
-            // Note that this if() can only be hit once per call to the method.
-            if (length == -1)
-                length = qstrlen(source);   // expensive...
-            uint newLength = length * 6 + 1; // worst case. 6 is due to &quot; and &apos;
-            char* buffer = new char[ newLength ];
-            destBoundary = buffer + newLength;
-            uint amountOfCharsAlreadyCopied = destination - d->escapeBuffer;
-            memcpy(buffer, d->escapeBuffer, amountOfCharsAlreadyCopied);
-            output = buffer;
-            destination = buffer + amountOfCharsAlreadyCopied;
+        const char c = *src;
+        if (!(c == '<' || c == '>' || c == '"' || c == '&' ||
+              (c >= 0 && c < 32 && c != 9 && c != 10 && c != 13))) {
+            // Plain character (tab, LF and CR are accepted in XML 1.0)
+            ++src;
+            continue;
         }
-        switch (*src) {
-        case 60: // <
-            memcpy(destination, "&lt;", 4);
-            destination += 4;
-            break;
-        case 62: // >
-            memcpy(destination, "&gt;", 4);
-            destination += 4;
+
+        if (src != runStart) {
+            writeBytes(runStart, src - runStart);
+        }
+
+        switch (c) {
+        case '<':
+            writeCString("&lt;");
             break;
-        case 34: // "
-            memcpy(destination, "&quot;", 6);
-            destination += 6;
+        case '>':
+            writeCString("&gt;");
             break;
-#if 0 // needed?
-        case 39: // '
-            memcpy(destination, "&apos;", 6);
-            destination += 6;
+        case '"':
+            writeCString("&quot;");
             break;
-#endif
-        case 38: // &
-            memcpy(destination, "&amp;", 5);
-            destination += 5;
+        case '&':
+            writeCString("&amp;");
             break;
         case 0:
-            *destination = '\0';
-            return output;
-        // Control codes accepted in XML 1.0 documents.
-        case 9:
-        case 10:
-        case 13:
-            *destination++ = *src++;
-            continue;
+            return;
         default:
-            // Don't add control codes not accepted in XML 1.0 documents.
-            if (*src > 0 && *src < 32) {
-                ++src;
-            } else {
-                *destination++ = *src++;
-            }
-            continue;
+            // Drop control codes not accepted in XML 1.0 documents.
+            break;
         }
         ++src;
+        runStart = src;
     }
-    // NOTREACHED (see case 0)
-    return output;
 }
 
 void KoXmlWriter::addManifestEntry(const QString& fullPath, const QString& mediaType)
@@ -322,11 +297,28 @@ void KoXmlWriter::addManifestEntry(const QString& fullPath, const QString& media
 }
 
 // TODO check return value!!!
+void KoXmlWriter::writeBytes(const char* data, int length) {
+    if (length >= s_outputBufferLength) {
+        // Doesn't fit in the buffer at all, pass it to the device
+        // directly (after what's already pending, to keep the order)
+        flush();
+        d->dev->write(data, length);
+        return;
+    }
+    if (d->outputBufferPos + length > s_outputBufferLength) {
+        flush();
+    }
+    memcpy(d->outputBuffer + d->outputBufferPos, data, length);
+    d->outputBufferPos += length;
+}
+
 void KoXmlWriter::writeCString(const char* cstr) {
-    d->dev->write(cstr, qstrlen(cstr));
+    writeBytes(cstr, qstrlen(cstr));
 }
 
-// TODO check return value!!!
 void KoXmlWriter::writeChar(char c) {
-    d->dev->putChar(c);
+    if (d->outputBufferPos == s_outputBufferLength) {
+        flush();
+    }
+    d->outputBuffer[d->outputBufferPos++] = c;
 }
@@ -45,6 +45,17 @@ public:
     /// Call this to terminate an XML document.
     void endDocument();
 
+    /**
+     * Flush the internal write buffer to the device.
+     *
+     * The writer batches its output and writes it out in large chunks,
+     * so the underlying device lags behind the calls made on the
+     * writer. endDocument() and the destructor flush automatically;
+     * call this manually only if you need to read the device while
+     * the writer is still alive (e.g. a fragment writer on a QBuffer).
+     */
+    void flush();
+
     /**
      * Start a new element, as a child of the current element.
      *
@@ -184,6 +195,8 @@ private:
     /// Write out \n followed by the number of spaces required.
     void writeIndent();
 
+    void writeBytes(const char* data, int length);
+
     void writeCString(const char* cstr);
 
     void writeChar(char c);
@@ -195,7 +208,7 @@ private:
             writeChar('>');
         }
     }
-    char *escapeForXML(const char* source, int length) const;
+    void writeEscaped(const char* source);
     bool prepareForChild(bool indentInside = true);
     void prepareForTextNode();
 
@@ -162,7 +162,7 @@ void TestXmlWriter::testAddManifestEntry()
 
 void TestXmlWriter::testEscapingLongString()
 {
-    int sz = 15000;  // must be more than KoXmlWriter::s_escapeBufferLen
+    int sz = 80000;  // must be more than KoXmlWriter::s_outputBufferLength
     QString x(sz);
     x.fill('x', sz);
     x += '&';
@@ -22,7 +22,11 @@
 #include <QStandardPaths>
 #include <QScreen>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QLocale>
 #include <QMessageBox>
 #include <QProcessEnvironment>
@@ -30,6 +34,7 @@
 #include <QStyle>
 #include <QStyleFactory>
 #include <QSysInfo>
+#include <QTextStream>
 #include <QTimer>
 #include <QWidget>
 #include <QImageReader>
@@ -105,8 +110,12 @@
 
 #include <dialogs/KisAsyncAnimationFramesSaveDialog.h>
 #include <kis_image_animation_interface.h>
+#include <kis_time_span.h>
 #include "kis_file_layer.h"
 #include "kis_group_layer.h"
+#include <kis_memory_statistics_server.h>
+#include <kis_paint_device.h>
+#include <KisGlobalResourcesInterface.h>
 #include "kis_node_commands_adapter.h"
 #include "KisSynchronizedConnection.h"
 #include <QThreadStorage>
@@ -117,6 +126,8 @@
 #include <config-seexpr.h>
 #include <config-safe-asserts.h>
 
+#include <limits>
+
 namespace {
 const QTime appStartTime(QTime::currentTime());
 }
@@ -412,11 +423,23 @@ void KisApplication::loadPlugins()
     KoColorSpaceRegistry::instance();
     KisActionRegistry::instance();
     KisFilterRegistry::instance();
-    KisGeneratorRegistry::instance();
     KisPaintOpRegistry::instance();
     KoToolRegistry::instance();
     KoDockRegistry::instance();
-    KisMetadataBackendRegistry::instance();
+}
+
+void KisApplication::loadDeferredPlugins()
+{
+    // These registries are not needed to get the first main window on
+    // screen, so their plugins are initialized from the event loop once
+    // startup is done. The registries stay lazy: anything that needs
+    // them before the queued call fires simply does the work earlier.
+    QTimer::singleShot(0, this, []() {
+        KisGeneratorRegistry::instance();
+    });
+    QTimer::singleShot(0, this, []() {
+        KisMetadataBackendRegistry::instance();
+    });
 }
 
 bool KisApplication::start(const KisApplicationArguments &args)
@@ -455,11 +478,12 @@ bool KisApplication::start(const KisApplicationArguments &args)
     const bool exportAs = args.exportAs();
     const bool exportSequence = args.exportSequence();
     const QString exportFileName = args.exportFileName();
+    const QString perfProbe = args.perfProbe();
 
-    d->batchRun = (exportAs || exportSequence || !exportFileName.isEmpty());
-    const bool needsMainWindow = (!exportAs && !exportSequence);
+    d->batchRun = (exportAs || exportSequence || !exportFileName.isEmpty() || !perfProbe.isEmpty());
+    const bool needsMainWindow = (!exportAs && !exportSequence && perfProbe.isEmpty());
     // only show the mainWindow when no command-line mode option is passed
-    bool showmainWindow = (!exportAs && !exportSequence); // would be !batchRun;
+    bool showmainWindow = needsMainWindow; // would be !batchRun;
 
     const bool showSplashScreen = !d->batchRun && qEnvironmentVariableIsEmpty("NOSPLASH");
     if (showSplashScreen && d->splashScreen) {
@@ -563,6 +587,10 @@ bool KisApplication::start(const KisApplicationArguments &args)
     setSplashScreenLoadingText(QString()); // done loading, so clear out label
     processEvents();
 
+    // Initialize the plugins the first window didn't need once the
+    // event loop is running
+    loadDeferredPlugins();
+
     //configure the unit manager
     KisSpinBoxUnitManagerFactory::setDefaultUnitManagerBuilder(new KisDocumentAwareSpinBoxUnitManagerBuilder());
     connect(this, &KisApplication::aboutToQuit, &KisSpinBoxUnitManagerFactory::clearUnitManagerBuilder); //ensure the builder is destroyed when the application leave.
@@ -595,7 +623,24 @@ bool KisApplication::start(const KisApplicationArguments &args)
                 // now try to load
             }
             else {
-                if (exportAs) {
+                if (!perfProbe.isEmpty()) {
+                    KisDocument *doc = kisPart->createDocument();
+                    doc->setFileBatchMode(true);
+
+                    if (!doc->openPath(fileName)) {
+                        errKrita << "Could not load " << fileName << ":" << doc->errorMessage();
+                        QTimer::singleShot(0, this, SLOT(quit()));
+                        return false;
+                    }
+
+                    qApp->processEvents(); // For vector layers to be updated
+                    doc->image()->waitForDone();
+
+                    const bool result = runPerfProbe(doc, perfProbe);
+                    QTimer::singleShot(0, this, SLOT(quit()));
+                    return result;
+                }
+                else if (exportAs) {
                     QString outputMimetype = KisMimeDatabase::mimeTypeForFile(exportFileName, false);
                     if (outputMimetype == "application/octetstream") {
                         dbgKrita << i18n("Mimetype not found, try using the -mimetype option") << Qt::endl;
@@ -644,10 +689,43 @@ bool KisApplication::start(const KisApplicationArguments &args)
                     doc->setFileBatchMode(true);
                     int sequenceStart = 0;
 
+                    KisTimeSpan renderRange = doc->image()->animationInterface()->documentPlaybackRange();
+
+                    if (!args.exportFrameRange().isEmpty()) {
+                        /**
+                         * Shard mode: render only a sub-range of the
+                         * sequence. The numbering of the exported files
+                         * stays absolute, so several processes can each
+                         * take a range of one animation and their
+                         * outputs merge into a single sequence.
+                         */
+                        const QStringList parts = args.exportFrameRange().split('-');
+                        bool startOk = false;
+                        bool endOk = false;
+                        const int rangeStart = parts.size() == 2 ? parts[0].toInt(&startOk) : 0;
+                        const int rangeEnd = parts.size() == 2 ? parts[1].toInt(&endOk) : 0;
+
+                        if (!startOk || !endOk || rangeStart > rangeEnd) {
+                            errKrita << "Invalid --export-frame-range" << args.exportFrameRange() << "(expected e.g. 10-250)" << Qt::endl;
+                            QTimer::singleShot(0, this, SLOT(quit()));
+                            return false;
+                        }
+
+                        renderRange &= KisTimeSpan::fromTimeToTime(rangeStart, rangeEnd);
+
+                        if (!renderRange.isValid()) {
+                            errKrita << "The requested frame range" << args.exportFrameRange() << "is outside the animation's playback range" << Qt::endl;
+                            QTimer::singleShot(0, this, SLOT(quit()));
+                            return false;
+                        }
+
+                        // keep the file numbering aligned to absolute frame numbers
+                        sequenceStart = renderRange.start();
+                    }
 
                     qDebug() << ppVar(exportFileName);
                     KisAsyncAnimationFramesSaveDialog exporter(doc->image(),
-                                               doc->image()->animationInterface()->documentPlaybackRange(),
+                                               renderRange,
                                                exportFileName,
                                                sequenceStart,
                                                false,
@@ -1114,6 +1192,119 @@ bool KisApplication::createNewDocFromTemplate(const QString &fileName, KisMainWi
     return false;
 }
 
+bool KisApplication::runPerfProbe(KisDocument *document, const QString &scenario)
+{
+    KisImageSP image = document->image();
+
+    QString name = scenario;
+    QString parameter;
+    const int separatorPos = scenario.indexOf(':');
+    if (separatorPos >= 0) {
+        name = scenario.left(separatorPos);
+        parameter = scenario.mid(separatorPos + 1);
+    }
+
+    QJsonArray runsUsecs;
+    QElapsedTimer timer;
+
+    if (name == "composite") {
+        const int numRuns = parameter.isEmpty() ? 3 : qMax(parameter.toInt(), 1);
+        /**
+         * The first run after loading is usually slower, because the
+         * tiles and the filter caches are still cold; report every run
+         * separately so the consumer can see both.
+         */
+        for (int i = 0; i < numRuns; i++) {
+            timer.start();
+            image->refreshGraphAsync();
+            image->waitForDone();
+            runsUsecs.append(qint64(timer.nsecsElapsed() / 1000));
+        }
+    }
+    else if (name == "filter") {
+        KisFilterSP filter = KisFilterRegistry::instance()->value(parameter);
+        if (!filter) {
+            errKrita << "Unknown filter for --perf-probe:" << parameter;
+            return false;
+        }
+
+        KisFilterConfigurationSP config =
+            filter->defaultConfiguration(KisGlobalResourcesInterface::instance());
+
+        // run over a copy, so the probe does not dirty the document
+        KisPaintDeviceSP device = new KisPaintDevice(*image->projection());
+
+        timer.start();
+        filter->process(device, image->bounds(), config->cloneWithResourcesSnapshot());
+        runsUsecs.append(qint64(timer.nsecsElapsed() / 1000));
+    }
+    else if (name == "render-frames") {
+        if (!image->animationInterface()->hasAnimation()) {
+            errKrita << "This file has no animation.";
+            return false;
+        }
+
+        const KisTimeSpan renderRange =
+            image->animationInterface()->documentPlaybackRange();
+        int numFrames = renderRange.duration();
+        if (!parameter.isEmpty()) {
+            numFrames = qBound(1, parameter.toInt(), numFrames);
+        }
+
+        for (int i = 0; i < numFrames; i++) {
+            timer.start();
+            image->animationInterface()->switchCurrentTimeAsync(renderRange.start() + i);
+            image->waitForDone();
+            runsUsecs.append(qint64(timer.nsecsElapsed() / 1000));
+        }
+    }
+    else {
+        errKrita << "Unknown --perf-probe scenario:" << scenario
+                 << "(expected composite[:runs], filter:<id> or render-frames[:count])";
+        return false;
+    }
+
+    qint64 totalUsecs = 0;
+    qint64 minUsecs = std::numeric_limits<qint64>::max();
+    qint64 maxUsecs = 0;
+    Q_FOREACH (const QJsonValue &value, runsUsecs) {
+        const qint64 usecs = qint64(value.toDouble());
+        totalUsecs += usecs;
+        minUsecs = qMin(minUsecs, usecs);
+        maxUsecs = qMax(maxUsecs, usecs);
+    }
+
+    QJsonObject timing;
+    timing["runsUsecs"] = runsUsecs;
+    timing["totalUsecs"] = totalUsecs;
+    timing["minUsecs"] = minUsecs;
+    timing["maxUsecs"] = maxUsecs;
+    timing["avgUsecs"] = totalUsecs / runsUsecs.count();
+
+    const KisMemoryStatisticsServer::Statistics memStats =
+        KisMemoryStatisticsServer::instance()->fetchMemoryStatistics(image);
+
+    QJsonObject memory;
+    memory["imageSize"] = memStats.imageSize;
+    memory["layersSize"] = memStats.layersSize;
+    memory["projectionsSize"] = memStats.projectionsSize;
+    memory["totalMemorySize"] = memStats.totalMemorySize;
+    memory["swapSize"] = memStats.swapSize;
+
+    QJsonObject root;
+    root["file"] = document->path();
+    root["scenario"] = scenario;
+    root["width"] = image->width();
+    root["height"] = image->height();
+    root["timing"] = timing;
+    root["memory"] = memory;
+
+    QTextStream out(stdout);
+    out << QJsonDocument(root).toJson();
+
+    return true;
+}
+
 void KisApplication::resetConfig()
 {
     KIS_ASSERT_RECOVER_RETURN(qApp->thread() == QThread::currentThread());
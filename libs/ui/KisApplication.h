@@ -13,6 +13,7 @@
 #include <qtsingleapplication/qtsingleapplication.h>
 #include "kritaui_export.h"
 
+class KisDocument;
 class KisMainWindow;
 class KisApplicationPrivate;
 class QWidget;
@@ -85,6 +86,7 @@ public:
     void addResourceTypes();
     bool registerResources();
     void loadPlugins();
+    void loadDeferredPlugins();
     void initializeGlobals(const KisApplicationArguments &args);
     void processPostponedSynchronizationEvents();
 
@@ -106,6 +108,13 @@ private:
     bool createNewDocFromTemplate(const QString &fileName, KisMainWindow *m_mainWindow);
     void resetConfig();
 
+    /**
+     * Runs the headless performance scenario requested with --perf-probe
+     * on an already loaded document and prints the timing and memory
+     * statistics as JSON to stdout.
+     */
+    bool runPerfProbe(KisDocument *document, const QString &scenario);
+
 private:
     class Private;
     QScopedPointer<Private> d;
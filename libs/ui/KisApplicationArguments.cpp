@@ -32,7 +32,9 @@ struct Q_DECL_HIDDEN KisApplicationArguments::Private
     bool doTemplate {false};
     bool exportAs {false};
     bool exportSequence {false};
+    QString exportFrameRange;
     QString exportFileName;
+    QString perfProbe;
     QString workspace;
     QString windowLayout;
     QString session;
@@ -95,6 +97,13 @@ KisApplicationArguments::KisApplicationArguments(const QApplication &app)
     parser.addOption(QCommandLineOption(QStringList() << QLatin1String("export"), i18n("Export to the given filename and exit")));
     parser.addOption(QCommandLineOption(QStringList() << QLatin1String("export-sequence"), i18n("Export animation to the given filename and exit")));
     parser.addOption(QCommandLineOption(QStringList() << QLatin1String("export-filename"), i18n("Filename for export"), QLatin1String("filename")));
+    parser.addOption(QCommandLineOption(QStringList() << QLatin1String("export-frame-range"), i18n("Limit --export-sequence to the given frame range, e.g. 10-250. The frame numbers in the exported filenames are kept absolute, so one sequence can be split over several Krita processes"), QLatin1String("range")));
+    parser.addOption(QCommandLineOption(QStringList() << QLatin1String("perf-probe"), i18n("Open the given file without a GUI, run the named performance scenario and print timing and memory statistics as JSON to stdout.\n"
+                                                                                           "Possible scenarios are:\n"
+                                                                                           "    * composite[:runs] - recomposite the full layer stack (3 runs by default)\n"
+                                                                                           "    * filter:<id> - run the given filter over a copy of the projection\n"
+                                                                                           "    * render-frames[:count] - regenerate animation frames of the playback range\n"),
+                                        QLatin1String("scenario")));
     parser.addOption(QCommandLineOption(QStringList() << QLatin1String("file-layer"), i18n("File layer to be added to existing or new file"), QLatin1String("file-layer")));
     parser.addOption(QCommandLineOption(QStringList() << QLatin1String("resource-location"), i18n("A location that overrides the configured location for Krita's resources"), QLatin1String("file-layer")));
     parser.addPositionalArgument(QLatin1String("[file(s)]"), i18n("File(s) or URL(s) to open"));
@@ -186,6 +195,8 @@ KisApplicationArguments::KisApplicationArguments(const QApplication &app)
     d->doTemplate = parser.isSet("template");
     d->exportAs = parser.isSet("export");
     d->exportSequence = parser.isSet("export-sequence");
+    d->exportFrameRange = parser.value("export-frame-range");
+    d->perfProbe = parser.value("perf-probe");
     d->canvasOnly = parser.isSet("canvasonly");
     d->noSplash = parser.isSet("nosplash");
     d->fullScreen = parser.isSet("fullscreen");
@@ -325,11 +336,21 @@ bool KisApplicationArguments::exportSequence() const
     return d->exportSequence;
 }
 
+QString KisApplicationArguments::exportFrameRange() const
+{
+    return d->exportFrameRange;
+}
+
 QString KisApplicationArguments::exportFileName() const
 {
     return d->exportFileName;
 }
 
+QString KisApplicationArguments::perfProbe() const
+{
+    return d->perfProbe;
+}
+
 QString KisApplicationArguments::workspace() const
 {
     return d->workspace;
@@ -33,7 +33,9 @@ public:
     bool doTemplate() const;
     bool exportAs() const;
     bool exportSequence() const;
+    QString exportFrameRange() const;
     QString exportFileName() const;
+    QString perfProbe() const;
     QString workspace() const;
     QString windowLayout() const;
     QString session() const;
@@ -7,6 +7,7 @@
 #include "KisAutoSaveRecoveryDialog.h"
 
 #include <KoStore.h>
+#include <KisProjectionSnapshot.h>
 
 #include <kwidgetitemdelegate.h>
 #include <klocalizedstring.h>
@@ -200,8 +201,14 @@ KisAutoSaveRecoveryDialog::KisAutoSaveRecoveryDialog(const QStringList &filename
         file->name = filename;
 
         QString path = autoSaveLocation() + "/" + filename;
+
+        // the warm-start sidecar is a raw projection dump that can be
+        // memory-mapped, so it beats opening the ZIP and decoding a PNG
+        file->thumbnail = KisProjectionSnapshot::loadScaled(
+            KisProjectionSnapshot::snapshotPath(path), QSize(200, 200));
+
         // get thumbnail -- almost all Krita-supported formats save a thumbnail
-        KoStore* store = KoStore::createStore(path, KoStore::Read);
+        KoStore* store = file->thumbnail.isNull() ? KoStore::createStore(path, KoStore::Read) : 0;
 
         if (store) {
             QString thumbnailPath = QLatin1String("Thumbnails/thumbnail.png");
@@ -47,6 +47,7 @@
 #include <kis_generator_layer.h>
 #include <kis_generator_registry.h>
 #include <KisAutoSaveRecoveryDialog.h>
+#include <KisProjectionSnapshot.h>
 #include <kdesktopfile.h>
 #include <kconfiggroup.h>
 #include <KisBackup.h>
@@ -111,6 +112,7 @@
 #include "kis_grid_config.h"
 #include "kis_guides_config.h"
 #include "KisImageBarrierLock.h"
+#include "KisLayerPayloadCache.h"
 #include "KisReferenceImagesLayer.h"
 #include "dialogs/KisRecoverNamedAutosaveDialog.h"
 
@@ -403,6 +405,13 @@ public:
     bool imageModifiedWithoutUndo = false;
     bool modifiedWhileSaving = false;
     QScopedPointer<KisDocument> backgroundSaveDocument;
+
+    /**
+     * Serialized layer payloads reused by consecutive saves of the
+     * same document. Shared with the cloned documents created for
+     * background saving, so the payloads survive between saves.
+     */
+    QSharedPointer<KisLayerPayloadCache> layerPayloadCache {new KisLayerPayloadCache()};
     QPointer<KoUpdater> savingUpdater;
     QFuture<KisImportExportErrorCode> childSavingFuture;
     KritaUtils::ExportFileJob backgroundSaveJob;
@@ -538,6 +547,9 @@ void KisDocument::Private::copyFromImpl(const Private &rhs, KisDocument *q, KisD
     globalAssistantsColor = rhs.globalAssistantsColor;
     batchMode = rhs.batchMode;
 
+    // deliberately shared between the document and its saving clones
+    layerPayloadCache = rhs.layerPayloadCache;
+
 
     if (rhs.linkedResourceStorage) {
         linkedResourceStorage = rhs.linkedResourceStorage->clone();
@@ -1472,6 +1484,25 @@ void KisDocument::slotAutoSaveImpl(std::unique_ptr<KisDocument> &&optionalCloned
     const bool hadClonedDocument = bool(optionalClonedDocument);
     KritaUtils::BackgroudSavingStartResult result = KritaUtils::BackgroudSavingStartResult::Failure;
 
+    /**
+     * Take the warm-start projection snapshot before the cloned
+     * document is moved into the saving job. The image we read from
+     * is guaranteed to be quiescent here: either the original image
+     * is idle, or we read from the clone.
+     */
+    QImage projectionSnapshot;
+    if (d->image->isIdle() || hadClonedDocument) {
+        KisImageSP snapshotImage = hadClonedDocument ? optionalClonedDocument->image() : d->image;
+        QSize snapshotSize = snapshotImage->bounds().size();
+        const QSize maximumSnapshotSize(2048, 2048);
+        if (snapshotSize.width() > maximumSnapshotSize.width() ||
+            snapshotSize.height() > maximumSnapshotSize.height()) {
+
+            snapshotSize = snapshotSize.scaled(maximumSnapshotSize, Qt::KeepAspectRatio).expandedTo({1, 1});
+        }
+        projectionSnapshot = snapshotImage->convertToQImage(snapshotSize, 0);
+    }
+
     if (d->image->isIdle() || hadClonedDocument) {
         result = initiateSavingInBackground(i18n("Autosaving..."),
                                              this, SLOT(slotCompleteAutoSaving(KritaUtils::ExportFileJob, KisImportExportErrorCode, QString, QString)),
@@ -1500,6 +1531,11 @@ void KisDocument::slotAutoSaveImpl(std::unique_ptr<KisDocument> &&optionalCloned
         setEmergencyAutoSaveInterval();
     } else {
         d->modifiedAfterAutosave = false;
+
+        // refresh the warm-start sidecar used by session restore and
+        // the recovery dialog; failure to write it is not an error
+        KisProjectionSnapshot::write(KisProjectionSnapshot::snapshotPath(autoSaveFileName),
+                                     projectionSnapshot);
     }
 }
 
@@ -2216,12 +2252,15 @@ void KisDocument::removeAutoSaveFiles(const QString &autosaveBaseName, bool wasR
         KisUsageLogger::log(QString("Removing autosave file: %1").arg(asf));
         QFile::remove(asf);
     }
+    KisProjectionSnapshot::removeFor(asf);
+
     asf = generateAutoSaveFileName(QString());   // and the one in $HOME
 
     if (QFile::exists(asf)) {
         KisUsageLogger::log(QString("Removing autosave file: %1").arg(asf));
         QFile::remove(asf);
     }
+    KisProjectionSnapshot::removeFor(asf);
 
     QList<QRegularExpression> expressions;
 
@@ -2236,6 +2275,7 @@ void KisDocument::removeAutoSaveFiles(const QString &autosaveBaseName, bool wasR
 
             KisUsageLogger::log(QString("Removing autosave file: %1").arg(autosaveBaseName));
             QFile::remove(autosaveBaseName);
+            KisProjectionSnapshot::removeFor(autosaveBaseName);
         }
     }
 }
@@ -2792,6 +2832,11 @@ KisImageSP KisDocument::savingImage() const
     return d->savingImage;
 }
 
+KisLayerPayloadCache *KisDocument::layerPayloadCache() const
+{
+    return d->layerPayloadCache.data();
+}
+
 
 void KisDocument::setCurrentImage(KisImageSP image, bool forceInitialUpdate, KisNodeSP preActivatedNode)
 {
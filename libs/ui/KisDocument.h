@@ -53,6 +53,7 @@ class KisGuidesConfig;
 class KisMirrorAxisConfig;
 class QDomDocument;
 class KisReferenceImagesLayer;
+class KisLayerPayloadCache;
 
 #define KIS_MIME_TYPE "application/x-krita"
 
@@ -616,6 +617,14 @@ public:
      */
     KisImageSP savingImage() const;
 
+    /**
+     * @brief layerPayloadCache returns the cache of serialized layer
+     * payloads reused by consecutive saves of the same document. The
+     * cache is shared with the cloned documents created for background
+     * saving.
+     */
+    KisLayerPayloadCache *layerPayloadCache() const;
+
     /**
      * Set the current image to the specified image and turn undo on.
      */
@@ -5,6 +5,10 @@
  */
 #include "KisFrameCacheStore.h"
 
+#include <QHash>
+#include <QPair>
+#include <QWeakPointer>
+
 #include <KoColorSpace.h>
 #include "kis_update_info.h"
 #include "KisFrameDataSerializer.h"
@@ -131,6 +135,38 @@ struct KRITAUI_NO_EXPORT KisFrameCacheStore::Private
     FrameInfoSP lastLoadedBaseFrameInfo;
 
     QMap<int, FrameInfoSP> savedFrames;
+
+    /**
+     * Content-addressed index of the stored full frames, used for
+     * aliasing identical frames to one stored instance. The weak
+     * references keep the index from prolonging the lifetime of
+     * forgotten frames; dead entries are swept on insertion.
+     */
+    QHash<QPair<quint64, quint64>, QWeakPointer<FrameInfo>> fullFramesByContentHash;
+
+    FrameInfoSP findDuplicateFullFrame(const QPair<quint64, quint64> &contentHash,
+                                       const QRect &imageBounds, int levelOfDetail)
+    {
+        FrameInfoSP duplicate = fullFramesByContentHash.value(contentHash).toStrongRef();
+
+        if (duplicate &&
+            (duplicate->imageBounds() != imageBounds ||
+             duplicate->levelOfDetail() != levelOfDetail)) {
+
+            duplicate.clear();
+        }
+
+        return duplicate;
+    }
+
+    void registerFullFrame(const QPair<quint64, quint64> &contentHash, FrameInfoSP frameInfo)
+    {
+        for (auto it = fullFramesByContentHash.begin(); it != fullFramesByContentHash.end();) {
+            it = it.value().isNull() ? fullFramesByContentHash.erase(it) : it + 1;
+        }
+
+        fullFramesByContentHash.insert(contentHash, frameInfo.toWeakRef());
+    }
 };
 
 KisFrameCacheStore::KisFrameCacheStore()
@@ -187,7 +223,29 @@ void KisFrameCacheStore::saveFrame(int frameId, KisOpenGLUpdateInfoSP info, cons
 
     FrameInfoSP frameInfo;
 
-    if (m_d->lastSavedFullFrame.isValid()) {
+    /**
+     * Hold-heavy animations render byte-identical frames for separate
+     * invalidation ranges over and over. Alias such frames to the
+     * full frame already stored instead of saving the same pixels
+     * again. Unlike the sampling-based copy detection that was
+     * disabled below, the 128-bit hash covers every byte of the
+     * frame, so no user-visible differences can slip through it.
+     */
+    const QPair<quint64, quint64> contentHash =
+        KisFrameDataSerializer::frameContentHash(frame);
+
+    FrameInfoSP duplicateFrameInfo =
+        m_d->findDuplicateFullFrame(contentHash, imageBounds, info->levelOfDetail());
+
+    if (duplicateFrameInfo) {
+        frameInfo = toQShared(new FrameInfo(info->dirtyImageRect(),
+                                            imageBounds,
+                                            info->levelOfDetail(),
+                                            m_d->serializer,
+                                            duplicateFrameInfo));
+    }
+
+    if (!frameInfo && m_d->lastSavedFullFrame.isValid()) {
         boost::optional<qreal> uniqueness = KisFrameDataSerializer::estimateFrameUniqueness(m_d->lastSavedFullFrame, frame, 0.01);
 
 
@@ -215,7 +273,22 @@ void KisFrameCacheStore::saveFrame(int frameId, KisOpenGLUpdateInfoSP info, cons
             if (*uniqueness < 0.5) {
                 FrameInfoSP baseFrameInfo = m_d->savedFrames[m_d->lastSavedFullFrameId];
 
-                KisFrameDataSerializer::subtractFrames(frame, m_d->lastSavedFullFrame);
+                std::vector<bool> sameTiles;
+                KisFrameDataSerializer::subtractFrames(frame, m_d->lastSavedFullFrame, &sameTiles);
+
+                /**
+                 * Tiles that didn't change since the keyframe produce
+                 * an all-zero delta; drop them from the stored frame
+                 * entirely, addFrames() reconstructs them from the
+                 * base on loading. In a mostly-static shot a delta
+                 * frame shrinks to the few tiles the stroke actually
+                 * touched.
+                 */
+                auto tileIt = frame.frameTiles.begin();
+                for (size_t i = 0; i < sameTiles.size(); i++) {
+                    tileIt = sameTiles[i] ? frame.frameTiles.erase(tileIt) : tileIt + 1;
+                }
+
                 frameInfo = toQShared(new FrameInfo(info->dirtyImageRect(),
                                                     imageBounds,
                                                     info->levelOfDetail(),
@@ -237,6 +310,7 @@ void KisFrameCacheStore::saveFrame(int frameId, KisOpenGLUpdateInfoSP info, cons
     m_d->savedFrames.insert(frameId, frameInfo);
 
     if (frameInfo->type() == FrameFull) {
+        m_d->registerFullFrame(contentHash, frameInfo);
         m_d->lastSavedFullFrame = std::move(frame);
         m_d->lastSavedFullFrameId = frameId;
     }
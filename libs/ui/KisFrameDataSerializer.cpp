@@ -156,6 +156,15 @@ KisFrameDataSerializer::Frame KisFrameDataSerializer::loadFrame(int frameId, Kis
     KIS_SAFE_ASSERT_RECOVER_NOOP(file.exists());
     if (!file.open(QFile::ReadOnly)) return frame;
 
+    /**
+     * Map the frame file instead of read()-ing it: the tile payloads
+     * are decompressed (or copied) straight from the page cache into
+     * the pool chunk that is later handed to the texture upload,
+     * skipping the intermediate staging buffer. When mapping fails we
+     * fall back to streamed reads.
+     */
+    const uchar *mappedFile = file.map(0, file.size());
+
     QDataStream stream(&file);
 
     int numTiles = 0;
@@ -184,17 +193,26 @@ KisFrameDataSerializer::Frame KisFrameDataSerializer::loadFrame(int frameId, Kis
         stream >> inputSize;
 
         if (isCompressed) {
-            const int maxBufferSize = compression.outputBufferSize(inputSize);
-            quint8 *buffer = m_d->getCompressionBuffer(maxBufferSize);
-            stream.readRawData((char*)buffer, inputSize);
-
             tile.data.allocate(frame.pixelSize);
 
             QElapsedTimer compTime;
             compTime.start();
 
-            const int decompressedSize =
-                compression.decompress(buffer, inputSize, tile.data.data(), frameByteSize);
+            int decompressedSize = -1;
+
+            if (mappedFile) {
+                const quint8 *src = mappedFile + stream.device()->pos();
+                decompressedSize =
+                    compression.decompress(src, inputSize, tile.data.data(), frameByteSize);
+                stream.skipRawData(inputSize);
+            } else {
+                const int maxBufferSize = compression.outputBufferSize(inputSize);
+                quint8 *buffer = m_d->getCompressionBuffer(maxBufferSize);
+                stream.readRawData((char*)buffer, inputSize);
+
+                decompressedSize =
+                    compression.decompress(buffer, inputSize, tile.data.data(), frameByteSize);
+            }
 
             compressionTime += compTime.nsecsElapsed();
 
@@ -206,7 +224,13 @@ KisFrameDataSerializer::Frame KisFrameDataSerializer::loadFrame(int frameId, Kis
                                                  KisFrameDataSerializer::Frame());
 
             tile.data.allocate(frame.pixelSize);
-            stream.readRawData((char*)tile.data.data(), inputSize);
+
+            if (mappedFile) {
+                std::memcpy(tile.data.data(), mappedFile + stream.device()->pos(), inputSize);
+                stream.skipRawData(inputSize);
+            } else {
+                stream.readRawData((char*)tile.data.data(), inputSize);
+            }
         }
 
         frame.frameTiles.push_back(std::move(tile));
@@ -286,6 +310,59 @@ boost::optional<qreal> KisFrameDataSerializer::estimateFrameUniqueness(const Kis
     return numSampledPixels > 0 ? qreal(numUniquePixels) / numSampledPixels : 1.0;
 }
 
+namespace {
+
+struct Fnv1aHash {
+    // two independent FNV-1a streams give a 128-bit combined hash
+    quint64 lo = 0xcbf29ce484222325ULL;
+    quint64 hi = 0x6c62272e07bb0142ULL;
+
+    inline void feedByte(quint8 value) {
+        lo = (lo ^ value) * 0x100000001b3ULL;
+        hi = (hi ^ value) * 0x9e3779b97f4a7c15ULL;
+    }
+
+    inline void feedInt(qint64 value) {
+        for (int i = 0; i < 8; i++) {
+            feedByte(quint8(value >> (i * 8)));
+        }
+    }
+
+    inline void feedData(const quint8 *data, int numBytes) {
+        for (int i = 0; i < numBytes; i++) {
+            feedByte(data[i]);
+        }
+    }
+};
+
+}
+
+QPair<quint64, quint64> KisFrameDataSerializer::frameContentHash(const KisFrameDataSerializer::Frame &frame)
+{
+    Fnv1aHash hash;
+
+    hash.feedInt(frame.pixelSize);
+    hash.feedInt(qint64(frame.frameTiles.size()));
+
+    for (auto it = frame.frameTiles.begin(); it != frame.frameTiles.end(); ++it) {
+        const FrameTile &tile = *it;
+
+        hash.feedInt(tile.col);
+        hash.feedInt(tile.row);
+        hash.feedInt(tile.rect.x());
+        hash.feedInt(tile.rect.y());
+        hash.feedInt(tile.rect.width());
+        hash.feedInt(tile.rect.height());
+
+        KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(tile.data.data(), qMakePair(quint64(0), quint64(0)));
+
+        const int numBytes = frame.pixelSize * tile.rect.width() * tile.rect.height();
+        hash.feedData(tile.data.data(), numBytes);
+    }
+
+    return qMakePair(hash.lo, hash.hi);
+}
+
 template <template <typename U> class OpPolicy, typename T>
 bool processData(T *dst, const T *src, int numUnits)
 {
@@ -306,44 +383,90 @@ bool processData(T *dst, const T *src, int numUnits)
     return unitsAreSame;
 }
 
+template <template <typename U> class OpPolicy>
+bool processTileData(quint8 *dst, const quint8 *src, int numBytes)
+{
+    const int numQWords = numBytes / 8;
+    const int tailBytes = numBytes % 8;
+
+    bool tileIsSame =
+        processData<OpPolicy>(reinterpret_cast<quint64*>(dst),
+                              reinterpret_cast<const quint64*>(src),
+                              numQWords);
+
+    tileIsSame &= processData<OpPolicy>(dst + numBytes - tailBytes,
+                                        src + numBytes - tailBytes,
+                                        tailBytes);
+
+    return tileIsSame;
+}
 
 template<template <typename U> class OpPolicy>
-bool KisFrameDataSerializer::processFrames(KisFrameDataSerializer::Frame &dst, const KisFrameDataSerializer::Frame &src)
+bool KisFrameDataSerializer::processFrames(KisFrameDataSerializer::Frame &dst, const KisFrameDataSerializer::Frame &src, std::vector<bool> *sameTiles)
 {
     bool framesAreSame = true;
 
     KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(estimateFrameUniqueness(src, dst, 0.0), false);
 
+    if (sameTiles) {
+        sameTiles->clear();
+        sameTiles->reserve(src.frameTiles.size());
+    }
+
     for (int i = 0; i < int(src.frameTiles.size()); i++) {
         const FrameTile &srcTile = src.frameTiles[i];
         FrameTile &dstTile = dst.frameTiles[i];
 
         const int numBytes = srcTile.rect.width() * srcTile.rect.height() * src.pixelSize;
-        const int numQWords = numBytes / 8;
-
-        const quint64 *srcDataPtr = reinterpret_cast<const quint64*>(srcTile.data.data());
-        quint64 *dstDataPtr = reinterpret_cast<quint64*>(dstTile.data.data());
-
-        framesAreSame &= processData<OpPolicy>(dstDataPtr, srcDataPtr, numQWords);
 
+        const bool tileIsSame =
+            processTileData<OpPolicy>(dstTile.data.data(), srcTile.data.data(), numBytes);
 
-        const int tailBytes = numBytes % 8;
-        const quint8 *srcTailDataPtr = srcTile.data.data() + numBytes - tailBytes;
-        quint8 *dstTailDataPtr = dstTile.data.data() + numBytes - tailBytes;
+        if (sameTiles) {
+            sameTiles->push_back(tileIsSame);
+        }
 
-        framesAreSame &= processData<OpPolicy>(dstTailDataPtr, srcTailDataPtr, tailBytes);
+        framesAreSame &= tileIsSame;
     }
 
     return framesAreSame;
 }
 
-bool KisFrameDataSerializer::subtractFrames(KisFrameDataSerializer::Frame &dst, const KisFrameDataSerializer::Frame &src)
+bool KisFrameDataSerializer::subtractFrames(KisFrameDataSerializer::Frame &dst, const KisFrameDataSerializer::Frame &src, std::vector<bool> *sameTiles)
 {
-    return processFrames<std::minus>(dst, src);
+    return processFrames<std::minus>(dst, src, sameTiles);
 }
 
 void KisFrameDataSerializer::addFrames(KisFrameDataSerializer::Frame &dst, const KisFrameDataSerializer::Frame &src)
 {
-    // TODO: don't spend time on calculation of "framesAreSame" in this case
-    (void) processFrames<std::plus>(dst, src);
+    KIS_SAFE_ASSERT_RECOVER_RETURN(dst.pixelSize == src.pixelSize);
+    KIS_SAFE_ASSERT_RECOVER_RETURN(dst.frameTiles.size() <= src.frameTiles.size());
+
+    std::vector<FrameTile> reconstructedTiles;
+    reconstructedTiles.reserve(src.frameTiles.size());
+
+    auto dstIt = dst.frameTiles.begin();
+
+    for (auto srcIt = src.frameTiles.begin(); srcIt != src.frameTiles.end(); ++srcIt) {
+        if (dstIt != dst.frameTiles.end() &&
+            dstIt->col == srcIt->col &&
+            dstIt->row == srcIt->row) {
+
+            KIS_SAFE_ASSERT_RECOVER_RETURN(dstIt->rect == srcIt->rect);
+
+            const int numBytes = srcIt->rect.width() * srcIt->rect.height() * src.pixelSize;
+            processTileData<std::plus>(dstIt->data.data(), srcIt->data.data(), numBytes);
+
+            reconstructedTiles.push_back(std::move(*dstIt));
+            ++dstIt;
+        } else {
+            // the delta tile was dropped at save time because it was
+            // all-zero, so the base tile is reused verbatim
+            reconstructedTiles.push_back(srcIt->clone());
+        }
+    }
+
+    KIS_SAFE_ASSERT_RECOVER_RETURN(dstIt == dst.frameTiles.end());
+
+    dst.frameTiles = std::move(reconstructedTiles);
 }
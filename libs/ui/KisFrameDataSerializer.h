@@ -108,12 +108,36 @@ public:
     void forgetFrame(int frameId);
 
     static boost::optional<qreal> estimateFrameUniqueness(const Frame &lhs, const Frame &rhs, qreal portion);
-    static bool subtractFrames(Frame &dst, const Frame &src);
+
+    /**
+     * Calculates a 128-bit FNV-1a hash over the entire content of
+     * \p frame: the pixel size, the tile geometry and every byte of
+     * the tile data. Unlike estimateFrameUniqueness() with a partial
+     * \p portion, the hash is a function of the full content, so two
+     * equal hashes identify frames that render identically.
+     */
+    static QPair<quint64, quint64> frameContentHash(const Frame &frame);
+
+    /**
+     * Subtracts \p src from \p dst tile-wise. When \p sameTiles is
+     * provided, it is filled with one flag per tile telling whether
+     * the tile's delta came out all-zero; such tiles may be dropped
+     * from the stored frame entirely, addFrames() reconstructs them
+     * from the base frame.
+     */
+    static bool subtractFrames(Frame &dst, const Frame &src, std::vector<bool> *sameTiles = 0);
+
+    /**
+     * Adds the base frame \p src back to the delta frame \p dst. The
+     * tiles of \p dst must form an (ordered) subset of the tiles of
+     * \p src; base tiles that have no counterpart in \p dst are copied
+     * into the result verbatim.
+     */
     static void addFrames(Frame &dst, const Frame &src);
 
 private:
     template<template <typename U> class OpPolicy>
-    static bool processFrames(KisFrameDataSerializer::Frame &dst, const KisFrameDataSerializer::Frame &src);
+    static bool processFrames(KisFrameDataSerializer::Frame &dst, const KisFrameDataSerializer::Frame &src, std::vector<bool> *sameTiles);
 
 private:
     Q_DISABLE_COPY(KisFrameDataSerializer)
@@ -44,6 +44,17 @@ KisImageThumbnailStrokeStrategyBase::~KisImageThumbnailStrokeStrategyBase()
 {
 }
 
+void KisImageThumbnailStrokeStrategyBase::setIncrementalSource(KisPaintDeviceSP cachedThumbnailDevice, const QRegion &dirtyImageRegion)
+{
+    m_cachedThumbnailDevice = cachedThumbnailDevice;
+    m_dirtyImageRegion = dirtyImageRegion;
+}
+
+KisPaintDeviceSP KisImageThumbnailStrokeStrategyBase::oversampledThumbnailSnapshot() const
+{
+    return m_oversampledSnapshot;
+}
+
 void KisImageThumbnailStrokeStrategyBase::initStrokeCallback()
 {
     using KritaUtils::addJobConcurrent;
@@ -62,8 +73,38 @@ void KisImageThumbnailStrokeStrategyBase::initStrokeCallback()
 
     QVector<KisRunnableStrokeJobData*> jobs;
 
+    /**
+     * When a cache from the previous run is available, only the tiles
+     * that intersect the dirty region are rescaled from the
+     * projection; the clean ones are copied over from the cache. On a
+     * large canvas the dirty region of a stroke usually touches only a
+     * couple of tiles.
+     */
+    const bool incremental =
+        m_cachedThumbnailDevice &&
+        *m_cachedThumbnailDevice->colorSpace() == *m_device->colorSpace();
+
+    const qreal tileToImageX = qreal(imageRect.width()) / m_thumbnailOversampledSize.width();
+    const qreal tileToImageY = qreal(imageRect.height()) / m_thumbnailOversampledSize.height();
+
     QVector<QRect> tileRects = KritaUtils::splitRectIntoPatches(QRect(QPoint(0, 0), m_thumbnailOversampledSize), QSize(thumbnailTileDim, thumbnailTileDim));
     Q_FOREACH (const QRect &rc, tileRects) {
+        if (incremental) {
+            // the image rect this tile is downscaled from, grown a bit
+            // to account for the sampling radius of the scaler
+            const QRect tileImageRect =
+                QRectF(rc.x() * tileToImageX, rc.y() * tileToImageY,
+                       rc.width() * tileToImageX, rc.height() * tileToImageY)
+                    .toAlignedRect().adjusted(-1, -1, 1, 1);
+
+            if (!m_dirtyImageRegion.intersects(tileImageRect)) {
+                addJobConcurrent(jobs, [this, tileRect = rc] () {
+                    KisPainter::copyAreaOptimized(tileRect.topLeft(), m_cachedThumbnailDevice, m_thumbnailDevice, tileRect);
+                });
+                continue;
+            }
+        }
+
         addJobConcurrent(jobs, [this, tileRect = rc] () {
             //we aren't going to use oversample capability of createThumbnailDevice because it recomputes exact bounds for each small patch, which is
             //slow. We'll handle scaling separately.
@@ -73,6 +114,10 @@ void KisImageThumbnailStrokeStrategyBase::initStrokeCallback()
     }
 
     addJobSequential(jobs, [this] () {
+        // keep a (COW) snapshot of the oversampled thumbnail around;
+        // the downscale below works in-place
+        m_oversampledSnapshot = new KisPaintDevice(*m_thumbnailDevice);
+
         KoDummyUpdaterHolder updaterHolder;
         qreal xscale = m_thumbnailSize.width() / (qreal)m_thumbnailOversampledSize.width();
         qreal yscale = m_thumbnailSize.height() / (qreal)m_thumbnailOversampledSize.height();
@@ -95,4 +140,5 @@ void KisImageThumbnailStrokeStrategy::reportThumbnailGenerationCompleted(KisPain
                                             m_renderingIntent,
                                             m_conversionFlags);
     Q_EMIT thumbnailUpdated(overviewImage);
+    Q_EMIT thumbnailCacheUpdated(oversampledThumbnailSnapshot());
 }
@@ -10,6 +10,7 @@
 
 #include <QObject>
 #include <QRect>
+#include <QRegion>
 #include <QSize>
 #include <QImage>
 
@@ -34,12 +35,32 @@ public:
                                         KoColorConversionTransformation::ConversionFlags conversionFlags);
     ~KisImageThumbnailStrokeStrategyBase() override;
 
+    /**
+     * Enables incremental regeneration of the thumbnail: tiles of the
+     * oversampled thumbnail that do not intersect @p dirtyImageRegion
+     * (in image pixels) are copied from @p cachedThumbnailDevice
+     * instead of being rescaled from the projection. The cache must
+     * come from a previous run with the same thumbnail size and image
+     * bounds; the caller is responsible for dropping it when either
+     * changes. A colorspace mismatch is detected internally and falls
+     * back to a full regeneration.
+     */
+    void setIncrementalSource(KisPaintDeviceSP cachedThumbnailDevice, const QRegion &dirtyImageRegion);
+
 private:
     void initStrokeCallback() override;
 
 protected:
     virtual void reportThumbnailGenerationCompleted(KisPaintDeviceSP device, const QRect &rect) = 0;
 
+    /**
+     * A snapshot of the oversampled thumbnail device taken right
+     * before the final downscale; pass it back via
+     * setIncrementalSource() on the next run to regenerate only the
+     * dirty tiles
+     */
+    KisPaintDeviceSP oversampledThumbnailSnapshot() const;
+
 private:
     KisPaintDeviceSP m_device;
     QRect m_rect;
@@ -47,6 +68,9 @@ private:
     QSize m_thumbnailOversampledSize;
     bool m_isPixelArt {false};
     KisPaintDeviceSP m_thumbnailDevice;
+    KisPaintDeviceSP m_cachedThumbnailDevice;
+    QRegion m_dirtyImageRegion;
+    KisPaintDeviceSP m_oversampledSnapshot;
 
 protected:
     const KoColorProfile *m_profile;
@@ -67,6 +91,10 @@ protected:
 Q_SIGNALS:
     //Emitted when thumbnail is updated and overviewImage is fully generated.
     void thumbnailUpdated(QImage pixmap);
+
+    //Emitted alongside thumbnailUpdated() with the oversampled device
+    //that can seed the next incremental run
+    void thumbnailCacheUpdated(KisPaintDeviceSP device);
 };
 
 #endif // KISIMAGETHUMBNAILSTROKESTRATEGY_H
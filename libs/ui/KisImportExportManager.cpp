@@ -22,6 +22,10 @@
 #include <QSaveFile>
 #include <QGroupBox>
 #include <QFuture>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
 #include <QtConcurrent>
 
 #include <klocalizedstring.h>
@@ -223,10 +227,60 @@ QStringList KisImportExportManager::supportedMimeTypes(Direction direction)
     return QStringList();
 }
 
+namespace {
+KisImportExportFilter *createFilterInstance(const KoJsonTrader::Plugin &loader)
+{
+    KPluginFactory *factory = qobject_cast<KPluginFactory *>(loader.instance());
+
+    if (!factory) {
+        warnUI << loader.errorString();
+        return 0;
+    }
+
+    QObject* obj = factory->create<KisImportExportFilter>(0);
+    if (!obj || !obj->inherits("KisImportExportFilter")) {
+        delete obj;
+        return 0;
+    }
+
+    KisImportExportFilter *f = qobject_cast<KisImportExportFilter*>(obj);
+    if (!f) {
+        delete obj;
+        return 0;
+    }
+
+    f->setObjectName(loader.fileName());
+    return f;
+}
+}
+
 KisImportExportFilter *KisImportExportManager::filterForMimeType(const QString &mimetype, KisImportExportManager::Direction direction)
 {
+    /**
+     * Resolving the right plugin means scanning the metadata of every
+     * file filter, which batch conversions pay per file, so the winning
+     * plugin is remembered per mimetype and direction. The filter
+     * instance itself is still created per conversion: it carries
+     * per-conversion state like the update reporter.
+     */
+    static QMutex pluginCacheMutex;
+    static QMap<QString, KoJsonTrader::Plugin> pluginCache;
+
+    const QString cacheKey = QString("%1:%2").arg(direction == Export ? "export" : "import", mimetype);
+
+    QMutexLocker cacheLocker(&pluginCacheMutex);
+
+    if (pluginCache.contains(cacheKey)) {
+        KisImportExportFilter *filter = createFilterInstance(pluginCache[cacheKey]);
+        if (filter) {
+            filter->setMimeType(mimetype);
+        }
+        return filter;
+    }
+
     int weight = -1;
     KisImportExportFilter *filter = 0;
+    KoJsonTrader::Plugin winningPlugin;
     QList<KoJsonTrader::Plugin>list = KoJsonTrader::instance()->query("Krita/FileFilter", "");
 
     Q_FOREACH(const KoJsonTrader::Plugin &loader, list) {
@@ -235,22 +289,8 @@ KisImportExportFilter *KisImportExportManager::filterForMimeType(const QString &
 
         if (json.value(directionKey).toString().split(",", Qt::SkipEmptyParts).contains(mimetype)) {
 
-            KPluginFactory *factory = qobject_cast<KPluginFactory *>(loader.instance());
-
-            if (!factory) {
-                warnUI << loader.errorString();
-                continue;
-            }
-
-            QObject* obj = factory->create<KisImportExportFilter>(0);
-            if (!obj || !obj->inherits("KisImportExportFilter")) {
-                delete obj;
-                continue;
-            }
-
-            KisImportExportFilter *f = qobject_cast<KisImportExportFilter*>(obj);
+            KisImportExportFilter *f = createFilterInstance(loader);
             if (!f) {
-                delete obj;
                 continue;
             }
 
@@ -261,13 +301,16 @@ KisImportExportFilter *KisImportExportManager::filterForMimeType(const QString &
             if (w > weight) {
                 delete filter;
                 filter = f;
-                f->setObjectName(loader.fileName());
                 weight = w;
+                winningPlugin = loader;
+            } else {
+                delete f;
             }
         }
     }
 
     if (filter) {
+        pluginCache.insert(cacheKey, winningPlugin);
         filter->setMimeType(mimetype);
     }
     return filter;
@@ -754,9 +797,23 @@ KisImportExportErrorCode KisImportExportManager::doExport(const QString &locatio
                                                           KisPropertiesConfigurationSP exportConfiguration,
                                                           const QString alsoAsKraLocation)
 {
+    /**
+     * Autosaving runs concurrently with the artist's work, so the
+     * saving thread steps back in priority for its duration and the
+     * rendering threads keep the cores.
+     */
+    const bool lowerPriority = m_document->isAutosaving();
+    if (lowerPriority) {
+        QThread::currentThread()->setPriority(QThread::LowPriority);
+    }
+
     KisImportExportErrorCode status =
             doExportImpl(location, filter, exportConfiguration);
 
+    if (lowerPriority) {
+        QThread::currentThread()->setPriority(QThread::NormalPriority);
+    }
+
     if (!alsoAsKraLocation.isNull() && status.isOk()) {
         QByteArray mime = m_document->nativeFormatMimeType();
         QSharedPointer<KisImportExportFilter> filter(
@@ -791,6 +848,69 @@ KisImportExportErrorCode KisImportExportManager::doExport(const QString &locatio
 #define USE_QSAVEFILE
 #endif
 
+namespace {
+/**
+ * Forwards all I/O to the real save file, but keeps the write rate
+ * under a budget by briefly sleeping on the saving thread whenever it
+ * runs ahead. Used for autosaving only, so a background checkpoint
+ * doesn't saturate the disk under the artist's foreground work;
+ * interactive saves are never throttled.
+ */
+class ThrottledSaveDevice : public QIODevice
+{
+public:
+    ThrottledSaveDevice(QIODevice *target, qint64 bytesPerSecond)
+        : m_target(target),
+          m_bytesPerSecond(bytesPerSecond)
+    {
+        m_timer.start();
+    }
+
+    bool isSequential() const override {
+        return m_target->isSequential();
+    }
+
+    qint64 size() const override {
+        return m_target->size();
+    }
+
+    qint64 pos() const override {
+        return m_target->pos();
+    }
+
+    bool seek(qint64 pos) override {
+        return QIODevice::seek(pos) && m_target->seek(pos);
+    }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override {
+        return m_target->read(data, maxSize);
+    }
+
+    qint64 writeData(const char *data, qint64 maxSize) override {
+        const qint64 written = m_target->write(data, maxSize);
+
+        if (written > 0) {
+            m_bytesWritten += written;
+
+            const qint64 budgetMs = m_bytesWritten * 1000 / m_bytesPerSecond;
+            const qint64 aheadMs = budgetMs - m_timer.elapsed();
+            if (aheadMs > 0) {
+                QThread::msleep(qMin<qint64>(aheadMs, 500));
+            }
+        }
+
+        return written;
+    }
+
+private:
+    QIODevice *m_target;
+    qint64 m_bytesPerSecond;
+    qint64 m_bytesWritten {0};
+    QElapsedTimer m_timer;
+};
+}
+
 KisImportExportErrorCode KisImportExportManager::doExportImpl(const QString &location, QSharedPointer<KisImportExportFilter> filter, KisPropertiesConfigurationSP exportConfiguration)
 {
 #ifdef USE_QSAVEFILE
@@ -809,7 +929,18 @@ KisImportExportErrorCode KisImportExportManager::doExportImpl(const QString &loc
         return result;
     }
 
-    KisImportExportErrorCode status = filter->convert(m_document, &file, exportConfiguration);
+    KisImportExportErrorCode status;
+
+    const int writeBudgetMiB = KisConfig(true).autoSaveWriteBudget();
+
+    if (m_document->isAutosaving() && filter->supportsIO() && writeBudgetMiB > 0) {
+        ThrottledSaveDevice throttledFile(&file, qint64(writeBudgetMiB) * 1024 * 1024);
+        throttledFile.open(QIODevice::WriteOnly);
+        status = filter->convert(m_document, &throttledFile, exportConfiguration);
+        throttledFile.close();
+    } else {
+        status = filter->convert(m_document, &file, exportConfiguration);
+    }
 
     if (filter->supportsIO()) {
         if (!status.isOk()) {
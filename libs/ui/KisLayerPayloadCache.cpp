@@ -0,0 +1,158 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisLayerPayloadCache.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QVector>
+
+#include <algorithm>
+
+#include "kis_paint_device.h"
+#include "kis_datamanager.h"
+#include "tiles3/kis_tile.h"
+
+namespace {
+
+/**
+ * The pinned payloads are compressed tile streams, i.e. roughly the
+ * on-disk size of the layers. The limit keeps the cache from doubling
+ * the memory footprint of huge documents; layers that do not fit are
+ * simply re-serialized on every save.
+ */
+const qint64 maxTotalPayloadSize = 256LL * 1024 * 1024;
+
+QVector<KisTileSP> takeSortedSnapshot(KisPaintDeviceSP device)
+{
+    QVector<KisTileSP> tiles = device->dataManager()->tilesSnapshot();
+
+    /**
+     * The iteration order of the tile hash table is not defined, so
+     * sort the tiles to make the snapshots comparable
+     */
+    std::sort(tiles.begin(), tiles.end(),
+        [] (const KisTileSP &lhs, const KisTileSP &rhs) {
+            return lhs->row() != rhs->row() ?
+                lhs->row() < rhs->row() :
+                lhs->col() < rhs->col();
+        });
+
+    return tiles;
+}
+
+}
+
+struct KisLayerPayloadCache::Private
+{
+    struct Entry {
+        QVector<KisTileSP> tiles;
+        quint32 pixelSize = 0;
+        QByteArray payload;
+        bool touched = false;
+    };
+
+    QMutex mutex;
+    QHash<QString, Entry> entries;
+    qint64 totalPayloadSize = 0;
+};
+
+KisLayerPayloadCache::KisLayerPayloadCache()
+    : m_d(new Private)
+{
+}
+
+KisLayerPayloadCache::~KisLayerPayloadCache()
+{
+}
+
+bool KisLayerPayloadCache::tryFetchPayload(const QString &key, KisPaintDeviceSP device, QByteArray *payload)
+{
+    QMutexLocker locker(&m_d->mutex);
+
+    auto it = m_d->entries.find(key);
+    if (it == m_d->entries.end()) return false;
+
+    /**
+     * The tile comparison cannot tell apart two devices that have no
+     * tiles at all, while their serialized headers still differ
+     */
+    if (it->pixelSize != device->pixelSize()) return false;
+
+    const QVector<KisTileSP> tiles = takeSortedSnapshot(device);
+
+    if (tiles.size() != it->tiles.size()) return false;
+
+    for (int i = 0; i < tiles.size(); i++) {
+        const KisTileSP tile = tiles[i];
+        const KisTileSP cachedTile = it->tiles[i];
+
+        if (tile->col() != cachedTile->col() ||
+            tile->row() != cachedTile->row() ||
+            tile->tileData() != cachedTile->tileData()) {
+
+            return false;
+        }
+    }
+
+    *payload = it->payload;
+    it->touched = true;
+    return true;
+}
+
+void KisLayerPayloadCache::storePayload(const QString &key, KisPaintDeviceSP device, const QByteArray &payload)
+{
+    QMutexLocker locker(&m_d->mutex);
+
+    auto it = m_d->entries.find(key);
+    if (it != m_d->entries.end()) {
+        m_d->totalPayloadSize -= it->payload.size();
+        m_d->entries.erase(it);
+    }
+
+    if (m_d->totalPayloadSize + payload.size() > maxTotalPayloadSize) return;
+
+    Private::Entry entry;
+    entry.tiles = takeSortedSnapshot(device);
+    entry.pixelSize = device->pixelSize();
+    entry.payload = payload;
+    entry.touched = true;
+
+    m_d->totalPayloadSize += payload.size();
+    m_d->entries.insert(key, entry);
+}
+
+void KisLayerPayloadCache::beginSave()
+{
+    QMutexLocker locker(&m_d->mutex);
+
+    for (auto it = m_d->entries.begin(); it != m_d->entries.end(); ++it) {
+        it->touched = false;
+    }
+}
+
+void KisLayerPayloadCache::endSave()
+{
+    QMutexLocker locker(&m_d->mutex);
+
+    for (auto it = m_d->entries.begin(); it != m_d->entries.end();) {
+        if (!it->touched) {
+            m_d->totalPayloadSize -= it->payload.size();
+            it = m_d->entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void KisLayerPayloadCache::clear()
+{
+    QMutexLocker locker(&m_d->mutex);
+
+    m_d->entries.clear();
+    m_d->totalPayloadSize = 0;
+}
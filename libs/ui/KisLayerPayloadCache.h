@@ -0,0 +1,76 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_LAYER_PAYLOAD_CACHE_H
+#define KIS_LAYER_PAYLOAD_CACHE_H
+
+#include <QByteArray>
+#include <QScopedPointer>
+#include <QString>
+
+#include "kritaui_export.h"
+#include "kis_types.h"
+
+/**
+ * @brief A cache of the serialized tile streams written into a .kra
+ * archive, kept between two saves of the same document.
+ *
+ * Serializing the layer data dominates the cost of saving, even though
+ * most layers are usually unchanged since the previous save. The cache
+ * keeps the byte stream written for every layer device and lets the
+ * next save reuse it when the device has not changed, so an autosave
+ * after a small change only re-serializes the layers that were
+ * actually touched.
+ *
+ * Background saving clones the image, so two consecutive saves see
+ * different KisPaintDevice objects even for unchanged layers. The
+ * devices of an unchanged layer still share their copy-on-write tile
+ * data, therefore a device is recognized by comparing its tile list
+ * (tile coordinates plus tile-data pointers) against a snapshot pinned
+ * at the previous save. Pinning the tiles guarantees the pointers
+ * cannot be recycled while the entry is alive; it costs no extra
+ * memory as long as the original layer still references the same data.
+ *
+ * The cache is shared between a document and its saving clones and is
+ * accessed from the background saving thread, hence the internal
+ * locking.
+ */
+class KRITAUI_EXPORT KisLayerPayloadCache
+{
+public:
+    KisLayerPayloadCache();
+    ~KisLayerPayloadCache();
+
+    /**
+     * Fetches the payload stored under \p key at a previous save, if
+     * \p device still carries the same tile data. Returns true and
+     * initializes \p payload on success.
+     */
+    bool tryFetchPayload(const QString &key, KisPaintDeviceSP device, QByteArray *payload);
+
+    /**
+     * Stores the payload that was written for \p device under \p key.
+     * The entry is dropped silently when it does not fit into the
+     * memory limit of the cache.
+     */
+    void storePayload(const QString &key, KisPaintDeviceSP device, const QByteArray &payload);
+
+    /**
+     * Mark the beginning/end of one save operation. Entries that were
+     * neither fetched nor stored between the two calls belong to
+     * removed nodes and are pruned on endSave().
+     */
+    void beginSave();
+    void endSave();
+
+    void clear();
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif
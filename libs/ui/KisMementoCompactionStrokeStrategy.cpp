@@ -0,0 +1,48 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#include "KisMementoCompactionStrokeStrategy.h"
+
+#include "kis_image_config.h"
+#include "tiles3/kis_tile_data_store.h"
+
+namespace {
+
+/**
+ * Compaction starts when the historical data outgrows this share of
+ * the tiles hard limit...
+ */
+const qreal historicalMemoryThreshold = 0.25;
+
+/**
+ * ...and every idle invocation frees at most this much, to keep the
+ * idle stroke short. The idle watcher restarts us if there is more.
+ */
+const qint64 compactionSliceMiB = 64;
+
+}
+
+KisMementoCompactionStrokeStrategy::KisMementoCompactionStrokeStrategy()
+    : KisIdleTaskStrokeStrategy(QLatin1String("memento-compaction"))
+{
+}
+
+KisMementoCompactionStrokeStrategy::~KisMementoCompactionStrokeStrategy() = default;
+
+void KisMementoCompactionStrokeStrategy::initStrokeCallback()
+{
+    KisIdleTaskStrokeStrategy::initStrokeCallback();
+
+    KisTileDataStore *store = KisTileDataStore::instance();
+
+    const KisTileDataStore::MemoryStatistics stats = store->memoryStatistics();
+    const qint64 thresholdBytes =
+        qint64(historicalMemoryThreshold *
+               KisImageConfig(true).tilesHardLimit()) << 20;
+
+    if (stats.historicalMemorySize > thresholdBytes) {
+        store->compactHistoricalTiles(MiB_TO_METRIC(compactionSliceMiB));
+    }
+}
@@ -0,0 +1,35 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KISMEMENTOCOMPACTIONSTROKESTRATEGY_H
+#define KISMEMENTOCOMPACTIONSTROKESTRATEGY_H
+
+#include "KisIdleTaskStrokeStrategy.h"
+
+/**
+ * An idle task that re-compresses historical tile data — old memento
+ * revisions kept only for the undo stack — into the swap. After a few
+ * thousand strokes on a big document the historical data can grow to
+ * multiple gigabytes; waiting for the hard memory limit to kick in
+ * means the swap-out cost is paid in the middle of painting. Instead
+ * this task compacts a bounded slice of it whenever the image is
+ * idle, so long sessions stay inside physical RAM.
+ *
+ * The task is a cheap no-op while the historical memory stays below
+ * a threshold, and each invocation frees at most a fixed slice to
+ * keep the idle stroke short and cancellable.
+ */
+class KRITAUI_EXPORT KisMementoCompactionStrokeStrategy : public KisIdleTaskStrokeStrategy
+{
+    Q_OBJECT
+public:
+    KisMementoCompactionStrokeStrategy();
+    ~KisMementoCompactionStrokeStrategy() override;
+
+private:
+    void initStrokeCallback() override;
+};
+
+#endif // KISMEMENTOCOMPACTIONSTROKESTRATEGY_H
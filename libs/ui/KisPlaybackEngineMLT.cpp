@@ -109,9 +109,10 @@ struct FrameRenderingStats
  *  simultaneously in a separate thread.
  */
 static void mltOnConsumerFrameShow(mlt_consumer c, void* p_self, mlt_frame p_frame) {
+    Q_UNUSED(c);
+
     KisPlaybackEngineMLT* self = static_cast<KisPlaybackEngineMLT*>(p_self);
     Mlt::Frame frame(p_frame);
-    Mlt::Consumer consumer(c);
     const int position = frame.get_position();
 
     KisPlaybackEngineMLT::FrameWaitingInterface *iface = self->frameWaitingInterface();
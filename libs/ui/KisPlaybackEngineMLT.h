@@ -31,6 +31,13 @@ enum PlaybackMode {
  * If MLT is unavailable or unwanted, Krita can instead use KisPlaybackEngineQT
  * which may be simpler but has different characteristics and is not designed with
  * audio-video synchronization in mind.
+ *
+ * Note that only audio flows through MLT: video frames are rendered by
+ * the regular canvas pipeline and never cross the MLT boundary, neither
+ * during preview playback nor on export (which muxes through an external
+ * FFmpeg process). MLT merely paces the canvas via consumer-frame-show
+ * callbacks, so there is no pixel-plane exchange (and hence no copy) to
+ * optimize on this boundary.
  */
 class KRITAUI_EXPORT KisPlaybackEngineMLT : public KisPlaybackEngine
 {
@@ -116,7 +116,7 @@ void KisPresetShadowUpdater::slotCanvasResourceChanged(int key, const QVariant &
             m_d->proxyConnections.addConnection(
                 m_d->currentUpdateProxy, SIGNAL(sigSettingsChangedUncompressedEarlyWarning()),
                 this, SLOT(slotPresetChanged()));
-            slotPresetChanged();
+            slotPresetSwitched();
         } else {
             m_d->view->canvasResourceProvider()->resourceManager()->
                     setResource(KoCanvasResource::CurrentPaintOpPresetCache,
@@ -143,6 +143,27 @@ void KisPresetShadowUpdater::slotPresetChanged()
 
 }
 
+void KisPresetShadowUpdater::slotPresetSwitched()
+{
+    /**
+     * In contrast to tweaking the settings of the current preset
+     * (which comes as a stream of change notifications while the user
+     * drags a slider), switching to another preset is a discrete
+     * event, so there is nothing to compress. Start the background
+     * preparation right away, otherwise a stroke made within the
+     * compressor's timeout would still pay the full cost of the cache
+     * generation on the first dab.
+     */
+    m_d->sequenceNumber++;
+    m_d->updateStartCompressor.stop();
+
+    m_d->view->canvasResourceProvider()->resourceManager()->
+            setResource(KoCanvasResource::CurrentPaintOpPresetCache,
+                        QVariant::fromValue(KoResourceCacheInterfaceSP()));
+
+    slotStartPresetPreparation();
+}
+
 void KisPresetShadowUpdater::slotStartPresetPreparation()
 {
     if (m_d->currentPreset) {
@@ -24,6 +24,7 @@ public:
 public Q_SLOTS:
     void slotCanvasResourceChanged(int key, const QVariant & value);
     void slotPresetChanged();
+    void slotPresetSwitched();
     void slotStartPresetPreparation();
 
     void slotCacheGenerationFinished(int sequenceNumber,
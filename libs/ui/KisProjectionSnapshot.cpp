@@ -0,0 +1,105 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#include "KisProjectionSnapshot.h"
+
+#include <QFile>
+#include <QSaveFile>
+
+#include <cstring>
+
+namespace {
+
+struct SnapshotHeader {
+    char magic[8]; // "KRAPSNAP"
+    quint32 version;
+    qint32 width;
+    qint32 height;
+    qint32 format; // QImage::Format
+    qint32 bytesPerLine;
+};
+
+const char snapshotMagic[8] = {'K', 'R', 'A', 'P', 'S', 'N', 'A', 'P'};
+const quint32 snapshotVersion = 1;
+
+}
+
+QString KisProjectionSnapshot::snapshotPath(const QString &autoSaveFilePath)
+{
+    return autoSaveFilePath + ".psnap";
+}
+
+bool KisProjectionSnapshot::write(const QString &snapshotFilePath, const QImage &projection)
+{
+    if (projection.isNull()) return false;
+
+    SnapshotHeader header;
+    memcpy(header.magic, snapshotMagic, sizeof(header.magic));
+    header.version = snapshotVersion;
+    header.width = projection.width();
+    header.height = projection.height();
+    header.format = projection.format();
+    header.bytesPerLine = projection.bytesPerLine();
+
+    QSaveFile file(snapshotFilePath);
+    if (!file.open(QIODevice::WriteOnly)) return false;
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(projection.constBits()),
+               qint64(header.bytesPerLine) * header.height);
+
+    return file.commit();
+}
+
+QImage KisProjectionSnapshot::loadScaled(const QString &snapshotFilePath, const QSize &maxSize)
+{
+    QFile file(snapshotFilePath);
+    if (!file.exists() || !file.open(QIODevice::ReadOnly)) return QImage();
+
+    const qint64 fileSize = file.size();
+    if (fileSize <= qint64(sizeof(SnapshotHeader))) return QImage();
+
+    uchar *mapped = file.map(0, fileSize);
+    if (!mapped) return QImage();
+
+    SnapshotHeader header;
+    memcpy(&header, mapped, sizeof(header));
+
+    if (memcmp(header.magic, snapshotMagic, sizeof(header.magic)) != 0 ||
+        header.version != snapshotVersion ||
+        header.width <= 0 || header.height <= 0 ||
+        header.bytesPerLine <= 0 ||
+        header.format <= QImage::Format_Invalid ||
+        header.format >= QImage::NImageFormats ||
+        fileSize < qint64(sizeof(header)) + qint64(header.bytesPerLine) * header.height) {
+
+        file.unmap(mapped);
+        return QImage();
+    }
+
+    /**
+     * The wrapper image aliases the mapped pages, so no pixel data is
+     * copied or decoded; scaled() then touches only the pages it
+     * actually reads and produces an independent image we can safely
+     * return after unmapping.
+     */
+    const QImage wrapper(mapped + sizeof(header),
+                         header.width, header.height,
+                         header.bytesPerLine,
+                         QImage::Format(header.format));
+
+    QImage result = wrapper.scaled(maxSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+    file.unmap(mapped);
+    return result;
+}
+
+void KisProjectionSnapshot::removeFor(const QString &autoSaveFilePath)
+{
+    const QString sidecar = snapshotPath(autoSaveFilePath);
+    if (QFile::exists(sidecar)) {
+        QFile::remove(sidecar);
+    }
+}
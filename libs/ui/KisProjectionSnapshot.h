@@ -0,0 +1,58 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KISPROJECTIONSNAPSHOT_H
+#define KISPROJECTIONSNAPSHOT_H
+
+#include "kritaui_export.h"
+
+#include <QImage>
+#include <QString>
+
+/**
+ * Reads and writes raw, memory-mappable dumps of a document's merged
+ * projection, stored as sidecar files next to the autosave .kra.
+ *
+ * The autosave archive already contains a PNG preview, but getting at
+ * it means opening the ZIP and decoding the PNG for every candidate
+ * file, which makes session restore and the autosave recovery dialog
+ * noticeably sluggish when many documents are listed. The sidecar
+ * stores the pixels verbatim (a small header followed by the raw
+ * QImage bits), so a reader can mmap the file and hand the pages
+ * straight to QImage without any decoding.
+ *
+ * The snapshot is refreshed on every autosave and removed together
+ * with the autosave file, so it never outlives the data it previews.
+ */
+class KRITAUI_EXPORT KisProjectionSnapshot
+{
+public:
+    /**
+     * The path of the snapshot sidecar accompanying \p autoSaveFilePath
+     */
+    static QString snapshotPath(const QString &autoSaveFilePath);
+
+    /**
+     * Writes \p projection into \p snapshotFilePath atomically.
+     * Returns false when the file could not be written; the caller is
+     * expected to ignore that (the snapshot is a pure optimization).
+     */
+    static bool write(const QString &snapshotFilePath, const QImage &projection);
+
+    /**
+     * Memory-maps \p snapshotFilePath and returns the stored
+     * projection scaled down to fit \p maxSize. Returns a null image
+     * when the file is missing or malformed, in which case the caller
+     * should fall back to the preview inside the autosave archive.
+     */
+    static QImage loadScaled(const QString &snapshotFilePath, const QSize &maxSize);
+
+    /**
+     * Removes the snapshot accompanying \p autoSaveFilePath, if any
+     */
+    static void removeFor(const QString &autoSaveFilePath);
+};
+
+#endif // KISPROJECTIONSNAPSHOT_H
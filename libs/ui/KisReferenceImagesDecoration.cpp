@@ -49,6 +49,36 @@ struct KisReferenceImagesDecoration::Private {
         updateBuffer(dirtyWidgetRect, dirtyImageRect);
     }
 
+    /**
+     * Fast path for panning: when the new transform differs from the
+     * previous one by a pure translation and the shifted buffer still
+     * covers every visible reference pixel, just move the buffer
+     * instead of re-rendering all the references.
+     */
+    bool tryTranslateBuffer(const QTransform &newTransform)
+    {
+        if (buffer.image.isNull()) return false;
+
+        KisSharedPtr<KisReferenceImagesLayer> strongLayer = layer.toStrongRef();
+        if (strongLayer.isNull()) return false;
+
+        const QPointF delta(newTransform.dx() - previousTransform.dx(),
+                            newTransform.dy() - previousTransform.dy());
+
+        QTransform translatedTransform = previousTransform;
+        translatedTransform *= QTransform::fromTranslate(delta.x(), delta.y());
+        if (!KisAlgebra2D::fuzzyMatrixCompare(translatedTransform, newTransform, 1e-4)) return false;
+
+        const QRectF neededWidgetRect =
+            q->view()->viewConverter()->imageToWidget(strongLayer->boundingImageRect())
+                .intersected(QRectF(q->view()->rect()));
+
+        if (!buffer.bounds().translated(delta).contains(neededWidgetRect)) return false;
+
+        buffer.position += delta;
+        return true;
+    }
+
 private:
     void updateBuffer(QRectF widgetRect, QRectF imageRect)
     {
@@ -130,10 +160,16 @@ void KisReferenceImagesDecoration::drawDecoration(QPainter &gc, const QRectF &/*
 
         QTransform transform = converter->imageToWidgetTransform();
         if (d->previousViewSize != viewSize || !KisAlgebra2D::fuzzyMatrixCompare(transform, d->previousTransform, 1e-4)) {
+            const bool bufferMoved =
+                d->previousViewSize == viewSize && d->tryTranslateBuffer(transform);
+
             d->previousViewSize = viewSize;
             d->previousTransform = transform;
-            d->buffer.image = QImage();
-            d->updateBufferByWidgetCoordinates(QRectF(QPointF(0,0), viewSize));
+
+            if (!bufferMoved) {
+                d->buffer.image = QImage();
+                d->updateBufferByWidgetCoordinates(QRectF(QPointF(0,0), viewSize));
+            }
         }
 
         if (!d->buffer.image.isNull()) {
@@ -122,6 +122,8 @@
 #include "imagesize/imagesize.h"
 #include <KoToolDocker.h>
 #include <KisIdleTasksManager.h>
+#include "KisMementoCompactionStrokeStrategy.h"
+#include "KisVisibilityToggleSnapshotStrokeStrategy.h"
 #include <KisImageBarrierLock.h>
 #include <KisTextPropertiesManager.h>
 #include <kis_selection.h>
@@ -232,6 +234,8 @@ public:
     KisMirrorManager mirrorManager;
     KisInputManager inputManager;
     KisIdleTasksManager idleTasksManager;
+    KisIdleTasksManager::TaskGuard mementoCompactionTaskGuard;
+    KisIdleTasksManager::TaskGuard visibilityToggleSnapshotTaskGuard;
     KisTextPropertiesManager textPropertyManager;
 
     KisSignalAutoConnectionsStore viewConnections;
@@ -283,6 +287,20 @@ KisViewManager::KisViewManager(QWidget *parent, KisKActionCollection *_actionCol
     createActions();
     setupManagers();
 
+    // compact historical (undo-only) tile data while the image is idle
+    d->mementoCompactionTaskGuard = d->idleTasksManager.addIdleTaskWithGuard(
+        [] (KisImageSP image) {
+            Q_UNUSED(image);
+            return new KisMementoCompactionStrokeStrategy();
+        });
+
+    // snapshot the projection of a freshly toggled layer, so
+    // before/after visibility flips become instant blits
+    d->visibilityToggleSnapshotTaskGuard = d->idleTasksManager.addIdleTaskWithGuard(
+        [] (KisImageSP image) {
+            return new KisVisibilityToggleSnapshotStrokeStrategy(image);
+        });
+
     // These initialization functions must wait until KisViewManager ctor is complete.
     d->statusBar.setup();
     d->persistentImageProgressUpdater =
@@ -779,6 +797,10 @@ void KisViewManager::createActions()
     d->rulersTrackMouseAction->setChecked(cfg.rulersTrackMouse());
     connect(d->rulersTrackMouseAction, SIGNAL(toggled(bool)), SLOT(slotSaveRulersTrackMouseState(bool)));
 
+    tAction = actionManager()->createAction("view_toggle_perf_hud");
+    tAction->setChecked(cfg.enableCanvasPerfHud());
+    connect(tAction, SIGNAL(toggled(bool)), SLOT(slotTogglePerfHud(bool)));
+
     d->zoomTo100pct = actionManager()->createAction("zoom_to_100pct");
 
     d->zoomIn = actionManager()->createStandardAction(KStandardAction::ZoomIn, 0, "");
@@ -1604,6 +1626,18 @@ void KisViewManager::slotSaveRulersTrackMouseState(bool value)
     cfg.setRulersTrackMouse(value);
 }
 
+void KisViewManager::slotTogglePerfHud(bool value)
+{
+    KisConfig cfg(false);
+    cfg.setEnableCanvasPerfHud(value);
+
+    /**
+     * The canvases listen to the config notifier and attach or remove
+     * the debug overlay decoration themselves.
+     */
+    KisConfigNotifier::instance()->notifyConfigChanged();
+}
+
 void KisViewManager::setShowFloatingMessage(bool show)
 {
     d->showFloatingMessage = show;
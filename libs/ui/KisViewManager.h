@@ -258,6 +258,7 @@ private Q_SLOTS:
     void slotUpdatePixelGridAction();
     void slotSaveShowRulersState(bool value);
     void slotSaveRulersTrackMouseState(bool value);
+    void slotTogglePerfHud(bool value);
     void slotResetRotation();
     void slotResetDisplay();
     void slotToggleFullscreen();
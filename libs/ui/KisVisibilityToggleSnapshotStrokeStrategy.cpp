@@ -0,0 +1,41 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#include "KisVisibilityToggleSnapshotStrokeStrategy.h"
+
+#include "kis_image.h"
+#include "kis_node.h"
+#include "kis_paint_device.h"
+#include "KisVisibilityToggleProjectionCache.h"
+
+KisVisibilityToggleSnapshotStrokeStrategy::KisVisibilityToggleSnapshotStrokeStrategy(KisImageSP image)
+    : KisIdleTaskStrokeStrategy(QLatin1String("visibility-toggle-snapshot"))
+    , m_image(image)
+{
+}
+
+KisVisibilityToggleSnapshotStrokeStrategy::~KisVisibilityToggleSnapshotStrokeStrategy() = default;
+
+void KisVisibilityToggleSnapshotStrokeStrategy::initStrokeCallback()
+{
+    KisIdleTaskStrokeStrategy::initStrokeCallback();
+
+    KisVisibilityToggleProjectionCache *cache =
+        m_image->visibilityToggleProjectionCache();
+
+    KisNodeSP node = cache->trackedNode();
+    if (!node) return;
+
+    const bool visibility = node->visible();
+    if (cache->hasSnapshot(node, visibility)) return;
+
+    /**
+     * We are inside an idle stroke, so the projection is fully
+     * recomposited for the node's current visibility state and the
+     * copy is a cheap copy-on-write one
+     */
+    KisPaintDeviceSP snapshot = new KisPaintDevice(*m_image->projection());
+    cache->storeSnapshot(node, visibility, snapshot);
+}
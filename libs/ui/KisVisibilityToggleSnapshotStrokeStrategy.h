@@ -0,0 +1,38 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KISVISIBILITYTOGGLESNAPSHOTSTROKESTRATEGY_H
+#define KISVISIBILITYTOGGLESNAPSHOTSTROKESTRATEGY_H
+
+#include "KisIdleTaskStrokeStrategy.h"
+
+/**
+ * An idle task that feeds KisVisibilityToggleProjectionCache: when
+ * the image becomes idle after a layer visibility toggle, it takes a
+ * copy-on-write snapshot of the current projection and stores it for
+ * the toggled node's current visibility state. Since idle tasks only
+ * run on a quiescent image, the snapshot is guaranteed to be
+ * consistent with the node's state. Once both states of a node have
+ * been captured over a toggle cycle, further before/after flips of
+ * that node are served as instant blits.
+ *
+ * The task is a cheap no-op when no node is being tracked or the
+ * snapshot for the current state is already present.
+ */
+class KRITAUI_EXPORT KisVisibilityToggleSnapshotStrokeStrategy : public KisIdleTaskStrokeStrategy
+{
+    Q_OBJECT
+public:
+    KisVisibilityToggleSnapshotStrokeStrategy(KisImageSP image);
+    ~KisVisibilityToggleSnapshotStrokeStrategy() override;
+
+private:
+    void initStrokeCallback() override;
+
+private:
+    KisImageSP m_image;
+};
+
+#endif // KISVISIBILITYTOGGLESNAPSHOTSTROKESTRATEGY_H
@@ -29,6 +29,7 @@
 #include <QThread>
 #include "kis_signal_compressor_with_param.h"
 #include "KisImageBarrierLock.h"
+#include "KisBlockBackgroundFrameGenerationLock.h"
 #include "kis_layer_utils.h"
 #include "KisDecoratedNodeInterface.h"
 #include "kis_keyframe_channel.h"
@@ -122,6 +123,19 @@ public:
         const KisTimeSpan range = m_canvas->image()->animationInterface()->activePlaybackRange();
         setPlaybackRange(range);
 
+        /**
+         * Reserve the image workers for playback: while the
+         * environment is active, the background cache populator is
+         * postponed, so regeneration of frames behind the playhead
+         * cannot steal the updater threads from frame display. The
+         * pre-render pass below warms the visible range before the
+         * first frame is shown anyway.
+         */
+        if (!m_backgroundGenerationBlock) {
+            m_backgroundGenerationBlock.reset(
+                new KisBlockBackgroundFrameGenerationLock(m_canvas->image()->animationInterface()));
+        }
+
         // Initialize and optimize playback environment...
         if (m_canvas->frameCache()) {
             KisImageConfig cfg(true);
@@ -177,6 +191,7 @@ public:
 
     void restore() {
         m_cancelStrokeConnections.clear();
+        m_backgroundGenerationBlock.reset();
 
         if (m_canvas) {
             if (m_canvas->frameCache()) {
@@ -202,6 +217,7 @@ private:
     KisSignalAutoConnectionsStore m_cancelStrokeConnections;
     SingleShotSignal m_cancelTrigger;
     QVector<KisNodeWSP> m_disabledDecoratedNodes;
+    QScopedPointer<KisBlockBackgroundFrameGenerationLock> m_backgroundGenerationBlock;
 
     KisCanvas2* m_canvas;
 
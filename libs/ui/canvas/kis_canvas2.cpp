@@ -41,6 +41,8 @@
 #include "kis_prescaled_projection.h"
 #include "kis_image.h"
 #include "KisImageBarrierLock.h"
+#include "KisSwapPrefetchJob.h"
+#include "tiles3/kis_tile_data_store.h"
 #include "kis_undo_adapter.h"
 #include "flake/kis_shape_layer.h"
 #include "kis_canvas_resource_provider.h"
@@ -179,6 +181,7 @@ public:
     KisAnimationFrameCacheSP frameCache;
     bool lodPreferredInImage = false;
     bool bootstrapLodBlocked = false;
+    int lastPreferredLod = -1;
     QPointer<KoShapeManager> currentlyActiveShapeManager;
     KisInputActionGroupsMask inputActionGroupsMask = AllActionGroup;
 
@@ -321,7 +324,8 @@ void KisCanvas2::initializeFpsDecoration()
     KisConfig cfg(true);
 
     const bool shouldShowDebugOverlay =
-        (canvasIsOpenGL() && cfg.enableOpenGLFramerateLogging()) ||
+        (canvasIsOpenGL() && (cfg.enableOpenGLFramerateLogging() ||
+                              cfg.enableCanvasPerfHud())) ||
         cfg.enableBrushSpeedLogging();
 
     if (shouldShowDebugOverlay && !decoration(KisFpsDecoration::idTag)) {
@@ -880,6 +884,8 @@ void KisCanvas2::updateCanvasProjection()
     KisUpdateInfoList originalInfoObjects;
     m_d->projectionUpdatesCompressor.takeUpdateInfo(originalInfoObjects);
 
+    KisOpenglCanvasDebugger::instance()->notifyUpdateQueueDepth(originalInfoObjects.size());
+
     for (auto it = originalInfoObjects.constBegin();
          it != originalInfoObjects.constEnd();
          ++it) {
@@ -972,6 +978,7 @@ void KisCanvas2::slotDoCanvasUpdate()
      */
     if (m_d->canvasWidget->isBusy()) {
         // just restarting the timer
+        KisOpenglCanvasDebugger::instance()->notifyCanvasUpdatePostponed();
         m_d->canvasUpdateCompressor.start();
         return;
     }
@@ -1139,6 +1146,20 @@ void KisCanvas2::slotUpdateRegionOfInterest()
 
     if (m_d->regionOfInterest != oldRegionOfInterest) {
         Q_EMIT sigRegionOfInterestChanged(m_d->regionOfInterest);
+
+        /**
+         * Predictively swap in the projection tiles around the
+         * viewport, so that panning over a partially swapped
+         * document doesn't stall on synchronous decompression.
+         * Only bother when some tiles actually live in the swap.
+         */
+        KisImageSP image = this->image();
+        KisTileDataStore *store = KisTileDataStore::instance();
+
+        if (image && store->numTiles() != store->numTilesInMemory()) {
+            image->addSpontaneousJob(
+                new KisSwapPrefetchJob(image->projection(), m_d->regionOfInterest));
+        }
     }
 }
 
@@ -1177,13 +1198,37 @@ void KisCanvas2::notifyLevelOfDetailChange()
     KisImageSP image = this->image();
 
     if (m_d->bootstrapLodBlocked || !m_d->lodIsSupported()) {
+        m_d->lastPreferredLod = -1;
         image->setLodPreferences(KisLodPreferences(KisLodPreferences::None, 0));
     } else {
         const qreal effectiveZoom = m_d->coordinatesConverter->effectiveZoom();
 
         KisConfig cfg(true);
         const int maxLod = cfg.numMipmapLevels();
-        const int lod = KisLodTransform::scaleToLod(effectiveZoom, maxLod);
+        int lod = KisLodTransform::scaleToLod(effectiveZoom, maxLod);
+
+        /**
+         * Switching the level means regenerating the lod planes and
+         * re-uploading the textures, which shows up as a visible
+         * blur-then-sharpen pop. Zooming near a level boundary would
+         * trigger that on every small zoom change, so keep the
+         * previous level while the zoom stays within a small
+         * hysteresis band around the boundary.
+         */
+        if (m_d->lastPreferredLod >= 0 &&
+            lod != m_d->lastPreferredLod &&
+            qAbs(lod - m_d->lastPreferredLod) == 1) {
+
+            const qreal lodF = qMax<qreal>(0.0, std::log2(1.0 / effectiveZoom));
+            const qreal hysteresisMargin = 0.12;
+
+            if (qAbs(lodF - qRound(lodF)) < hysteresisMargin) {
+                lod = m_d->lastPreferredLod;
+            }
+        }
+
+        m_d->lastPreferredLod = lod;
+
         KisLodPreferences::PreferenceFlags flags = KisLodPreferences::LodSupported;
 
         if (m_d->lodPreferredInImage) {
@@ -14,6 +14,7 @@ struct KisCanvasDecoration::Private {
     QPointer<KisView> view;
     QString id;
     int priority = 0;
+    quint64 cacheStamp = 0;
 };
 
 KisCanvasDecoration::KisCanvasDecoration(const QString& id, QPointer<KisView>parent)
@@ -44,6 +45,7 @@ const QString& KisCanvasDecoration::id() const
 void KisCanvasDecoration::setVisible(bool v)
 {
     d->visible = v;
+    setCacheDirty();
     if (d->view &&
             d->view->canvasBase()) {
 
@@ -82,6 +84,21 @@ void KisCanvasDecoration::setPriority(int value)
     d->priority = value;
 }
 
+bool KisCanvasDecoration::isCacheable() const
+{
+    return false;
+}
+
+quint64 KisCanvasDecoration::cacheStamp() const
+{
+    return d->cacheStamp;
+}
+
+void KisCanvasDecoration::setCacheDirty()
+{
+    d->cacheStamp++;
+}
+
 int KisCanvasDecoration::decorationThickness() const
 {
     if (d->view && d->view->canvasBase() && d->view->canvasBase()->resourceManager()) {
@@ -60,6 +60,24 @@ public:
      */
     int priority() const;
 
+    /**
+     * Whether the canvas widget may cache the decoration in a
+     * viewport-sized layer and recomposite it on partial canvas
+     * updates instead of repainting the decoration.
+     *
+     * A decoration may return true only when its drawing depends on
+     * nothing but its own state and the view transform, and every
+     * change of that state calls setCacheDirty(). Returns false by
+     * default.
+     */
+    virtual bool isCacheable() const;
+
+    /**
+     * A counter the canvas widget compares to detect that the cached
+     * layer of the decoration became outdated.
+     */
+    quint64 cacheStamp() const;
+
     static bool comparePriority(KisCanvasDecorationSP decoration1, KisCanvasDecorationSP decoration2);
 
     virtual void notifyWindowMinimized(bool minimized);
@@ -87,6 +105,13 @@ protected:
      */
     void setPriority(int value);
 
+    /**
+     * Marks the cached layer of the decoration outdated. Cacheable
+     * decorations must call this in every mutator that changes what
+     * the decoration draws.
+     */
+    void setCacheDirty();
+
     // returns the minimum decoration thickness, somewhat equivelant to the display scaling.
     int decorationThickness() const;
 
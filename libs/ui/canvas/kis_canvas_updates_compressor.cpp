@@ -6,6 +6,8 @@
 
 #include "kis_canvas_updates_compressor.h"
 
+#include <QRegion>
+
 bool KisCanvasUpdatesCompressor::putUpdateInfo(KisUpdateInfoSP info)
 {
     const int levelOfDetail = info->levelOfDetail();
@@ -15,20 +17,39 @@ bool KisCanvasUpdatesCompressor::putUpdateInfo(KisUpdateInfoSP info)
     QMutexLocker l(&m_mutex);
 
     if (info->canBeCompressed()) {
-        KisUpdateInfoList::iterator it = m_updatesList.begin();
-        while (it != m_updatesList.end()) {
-            if ((*it)->canBeCompressed() &&
-                levelOfDetail == (*it)->levelOfDetail() &&
-                newUpdateRect.contains((*it)->dirtyImageRect())) {
-
-                /**
-                 * We should always remove the overridden update and put 'info' to the end
-                 * of the queue. Otherwise, the updates will become reordered and the canvas
-                 * may have tiles artifacts with "outdated" data
-                 */
+        /**
+         * Skip intermediate states: a queued update whose area is fully
+         * covered by the newer updates of the same level of detail will be
+         * overwritten on the canvas before the next frame is shown anyway,
+         * so converting and uploading it is wasted work. We walk the queue
+         * from the newest entry backwards, accumulating the covered region;
+         * that also catches a dab that is jointly overwritten by several
+         * later dabs of a high-rate stroke (e.g. the airbrush), where no
+         * single update contains it.
+         *
+         * We should always remove the overridden update and keep 'info' at
+         * the end of the queue. Otherwise, the updates will become
+         * reordered and the canvas may have tiles artifacts with
+         * "outdated" data.
+         */
+        QRegion coveredRegion(newUpdateRect);
+
+        KisUpdateInfoList::iterator it = m_updatesList.end();
+        while (it != m_updatesList.begin()) {
+            --it;
+
+            if (!(*it)->canBeCompressed() ||
+                levelOfDetail != (*it)->levelOfDetail()) {
+
+                continue;
+            }
+
+            const QRect oldUpdateRect = (*it)->dirtyImageRect();
+
+            if (QRegion(oldUpdateRect).subtracted(coveredRegion).isEmpty()) {
                 it = m_updatesList.erase(it);
             } else {
-                ++it;
+                coveredRegion += oldUpdateRect;
             }
         }
     }
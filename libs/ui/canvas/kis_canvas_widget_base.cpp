@@ -6,9 +6,11 @@
 
 #include "kis_canvas_widget_base.h"
 
+#include <QHash>
 #include <QImage>
 #include <QPainter>
 #include <QTimer>
+#include <QTransform>
 #include <QMenu>
 
 #include <KoShapeManager.h>
@@ -43,7 +45,16 @@ public:
         , borderColor(Qt::gray)
     {}
 
+    struct DecorationCacheEntry {
+        QImage layer;
+        QTransform transform;
+        QSize size;
+        qreal devicePixelRatio = 1.0;
+        quint64 stamp = 0;
+    };
+
     QList<KisCanvasDecorationSP> decorations;
+    QHash<const KisCanvasDecoration*, DecorationCacheEntry> decorationCaches;
     KisCanvas2 * canvas;
     KisCoordinatesConverter *coordinatesConverter;
     const KoViewConverter * viewConverter;
@@ -104,7 +115,11 @@ void KisCanvasWidgetBase::drawDecorations(QPainter & gc, const QRect &updateWidg
     // ask the decorations to paint themselves
     // decorations are painted in "widget" coordinate system
     Q_FOREACH (KisCanvasDecorationSP deco, m_d->decorations) {
-        if (deco->visible()) {
+        if (!deco->visible()) continue;
+
+        if (deco->isCacheable()) {
+            drawCachedDecoration(gc, updateWidgetRect, deco);
+        } else {
             deco->paint(gc, m_d->coordinatesConverter->widgetToDocument(updateWidgetRect), m_d->coordinatesConverter,m_d->canvas);
         }
     }
@@ -120,8 +135,54 @@ void KisCanvasWidgetBase::drawDecorations(QPainter & gc, const QRect &updateWidg
     gc.restore();
 }
 
+void KisCanvasWidgetBase::drawCachedDecoration(QPainter &gc, const QRect &updateWidgetRect, KisCanvasDecorationSP deco) const
+{
+    const QPaintDevice *device = gc.device();
+    const qreal devicePixelRatio = device->devicePixelRatioF();
+    const QSize widgetSize(qRound(device->width() / devicePixelRatio),
+                           qRound(device->height() / devicePixelRatio));
+    const QTransform transform = m_d->coordinatesConverter->documentToWidgetTransform();
+
+    Private::DecorationCacheEntry &entry = m_d->decorationCaches[deco.data()];
+
+    if (entry.layer.isNull() ||
+        entry.stamp != deco->cacheStamp() ||
+        entry.transform != transform ||
+        entry.size != widgetSize ||
+        entry.devicePixelRatio != devicePixelRatio) {
+
+        QImage layer(widgetSize * devicePixelRatio, QImage::Format_ARGB32_Premultiplied);
+        layer.setDevicePixelRatio(devicePixelRatio);
+        layer.fill(Qt::transparent);
+
+        QPainter layerPainter(&layer);
+        layerPainter.setRenderHints(gc.renderHints());
+        deco->paint(layerPainter,
+                    m_d->coordinatesConverter->widgetToDocument(QRect(QPoint(), widgetSize)),
+                    m_d->coordinatesConverter,
+                    m_d->canvas);
+        layerPainter.end();
+
+        entry.layer = layer;
+        entry.transform = transform;
+        entry.size = widgetSize;
+        entry.devicePixelRatio = devicePixelRatio;
+        entry.stamp = deco->cacheStamp();
+    }
+
+    // recomposite only the damaged part of the cached layer
+    gc.drawImage(updateWidgetRect, entry.layer,
+                 QRectF(updateWidgetRect.x() * devicePixelRatio,
+                        updateWidgetRect.y() * devicePixelRatio,
+                        updateWidgetRect.width() * devicePixelRatio,
+                        updateWidgetRect.height() * devicePixelRatio));
+}
+
 void KisCanvasWidgetBase::addDecoration(KisCanvasDecorationSP deco)
 {
+    // drop a possible leftover entry of a decoration that used to
+    // live at the same address
+    m_d->decorationCaches.remove(deco.data());
     m_d->decorations.push_back(deco);
     std::stable_sort(m_d->decorations.begin(), m_d->decorations.end(), KisCanvasDecoration::comparePriority);
 }
@@ -130,6 +191,7 @@ void KisCanvasWidgetBase::removeDecoration(const QString &id)
 {
     for (auto it = m_d->decorations.begin(); it != m_d->decorations.end(); ++it) {
         if ((*it)->id() == id) {
+            m_d->decorationCaches.remove(it->data());
             it = m_d->decorations.erase(it);
             break;
         }
@@ -148,6 +210,7 @@ KisCanvasDecorationSP KisCanvasWidgetBase::decoration(const QString& id) const
 
 void KisCanvasWidgetBase::setDecorations(const QList<KisCanvasDecorationSP > &decorations)
 {
+    m_d->decorationCaches.clear();
     m_d->decorations=decorations;
     std::stable_sort(m_d->decorations.begin(), m_d->decorations.end(), KisCanvasDecoration::comparePriority);
 }
@@ -87,6 +87,13 @@ protected:
     virtual bool callFocusNextPrevChild(bool next) = 0;
 
 private:
+    /**
+     * Composites the damaged part of the cached layer of a cacheable
+     * decoration, re-rendering the layer when the decoration, the view
+     * transform or the viewport size changed.
+     */
+    void drawCachedDecoration(QPainter &gc, const QRect &updateWidgetRect, KisCanvasDecorationSP deco) const;
+
     struct Private;
     Private * const m_d;
 
@@ -46,6 +46,37 @@ struct KisCoordinatesConverter::Private {
     QTransform imageToDocument;
     QTransform documentToFlake;
     QTransform widgetToViewport;
+
+    /**
+     * The inverted transforms are cached and recalculated only when
+     * the canvas transformation actually changes (zoom, pan, rotation,
+     * mirroring, resize). The widget-to-* conversion methods are
+     * called at tablet-input rate on the GUI thread, so they should
+     * not invert matrices per call. The forward compositions stay
+     * live: they are read by the offset-correction helpers in the
+     * middle of a transformation update, before the caches are
+     * refreshed.
+     */
+    QTransform widgetToDocument;
+    QTransform widgetToImage;
+    QTransform documentToImage;
+    QTransform flakeToDocument;
+    QTransform viewportToImage;
+    QTransform viewportToWidget;
+    QTransform widgetToFlake;
+
+    void recalculateCachedInvertedTransforms() {
+        const QTransform documentToWidget = documentToFlake * flakeToWidget;
+        const QTransform imageToWidget = imageToDocument * documentToWidget;
+
+        widgetToDocument = documentToWidget.inverted();
+        widgetToImage = imageToWidget.inverted();
+        documentToImage = imageToDocument.inverted();
+        flakeToDocument = documentToFlake.inverted();
+        viewportToImage = (imageToWidget * widgetToViewport).inverted();
+        viewportToWidget = widgetToViewport.inverted();
+        widgetToFlake = flakeToWidget.inverted();
+    }
 };
 
 /**
@@ -115,7 +146,12 @@ void KisCoordinatesConverter::correctTransformationToOffset()
 
 void KisCoordinatesConverter::recalculateTransformations()
 {
-    if(!m_d->image) return;
+    if(!m_d->image) {
+        // keep the cached inverses consistent with flakeToWidget,
+        // which may be translated even before the image is set
+        m_d->recalculateCachedInvertedTransforms();
+        return;
+    }
 
     m_d->imageToDocument = QTransform::fromScale(1 / m_d->image->xRes(),
                                                  1 / m_d->image->yRes());
@@ -135,6 +171,8 @@ void KisCoordinatesConverter::recalculateTransformations()
     QPointF    offset            = canvasBounds.topLeft();
 
     m_d->widgetToViewport = reversedTransform * QTransform::fromTranslate(-offset.x(), -offset.y());
+
+    m_d->recalculateCachedInvertedTransforms();
 }
 
 
@@ -362,13 +400,41 @@ QTransform KisCoordinatesConverter::documentToWidgetTransform() const {
 }
 
 QTransform KisCoordinatesConverter::viewportToWidgetTransform() const {
-    return m_d->widgetToViewport.inverted();
+    return m_d->viewportToWidget;
 }
 
 QTransform KisCoordinatesConverter::imageToViewportTransform() const {
     return m_d->imageToDocument * m_d->documentToFlake * m_d->flakeToWidget * m_d->widgetToViewport;
 }
 
+QTransform KisCoordinatesConverter::widgetToDocumentTransform() const {
+    return m_d->widgetToDocument;
+}
+
+QTransform KisCoordinatesConverter::widgetToImageTransform() const {
+    return m_d->widgetToImage;
+}
+
+QTransform KisCoordinatesConverter::documentToImageTransform() const {
+    return m_d->documentToImage;
+}
+
+QTransform KisCoordinatesConverter::flakeToDocumentTransform() const {
+    return m_d->flakeToDocument;
+}
+
+QTransform KisCoordinatesConverter::viewportToImageTransform() const {
+    return m_d->viewportToImage;
+}
+
+QTransform KisCoordinatesConverter::widgetToViewportTransform() const {
+    return m_d->widgetToViewport;
+}
+
+QTransform KisCoordinatesConverter::widgetToFlakeTransform() const {
+    return m_d->widgetToFlake;
+}
+
 void KisCoordinatesConverter::getQPainterCheckersInfo(QTransform *transform,
                                                       QPointF *brushOrigin,
                                                       QPolygonF *polygon,
@@ -538,5 +604,29 @@ QTransform KisCoordinatesConverter::viewToWidget() const
 
 QTransform KisCoordinatesConverter::widgetToView() const
 {
-    return flakeToWidgetTransform().inverted();
+    return widgetToFlakeTransform();
+}
+
+void KisCoordinatesConverter::widgetToDocument(const QPointF *src, QPointF *dst, int numPoints) const
+{
+    const QTransform &transform = m_d->widgetToDocument;
+    for (int i = 0; i < numPoints; i++) {
+        dst[i] = transform.map(src[i]);
+    }
+}
+
+void KisCoordinatesConverter::widgetToImage(const QPointF *src, QPointF *dst, int numPoints) const
+{
+    const QTransform &transform = m_d->widgetToImage;
+    for (int i = 0; i < numPoints; i++) {
+        dst[i] = transform.map(src[i]);
+    }
+}
+
+void KisCoordinatesConverter::documentToWidget(const QPointF *src, QPointF *dst, int numPoints) const
+{
+    const QTransform transform = documentToWidgetTransform();
+    for (int i = 0; i < numPoints; i++) {
+        dst[i] = transform.map(src[i]);
+    }
 }
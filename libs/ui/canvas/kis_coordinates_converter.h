@@ -82,37 +82,46 @@ public:
     template<class T> typename _Private::Traits<T>::Result
     imageToViewport(const T& obj) const { return _Private::Traits<T>::map(imageToViewportTransform(), obj); }
     template<class T> typename _Private::Traits<T>::Result
-    viewportToImage(const T& obj) const { return _Private::Traits<T>::map(imageToViewportTransform().inverted(), obj); }
+    viewportToImage(const T& obj) const { return _Private::Traits<T>::map(viewportToImageTransform(), obj); }
 
     template<class T> typename _Private::Traits<T>::Result
     flakeToWidget(const T& obj) const { return _Private::Traits<T>::map(flakeToWidgetTransform(), obj); }
     template<class T> typename _Private::Traits<T>::Result
-    widgetToFlake(const T& obj) const { return _Private::Traits<T>::map(flakeToWidgetTransform().inverted(), obj); }
+    widgetToFlake(const T& obj) const { return _Private::Traits<T>::map(widgetToFlakeTransform(), obj); }
 
     template<class T> typename _Private::Traits<T>::Result
-    widgetToViewport(const T& obj) const { return _Private::Traits<T>::map(viewportToWidgetTransform().inverted(), obj); }
+    widgetToViewport(const T& obj) const { return _Private::Traits<T>::map(widgetToViewportTransform(), obj); }
     template<class T> typename _Private::Traits<T>::Result
     viewportToWidget(const T& obj) const { return _Private::Traits<T>::map(viewportToWidgetTransform(), obj); }
 
     template<class T> typename _Private::Traits<T>::Result
     documentToWidget(const T& obj) const { return _Private::Traits<T>::map(documentToWidgetTransform(), obj); }
     template<class T> typename _Private::Traits<T>::Result
-    widgetToDocument(const T& obj) const { return _Private::Traits<T>::map(documentToWidgetTransform().inverted(), obj); }
+    widgetToDocument(const T& obj) const { return _Private::Traits<T>::map(widgetToDocumentTransform(), obj); }
 
     template<class T> typename _Private::Traits<T>::Result
     imageToDocument(const T& obj) const { return _Private::Traits<T>::map(imageToDocumentTransform(), obj); }
     template<class T> typename _Private::Traits<T>::Result
-    documentToImage(const T& obj) const { return _Private::Traits<T>::map(imageToDocumentTransform().inverted(), obj); }
+    documentToImage(const T& obj) const { return _Private::Traits<T>::map(documentToImageTransform(), obj); }
 
     template<class T> typename _Private::Traits<T>::Result
     documentToFlake(const T& obj) const { return _Private::Traits<T>::map(documentToFlakeTransform(), obj); }
     template<class T> typename _Private::Traits<T>::Result
-    flakeToDocument(const T& obj) const { return _Private::Traits<T>::map(documentToFlakeTransform().inverted(), obj); }
+    flakeToDocument(const T& obj) const { return _Private::Traits<T>::map(flakeToDocumentTransform(), obj); }
 
     template<class T> typename _Private::Traits<T>::Result
     imageToWidget(const T& obj) const { return _Private::Traits<T>::map(imageToWidgetTransform(), obj); }
     template<class T> typename _Private::Traits<T>::Result
-    widgetToImage(const T& obj) const { return _Private::Traits<T>::map(imageToWidgetTransform().inverted(), obj); }
+    widgetToImage(const T& obj) const { return _Private::Traits<T>::map(widgetToImageTransform(), obj); }
+
+    /**
+     * Batch conversion of a run of points, e.g. the coalesced samples
+     * of high-rate tablet events. The cached transform is fetched once
+     * for the whole run. @p src and @p dst may point to the same array.
+     */
+    void widgetToDocument(const QPointF *src, QPointF *dst, int numPoints) const;
+    void widgetToImage(const QPointF *src, QPointF *dst, int numPoints) const;
+    void documentToWidget(const QPointF *src, QPointF *dst, int numPoints) const;
 
     QTransform imageToWidgetTransform() const;
     QTransform imageToDocumentTransform() const;
@@ -122,6 +131,16 @@ public:
     QTransform flakeToWidgetTransform() const;
     QTransform documentToWidgetTransform() const;
 
+    // cached inverses of the transforms above, kept up to date by
+    // recalculateTransformations()
+    QTransform widgetToDocumentTransform() const;
+    QTransform widgetToImageTransform() const;
+    QTransform documentToImageTransform() const;
+    QTransform flakeToDocumentTransform() const;
+    QTransform viewportToImageTransform() const;
+    QTransform widgetToViewportTransform() const;
+    QTransform widgetToFlakeTransform() const;
+
     void getQPainterCheckersInfo(QTransform *transform,
                                  QPointF *brushOrigin,
                                  QPolygonF *polygon,
@@ -39,6 +39,13 @@ KisGridDecoration::~KisGridDecoration()
 void KisGridDecoration::setGridConfig(const KisGridConfig &config)
 {
     m_d->config = config;
+    setCacheDirty();
+}
+
+bool KisGridDecoration::isCacheable() const
+{
+    // the grid depends on the config and the view transform only
+    return true;
 }
 
 void KisGridDecoration::drawDecoration(QPainter& gc, const QRectF& updateArea, const KisCoordinatesConverter* converter, KisCanvas2* canvas)
@@ -25,6 +25,8 @@ public:
 
     void setGridConfig(const KisGridConfig &config);
 
+    bool isCacheable() const override;
+
 protected:
     void drawDecoration(QPainter& gc, const QRectF& updateArea, const KisCoordinatesConverter* converter, KisCanvas2* canvas) override;
 
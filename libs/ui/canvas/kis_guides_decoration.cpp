@@ -30,6 +30,13 @@ KisGuidesDecoration::~KisGuidesDecoration()
 void KisGuidesDecoration::setGuidesConfig(const KisGuidesConfig &value)
 {
     m_d->guidesConfig = value;
+    setCacheDirty();
+}
+
+bool KisGuidesDecoration::isCacheable() const
+{
+    // the guides depend on the config and the view transform only
+    return true;
 }
 
 const KisGuidesConfig& KisGuidesDecoration::guidesConfig() const
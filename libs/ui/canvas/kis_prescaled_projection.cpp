@@ -15,6 +15,14 @@
 #include <QPoint>
 #include <QSize>
 #include <QPainter>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
+
+#include <functional>
+#include <memory>
+#include <vector>
 
 #include <KoColorProfile.h>
 #include <KoViewConverter.h>
@@ -33,6 +41,30 @@
 
 #define ceiledSize(sz) QSize(ceil((sz).width()), ceil((sz).height()))
 
+namespace {
+
+class PatchPrescaleTask : public QRunnable
+{
+public:
+    PatchPrescaleTask(std::function<void()> func, QSemaphore *doneSemaphore)
+        : m_func(func),
+          m_doneSemaphore(doneSemaphore)
+    {
+        setAutoDelete(false);
+    }
+
+    void run() override {
+        m_func();
+        m_doneSemaphore->release();
+    }
+
+private:
+    std::function<void()> m_func;
+    QSemaphore *m_doneSemaphore;
+};
+
+}
+
 inline void copyQImageBuffer(uchar* dst, const uchar* src , qint32 deltaX, qint32 width)
 {
     if (deltaX >= 0) {
@@ -158,7 +190,7 @@ void KisPrescaledProjection::viewportMoved(const QPointF &offset)
         updateRegion -= savedArea;
     }
 
-    QPainter gc(&newImage);
+    QVector<KisPPUpdateInfoSP> patchInfos;
     auto rc = updateRegion.begin();
     while (rc != updateRegion.end()) {
         QRect rect = *rc;
@@ -173,11 +205,20 @@ void KisPrescaledProjection::viewportMoved(const QPointF &offset)
 
             KisPPUpdateInfoSP info = getInitialUpdateInformation(QRect());
             fillInUpdateInformation(viewportPatch, info);
-            drawUsingBackend(gc, info);
+            patchInfos.append(info);
         }
         rc++;
     }
 
+    QPainter gc(&newImage);
+    drawPatchesUsingBackend(gc, patchInfos);
+    gc.end();
+
+    /**
+     * The widget sees only complete frames: the uncovered strips are
+     * rendered into a back buffer and the prescaled image is swapped
+     * in one go.
+     */
     m_d->prescaledQImage = newImage;
 }
 
@@ -240,15 +281,17 @@ void KisPrescaledProjection::preScale()
     QVector<QRect> patches =
         KritaUtils::splitRectIntoPatches(imageRect, m_d->updatePatchSize);
 
+    QVector<KisPPUpdateInfoSP> patchInfos;
     Q_FOREACH (const QRect& rc, patches) {
         QRect viewportPatch = m_d->coordinatesConverter->imageToViewport(rc).toAlignedRect();
         KisPPUpdateInfoSP info = getInitialUpdateInformation(QRect());
         fillInUpdateInformation(viewportPatch, info);
-        QPainter gc(&m_d->prescaledQImage);
-        gc.setCompositionMode(QPainter::CompositionMode_Source);
-        drawUsingBackend(gc, info);
+        patchInfos.append(info);
     }
 
+    QPainter gc(&m_d->prescaledQImage);
+    gc.setCompositionMode(QPainter::CompositionMode_Source);
+    drawPatchesUsingBackend(gc, patchInfos);
 }
 
 void KisPrescaledProjection::setDisplayConfig(const KisDisplayConfig &config)
@@ -373,6 +416,75 @@ void KisPrescaledProjection::updateScaledImage(KisPPUpdateInfoSP info)
     drawUsingBackend(gc, info);
 }
 
+void KisPrescaledProjection::drawPatchesUsingBackend(QPainter &gc, const QVector<KisPPUpdateInfoSP> &infos)
+{
+    /**
+     * Fetching and smooth-scaling the patches is by far the most
+     * expensive part of refilling the prescaled image, and every
+     * patch is independent, so that stage is spread over the global
+     * thread pool. The final composition stays serial: QPainter
+     * cannot be driven from multiple threads, and blitting an
+     * already prescaled patch is cheap.
+     */
+    QVector<KisPPUpdateInfoSP> scalableInfos;
+    Q_FOREACH (KisPPUpdateInfoSP info, infos) {
+        if (!info->imageRect.isEmpty() &&
+            info->transfer == KisPPUpdateInfo::PATCH) {
+
+            scalableInfos.append(info);
+        }
+    }
+
+    auto prescalePatch = [this](KisPPUpdateInfoSP info) {
+        info->patch = m_d->projectionBackend->getNearestPatch(info);
+        // prescale the patch because otherwise we'd scale using QPainter, which gives
+        // a crap result compared to QImage's smoothscale
+        info->patch.preScale(info->viewportRect);
+    };
+
+    if (scalableInfos.size() == 1) {
+        prescalePatch(scalableInfos.first());
+    } else if (scalableInfos.size() > 1) {
+        const int numTiles = scalableInfos.size();
+        const int numTasks = qMin(QThread::idealThreadCount(), numTiles);
+
+        QSemaphore doneSemaphore;
+        std::vector<std::unique_ptr<PatchPrescaleTask>> tasks;
+
+        for (int i = 0; i < numTasks; i++) {
+            std::function<void()> func =
+                [i, numTiles, numTasks, &scalableInfos, prescalePatch]() {
+                    for (int index = i; index < numTiles; index += numTasks) {
+                        prescalePatch(scalableInfos[index]);
+                    }
+                };
+
+            std::unique_ptr<PatchPrescaleTask> task(
+                new PatchPrescaleTask(func, &doneSemaphore));
+
+            if (!QThreadPool::globalInstance()->tryStart(task.get())) {
+                // all the pool threads are busy, run the task in
+                // the calling thread instead
+                task->run();
+            }
+
+            tasks.push_back(std::move(task));
+        }
+
+        doneSemaphore.acquire(tasks.size());
+    }
+
+    Q_FOREACH (KisPPUpdateInfoSP info, infos) {
+        if (info->imageRect.isEmpty()) continue;
+
+        if (info->transfer == KisPPUpdateInfo::DIRECT) {
+            m_d->projectionBackend->drawFromOriginalImage(gc, info);
+        } else /* if info->transfer == KisPPUpdateInformation::PATCH */ {
+            info->patch.drawMe(gc, info->viewportRect, info->renderHints);
+        }
+    }
+}
+
 void KisPrescaledProjection::drawUsingBackend(QPainter &gc, KisPPUpdateInfoSP info)
 {
     if (info->imageRect.isEmpty()) return;
@@ -7,6 +7,7 @@
 #define KIS_PRESCALED_PROJECTION_H
 
 #include <QObject>
+#include <QVector>
 
 #include <kritaui_export.h>
 #include <kis_shared.h>
@@ -161,6 +162,15 @@ private:
      */
     void drawUsingBackend(QPainter &gc, KisPPUpdateInfoSP info);
 
+    /**
+     * Draws a batch of patches, prescaling them in parallel on the
+     * global thread pool before compositing them serially onto @p gc
+     *
+     * @param infos prepared information for every patch of the batch
+     * @param gc The painter we draw on
+     */
+    void drawPatchesUsingBackend(QPainter &gc, const QVector<KisPPUpdateInfoSP> &infos);
+
     struct Private;
     Private * const m_d;
 };
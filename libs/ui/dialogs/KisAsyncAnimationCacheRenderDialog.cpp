@@ -87,6 +87,51 @@ int KisAsyncAnimationCacheRenderDialog::calcFirstDirtyFrame(KisAnimationFrameCac
     return result;
 }
 
+int KisAsyncAnimationCacheRenderDialog::calcNearestDirtyFrame(KisAnimationFrameCacheSP cache, const KisTimeSpan &playbackRange, const KisTimeSpan &skipRange, int playheadFrame)
+{
+    int result = -1;
+
+    KisImageSP image = cache->image();
+    if (!image) return result;
+
+    KisImageAnimationInterface *animation = image->animationInterface();
+    if (!animation->hasAnimation()) return result;
+
+    if (!playbackRange.isValid()) return result;
+    KIS_ASSERT_RECOVER_RETURN_VALUE(!playbackRange.isInfinite(), result);
+
+    const int center = qBound(playbackRange.start(), playheadFrame, playbackRange.end());
+
+    auto frameIsDirty = [&] (int frame) {
+        return !skipRange.contains(frame) &&
+            cache->frameStatus(frame) != KisAnimationFrameCache::Cached;
+    };
+
+    for (int offset = 0; ; offset++) {
+        const int after = center + offset;
+        const int before = center - offset;
+
+        const bool afterInRange = after <= playbackRange.end();
+        const bool beforeInRange = before >= playbackRange.start();
+
+        if (!afterInRange && !beforeInRange) break;
+
+        // the frames ahead of the playhead are reached by playback
+        // first, so they win on equal distance
+        if (afterInRange && frameIsDirty(after)) {
+            result = after;
+            break;
+        }
+
+        if (beforeInRange && offset > 0 && frameIsDirty(before)) {
+            result = before;
+            break;
+        }
+    }
+
+    return result;
+}
+
 
 struct KisAsyncAnimationCacheRenderDialog::Private
 {
@@ -19,6 +19,15 @@ public:
 
     static int calcFirstDirtyFrame(KisAnimationFrameCacheSP cache, const KisTimeSpan &playbackRange, const KisTimeSpan &skipRange);
 
+    /**
+     * Returns the uncached frame of \p playbackRange closest to
+     * \p playheadFrame, preferring the frames ahead of the playhead
+     * on equal distance. Used by the background cache populator so
+     * that the region the animator is actually looking at becomes
+     * playable first.
+     */
+    static int calcNearestDirtyFrame(KisAnimationFrameCacheSP cache, const KisTimeSpan &playbackRange, const KisTimeSpan &skipRange, int playheadFrame);
+
 protected:
     QList<int> calcDirtyFrames() const override;
     KisAsyncAnimationRendererBase* createRenderer(KisImageSP image) override;
@@ -28,6 +28,10 @@
 
 #include <QThread>
 #include <QApplication>
+#include <QRunnable>
+#include <QScopedPointer>
+#include <QSemaphore>
+#include <QThreadPool>
 
 #include <kis_spontaneous_job.h>
 #include "kis_global.h"
@@ -289,6 +293,7 @@ void KisShapeLayerCanvas::slotStartAsyncRepaint()
         return;
     }
 
+    QRegion repaintRegion;
     QRect repaintRect;
     QRect uncroppedRepaintRect;
     bool forceUpdateHiddenAreasOnly = false;
@@ -297,14 +302,14 @@ void KisShapeLayerCanvas::slotStartAsyncRepaint()
     {
         QMutexLocker locker(&m_dirtyRegionMutex);
 
-        repaintRect = m_dirtyRegion.boundingRect();
+        repaintRegion = m_dirtyRegion;
         forceUpdateHiddenAreasOnly = m_forceUpdateHiddenAreasOnly;
 
         /// Since we are going to override the previous jobs, we should fetch
         /// all the area covered by it. Otherwise we'll get dirty leftovers of
         /// the layer on the projection
         Q_FOREACH (const KoShapeManager::PaintJob &job, m_paintJobsOrder.jobs) {
-            repaintRect |= viewConverter()->documentToView().mapRect(job.docUpdateRect).toAlignedRect();
+            repaintRegion += viewConverter()->documentToView().mapRect(job.docUpdateRect).toAlignedRect();
         }
         m_paintJobsOrder.clear();
 
@@ -312,18 +317,25 @@ void KisShapeLayerCanvas::slotStartAsyncRepaint()
         m_forceUpdateHiddenAreasOnly = false;
     }
 
+    QRegion clearRegion;
+
     if (!forceUpdateHiddenAreasOnly) {
-        if (repaintRect.isEmpty()) {
+        if (repaintRegion.isEmpty()) {
             return;
         }
 
-        // Crop the update rect by the image bounds. We keep the cache consistent
-        // by tracking the size of the image in slotImageSizeChanged()
-        uncroppedRepaintRect = repaintRect;
-        repaintRect = repaintRect.intersected(image->bounds());
+        // Crop the update region by the image bounds. We keep the cache consistent
+        // by tracking the size of the image in slotImageSizeChanged(). The part
+        // that got cropped away generates no paint jobs, so it must be cleared
+        // by repaint() explicitly.
+        uncroppedRepaintRect = repaintRegion.boundingRect();
+        repaintRegion &= image->bounds();
+        repaintRect = repaintRegion.boundingRect();
+        clearRegion = QRegion(uncroppedRepaintRect) - repaintRect;
     } else {
         const QRectF shapesBounds = KoShape::boundingRect(m_shapeManager->shapes());
-        repaintRect |= kisGrowRect(viewConverter()->documentToView(shapesBounds).toAlignedRect(), 2);
+        repaintRegion += kisGrowRect(viewConverter()->documentToView(shapesBounds).toAlignedRect(), 2);
+        repaintRect = repaintRegion.boundingRect();
         uncroppedRepaintRect = repaintRect;
     }
 
@@ -361,6 +373,11 @@ void KisShapeLayerCanvas::slotStartAsyncRepaint()
 
     KoShapeManager::PaintJobsOrder jobsOrder;
     Q_FOREACH (const QRect &viewUpdateRect, updateRects) {
+        // skip the patches that cover only untouched parts of the
+        // bounding rect of the dirty region; their projection content
+        // is still valid
+        if (!repaintRegion.intersects(viewUpdateRect)) continue;
+
         jobsOrder.jobs << KoShapeManager::PaintJob(viewConverter()->viewToDocument().mapRect(QRectF(viewUpdateRect)),
                                               viewUpdateRect);
     }
@@ -375,6 +392,7 @@ void KisShapeLayerCanvas::slotStartAsyncRepaint()
         // the only actor that can add stuff to it.
         KIS_SAFE_ASSERT_RECOVER_NOOP(m_paintJobsOrder.isEmpty());
         m_paintJobsOrder = jobsOrder;
+        m_paintJobsClearRegion = clearRegion;
     }
 
     m_hasUpdateInCompressor = false;
@@ -399,14 +417,97 @@ void KisShapeLayerCanvas::slotImageSizeChanged()
     m_cachedImageRect = m_image->bounds();
 }
 
+namespace {
+
+/**
+ * Rasterizes one 256x256 paint job into a private image and uploads the
+ * result to the projection device. KoShapeManager::paintJob() only
+ * reads the cloned shapes packed into the job, so the jobs can be
+ * rendered concurrently; only the projection writes are serialized,
+ * because the patches are not aligned to the device's tile grid.
+ */
+class ShapePaintJobTask : public QRunnable
+{
+public:
+    ShapePaintJobTask(KoShapeManager *shapeManager,
+                      const KoShapeManager::PaintJob &job,
+                      const QTransform &documentToView,
+                      bool antialias,
+                      KisPaintDeviceSP projection,
+                      QMutex *projectionMutex,
+                      QSemaphore *doneSemaphore)
+        : m_shapeManager(shapeManager)
+        , m_job(job)
+        , m_documentToView(documentToView)
+        , m_antialias(antialias)
+        , m_projection(projection)
+        , m_projectionMutex(projectionMutex)
+        , m_doneSemaphore(doneSemaphore)
+    {
+        setAutoDelete(false);
+    }
+
+    void run() override {
+        const QRect viewUpdateRect = m_job.viewUpdateRect;
+
+        QImage image(viewUpdateRect.size(), QImage::Format_ARGB32);
+        image.fill(0);
+
+        QPainter tempPainter(&image);
+        if (m_antialias) {
+            tempPainter.setRenderHint(QPainter::Antialiasing);
+            tempPainter.setRenderHint(QPainter::TextAntialiasing);
+        }
+
+        tempPainter.setClipRect(QRect(QPoint(), viewUpdateRect.size()));
+        tempPainter.setTransform(m_documentToView *
+                                 QTransform::fromTranslate(-viewUpdateRect.x(), -viewUpdateRect.y()));
+
+        m_shapeManager->paintJob(tempPainter, m_job);
+
+        QScopedArrayPointer<quint8> dstData(
+            new quint8[viewUpdateRect.width() * viewUpdateRect.height() * m_projection->pixelSize()]);
+
+        KoColorSpaceRegistry::instance()->rgb8()
+                ->convertPixelsTo(image.constBits(), dstData.data(), m_projection->colorSpace(),
+                                  viewUpdateRect.width() * viewUpdateRect.height(),
+                                  KoColorConversionTransformation::internalRenderingIntent(),
+                                  KoColorConversionTransformation::internalConversionFlags());
+
+        {
+            QMutexLocker locker(m_projectionMutex);
+            m_projection->writeBytes(dstData.data(),
+                                     viewUpdateRect.x(),
+                                     viewUpdateRect.y(),
+                                     viewUpdateRect.width(),
+                                     viewUpdateRect.height());
+        }
+
+        m_doneSemaphore->release();
+    }
+
+private:
+    KoShapeManager *m_shapeManager;
+    KoShapeManager::PaintJob m_job;
+    QTransform m_documentToView;
+    bool m_antialias;
+    KisPaintDeviceSP m_projection;
+    QMutex *m_projectionMutex;
+    QSemaphore *m_doneSemaphore;
+};
+
+} // namespace
+
 void KisShapeLayerCanvas::repaint()
 {
 
     KoShapeManager::PaintJobsOrder paintJobsOrder;
+    QRegion clearRegion;
 
     {
         QMutexLocker locker(&m_dirtyRegionMutex);
         std::swap(paintJobsOrder, m_paintJobsOrder);
+        std::swap(clearRegion, m_paintJobsClearRegion);
     }
 
     /**
@@ -418,18 +519,24 @@ void KisShapeLayerCanvas::repaint()
     const qint32 MASK_IMAGE_WIDTH = 256;
     const qint32 MASK_IMAGE_HEIGHT = 256;
 
-    QImage image(MASK_IMAGE_WIDTH, MASK_IMAGE_HEIGHT, QImage::Format_ARGB32);
-    QPainter tempPainter(&image);
+    const QTransform documentToView = viewConverter()->documentToView();
+    const bool antialias = m_parentLayer->antialiased();
 
-    if(m_parentLayer->antialiased()) {
-        tempPainter.setRenderHint(QPainter::Antialiasing);
-        tempPainter.setRenderHint(QPainter::TextAntialiasing);
-    }
+    QRect repaintRect = paintJobsOrder.uncroppedViewUpdateRect;
 
-    quint8 * dstData = new quint8[MASK_IMAGE_WIDTH * MASK_IMAGE_HEIGHT * m_projection->pixelSize()];
+    /**
+     * The paint jobs fully overwrite the pixels of their patches, so
+     * only the areas that have no job (the part of the update rect
+     * cropped away by the image bounds) need an explicit clear. The
+     * untouched patches in between keep their still-valid content.
+     */
+    for (const QRect &rc : clearRegion) {
+        m_projection->clear(rc);
+    }
 
-    QRect repaintRect = paintJobsOrder.uncroppedViewUpdateRect;
-    m_projection->clear(repaintRect);
+    QVector<ShapePaintJobTask*> tasks;
+    QMutex projectionMutex;
+    QSemaphore doneSemaphore;
 
     Q_FOREACH (const KoShapeManager::PaintJob &job, paintJobsOrder.jobs) {
         if (job.isEmpty()) {
@@ -442,53 +549,21 @@ void KisShapeLayerCanvas::repaint()
             continue;
         }
 
-        image.fill(0);
-
-        tempPainter.setTransform(QTransform());
-        tempPainter.setClipRect(QRect(0,0,job.viewUpdateRect.width(), job.viewUpdateRect.height()));
-        tempPainter.setTransform(viewConverter()->documentToView() *
-                                 QTransform::fromTranslate(-job.viewUpdateRect.x(), -job.viewUpdateRect.y()));
-
-        m_shapeManager->paintJob(tempPainter, job);
-
-        if (image.size() != job.viewUpdateRect.size()) {
-            const quint8 *imagePtr = image.constBits();
-            const int imageRowStride = 4 * image.width();
-
-            for (int y = 0; y < job.viewUpdateRect.height(); y++) {
-
-                KoColorSpaceRegistry::instance()->rgb8()
-                        ->convertPixelsTo(imagePtr, dstData, m_projection->colorSpace(),
-                                          job.viewUpdateRect.width(),
-                                          KoColorConversionTransformation::internalRenderingIntent(),
-                                          KoColorConversionTransformation::internalConversionFlags());
-
-                m_projection->writeBytes(dstData,
-                                         job.viewUpdateRect.x(),
-                                         job.viewUpdateRect.y() + y,
-                                         job.viewUpdateRect.width(),
-                                         1);
-
-                imagePtr += imageRowStride;
-            }
-        } else {
-            KoColorSpaceRegistry::instance()->rgb8()
-                    ->convertPixelsTo(image.constBits(), dstData, m_projection->colorSpace(),
-                                      MASK_IMAGE_WIDTH * MASK_IMAGE_HEIGHT,
-                                      KoColorConversionTransformation::internalRenderingIntent(),
-                                      KoColorConversionTransformation::internalConversionFlags());
-
-            m_projection->writeBytes(dstData,
-                                     job.viewUpdateRect.x(),
-                                     job.viewUpdateRect.y(),
-                                     MASK_IMAGE_WIDTH,
-                                     MASK_IMAGE_HEIGHT);
+        ShapePaintJobTask *task =
+            new ShapePaintJobTask(m_shapeManager.data(), job, documentToView, antialias,
+                                  m_projection, &projectionMutex, &doneSemaphore);
+        tasks << task;
 
+        if (!QThreadPool::globalInstance()->tryStart(task)) {
+            task->run();
         }
+
         repaintRect |= job.viewUpdateRect;
     }
 
-    delete[] dstData;
+    doneSemaphore.acquire(tasks.size());
+    qDeleteAll(tasks);
+
     m_projection->purgeDefaultPixels();
     m_parentLayer->setDirty(repaintRect);
 
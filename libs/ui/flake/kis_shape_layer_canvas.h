@@ -123,6 +123,10 @@ private:
     QRegion m_dirtyRegion;
     QMutex m_dirtyRegionMutex;
     KoShapeManager::PaintJobsOrder m_paintJobsOrder;
+    /// parts of the projection that have no paint job (e.g. the area
+    /// that got cropped away by the image bounds) but still need to be
+    /// cleared by repaint()
+    QRegion m_paintJobsClearRegion;
 
     QRect m_cachedImageRect;
 
@@ -52,6 +52,7 @@ struct KisAnimationCachePopulator::Private
 
     KisAsyncAnimationCacheRenderer regenerator;
     bool calculateAnimationCacheInBackground = true;
+    bool currentFrameIsPriority = false;
 
     enum State {
         NotWaitingForAnything,
@@ -242,16 +243,21 @@ struct KisAnimationCachePopulator::Private
 
         KisTimeSpan currentRange = animation->documentPlaybackRange();
 
-        const int frame = priorityFrame >= 0 ? priorityFrame : KisAsyncAnimationCacheRenderDialog::calcFirstDirtyFrame(cache, currentRange, skipRange);
+        /**
+         * Regenerate the frames nearest to the playhead first: after an
+         * edit the animator usually wants to replay the segment they
+         * are working on, not the beginning of the playback range
+         */
+        const int frame = priorityFrame >= 0 ? priorityFrame : KisAsyncAnimationCacheRenderDialog::calcNearestDirtyFrame(cache, currentRange, skipRange, animation->currentUITime());
 
         if (frame >= 0) {
-            return regenerate(cache, frame);
+            return regenerate(cache, frame, priorityFrame >= 0);
         }
 
         return RequestRejected;
     }
 
-    RegenerationRequestResult regenerate(KisAnimationFrameCacheSP cache, int frame)
+    RegenerationRequestResult regenerate(KisAnimationFrameCacheSP cache, int frame, bool isPriorityFrame = false)
     {
         if (state == WaitingForFrame) {
             // Already busy, deny request
@@ -271,6 +277,7 @@ struct KisAnimationCachePopulator::Private
          */
         enterState(WaitingForFrame);
 
+        currentFrameIsPriority = isPriorityFrame;
         regenerator.setFrameCache(cache);
 
         // if we ever decide to add ROI to background cache
@@ -366,6 +373,14 @@ void KisAnimationCachePopulator::requestRegenerationWithPriorityFrame(KisImageSP
 
     if (m_d->state == Private::NotWaitingForAnything) {
         m_d->generateIfIdle();
+    } else if (m_d->state == Private::WaitingForFrame && !m_d->currentFrameIsPriority) {
+        /**
+         * Preempt the in-flight background frame: the animator has
+         * just scrubbed to an uncached position and shouldn't wait
+         * behind a frame they already passed. The background frame
+         * stays dirty and is picked up again on the next idle pass.
+         */
+        m_d->regenerator.cancelCurrentFrameRendering(KisAsyncAnimationRendererBase::UserCancelled);
     }
 }
 
@@ -385,7 +400,12 @@ void KisAnimationCachePopulator::slotRequestRegeneration()
 void KisAnimationCachePopulator::slotRegeneratorFrameCancelled()
 {
     KIS_ASSERT_RECOVER_RETURN(m_d->state == Private::WaitingForFrame);
-    m_d->enterState(Private::NotWaitingForAnything);
+
+    // when the cancellation was a preemption in favor of a priority
+    // frame, keep polling so that the priority frame gets scheduled
+    m_d->enterState(!m_d->priorityFrames.isEmpty() ?
+                        Private::WaitingForIdle :
+                        Private::NotWaitingForAnything);
 }
 
 void KisAnimationCachePopulator::slotRegeneratorFrameReady()
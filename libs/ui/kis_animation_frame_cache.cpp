@@ -7,6 +7,7 @@
 #include "kis_animation_frame_cache.h"
 #include "kis_animation_frame_cache_p.h"
 
+#include <QHash>
 #include <QMap>
 
 #include "kis_debug.h"
@@ -62,6 +63,15 @@ struct KisAnimationFrameCache::Private
 
     QMap<int, int> newFrames;
 
+    Statistics stats;
+
+    /**
+     * Number of times a frame range starting at the given time has been
+     * generated. Any count above one means the range had to be re-rendered
+     * after it was dropped from the cache.
+     */
+    QHash<int, int> generationCounts;
+
     int getFrameIdAtTime(int time) const
     {
         if (newFrames.isEmpty()) return -1;
@@ -104,6 +114,11 @@ struct KisAnimationFrameCache::Private
     {
         invalidate(range);
 
+        stats.generatedFrames++;
+        if (++generationCounts[range.start()] > 1) {
+            stats.regeneratedFrames++;
+        }
+
         const int length = range.isInfinite() ? -1 : range.end() - range.start() + 1;
         newFrames.insert(range.start(), length);
         swapper->saveFrame(range.start(), info, image->bounds());
@@ -112,9 +127,12 @@ struct KisAnimationFrameCache::Private
     /**
      * Invalidate any cached frames within the given time range.
      * @param range
+     * @param droppedFramesCounter optional counter incremented for every
+     *        frame range that is completely forgotten (truncated ranges
+     *        keep their data and are not counted)
      * @return true if frames were invalidated, false if nothing was changed
      */
-    bool invalidate(const KisTimeSpan& range)
+    bool invalidate(const KisTimeSpan& range, int *droppedFramesCounter = nullptr)
     {
         if (newFrames.isEmpty()) return false;
 
@@ -143,6 +161,9 @@ struct KisAnimationFrameCache::Private
                     swapper->moveFrame(start, newStart);
                 } else {
                     swapper->forgetFrame(start);
+                    if (droppedFramesCounter) {
+                        (*droppedFramesCounter)++;
+                    }
                 }
 
                 it = newFrames.erase(it);
@@ -256,6 +277,28 @@ KisAnimationFrameCache::CacheStatus KisAnimationFrameCache::frameStatus(int time
     return m_d->hasFrame(time) ? Cached : Uncached;
 }
 
+KisAnimationFrameCache::Statistics KisAnimationFrameCache::statistics() const
+{
+    return m_d->stats;
+}
+
+QVector<KisTimeSpan> KisAnimationFrameCache::cachedRanges() const
+{
+    QVector<KisTimeSpan> ranges;
+    ranges.reserve(m_d->newFrames.size());
+
+    for (auto it = m_d->newFrames.constBegin(); it != m_d->newFrames.constEnd(); ++it) {
+        const int start = it.key();
+        const int length = it.value();
+
+        ranges.append(length == -1 ?
+                      KisTimeSpan::infinite(start) :
+                      KisTimeSpan::fromTimeToTime(start, start + length - 1));
+    }
+
+    return ranges;
+}
+
 FramesGluerBase::~FramesGluerBase()
 {
 }
@@ -365,7 +408,7 @@ void KisAnimationFrameCache::framesChanged(const KisTimeSpan &range, const QRect
 
     if (!range.isValid()) return;
 
-    bool cacheChanged = m_d->invalidate(range);
+    bool cacheChanged = m_d->invalidate(range, &m_d->stats.framesDroppedOnChange);
 
     if (cacheChanged) {
         Q_EMIT changed();
@@ -374,6 +417,9 @@ void KisAnimationFrameCache::framesChanged(const KisTimeSpan &range, const QRect
 
 void KisAnimationFrameCache::slotConfigChanged()
 {
+    if (!m_d->newFrames.isEmpty()) {
+        m_d->stats.cacheResets++;
+    }
     m_d->newFrames.clear();
 
     KisImageConfig cfg(true);
@@ -432,7 +478,7 @@ KisOpenGLUpdateInfoSP KisAnimationFrameCache::fetchFrameData(int time, KisImageS
 void KisAnimationFrameCache::addConvertedFrameData(KisOpenGLUpdateInfoSP info, int time)
 {
     const KisTimeSpan identicalRange =
-        KisTimeSpan::calculateIdenticalFramesRecursive(m_d->image->root(), time);
+        m_d->image->animationInterface()->identicalFramesAt(time);
 
     m_d->addFrame(info, identicalRange);
 
@@ -465,6 +511,7 @@ void KisAnimationFrameCache::dropLowQualityFrames(const KisTimeSpan &range, cons
         if (frameLod > m_d->effectiveLevelOfDetail(regionOfInterest) || !frameRect.contains(minimalRect)) {
             m_d->swapper->forgetFrame(frameId);
             it = m_d->newFrames.erase(it);
+            m_d->stats.framesDroppedLowQuality++;
         } else {
             ++it;
         }
@@ -9,6 +9,7 @@
 
 #include <QImage>
 #include <QObject>
+#include <QVector>
 
 #include "kritaui_export.h"
 #include "kis_types.h"
@@ -51,6 +52,36 @@ public:
     CacheStatus frameStatus(int time) const;
     bool tryGlueSameFrames(const KisTimeSpan &range);
 
+    /**
+     * Usage counters of the cache. The cache never evicts frames to stay
+     * under a size budget: frames are dropped only when the image content
+     * changes, when dropLowQualityFrames() discards them, or when the
+     * whole cache is reset on a configuration change. The counters tell
+     * which of these causes makes scrubbing re-render frames that were
+     * cached before.
+     */
+    struct Statistics {
+        /// total number of frames rendered and added to the cache
+        int generatedFrames = 0;
+        /// frames rendered for a range start that had been cached earlier
+        int regeneratedFrames = 0;
+        /// cached frames dropped because the image content changed
+        int framesDroppedOnChange = 0;
+        /// cached frames dropped by dropLowQualityFrames()
+        int framesDroppedLowQuality = 0;
+        /// full cache resets caused by configuration changes
+        int cacheResets = 0;
+    };
+
+    Statistics statistics() const;
+
+    /**
+     * Returns the list of contiguous frame ranges that are currently
+     * resident in the cache, sorted by start time. The last range may
+     * be infinite.
+     */
+    QVector<KisTimeSpan> cachedRanges() const;
+
 
     KisImageWSP image();
 
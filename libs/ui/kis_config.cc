@@ -1302,6 +1302,18 @@ void KisConfig::setAutoSaveInterval(int seconds)  const
     return m_cfg.writeEntry("AutoSaveInterval", seconds);
 }
 
+int KisConfig::autoSaveWriteBudget(bool defaultValue) const
+{
+    // in MiB per second, 0 disables the throttling
+    int def = 32;
+    return (defaultValue ? def : m_cfg.readEntry("AutoSaveWriteBudget", def));
+}
+
+void KisConfig::setAutoSaveWriteBudget(int mibPerSecond) const
+{
+    m_cfg.writeEntry("AutoSaveWriteBudget", mibPerSecond);
+}
+
 bool KisConfig::backupFile(bool defaultValue) const
 {
     return (defaultValue ? true : m_cfg.readEntry("CreateBackupFile", true));
@@ -2235,6 +2247,16 @@ void KisConfig::setEnableBrushSpeedLogging(bool value) const
     m_cfg.writeEntry("enableBrushSpeedLogging", value);
 }
 
+bool KisConfig::enableCanvasPerfHud(bool defaultValue) const
+{
+    return (defaultValue ? false : m_cfg.readEntry("enableCanvasPerfHud", false));
+}
+
+void KisConfig::setEnableCanvasPerfHud(bool value) const
+{
+    m_cfg.writeEntry("enableCanvasPerfHud", value);
+}
+
 void KisConfig::setDisableVectorOptimizations(bool value)
 {
     // use the old key name for compatibility
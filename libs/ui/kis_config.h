@@ -315,6 +315,9 @@ public:
     int autoSaveInterval(bool defaultValue = false) const;
     void setAutoSaveInterval(int seconds) const;
 
+    int autoSaveWriteBudget(bool defaultValue = false) const;
+    void setAutoSaveWriteBudget(int mibPerSecond) const;
+
     bool backupFile(bool defaultValue = false) const;
     void setBackupFile(bool backupFile) const;
 
@@ -600,6 +603,9 @@ public:
     void setEnableBrushSpeedLogging(bool value) const;
     bool enableBrushSpeedLogging(bool defaultValue = false) const;
 
+    void setEnableCanvasPerfHud(bool value) const;
+    bool enableCanvasPerfHud(bool defaultValue = false) const;
+
     void setDisableVectorOptimizations(bool value);
     bool disableVectorOptimizations(bool defaultValue = false) const;
 
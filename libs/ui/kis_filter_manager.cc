@@ -58,6 +58,7 @@ struct KisFilterManager::Private {
     KisFilterConfigurationSP currentlyAppliedConfiguration;
     KisStrokeId currentStrokeId;
     KisFilterStrokeStrategy::ExternalCancelUpdatesStorageSP externalCancelUpdatesStorage;
+    KisFilterStrokeStrategy::FilterCheckpointStorageSP filterCheckpointStorage;
     KisFilterStrokeStrategy::IdleBarrierData::IdleBarrierCookie idleBarrierCookie;
 
     bool filterAllSelectedFrames = false;
@@ -289,6 +290,13 @@ void KisFilterManager::apply(KisFilterConfigurationSP _filterConfig)
         d->externalCancelUpdatesStorage.reset(new KisFilterStrokeStrategy::ExternalCancelUpdatesStorage());
     }
 
+    if (!d->filterCheckpointStorage) {
+        // The checkpoint storage lets the restarted strokes of this
+        // dialog session resume the work of the cancelled ones.
+
+        d->filterCheckpointStorage.reset(new KisFilterStrokeStrategy::FilterCheckpointStorage());
+    }
+
     KoCanvasResourceProvider *resourceManager =
         d->view->canvasResourceProvider()->resourceManager();
 
@@ -301,6 +309,8 @@ void KisFilterManager::apply(KisFilterConfigurationSP _filterConfig)
                                                                     KisFilterConfigurationSP(filterConfig),
                                                                     resources,
                                                                     d->externalCancelUpdatesStorage.toWeakRef());
+    strategy->setFilterCheckpointStorage(d->filterCheckpointStorage);
+
     {
         KConfigGroup group( KSharedConfig::openConfig(), "filterdialog");
         strategy->setForceLodModeIfPossible(group.readEntry("forceLodMode", true));
@@ -356,6 +366,9 @@ void KisFilterManager::finish()
 
     d->idleBarrierCookie.clear();
     d->currentlyAppliedConfiguration.clear();
+
+    // the device has changed, the checkpoints are not resumable anymore
+    d->filterCheckpointStorage.clear();
 }
 
 void KisFilterManager::cancelRunningStroke()
@@ -370,6 +383,7 @@ void KisFilterManager::cancelRunningStroke()
     d->idleBarrierCookie.clear();
     d->currentlyAppliedConfiguration.clear();
     d->externalCancelUpdatesStorage.clear();
+    d->filterCheckpointStorage.clear();
 }
 
 void KisFilterManager::cancelDialog()
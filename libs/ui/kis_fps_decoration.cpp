@@ -104,6 +104,27 @@ QString KisFpsDecoration::getText() const
         lines << QString("Canvas FPS: %1").arg(QString::number(value, 'f', 1));
     }
 
+    if (KisOpenglCanvasDebugger::instance()->showPerfHudOnCanvas()) {
+        KisOpenglCanvasDebugger *debugger = KisOpenglCanvasDebugger::instance();
+
+        lines << QString("Frame CPU prep: %1 ms")
+                .arg(debugger->avgCpuFrameTime(), 0, 'f', 2);
+
+        const qreal gpuTime = debugger->avgGpuFrameTime();
+        if (gpuTime >= 0.0) {
+            lines << QString("Frame GPU time: %1 ms").arg(gpuTime, 0, 'f', 2);
+        } else {
+            lines << QString("Frame GPU time: n/a");
+        }
+
+        lines << QString("Texture upload: %1 KiB")
+                .arg(debugger->lastUploadBytes() / 1024);
+        lines << QString("Update queue depth: %1")
+                .arg(debugger->lastUpdateQueueDepth());
+        lines << QString("Postponed updates: %1")
+                .arg(debugger->postponedUpdatesCount());
+    }
+
     KisStrokeSpeedMonitor *monitor = KisStrokeSpeedMonitor::instance();
 
     if (monitor->haveStrokeSpeedMeasurement()) {
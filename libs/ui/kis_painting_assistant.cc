@@ -1097,6 +1097,24 @@ KisPaintingAssistantHandleSP KisPaintingAssistant::secondLocalHandle() const
     return 0;
 }
 
+bool KisPaintingAssistant::isPointSnappable(const QPointF& point, const QPointF& strokeBegin) const
+{
+    Q_UNUSED(strokeBegin);
+
+    /**
+     * Mirrors the gating the local assistants do themselves at the start of
+     * adjustPosition(): a point outside the local rectangle is rejected
+     * unless the stroke has already entered the rectangle before. Assistants
+     * without a (complete) local rectangle snap everywhere.
+     */
+    if (!isAssistantComplete() || m_hasBeenInsideLocalRect) {
+        return true;
+    }
+
+    const QRectF localRect = getLocalRect();
+    return localRect.isNull() || localRect.contains(point);
+}
+
 QRectF KisPaintingAssistant::getLocalRect() const
 {
     if (!isLocal() || !firstLocalHandle() || !secondLocalHandle()) {
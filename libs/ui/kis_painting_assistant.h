@@ -113,6 +113,18 @@ public:
      *                        (usually equals to 2px in screen coordinates converted to pt)
      */
     virtual QPointF adjustPosition(const QPointF& point, const QPointF& strokeBegin, bool snapToAny, qreal moveThresholdPt) = 0;
+
+    /**
+     * @brief isPointSnappable
+     * Cheap pre-check whether adjustPosition() can possibly snap the given
+     * point. The decoration calls it for every assistant on every tablet
+     * sample, so it must only consult cached data (e.g. the local rectangle
+     * or a cached grid polygon) and never do the full snapping math.
+     * Returning false means the assistant is guaranteed to reject the point;
+     * returning true just means it is worth evaluating.
+     */
+    virtual bool isPointSnappable(const QPointF& point, const QPointF& strokeBegin) const;
+
     virtual void adjustLine(QPointF& point, QPointF& strokeBegin) = 0;
     virtual void endStroke();
     virtual void setAdjustedBrushPosition(const QPointF position);
@@ -89,6 +89,8 @@ void KisPaintingAssistantsDecoration::slotConfigChanged()
     d->useCache =
         (drawMode == KisConfig::ASSISTANTS_DRAW_MODE_PIXMAP_CACHE) ||
         (drawMode == KisConfig::ASSISTANTS_DRAW_MODE_LARGE_PIXMAP_CACHE);
+
+    setCacheDirty();
 }
 
 void KisPaintingAssistantsDecoration::addAssistant(KisPaintingAssistantSP assistant)
@@ -178,6 +180,10 @@ QPointF KisPaintingAssistantsDecoration::adjustPosition(const QPointF& point, co
 
         Q_FOREACH (KisPaintingAssistantSP assistant, assistants()) {
             if (assistant->isSnappingActive() == true){ // the toggle button with eye icon to disable assistants
+                // cheap influence-region check before doing the full snapping math
+                if (!assistant->isPointSnappable(point, strokeBegin)) {
+                    continue;
+                }
                 QPointF newpoint = assistant->adjustPosition(point, strokeBegin, true, moveThresholdPt);
                 // Assistants that can't or don't want to snap return NaN values (aside from possible numeric issues)
                 // NOTE: It would be safer to also reject points too far outside canvas (or widget?) area,
@@ -372,6 +378,7 @@ int KisPaintingAssistantsDecoration::handleSize()
 void KisPaintingAssistantsDecoration::setHandleSize(int handleSize)
 {
     d->m_handleSize = handleSize;
+    setCacheDirty();
 }
 
 QList<KisPaintingAssistantHandleSP> KisPaintingAssistantsDecoration::handles()
@@ -416,23 +423,27 @@ KisPaintingAssistantSP KisPaintingAssistantsDecoration::selectedAssistant()
 void KisPaintingAssistantsDecoration::setSelectedAssistant(KisPaintingAssistantSP assistant)
 {
     d->selectedAssistant = assistant;
+    setCacheDirty();
     Q_EMIT selectedAssistantChanged();
 }
 
 void KisPaintingAssistantsDecoration::deselectAssistant()
 {
     d->selectedAssistant.clear();
+    setCacheDirty();
 }
 
 
 void KisPaintingAssistantsDecoration::setAssistantVisible(bool set)
 {
     d->assistantVisible=set;
+    setCacheDirty();
 }
 
 void KisPaintingAssistantsDecoration::setOutlineVisible(bool set)
 {
     d->outlineVisible=set;
+    setCacheDirty();
 }
 
 void KisPaintingAssistantsDecoration::setOnlyOneAssistantSnap(bool assistant)
@@ -458,6 +469,7 @@ void KisPaintingAssistantsDecoration::uncache()
     Q_FOREACH (KisPaintingAssistantSP assistant, assistants()) {
         assistant->uncache();
     }
+    setCacheDirty();
 }
 void KisPaintingAssistantsDecoration::toggleAssistantVisible()
 {
@@ -511,6 +523,16 @@ bool KisPaintingAssistantsDecoration::isEditingAssistants()
     return d->m_isEditingAssistants;
 }
 
+bool KisPaintingAssistantsDecoration::isCacheable() const
+{
+    /**
+     * The follow-brush preview and the editor widgets are driven by
+     * the assistants themselves, bypassing the mutators of this
+     * class, so only the plain line drawing may be cached.
+     */
+    return !d->m_isEditingAssistants && !d->outlineVisible;
+}
+
 QPointF KisPaintingAssistantsDecoration::snapToGuide(KoPointerEvent *e, const QPointF &offset, bool useModifiers)
 {
     if (!d->m_canvas || !d->m_canvas->currentImage()) {
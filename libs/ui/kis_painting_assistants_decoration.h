@@ -132,6 +132,10 @@ public:
     /// uncache all assistants
     void uncache();
 
+    /// the canvas widget may cache the decoration only while the
+    /// dynamic parts (follow-brush preview, editor widgets) are off
+    bool isCacheable() const override;
+
     int handleSize();
     void setHandleSize(int handleSize);
 
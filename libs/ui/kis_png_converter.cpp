@@ -1326,25 +1326,32 @@ KisImportExportErrorCode KisPNGConverter::buildFile(QIODevice* iodevice, const Q
     };
 
 
-    // Fill the data structure
-    RowPointersStruct rowPointers(imageRect.size(), device->pixelSize());
+    /**
+     * The image is converted and encoded in fixed-size bands of rows
+     * pulled straight from the device, so the peak memory usage does
+     * not depend on the image height. For interlaced export libpng
+     * requests the whole image once per pass, in which case the bands
+     * are simply converted again for every pass.
+     */
+    const int bandHeight = qMin(128, imageRect.height());
+
+    RowPointersStruct rowPointers(QSize(imageRect.width(), bandHeight), device->pixelSize());
 
-    int row = 0;
-    for (int y = imageRect.y(); y < imageRect.y() + imageRect.height(); y++, row++) {
+    auto convertRow = [&] (int y, png_byte *dstRow) -> bool {
         KisHLineConstIteratorSP it = device->createHLineConstIteratorNG(imageRect.x(), y, imageRect.width());
 
         switch (color_type) {
         case PNG_COLOR_TYPE_GRAY:
         case PNG_COLOR_TYPE_GRAY_ALPHA:
             if (color_nb_bits == 16) {
-                quint16 *dst = reinterpret_cast<quint16 *>(rowPointers.rows[row]);
+                quint16 *dst = reinterpret_cast<quint16 *>(dstRow);
                 do {
                     const quint16 *d = reinterpret_cast<const quint16 *>(it->oldRawData());
                     *(dst++) = d[0];
                     if (options.alpha) *(dst++) = d[1];
                 } while (it->nextPixel());
             } else {
-                quint8 *dst = rowPointers.rows[row];
+                quint8 *dst = dstRow;
                 do {
                     const quint8 *d = it->oldRawData();
                     *(dst++) = d[0];
@@ -1355,7 +1362,7 @@ KisImportExportErrorCode KisPNGConverter::buildFile(QIODevice* iodevice, const Q
         case PNG_COLOR_TYPE_RGB:
         case PNG_COLOR_TYPE_RGB_ALPHA:
             if (color_nb_bits == 16) {
-                quint16 *dst = reinterpret_cast<quint16 *>(rowPointers.rows[row]);
+                quint16 *dst = reinterpret_cast<quint16 *>(dstRow);
                 do {
                     const quint16 *d = reinterpret_cast<const quint16 *>(it->oldRawData());
                     *(dst++) = d[2];
@@ -1364,7 +1371,7 @@ KisImportExportErrorCode KisPNGConverter::buildFile(QIODevice* iodevice, const Q
                     if (options.alpha) *(dst++) = d[3];
                 } while (it->nextPixel());
             } else {
-                quint8 *dst = rowPointers.rows[row];
+                quint8 *dst = dstRow;
                 do {
                     const quint8 *d = it->oldRawData();
                     *(dst++) = d[2];
@@ -1375,7 +1382,7 @@ KisImportExportErrorCode KisPNGConverter::buildFile(QIODevice* iodevice, const Q
             }
             break;
         case PNG_COLOR_TYPE_PALETTE: {
-            quint8 *dst = rowPointers.rows[row];
+            quint8 *dst = dstRow;
             KisPNGWriteStream writestream(dst, color_nb_bits);
             do {
                 const quint8 *d = it->oldRawData();
@@ -1392,11 +1399,32 @@ KisImportExportErrorCode KisPNGConverter::buildFile(QIODevice* iodevice, const Q
         }
             break;
         default:
-            return ImportExportCodes::FormatColorSpaceUnsupported;
+            return false;
         }
-    }
 
-    png_write_image(png_ptr, rowPointers.rows);
+        return true;
+    };
+
+    const int numberOfPasses = png_set_interlace_handling(png_ptr);
+
+    for (int pass = 0; pass < numberOfPasses; pass++) {
+        for (int bandStart = imageRect.y();
+             bandStart < imageRect.y() + imageRect.height();
+             bandStart += bandHeight) {
+
+            const int bandRows =
+                qMin(bandHeight, imageRect.y() + imageRect.height() - bandStart);
+
+            for (int row = 0; row < bandRows; row++) {
+                if (!convertRow(bandStart + row, rowPointers.rows[row])) {
+                    return ImportExportCodes::FormatColorSpaceUnsupported;
+                }
+            }
+
+            png_write_rows(png_ptr, rowPointers.rows,
+                           static_cast<png_uint_32>(bandRows));
+        }
+    }
 
     // Writing is over
     png_write_end(png_ptr, info_ptr);
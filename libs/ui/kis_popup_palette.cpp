@@ -433,9 +433,52 @@ void KisPopupPalette::slotUpdate() {
         calculatePresetLayout();
     }
     m_canvasRotationIndicatorRect = rotationIndicatorRect(m_coordinatesConverter->rotationAngle());
+
+    /**
+     * Preset or tag changes arrive while the palette is hidden, so
+     * rebuilding the previews here keeps the scaling work off the
+     * open path
+     */
+    updatePresetPreviewCache(m_resourceManager->favoritePresetImages());
+
     update();
 }
 
+void KisPopupPalette::updatePresetPreviewCache(const QList<QImage> &images)
+{
+    const qreal devicePixelRatio = devicePixelRatioF();
+
+    QVector<qint64> sourceKeys;
+    QVector<QSize> boundsSizes;
+    sourceKeys.reserve(images.size());
+    boundsSizes.reserve(images.size());
+    for (int pos = 0; pos < images.size(); pos++) {
+        sourceKeys << images.at(pos).cacheKey();
+        boundsSizes << createPathFromPresetIndex(pos).boundingRect().toAlignedRect().size();
+    }
+
+    if (sourceKeys == m_cachedPresetSourceKeys &&
+        boundsSizes == m_cachedPresetBoundsSizes &&
+        qFuzzyCompare(m_cachedPresetDevicePixelRatio, devicePixelRatio)) {
+
+        return;
+    }
+
+    m_cachedPresetPreviews.clear();
+    for (int pos = 0; pos < images.size(); pos++) {
+        QImage preview;
+        if (!images.at(pos).isNull()) {
+            preview = images.at(pos).scaled(boundsSizes.at(pos)*devicePixelRatio, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+            preview.setDevicePixelRatio(devicePixelRatio);
+        }
+        m_cachedPresetPreviews << preview;
+    }
+
+    m_cachedPresetSourceKeys = sourceKeys;
+    m_cachedPresetBoundsSizes = boundsSizes;
+    m_cachedPresetDevicePixelRatio = devicePixelRatio;
+}
+
 //setting KisPopupPalette properties
 int KisPopupPalette::hoveredPreset() const
 {
@@ -627,7 +670,8 @@ void KisPopupPalette::paintEvent(QPaintEvent* e)
 
     // painting favorite brushes
     QList<QImage> images(m_resourceManager->favoritePresetImages());
-    
+    updatePresetPreviewCache(images);
+
     // painting favorite brushes pixmap/icon
     QPainterPath presetPath;
     int presetCount = images.size();
@@ -640,10 +684,8 @@ void KisPopupPalette::paintEvent(QPaintEvent* e)
             painter.setClipPath(presetPath);
 
             QRect bounds = presetPath.boundingRect().toAlignedRect();
-            if (!images.at(pos).isNull()) {
-                QImage previewHighDPI = images.at(pos).scaled(bounds.size()*devicePixelRatioF() , Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
-                previewHighDPI.setDevicePixelRatio(devicePixelRatioF());
-                painter.drawImage(bounds.topLeft(), previewHighDPI);
+            if (!m_cachedPresetPreviews.at(pos).isNull()) {
+                painter.drawImage(bounds.topLeft(), m_cachedPresetPreviews.at(pos));
             }
         } else {
             painter.fillPath(presetPath, palette().brush(QPalette::Window));  // brush slot that has no brush in it
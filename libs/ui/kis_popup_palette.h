@@ -118,6 +118,15 @@ private:
     void calculatePresetLayout();
     QPainterPath createPathFromPresetIndex(int index) const;
 
+    /**
+     * @brief Rebuild the pre-scaled preset previews if the source
+     * thumbnails, the slot geometry or the device pixel ratio changed;
+     * a no-op otherwise. Keeping the scaled previews around means
+     * opening the palette and hover repaints don't re-run a smooth
+     * scale per slot.
+     */
+    void updatePresetPreviewCache(const QList<QImage> &images);
+
     void calculateRotationSnapAreas();
 
     QPoint m_mirrorPos {};
@@ -179,6 +188,11 @@ private:
 
     CachedPresetLayout m_cachedPresetLayout;
 
+    QList<QImage> m_cachedPresetPreviews;
+    QVector<qint64> m_cachedPresetSourceKeys;
+    QVector<QSize> m_cachedPresetBoundsSizes;
+    qreal m_cachedPresetDevicePixelRatio {0.0};
+
     // updates the transparency and effects of the whole widget
     QGraphicsOpacityEffect *opacityChange {0};
     KisMouseClickEater *m_clicksEater;
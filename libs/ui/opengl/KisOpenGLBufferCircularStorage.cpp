@@ -6,16 +6,42 @@
 
 #include "KisOpenGLBufferCircularStorage.h"
 
+#include <cstring>
+#include <memory>
+
 #include <QtMath>
 
 #include "kis_assert.h"
 #include "kis_opengl.h"
+#include "KisOpenGLSync.h"
+
+#ifndef GL_MAP_WRITE_BIT
+    #define GL_MAP_WRITE_BIT 0x0002
+#endif
+#ifndef GL_MAP_PERSISTENT_BIT
+    #define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#ifndef GL_MAP_COHERENT_BIT
+    #define GL_MAP_COHERENT_BIT 0x0080
+#endif
+#ifndef GL_DYNAMIC_STORAGE_BIT
+    #define GL_DYNAMIC_STORAGE_BIT 0x0100
+#endif
 
 KisOpenGLBufferCircularStorage::BufferBinder::BufferBinder(KisOpenGLBufferCircularStorage *bufferStorage, const void **dataPtr, int dataSize) {
     if (bufferStorage) {
-        m_buffer = bufferStorage->getNextBuffer();
+        m_storage = bufferStorage;
+        m_buffer = bufferStorage->getNextBufferForUpload();
         m_buffer->bind();
-        m_buffer->write(0, *dataPtr, dataSize);
+
+        void *mappedPtr = bufferStorage->mappedPointerFor(m_buffer);
+        if (mappedPtr) {
+            // the mapping is coherent, so the upload is just a copy
+            // into the persistently mapped memory
+            memcpy(mappedPtr, *dataPtr, dataSize);
+        } else {
+            m_buffer->write(0, *dataPtr, dataSize);
+        }
         *dataPtr = nullptr;
     }
 
@@ -23,20 +49,23 @@ KisOpenGLBufferCircularStorage::BufferBinder::BufferBinder(KisOpenGLBufferCircul
 
 KisOpenGLBufferCircularStorage::BufferBinder::~BufferBinder() {
     if (m_buffer) {
-        m_buffer->release();
-
-        if (KisOpenGL::useTextureBufferInvalidation()) {
-            KisOpenGL::glInvalidateBufferData(m_buffer->bufferId());
-        }
+        m_storage->endUpload(m_buffer);
     }
 }
 
 struct Q_DECL_HIDDEN KisOpenGLBufferCircularStorage::Private
 {
+    struct BufferState {
+        void *mappedPtr = nullptr;
+        std::unique_ptr<KisOpenGLSync> uploadFence;
+    };
+
     std::vector<QOpenGLBuffer> buffers;
+    std::vector<BufferState> bufferStates;
     decltype(buffers)::size_type nextBuffer = 0;
     int bufferSize = 0;
     QOpenGLBuffer::Type type = QOpenGLBuffer::QOpenGLBuffer::VertexBuffer;
+    bool usePersistentMapping = false;
 };
 
 
@@ -58,6 +87,7 @@ void KisOpenGLBufferCircularStorage::allocate(int numBuffers, int bufferSize)
     reset();
     KIS_ASSERT(numBuffers > 0);
     KIS_ASSERT(bufferSize > 0);
+    m_d->usePersistentMapping = KisOpenGL::useBufferStorage();
     addBuffersImpl(static_cast<size_t>(numBuffers), bufferSize);
 }
 
@@ -70,6 +100,52 @@ QOpenGLBuffer *KisOpenGLBufferCircularStorage::getNextBuffer()
     return buffer;
 }
 
+QOpenGLBuffer *KisOpenGLBufferCircularStorage::getNextBufferForUpload()
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(isValid(), 0);
+
+    if (m_d->usePersistentMapping) {
+        Private::BufferState &state = m_d->bufferStates[m_d->nextBuffer];
+
+        if (state.uploadFence && !state.uploadFence->isSignaled()) {
+            // the GPU is still reading from the next buffer in the
+            // ring; grow the ring instead of stalling on the driver
+            // (the new buffers are placed right at the ring's head)
+            allocateMoreBuffers();
+        }
+    }
+
+    return getNextBuffer();
+}
+
+void *KisOpenGLBufferCircularStorage::mappedPointerFor(const QOpenGLBuffer *buffer) const
+{
+    const size_t index = buffer - m_d->buffers.data();
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(index < m_d->bufferStates.size(), nullptr);
+    return m_d->bufferStates[index].mappedPtr;
+}
+
+void KisOpenGLBufferCircularStorage::endUpload(QOpenGLBuffer *buffer)
+{
+    buffer->release();
+
+    const size_t index = buffer - m_d->buffers.data();
+    KIS_SAFE_ASSERT_RECOVER_RETURN(index < m_d->bufferStates.size());
+
+    Private::BufferState &state = m_d->bufferStates[index];
+
+    if (state.mappedPtr) {
+        // fence the texture upload, so that the buffer is handed
+        // out again only after the GPU has finished reading it
+        state.uploadFence.reset(new KisOpenGLSync());
+        return;
+    }
+
+    if (KisOpenGL::useTextureBufferInvalidation()) {
+        KisOpenGL::glInvalidateBufferData(buffer->bufferId());
+    }
+}
+
 bool KisOpenGLBufferCircularStorage::isValid() const
 {
     return !m_d->buffers.empty();
@@ -82,7 +158,9 @@ int KisOpenGLBufferCircularStorage::size() const
 
 void KisOpenGLBufferCircularStorage::reset()
 {
+    // destroying a buffer implicitly unmaps its persistent mapping
     m_d->buffers.clear();
+    m_d->bufferStates.clear();
     m_d->nextBuffer = 0;
     m_d->bufferSize = 0;
 }
@@ -107,8 +185,15 @@ void KisOpenGLBufferCircularStorage::allocateMoreBuffers()
     }();
     auto end = m_d->buffers.end();
 
+    const auto middleOffset = std::distance(begin, middle);
+
     std::rotate(begin, middle, end);
 
+    // keep the per-buffer states aligned with the rotated buffers
+    std::rotate(m_d->bufferStates.begin(),
+                std::next(m_d->bufferStates.begin(), middleOffset),
+                m_d->bufferStates.end());
+
     m_d->nextBuffer = m_d->buffers.size();
 
     const size_t buffersToAdd = numBuffers - m_d->buffers.size();
@@ -125,18 +210,37 @@ void KisOpenGLBufferCircularStorage::addBuffersImpl(size_t buffersToAdd, int buf
     if (m_d->buffers.capacity() < newSize)
         m_d->buffers.reserve(newSize);
 
+    if (m_d->bufferStates.capacity() < newSize)
+        m_d->bufferStates.reserve(newSize);
+
     // overflow check for size()
     KIS_ASSERT(m_d->buffers.size() <= std::numeric_limits<int>::max());
 
     for (size_t i = 0; i < buffersToAdd; i++) {
         m_d->buffers.emplace_back(m_d->type);
+        m_d->bufferStates.emplace_back();
 
         QOpenGLBuffer &buf = m_d->buffers.back();
+        Private::BufferState &state = m_d->bufferStates.back();
 
         buf.create();
-        buf.setUsagePattern(QOpenGLBuffer::DynamicDraw);
         buf.bind();
-        buf.allocate(m_d->bufferSize);
+
+        if (m_d->usePersistentMapping) {
+            // immutable storage, persistently mapped for the whole
+            // lifetime of the buffer; GL_DYNAMIC_STORAGE_BIT keeps
+            // plain write() usable in case the mapping fails
+            KisOpenGL::glBufferStorage(m_d->type, m_d->bufferSize, nullptr,
+                                       GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT |
+                                       GL_MAP_COHERENT_BIT | GL_DYNAMIC_STORAGE_BIT);
+            state.mappedPtr = KisOpenGL::glMapBufferRange(m_d->type, 0, m_d->bufferSize,
+                                                          GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT |
+                                                          GL_MAP_COHERENT_BIT);
+        } else {
+            buf.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+            buf.allocate(m_d->bufferSize);
+        }
+
         buf.release();
     }
 }
@@ -14,6 +14,14 @@
  * A simple storage class that owns a fixed amount of
  * QOpenGLBuffer objects and returns them sequentially.
  * Using multiple distinct buffers lets us avoid blocks
+ *
+ * When the driver supports GL_ARB_buffer_storage, the buffers
+ * are allocated as immutable storage and persistently mapped,
+ * so uploads through BufferBinder become a plain memcpy into
+ * coherently mapped memory. Each upload is guarded by a fence;
+ * when a buffer comes up for reuse while its fence is still
+ * unsignaled, the ring is grown instead of stalling on the
+ * driver.
  */
 class KisOpenGLBufferCircularStorage
 {
@@ -40,6 +48,7 @@ public:
         BufferBinder &operator=(BufferBinder &&) = delete;
 
     private:
+        KisOpenGLBufferCircularStorage *m_storage = nullptr;
         QOpenGLBuffer *m_buffer = nullptr;
     };
 
@@ -63,6 +72,9 @@ public:
 
 private:
     void addBuffersImpl(size_t buffersToAdd, int bufferSize);
+    QOpenGLBuffer *getNextBufferForUpload();
+    void *mappedPointerFor(const QOpenGLBuffer *buffer) const;
+    void endUpload(QOpenGLBuffer *buffer);
 
     struct Private;
     const QScopedPointer<Private> m_d;
@@ -862,6 +862,9 @@ void KisOpenGLCanvasRenderer::drawImage(const QRect &updateRect)
     const int firstCloneY = qFloor(qreal(firstRow) / imageRows);
     const int lastCloneY = qFloor(qreal(lastRow) / imageRows);
 
+    QVector<TileCloneRange> clones;
+    clones.reserve((lastCloneY - firstCloneY + 1) * (lastCloneX - firstCloneX + 1));
+
     for (int cloneY = firstCloneY; cloneY <= lastCloneY; cloneY++) {
         for (int cloneX = firstCloneX; cloneX <= lastCloneX; cloneX++) {
 
@@ -871,19 +874,23 @@ void KisOpenGLCanvasRenderer::drawImage(const QRect &updateRect)
             const int localFirstRow = cloneY == firstCloneY ? KisAlgebra2D::wrapValue(firstRow, imageRows) : 0;
             const int localLastRow = cloneY == lastCloneY ? KisAlgebra2D::wrapValue(lastRow, imageRows) : imageRows - 1;
 
-            drawImageTiles(localFirstCol, localLastCol,
-                           localFirstRow, localLastRow,
-                           scaleX, scaleY, QPoint(cloneX, cloneY));
+            clones.append({QPoint(cloneX, cloneY),
+                           localFirstCol, localLastCol,
+                           localFirstRow, localLastRow});
         }
     }
 
+    drawImageTiles(clones, scaleX, scaleY);
+
     d->displayShader->release();
 
     glDisable(GL_BLEND);
 }
 
-void KisOpenGLCanvasRenderer::drawImageTiles(int firstCol, int lastCol, int firstRow, int lastRow, qreal scaleX, qreal scaleY, const QPoint &wrapAroundOffset)
+void KisOpenGLCanvasRenderer::drawImageTiles(const QVector<TileCloneRange> &clones, qreal scaleX, qreal scaleY)
 {
+    if (clones.isEmpty()) return;
+
     KisCoordinatesConverter *converter = coordinatesConverter();
     const QSizeF &widgetSize = d->pixelAlignedWidgetSize;
 
@@ -893,27 +900,72 @@ void KisOpenGLCanvasRenderer::drawImageTiles(int firstCol, int lastCol, int firs
     //       this requires introducing a new coordinate system.
     projectionMatrix.ortho(0, widgetSize.width(), widgetSize.height(), 0, NEAR_VAL, FAR_VAL);
 
-    QTransform modelTransform = converter->imageToWidgetTransform();
+    const QTransform imageToWidgetTransform = converter->imageToWidgetTransform();
+    const QRect ir = d->openGLImageTextures->storedImageBounds();
+
+    /**
+     * The composited image is the same for every wrap-around clone, so
+     * the clones only differ in their model-view-projection matrix. The
+     * tiles are iterated in the outer loops and the clones in the inner
+     * one: this way the vertex buffers, the texture and the filtering
+     * parameters of each tile are set up only once, and only the matrix
+     * uniform changes between the repeated draws of the tile.
+     */
+    QVector<QMatrix4x4> cloneMatrices;
+    cloneMatrices.reserve(clones.size());
+
+    int firstCol = clones.first().firstCol;
+    int lastCol = clones.first().lastCol;
+    int firstRow = clones.first().firstRow;
+    int lastRow = clones.first().lastRow;
+
+    Q_FOREACH (const TileCloneRange &clone, clones) {
+        QTransform modelTransform = imageToWidgetTransform;
+
+        if (!clone.offset.isNull()) {
+            const QTransform wrapAroundTranslate = QTransform::fromTranslate(ir.width() * clone.offset.x(),
+                                                                       ir.height() * clone.offset.y());
+            modelTransform = wrapAroundTranslate * modelTransform;
+        }
 
-    if (!wrapAroundOffset.isNull()) {
-        const QRect ir = d->openGLImageTextures->storedImageBounds();
+        QMatrix4x4 modelMatrix(modelTransform);
+        modelMatrix.optimize();
+        cloneMatrices.append(projectionMatrix * modelMatrix);
 
-        const QTransform wrapAroundTranslate = QTransform::fromTranslate(ir.width() * wrapAroundOffset.x(),
-                                                                   ir.height() * wrapAroundOffset.y());
-        modelTransform = wrapAroundTranslate * modelTransform;
+        firstCol = qMin(firstCol, clone.firstCol);
+        lastCol = qMax(lastCol, clone.lastCol);
+        firstRow = qMin(firstRow, clone.firstRow);
+        lastRow = qMax(lastRow, clone.lastRow);
     }
 
-    // Set view/projection matrices
-    QMatrix4x4 modelMatrix(modelTransform);
-    modelMatrix.optimize();
-    modelMatrix = projectionMatrix * modelMatrix;
-    d->displayShader->setUniformValue(d->displayShader->location(Uniform::ModelViewProjection), modelMatrix);
-
     int lastTileLodPlane = -1;
+    int lastCloneMatrixIndex = -1;
+
+    /**
+     * The mipmap pyramids of the tiles are sampled only when the canvas
+     * actually minifies the image: the trilinear filter resolves to
+     * level 0 at 100% and above, and the high-quality downscale path
+     * activates below 50% only. When zoomed in there is no need to
+     * rebuild the pyramids of the tiles dirtied by an edit; they are
+     * regenerated lazily when the user zooms out again.
+     */
+    const bool mipLevelsInUse =
+        (d->filterMode == KisOpenGL::TrilinearFilterMode ||
+         d->filterMode == KisOpenGL::HighQualityFiltering) &&
+        !SCALE_MORE_OR_EQUAL_TO(scaleX, scaleY, 1.0);
 
     for (int col = firstCol; col <= lastCol; col++) {
         for (int row = firstRow; row <= lastRow; row++) {
 
+            bool tileVisible = false;
+            Q_FOREACH (const TileCloneRange &clone, clones) {
+                if (clone.containsTile(col, row)) {
+                    tileVisible = true;
+                    break;
+                }
+            }
+            if (!tileVisible) continue;
+
             KisTextureTile *tile =
                     d->openGLImageTextures->getTextureTileCR(col, row);
 
@@ -952,7 +1004,7 @@ void KisOpenGLCanvasRenderer::drawImageTiles(int firstCol, int lastCol, int firs
 
             // switching uniform is a rather expensive operation on macOS, so we change it only
             // when it is really needed
-            const int currentLodPlane = tile->bindToActiveTexture(d->lodSwitchInProgress);
+            const int currentLodPlane = tile->bindToActiveTexture(d->lodSwitchInProgress, mipLevelsInUse);
             if (d->displayShader->location(Uniform::FixedLodLevel) >= 0 &&
                 (lastTileLodPlane < 0 || lastTileLodPlane != currentLodPlane)) {
 
@@ -990,7 +1042,18 @@ void KisOpenGLCanvasRenderer::drawImageTiles(int firstCol, int lastCol, int firs
                 }
             }
 
-            glDrawArrays(GL_TRIANGLES, 0, 6);
+            for (int i = 0; i < clones.size(); i++) {
+                if (!clones[i].containsTile(col, row)) continue;
+
+                if (i != lastCloneMatrixIndex) {
+                    d->displayShader->setUniformValue(
+                        d->displayShader->location(Uniform::ModelViewProjection),
+                        cloneMatrices[i]);
+                    lastCloneMatrixIndex = i;
+                }
+
+                glDrawArrays(GL_TRIANGLES, 0, 6);
+            }
         }
     }
 
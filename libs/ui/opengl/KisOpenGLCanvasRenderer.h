@@ -103,7 +103,23 @@ private:
     void reportFailedShaderCompilation(const QString &context);
     void drawBackground(const QRect &updateRect);
     void drawImage(const QRect &updateRect);
-    void drawImageTiles(int firstCol, int lastCol, int firstRow, int lastRow, qreal scaleX, qreal scaleY, const QPoint &wrapAroundOffset);
+
+    /// One wrap-around repetition of the image and the (local) range of
+    /// texture tiles that is visible inside it
+    struct TileCloneRange {
+        QPoint offset;
+        int firstCol;
+        int lastCol;
+        int firstRow;
+        int lastRow;
+
+        bool containsTile(int col, int row) const {
+            return col >= firstCol && col <= lastCol &&
+                row >= firstRow && row <= lastRow;
+        }
+    };
+
+    void drawImageTiles(const QVector<TileCloneRange> &clones, qreal scaleX, qreal scaleY);
     void drawCheckers(const QRect &updateRect);
     void drawGrid(const QRect &updateRect);
 
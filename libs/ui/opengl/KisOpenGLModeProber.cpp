@@ -340,6 +340,10 @@ KisOpenGLModeProber::Result::Result(QOpenGLContext &context) {
     m_supportsBufferInvalidation = !m_isOpenGLES &&
             ((m_glMajorVersion >= 4 && m_glMinorVersion >= 3) ||
              context.hasExtension("GL_ARB_invalidate_subdata"));
+    m_supportsBufferStorage = !m_isOpenGLES &&
+            ((m_glMajorVersion >= 4 && m_glMinorVersion >= 4) ||
+             context.hasExtension("GL_ARB_buffer_storage"));
+
     m_supportsLod = context.format().majorVersion() >= 3 || (m_isOpenGLES && context.hasExtension("GL_EXT_shader_texture_lod"));
 
     m_extensions = context.extensions();
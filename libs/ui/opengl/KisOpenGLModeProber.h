@@ -121,6 +121,10 @@ public:
         return m_supportsBufferInvalidation;
     }
 
+    bool supportsBufferStorage() const {
+        return m_supportsBufferStorage;
+    }
+
 #ifdef Q_OS_WIN
     // This is only for detecting whether ANGLE is being used.
     // For detecting generic OpenGL ES please check isOpenGLES
@@ -157,6 +161,7 @@ private:
     bool m_supportsFBO = false;
     bool m_supportsBufferMapping = false;
     bool m_supportsBufferInvalidation = false;
+    bool m_supportsBufferStorage = false;
     bool m_supportsLod = false;
     QString m_rendererString;
     QString m_driverVersionString;
@@ -11,9 +11,41 @@
 
 #include "KisProofingConfiguration.h"
 
+#include <functional>
+#include <memory>
+#include <vector>
+
 #include <QReadWriteLock>
 #include <QReadLocker>
 #include <QWriteLocker>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
+
+namespace {
+
+class TilePreparationTask : public QRunnable
+{
+public:
+    TilePreparationTask(std::function<void()> func, QSemaphore *doneSemaphore)
+        : m_func(func),
+          m_doneSemaphore(doneSemaphore)
+    {
+        setAutoDelete(false);
+    }
+
+    void run() override {
+        m_func();
+        m_doneSemaphore->release();
+    }
+
+private:
+    std::function<void()> m_func;
+    QSemaphore *m_doneSemaphore;
+};
+
+}
 
 
 struct KRITAUI_NO_EXPORT KisOpenGLUpdateInfoBuilder::Private
@@ -30,6 +62,13 @@ struct KRITAUI_NO_EXPORT KisOpenGLUpdateInfoBuilder::Private
     KisProofingConfigurationSP proofingConfig;
     QScopedPointer<KoColorConversionTransformation> proofingTransform;
 
+    /**
+     * Extra transforms for the worker threads of the parallel tile
+     * conversion. The transforms wrap per-instance littleCMS handles
+     * that must not be shared between concurrently running threads.
+     */
+    std::vector<std::unique_ptr<KoColorConversionTransformation>> proofingTransformPool;
+
     KisTextureTileInfoPoolSP pool;
     QReadWriteLock lock;
 };
@@ -77,16 +116,30 @@ KisOpenGLUpdateInfoSP KisOpenGLUpdateInfoBuilder::buildUpdateInfo(const QRect &r
             KoColorConversionTransformation::Intent displayIntent = m_d->proofingConfig->determineDisplayIntent(m_d->conversionOptions.m_renderingIntent);
             KoColorConversionTransformation::ConversionFlags displayFlags =  m_d->proofingConfig->determineDisplayFlags(m_d->conversionOptions.m_conversionFlags);
 
-            m_d->proofingTransform.reset(KisTextureTileUpdateInfo::generateProofingTransform(
-                                             projection->colorSpace(),
-                                             m_d->conversionOptions.m_destinationColorSpace,
-                                             proofingSpace,
-                                             m_d->proofingConfig->conversionIntent,
-                                             displayIntent,
-                                             m_d->proofingConfig->useBlackPointCompensationFirstTransform,
-                                             m_d->proofingConfig->warningColor,
-                                             m_d->proofingConfig->determineAdaptationState(),
-                                             displayFlags));
+            auto createTransform = [&] () {
+                return KisTextureTileUpdateInfo::generateProofingTransform(
+                            projection->colorSpace(),
+                            m_d->conversionOptions.m_destinationColorSpace,
+                            proofingSpace,
+                            m_d->proofingConfig->conversionIntent,
+                            displayIntent,
+                            m_d->proofingConfig->useBlackPointCompensationFirstTransform,
+                            m_d->proofingConfig->warningColor,
+                            m_d->proofingConfig->determineAdaptationState(),
+                            displayFlags);
+            };
+
+            m_d->proofingTransform.reset(createTransform());
+
+            // one extra transform per possible worker thread of the
+            // parallel conversion below
+            if (m_d->proofingTransform) {
+                for (int i = 1; i < QThread::idealThreadCount(); i++) {
+                    KoColorConversionTransformation *transform = createTransform();
+                    if (!transform) break;
+                    m_d->proofingTransformPool.emplace_back(transform);
+                }
+            }
         }
     }
 
@@ -128,36 +181,105 @@ KisOpenGLUpdateInfoSP KisOpenGLUpdateInfoBuilder::buildUpdateInfo(const QRect &r
         alignedBounds = KisLodTransform::alignedRect(alignedBounds, levelOfDetail);
     }
 
+    QVector<QPoint> tileIndexes;
+    tileIndexes.reserve(numItems);
     for (int col = firstColumn; col <= lastColumn; col++) {
         for (int row = firstRow; row <= lastRow; row++) {
+            tileIndexes.append(QPoint(col, row));
+        }
+    }
 
-            const QRect alignedTileTextureRect = calculatePhysicalTileRect(col, row, bounds, levelOfDetail);
-
-            KisTextureTileUpdateInfoSP tileInfo(
-                        new KisTextureTileUpdateInfo(col, row,
-                                                     alignedTileTextureRect,
-                                                     alignedUpdateRect,
-                                                     alignedBounds,
-                                                     levelOfDetail,
-                                                     m_d->pool));
-            // Don't update empty tiles
-            if (tileInfo->valid()) {
-                tileInfo->retrieveData(projection, channelFlags, m_d->onlyOneChannelSelected, m_d->selectedChannelIndex);
-
-                if (convertColorSpace) {
-                    if (m_d->proofingTransform) {
-                        tileInfo->proofTo(m_d->conversionOptions.m_destinationColorSpace, m_d->proofingConfig->displayFlags, m_d->proofingTransform.data());
-                    } else {
-                        tileInfo->convertTo(m_d->conversionOptions.m_destinationColorSpace, m_d->conversionOptions.m_renderingIntent, m_d->conversionOptions.m_conversionFlags);
-                    }
+    QVector<KisTextureTileUpdateInfoSP> preparedTiles(tileIndexes.size());
+
+    auto prepareTile = [&] (int index, KoColorConversionTransformation *proofingTransform) {
+        const int col = tileIndexes[index].x();
+        const int row = tileIndexes[index].y();
+
+        const QRect alignedTileTextureRect = calculatePhysicalTileRect(col, row, bounds, levelOfDetail);
+
+        KisTextureTileUpdateInfoSP tileInfo(
+                    new KisTextureTileUpdateInfo(col, row,
+                                                 alignedTileTextureRect,
+                                                 alignedUpdateRect,
+                                                 alignedBounds,
+                                                 levelOfDetail,
+                                                 m_d->pool));
+        // Don't update empty tiles
+        if (tileInfo->valid()) {
+            tileInfo->retrieveData(projection, channelFlags, m_d->onlyOneChannelSelected, m_d->selectedChannelIndex);
+
+            if (convertColorSpace) {
+                if (proofingTransform) {
+                    tileInfo->proofTo(m_d->conversionOptions.m_destinationColorSpace, m_d->proofingConfig->displayFlags, proofingTransform);
+                } else {
+                    tileInfo->convertTo(m_d->conversionOptions.m_destinationColorSpace, m_d->conversionOptions.m_renderingIntent, m_d->conversionOptions.m_conversionFlags);
                 }
-
-                info->tileList.append(tileInfo);
             }
-            else {
-                dbgUI << "Trying to create an empty tileinfo record" << col << row << alignedTileTextureRect << updateRect << bounds;
+
+            preparedTiles[index] = tileInfo;
+        }
+        else {
+            dbgUI << "Trying to create an empty tileinfo record" << col << row << alignedTileTextureRect << updateRect << bounds;
+        }
+    };
+
+    /**
+     * Retrieving and converting the tiles is independent per tile: the
+     * projection device supports concurrent reads, the data buffers
+     * come from a thread-safe pool and convertPixelsTo() is stateless.
+     * The proofing transforms are not shareable between threads, so
+     * every worker gets its own copy from the pre-created pool. The
+     * channel-filtered path reads the configuration and stays on the
+     * calling thread.
+     */
+    const bool proofingActive = convertColorSpace && m_d->proofingTransform;
+
+    const bool parallelizeConversion =
+        tileIndexes.size() > 1 &&
+        channelFlags.isEmpty();
+
+    if (parallelizeConversion) {
+        int numTasks = qMin(QThread::idealThreadCount(), tileIndexes.size());
+        if (proofingActive) {
+            numTasks = qMin(numTasks, int(m_d->proofingTransformPool.size()) + 1);
+        }
+
+        QSemaphore doneSemaphore;
+        std::vector<std::unique_ptr<TilePreparationTask>> tasks;
+        tasks.reserve(numTasks);
+
+        for (int task = 0; task < numTasks; task++) {
+            KoColorConversionTransformation *proofingTransform =
+                !proofingActive ? nullptr :
+                task == 0 ? m_d->proofingTransform.data() :
+                m_d->proofingTransformPool[task - 1].get();
+
+            tasks.push_back(
+                std::make_unique<TilePreparationTask>(
+                    [&prepareTile, task, numTasks, proofingTransform, numTiles = tileIndexes.size()] () {
+                        for (int i = task; i < numTiles; i += numTasks) {
+                            prepareTile(i, proofingTransform);
+                        }
+                    },
+                    &doneSemaphore));
+
+            // if the pool is saturated, run the task in the calling thread
+            if (!QThreadPool::globalInstance()->tryStart(tasks.back().get())) {
+                tasks.back()->run();
             }
         }
+
+        doneSemaphore.acquire(static_cast<int>(tasks.size()));
+    } else {
+        for (int i = 0; i < tileIndexes.size(); i++) {
+            prepareTile(i, convertColorSpace ? m_d->proofingTransform.data() : nullptr);
+        }
+    }
+
+    Q_FOREACH (const KisTextureTileUpdateInfoSP &tileInfo, preparedTiles) {
+        if (tileInfo) {
+            info->tileList.append(tileInfo);
+        }
     }
 
     info->assignDirtyImageRect(rect);
@@ -209,8 +331,9 @@ void KisOpenGLUpdateInfoBuilder::setConversionOptions(const ConversionOptions &o
     QWriteLocker lock(&m_d->lock);
 
     m_d->conversionOptions = options;
-    // the proofing transform becomes invalid when the target colorspace changes
+    // the proofing transforms become invalid when the target colorspace changes
     m_d->proofingTransform.reset();
+    m_d->proofingTransformPool.clear();
 }
 
 void KisOpenGLUpdateInfoBuilder::setChannelFlags(const QBitArray &channelFrags, bool onlyOneChannelSelected, int selectedChannelIndex)
@@ -255,6 +378,7 @@ void KisOpenGLUpdateInfoBuilder::setProofingConfig(KisProofingConfigurationSP co
 
     m_d->proofingConfig = config;
     m_d->proofingTransform.reset();
+    m_d->proofingTransformPool.clear();
 }
 
 KisProofingConfigurationSP KisOpenGLUpdateInfoBuilder::proofingConfig() const
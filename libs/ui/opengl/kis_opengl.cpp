@@ -55,8 +55,12 @@
 #endif
 
 typedef void (APIENTRYP PFNGLINVALIDATEBUFFERDATAPROC) (GLuint buffer);
+typedef void (APIENTRYP PFNGLBUFFERSTORAGEPROC) (GLenum target, GLsizeiptr size, const void *data, GLbitfield flags);
+typedef void *(APIENTRYP PFNGLMAPBUFFERRANGEPROC) (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
 #else
 typedef void (QOPENGLF_APIENTRYP PFNGLINVALIDATEBUFFERDATAPROC) (GLuint buffer);
+typedef void (QOPENGLF_APIENTRYP PFNGLBUFFERSTORAGEPROC) (GLenum target, GLsizeiptr size, const void *data, GLbitfield flags);
+typedef void *(QOPENGLF_APIENTRYP PFNGLMAPBUFFERRANGEPROC) (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
 #endif
 
 namespace
@@ -83,6 +87,10 @@ namespace
     bool g_useBufferInvalidation = false;
     PFNGLINVALIDATEBUFFERDATAPROC g_glInvalidateBufferData = nullptr;
 
+    bool g_useBufferStorage = true;
+    PFNGLBUFFERSTORAGEPROC g_glBufferStorage = nullptr;
+    PFNGLMAPBUFFERRANGEPROC g_glMapBufferRange = nullptr;
+
     bool g_forceDisableTextureBuffers = false;
 
     void overrideSupportedRenderers(KisOpenGL::OpenGLRenderers supportedRenderers, KisOpenGL::OpenGLRenderer preferredByQt) {
@@ -183,6 +191,7 @@ void KisOpenGL::initialize()
         debugOut << "\n  Is OpenGL ES:" << openGLCheckResult->isOpenGLES();
         debugOut << "\n  supportsBufferMapping:" << openGLCheckResult->supportsBufferMapping();
         debugOut << "\n  supportsBufferInvalidation:" << openGLCheckResult->supportsBufferInvalidation();
+        debugOut << "\n  supportsBufferStorage:" << openGLCheckResult->supportsBufferStorage();
         debugOut << "\n  forceDisableTextureBuffers:" << g_forceDisableTextureBuffers;
         debugOut << "\n  Extensions:";
         {
@@ -236,6 +245,9 @@ void KisOpenGL::initialize()
     g_useBufferInvalidation = cfg.readEntry("useBufferInvalidation", false);
     KisUsageLogger::writeSysInfo(QString("\nuseBufferInvalidation (config option): %1\n").arg(g_useBufferInvalidation ? "true" : "false"));
 
+    g_useBufferStorage = cfg.readEntry("useBufferStorage", true);
+    KisUsageLogger::writeSysInfo(QString("useBufferStorage (config option): %1\n").arg(g_useBufferStorage ? "true" : "false"));
+
     if ((isOnX11 && openGLCheckResult->rendererString().startsWith("AMD")) || cfg.forceOpenGLFenceWorkaround()) {
         g_needsFenceWorkaround = true;
     }
@@ -298,6 +310,17 @@ void KisOpenGL::initializeContext(QOpenGLContext *ctx)
         g_glInvalidateBufferData = (PFNGLINVALIDATEBUFFERDATAPROC)ctx->getProcAddress("glInvalidateBufferData");
     }
 
+    if (openGLCheckResult->supportsBufferStorage()) {
+        QOpenGLContext *ctx = QOpenGLContext::currentContext();
+        g_glBufferStorage = (PFNGLBUFFERSTORAGEPROC)ctx->getProcAddress("glBufferStorage");
+        g_glMapBufferRange = (PFNGLMAPBUFFERRANGEPROC)ctx->getProcAddress("glMapBufferRange");
+
+        if (!g_glBufferStorage || !g_glMapBufferRange) {
+            g_glBufferStorage = nullptr;
+            g_glMapBufferRange = nullptr;
+        }
+    }
+
     QFile log(QStandardPaths::writableLocation(QStandardPaths::TempLocation) + "/krita-opengl.txt");
     log.open(QFile::WriteOnly);
     QString vendor((const char*)f->glGetString(GL_VENDOR));
@@ -371,6 +394,19 @@ bool KisOpenGL::supportsBufferMapping()
     return openGLCheckResult && openGLCheckResult->supportsBufferMapping();
 }
 
+bool KisOpenGL::supportsBufferStorage()
+{
+    initialize();
+    return openGLCheckResult && openGLCheckResult->supportsBufferStorage();
+}
+
+bool KisOpenGL::useBufferStorage()
+{
+    initialize();
+    return g_useBufferStorage &&
+        g_glBufferStorage && g_glMapBufferRange;
+}
+
 bool KisOpenGL::forceDisableTextureBuffers()
 {
     initialize();
@@ -417,6 +453,16 @@ void KisOpenGL::glInvalidateBufferData(uint buffer)
     g_glInvalidateBufferData(buffer);
 }
 
+void KisOpenGL::glBufferStorage(uint target, int size, const void *data, uint flags)
+{
+    g_glBufferStorage(target, size, data, flags);
+}
+
+void *KisOpenGL::glMapBufferRange(uint target, int offset, int length, uint access)
+{
+    return g_glMapBufferRange(target, offset, length, access);
+}
+
 KisOpenGL::OpenGLRenderer KisOpenGL::getCurrentOpenGLRenderer()
 {
     if (!openGLCheckResult) return RendererAuto;
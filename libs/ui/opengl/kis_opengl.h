@@ -102,6 +102,16 @@ public:
 
     static bool supportsBufferMapping();
 
+    /**
+     * @brief supportsBufferStorage
+     * @return True if OpenGL provides immutable buffer storage
+     * (GL_ARB_buffer_storage), needed for persistently mapped
+     * upload buffers.
+     */
+    static bool supportsBufferStorage();
+
+    static bool useBufferStorage();
+
     static bool forceDisableTextureBuffers();
     static bool shouldUseTextureBuffers(bool userPreference);
 
@@ -126,6 +136,9 @@ public:
 
     static void glInvalidateBufferData(uint buffer);
 
+    static void glBufferStorage(uint target, int size, const void *data, uint flags);
+    static void *glMapBufferRange(uint target, int offset, int length, uint access);
+
 private:
     static void fakeInitWindowsOpenGL(KisOpenGL::OpenGLRenderers supportedRenderers, KisOpenGL::OpenGLRenderer preferredByQt);
 
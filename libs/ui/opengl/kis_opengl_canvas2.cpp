@@ -19,7 +19,10 @@
 #include "kis_debug.h"
 #include <KisViewManager.h>
 #include "KisRepaintDebugger.h"
+#include <KisStrokeLatencyTracer.h>
 
+#include <QElapsedTimer>
+#include <QOpenGLTimerQuery>
 #include <QPointer>
 #include "KisOpenGLModeProber.h"
 #include "KisOpenGLContextSwitchLock.h"
@@ -66,6 +69,19 @@ public:
     KisOpenGLCanvasRenderer *renderer;
     QScopedPointer<KisOpenGLSync> glSyncObject;
     KisRepaintDebugger repaintDbg;
+
+    /**
+     * GL timer queries for the performance HUD. Two queries are used in
+     * a ping-pong fashion, because the result of a query becomes
+     * available only a frame or two after it has been issued.
+     */
+    struct GpuFrameTimer {
+        QScopedPointer<QOpenGLTimerQuery> query;
+        bool hasPendingResult {false};
+    };
+    GpuFrameTimer gpuTimers[2];
+    int gpuTimerIndex {0};
+    bool gpuTimersSupported {true};
 };
 
 KisOpenGLCanvas2::KisOpenGLCanvas2(KisCanvas2 *canvas,
@@ -205,7 +221,50 @@ void KisOpenGLCanvas2::paintGL()
         cfg.writeEntry("canvasState", "OPENGL_PAINT_STARTED");
     }
 
-    KisOpenglCanvasDebugger::instance()->notifyPaintRequested();
+    KisOpenglCanvasDebugger *debugger = KisOpenglCanvasDebugger::instance();
+    debugger->notifyPaintRequested();
+
+    const bool collectPerfStats = debugger->showPerfHudOnCanvas();
+    bool gpuTimerStarted = false;
+    QElapsedTimer frameTimer;
+
+    if (collectPerfStats) {
+        frameTimer.start();
+
+        // timer queries are not available on OpenGL ES
+        if (d->gpuTimersSupported && KisOpenGL::hasOpenGLES()) {
+            d->gpuTimersSupported = false;
+        }
+
+        if (d->gpuTimersSupported && !d->gpuTimers[0].query) {
+            for (Private::GpuFrameTimer &timer : d->gpuTimers) {
+                timer.query.reset(new QOpenGLTimerQuery(context()));
+                if (!timer.query->create()) {
+                    d->gpuTimers[0].query.reset();
+                    d->gpuTimers[1].query.reset();
+                    d->gpuTimersSupported = false;
+                    break;
+                }
+            }
+        }
+
+        if (d->gpuTimersSupported) {
+            Private::GpuFrameTimer &timer = d->gpuTimers[d->gpuTimerIndex];
+
+            if (timer.hasPendingResult && timer.query->isResultAvailable()) {
+                debugger->notifyGpuFrameTime(timer.query->waitForResult() / 1000.0);
+                timer.hasPendingResult = false;
+            }
+
+            // when the GPU lags more than two frames behind, skip the
+            // measurement instead of stalling on the pending result
+            if (!timer.hasPendingResult) {
+                timer.query->begin();
+                gpuTimerStarted = true;
+            }
+        }
+    }
+
     QRect canvasImageDirtyRect = d->canvasImageDirtyRect & rect();
     d->canvasImageDirtyRect = QRect();
     d->renderer->paintCanvasOnly(canvasImageDirtyRect, updateRect);
@@ -226,6 +285,17 @@ void KisOpenGLCanvas2::paintGL()
 
     d->repaintDbg.paint(this, updateRect.isEmpty() ? rect() : updateRect);
 
+    if (collectPerfStats) {
+        if (gpuTimerStarted) {
+            Private::GpuFrameTimer &timer = d->gpuTimers[d->gpuTimerIndex];
+            timer.query->end();
+            timer.hasPendingResult = true;
+            d->gpuTimerIndex = (d->gpuTimerIndex + 1) % 2;
+        }
+
+        debugger->notifyFrameRenderTime(frameTimer.nsecsElapsed() / 1000.0);
+    }
+
     // We create the glFenceSync object here instead of in KisOpenGLRenderer,
     // because the glFenceSync object should be created after all render
     // commands in a frame, not just the OpenGL canvas itself. Putting it
@@ -233,6 +303,8 @@ void KisOpenGLCanvas2::paintGL()
     // rendering, which a QtQuick2-based canvas will need.
     d->glSyncObject.reset(new KisOpenGLSync());
 
+    KisStrokeLatencyTracer::instance()->traceStage(KisStrokeLatencyTracer::FramePresented);
+
     if (!OPENGL_SUCCESS) {
         KisConfig cfg(false);
         cfg.writeEntry("canvasState", "OPENGL_SUCCESS");
@@ -33,8 +33,29 @@ struct KisOpenglCanvasDebugger::Private
     int syncFlaggedSum;
 
     bool isEnabled;
+    bool isHudEnabled {false};
+
+    /**
+     * The per-frame values are smoothed with an exponential moving
+     * average, so the HUD stays readable while still following the
+     * recent frames.
+     */
+    qreal avgCpuTimeUsecs {0.0};
+    qreal avgGpuTimeUsecs {-1.0};
+    quint64 pendingUploadBytes {0};
+    quint64 lastUploadBytes {0};
+    int lastQueueDepth {0};
+    int postponedUpdates {0};
 };
 
+namespace {
+inline qreal movingAverage(qreal avg, qreal value)
+{
+    const qreal alpha = 0.1;
+    return avg > 0.0 ? avg * (1.0 - alpha) + value * alpha : value;
+}
+}
+
 Q_GLOBAL_STATIC(KisOpenglCanvasDebugger, s_instance)
 
 KisOpenglCanvasDebugger::KisOpenglCanvasDebugger()
@@ -74,12 +95,86 @@ void KisOpenglCanvasDebugger::slotConfigChanged()
 {
     KisConfig cfg(true);
     m_d->isEnabled = cfg.enableOpenGLFramerateLogging();
+    m_d->isHudEnabled = cfg.enableCanvasPerfHud();
 
     if (m_d->isEnabled) {
         m_d->time.start();
     }
 }
 
+bool KisOpenglCanvasDebugger::showPerfHudOnCanvas() const
+{
+    return m_d->isHudEnabled;
+}
+
+void KisOpenglCanvasDebugger::notifyFrameRenderTime(qreal cpuTimeUsecs)
+{
+    if (!m_d->isHudEnabled) return;
+
+    m_d->avgCpuTimeUsecs = movingAverage(m_d->avgCpuTimeUsecs, cpuTimeUsecs);
+
+    /**
+     * The uploads happen from a different code path than the canvas
+     * repaints, so attribute everything uploaded since the last frame
+     * to the frame that is being rendered now.
+     */
+    m_d->lastUploadBytes = m_d->pendingUploadBytes;
+    m_d->pendingUploadBytes = 0;
+}
+
+void KisOpenglCanvasDebugger::notifyGpuFrameTime(qreal gpuTimeUsecs)
+{
+    if (!m_d->isHudEnabled) return;
+
+    m_d->avgGpuTimeUsecs = movingAverage(m_d->avgGpuTimeUsecs, gpuTimeUsecs);
+}
+
+void KisOpenglCanvasDebugger::notifyTextureUpload(quint64 bytes)
+{
+    if (!m_d->isHudEnabled) return;
+
+    m_d->pendingUploadBytes += bytes;
+}
+
+void KisOpenglCanvasDebugger::notifyUpdateQueueDepth(int depth)
+{
+    if (!m_d->isHudEnabled) return;
+
+    m_d->lastQueueDepth = depth;
+}
+
+void KisOpenglCanvasDebugger::notifyCanvasUpdatePostponed()
+{
+    if (!m_d->isHudEnabled) return;
+
+    m_d->postponedUpdates++;
+}
+
+qreal KisOpenglCanvasDebugger::avgCpuFrameTime() const
+{
+    return m_d->avgCpuTimeUsecs / 1000.0;
+}
+
+qreal KisOpenglCanvasDebugger::avgGpuFrameTime() const
+{
+    return m_d->avgGpuTimeUsecs >= 0.0 ? m_d->avgGpuTimeUsecs / 1000.0 : -1.0;
+}
+
+quint64 KisOpenglCanvasDebugger::lastUploadBytes() const
+{
+    return m_d->lastUploadBytes;
+}
+
+int KisOpenglCanvasDebugger::lastUpdateQueueDepth() const
+{
+    return m_d->lastQueueDepth;
+}
+
+int KisOpenglCanvasDebugger::postponedUpdatesCount() const
+{
+    return m_d->postponedUpdates;
+}
+
 void KisOpenglCanvasDebugger::notifyPaintRequested()
 {
     if (!m_d->isEnabled) return;
@@ -26,6 +26,28 @@ public:
     void notifySyncStatus(bool value);
     qreal accumulatedFps();
 
+    /**
+     * The on-canvas performance HUD. When enabled, the canvas feeds
+     * per-frame statistics into the debugger, and KisFpsDecoration
+     * renders them on top of the canvas.
+     */
+    bool showPerfHudOnCanvas() const;
+
+    void notifyFrameRenderTime(qreal cpuTimeUsecs);
+    void notifyGpuFrameTime(qreal gpuTimeUsecs);
+    void notifyTextureUpload(quint64 bytes);
+    void notifyUpdateQueueDepth(int depth);
+    void notifyCanvasUpdatePostponed();
+
+    /// smoothed CPU-side frame preparation time, in milliseconds
+    qreal avgCpuFrameTime() const;
+    /// smoothed GPU frame time, in milliseconds; negative when no
+    /// timer-query result has arrived (yet) or queries are unsupported
+    qreal avgGpuFrameTime() const;
+    quint64 lastUploadBytes() const;
+    int lastUpdateQueueDepth() const;
+    int postponedUpdatesCount() const;
+
 private Q_SLOTS:
     void slotConfigChanged();
 
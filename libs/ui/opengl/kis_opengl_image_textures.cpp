@@ -29,6 +29,8 @@
 #include "KisOpenGLModeProber.h"
 #include "kis_fixed_paint_device.h"
 #include "KisOpenGLSync.h"
+#include <KisStrokeLatencyTracer.h>
+#include "opengl/kis_opengl_canvas_debugger.h"
 #include <QVector3D>
 #include "kis_painting_tweaks.h"
 #include "KisOpenGLBufferCreationGuard.h"
@@ -64,6 +66,16 @@
 #define GL_RGBA16_EXT 0x805B
 #endif
 
+// GL_ARB_texture_compression_bptc
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#endif
+
+// GL_EXT_texture_compression_s3tc
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
 //#define DEBUG_BUFFER_REALLOCATION
 
 
@@ -343,6 +355,8 @@ void KisOpenGLImageTextures::recalculateCache(KisUpdateInfoSP info, bool blockMi
     QScopedPointer<KisOpenGLSync> sync;
     int numProcessedTiles = 0;
 
+    quint64 uploadedBytes = 0;
+
     KisTextureTileUpdateInfoSP tileInfo;
     Q_FOREACH (tileInfo, glInfo->tileList) {
         KisTextureTile *tile = getTextureTileCR(tileInfo->tileCol(), tileInfo->tileRow());
@@ -364,6 +378,7 @@ void KisOpenGLImageTextures::recalculateCache(KisUpdateInfoSP info, bool blockMi
 
 
         tile->update(*tileInfo, blockMipmapRegeneration);
+        uploadedBytes += tileInfo->patchPixelsLength();
 
         if (m_bufferStorage.isValid()) {
             if (!sync) {
@@ -375,6 +390,11 @@ void KisOpenGLImageTextures::recalculateCache(KisUpdateInfoSP info, bool blockMi
             numProcessedTiles++;
         }
     }
+
+    if (!glInfo->tileList.isEmpty()) {
+        KisOpenglCanvasDebugger::instance()->notifyTextureUpload(uploadedBytes);
+        KisStrokeLatencyTracer::instance()->traceStage(KisStrokeLatencyTracer::TextureUploaded);
+    }
 }
 
 void KisOpenGLImageTextures::generateCheckerTexture(const QImage &checkImage)
@@ -844,6 +864,33 @@ void KisOpenGLImageTextures::updateTextureFormat()
         }
     }
 
+    /**
+     * For 8-bit SDR documents the tiles may optionally be kept in a
+     * driver-compressed format while they are not edited, which cuts
+     * the VRAM footprint of large documents roughly by a factor of
+     * four. KisTextureTile promotes a tile back to the uncompressed
+     * working format as soon as it receives a partial update, i.e.
+     * when it comes under active editing.
+     */
+    m_texturesInfo.compressedInternalFormat = 0;
+
+    {
+        KisConfig cfg(true);
+
+        if (cfg.readEntry("useCompressedTextures", false) &&
+            !KisOpenGL::hasOpenGLES() &&
+            m_texturesInfo.internalFormat == GL_RGBA8) {
+
+            if (ctx->hasExtension("GL_ARB_texture_compression_bptc")) {
+                m_texturesInfo.compressedInternalFormat = GL_COMPRESSED_RGBA_BPTC_UNORM;
+                dbgUI << "Using BPTC compression for static tiles";
+            } else if (ctx->hasExtension("GL_EXT_texture_compression_s3tc")) {
+                m_texturesInfo.compressedInternalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+                dbgUI << "Using S3TC compression for static tiles";
+            }
+        }
+    }
+
     if (!m_internalColorManagementActive &&
             colorModelId != destinationColorModelId) {
 
@@ -67,7 +67,10 @@ KisShaderProgram *KisOpenGLShaderLoader::loadShader(QString vertPath, QString fr
     vertexShaderFile.open(QIODevice::ReadOnly);
     vertSource.append(vertexShaderFile.readAll());
 
-    result = shader->addShaderFromSourceCode(QOpenGLShader::Vertex, vertSource);
+    // The cacheable variant lets Qt serve the program from its on-disk
+    // binary cache (keyed by driver and source hash), so only the very
+    // first canvas after a driver change pays the compile time.
+    result = shader->addCacheableShaderFromSourceCode(QOpenGLShader::Vertex, vertSource);
     if (!result)
         throw ShaderLoaderException(QString("%1: %2 - Cause: %3").arg("Failed to add vertex shader source from file", vertPath, shader->log()));
 
@@ -107,7 +110,7 @@ KisShaderProgram *KisOpenGLShaderLoader::loadShader(QString vertPath, QString fr
     fragmentShaderFile.open(QIODevice::ReadOnly);
     fragSource.append(fragmentShaderFile.readAll());
 
-    result = shader->addShaderFromSourceCode(QOpenGLShader::Fragment, fragSource);
+    result = shader->addCacheableShaderFromSourceCode(QOpenGLShader::Fragment, fragSource);
     if (!result)
         throw ShaderLoaderException(QString("%1: %2 - Cause: %3").arg("Failed to add fragment shader source from file", fragPath, shader->log()));
 
@@ -10,6 +10,7 @@
 #include "KisOpenGLBufferCircularStorage.h"
 
 #include <kis_debug.h>
+#include <QOpenGLContext>
 #if !defined(QT_OPENGL_ES)
 #include <QOpenGLBuffer>
 #endif
@@ -97,11 +98,19 @@ KisTextureTile::KisTextureTile(const QRect &imageRect, const KisGLTexturesInfo *
 
     setTextureParameters();
 
+    // static tiles start in the compressed format when it is
+    // available; the driver compresses the data on upload. All the
+    // levels are marked at once: the mip levels inherit the internal
+    // format of level 0 when they get (re)generated
+    m_compressedFormatLevels = m_texturesInfo->compressedInternalFormat != 0 ? ~0u : 0u;
+
     KisOpenGLBufferCircularStorage::BufferBinder binder(
         m_bufferStorage, &fd, fillData.size());
 
     f->glTexImage2D(GL_TEXTURE_2D, 0,
-                 m_texturesInfo->internalFormat,
+                 levelUsesCompressedFormat(0) ?
+                     m_texturesInfo->compressedInternalFormat :
+                     m_texturesInfo->internalFormat,
                  m_texturesInfo->width,
                  m_texturesInfo->height, 0,
                  m_texturesInfo->format,
@@ -117,13 +126,23 @@ KisTextureTile::~KisTextureTile()
     f->glDeleteTextures(1, &m_textureId);
 }
 
-int KisTextureTile::bindToActiveTexture(bool blockMipmapRegeneration)
+int KisTextureTile::bindToActiveTexture(bool blockMipmapRegeneration, bool mipLevelsInUse)
 {
     f->glBindTexture(GL_TEXTURE_2D, m_textureId);
 
     if (m_needsMipmapRegeneration && !blockMipmapRegeneration) {
-        regenerateMipmap();
-        setPreparedLodPlane(0);
+        /**
+         * The tile's mipmap chain is our GPU-resident downscale
+         * pyramid; it is sampled only when the canvas minifies the
+         * image or while an Instant Preview plane is displayed. When
+         * the view samples level 0 exclusively, rebuilding the chain
+         * after every edit is wasted work, so the chain stays dirty
+         * and is regenerated on the first bind that needs it.
+         */
+        if (mipLevelsInUse || m_preparedLodPlane > 0) {
+            regenerateMipmap();
+            setPreparedLodPlane(0);
+        }
     }
 
     return m_preparedLodPlane;
@@ -149,6 +168,69 @@ void KisTextureTile::regenerateMipmap()
     f->glGenerateMipmap(GL_TEXTURE_2D);
     m_mipmapHasBeenAllocated = true;
     m_needsMipmapRegeneration = false;
+
+    // the regenerated levels inherit the internal format of level 0
+    m_compressedFormatLevels = levelUsesCompressedFormat(0) ? ~0u : 0u;
+}
+
+void KisTextureTile::promoteToUncompressedFormat(int level)
+{
+#ifndef QT_OPENGL_ES_2
+    /**
+     * A partial update means the tile is under active editing, so we
+     * respecify the level in the uncompressed working format.
+     * Otherwise every glTexSubImage2D() of the stroke would force the
+     * driver to decompress and recompress the touched blocks (and
+     * partial uploads into S3TC/BPTC levels are invalid at
+     * non-block-aligned offsets in the first place).
+     *
+     * The level's current content is read back in the transfer format;
+     * the compression path is only enabled for 8-bit RGBA textures,
+     * so the pixel size is known to be 4 bytes.
+     */
+    const int levelWidth = qMax(1, m_texturesInfo->width >> level);
+    const int levelHeight = qMax(1, m_texturesInfo->height >> level);
+
+    QByteArray scratch(levelWidth * levelHeight * 4, 0);
+
+    /**
+     * glGetTexImage() is not a member of QOpenGLFunctions (it has no
+     * GL ES counterpart) and kritaui doesn't link the GL library
+     * directly, so the entry point is resolved through the context
+     */
+    typedef void (QOPENGLF_APIENTRYP kis_glGetTexImage_t)(GLenum target, GLint level,
+                                                          GLenum format, GLenum type,
+                                                          void *pixels);
+    kis_glGetTexImage_t getTexImage =
+        reinterpret_cast<kis_glGetTexImage_t>(
+            QOpenGLContext::currentContext()->getProcAddress("glGetTexImage"));
+
+    // on a context without readback support the level is respecified
+    // from zeroed scratch; the following sub-image upload still
+    // repaints the updated part
+    KIS_SAFE_ASSERT_RECOVER_NOOP(getTexImage);
+
+    if (getTexImage) {
+        getTexImage(GL_TEXTURE_2D, level,
+                    m_texturesInfo->format,
+                    m_texturesInfo->type,
+                    scratch.data());
+    }
+
+    f->glTexImage2D(GL_TEXTURE_2D, level,
+                    m_texturesInfo->internalFormat,
+                    levelWidth,
+                    levelHeight, 0,
+                    m_texturesInfo->format,
+                    m_texturesInfo->type,
+                    scratch.constData());
+
+    if (level == 0) {
+        setNeedsMipmapRegeneration();
+    }
+#endif
+
+    m_compressedFormatLevels &= ~(1u << level);
 }
 
 void KisTextureTile::update(const KisTextureTileUpdateInfo &updateInfo, bool blockMipmapRegeneration)
@@ -164,6 +246,10 @@ void KisTextureTile::update(const KisTextureTileUpdateInfo &updateInfo, bool blo
 
     const GLvoid *fd = updateInfo.data();
 
+    if (levelUsesCompressedFormat(0) && !updateInfo.isEntireTileUpdated()) {
+        promoteToUncompressedFormat(0);
+    }
+
     /**
      * In some special case, when the Lod0 stroke is cancelled the
      * following situation is possible:
@@ -201,18 +287,43 @@ void KisTextureTile::update(const KisTextureTileUpdateInfo &updateInfo, bool blo
         regenerateMipmap();
     }
 
+    /**
+     * A LodN plane uploaded while the tile was still compressed keeps
+     * the compressed format after level 0 has been promoted (unless
+     * the mipmap regeneration above has just respecified it), so the
+     * target level has to be promoted separately before any partial
+     * sub-image upload into it
+     */
+    if (!updateInfo.isEntireTileUpdated() &&
+        patchLevelOfDetail > 0 &&
+        levelUsesCompressedFormat(patchLevelOfDetail)) {
+
+        promoteToUncompressedFormat(patchLevelOfDetail);
+    }
 
     if (updateInfo.isEntireTileUpdated()) {
         KisOpenGLBufferCircularStorage::BufferBinder b(
             m_bufferStorage, &fd, updateInfo.patchPixelsLength());
 
+        // as long as the tile has not been promoted, full reloads
+        // (e.g. on opening the document) keep it compressed
+        const bool compressedUpload = levelUsesCompressedFormat(0);
+
         f->glTexImage2D(GL_TEXTURE_2D, patchLevelOfDetail,
-                     m_texturesInfo->internalFormat,
+                     compressedUpload ?
+                         m_texturesInfo->compressedInternalFormat :
+                         m_texturesInfo->internalFormat,
                      patchSize.width(),
                      patchSize.height(), 0,
                      m_texturesInfo->format,
                      m_texturesInfo->type,
                      fd);
+
+        if (compressedUpload) {
+            m_compressedFormatLevels |= 1u << patchLevelOfDetail;
+        } else {
+            m_compressedFormatLevels &= ~(1u << patchLevelOfDetail);
+        }
     }
     else {
         const int size = patchSize.width() * patchSize.height() * updateInfo.pixelSize();
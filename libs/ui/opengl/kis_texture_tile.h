@@ -35,6 +35,11 @@ struct KisGLTexturesInfo {
     GLint internalFormat {0};
     GLint format {0};
     GLint type {0};
+
+    // when non-zero, tiles are initially kept in this
+    // (driver-compressed) format and are promoted to
+    // internalFormat on the first partial update
+    GLint compressedInternalFormat {0};
 };
 
 class KisTextureTile
@@ -73,8 +78,13 @@ public:
      * Binds the tile's texture to the current GL_TEXTURE_2D binding point,
      * regenerates the mipmap if needed and returns the levelOfDetail that
      * should be used for painting
+     *
+     * \p mipLevelsInUse tells whether the current canvas transform can
+     * sample the levels below 0 at all; when it cannot, a dirty mipmap
+     * chain is kept stale and is rebuilt lazily on the first bind that
+     * actually needs it (that is, when the user zooms out)
      */
-    int bindToActiveTexture(bool blockMipmapRegeneration);
+    int bindToActiveTexture(bool blockMipmapRegeneration, bool mipLevelsInUse);
 
 private:
     inline void setTextureParameters();
@@ -83,6 +93,11 @@ private:
     void setNeedsMipmapRegeneration();
     void setPreparedLodPlane(int lod);
     void regenerateMipmap();
+    void promoteToUncompressedFormat(int level);
+
+    inline bool levelUsesCompressedFormat(int level) const {
+        return m_compressedFormatLevels & (1u << level);
+    }
 
     GLuint m_textureId;
 
@@ -97,6 +112,15 @@ private:
     QOpenGLFunctions *f;
     KisOpenGLBufferCircularStorage *m_bufferStorage;
     bool m_mipmapHasBeenAllocated = false;
+
+    /**
+     * A bit per mip level, set while the level holds driver-compressed
+     * data. Levels are tracked individually because entire-tile LodN
+     * uploads and mipmap regeneration specify levels independently,
+     * and partial sub-image uploads into a compressed level are
+     * invalid at non-block-aligned offsets.
+     */
+    quint32 m_compressedFormatLevels = 0;
     Q_DISABLE_COPY(KisTextureTile)
 };
 
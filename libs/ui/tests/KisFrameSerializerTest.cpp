@@ -207,4 +207,77 @@ void KisFrameSerializerTest::testFrameArithmetics()
     }
 }
 
+#include <algorithm>
+
+void modifySingleTile(KisFrameDataSerializer::Frame &frame, int tileIndex)
+{
+    KisFrameDataSerializer::FrameTile &tile = frame.frameTiles[tileIndex];
+    const int numPixels = tile.rect.width() * tile.rect.height();
+    qint32 *pixelPtr = reinterpret_cast<qint32*>(tile.data.data());
+
+    for (int j = 0; j < numPixels; j++) {
+        *pixelPtr++ += 13;
+    }
+}
+
+void KisFrameSerializerTest::testDeltaFrameTrimming()
+{
+    KisTextureTileInfoPoolRegistry poolRegistry;
+    KisTextureTileInfoPoolSP pool = poolRegistry.getPool(maxTileSize, maxTileSize);
+
+    KisFrameDataSerializer::Frame baseFrame = generateTestFrame(2, pool);
+    KisFrameDataSerializer::Frame deltaFrame = generateTestFrame(2, pool);
+    modifySingleTile(deltaFrame, 3);
+
+    std::vector<bool> sameTiles;
+    const bool framesAreSame =
+        KisFrameDataSerializer::subtractFrames(deltaFrame, baseFrame, &sameTiles);
+
+    QVERIFY(!framesAreSame);
+    QCOMPARE(sameTiles.size(), baseFrame.frameTiles.size());
+    QCOMPARE(int(std::count(sameTiles.begin(), sameTiles.end(), false)), 1);
+
+    // drop the all-zero delta tiles, like KisFrameCacheStore does
+    auto tileIt = deltaFrame.frameTiles.begin();
+    for (size_t i = 0; i < sameTiles.size(); i++) {
+        tileIt = sameTiles[i] ? deltaFrame.frameTiles.erase(tileIt) : tileIt + 1;
+    }
+    QCOMPARE(int(deltaFrame.frameTiles.size()), 1);
+
+    KisFrameDataSerializer::addFrames(deltaFrame, baseFrame);
+    QCOMPARE(deltaFrame.frameTiles.size(), baseFrame.frameTiles.size());
+
+    KisFrameDataSerializer::Frame expectedFrame = generateTestFrame(2, pool);
+    modifySingleTile(expectedFrame, 3);
+
+    boost::optional<qreal> result =
+        KisFrameDataSerializer::estimateFrameUniqueness(deltaFrame, expectedFrame, 1.0);
+    QVERIFY(!!result);
+    QVERIFY(*result == 0.0);
+}
+
+void KisFrameSerializerTest::testFrameContentHash()
+{
+    KisTextureTileInfoPoolRegistry poolRegistry;
+    KisTextureTileInfoPoolSP pool = poolRegistry.getPool(maxTileSize, maxTileSize);
+
+    KisFrameDataSerializer::Frame testFrame1 = generateTestFrame(2, pool);
+    KisFrameDataSerializer::Frame testFrame2 = generateTestFrame(2, pool);
+
+    // equal content hashes to equal values
+    QCOMPARE(KisFrameDataSerializer::frameContentHash(testFrame1),
+             KisFrameDataSerializer::frameContentHash(testFrame2));
+
+    // a change in a single tile changes the hash
+    modifySingleTile(testFrame2, 3);
+    QVERIFY(KisFrameDataSerializer::frameContentHash(testFrame1) !=
+            KisFrameDataSerializer::frameContentHash(testFrame2));
+
+    // a change in tile geometry changes the hash as well
+    KisFrameDataSerializer::Frame testFrame3 = generateTestFrame(2, pool);
+    testFrame3.frameTiles[3].col += 1;
+    QVERIFY(KisFrameDataSerializer::frameContentHash(testFrame1) !=
+            KisFrameDataSerializer::frameContentHash(testFrame3));
+}
+
 SIMPLE_TEST_MAIN(KisFrameSerializerTest)
@@ -17,6 +17,8 @@ private Q_SLOTS:
     void testFrameDataSerialization();
     void testFrameUniquenessEstimation();
     void testFrameArithmetics();
+    void testDeltaFrameTrimming();
+    void testFrameContentHash();
 
 };
 
@@ -0,0 +1,91 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisLayerPayloadCacheTest.h"
+
+#include <simpletest.h>
+#include <testutil.h>
+
+#include <KoColor.h>
+#include <KoColorSpaceRegistry.h>
+#include <kis_paint_device.h>
+
+#include "KisLayerPayloadCache.h"
+
+void KisLayerPayloadCacheTest::testPayloadReuse()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+
+    dev->fill(QRect(0, 0, 256, 256), KoColor(Qt::red, cs));
+
+    KisLayerPayloadCache cache;
+    QByteArray payload;
+
+    cache.beginSave();
+    QVERIFY(!cache.tryFetchPayload("layers/layer0", dev, &payload));
+    cache.storePayload("layers/layer0", dev, QByteArray("payload1"));
+    cache.endSave();
+
+    // a copy of the device shares its tiles and therefore reuses the
+    // payload, like the clone made for background saving does
+    KisPaintDeviceSP copyDev = new KisPaintDevice(*dev);
+
+    cache.beginSave();
+    QVERIFY(cache.tryFetchPayload("layers/layer0", copyDev, &payload));
+    QCOMPARE(payload, QByteArray("payload1"));
+    cache.endSave();
+
+    // touching the copy detaches the changed tile and invalidates the
+    // entry
+    copyDev->fill(QRect(0, 0, 64, 64), KoColor(Qt::green, cs));
+
+    cache.beginSave();
+    QVERIFY(!cache.tryFetchPayload("layers/layer0", copyDev, &payload));
+    cache.storePayload("layers/layer0", copyDev, QByteArray("payload2"));
+    cache.endSave();
+
+    cache.beginSave();
+    QVERIFY(cache.tryFetchPayload("layers/layer0", copyDev, &payload));
+    QCOMPARE(payload, QByteArray("payload2"));
+    cache.endSave();
+
+    // devices without any tiles are distinguished by their pixel size
+    KisPaintDeviceSP emptyRgb = new KisPaintDevice(cs);
+    KisPaintDeviceSP emptyAlpha = new KisPaintDevice(KoColorSpaceRegistry::instance()->alpha8());
+
+    cache.beginSave();
+    cache.storePayload("layers/layer1", emptyRgb, QByteArray("rgb"));
+    QVERIFY(!cache.tryFetchPayload("layers/layer1", emptyAlpha, &payload));
+    QVERIFY(cache.tryFetchPayload("layers/layer1", emptyRgb, &payload));
+    cache.endSave();
+}
+
+void KisLayerPayloadCacheTest::testPruning()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+
+    dev->fill(QRect(0, 0, 128, 128), KoColor(Qt::blue, cs));
+
+    KisLayerPayloadCache cache;
+    QByteArray payload;
+
+    cache.beginSave();
+    cache.storePayload("layers/layer0", dev, QByteArray("payload"));
+    cache.endSave();
+
+    // a save that doesn't touch the entry (e.g. the node was removed)
+    // prunes it
+    cache.beginSave();
+    cache.endSave();
+
+    cache.beginSave();
+    QVERIFY(!cache.tryFetchPayload("layers/layer0", dev, &payload));
+    cache.endSave();
+}
+
+SIMPLE_TEST_MAIN(KisLayerPayloadCacheTest)
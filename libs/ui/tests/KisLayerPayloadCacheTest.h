@@ -0,0 +1,21 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISLAYERPAYLOADCACHETEST_H
+#define KISLAYERPAYLOADCACHETEST_H
+
+#include <QObject>
+
+class KisLayerPayloadCacheTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testPayloadReuse();
+    void testPruning();
+};
+
+#endif
@@ -0,0 +1,70 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisStabilizerSampleRingTest.h"
+
+#include "KisStabilizerSampleRing.h"
+#include "kis_paint_information.h"
+
+void KisStabilizerSampleRingTest::testRotation()
+{
+    KisStabilizerSampleRing ring;
+    ring.reset(3, KisPaintInformation(QPoint(0, 0)));
+
+    QCOMPARE(ring.size(), 3);
+    QCOMPARE(ring.head().pos(), QPointF(0, 0));
+
+    // push more samples than the ring holds so that the start
+    // index wraps around
+    for (int i = 1; i <= 5; i++) {
+        ring.rotateWith(KisPaintInformation(QPoint(10 * i, 0)));
+    }
+
+    QCOMPARE(ring.size(), 3);
+
+    // the ring should now hold the three newest samples in
+    // oldest-to-newest order
+    QCOMPARE(ring.at(0).pos(), QPointF(30, 0));
+    QCOMPARE(ring.at(1).pos(), QPointF(40, 0));
+    QCOMPARE(ring.at(2).pos(), QPointF(50, 0));
+    QCOMPARE(ring.head().pos(), QPointF(30, 0));
+}
+
+void KisStabilizerSampleRingTest::testReset()
+{
+    KisStabilizerSampleRing ring;
+    ring.reset(4, KisPaintInformation(QPoint(1, 1)));
+
+    QCOMPARE(ring.size(), 4);
+    for (int i = 0; i < ring.size(); i++) {
+        QCOMPARE(ring.at(i).pos(), QPointF(1, 1));
+    }
+
+    // resetting to a different size refills all the samples
+    ring.rotateWith(KisPaintInformation(QPoint(2, 2)));
+    ring.reset(6, KisPaintInformation(QPoint(3, 3)));
+
+    QCOMPARE(ring.size(), 6);
+    for (int i = 0; i < ring.size(); i++) {
+        QCOMPARE(ring.at(i).pos(), QPointF(3, 3));
+    }
+}
+
+void KisStabilizerSampleRingTest::testFill()
+{
+    KisStabilizerSampleRing ring;
+    ring.reset(3, KisPaintInformation(QPoint(0, 0)));
+
+    ring.rotateWith(KisPaintInformation(QPoint(10, 0)));
+    ring.fillWith(KisPaintInformation(QPoint(7, 7)));
+
+    QCOMPARE(ring.size(), 3);
+    for (int i = 0; i < ring.size(); i++) {
+        QCOMPARE(ring.at(i).pos(), QPointF(7, 7));
+    }
+}
+
+SIMPLE_TEST_MAIN(KisStabilizerSampleRingTest)
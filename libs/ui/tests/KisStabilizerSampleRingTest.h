@@ -0,0 +1,21 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISSTABILIZERSAMPLERINGTEST_H
+#define KISSTABILIZERSAMPLERINGTEST_H
+
+#include <simpletest.h>
+
+class KisStabilizerSampleRingTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testRotation();
+    void testReset();
+    void testFill();
+};
+
+#endif /* KISSTABILIZERSAMPLERINGTEST_H */
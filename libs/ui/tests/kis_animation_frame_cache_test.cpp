@@ -93,6 +93,60 @@ void KisAnimationFrameCacheTest::testCache()
 
 }
 
+void KisAnimationFrameCacheTest::testStatistics()
+{
+    TestUtil::MaskParent p;
+    KisImageSP image = p.image;
+    KisImageAnimationInterface *animation = image->animationInterface();
+    KisPaintLayerSP layer2 = new KisPaintLayer(p.image, "", OPACITY_OPAQUE_U8);
+    image->addNode(layer2);
+
+    KUndo2Command parentCommand;
+
+    KisKeyframeChannel *rasterChannel2 = layer2->getKeyframeChannel(KisKeyframeChannel::Raster.id(), true);
+    rasterChannel2->addKeyframe(10, &parentCommand);
+    rasterChannel2->addKeyframe(20, &parentCommand);
+
+    KisOpenGLImageTexturesSP glTex = KisOpenGLImageTextures::getImageTextures(image, 0, KoColorConversionTransformation::IntentPerceptual, KoColorConversionTransformation::Empty);
+    KisAnimationFrameCacheSP cache = new KisAnimationFrameCache(glTex);
+    glTex->testingForceInitialized();
+
+    m_globalAnimationCache = cache.data();
+    connect(animation, SIGNAL(sigFrameReady(int)), this, SLOT(slotFrameGenerationFinished(int)));
+
+    QCOMPARE(cache->statistics().generatedFrames, 0);
+    QVERIFY(cache->cachedRanges().isEmpty());
+
+    int t;
+    animation->saveAndResetCurrentTime(11, &t);
+    animation->notifyFrameReady();
+
+    QCOMPARE(cache->statistics().generatedFrames, 1);
+    QCOMPARE(cache->statistics().regeneratedFrames, 0);
+    QCOMPARE(cache->cachedRanges(),
+             QVector<KisTimeSpan>({KisTimeSpan::fromTimeToTime(10, 19)}));
+
+    image->invalidateFrames(KisTimeSpan::fromTimeToTime(10, 19), QRect());
+
+    QCOMPARE(cache->statistics().framesDroppedOnChange, 1);
+    QVERIFY(cache->cachedRanges().isEmpty());
+
+    // rendering the same range again counts as a regeneration
+    animation->saveAndResetCurrentTime(11, &t);
+    animation->notifyFrameReady();
+
+    QCOMPARE(cache->statistics().generatedFrames, 2);
+    QCOMPARE(cache->statistics().regeneratedFrames, 1);
+
+    // a partial invalidation truncates the range and keeps its data,
+    // so no drop is counted
+    image->invalidateFrames(KisTimeSpan::fromTimeToTime(15, 19), QRect());
+
+    QCOMPARE(cache->statistics().framesDroppedOnChange, 1);
+    QCOMPARE(cache->cachedRanges(),
+             QVector<KisTimeSpan>({KisTimeSpan::fromTimeToTime(10, 14)}));
+}
+
 void KisAnimationFrameCacheTest::slotFrameGenerationFinished(int time)
 {
     KisImageSP image = m_globalAnimationCache->image();
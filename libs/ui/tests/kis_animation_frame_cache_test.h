@@ -17,6 +17,7 @@ class KisAnimationFrameCacheTest : public QObject
 
 private Q_SLOTS:
     void testCache();
+    void testStatistics();
 
     void testFrameGlueing_data();
     void testFrameGlueing();
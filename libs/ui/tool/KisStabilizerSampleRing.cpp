@@ -0,0 +1,59 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisStabilizerSampleRing.h"
+
+#include "kis_assert.h"
+
+void KisStabilizerSampleRing::reset(int size, const KisPaintInformation &sample)
+{
+    KIS_SAFE_ASSERT_RECOVER(size > 0) {
+        size = 1;
+    }
+
+    if (m_samples.size() != size) {
+        m_samples.resize(size);
+    }
+
+    m_start = 0;
+    fillWith(sample);
+}
+
+int KisStabilizerSampleRing::size() const
+{
+    return m_samples.size();
+}
+
+bool KisStabilizerSampleRing::isEmpty() const
+{
+    return m_samples.isEmpty();
+}
+
+const KisPaintInformation& KisStabilizerSampleRing::head() const
+{
+    return m_samples[m_start];
+}
+
+const KisPaintInformation& KisStabilizerSampleRing::at(int index) const
+{
+    return m_samples[(m_start + index) % m_samples.size()];
+}
+
+void KisStabilizerSampleRing::rotateWith(const KisPaintInformation &sample)
+{
+    // KisPaintInformation::operator=() copies into the existing
+    // pimpl, so recycling the slot of the oldest sample doesn't
+    // allocate
+    m_samples[m_start] = sample;
+    m_start = (m_start + 1) % m_samples.size();
+}
+
+void KisStabilizerSampleRing::fillWith(const KisPaintInformation &sample)
+{
+    for (auto it = m_samples.begin(); it != m_samples.end(); ++it) {
+        *it = sample;
+    }
+}
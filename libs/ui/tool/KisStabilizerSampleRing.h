@@ -0,0 +1,70 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISSTABILIZERSAMPLERING_H
+#define KISSTABILIZERSAMPLERING_H
+
+#include <QVector>
+
+#include "kritaui_export.h"
+
+#include <brushengine/kis_paint_information.h>
+
+/**
+ * A fixed-capacity ring buffer of the paint information samples used
+ * by the stabilizer smoothing mode.
+ *
+ * The stabilizer used to keep its averaging window in a
+ * QQueue<KisPaintInformation>, which allocated a heap node on every
+ * enqueue. At the report rates of modern tablets (1kHz+) that
+ * generated a constant stream of small allocations in the middle of
+ * the stroke. The ring buffer preallocates all its samples once per
+ * stroke and recycles them in-place afterwards: pushing a new sample
+ * is a plain assignment into the slot of the retiring one, so the
+ * steady state of the stroke causes no heap traffic at all.
+ */
+class KRITAUI_EXPORT KisStabilizerSampleRing
+{
+public:
+    /**
+     * Resizes the ring to \p size slots and fills all of them with
+     * \p sample. This is the only operation that may allocate, and
+     * only when the requested size differs from the current one.
+     */
+    void reset(int size, const KisPaintInformation &sample);
+
+    int size() const;
+    bool isEmpty() const;
+
+    /**
+     * The oldest sample of the ring
+     */
+    const KisPaintInformation& head() const;
+
+    /**
+     * Returns the sample at \p index, counting from the oldest
+     * (index 0) to the newest (index size() - 1)
+     */
+    const KisPaintInformation& at(int index) const;
+
+    /**
+     * Drops the oldest sample and appends \p sample as the newest
+     * one, reusing the retired slot in-place
+     */
+    void rotateWith(const KisPaintInformation &sample);
+
+    /**
+     * Overwrites all the samples of the ring with \p sample without
+     * changing its size
+     */
+    void fillWith(const KisPaintInformation &sample);
+
+private:
+    QVector<KisPaintInformation> m_samples;
+    int m_start {0};
+};
+
+#endif // KISSTABILIZERSAMPLERING_H
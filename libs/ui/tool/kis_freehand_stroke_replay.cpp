@@ -0,0 +1,220 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_freehand_stroke_replay.h"
+
+#include <QApplication>
+#include <QDomDocument>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QGlobalStatic>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include "kis_debug.h"
+#include "kis_tool_freehand_helper.h"
+
+Q_GLOBAL_STATIC(KisFreehandStrokeRecorder, s_instance)
+
+struct Q_DECL_HIDDEN KisFreehandStrokeRecorder::Private
+{
+    Private()
+    {
+        fileName = QString::fromLocal8Bit(qgetenv("KRITA_RECORD_STROKES"));
+        if (!fileName.isEmpty()) {
+            startDocument();
+            recording = true;
+        }
+    }
+
+    void startDocument() {
+        document = QDomDocument();
+        root = document.createElement("stroke-replay-log");
+        root.setAttribute("version", 1);
+        document.appendChild(root);
+        currentStroke = QDomElement();
+    }
+
+    QMutex mutex;
+    bool recording {false};
+    QString fileName;
+
+    QDomDocument document;
+    QDomElement root;
+    QDomElement currentStroke;
+};
+
+KisFreehandStrokeRecorder::KisFreehandStrokeRecorder()
+    : m_d(new Private)
+{
+}
+
+KisFreehandStrokeRecorder::~KisFreehandStrokeRecorder()
+{
+    if (m_d->recording) {
+        stopRecording();
+    }
+    delete m_d;
+}
+
+KisFreehandStrokeRecorder* KisFreehandStrokeRecorder::instance()
+{
+    return s_instance;
+}
+
+bool KisFreehandStrokeRecorder::isRecording() const
+{
+    QMutexLocker locker(&m_d->mutex);
+    return m_d->recording;
+}
+
+void KisFreehandStrokeRecorder::startRecording(const QString &fileName)
+{
+    QMutexLocker locker(&m_d->mutex);
+
+    m_d->fileName = fileName;
+    m_d->startDocument();
+    m_d->recording = true;
+}
+
+bool KisFreehandStrokeRecorder::stopRecording()
+{
+    QMutexLocker locker(&m_d->mutex);
+
+    if (!m_d->recording) return false;
+    m_d->recording = false;
+
+    QFile file(m_d->fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    file.write(m_d->document.toByteArray(1));
+    return true;
+}
+
+void KisFreehandStrokeRecorder::recordStrokeBegin(const KisPaintInformation &pi)
+{
+    QMutexLocker locker(&m_d->mutex);
+    if (!m_d->recording) return;
+
+    m_d->currentStroke = m_d->document.createElement("stroke");
+    m_d->root.appendChild(m_d->currentStroke);
+
+    QDomElement sample = m_d->document.createElement("sample");
+    pi.toXML(m_d->document, sample);
+    m_d->currentStroke.appendChild(sample);
+}
+
+void KisFreehandStrokeRecorder::recordSample(const KisPaintInformation &pi)
+{
+    QMutexLocker locker(&m_d->mutex);
+    if (!m_d->recording || m_d->currentStroke.isNull()) return;
+
+    QDomElement sample = m_d->document.createElement("sample");
+    pi.toXML(m_d->document, sample);
+    m_d->currentStroke.appendChild(sample);
+}
+
+void KisFreehandStrokeRecorder::recordStrokeEnd()
+{
+    QMutexLocker locker(&m_d->mutex);
+    m_d->currentStroke = QDomElement();
+}
+
+bool KisFreehandStrokeReplayer::load(const QString &fileName)
+{
+    m_strokes.clear();
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDomDocument document;
+    if (!document.setContent(&file)) {
+        return false;
+    }
+
+    QDomElement root = document.documentElement();
+    if (root.tagName() != "stroke-replay-log") {
+        return false;
+    }
+
+    for (QDomElement stroke = root.firstChildElement("stroke");
+         !stroke.isNull();
+         stroke = stroke.nextSiblingElement("stroke")) {
+
+        QVector<KisPaintInformation> samples;
+        for (QDomElement sample = stroke.firstChildElement("sample");
+             !sample.isNull();
+             sample = sample.nextSiblingElement("sample")) {
+
+            samples << KisPaintInformation::fromXML(sample);
+        }
+
+        if (!samples.isEmpty()) {
+            m_strokes << samples;
+        }
+    }
+
+    return !m_strokes.isEmpty();
+}
+
+int KisFreehandStrokeReplayer::strokeCount() const
+{
+    return m_strokes.size();
+}
+
+void KisFreehandStrokeReplayer::replayStroke(int index,
+                                             KisToolFreehandHelper *helper,
+                                             KisImageWSP image,
+                                             KisNodeSP node,
+                                             KisStrokesFacade *strokesFacade,
+                                             bool atOriginalSpeed)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(index >= 0 && index < m_strokes.size());
+    KIS_SAFE_ASSERT_RECOVER_RETURN(helper && !helper->isRunning());
+
+    const QVector<KisPaintInformation> &samples = m_strokes[index];
+
+    helper->initPaintImpl(0, samples.first(), helper->resourceManager(),
+                          image, node, strokesFacade);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 1; i < samples.size(); i++) {
+        if (atOriginalSpeed) {
+            const qreal targetMsecs =
+                samples[i].currentTime() - samples.first().currentTime();
+
+            /**
+             * Keep the event loop running while waiting, the stroke
+             * system delivers its updates through it
+             */
+            while (timer.elapsed() < targetMsecs) {
+                qApp->processEvents();
+            }
+        }
+
+        KisPaintInformation info = samples[i];
+        helper->paint(info);
+    }
+
+    helper->endPaint();
+}
+
+void KisFreehandStrokeReplayer::replayAll(KisToolFreehandHelper *helper,
+                                          KisImageWSP image,
+                                          KisNodeSP node,
+                                          KisStrokesFacade *strokesFacade,
+                                          bool atOriginalSpeed)
+{
+    for (int i = 0; i < m_strokes.size(); i++) {
+        replayStroke(i, helper, image, node, strokesFacade, atOriginalSpeed);
+    }
+}
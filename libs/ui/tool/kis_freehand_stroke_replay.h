@@ -0,0 +1,93 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __KIS_FREEHAND_STROKE_REPLAY_H
+#define __KIS_FREEHAND_STROKE_REPLAY_H
+
+#include <QString>
+#include <QVector>
+
+#include <brushengine/kis_paint_information.h>
+
+#include "kis_types.h"
+#include "kritaui_export.h"
+
+class KisToolFreehandHelper;
+class KisStrokesFacade;
+
+/**
+ * Records the KisPaintInformation stream of freehand strokes into a
+ * replay log. The samples are captured before the smoothing pipeline,
+ * so a replay reproduces the full processing path of the original
+ * strokes, including smoothing and stabilization.
+ *
+ * Recording is disabled by default; set the KRITA_RECORD_STROKES
+ * environment variable to the name of the log file to capture a whole
+ * session, or drive startRecording()/stopRecording() explicitly.
+ */
+class KRITAUI_EXPORT KisFreehandStrokeRecorder
+{
+public:
+    KisFreehandStrokeRecorder();
+    ~KisFreehandStrokeRecorder();
+    static KisFreehandStrokeRecorder* instance();
+
+    bool isRecording() const;
+    void startRecording(const QString &fileName);
+
+    /// Stops recording and writes the log file. Returns false when
+    /// the file could not be written.
+    bool stopRecording();
+
+    void recordStrokeBegin(const KisPaintInformation &pi);
+    void recordSample(const KisPaintInformation &pi);
+    void recordStrokeEnd();
+
+private:
+    struct Private;
+    Private * const m_d;
+};
+
+/**
+ * Feeds a recorded stroke log back through KisToolFreehandHelper,
+ * either at the original pace of the artist's input or as fast as the
+ * stroke system accepts the samples. The replay can target any open
+ * document: the strokes are painted with the currently selected
+ * preset onto the given node.
+ */
+class KRITAUI_EXPORT KisFreehandStrokeReplayer
+{
+public:
+    /// Loads a log written by KisFreehandStrokeRecorder
+    bool load(const QString &fileName);
+
+    int strokeCount() const;
+
+    /**
+     * Replays one stroke of the log. When \p atOriginalSpeed is true
+     * the samples are delivered with the recorded inter-sample
+     * delays (the event loop keeps running in between); otherwise
+     * they are pushed as fast as possible, which is the mode used
+     * for benchmarking.
+     */
+    void replayStroke(int index,
+                      KisToolFreehandHelper *helper,
+                      KisImageWSP image,
+                      KisNodeSP node,
+                      KisStrokesFacade *strokesFacade,
+                      bool atOriginalSpeed = false);
+
+    void replayAll(KisToolFreehandHelper *helper,
+                   KisImageWSP image,
+                   KisNodeSP node,
+                   KisStrokesFacade *strokesFacade,
+                   bool atOriginalSpeed = false);
+
+private:
+    QVector<QVector<KisPaintInformation>> m_strokes;
+};
+
+#endif /* __KIS_FREEHAND_STROKE_REPLAY_H */
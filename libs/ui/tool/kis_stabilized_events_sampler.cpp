@@ -6,7 +6,7 @@
 
 #include "kis_stabilized_events_sampler.h"
 
-#include <QList>
+#include <QVector>
 #include <QElapsedTimer>
 #include <QtMath>
 
@@ -18,7 +18,9 @@ struct KisStabilizedEventsSampler::Private
     Private(int _sampleTime) : sampleTime(_sampleTime), elapsedTimeOverride(0) {}
 
     QElapsedTimer lastPaintTime;
-    QList<KisPaintInformation> realEvents;
+    // QVector keeps its capacity over clear(), so the per-poll-round
+    // recycling of the container doesn't reallocate
+    QVector<KisPaintInformation> realEvents;
     int sampleTime;
     int elapsedTimeOverride;
 
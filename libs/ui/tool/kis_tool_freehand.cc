@@ -45,6 +45,7 @@
 #include <KisViewManager.h>
 #include <kis_painting_assistants_decoration.h>
 #include "kis_painting_information_builder.h"
+#include <KisStrokeLatencyTracer.h>
 #include "kis_tool_freehand_helper.h"
 #include "strokes/freehand_stroke.h"
 #include "kis_tool_utils.h"
@@ -182,6 +183,7 @@ void KisToolFreehand::initStroke(KoPointerEvent *event)
 
 void KisToolFreehand::doStroke(KoPointerEvent *event)
 {
+    KisStrokeLatencyTracer::instance()->traceSampleIngested();
     m_helper->paintEvent(event);
 }
 
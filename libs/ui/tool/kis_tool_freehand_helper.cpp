@@ -8,7 +8,6 @@
 
 #include <QTimer>
 #include <QElapsedTimer>
-#include <QQueue>
 
 #include <klocalizedstring.h>
 
@@ -24,8 +23,10 @@
 #include <brushengine/kis_paintop_utils.h>
 
 #include "kis_update_time_monitor.h"
+#include "kis_freehand_stroke_replay.h"
 #include "kis_stabilized_events_sampler.h"
 #include "KisStabilizerDelayedPaintHelper.h"
+#include "KisStabilizerSampleRing.h"
 #include "kis_config.h"
 
 #include "kis_random_source.h"
@@ -94,8 +95,8 @@ struct KisToolFreehandHelper::Private
     // airbrushing effects.
     QTimer airbrushingTimer;
 
-    QList<KisPaintInformation> history;
-    QList<qreal> distanceHistory;
+    QVector<KisPaintInformation> history;
+    QVector<qreal> distanceHistory;
 
     // Keeps track of past cursor positions. This is used to determine the drawing angle when
     // drawing the brush outline or starting a stroke.
@@ -103,10 +104,11 @@ struct KisToolFreehandHelper::Private
 
     // Stabilizer data
     bool usingStabilizer;
-    QQueue<KisPaintInformation> stabilizerDeque;
+    KisStabilizerSampleRing stabilizerSampleRing;
     QTimer stabilizerPollTimer;
     KisStabilizedEventsSampler stabilizedSampler;
     KisStabilizerDelayedPaintHelper stabilizerDelayedPaintHelper;
+    QVector<KisPaintInformation> stabilizerDelayedPaintTodoItems;
 
     qreal effectiveSmoothnessDistance(qreal speed) const;
 };
@@ -273,6 +275,8 @@ void KisToolFreehandHelper::initPaintImpl(qreal startAngle,
 {
     m_d->strokesFacade = strokesFacade;
 
+    KisFreehandStrokeRecorder::instance()->recordStrokeBegin(pi);
+
     m_d->haveTangent = false;
     m_d->previousTangent = QPointF();
 
@@ -458,7 +462,9 @@ void KisToolFreehandHelper::paintEvent(KoPointerEvent *event)
 
 
 void KisToolFreehandHelper::paint(KisPaintInformation &info)
-{ 
+{
+    KisFreehandStrokeRecorder::instance()->recordSample(info);
+
     /**
      * Smooth the coordinates out using the history and the
      * distance. This is a heavily modified version of an algo used in
@@ -668,6 +674,8 @@ void KisToolFreehandHelper::paint(KisPaintInformation &info)
 
 void KisToolFreehandHelper::endPaint()
 {
+    KisFreehandStrokeRecorder::instance()->recordStrokeEnd();
+
     if (!m_d->hasPaintAtLeastOnce) {
         paintAt(m_d->previousPaintInformation);
     } else if (m_d->smoothingOptions->smoothingType() != KisSmoothingOptions::NO_SMOOTHING) {
@@ -708,6 +716,8 @@ void KisToolFreehandHelper::cancelPaint()
 {
     if (!m_d->strokeId) return;
 
+    KisFreehandStrokeRecorder::instance()->recordStrokeEnd();
+
     m_d->strokeTimeoutTimer.stop();
 
     if (m_d->airbrushingTimer.isActive()) {
@@ -746,11 +756,10 @@ void KisToolFreehandHelper::stabilizerStart(KisPaintInformation firstPaintInfo)
     int sampleSize = qRound(m_d->effectiveSmoothnessDistance(firstPaintInfo.drawingSpeed()));
     sampleSize = qMax(3, sampleSize);
 
-    // Fill the deque with the current value repeated until filling the sample
-    m_d->stabilizerDeque.clear();
-    for (int i = sampleSize; i > 0; i--) {
-        m_d->stabilizerDeque.enqueue(firstPaintInfo);
-    }
+    // Fill the ring with the current value repeated until filling the sample.
+    // The ring keeps its samples preallocated, so the rest of the stroke
+    // recycles them without touching the heap.
+    m_d->stabilizerSampleRing.reset(sampleSize, firstPaintInfo);
 
     // Poll and draw regularly
     KisConfig cfg(true);
@@ -768,7 +777,7 @@ void KisToolFreehandHelper::stabilizerStart(KisPaintInformation firstPaintInfo)
 }
 
 KisPaintInformation
-KisToolFreehandHelper::getStabilizedPaintInfo(const QQueue<KisPaintInformation> &queue,
+KisToolFreehandHelper::getStabilizedPaintInfo(const KisStabilizerSampleRing &samples,
                                               const KisPaintInformation &lastPaintInfo)
 {
     KisPaintInformation result(lastPaintInfo.pos(),
@@ -785,28 +794,23 @@ KisToolFreehandHelper::getStabilizedPaintInfo(const QQueue<KisPaintInformation>
     result.setCanvasMirroredH(lastPaintInfo.canvasMirroredH());
     result.setCanvasMirroredV(lastPaintInfo.canvasMirroredV());
 
-    if (queue.size() > 1) {
-        QQueue<KisPaintInformation>::const_iterator it = queue.constBegin();
-        QQueue<KisPaintInformation>::const_iterator end = queue.constEnd();
-
+    if (samples.size() > 1) {
         /**
-         * The first point is going to be overridden by lastPaintInfo, skip it.
+         * The first (oldest) sample is going to be overridden by
+         * lastPaintInfo, skip it.
          */
-        it++;
         int i = 2;
 
         if (m_d->smoothingOptions->stabilizeSensors()) {
-            while (it != end) {
+            for (int index = 1; index < samples.size(); index++) {
                 qreal k = qreal(i - 1) / i; // coeff for uniform averaging
-                result.KisPaintInformation::mixOtherWithoutTime(k, *it);
-                it++;
+                result.KisPaintInformation::mixOtherWithoutTime(k, samples.at(index));
                 i++;
             }
         } else{
-            while (it != end) {
+            for (int index = 1; index < samples.size(); index++) {
                 qreal k = qreal(i - 1) / i; // coeff for uniform averaging
-                result.KisPaintInformation::mixOtherOnlyPosition(k, *it);
-                it++;
+                result.KisPaintInformation::mixOtherOnlyPosition(k, samples.at(index));
                 i++;
             }
         }
@@ -820,7 +824,8 @@ void KisToolFreehandHelper::stabilizerPollAndPaint()
     KisStabilizedEventsSampler::iterator it;
     KisStabilizedEventsSampler::iterator end;
     std::tie(it, end) = m_d->stabilizedSampler.range();
-    QVector<KisPaintInformation> delayedPaintTodoItems;
+    QVector<KisPaintInformation> &delayedPaintTodoItems = m_d->stabilizerDelayedPaintTodoItems;
+    delayedPaintTodoItems.clear(); // keeps the capacity from the previous poll round
 
     for (; it != end; ++it) {
         KisPaintInformation sampledInfo = *it;
@@ -845,7 +850,7 @@ void KisToolFreehandHelper::stabilizerPollAndPaint()
         }
 
         if (canPaint) {
-            KisPaintInformation newInfo = getStabilizedPaintInfo(m_d->stabilizerDeque, sampledInfo);
+            KisPaintInformation newInfo = getStabilizedPaintInfo(m_d->stabilizerSampleRing, sampledInfo);
 
             if (m_d->stabilizerDelayedPaintHelper.running()) {
                 delayedPaintTodoItems.append(newInfo);
@@ -854,17 +859,10 @@ void KisToolFreehandHelper::stabilizerPollAndPaint()
             }
             m_d->previousPaintInformation = newInfo;
 
-            // Push the new entry through the queue
-            m_d->stabilizerDeque.dequeue();
-            m_d->stabilizerDeque.enqueue(sampledInfo);
-        } else if (m_d->stabilizerDeque.head().pos() != m_d->previousPaintInformation.pos()) {
-            QQueue<KisPaintInformation>::iterator it = m_d->stabilizerDeque.begin();
-            QQueue<KisPaintInformation>::iterator end = m_d->stabilizerDeque.end();
-
-            while (it != end) {
-                *it = m_d->previousPaintInformation;
-                ++it;
-            }
+            // Push the new entry through the ring
+            m_d->stabilizerSampleRing.rotateWith(sampledInfo);
+        } else if (m_d->stabilizerSampleRing.head().pos() != m_d->previousPaintInformation.pos()) {
+            m_d->stabilizerSampleRing.fillWith(m_d->previousPaintInformation);
         }
     }
 
@@ -888,7 +886,7 @@ void KisToolFreehandHelper::stabilizerEnd()
         stabilizerPollAndPaint();
 
         // Draw the finish line with pending events and a time override
-        m_d->stabilizedSampler.addFinishingEvent(m_d->stabilizerDeque.size());
+        m_d->stabilizedSampler.addFinishingEvent(m_d->stabilizerSampleRing.size());
         stabilizerPollAndPaint();
     }
 
@@ -26,6 +26,7 @@ class KisStrokesFacade;
 class KisPostExecutionUndoAdapter;
 class KisPaintOp;
 class KisFreehandStrokeInfo;
+class KisStabilizerSampleRing;
 
 
 class KRITAUI_EXPORT KisToolFreehandHelper : public QObject
@@ -128,6 +129,12 @@ protected:
                                   const KisPaintInformation &pi2);
 
 private:
+    /**
+     * The replayer feeds recorded KisPaintInformation streams back
+     * through initPaintImpl()/paint()/endPaint()
+     */
+    friend class KisFreehandStrokeReplayer;
+
     void paint(KisPaintInformation &info );
     void paintBezierSegment(KisPaintInformation pi1, KisPaintInformation pi2,
                                                    QPointF tangent1, QPointF tangent2 
@@ -135,7 +142,7 @@ private:
 
     void stabilizerStart(KisPaintInformation firstPaintInfo);
     void stabilizerEnd();
-    KisPaintInformation getStabilizedPaintInfo(const QQueue<KisPaintInformation> &queue,
+    KisPaintInformation getStabilizedPaintInfo(const KisStabilizerSampleRing &samples,
                                                const KisPaintInformation &lastPaintInfo);
     int computeAirbrushTimerInterval() const;
 
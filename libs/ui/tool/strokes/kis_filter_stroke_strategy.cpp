@@ -23,6 +23,8 @@
 #include <commands_new/KisDisableDirtyRequestsCommand.h>
 
 
+struct SubTaskSharedData;
+
 struct KisFilterStrokeStrategy::Private {
     Private()
         : updatesFacade(0)
@@ -40,6 +42,8 @@ struct KisFilterStrokeStrategy::Private {
         , updatesFacade(rhs.updatesFacade)
         , levelOfDetail(0)
         , cancelledUpdates(rhs.cancelledUpdates)
+        , checkpointStorage(rhs.checkpointStorage)
+        , configHash(rhs.configHash)
 
     {
         KIS_ASSERT_RECOVER_RETURN(!rhs.levelOfDetail);
@@ -57,6 +61,15 @@ struct KisFilterStrokeStrategy::Private {
     ExternalCancelUpdatesStorageSP cancelledUpdates;
     QRect nextExternalUpdateRect;
     bool hasBeenLodCloned = false;
+
+    FilterCheckpointStorageSP checkpointStorage;
+    QString configHash;
+
+    /**
+     * The shared data of the active-frame run, kept to be able to
+     * checkpoint its partial result on cancellation
+     */
+    QSharedPointer<SubTaskSharedData> activeFrameShared;
 };
 
 struct SubTaskSharedData {
@@ -112,6 +125,14 @@ public:
     QSharedPointer<KisTransaction> filterDeviceTransaction;
     QRect processRect;
 
+    /**
+     * The patches that have been fully processed so far. Appended
+     * concurrently by the processing jobs, harvested by the
+     * checkpointing code on cancellation.
+     */
+    QMutex processedRectsLock;
+    QVector<QRect> processedRects;
+
 private:
     KisImageSP m_image;
     KisNodeSP m_node;
@@ -154,6 +175,11 @@ KisFilterStrokeStrategy::KisFilterStrokeStrategy(KisFilterSP filter,
     m_d->updatesFacade = resources->image().data();
     m_d->levelOfDetail = 0;
     m_d->cancelledUpdates = externalCancelUpdatesStorage;
+    m_d->configHash =
+        QString("%1:%2:%3")
+            .arg(filterConfig->name())
+            .arg(filterConfig->version())
+            .arg(filterConfig->toXML());
 
     setNeedsExplicitCancel(true);
     setSupportsWrapAroundMode(true);
@@ -175,6 +201,11 @@ KisFilterStrokeStrategy::~KisFilterStrokeStrategy()
     delete m_d;
 }
 
+void KisFilterStrokeStrategy::setFilterCheckpointStorage(FilterCheckpointStorageSP storage)
+{
+    m_d->checkpointStorage = storage;
+}
+
 void KisFilterStrokeStrategy::initStrokeCallback()
 {
     KisStrokeStrategyUndoCommandBased::initStrokeCallback();
@@ -238,8 +269,41 @@ void KisFilterStrokeStrategy::doStrokeCallback(KisStrokeJobData *data)
                 }
             }
 
+            /**
+             * If the previous (cancelled) stroke of the session ran
+             * with exactly the same configuration, resume from its
+             * checkpoint instead of re-filtering from scratch. The
+             * open transaction is carried over together with the
+             * device, so the unprocessed patches still read the
+             * original content through its memento.
+             */
+            if (m_d->checkpointStorage && !shared->shouldSwitchTime()) {
+                QMutexLocker locker(&m_d->checkpointStorage->lock);
+
+                auto it = m_d->checkpointStorage->checkpoints.find(m_d->levelOfDetail);
+                if (it != m_d->checkpointStorage->checkpoints.end()) {
+
+                    if (it->configHash == m_d->configHash &&
+                        it->processRect == shared->processRect) {
+
+                        shared->filterDevice = it->filterDevice;
+                        shared->filterDeviceTransaction = it->filterDeviceTransaction;
+                        shared->processedRects = it->processedRects;
+                    }
+
+                    // a mismatching checkpoint is useless, drop it
+                    m_d->checkpointStorage->checkpoints.erase(it);
+                }
+            }
+
+            if (!shared->shouldSwitchTime()) {
+                m_d->activeFrameShared = shared;
+            }
+
             // Filter device needs a transaction to prevent grid-patch artifacts from multithreaded read/write.
-            shared->filterDeviceTransaction.reset(new KisTransaction(shared->filterDevice));
+            if (!shared->filterDeviceTransaction) {
+                shared->filterDeviceTransaction.reset(new KisTransaction(shared->filterDevice));
+            }
 
 
             // Actually process the device
@@ -252,20 +316,28 @@ void KisFilterStrokeStrategy::doStrokeCallback(KisStrokeJobData *data)
                 QVector<QRect> patches = KritaUtils::splitRectIntoPatches(shared->processRect, size);
 
                 Q_FOREACH (const QRect &patch, patches) {
-                    if (!patch.isEmpty()) {
+                    if (!patch.isEmpty() && !shared->processedRects.contains(patch)) {
                         addJobConcurrent(processJobs, [patch, shared, progress](){
                             shared->filter()->processImpl(shared->filterDevice, patch,
                                                           shared->filterConfig().data(),
                                                           progress->updater());
+
+                            QMutexLocker locker(&shared->processedRectsLock);
+                            shared->processedRects << patch;
                         });
                     }
                 }
             } else {
-                if (!shared->processRect.isEmpty()) {
+                if (!shared->processRect.isEmpty() &&
+                    !shared->processedRects.contains(shared->processRect)) {
+
                     addJobSequential(processJobs, [shared, progress](){
                         shared->filter()->processImpl(shared->filterDevice, shared->processRect,
                                                       shared->filterConfig().data(),
                                                       progress->updater());
+
+                        QMutexLocker locker(&shared->processedRectsLock);
+                        shared->processedRects << shared->processRect;
                     });
                 }
             }
@@ -279,6 +351,13 @@ void KisFilterStrokeStrategy::doStrokeCallback(KisStrokeJobData *data)
             runAndSaveCommand(toQShared(shared->filterDeviceTransaction->endAndTake()), KisStrokeJobData::BARRIER, KisStrokeJobData::NORMAL);
             shared->filterDeviceTransaction.reset();
 
+            /**
+             * The transaction is committed into the stroke's undo
+             * stack now, so cancellation would revert the filter
+             * device as well; the run cannot be checkpointed anymore
+             */
+            m_d->activeFrameShared.clear();
+
             if (!shared->filterDeviceBounds.intersects(
                     shared->filter()->neededRect(shared->processRect, shared->filterConfig().data(), shared->levelOfDetail()))) {
                 return;
@@ -328,6 +407,34 @@ void KisFilterStrokeStrategy::cancelStrokeCallback()
 {
     using namespace KritaUtils;
 
+    /**
+     * Save the partially processed result for the next stroke of the
+     * session. All the processing jobs have either finished or been
+     * dropped at this point. We can only checkpoint while the filter
+     * device transaction is still open: afterwards the undo sequence
+     * below reverts the device content as well.
+     */
+    if (m_d->checkpointStorage &&
+        m_d->activeFrameShared &&
+        m_d->activeFrameShared->filterDeviceTransaction) {
+
+        QSharedPointer<SubTaskSharedData> shared = m_d->activeFrameShared;
+
+        FilterCheckpointStorage::Checkpoint checkpoint;
+        checkpoint.configHash = m_d->configHash;
+        checkpoint.processRect = shared->processRect;
+        checkpoint.filterDevice = shared->filterDevice;
+        checkpoint.filterDeviceTransaction = shared->filterDeviceTransaction;
+
+        {
+            QMutexLocker locker(&shared->processedRectsLock);
+            checkpoint.processedRects = shared->processedRects;
+        }
+
+        QMutexLocker locker(&m_d->checkpointStorage->lock);
+        m_d->checkpointStorage->checkpoints.insert(m_d->levelOfDetail, checkpoint);
+    }
+
     const bool shouldIssueCancellationUpdates = m_d->cancelledUpdates->shouldIssueCancellationUpdates;
 
     QVector<KisStrokeJobData *> jobs;
@@ -12,6 +12,11 @@
 #include "kis_lod_transform.h"
 #include "kis_resources_snapshot.h"
 
+#include <QMutex>
+#include <QHash>
+
+class KisTransaction;
+
 class KRITAUI_EXPORT KisFilterStrokeStrategy : public KisStrokeStrategyUndoCommandBased
 {
 public:
@@ -76,6 +81,29 @@ public:
 
     using ExternalCancelUpdatesStorageSP = QSharedPointer<ExternalCancelUpdatesStorage>;
 
+    /**
+     * Keeps the partial result of a cancelled filter run, so that a
+     * restarted stroke with exactly the same configuration can resume
+     * from the last processed patch instead of re-filtering from
+     * scratch. The storage is shared between the consecutive strokes
+     * of one filter dialog session and must be dropped when the
+     * session ends (the device may change afterwards).
+     */
+    struct FilterCheckpointStorage {
+        struct Checkpoint {
+            QString configHash;
+            QRect processRect;
+            KisPaintDeviceSP filterDevice;
+            QSharedPointer<KisTransaction> filterDeviceTransaction;
+            QVector<QRect> processedRects;
+        };
+
+        QMutex lock;
+        QHash<int, Checkpoint> checkpoints; // keyed by the level of detail
+    };
+
+    using FilterCheckpointStorageSP = QSharedPointer<FilterCheckpointStorage>;
+
 public:
     KisFilterStrokeStrategy(KisFilterSP filter,
                             KisFilterConfigurationSP filterConfig,
@@ -89,6 +117,12 @@ public:
 
     ~KisFilterStrokeStrategy() override;
 
+    /**
+     * Attach the checkpoint storage shared by the consecutive strokes
+     * of the filter dialog session. Must be called before the stroke
+     * is started.
+     */
+    void setFilterCheckpointStorage(FilterCheckpointStorageSP storage);
 
     void initStrokeCallback() override;
     void doStrokeCallback(KisStrokeJobData *data) override;
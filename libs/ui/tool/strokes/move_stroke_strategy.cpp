@@ -497,10 +497,25 @@ void MoveStrokeStrategy::doStrokeCallback(KisStrokeJobData *data)
 
 void MoveStrokeStrategy::doCanvasUpdate(bool forceUpdate)
 {
+    const int minUpdateInterval = 30;
+    const int maxUpdateInterval = 480;
+
     if (!forceUpdate &&
             (m_updateTimer.elapsed() < m_updateInterval ||
              m_updatesFacade->hasUpdatesRunning())) {
 
+        /**
+         * The previous refresh is still compositing when the next one
+         * is due, so the layers are too expensive for the current
+         * rate; back off instead of queueing updates the image cannot
+         * keep up with
+         */
+        if (m_updatesFacade->hasUpdatesRunning() &&
+            m_updateTimer.elapsed() >= m_updateInterval) {
+
+            m_updateInterval = qMin(2 * m_updateInterval, maxUpdateInterval);
+        }
+
         return;
     }
 
@@ -526,6 +541,7 @@ void MoveStrokeStrategy::doCanvasUpdate(bool forceUpdate)
     }
 
     m_hasPostponedJob = false;
+    m_updateInterval = qMax(minUpdateInterval, 3 * m_updateInterval / 4);
     m_updateTimer.restart();
 }
 
@@ -108,7 +108,16 @@ private:
 
     QElapsedTimer m_updateTimer;
     bool m_hasPostponedJob {false};
-    const int m_updateInterval {30};
+
+    /**
+     * The canvas refresh interval adapts to how fast the image can
+     * actually recomposite the moved layers: it backs off while
+     * refreshes cannot keep up with the drag (e.g. a full-canvas
+     * layer on a huge image) and decays back to the base rate once
+     * they do. The full-resolution result is guaranteed by the forced
+     * update at the end of the stroke.
+     */
+    int m_updateInterval {30};
 
     template <typename Functor>
     void recursiveApplyNodes(KisNodeList nodes, Functor &&func);
@@ -110,6 +110,29 @@ QPointF PerspectiveAssistant::adjustPosition(const QPointF& pt, const QPointF& s
     return project(pt, strokeBegin, snapToAny, moveThresholdPt);
 }
 
+bool PerspectiveAssistant::isPointSnappable(const QPointF& point, const QPointF& strokeBegin) const
+{
+    if (!KisPaintingAssistant::isPointSnappable(point, strokeBegin)) {
+        return false;
+    }
+
+    // an already chosen snap line keeps snapping outside the grid
+    if (!m_snapLine.isNull()) {
+        return true;
+    }
+
+    // the grid only snaps strokes that start inside its tetragon; the
+    // polygon and the projection transform are cached in getTransform()
+    // and recomputed only when a handle has moved
+    QPolygonF poly;
+    QTransform transform;
+    if (!getTransform(poly, transform)) {
+        return false;
+    }
+
+    return poly.containsPoint(strokeBegin, Qt::OddEvenFill);
+}
+
 void PerspectiveAssistant::adjustLine(QPointF &point, QPointF &strokeBegin)
 {
     point = project(point, strokeBegin, true, 0.0);
@@ -26,6 +26,7 @@ public:
     KisPaintingAssistantSP clone(QMap<KisPaintingAssistantHandleSP, KisPaintingAssistantHandleSP> &handleMap) const override;
 
     QPointF adjustPosition(const QPointF& point, const QPointF& strokeBegin, const bool snapToAny, qreal moveThresholdPt) override;
+    bool isPointSnappable(const QPointF& point, const QPointF& strokeBegin) const override;
     void adjustLine(QPointF &point, QPointF& strokeBegin) override;
     void endStroke() override;
 
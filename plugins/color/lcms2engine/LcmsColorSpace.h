@@ -11,6 +11,10 @@
 #define KOLCMSCOLORSPACE_H_
 
 #include <array>
+#include <cstring>
+
+#include <QVector>
+
 #include <kis_lockless_stack.h>
 #include <KoColorSpaceAbstract.h>
 
@@ -82,6 +86,12 @@ class LcmsColorSpace : public KoColorSpaceAbstract<_CSTraits>, public KoLcmsInfo
             profiles[0] = 0;
             profiles[1] = 0;
             profiles[2] = 0;
+
+            if (colorSpace->channelCount() > colorSpace->colorChannelCount()) {
+                const quint32 channelSize = colorSpace->pixelSize() / colorSpace->channelCount();
+                m_alphaOffset = colorSpace->alphaPos() * channelSize;
+                m_alphaSize = channelSize;
+            }
         }
 
         ~KoLcmsColorTransformation() override
@@ -104,36 +114,58 @@ class LcmsColorSpace : public KoColorSpaceAbstract<_CSTraits>, public KoLcmsInfo
         void transform(const quint8 *src, quint8 *dst, qint32 nPixels) const override
         {
             cmsDoTransform(cmstransform, const_cast<quint8 *>(src), dst, nPixels);
+            recombineAlpha(src, dst, nPixels);
+        }
 
-            qint32 numPixels = nPixels;
-            qint32 pixelSize = m_colorSpace->pixelSize();
-            int index = 0;
+        void transform(const quint8 *srcRowStart, qint32 srcRowStride, quint8 *dstRowStart, qint32 dstRowStride, qint32 columns, qint32 rows) const override
+        {
+#if LCMS_VERSION >= 2080
+            cmsDoTransformLineStride(cmstransform, srcRowStart, dstRowStart, columns, rows, srcRowStride, dstRowStride, 0, 0);
+
+            const quint8 *src = srcRowStart;
+            quint8 *dst = dstRowStart;
+            for (qint32 y = 0; y < rows; ++y) {
+                recombineAlpha(src, dst, columns);
+                src += srcRowStride;
+                dst += dstRowStride;
+            }
+#else
+            KoColorTransformation::transform(srcRowStart, srcRowStride, dstRowStart, dstRowStride, columns, rows);
+#endif
+        }
+
+        /**
+         * Restore the alpha channel after cmsDoTransform(), which does
+         * not write the extra channels of the destination. When the
+         * transformation carries no alpha LUT and runs in place, the
+         * original alpha is still in the buffer, so nothing needs to be
+         * done at all.
+         */
+        void recombineAlpha(const quint8 *src, quint8 *dst, qint32 nPixels) const
+        {
+            const qint32 pixelSize = m_colorSpace->pixelSize();
 
             if (cmsAlphaTransform) {
-                float *alpha = new float[nPixels];
-                float *dstalpha = new float[nPixels];
+                QVector<float> alpha(nPixels);
+                QVector<float> dstalpha(nPixels);
 
-                while (index < nPixels) {
-                    alpha[index] = m_colorSpace->opacityF(src);
-                    src += pixelSize;
-                    index++;
+                for (qint32 i = 0; i < nPixels; i++) {
+                    alpha[i] = m_colorSpace->opacityF(src + i * pixelSize);
                 }
 
-                cmsDoTransform(cmsAlphaTransform, const_cast<float *>(alpha), static_cast<float *>(dstalpha), nPixels);
-                for (int i = 0; i < numPixels; i++) {
-                    m_colorSpace->setOpacity(dst, dstalpha[i], 1);
-                    dst += pixelSize;
-                }
+                cmsDoTransform(cmsAlphaTransform, alpha.constData(), dstalpha.data(), nPixels);
 
-                delete [] alpha;
-                delete [] dstalpha;
-            } else {
-                while (numPixels > 0) {
-                    qreal alpha = m_colorSpace->opacityF(src);
-                    m_colorSpace->setOpacity(dst, alpha, 1);
-                    src += pixelSize;
-                    dst += pixelSize;
-                    numPixels--;
+                for (qint32 i = 0; i < nPixels; i++) {
+                    m_colorSpace->setOpacity(dst + i * pixelSize, dstalpha[i], 1);
+                }
+            } else if (src != dst && m_alphaSize > 0) {
+                const quint8 *srcAlpha = src + m_alphaOffset;
+                quint8 *dstAlpha = dst + m_alphaOffset;
+
+                for (qint32 i = 0; i < nPixels; i++) {
+                    memcpy(dstAlpha, srcAlpha, m_alphaSize);
+                    srcAlpha += pixelSize;
+                    dstAlpha += pixelSize;
                 }
             }
         }
@@ -143,6 +175,8 @@ class LcmsColorSpace : public KoColorSpaceAbstract<_CSTraits>, public KoLcmsInfo
         cmsHPROFILE profiles[3];
         cmsHTRANSFORM cmstransform;
         cmsHTRANSFORM cmsAlphaTransform;
+        quint32 m_alphaOffset {0};
+        quint32 m_alphaSize {0};
     };
 
     struct KisLcmsLastTransformation {
@@ -130,6 +130,12 @@ bool KisColorSelectorComponent::allowsColorSelectionAtPoint(const QPoint & /*pt*
     return true;
 }
 
+bool KisColorSelectorComponent::paintImageDependsOnParameter(Parameter parameter) const
+{
+    Q_UNUSED(parameter);
+    return true;
+}
+
 KoColor KisColorSelectorComponent::currentColor()
 {
     return selectColor(m_lastX, m_lastY);
@@ -148,6 +154,16 @@ void KisColorSelectorComponent::setParam(qreal hue, qreal hsvSaturation, qreal v
        qFuzzyCompare(m_luma, luma))
         return;
 
+    const qreal oldHue = m_hue;
+    const qreal oldHsvSaturation = m_hsvSaturation;
+    const qreal oldValue = m_value;
+    const qreal oldHslSaturation = m_hslSaturation;
+    const qreal oldLightness = m_lightness;
+    const qreal oldHsiSaturation = m_hsiSaturation;
+    const qreal oldIntensity = m_intensity;
+    const qreal oldHsySaturation = m_hsySaturation;
+    const qreal oldLuma = m_luma;
+
     if (hue >= 0) {
         m_hue = qMin(hue, qreal(1));
     }
@@ -208,7 +224,27 @@ void KisColorSelectorComponent::setParam(qreal hue, qreal hsvSaturation, qreal v
         m_lightness = -1;
     }
 
-    m_dirty=true;
+    /**
+     * The marker has to be repainted in any case, but the cached selector
+     * image is only re-rendered when a parameter it actually depends on
+     * changed; for color-picking-heavy workflows most components repaint
+     * from the cache
+     */
+    typedef KisColorSelectorConfiguration Cfg;
+    const bool imageChanged =
+        (!qFuzzyCompare(oldHue, m_hue) && paintImageDependsOnParameter(Cfg::H)) ||
+        (!qFuzzyCompare(oldHsvSaturation, m_hsvSaturation) && paintImageDependsOnParameter(Cfg::hsvS)) ||
+        (!qFuzzyCompare(oldValue, m_value) && paintImageDependsOnParameter(Cfg::V)) ||
+        (!qFuzzyCompare(oldHslSaturation, m_hslSaturation) && paintImageDependsOnParameter(Cfg::hslS)) ||
+        (!qFuzzyCompare(oldLightness, m_lightness) && paintImageDependsOnParameter(Cfg::L)) ||
+        (!qFuzzyCompare(oldHsiSaturation, m_hsiSaturation) && paintImageDependsOnParameter(Cfg::hsiS)) ||
+        (!qFuzzyCompare(oldIntensity, m_intensity) && paintImageDependsOnParameter(Cfg::I)) ||
+        (!qFuzzyCompare(oldHsySaturation, m_hsySaturation) && paintImageDependsOnParameter(Cfg::hsyS)) ||
+        (!qFuzzyCompare(oldLuma, m_luma) && paintImageDependsOnParameter(Cfg::Y));
+
+    if (imageChanged) {
+        m_dirty=true;
+    }
     Q_EMIT update();
 }
 
@@ -51,9 +51,9 @@ public:
     /// returns true, if this component wants to grab the mouse (normally true, if containsPoint returns true)
     bool wantsGrab(int x, int y) {return containsPointInComponentCoords(x-m_x, y-m_y);}
 
-    void setGamutMask(KoGamutMaskSP gamutMask);
+    virtual void setGamutMask(KoGamutMaskSP gamutMask);
     void unsetGamutMask();
-    void updateGamutMaskPreview();
+    virtual void updateGamutMaskPreview();
     void toggleGamutMask(bool state);
 
 public Q_SLOTS:
@@ -87,6 +87,13 @@ protected:
     /// it is masked out). Default implementation always returns true.
     virtual bool allowsColorSelectionAtPoint(const QPoint &) const;
 
+    /// returns true if the cached selector image (as opposed to the marker
+    /// drawn on top of it) depends on the given parameter; setParam() only
+    /// re-renders the image when a parameter it depends on changed, so e.g.
+    /// a plain hue strip is never re-rendered on color changes. The default
+    /// implementation conservatively re-renders on every change.
+    virtual bool paintImageDependsOnParameter(Parameter parameter) const;
+
     // Workaround for Bug 287001
     void setLastMousePosition(int x, int y);
 
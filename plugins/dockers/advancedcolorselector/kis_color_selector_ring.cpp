@@ -48,6 +48,14 @@ bool KisColorSelectorRing::containsPointInComponentCoords(int x, int y) const
     return false;
 }
 
+bool KisColorSelectorRing::paintImageDependsOnParameter(Parameter parameter) const
+{
+    Q_UNUSED(parameter);
+    // the ring always shows the full hue range at fixed saturation and
+    // brightness; only the blip follows the color
+    return false;
+}
+
 void KisColorSelectorRing::paint(QPainter* painter)
 {
     qreal devicePixelRatioF = painter->device()->devicePixelRatioF();
@@ -252,6 +252,65 @@ void KisColorSelectorSimple::setColor(const KoColor &color)
     KisColorSelectorComponent::setColor(color);
 }
 
+bool KisColorSelectorSimple::paintImageDependsOnParameter(Parameter parameter) const
+{
+    switch (m_parameter) {
+    case KisColorSelectorConfiguration::SL:
+    case KisColorSelectorConfiguration::SV:
+    case KisColorSelectorConfiguration::SV2:
+    case KisColorSelectorConfiguration::SI:
+    case KisColorSelectorConfiguration::SY:
+        return parameter == KisColorSelectorConfiguration::H;
+    case KisColorSelectorConfiguration::hsvSH:
+        return parameter == KisColorSelectorConfiguration::V;
+    case KisColorSelectorConfiguration::hslSH:
+        return parameter == KisColorSelectorConfiguration::L;
+    case KisColorSelectorConfiguration::hsiSH:
+        return parameter == KisColorSelectorConfiguration::I;
+    case KisColorSelectorConfiguration::hsySH:
+        return parameter == KisColorSelectorConfiguration::Y;
+    case KisColorSelectorConfiguration::VH:
+        return parameter == KisColorSelectorConfiguration::hsvS;
+    case KisColorSelectorConfiguration::LH:
+        return parameter == KisColorSelectorConfiguration::hslS;
+    case KisColorSelectorConfiguration::IH:
+        return parameter == KisColorSelectorConfiguration::hsiS;
+    case KisColorSelectorConfiguration::YH:
+        return parameter == KisColorSelectorConfiguration::hsyS;
+    case KisColorSelectorConfiguration::H:
+        // a plain hue strip shows the full range whatever the color is
+        return false;
+    case KisColorSelectorConfiguration::Hluma:
+        return parameter == KisColorSelectorConfiguration::Y;
+    case KisColorSelectorConfiguration::hsvS:
+        return parameter == KisColorSelectorConfiguration::H ||
+               parameter == KisColorSelectorConfiguration::V;
+    case KisColorSelectorConfiguration::hslS:
+        return parameter == KisColorSelectorConfiguration::H ||
+               parameter == KisColorSelectorConfiguration::L;
+    case KisColorSelectorConfiguration::hsiS:
+        return parameter == KisColorSelectorConfiguration::H ||
+               parameter == KisColorSelectorConfiguration::I;
+    case KisColorSelectorConfiguration::hsyS:
+        return parameter == KisColorSelectorConfiguration::H ||
+               parameter == KisColorSelectorConfiguration::Y;
+    case KisColorSelectorConfiguration::V:
+        return parameter == KisColorSelectorConfiguration::H ||
+               parameter == KisColorSelectorConfiguration::hsvS;
+    case KisColorSelectorConfiguration::L:
+        return parameter == KisColorSelectorConfiguration::H ||
+               parameter == KisColorSelectorConfiguration::hslS;
+    case KisColorSelectorConfiguration::I:
+        return parameter == KisColorSelectorConfiguration::H ||
+               parameter == KisColorSelectorConfiguration::hsiS;
+    case KisColorSelectorConfiguration::Y:
+        return parameter == KisColorSelectorConfiguration::H ||
+               parameter == KisColorSelectorConfiguration::hsyS;
+    default:
+        return true;
+    }
+}
+
 void KisColorSelectorSimple::paint(QPainter* painter)
 {
     if(isDirty()) {
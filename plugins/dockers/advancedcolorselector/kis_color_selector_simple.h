@@ -30,6 +30,7 @@ public:
 protected:
     void paint(QPainter*) override;
     KoColor selectColor(int x, int y) override;
+    bool paintImageDependsOnParameter(Parameter parameter) const override;
 
 private:
     friend class Acs::PixelCacheRenderer;
@@ -32,6 +32,13 @@ bool KisColorSelectorTriangle::containsPointInComponentCoords(int x, int y) cons
     return pixel.opacityU8() == OPACITY_OPAQUE_U8;
 }
 
+bool KisColorSelectorTriangle::paintImageDependsOnParameter(Parameter parameter) const
+{
+    // the triangle always shows the saturation/value plane of the
+    // current hue
+    return parameter == KisColorSelectorConfiguration::H;
+}
+
 void KisColorSelectorTriangle::paint(QPainter* painter)
 {
     if(isDirty()) {
@@ -27,6 +27,7 @@ protected:
     void paint(QPainter*) override;
     KoColor selectColor(int x, int y) override;
     bool containsPointInComponentCoords(int x, int y) const override;
+    bool paintImageDependsOnParameter(Parameter parameter) const override;
 
 private:
     friend class Acs::PixelCacheRenderer;
@@ -170,6 +170,42 @@ void KisColorSelectorWheel::setColor(const KoColor &color)
     KisColorSelectorComponent::setColor(color);
 }
 
+void KisColorSelectorWheel::setGamutMask(KoGamutMaskSP gamutMask)
+{
+    m_maskBuffer = QImage();
+    KisColorSelectorComponent::setGamutMask(gamutMask);
+}
+
+void KisColorSelectorWheel::updateGamutMaskPreview()
+{
+    m_maskBuffer = QImage();
+    KisColorSelectorComponent::updateGamutMaskPreview();
+}
+
+bool KisColorSelectorWheel::paintImageDependsOnParameter(Parameter parameter) const
+{
+    switch (m_parameter) {
+    case KisColorSelectorConfiguration::hsvSH:
+        return parameter == KisColorSelectorConfiguration::V;
+    case KisColorSelectorConfiguration::hslSH:
+        return parameter == KisColorSelectorConfiguration::L;
+    case KisColorSelectorConfiguration::hsiSH:
+        return parameter == KisColorSelectorConfiguration::I;
+    case KisColorSelectorConfiguration::hsySH:
+        return parameter == KisColorSelectorConfiguration::Y;
+    case KisColorSelectorConfiguration::VH:
+        return parameter == KisColorSelectorConfiguration::hsvS;
+    case KisColorSelectorConfiguration::LH:
+        return parameter == KisColorSelectorConfiguration::hslS;
+    case KisColorSelectorConfiguration::IH:
+        return parameter == KisColorSelectorConfiguration::hsiS;
+    case KisColorSelectorConfiguration::YH:
+        return parameter == KisColorSelectorConfiguration::hsyS;
+    default:
+        return true;
+    }
+}
+
 void KisColorSelectorWheel::paint(QPainter* painter)
 {
 
@@ -201,33 +237,52 @@ void KisColorSelectorWheel::paint(QPainter* painter)
 
     // draw gamut mask
     if (m_gamutMaskOn && m_currentGamutMask) {
-        QImage maskBuffer = QImage(m_renderAreaSize*painter->device()->devicePixelRatioF(), QImage::Format_ARGB32_Premultiplied);
-        maskBuffer.setDevicePixelRatio(painter->device()->devicePixelRatioF());
-        maskBuffer.fill(0);
-        QPainter maskPainter(&maskBuffer);
+        const qreal devicePixelRatio = painter->device()->devicePixelRatioF();
+
+        /**
+         * Rasterizing the vector mask is much more expensive than the
+         * blip repaint that happens on every color change, so the
+         * overlay is kept around until the mask or the geometry changes
+         */
+        const bool maskBufferValid =
+            !m_maskBuffer.isNull() &&
+            m_maskBufferSize == m_renderAreaSize &&
+            m_maskBufferPreviewActive == m_maskPreviewActive &&
+            qFuzzyCompare(m_maskBufferDevicePixelRatio, devicePixelRatio);
 
-        QRect rect = QRect(0, 0, m_renderAreaSize.width(), m_renderAreaSize.height());
-        maskPainter.setRenderHint(QPainter::Antialiasing, true);
+        if (!maskBufferValid) {
+            m_maskBuffer = QImage(m_renderAreaSize*devicePixelRatio, QImage::Format_ARGB32_Premultiplied);
+            m_maskBuffer.setDevicePixelRatio(devicePixelRatio);
+            m_maskBuffer.fill(0);
+            QPainter maskPainter(&m_maskBuffer);
 
-        maskPainter.resetTransform();
-        maskPainter.translate(rect.width()*0.5, rect.height()*0.5);
-        maskPainter.scale(rect.width()*0.5, rect.height()*0.5);
+            QRect rect = QRect(0, 0, m_renderAreaSize.width(), m_renderAreaSize.height());
+            maskPainter.setRenderHint(QPainter::Antialiasing, true);
 
-        maskPainter.setPen(QPen(QBrush(Qt::white), 0.002));
-        maskPainter.setBrush(QColor(128,128,128,255)); // middle gray
+            maskPainter.resetTransform();
+            maskPainter.translate(rect.width()*0.5, rect.height()*0.5);
+            maskPainter.scale(rect.width()*0.5, rect.height()*0.5);
 
-        maskPainter.drawEllipse(QPointF(0,0), 1.0, 1.0);
+            maskPainter.setPen(QPen(QBrush(Qt::white), 0.002));
+            maskPainter.setBrush(QColor(128,128,128,255)); // middle gray
 
-        maskPainter.resetTransform();
-        maskPainter.setTransform(m_currentGamutMask->maskToViewTransform(m_renderAreaSize.width()));
+            maskPainter.drawEllipse(QPointF(0,0), 1.0, 1.0);
 
-        maskPainter.setCompositionMode(QPainter::CompositionMode_DestinationIn);
-        m_currentGamutMask->paint(maskPainter, m_maskPreviewActive);
+            maskPainter.resetTransform();
+            maskPainter.setTransform(m_currentGamutMask->maskToViewTransform(m_renderAreaSize.width()));
 
-        maskPainter.setCompositionMode(QPainter::CompositionMode_SourceOver);
-        m_currentGamutMask->paintStroke(maskPainter, m_maskPreviewActive);
+            maskPainter.setCompositionMode(QPainter::CompositionMode_DestinationIn);
+            m_currentGamutMask->paint(maskPainter, m_maskPreviewActive);
+
+            maskPainter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+            m_currentGamutMask->paintStroke(maskPainter, m_maskPreviewActive);
+
+            m_maskBufferSize = m_renderAreaSize;
+            m_maskBufferPreviewActive = m_maskPreviewActive;
+            m_maskBufferDevicePixelRatio = devicePixelRatio;
+        }
 
-        painter->drawImage(m_renderAreaOffsetX, m_renderAreaOffsetY, maskBuffer);
+        painter->drawImage(m_renderAreaOffsetX, m_renderAreaOffsetY, m_maskBuffer);
     }
 
     // draw blips
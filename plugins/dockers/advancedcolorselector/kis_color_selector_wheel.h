@@ -26,10 +26,13 @@ class KisColorSelectorWheel : public KisColorSelectorComponent
 public:
     explicit KisColorSelectorWheel(KisColorSelector *parent);
     void setColor(const KoColor &color) override;
+    void setGamutMask(KoGamutMaskSP gamutMask) override;
+    void updateGamutMaskPreview() override;
 
 protected:
     KoColor selectColor(int x, int y) override;
     void paint(QPainter*) override;
+    bool paintImageDependsOnParameter(Parameter parameter) const override;
 
 private:
     friend class Acs::PixelCacheRenderer;
@@ -49,6 +52,13 @@ private:
     qreal m_renderAreaOffsetX {0.0};
     qreal m_renderAreaOffsetY {0.0};
     QTransform m_toRenderArea;
+
+    // the gamut mask overlay rendered from the vector mask; rebuilt only
+    // when the mask, the render area or the preview state changes
+    QImage m_maskBuffer;
+    QSize m_maskBufferSize;
+    bool m_maskBufferPreviewActive {false};
+    qreal m_maskBufferDevicePixelRatio {0.0};
 };
 
 #endif // KIS_COLOR_SELECTOR_WHEEL_H
@@ -51,6 +51,11 @@ void ChannelDockerWidget::setCanvas(KisCanvas2 * canvas)
 {
     if(m_canvas == canvas)
         return;
+
+    if (m_canvas) {
+        disconnect(m_canvas->image().data(), SIGNAL(sigImageUpdated(QRect)), this, SLOT(slotImageUpdated(QRect)));
+    }
+
     m_canvas = canvas;
 
     m_model->setCanvas(m_canvas);
@@ -58,6 +63,7 @@ void ChannelDockerWidget::setCanvas(KisCanvas2 * canvas)
     KisWidgetWithIdleTask<QWidget>::setCanvas(canvas);
 
     if (m_canvas) {
+        connect(m_canvas->image().data(), SIGNAL(sigImageUpdated(QRect)), SLOT(slotImageUpdated(QRect)));
         connect(m_canvas->displayColorConverter(), SIGNAL(displayConfigurationChanged()), SLOT(startUpdateCanvasProjection()));
         connect(m_model, SIGNAL(channelFlagsChanged()), m_canvas, SLOT(channelSelectionChanged()));
     }
@@ -68,6 +74,11 @@ void ChannelDockerWidget::startUpdateCanvasProjection()
     triggerCacheUpdate();
 }
 
+void ChannelDockerWidget::slotImageUpdated(const QRect &rect)
+{
+    m_dirtyImageRegion += rect;
+}
+
 KisIdleTasksManager::TaskGuard ChannelDockerWidget::registerIdleTask(KisCanvas2 *canvas)
 {
     return
@@ -78,11 +89,35 @@ KisIdleTasksManager::TaskGuard ChannelDockerWidget::registerIdleTask(KisCanvas2
             const QSize previewSize = m_model->thumbnailSizeLimit();
 
             KisChannelsThumbnailsStrokeStrategy *strategy =
-                new KisChannelsThumbnailsStrokeStrategy(image->projection(), image->bounds(),
+                new KisChannelsThumbnailsStrokeStrategy(image->projectionSnapshot(), image->bounds(),
                                                         previewSize, false, config.profile,
                                                         config.intent, config.conversionFlags);
 
+            /**
+             * A cancelled stroke never reports completion, so merge the
+             * region handed to the previous run back first; it is reset
+             * again when the cache update actually arrives
+             */
+            m_dirtyImageRegion += m_dirtyRegionBeingRendered;
+            m_dirtyRegionBeingRendered = m_dirtyImageRegion;
+            m_dirtyImageRegion = QRegion();
+
+            const bool cacheIsValid =
+                m_cachedThumbnailDevice &&
+                m_cachedThumbnailSize == previewSize &&
+                m_cachedImageSize == image->size();
+
+            if (cacheIsValid) {
+                strategy->setIncrementalSource(m_cachedThumbnailDevice, m_dirtyRegionBeingRendered);
+            } else {
+                m_cachedThumbnailDevice = nullptr;
+            }
+
+            m_cachedThumbnailSize = previewSize;
+            m_cachedImageSize = image->size();
+
             connect(strategy, SIGNAL(thumbnailsUpdated(QVector<QImage>, const KoColorSpace*)), this, SLOT(updateImageThumbnails(QVector<QImage>, const KoColorSpace*)));
+            connect(strategy, SIGNAL(thumbnailsCacheUpdated(KisPaintDeviceSP)), this, SLOT(updateThumbnailCache(KisPaintDeviceSP)));
 
             return strategy;
         });
@@ -95,7 +130,16 @@ void ChannelDockerWidget::updateImageThumbnails(const QVector<QImage> &channels,
     m_channelTable->resizeColumnsToContents();
 }
 
+void ChannelDockerWidget::updateThumbnailCache(KisPaintDeviceSP device)
+{
+    m_cachedThumbnailDevice = device;
+    m_dirtyRegionBeingRendered = QRegion();
+}
+
 void ChannelDockerWidget::clearCachedState()
 {
     m_model->setChannelThumbnails({}, nullptr);
+    m_cachedThumbnailDevice = nullptr;
+    m_dirtyImageRegion = QRegion();
+    m_dirtyRegionBeingRendered = QRegion();
 }
@@ -14,6 +14,7 @@
 #include <KisChannelsThumbnailsStrokeStrategyMetatypes.h>
 #include "KisWidgetWithIdleTask.h"
 #include <QTableView>
+#include <QRegion>
 #include <kis_canvas2.h>
 
 class ChannelModel;
@@ -31,7 +32,9 @@ public Q_SLOTS:
     void slotScrollerStateChanged(QScroller::State state){KisKineticScroller::updateCursor(this, state);}
 
 private Q_SLOTS:
+    void slotImageUpdated(const QRect &rect);
     void updateImageThumbnails(const QVector<QImage> &channels, const KoColorSpace *cs);
+    void updateThumbnailCache(KisPaintDeviceSP device);
 
 private:
     KisIdleTasksManager::TaskGuard registerIdleTask(KisCanvas2 *canvas) override;
@@ -40,6 +43,15 @@ private:
 private:
     QTableView *m_channelTable {nullptr};
     ChannelModel *m_model {nullptr};
+
+    // the oversampled device of the last completed thumbnail stroke
+    // and the image region dirtied since; used to regenerate only the
+    // changed tiles on the next run
+    KisPaintDeviceSP m_cachedThumbnailDevice;
+    QRegion m_dirtyImageRegion;
+    QRegion m_dirtyRegionBeingRendered;
+    QSize m_cachedThumbnailSize;
+    QSize m_cachedImageSize;
 };
 
 
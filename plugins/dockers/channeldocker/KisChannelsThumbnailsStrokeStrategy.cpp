@@ -51,4 +51,5 @@ void KisChannelsThumbnailsStrokeStrategy::reportThumbnailGenerationCompleted(Kis
     }
 
     Q_EMIT thumbnailsUpdated(thumbnails, cs);
+    Q_EMIT thumbnailsCacheUpdated(oversampledThumbnailSnapshot());
 }
@@ -23,6 +23,10 @@ Q_SIGNALS:
     //Emitted when thumbnail is updated and overviewImage is fully generated.
     void thumbnailsUpdated(const QVector<QImage> &channels, const KoColorSpace *cs);
 
+    //Emitted alongside thumbnailsUpdated() with the oversampled device
+    //that can seed the next incremental run
+    void thumbnailsCacheUpdated(KisPaintDeviceSP device);
+
 };
 
 #endif // KISCHANNELSTHUMBNAILSSTROKESTRATEGY_H
@@ -6,6 +6,7 @@
  */
 #include "HistogramComputationStrokeStrategy.h"
 
+#include "KoColorModelStandardIds.h"
 #include "KoColorSpace.h"
 
 #include "krita_utils.h"
@@ -29,15 +30,21 @@ struct HistogramComputationStrokeStrategy::Private
     };
 
     KisImageSP image;
+    QRegion dirtyRegion;
+    HistogramData previousData;
     std::vector<HistVector> results;
 };
 
 
-HistogramComputationStrokeStrategy::HistogramComputationStrokeStrategy(KisImageSP image)
+HistogramComputationStrokeStrategy::HistogramComputationStrokeStrategy(KisImageSP image,
+                                                                       const QRegion &dirtyRegion,
+                                                                       const HistogramData &previousData)
     : KisIdleTaskStrokeStrategy(QLatin1String("ComputeHistogram"), kundo2_i18n("Update histogram"))
     , m_d(new Private)
 {
     m_d->image = image;
+    m_d->dirtyRegion = dirtyRegion;
+    m_d->previousData = previousData;
 }
 
 HistogramComputationStrokeStrategy::~HistogramComputationStrokeStrategy()
@@ -48,14 +55,30 @@ void HistogramComputationStrokeStrategy::initStrokeCallback()
 {
     KisIdleTaskStrokeStrategy::initStrokeCallback();
 
-    QVector<KisStrokeJobData*> jobsData;
-    int i = 0;
-    QVector<QRect> tileRects = KritaUtils::splitRectIntoPatches(m_d->image->bounds(), KritaUtils::optimalPatchSize());
+    const QRect imageBounds = m_d->image->bounds();
+    const KoColorSpace *cs = m_d->image->projection()->colorSpace();
+
+    QVector<QRect> tileRects = KritaUtils::splitRectIntoPatches(imageBounds, KritaUtils::optimalPatchSize());
     m_d->results.resize(tileRects.size());
 
-    Q_FOREACH (const QRect &tileRectangle, tileRects) {
-        jobsData << new HistogramComputationStrokeStrategy::Private::ProcessData(tileRectangle, i);
-        i++;
+    /**
+     * When the previous computation covered the same patch grid, only the
+     * patches touched by the dirty region need to be recomputed; the bins
+     * of the clean patches are carried over and merged as they are.
+     */
+    const bool reuseCleanPatches =
+        !m_d->dirtyRegion.isEmpty() &&
+        m_d->previousData.colorSpace == cs &&
+        m_d->previousData.bounds == imageBounds &&
+        int(m_d->previousData.patchBins.size()) == tileRects.size();
+
+    QVector<KisStrokeJobData*> jobsData;
+    for (int i = 0; i < tileRects.size(); i++) {
+        if (reuseCleanPatches && !m_d->dirtyRegion.intersects(tileRects[i])) {
+            m_d->results[i] = m_d->previousData.patchBins[i];
+        } else {
+            jobsData << new HistogramComputationStrokeStrategy::Private::ProcessData(tileRects[i], i);
+        }
     }
     addMutatedJobs(jobsData);
 }
@@ -85,6 +108,15 @@ void HistogramComputationStrokeStrategy::doStrokeCallback(KisStrokeJobData *data
         return;
 
     initiateVector(m_d->results[d_pd->jobId], cs);
+    HistVector &bins = m_d->results[d_pd->jobId];
+
+    /**
+     * Integer colorspaces store their channels in pixel order, so the bin
+     * index can be read straight from the pixel data instead of going
+     * through a virtual scaleToU8() call per channel per pixel.
+     */
+    const bool isUint8 = cs->colorDepthId() == Integer8BitsColorDepthID;
+    const bool isUint16 = cs->colorDepthId() == Integer16BitsColorDepthID;
 
     quint32 toSkip = nSkip;
 
@@ -95,14 +127,38 @@ void HistogramComputationStrokeStrategy::doStrokeCallback(KisStrokeJobData *data
 
         numConseqPixels = it.nConseqPixels();
         const quint8* pixel = it.rawDataConst();
-        for (int k = 0; k < numConseqPixels; ++k) {
-            if (--toSkip == 0) {
-                for (int chan = 0; chan < (int)channelCount; ++chan) {
-                    m_d->results[d_pd->jobId][chan][cs->scaleToU8(pixel, chan)]++;
+
+        if (isUint8) {
+            for (int k = 0; k < numConseqPixels; ++k) {
+                if (--toSkip == 0) {
+                    for (quint32 chan = 0; chan < channelCount; ++chan) {
+                        bins[chan][pixel[chan]]++;
+                    }
+                    toSkip = nSkip;
                 }
-                toSkip = nSkip;
+                pixel += pixelSize;
+            }
+        } else if (isUint16) {
+            for (int k = 0; k < numConseqPixels; ++k) {
+                if (--toSkip == 0) {
+                    const quint16 *channels = reinterpret_cast<const quint16 *>(pixel);
+                    for (quint32 chan = 0; chan < channelCount; ++chan) {
+                        bins[chan][channels[chan] >> 8]++;
+                    }
+                    toSkip = nSkip;
+                }
+                pixel += pixelSize;
+            }
+        } else {
+            for (int k = 0; k < numConseqPixels; ++k) {
+                if (--toSkip == 0) {
+                    for (quint32 chan = 0; chan < channelCount; ++chan) {
+                        bins[chan][cs->scaleToU8(pixel, chan)]++;
+                    }
+                    toSkip = nSkip;
+                }
+                pixel += pixelSize;
             }
-            pixel += pixelSize;
         }
     }
 }
@@ -111,10 +167,11 @@ void HistogramComputationStrokeStrategy::finishStrokeCallback()
 {
     HistogramData hisData;
     hisData.colorSpace = m_d->image->projection()->colorSpace();
+    hisData.bounds = m_d->image->bounds();
+    hisData.coveredRegion = m_d->dirtyRegion;
 
     if (m_d->results.size() == 1) {
         hisData.bins = m_d->results[0];
-        Q_EMIT computationResultReady(hisData);
     } else {
 
         quint32 channelCount = m_d->image->projection()->channelCount();
@@ -124,17 +181,19 @@ void HistogramComputationStrokeStrategy::finishStrokeCallback()
         for (int chan = 0; chan < (int)channelCount; chan++) {
             int bsize = hisData.bins[chan].size();
 
-            for (int bi = 0; bi < bsize; bi++) {
-                hisData.bins[chan][bi] = 0;
-                for (int i = 0; i < (int)m_d->results.size(); i++) {
+            for (int i = 0; i < (int)m_d->results.size(); i++) {
+                if (m_d->results[i].empty()) continue;
+
+                for (int bi = 0; bi < bsize; bi++) {
                     hisData.bins[chan][bi] += m_d->results[i][chan][bi];
                 }
             }
         }
-
-        Q_EMIT computationResultReady(hisData);
     }
 
+    hisData.patchBins = m_d->results;
+    Q_EMIT computationResultReady(hisData);
+
     KisIdleTaskStrokeStrategy::finishStrokeCallback();
 }
 
@@ -8,6 +8,7 @@
 #define HISTOGRAMCOMPUTATIONSTROKESTRATEGY_H
 
 #include <KisIdleTaskStrokeStrategy.h>
+#include <QRegion>
 #include <vector>
 
 class KoColorSpace;
@@ -19,6 +20,17 @@ struct HistogramData
 {
     HistVector bins;
     const KoColorSpace* colorSpace {0};
+
+    /**
+     * The per-patch bins and the image bounds they were computed for.
+     * Feeding them back into the next computation lets it reuse the
+     * patches that did not change and recompute only the dirty ones.
+     */
+    QRect bounds;
+    std::vector<HistVector> patchBins;
+
+    /// The dirty region this computation has consumed
+    QRegion coveredRegion;
 };
 Q_DECLARE_METATYPE(HistogramData)
 
@@ -27,7 +39,9 @@ class HistogramComputationStrokeStrategy : public KisIdleTaskStrokeStrategy
 {
     Q_OBJECT
 public:
-    HistogramComputationStrokeStrategy(KisImageSP image);
+    HistogramComputationStrokeStrategy(KisImageSP image,
+                                       const QRegion &dirtyRegion = QRegion(),
+                                       const HistogramData &previousData = HistogramData());
     ~HistogramComputationStrokeStrategy() override;
 
 private:
@@ -18,6 +18,7 @@
 #include "KoChannelInfo.h"
 #include "KisViewManager.h"
 #include "kis_canvas2.h"
+#include "kis_image.h"
 
 
 
@@ -32,13 +33,41 @@ HistogramDockerWidget::~HistogramDockerWidget()
 {
 }
 
+void HistogramDockerWidget::setCanvas(KisCanvas2 *canvas)
+{
+    if (m_canvas) {
+        m_canvas->image()->disconnect(this);
+    }
+
+    KisWidgetWithIdleTask<QLabel>::setCanvas(canvas);
+
+    if (m_canvas) {
+        connect(m_canvas->image().data(), SIGNAL(sigImageUpdated(QRect)),
+                this, SLOT(slotImageUpdated(QRect)), Qt::UniqueConnection);
+    }
+}
+
 void HistogramDockerWidget::receiveNewHistogram(HistogramData data)
 {
     m_histogramData = data.bins;
     m_colorSpace = data.colorSpace;
+
+    /**
+     * The rects that arrived while the computation was running stay in
+     * the dirty region; the idle tasks manager will restart the task for
+     * them anyway.
+     */
+    m_dirtyRegion -= data.coveredRegion;
+    m_cachedData = std::move(data);
+
     update();
 }
 
+void HistogramDockerWidget::slotImageUpdated(const QRect &rect)
+{
+    m_dirtyRegion += rect;
+}
+
 KisIdleTasksManager::TaskGuard HistogramDockerWidget::registerIdleTask(KisCanvas2 *canvas)
 {
     KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(canvas, KisIdleTasksManager::TaskGuard());
@@ -47,7 +76,7 @@ KisIdleTasksManager::TaskGuard HistogramDockerWidget::registerIdleTask(KisCanvas
         canvas->viewManager()->idleTasksManager()->
         addIdleTaskWithGuard([this](KisImageSP image) {
             HistogramComputationStrokeStrategy* strategy =
-                new HistogramComputationStrokeStrategy(image);
+                new HistogramComputationStrokeStrategy(image, m_dirtyRegion, m_cachedData);
 
             connect(strategy, SIGNAL(computationResultReady(HistogramData)), this, SLOT(receiveNewHistogram(HistogramData)));
 
@@ -59,6 +88,8 @@ void HistogramDockerWidget::clearCachedState()
 {
     m_colorSpace = 0;
     m_histogramData.clear();
+    m_cachedData = HistogramData();
+    m_dirtyRegion = QRegion();
 }
 
 void HistogramDockerWidget::paintEvent(QPaintEvent *event)
@@ -24,10 +24,12 @@ class HistogramDockerWidget : public KisWidgetWithIdleTask<QLabel>
 public:
     HistogramDockerWidget(QWidget *parent = 0, const char *name = 0, Qt::WindowFlags f = Qt::WindowFlags());
     ~HistogramDockerWidget() override;
+    void setCanvas(KisCanvas2 *canvas) override;
     void paintEvent(QPaintEvent *event) override;
 
 public Q_SLOTS:
     void receiveNewHistogram(HistogramData data);
+    void slotImageUpdated(const QRect &rect);
 
 private:
     KisIdleTasksManager::TaskGuard registerIdleTask(KisCanvas2 *canvas) override;
@@ -37,6 +39,14 @@ private:
     HistVector m_histogramData;
     const KoColorSpace* m_colorSpace {0};
     bool m_smoothHistogram {false};
+
+    /**
+     * The per-patch bins of the last computation plus the region that
+     * changed since; together they let the next computation recalculate
+     * only the patches that are actually dirty.
+     */
+    HistogramData m_cachedData;
+    QRegion m_dirtyRegion;
 };
 
 #endif // HISTOGRAMDOCKERWIDGET_H
@@ -0,0 +1,232 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#include "MemoryProfilerDock.h"
+
+#include <QFile>
+#include <QFileDialog>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPushButton>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+#include <KFormat>
+#include <klocalizedstring.h>
+
+#include <kis_image.h>
+#include <kis_memory_statistics_server.h>
+
+namespace {
+
+QTreeWidgetItem* addItem(QTreeWidgetItem *parent,
+                         const QString &name,
+                         qint64 size)
+{
+    QTreeWidgetItem *item = new QTreeWidgetItem(parent);
+    item->setText(0, name);
+    item->setText(1, KFormat().formatByteSize(qreal(size)));
+    item->setTextAlignment(1, Qt::AlignRight | Qt::AlignVCenter);
+    return item;
+}
+
+QTreeWidgetItem* addCounterItem(QTreeWidgetItem *parent,
+                                const QString &name,
+                                qint64 value,
+                                qint64 previousValue)
+{
+    QTreeWidgetItem *item = new QTreeWidgetItem(parent);
+    item->setText(0, name);
+    item->setText(1, QString("%1 (+%2)")
+                         .arg(value)
+                         .arg(qMax<qint64>(value - previousValue, 0)));
+    item->setTextAlignment(1, Qt::AlignRight | Qt::AlignVCenter);
+    return item;
+}
+
+} // namespace
+
+MemoryProfilerDock::MemoryProfilerDock()
+    : QDockWidget(i18n("Memory Profiler"))
+{
+    QWidget *page = new QWidget(this);
+    QVBoxLayout *layout = new QVBoxLayout(page);
+
+    m_tree = new QTreeWidget(page);
+    m_tree->setColumnCount(2);
+    m_tree->setHeaderLabels({i18n("Subsystem"), i18n("Size")});
+    m_tree->setRootIsDecorated(true);
+    layout->addWidget(m_tree);
+
+    m_snapshotButton = new QPushButton(i18n("Save Snapshot..."), page);
+    layout->addWidget(m_snapshotButton);
+
+    setWidget(page);
+
+    connect(m_snapshotButton, SIGNAL(clicked()), SLOT(saveSnapshot()));
+    connect(KisMemoryStatisticsServer::instance(),
+            SIGNAL(sigUpdateMemoryStatistics()),
+            SLOT(updateStatistics()));
+
+    updateStatistics();
+}
+
+void MemoryProfilerDock::setCanvas(KoCanvasBase *canvas)
+{
+    m_canvas = dynamic_cast<KisCanvas2*>(canvas);
+    updateStatistics();
+}
+
+void MemoryProfilerDock::unsetCanvas()
+{
+    m_canvas = nullptr;
+    updateStatistics();
+}
+
+void MemoryProfilerDock::updateStatistics()
+{
+    if (!isVisible()) return;
+
+    KisImageSP image = m_canvas ? m_canvas->image() : nullptr;
+    const KisMemoryStatisticsServer::Statistics stats =
+        KisMemoryStatisticsServer::instance()->fetchMemoryStatistics(image);
+
+    m_tree->clear();
+
+    QTreeWidgetItem *imageItem =
+        addItem(nullptr, i18n("Current Image"), stats.imageSize);
+    addItem(imageItem, i18n("Layers"), stats.layersSize);
+    addItem(imageItem, i18n("Projections"), stats.projectionsSize);
+    addItem(imageItem, i18n("Instant Preview"), stats.lodSize);
+
+    /**
+     * The per-node sizes are attributed to the owning node, so the
+     * indentation of the layer stack can be restored from the levels.
+     */
+    QTreeWidgetItem *layersItem =
+        addItem(nullptr, i18n("Per Layer"), stats.imageSize);
+    QVector<QTreeWidgetItem*> parents;
+    parents << layersItem;
+
+    Q_FOREACH (const KisMemoryStatisticsServer::Statistics::NodeStatistics &node,
+               stats.nodeStatistics) {
+
+        parents.resize(node.level + 1);
+        QTreeWidgetItem *item =
+            addItem(parents.last(), node.name, node.totalSize);
+        parents << item;
+    }
+
+    QTreeWidgetItem *tilesItem =
+        addItem(nullptr, i18n("Tile Store"), stats.totalMemorySize);
+    addItem(tilesItem, i18n("In Memory"), stats.realMemorySize);
+    addItem(tilesItem, i18n("Undo History"), stats.historicalMemorySize);
+    addItem(tilesItem, i18n("Pooler Reserve"), stats.poolSize);
+    addItem(tilesItem, i18n("Swapped Out"), stats.swapSize);
+
+    /**
+     * Activity counters since the start of the session; the deltas in
+     * parentheses cover the interval since the last refresh.
+     */
+    const KisTileDataStore::TileStatistics tileStats =
+        KisTileDataStore::instance()->tileStatistics();
+
+    QTreeWidgetItem *activityItem = new QTreeWidgetItem();
+    activityItem->setText(0, i18n("Tile Activity"));
+    addCounterItem(activityItem, i18n("Allocations"),
+                   tileStats.allocations, m_lastTileStats.allocations);
+    addCounterItem(activityItem, i18n("Pool Hits"),
+                   tileStats.poolHits, m_lastTileStats.poolHits);
+    addCounterItem(activityItem, i18n("Pool Misses"),
+                   tileStats.poolMisses, m_lastTileStats.poolMisses);
+    addCounterItem(activityItem, i18n("Swap-Outs"),
+                   tileStats.swapOuts, m_lastTileStats.swapOuts);
+    addCounterItem(activityItem, i18n("Swap-Ins"),
+                   tileStats.swapIns, m_lastTileStats.swapIns);
+    if (tileStats.compressedSwapSize > 0) {
+        QTreeWidgetItem *ratioItem = new QTreeWidgetItem(activityItem);
+        ratioItem->setText(0, i18n("Swap Compression Ratio"));
+        ratioItem->setText(1, QString::number(qreal(tileStats.rawSwapSize) /
+                                              tileStats.compressedSwapSize, 'f', 2));
+        ratioItem->setTextAlignment(1, Qt::AlignRight | Qt::AlignVCenter);
+    }
+    m_lastTileStats = tileStats;
+
+    QTreeWidgetItem *limitsItem =
+        addItem(nullptr, i18n("Limits"), stats.totalMemoryLimit);
+    addItem(limitsItem, i18n("Tiles Hard Limit"), stats.tilesHardLimit);
+    addItem(limitsItem, i18n("Tiles Soft Limit"), stats.tilesSoftLimit);
+    addItem(limitsItem, i18n("Pool Limit"), stats.tilesPoolLimit);
+
+    m_tree->addTopLevelItem(imageItem);
+    m_tree->addTopLevelItem(layersItem);
+    m_tree->addTopLevelItem(tilesItem);
+    m_tree->addTopLevelItem(limitsItem);
+
+    imageItem->setExpanded(true);
+    tilesItem->setExpanded(true);
+    m_tree->resizeColumnToContents(0);
+}
+
+void MemoryProfilerDock::saveSnapshot()
+{
+    const QString fileName =
+        QFileDialog::getSaveFileName(this, i18n("Save Memory Snapshot"),
+                                     QString(), i18n("JSON files (*.json)"));
+    if (fileName.isEmpty()) return;
+
+    KisImageSP image = m_canvas ? m_canvas->image() : nullptr;
+    const KisMemoryStatisticsServer::Statistics stats =
+        KisMemoryStatisticsServer::instance()->fetchMemoryStatistics(image);
+
+    QJsonObject root;
+    root["imageSize"] = stats.imageSize;
+    root["layersSize"] = stats.layersSize;
+    root["projectionsSize"] = stats.projectionsSize;
+    root["lodSize"] = stats.lodSize;
+    root["totalMemorySize"] = stats.totalMemorySize;
+    root["realMemorySize"] = stats.realMemorySize;
+    root["historicalMemorySize"] = stats.historicalMemorySize;
+    root["poolSize"] = stats.poolSize;
+    root["swapSize"] = stats.swapSize;
+    root["totalMemoryLimit"] = stats.totalMemoryLimit;
+    root["tilesHardLimit"] = stats.tilesHardLimit;
+    root["tilesSoftLimit"] = stats.tilesSoftLimit;
+    root["tilesPoolLimit"] = stats.tilesPoolLimit;
+
+    QJsonArray nodes;
+    Q_FOREACH (const KisMemoryStatisticsServer::Statistics::NodeStatistics &node,
+               stats.nodeStatistics) {
+
+        QJsonObject object;
+        object["name"] = node.name;
+        object["level"] = node.level;
+        object["layersSize"] = node.layersSize;
+        object["projectionsSize"] = node.projectionsSize;
+        object["lodSize"] = node.lodSize;
+        object["totalSize"] = node.totalSize;
+        nodes.append(object);
+    }
+    root["nodes"] = nodes;
+
+    const KisTileDataStore::TileStatistics tileStats =
+        KisTileDataStore::instance()->tileStatistics();
+
+    QJsonObject tiles;
+    tiles["allocations"] = tileStats.allocations;
+    tiles["poolHits"] = tileStats.poolHits;
+    tiles["poolMisses"] = tileStats.poolMisses;
+    tiles["swapOuts"] = tileStats.swapOuts;
+    tiles["swapIns"] = tileStats.swapIns;
+    tiles["rawSwapSize"] = tileStats.rawSwapSize;
+    tiles["compressedSwapSize"] = tileStats.compressedSwapSize;
+    root["tileStatistics"] = tiles;
+
+    QFile file(fileName);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(QJsonDocument(root).toJson());
+    }
+}
@@ -0,0 +1,50 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef _MEMORY_PROFILER_DOCK_H_
+#define _MEMORY_PROFILER_DOCK_H_
+
+#include <QDockWidget>
+#include <QPointer>
+
+#include <KoCanvasObserverBase.h>
+
+#include <kis_canvas2.h>
+#include <tiles3/kis_tile_data_store.h>
+
+class QPushButton;
+class QTreeWidget;
+
+/**
+ * Shows a live breakdown of Krita's memory consumption: per-layer
+ * attribution of the image devices, the tile store totals (including
+ * the historical tiles held by the undo system, the pooler reserve and
+ * the swapped-out part) and the configured limits. The breakdown can
+ * be dumped into a JSON snapshot for offline comparison.
+ */
+class MemoryProfilerDock : public QDockWidget, public KoCanvasObserverBase {
+    Q_OBJECT
+public:
+    MemoryProfilerDock();
+
+    QString observerName() override { return "MemoryProfilerDock"; }
+    void setCanvas(KoCanvasBase *canvas) override;
+    void unsetCanvas() override;
+
+private Q_SLOTS:
+    void updateStatistics();
+    void saveSnapshot();
+
+private:
+    QPointer<KisCanvas2> m_canvas;
+    QTreeWidget *m_tree {nullptr};
+    QPushButton *m_snapshotButton {nullptr};
+
+    /// previous counter snapshot, for the per-interval deltas
+    KisTileDataStore::TileStatistics m_lastTileStats;
+};
+
+#endif
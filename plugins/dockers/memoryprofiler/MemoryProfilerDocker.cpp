@@ -0,0 +1,64 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#include "MemoryProfilerDocker.h"
+
+#include <kpluginfactory.h>
+#include <klocalizedstring.h>
+
+#include <KoDockFactoryBase.h>
+#include <KoDockRegistry.h>
+
+#include "MemoryProfilerDock.h"
+
+K_PLUGIN_FACTORY_WITH_JSON(MemoryProfilerDockerPluginFactory,
+                           "krita_memoryprofiler.json",
+                           registerPlugin<MemoryProfilerDockerPlugin>();)
+
+class MemoryProfilerDockFactory : public KoDockFactoryBase {
+public:
+    MemoryProfilerDockFactory()
+    {
+    }
+
+    ~MemoryProfilerDockFactory() override
+    {
+    }
+
+    QString id() const override
+    {
+        return QString("MemoryProfilerDock");
+    }
+
+    Qt::DockWidgetArea defaultDockWidgetArea() const
+    {
+        return Qt::RightDockWidgetArea;
+    }
+
+    QDockWidget* createDockWidget() override
+    {
+        MemoryProfilerDock *dockWidget = new MemoryProfilerDock();
+        dockWidget->setObjectName(id());
+        return dockWidget;
+    }
+
+    DockPosition defaultDockPosition() const override
+    {
+        return DockMinimized;
+    }
+};
+
+
+MemoryProfilerDockerPlugin::MemoryProfilerDockerPlugin(QObject *parent, const QVariantList &)
+    : QObject(parent)
+{
+    KoDockRegistry::instance()->add(new MemoryProfilerDockFactory());
+}
+
+MemoryProfilerDockerPlugin::~MemoryProfilerDockerPlugin()
+{
+}
+
+#include "MemoryProfilerDocker.moc"
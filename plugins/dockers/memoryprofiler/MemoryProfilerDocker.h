@@ -0,0 +1,21 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef _MEMORY_PROFILER_DOCKER_H_
+#define _MEMORY_PROFILER_DOCKER_H_
+
+#include <QObject>
+#include <QVariant>
+
+class MemoryProfilerDockerPlugin : public QObject
+{
+    Q_OBJECT
+public:
+    MemoryProfilerDockerPlugin(QObject *parent, const QVariantList &);
+    ~MemoryProfilerDockerPlugin() override;
+};
+
+#endif
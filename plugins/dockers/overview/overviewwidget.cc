@@ -44,13 +44,16 @@ OverviewWidget::~OverviewWidget()
 void OverviewWidget::setCanvas(KisCanvas2 *canvas)
 {
     if (m_canvas) {
-        m_canvas->image()->disconnect(this);
+        disconnect(m_canvas->image().data(), SIGNAL(sigImageUpdated(QRect)), this, SLOT(slotImageUpdated(QRect)));
         m_canvas->displayColorConverter()->disconnect(this);
+        stashCanvasState();
     }
 
     KisWidgetWithIdleTask<QWidget>::setCanvas(canvas);
 
     if (m_canvas) {
+        restoreCanvasState();
+        connect(m_canvas->image().data(), SIGNAL(sigImageUpdated(QRect)), SLOT(slotImageUpdated(QRect)));
         connect(m_canvas->displayColorConverter(), SIGNAL(displayConfigurationChanged()), SLOT(startUpdateCanvasProjection()));
         connect(m_canvas->canvasController()->proxyObject, SIGNAL(canvasOffsetXChanged(int)), this, SLOT(update()), Qt::UniqueConnection);
         connect(m_canvas->viewManager()->mainWindow(), SIGNAL(themeChanged()), this, SLOT(slotThemeChanged()), Qt::UniqueConnection);
@@ -89,10 +92,39 @@ KisIdleTasksManager::TaskGuard OverviewWidget::registerIdleTask(KisCanvas2 *canv
                 thumbnailSize.scale(image->size(), Qt::KeepAspectRatio);
             }
 
+            /**
+             * The published snapshot shares its tiles with the real
+             * projection in a COW manner, so rendering the thumbnail
+             * doesn't serialize against the painting strokes
+             */
             KisImageThumbnailStrokeStrategy *strategy =
-                new KisImageThumbnailStrokeStrategy(image->projection(), image->bounds(), thumbnailSize, isPixelArt(), config.profile, config.intent, config.conversionFlags);
+                new KisImageThumbnailStrokeStrategy(image->projectionSnapshot(), image->bounds(), thumbnailSize, isPixelArt(), config.profile, config.intent, config.conversionFlags);
+
+            /**
+             * A cancelled stroke never reports completion, so merge the
+             * region handed to the previous run back first; it is reset
+             * again when the cache update actually arrives
+             */
+            m_dirtyImageRegion += m_dirtyRegionBeingRendered;
+            m_dirtyRegionBeingRendered = m_dirtyImageRegion;
+            m_dirtyImageRegion = QRegion();
+
+            const bool cacheIsValid =
+                m_cachedThumbnailDevice &&
+                m_cachedThumbnailSize == thumbnailSize &&
+                m_cachedImageSize == image->size();
+
+            if (cacheIsValid) {
+                strategy->setIncrementalSource(m_cachedThumbnailDevice, m_dirtyRegionBeingRendered);
+            } else {
+                m_cachedThumbnailDevice = nullptr;
+            }
+
+            m_cachedThumbnailSize = thumbnailSize;
+            m_cachedImageSize = image->size();
 
             connect(strategy, SIGNAL(thumbnailUpdated(QImage)), this, SLOT(updateThumbnail(QImage)));
+            connect(strategy, SIGNAL(thumbnailCacheUpdated(KisPaintDeviceSP)), this, SLOT(updateThumbnailCache(KisPaintDeviceSP)));
 
             return strategy;
         });
@@ -102,6 +134,112 @@ void OverviewWidget::clearCachedState()
 {
     m_pixmap = QPixmap();
     m_oldPixmap = QPixmap();
+    m_cachedThumbnailDevice = nullptr;
+    m_dirtyImageRegion = QRegion();
+    m_dirtyRegionBeingRendered = QRegion();
+}
+
+void OverviewWidget::stashCanvasState()
+{
+    if (m_oldPixmap.isNull() && !m_cachedThumbnailDevice) {
+        return;
+    }
+
+    /**
+     * The suspended thumbnails are only an optimization for switching
+     * back to a recently used document, so instead of tracking usage
+     * order just drop all of them when the budget is exceeded
+     */
+    static constexpr int maxSuspendedStates = 8;
+    if (!m_suspendedStates.contains(m_canvas) &&
+        m_suspendedStates.size() >= maxSuspendedStates) {
+
+        // clear the map before dropping the connections, so that the
+        // shared-image reference check doesn't see the doomed entries
+        const QHash<QObject*, SuspendedCanvasState> droppedStates = m_suspendedStates;
+        m_suspendedStates.clear();
+
+        for (auto it = droppedStates.begin(); it != droppedStates.end(); ++it) {
+            dropSuspendedStateConnections(it.key(), it.value());
+        }
+    }
+
+    SuspendedCanvasState state;
+    state.image = m_canvas->image();
+    state.oldPixmap = m_oldPixmap;
+    state.cachedThumbnailDevice = m_cachedThumbnailDevice;
+    state.cachedThumbnailSize = m_cachedThumbnailSize;
+    state.cachedImageSize = m_cachedImageSize;
+
+    /**
+     * A stroke rendering right now will never report back to this
+     * canvas, so its region counts as dirty again
+     */
+    state.dirtyImageRegion = m_dirtyImageRegion + m_dirtyRegionBeingRendered;
+
+    m_suspendedStates.insert(m_canvas, state);
+
+    connect(m_canvas->image().data(), SIGNAL(sigImageUpdated(QRect)),
+            this, SLOT(slotSuspendedImageUpdated(QRect)), Qt::UniqueConnection);
+    connect(m_canvas, SIGNAL(destroyed(QObject*)),
+            this, SLOT(slotSuspendedCanvasDestroyed(QObject*)), Qt::UniqueConnection);
+}
+
+void OverviewWidget::restoreCanvasState()
+{
+    auto it = m_suspendedStates.find(m_canvas);
+    if (it == m_suspendedStates.end()) {
+        return;
+    }
+
+    const SuspendedCanvasState state = it.value();
+    dropSuspendedStateConnections(it.key(), state);
+    m_suspendedStates.erase(it);
+
+    KisImageSP image = state.image;
+    if (!image || image != m_canvas->image()) {
+        return;
+    }
+
+    m_oldPixmap = state.oldPixmap;
+    m_cachedThumbnailDevice = state.cachedThumbnailDevice;
+    m_cachedThumbnailSize = state.cachedThumbnailSize;
+    m_cachedImageSize = state.cachedImageSize;
+    m_dirtyImageRegion = state.dirtyImageRegion;
+    m_dirtyRegionBeingRendered = QRegion();
+
+    recalculatePreviewDimensions();
+    if (!m_oldPixmap.isNull()) {
+        m_pixmap = m_oldPixmap.scaled(m_previewSize, Qt::KeepAspectRatio, Qt::FastTransformation);
+    }
+}
+
+void OverviewWidget::dropSuspendedStateConnections(QObject *canvasKey, const SuspendedCanvasState &state)
+{
+    KisImageSP image = state.image;
+    if (image) {
+        /**
+         * Several canvases (Window -> New View) may share one image,
+         * and the dirty-region connection is per image, so it must
+         * stay alive until the last suspended entry referencing the
+         * image is gone. The entry being dropped is excluded by key:
+         * it may still be present in the map at this point.
+         */
+        bool imageStillReferenced = false;
+        for (auto it = m_suspendedStates.begin(); it != m_suspendedStates.end(); ++it) {
+            if (it.key() != canvasKey && it->image.data() == image.data()) {
+                imageStillReferenced = true;
+                break;
+            }
+        }
+
+        if (!imageStillReferenced) {
+            disconnect(image.data(), SIGNAL(sigImageUpdated(QRect)),
+                       this, SLOT(slotSuspendedImageUpdated(QRect)));
+        }
+    }
+    disconnect(canvasKey, SIGNAL(destroyed(QObject*)),
+               this, SLOT(slotSuspendedCanvasDestroyed(QObject*)));
 }
 
 bool OverviewWidget::isPixelArt()
@@ -143,6 +281,32 @@ void OverviewWidget::startUpdateCanvasProjection()
     triggerCacheUpdate();
 }
 
+void OverviewWidget::slotImageUpdated(const QRect &rect)
+{
+    m_dirtyImageRegion += rect;
+}
+
+void OverviewWidget::slotSuspendedImageUpdated(const QRect &rect)
+{
+    QObject *image = sender();
+
+    for (auto it = m_suspendedStates.begin(); it != m_suspendedStates.end(); ++it) {
+        KisImageSP entryImage = it->image;
+        if (entryImage && entryImage.data() == image) {
+            it->dirtyImageRegion += rect;
+        }
+    }
+}
+
+void OverviewWidget::slotSuspendedCanvasDestroyed(QObject *canvas)
+{
+    auto it = m_suspendedStates.find(canvas);
+    if (it != m_suspendedStates.end()) {
+        dropSuspendedStateConnections(it.key(), it.value());
+        m_suspendedStates.erase(it);
+    }
+}
+
 void OverviewWidget::resizeEvent(QResizeEvent *event)
 {
     Q_UNUSED(event);
@@ -216,6 +380,12 @@ void OverviewWidget::updateThumbnail(QImage pixmap)
     update();
 }
 
+void OverviewWidget::updateThumbnailCache(KisPaintDeviceSP device)
+{
+    m_cachedThumbnailDevice = device;
+    m_dirtyRegionBeingRendered = QRegion();
+}
+
 void OverviewWidget::slotThemeChanged()
 {
     m_outlineColor = qApp->palette().color(QPalette::Highlight);
@@ -10,8 +10,10 @@
 #define OVERVIEWWIDGET_H
 #include <QObject>
 #include <QWidget>
+#include <QHash>
 #include <QPixmap>
 #include <QPointer>
+#include <QRegion>
 
 #include "KisWidgetWithIdleTask.h"
 
@@ -38,7 +40,11 @@ public:
 
 public Q_SLOTS:
     void startUpdateCanvasProjection();
+    void slotImageUpdated(const QRect &rect);
+    void slotSuspendedImageUpdated(const QRect &rect);
+    void slotSuspendedCanvasDestroyed(QObject *canvas);
     void updateThumbnail(QImage pixmap);
+    void updateThumbnailCache(KisPaintDeviceSP device);
     void slotThemeChanged();
 
 Q_SIGNALS:
@@ -86,6 +92,37 @@ private:
     bool m_dragging {false};
     QPointF m_lastPos {QPointF(0, 0)};
 
+    // the oversampled device of the last completed thumbnail stroke
+    // and the image region dirtied since; used to regenerate only the
+    // changed tiles on the next run
+    KisPaintDeviceSP m_cachedThumbnailDevice;
+    QRegion m_dirtyImageRegion;
+    QRegion m_dirtyRegionBeingRendered;
+    QSize m_cachedThumbnailSize;
+    QSize m_cachedImageSize;
+
+    /**
+     * Thumbnail state of the canvases the docker is currently not
+     * showing. Keeping it across document switches means only the
+     * region dirtied while a document was inactive needs to be
+     * re-rendered when the user switches back, instead of the whole
+     * image.
+     */
+    struct SuspendedCanvasState {
+        KisImageWSP image;
+        QPixmap oldPixmap;
+        KisPaintDeviceSP cachedThumbnailDevice;
+        QSize cachedThumbnailSize;
+        QSize cachedImageSize;
+        QRegion dirtyImageRegion;
+    };
+
+    void stashCanvasState();
+    void restoreCanvasState();
+    void dropSuspendedStateConnections(QObject *canvasKey, const SuspendedCanvasState &state);
+
+    QHash<QObject*, SuspendedCanvasState> m_suspendedStates;
+
     QColor m_outlineColor;
 };
 
@@ -8,6 +8,7 @@
 #include <kis_config.h>
 #include <kis_color_button.h>
 #include <kis_filter_configuration.h>
+#include <filter/kis_color_transformation_configuration.h>
 #include <KisVisualColorSelectorShape.h>
 #include <KisVisualRectangleSelectorShape.h>
 #include <KisVisualEllipticalSelectorShape.h>
@@ -44,7 +45,9 @@ KisASCCDLConfigWidget::~KisASCCDLConfigWidget()
 
 KisPropertiesConfigurationSP KisASCCDLConfigWidget::configuration() const
 {
-    KisFilterConfigurationSP config = new KisFilterConfiguration("asc-cdl", 0, KisGlobalResourcesInterface::instance());
+    // a KisColorTransformationConfiguration is needed here so that the
+    // filter can reuse its cached per-thread color transformations
+    KisFilterConfigurationSP config = new KisColorTransformationConfiguration("asc-cdl", 0, KisGlobalResourcesInterface::instance());
     QVariant colorVariant("KoColor");
     colorVariant.setValue(m_page->btnSlope->color());
     config->setProperty("slope", colorVariant);
@@ -110,7 +110,12 @@ QRect KisBlurFilter::neededRect(const QRect & rect, const KisFilterConfiguration
     const int halfWidth = t.scale(_config->getProperty("halfWidth", value) ? value.toUInt() : 5);
     const int halfHeight = t.scale(_config->getProperty("halfHeight", value) ? value.toUInt() : 5);
 
-    return rect.adjusted(-halfWidth * 2, -halfHeight * 2, halfWidth * 2, halfHeight * 2);
+    /**
+     * The kernel matrix is always (2 * halfWidth + 1) x (2 * halfHeight + 1)
+     * (rotation is sampled inside the same matrix), so the convolution
+     * reads exactly the kernel's half size beyond the processed rect
+     */
+    return rect.adjusted(-halfWidth, -halfHeight, halfWidth, halfHeight);
 }
 
 QRect KisBlurFilter::changedRect(const QRect & rect, const KisFilterConfigurationSP _config, int lod) const
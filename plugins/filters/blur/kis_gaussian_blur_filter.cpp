@@ -48,6 +48,7 @@ KisFilterConfigurationSP KisGaussianBlurFilter::defaultConfiguration(KisResource
     config->setProperty("horizRadius", 5);
     config->setProperty("vertRadius", 5);
     config->setProperty("lockAspect", true);
+    config->setProperty("fastMode", false);
 
     return config;
 }
@@ -75,9 +76,15 @@ void KisGaussianBlurFilter::processImpl(KisPaintDeviceSP device,
         channelFlags = QBitArray(device->colorSpace()->channelCount(), true);
     }
 
-    KisGaussianKernel::applyGaussian(device, rect,
-                                     horizontalRadius, verticalRadius,
-                                     channelFlags, progressUpdater);
+    if (config->getBool("fastMode", false)) {
+        KisGaussianKernel::applyGaussianCascade(device, rect,
+                                                horizontalRadius, verticalRadius,
+                                                channelFlags, progressUpdater);
+    } else {
+        KisGaussianKernel::applyGaussian(device, rect,
+                                         horizontalRadius, verticalRadius,
+                                         channelFlags, progressUpdater);
+    }
 }
 
 QRect KisGaussianBlurFilter::neededRect(const QRect & rect, const KisFilterConfigurationSP _config, int lod) const
@@ -85,6 +92,14 @@ QRect KisGaussianBlurFilter::neededRect(const QRect & rect, const KisFilterConfi
     KisLodTransformScalar t(lod);
 
     QVariant value;
+
+    if (_config->getBool("fastMode", false)) {
+        const int haloWidth = _config->getProperty("horizRadius", value) ? KisGaussianKernel::boxBlurHaloFromRadius(t.scale(value.toFloat())) : 5;
+        const int haloHeight = _config->getProperty("vertRadius", value) ? KisGaussianKernel::boxBlurHaloFromRadius(t.scale(value.toFloat())) : 5;
+
+        return rect.adjusted(-haloWidth, -haloHeight, haloWidth, haloHeight);
+    }
+
     /**
      * NOTE: integer division by two is done on purpose,
      *       because the kernel size is always odd
@@ -92,7 +107,13 @@ QRect KisGaussianBlurFilter::neededRect(const QRect & rect, const KisFilterConfi
     const int halfWidth = _config->getProperty("horizRadius", value) ? KisGaussianKernel::kernelSizeFromRadius(t.scale(value.toFloat())) / 2 : 5;
     const int halfHeight = _config->getProperty("vertRadius", value) ? KisGaussianKernel::kernelSizeFromRadius(t.scale(value.toFloat())) / 2 : 5;
 
-    return rect.adjusted(-halfWidth * 2, -halfHeight * 2, halfWidth * 2, halfHeight * 2);
+    /**
+     * The separable implementation blurs the rows of the intermediate
+     * device ceil(kernelHeight / 2.0) == halfHeight + 1 pixels above and
+     * below the processed rect, and the horizontal pass reads halfWidth
+     * pixels of the source around them. The FFTW path reads even less.
+     */
+    return rect.adjusted(-halfWidth, -(halfHeight + 1), halfWidth, halfHeight + 1);
 }
 
 QRect KisGaussianBlurFilter::changedRect(const QRect & rect, const KisFilterConfigurationSP _config, int lod) const
@@ -101,6 +122,13 @@ QRect KisGaussianBlurFilter::changedRect(const QRect & rect, const KisFilterConf
 
     QVariant value;
 
+    if (_config->getBool("fastMode", false)) {
+        const int haloWidth = _config->getProperty("horizRadius", value) ? KisGaussianKernel::boxBlurHaloFromRadius(t.scale(value.toFloat())) : 5;
+        const int haloHeight = _config->getProperty("vertRadius", value) ? KisGaussianKernel::boxBlurHaloFromRadius(t.scale(value.toFloat())) : 5;
+
+        return rect.adjusted(-haloWidth, -haloHeight, haloWidth, haloHeight);
+    }
+
     const int halfWidth = _config->getProperty("horizRadius", value) ? KisGaussianKernel::kernelSizeFromRadius(t.scale(value.toFloat())) / 2 : 5;
     const int halfHeight = _config->getProperty("vertRadius", value) ? KisGaussianKernel::kernelSizeFromRadius(t.scale(value.toFloat())) / 2 : 5;
 
@@ -175,7 +175,8 @@ QRect KisLensBlurFilter::neededRect(const QRect & rect, const KisFilterConfigura
     const int halfWidth = t.scale(_config->getProperty("halfWidth", value) ? value.toUInt() : 5);
     const int halfHeight = t.scale(_config->getProperty("halfHeight", value) ? value.toUInt() : 5);
 
-    return rect.adjusted(-halfWidth * 2, -halfHeight * 2, halfWidth * 2, halfHeight * 2);
+    // the iris kernel reads exactly its half size beyond the processed rect
+    return rect.adjusted(-halfWidth, -halfHeight, halfWidth, halfHeight);
 }
 
 QRect KisLensBlurFilter::changedRect(const QRect & rect, const KisFilterConfigurationSP _config, int lod) const
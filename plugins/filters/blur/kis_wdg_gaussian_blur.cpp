@@ -47,6 +47,9 @@ KisWdgGaussianBlur::KisWdgGaussianBlur(bool usedForMasks, QWidget * parent) : Ki
     connect(m_widget->aspectButton, SIGNAL(keepAspectRatioChanged(bool)), this, SLOT(aspectLockChanged(bool)));
     connect(m_widget->horizontalRadius, SIGNAL(valueChanged(qreal)), SIGNAL(sigConfigurationItemChanged()));
     connect(m_widget->verticalRadius, SIGNAL(valueChanged(qreal)), SIGNAL(sigConfigurationItemChanged()));
+
+    m_widget->fastModeCheckBox->setToolTip(i18n("Approximate the blur with a cascade of box blurs. Much faster for large radii, but the result is not a true gaussian."));
+    connect(m_widget->fastModeCheckBox, SIGNAL(toggled(bool)), SIGNAL(sigConfigurationItemChanged()));
 }
 
 KisWdgGaussianBlur::~KisWdgGaussianBlur()
@@ -60,6 +63,7 @@ KisPropertiesConfigurationSP KisWdgGaussianBlur::configuration() const
     config->setProperty("horizRadius", m_widget->horizontalRadius->value());
     config->setProperty("vertRadius", m_widget->verticalRadius->value());
     config->setProperty("lockAspect", m_widget->aspectButton->keepAspectRatio());
+    config->setProperty("fastMode", m_widget->fastModeCheckBox->isChecked());
     return config;
 }
 
@@ -75,6 +79,9 @@ void KisWdgGaussianBlur::setConfiguration(const KisPropertiesConfigurationSP con
     if (config->getProperty("lockAspect", value)) {
         m_widget->aspectButton->setKeepAspectRatio(value.toBool());
     }
+    if (config->getProperty("fastMode", value)) {
+        m_widget->fastModeCheckBox->setChecked(value.toBool());
+    }
 }
 
 void KisWdgGaussianBlur::horizontalRadiusChanged(qreal v)
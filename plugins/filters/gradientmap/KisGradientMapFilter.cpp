@@ -32,6 +32,8 @@ KisGradientMapFilter::KisGradientMapFilter()
     : KisFilter(id(), FiltersCategoryMapId, i18n("&Gradient Map..."))
 {
     setSupportsPainting(true);
+    // a pure per-pixel mapping, so the LoD preview is exact
+    setSupportsLevelOfDetail(true);
 }
 
 class BlendColorModePolicy
@@ -120,26 +122,26 @@ void KisGradientMapFilter::processImpl(KisPaintDeviceSP device,
 
     KIS_SAFE_ASSERT_RECOVER_RETURN(filterConfig);
 
-    KoAbstractGradientSP gradient = filterConfig->gradient();
     const int colorMode = filterConfig->colorMode();
     const KoColorSpace *colorSpace = device->colorSpace();
     const int cachedGradientSize = device->extent().width() + device->extent().height();
 
+    // The baked gradients are owned by the configuration, so that all the
+    // patches the stroke is split into share one lookup table instead of
+    // reparsing the gradient and reinterpolating its stops per patch
+
     if (colorMode == KisGradientMapFilterConfiguration::ColorMode_Blend) {
-        KoCachedGradient cachedGradient(gradient, cachedGradientSize, colorSpace);
-        BlendColorModePolicy colorModePolicy(&cachedGradient);
+        BlendColorModePolicy colorModePolicy(filterConfig->cachedBlendGradient(colorSpace, cachedGradientSize));
         processImpl(device, applyRect, config, progressUpdater, colorModePolicy);
 
     } else if (colorMode == KisGradientMapFilterConfiguration::ColorMode_Nearest) {
-        KisGradientMapFilterNearestCachedGradient cachedGradient(gradient, cachedGradientSize, colorSpace);
-        NearestColorModePolicy colorModePolicy(&cachedGradient);
+        NearestColorModePolicy colorModePolicy(filterConfig->cachedNearestGradient(colorSpace, cachedGradientSize));
         processImpl(device, applyRect, config, progressUpdater, colorModePolicy);
 
     } else /* if colorMode == KisGradientMapFilterConfiguration::ColorMode_Dither */ {
         KisDitherUtil ditherUtil;
-        KisGradientMapFilterDitherCachedGradient cachedGradient(gradient, cachedGradientSize, colorSpace);
         ditherUtil.setConfiguration(*filterConfig, "dither/");
-        DitherColorModePolicy colorModePolicy(&cachedGradient, &ditherUtil);
+        DitherColorModePolicy colorModePolicy(filterConfig->cachedDitherGradient(colorSpace, cachedGradientSize), &ditherUtil);
         processImpl(device, applyRect, config, progressUpdater, colorModePolicy);
     }
 }
@@ -122,6 +122,60 @@ int KisGradientMapFilterConfiguration::colorMode() const
     return getInt("colorMode", defaultColorMode());
 }
 
+const KoCachedGradient* KisGradientMapFilterConfiguration::cachedBlendGradient(const KoColorSpace *colorSpace, qint32 steps) const
+{
+    QMutexLocker locker(&m_cachedGradientsMutex);
+    invalidateCachedGradientsIfNeeded(colorSpace, steps);
+    if (!m_cachedBlendGradient) {
+        m_cachedBlendGradient.reset(new KoCachedGradient(gradient(), steps, colorSpace));
+    }
+    return m_cachedBlendGradient.data();
+}
+
+const KisGradientMapFilterNearestCachedGradient* KisGradientMapFilterConfiguration::cachedNearestGradient(const KoColorSpace *colorSpace, qint32 steps) const
+{
+    QMutexLocker locker(&m_cachedGradientsMutex);
+    invalidateCachedGradientsIfNeeded(colorSpace, steps);
+    if (!m_cachedNearestGradient) {
+        m_cachedNearestGradient.reset(new KisGradientMapFilterNearestCachedGradient(gradient(), steps, colorSpace));
+    }
+    return m_cachedNearestGradient.data();
+}
+
+const KisGradientMapFilterDitherCachedGradient* KisGradientMapFilterConfiguration::cachedDitherGradient(const KoColorSpace *colorSpace, qint32 steps) const
+{
+    QMutexLocker locker(&m_cachedGradientsMutex);
+    invalidateCachedGradientsIfNeeded(colorSpace, steps);
+    if (!m_cachedDitherGradient) {
+        m_cachedDitherGradient.reset(new KisGradientMapFilterDitherCachedGradient(gradient(), steps, colorSpace));
+    }
+    return m_cachedDitherGradient.data();
+}
+
+void KisGradientMapFilterConfiguration::invalidateCachedGradientsIfNeeded(const KoColorSpace *colorSpace, qint32 steps) const
+{
+    if (m_cachedGradientsColorSpace != colorSpace || m_cachedGradientsSteps != steps) {
+        m_cachedBlendGradient.reset();
+        m_cachedNearestGradient.reset();
+        m_cachedDitherGradient.reset();
+        m_cachedGradientsColorSpace = colorSpace;
+        m_cachedGradientsSteps = steps;
+    }
+}
+
+void KisGradientMapFilterConfiguration::setProperty(const QString &name, const QVariant &value)
+{
+    {
+        QMutexLocker locker(&m_cachedGradientsMutex);
+        m_cachedBlendGradient.reset();
+        m_cachedNearestGradient.reset();
+        m_cachedDitherGradient.reset();
+        m_cachedGradientsColorSpace = nullptr;
+        m_cachedGradientsSteps = 0;
+    }
+    KisFilterConfiguration::setProperty(name, value);
+}
+
 void KisGradientMapFilterConfiguration::setGradient(KoAbstractGradientSP newGradient)
 {
     if (!newGradient) {
@@ -10,12 +10,19 @@
 #ifndef KIS_GRADIENT_MAP_FILTER_CONFIGURATION_H
 #define KIS_GRADIENT_MAP_FILTER_CONFIGURATION_H
 
+#include <QMutex>
+#include <QSharedPointer>
+
 #include <kis_filter_configuration.h>
 #include <KisGradientConversion.h>
 #include <KisResourcesInterface.h>
 #include <KoColorSpaceRegistry.h>
 #include <KoAbstractGradient.h>
 #include <KoStopGradient.h>
+#include <KoCachedGradient.h>
+
+#include "KisGradientMapFilterNearestCachedGradient.h"
+#include "KisGradientMapFilterDitherCachedGradient.h"
 
 
 class KisGradientMapFilterConfiguration;
@@ -80,9 +87,34 @@ public:
     KoAbstractGradientSP gradient(KoAbstractGradientSP fallbackGradient = nullptr) const;
     int colorMode() const;
 
+    /**
+     * These return the gradient baked into a lookup table for the given
+     * color space and number of steps, one flavor per color mode. The
+     * baked gradient is built lazily on first use and then shared between
+     * all the patches the filter is split into, instead of reparsing the
+     * gradient and reinterpolating its stops once per patch. The cache is
+     * dropped whenever a property changes, in the same way
+     * KisColorTransformationConfiguration drops its color transformations.
+     */
+    const KoCachedGradient* cachedBlendGradient(const KoColorSpace *colorSpace, qint32 steps) const;
+    const KisGradientMapFilterNearestCachedGradient* cachedNearestGradient(const KoColorSpace *colorSpace, qint32 steps) const;
+    const KisGradientMapFilterDitherCachedGradient* cachedDitherGradient(const KoColorSpace *colorSpace, qint32 steps) const;
+
+    void setProperty(const QString &name, const QVariant &value) override;
+
     void setGradient(KoAbstractGradientSP newGradient);
     void setColorMode(int newColorMode);
     void setDefaults();
+
+private:
+    void invalidateCachedGradientsIfNeeded(const KoColorSpace *colorSpace, qint32 steps) const;
+
+    mutable QMutex m_cachedGradientsMutex;
+    mutable QSharedPointer<KoCachedGradient> m_cachedBlendGradient;
+    mutable QSharedPointer<KisGradientMapFilterNearestCachedGradient> m_cachedNearestGradient;
+    mutable QSharedPointer<KisGradientMapFilterDitherCachedGradient> m_cachedDitherGradient;
+    mutable const KoColorSpace *m_cachedGradientsColorSpace {nullptr};
+    mutable qint32 m_cachedGradientsSteps {0};
 };
 
 #endif
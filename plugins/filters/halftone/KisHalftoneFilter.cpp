@@ -216,16 +216,17 @@ void KisHalftoneFilter::processIntensity(KisPaintDeviceSP device,
 
     {
         const bool invert = config->invert(prefix);
+        const KoColorSpace *deviceColorSpace = device->colorSpace();
 
         KisSequentialIterator maskIterator(maskDevice->pixelSelection(), applyRect);
-        KisSequentialIterator dstIterator(device, applyRect);
-        KisSequentialIterator srcIterator(generatorDevice, applyRect);
+        KisSequentialConstIterator dstIterator(device, applyRect);
+        KisSequentialConstIterator srcIterator(generatorDevice, applyRect);
 
         if (!invert) {
             while (maskIterator.nextPixel() && dstIterator.nextPixel() && srcIterator.nextPixel()) {
-                int dstGray = device->colorSpace()->intensity8(dstIterator.rawData());
-                int srcGray = srcIterator.rawData()[0];
-                int srcAlpha = srcIterator.rawData()[1];
+                int dstGray = deviceColorSpace->intensity8(dstIterator.rawDataConst());
+                int srcGray = srcIterator.rawDataConst()[0];
+                int srcAlpha = srcIterator.rawDataConst()[1];
 
                 // Combine pixels
                 int result = qBound(0, dstGray + (srcGray - 128) * noiseWeightLut[dstGray] * srcAlpha / 0xFE01, 255);
@@ -237,9 +238,9 @@ void KisHalftoneFilter::processIntensity(KisPaintDeviceSP device,
             }
         } else {
             while (maskIterator.nextPixel() && dstIterator.nextPixel() && srcIterator.nextPixel()) {
-                int dstGray = device->colorSpace()->intensity8(dstIterator.rawData());
-                int srcGray = srcIterator.rawData()[0];
-                int srcAlpha = srcIterator.rawData()[1];
+                int dstGray = deviceColorSpace->intensity8(dstIterator.rawDataConst());
+                int srcGray = srcIterator.rawDataConst()[0];
+                int srcAlpha = srcIterator.rawDataConst()[1];
 
                 // Combine pixels
                 int result = qBound(0, dstGray + (srcGray - 128) * noiseWeightLut[dstGray] * srcAlpha / 0xFE01, 255);
@@ -325,19 +326,31 @@ void KisHalftoneFilter::processChannel(KisPaintDeviceSP device,
     // Fill the device
     const bool invert = config->invert(prefix);
     KisSequentialIterator dstIterator(device, applyRect);
-    KisSequentialIterator srcIterator(generatorDevice, applyRect);
+    KisSequentialConstIterator srcIterator(generatorDevice, applyRect);
 
     const KoColorSpace *colorSpace = device->colorSpace();
+    const ChannelType channelMin = static_cast<ChannelType>(channelInfo->getUIMin());
+    const ChannelType channelMax = static_cast<ChannelType>(channelInfo->getUIMax());
 
     if (colorSpace->profile()->isLinear()) {
+        // The generator pixels must pass through the linear color space
+        // before being combined. The conversion of the gray value and of
+        // the alpha value are independent of each other, so a pair of
+        // 256 entry tables replaces the per-pixel KoColor round trip
+        QVector<quint8> srcGrayLut(256);
+        QVector<quint8> srcAlphaLut(256);
+        const int alphaPos = colorSpace->alphaPos();
+        for (int i = 0; i < 256; ++i) {
+            KoColor c(QColor(i, i, i, i), colorSpace);
+            srcGrayLut[i] = colorSpace->scaleToU8(c.data(), 0);
+            srcAlphaLut[i] = colorSpace->scaleToU8(c.data(), alphaPos);
+        }
+
         if (!invert) {
             while (dstIterator.nextPixel() && srcIterator.nextPixel()) {
-                int dst = 255 - device->colorSpace()->scaleToU8(dstIterator.rawData(), channelPos);
-                int src = srcIterator.rawData()[0];
-                int srcAlpha = srcIterator.rawData()[1];
-                KoColor c(QColor(src, src, src, srcAlpha), device->colorSpace());
-                src = device->colorSpace()->scaleToU8(c.data(), 0);
-                srcAlpha = device->colorSpace()->scaleToU8(c.data(), device->colorSpace()->alphaPos());
+                int dst = 255 - colorSpace->scaleToU8(dstIterator.rawData(), channelPos);
+                int src = srcGrayLut[srcIterator.rawDataConst()[0]];
+                int srcAlpha = srcAlphaLut[srcIterator.rawDataConst()[1]];
 
                 // Combine pixels
                 int result = qBound(0, dst + (src - 128) * noiseWeightLut[dst] * srcAlpha / 0xFE01, 255);
@@ -346,18 +359,13 @@ void KisHalftoneFilter::processChannel(KisPaintDeviceSP device,
                 result = hardnessLut[result];
 
                 ChannelType *dstPixel = reinterpret_cast<ChannelType*>(dstIterator.rawData());
-                ChannelType channelMin = static_cast<ChannelType>(channelInfo->getUIMin());
-                ChannelType channelMax = static_cast<ChannelType>(channelInfo->getUIMax());
                 dstPixel[channelPos] = static_cast<ChannelType>(mapU8ToRange(255 - result, channelMin, channelMax));
             }
         } else {
             while (dstIterator.nextPixel() && srcIterator.nextPixel()) {
-                int dst = device->colorSpace()->scaleToU8(dstIterator.rawData(), channelPos);
-                int src = srcIterator.rawData()[0];
-                int srcAlpha = srcIterator.rawData()[1];
-                KoColor c(QColor(src, src, src, srcAlpha), device->colorSpace());
-                src = device->colorSpace()->scaleToU8(c.data(), 0);
-                srcAlpha = device->colorSpace()->scaleToU8(c.data(), device->colorSpace()->alphaPos());
+                int dst = colorSpace->scaleToU8(dstIterator.rawData(), channelPos);
+                int src = srcGrayLut[srcIterator.rawDataConst()[0]];
+                int srcAlpha = srcAlphaLut[srcIterator.rawDataConst()[1]];
 
                 // Combine pixels
                 int result = qBound(0, dst + (src - 128) * noiseWeightLut[dst] * srcAlpha / 0xFE01, 255);
@@ -366,17 +374,15 @@ void KisHalftoneFilter::processChannel(KisPaintDeviceSP device,
                 result = hardnessLut[result];
 
                 ChannelType *dstPixel = reinterpret_cast<ChannelType*>(dstIterator.rawData());
-                ChannelType channelMin = static_cast<ChannelType>(channelInfo->getUIMin());
-                ChannelType channelMax = static_cast<ChannelType>(channelInfo->getUIMax());
                 dstPixel[channelPos] = static_cast<ChannelType>(mapU8ToRange(result, channelMin, channelMax));
             }
         }
     } else {
         if (!invert) {
             while (dstIterator.nextPixel() && srcIterator.nextPixel()) {
-                int dst = 255 - device->colorSpace()->scaleToU8(dstIterator.rawData(), channelPos);
-                int src = srcIterator.rawData()[0];
-                int srcAlpha = srcIterator.rawData()[1];
+                int dst = 255 - colorSpace->scaleToU8(dstIterator.rawData(), channelPos);
+                int src = srcIterator.rawDataConst()[0];
+                int srcAlpha = srcIterator.rawDataConst()[1];
 
                 // Combine pixels
                 int result = qBound(0, dst + (src - 128) * noiseWeightLut[dst] * srcAlpha / 0xFE01, 255);
@@ -385,15 +391,13 @@ void KisHalftoneFilter::processChannel(KisPaintDeviceSP device,
                 result = hardnessLut[result];
 
                 ChannelType *dstPixel = reinterpret_cast<ChannelType*>(dstIterator.rawData());
-                ChannelType channelMin = static_cast<ChannelType>(channelInfo->getUIMin());
-                ChannelType channelMax = static_cast<ChannelType>(channelInfo->getUIMax());
                 dstPixel[channelPos] = static_cast<ChannelType>(mapU8ToRange(255 - result, channelMin, channelMax));
             }
         } else {
             while (dstIterator.nextPixel() && srcIterator.nextPixel()) {
-                int dst = device->colorSpace()->scaleToU8(dstIterator.rawData(), channelPos);
-                int src = srcIterator.rawData()[0];
-                int srcAlpha = srcIterator.rawData()[1];
+                int dst = colorSpace->scaleToU8(dstIterator.rawData(), channelPos);
+                int src = srcIterator.rawDataConst()[0];
+                int srcAlpha = srcIterator.rawDataConst()[1];
 
                 // Combine pixels
                 int result = qBound(0, dst + (src - 128) * noiseWeightLut[dst] * srcAlpha / 0xFE01, 255);
@@ -402,8 +406,6 @@ void KisHalftoneFilter::processChannel(KisPaintDeviceSP device,
                 result = hardnessLut[result];
 
                 ChannelType *dstPixel = reinterpret_cast<ChannelType*>(dstIterator.rawData());
-                ChannelType channelMin = static_cast<ChannelType>(channelInfo->getUIMin());
-                ChannelType channelMax = static_cast<ChannelType>(channelInfo->getUIMax());
                 dstPixel[channelPos] = static_cast<ChannelType>(mapU8ToRange(result, channelMin, channelMax));
             }
         }
@@ -522,14 +524,15 @@ void KisHalftoneFilter::processAlpha(KisPaintDeviceSP device,
 
     // Fill the device
     const bool invert = config->invert(prefix);
+    const KoColorSpace *colorSpace = device->colorSpace();
     KisSequentialIterator dstIterator(device, applyRect);
-    KisSequentialIterator srcIterator(generatorDevice, applyRect);
+    KisSequentialConstIterator srcIterator(generatorDevice, applyRect);
 
     if (!invert) {
         while (dstIterator.nextPixel() && srcIterator.nextPixel()) {
-            int dst = 255 - device->colorSpace()->opacityU8(dstIterator.rawData());
-            int src = srcIterator.rawData()[0];
-            int srcAlpha = srcIterator.rawData()[1];
+            int dst = 255 - colorSpace->opacityU8(dstIterator.rawData());
+            int src = srcIterator.rawDataConst()[0];
+            int srcAlpha = srcIterator.rawDataConst()[1];
 
             // Combine pixels
             int result = qBound(0, dst + (src - 128) * noiseWeightLut[dst] * srcAlpha / 0xFE01, 255);
@@ -537,13 +540,13 @@ void KisHalftoneFilter::processAlpha(KisPaintDeviceSP device,
             // Apply hardness
             result = hardnessLut[result];
 
-            device->colorSpace()->setOpacity(dstIterator.rawData(), static_cast<quint8>(255 - result), 1);
+            colorSpace->setOpacity(dstIterator.rawData(), static_cast<quint8>(255 - result), 1);
         }
     } else {
         while (dstIterator.nextPixel() && srcIterator.nextPixel()) {
-            int dst = device->colorSpace()->opacityU8(dstIterator.rawData());
-            int src = srcIterator.rawData()[0];
-            int srcAlpha = srcIterator.rawData()[1];
+            int dst = colorSpace->opacityU8(dstIterator.rawData());
+            int src = srcIterator.rawDataConst()[0];
+            int srcAlpha = srcIterator.rawDataConst()[1];
 
             // Combine pixels
             int result = qBound(0, dst + (src - 128) * noiseWeightLut[dst] * srcAlpha / 0xFE01, 255);
@@ -551,7 +554,7 @@ void KisHalftoneFilter::processAlpha(KisPaintDeviceSP device,
             // Apply hardness
             result = hardnessLut[result];
 
-            device->colorSpace()->setOpacity(dstIterator.rawData(), static_cast<quint8>(result), 1);
+            colorSpace->setOpacity(dstIterator.rawData(), static_cast<quint8>(result), 1);
         }
     }
     m_grayDevicesCache.putDevice(generatorDevice);
@@ -589,12 +592,12 @@ void KisHalftoneFilter::processMask(KisPaintDeviceSP device,
     // Fill the device
     const bool invert = config->invert(prefix);
     KisSequentialIterator dstIterator(device, applyRect);
-    KisSequentialIterator srcIterator(generatorDevice, applyRect);
+    KisSequentialConstIterator srcIterator(generatorDevice, applyRect);
 
     if (!invert) {
         while (dstIterator.nextPixel() && srcIterator.nextPixel()) {
             int dst = 255 - *dstIterator.rawData();
-            int src = *srcIterator.rawData();
+            int src = *srcIterator.rawDataConst();
 
             // Combine pixels
             int result = qBound(0, dst + (src - 128) * noiseWeightLut[dst] / 0xFF, 255);
@@ -607,7 +610,7 @@ void KisHalftoneFilter::processMask(KisPaintDeviceSP device,
     } else {
         while (dstIterator.nextPixel() && srcIterator.nextPixel()) {
             int dst = *dstIterator.rawData();
-            int src = *srcIterator.rawData();
+            int src = *srcIterator.rawDataConst();
 
             // Combine pixels
             int result = qBound(0, dst + (src - 128) * noiseWeightLut[dst] / 0xFF, 255);
@@ -9,6 +9,7 @@
 
 
 #include <cmath>
+#include <cstring>
 
 #include <KoUpdater.h>
 
@@ -32,6 +33,41 @@ KisWaveletNoiseReduction::KisWaveletNoiseReduction()
 
 KisWaveletNoiseReduction::~KisWaveletNoiseReduction()
 {
+    qDeleteAll(m_waveletBuffers);
+}
+
+KisMathToolbox::KisWavelet* KisWaveletNoiseReduction::takeWaveletBuffer(uint size, uint depth) const
+{
+    {
+        QMutexLocker locker(&m_waveletBuffersMutex);
+        for (int i = 0; i < m_waveletBuffers.size(); ++i) {
+            KisMathToolbox::KisWavelet *wavelet = m_waveletBuffers[i];
+            if (wavelet->size == size && wavelet->depth == depth) {
+                m_waveletBuffers.removeAt(i);
+                memset(wavelet->coeffs, 0, size * size * depth * sizeof(float));
+                return wavelet;
+            }
+        }
+    }
+    return new KisMathToolbox::KisWavelet(size, depth);
+}
+
+void KisWaveletNoiseReduction::putWaveletBuffer(KisMathToolbox::KisWavelet *wavelet) const
+{
+    QMutexLocker locker(&m_waveletBuffersMutex);
+
+    // only buffers of the most recently used size are worth keeping around
+    for (int i = m_waveletBuffers.size() - 1; i >= 0; --i) {
+        if (m_waveletBuffers[i]->size != wavelet->size || m_waveletBuffers[i]->depth != wavelet->depth) {
+            delete m_waveletBuffers.takeAt(i);
+        }
+    }
+
+    if (m_waveletBuffers.size() >= 2) {
+        delete wavelet;
+        return;
+    }
+    m_waveletBuffers.append(wavelet);
 }
 
 KisConfigWidget * KisWaveletNoiseReduction::createConfigurationWidget(QWidget* parent, const KisPaintDeviceSP, bool) const
@@ -64,21 +100,22 @@ void KisWaveletNoiseReduction::processImpl(KisPaintDeviceSP device,
     //     dbgFilters << size <<"" << maxrectsize <<"" << srcTopLeft.x() <<"" << srcTopLeft.y();
 
     //     dbgFilters <<"Transforming...";
+    int waveletSize;
+    const int maxrectsize = qMax(applyRect.width(), applyRect.height());
+    for (waveletSize = 2; waveletSize < maxrectsize; waveletSize *= 2) ;
+    const qint32 depth = device->colorSpace()->colorChannelCount();
+
     KisMathToolbox::KisWavelet* buff = 0;
     KisMathToolbox::KisWavelet* wav = 0;
 
     try {
-        buff = mathToolbox.initWavelet(device, applyRect);
+        buff = takeWaveletBuffer(waveletSize, depth);
+        wav = takeWaveletBuffer(waveletSize, depth);
     } catch (const std::bad_alloc&) {
         if (buff) delete buff;
         return;
     }
-    try {
-        wav = mathToolbox.fastWaveletTransformation(device, applyRect, buff);
-    } catch (const std::bad_alloc&) {
-        if (wav) delete wav;
-        return;
-    }
+    mathToolbox.fastWaveletTransformation(device, applyRect, buff, wav);
 
     float* const fin = wav->coeffs + wav->depth * pow2(wav->size);
     float* const begin = wav->coeffs + wav->depth;
@@ -108,6 +145,6 @@ void KisWaveletNoiseReduction::processImpl(KisPaintDeviceSP device,
 
     mathToolbox.fastWaveletUntransformation(device, applyRect, wav, buff);
 
-    delete wav;
-    delete buff;
+    putWaveletBuffer(wav);
+    putWaveletBuffer(buff);
 }
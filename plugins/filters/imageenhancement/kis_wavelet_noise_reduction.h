@@ -10,7 +10,11 @@
 
 #include <vector>
 
+#include <QMutex>
+#include <QVector>
+
 #include <filter/kis_filter.h>
+#include <kis_math_toolbox.h>
 
 #define BEST_WAVELET_THRESHOLD_VALUE 7.0
 
@@ -39,6 +43,22 @@ public:
 
 private:
     KisFilterConfigurationSP  defaultConfiguration(KisResourcesInterfaceSP resourcesInterface) const override;
+
+    KisMathToolbox::KisWavelet* takeWaveletBuffer(uint size, uint depth) const;
+    void putWaveletBuffer(KisMathToolbox::KisWavelet *wavelet) const;
+
+    /**
+     * The wavelet planes for a typically sized image weigh hundreds of
+     * megabytes, and allocating and zero-filling them again on every
+     * invocation is a large constant cost when the filter is reapplied
+     * while tuning the threshold. The last used pair of planes is
+     * pooled here, in the same spirit as KisCachedPaintDevice. The
+     * decomposition itself cannot be cached across invocations because
+     * the filter is handed a fresh device every time, so there is
+     * nothing stable to key the coefficients on.
+     */
+    mutable QMutex m_waveletBuffersMutex;
+    mutable QVector<KisMathToolbox::KisWavelet*> m_waveletBuffers;
 };
 
 #endif
@@ -26,6 +26,7 @@ KisLevelsFilterConfiguration::KisLevelsFilterConfiguration(int channelCount, Kis
 
 KisLevelsFilterConfiguration::KisLevelsFilterConfiguration(const KisLevelsFilterConfiguration &rhs)
     : KisColorTransformationConfiguration(rhs)
+    , m_levelsCurves(rhs.m_levelsCurves)
     , m_transfers(rhs.m_transfers)
     , m_lightnessTransfer(rhs.m_lightnessTransfer)
 {}
@@ -40,14 +41,9 @@ bool KisLevelsFilterConfiguration::isCompatible(const KisPaintDeviceSP dev) cons
     return useLightnessMode() || (int)dev->compositionSourceColorSpace()->channelCount() == channelCount();
 }
 
-const QVector<KisLevelsCurve> KisLevelsFilterConfiguration::levelsCurves() const
+const QVector<KisLevelsCurve>& KisLevelsFilterConfiguration::levelsCurves() const
 {
-    QVector<KisLevelsCurve> levelsCurves_;
-    for (qint32 i = 0; i < channelCount(); ++i) {
-        const QString levelsCurveStr = getString(QString("channel_") + KisDomUtils::toString(i), "");
-        levelsCurves_.append(levelsCurveStr.isEmpty() ? KisLevelsCurve() : KisLevelsCurve(levelsCurveStr));
-    }
-    return levelsCurves_;
+    return m_levelsCurves;
 }
 
 const KisLevelsCurve KisLevelsFilterConfiguration::lightnessLevelsCurve() const
@@ -62,7 +58,6 @@ void KisLevelsFilterConfiguration::setLevelsCurves(const QVector<KisLevelsCurve>
         setProperty(QString("channel_") + KisDomUtils::toString(i), newLevelsCurves[i].toString());
     }
     setChannelCount(newLevelsCurves.size());
-    updateTransfers();
 }
 
 void KisLevelsFilterConfiguration::setLightnessLevelsCurve(const KisLevelsCurve &newLightnessLevelsCurve)
@@ -70,12 +65,17 @@ void KisLevelsFilterConfiguration::setLightnessLevelsCurve(const KisLevelsCurve
     setProperty("lightness", newLightnessLevelsCurve.toString());
 }
 
+void KisLevelsFilterConfiguration::updateTransfer(int index)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(index >= 0 && index < m_levelsCurves.size());
+    m_transfers[index] = m_levelsCurves[index].uint16Transfer();
+}
+
 void KisLevelsFilterConfiguration::updateTransfers()
 {
-    const QVector<KisLevelsCurve> lc = levelsCurves();
-    m_transfers.resize(lc.size());
-    for (int i = 0; i < lc.size(); i++) {
-        m_transfers[i] = lc[i].uint16Transfer();
+    m_transfers.resize(m_levelsCurves.size());
+    for (int i = 0; i < m_levelsCurves.size(); i++) {
+        m_transfers[i] = m_levelsCurves[i].uint16Transfer();
     }
 }
 
@@ -178,6 +178,8 @@ void KisLevelsFilterConfiguration::setLegacyValuesFromLightnessLevelsCurve()
  * version 2) then the legacy properties are copied to the new and
  * compact "lightness" property. Conversely, if the "lightness" property
  * is set, its values are copied to the legacy properties.
+ * Only the lut of the changed channel is recomputed, the cached curves
+ * and luts of the other channels are reused.
  */
 void KisLevelsFilterConfiguration::setProperty(const QString &name, const QVariant &value)
 {
@@ -190,8 +192,28 @@ void KisLevelsFilterConfiguration::setProperty(const QString &name, const QVaria
                name == "outblackvalue" || name == "outwhitevalue") {
         setLightessLevelsCurveFromLegacyValues();
         updateLightnessTransfer();
-    } else if (QRegularExpression("channel_\\d+").match(name).hasMatch()) {
-        updateTransfers();
+    } else if (name == "number_of_channels") {
+        const int newChannelCount = value.toInt();
+        const int oldChannelCount = m_levelsCurves.size();
+        m_levelsCurves.resize(newChannelCount);
+        m_transfers.resize(newChannelCount);
+        for (int i = oldChannelCount; i < newChannelCount; ++i) {
+            updateTransfer(i);
+        }
+    } else {
+        const QRegularExpressionMatch match = QRegularExpression("channel_(\\d+)").match(name);
+        if (match.hasMatch()) {
+            const int index = match.captured(1).toInt();
+            if (index >= m_levelsCurves.size()) {
+                // the channel count property is updated after the
+                // channel properties in setLevelsCurves
+                m_levelsCurves.resize(index + 1);
+                m_transfers.resize(index + 1);
+            }
+            const QString levelsCurveStr = value.toString();
+            m_levelsCurves[index] = levelsCurveStr.isEmpty() ? KisLevelsCurve() : KisLevelsCurve(levelsCurveStr);
+            updateTransfer(index);
+        }
     }
 }
 
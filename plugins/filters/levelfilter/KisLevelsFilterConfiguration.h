@@ -38,7 +38,7 @@ public:
 
     void setProperty(const QString &name, const QVariant &value) override;
 
-    const QVector<KisLevelsCurve> levelsCurves() const;
+    const QVector<KisLevelsCurve>& levelsCurves() const;
     const KisLevelsCurve lightnessLevelsCurve() const;
     void setLevelsCurves(const QVector<KisLevelsCurve> &newLevelsCurves);
     void setLightnessLevelsCurve(const KisLevelsCurve &newLightnessLevelsCurve);
@@ -55,6 +55,13 @@ public:
     void setDefaults();
 
 private:
+    /**
+     * The parsed curves and the transfer luts are cached here so that a
+     * change to a single channel property only reparses and recomputes
+     * the lut of that channel, instead of rebuilding everything from
+     * the property strings on every slider tick
+     */
+    QVector<KisLevelsCurve> m_levelsCurves;
     QVector<QVector<quint16>> m_transfers;
     QVector<quint16> m_lightnessTransfer;
 
@@ -64,6 +71,7 @@ private:
     void setLightessLevelsCurveFromLegacyValues();
     void setLegacyValuesFromLightnessLevelsCurve();
 
+    void updateTransfer(int index);
     void updateTransfers();
     void updateLightnessTransfer();
 };
@@ -29,6 +29,7 @@
 #include <KisDocument.h>
 #include <kis_image.h>
 #include <KisSequentialIteratorProgress.h>
+#include <kis_iterator_ng.h>
 #include <kis_layer.h>
 #include <filter/kis_filter_registry.h>
 #include <kis_global.h>
@@ -44,7 +45,7 @@
 KisOilPaintFilter::KisOilPaintFilter() : KisFilter(id(), FiltersCategoryArtisticId, i18n("&Oilpaint..."))
 {
     setSupportsPainting(true);
-    setSupportsThreading(false);
+    setSupportsThreading(true);
     setSupportsAdjustmentLayers(true);
 }
 
@@ -60,129 +61,183 @@ void KisOilPaintFilter::processImpl(KisPaintDeviceSP device,
     const quint32 brushSize = config ? config->getInt("brushSize", 1) : 1;
     const quint32 smooth = config ? config->getInt("smooth", 30) : 30;
 
-    OilPaint(device, device, applyRect, brushSize, smooth, progressUpdater);
+    /**
+     * The filter samples a brush-sized neighborhood around every pixel,
+     * so it must read from an unmodified snapshot of the source. That
+     * also makes the patches independent of each other, which lets the
+     * filter run multithreaded.
+     */
+    const QRect srcRect = applyRect.adjusted(-brushSize, -brushSize, brushSize, brushSize);
+    KisPaintDeviceSP srcDev = new KisPaintDevice(device->colorSpace());
+    srcDev->prepareClone(device);
+    srcDev->makeCloneFromRough(device, srcRect);
+
+    OilPaint(srcDev, device, applyRect, brushSize, smooth, progressUpdater);
 }
 
-// This method have been ported from Pieter Z. Voloshyn algorithm code.
+// The algorithm itself has been ported from Pieter Z. Voloshyn's code in Digikam.
 
 /* Function to apply the OilPaint effect.
  *
- * data             => The image data in RGBA mode.
- * w                => Width of image.
- * h                => Height of image.
- * BrushSize        => Brush size.
+ * src              => An unmodified snapshot of the source data.
+ * dst              => The destination device.
+ * applyRect        => The rect to be processed.
+ * BrushSize        => Brush size (the neighborhood radius).
  * Smoothness       => Smooth value.
  *
- * Theory           => Using MostFrequentColor function we take the main color in
- *                     a matrix and simply write at the original position.
+ * Theory           => For every pixel the neighborhood is bucketed into an
+ *                     intensity histogram and the pixel is replaced with the
+ *                     average color of the most frequent bucket.
+ *
+ *                     Instead of rescanning the whole neighborhood for every
+ *                     pixel, the histogram slides along the scanline: when
+ *                     moving one pixel to the right the leftmost column of
+ *                     the window is removed and one new column is added, so
+ *                     the cost per pixel is O(radius) instead of O(radius^2).
+ *                     The rows of the window are decoded into normalised
+ *                     channel values once, when they enter the window.
  */
 
 void KisOilPaintFilter::OilPaint(const KisPaintDeviceSP src, KisPaintDeviceSP dst, const QRect &applyRect,
                                  int BrushSize, int Smoothness, KoUpdater* progressUpdater) const
 {
-    KisSequentialConstIteratorProgress it(src, applyRect, progressUpdater);
-    KisSequentialIterator dstIt(dst, applyRect);
-
-    while (it.nextPixel() && dstIt.nextPixel()) {
-        MostFrequentColor(src, dstIt.rawData(), applyRect, it.x(), it.y(), BrushSize, Smoothness);
-    }
-}
-
-// This method has been ported from Pieter Z. Voloshyn's algorithm code in Digikam.
-
-/* Function to determine the most frequent color in a matrix
- *
- * Bits             => Bits array
- * Width            => Image width
- * Height           => Image height
- * X                => Position horizontal
- * Y                => Position vertical
- * Radius           => Is the radius of the matrix to be analyzed
- * Intensity        => Intensity to calculate
- *
- * Theory           => This function creates a matrix with the analyzed pixel in
- *                     the center of this matrix and find the most frequent color
- */
-
-void KisOilPaintFilter::MostFrequentColor(KisPaintDeviceSP src, quint8* dst, const QRect& /*bounds*/, int X, int Y, int Radius, int Intensity) const
-{
-    uint I;
-
-    double Scale = Intensity / 255.0;
-
-    // Alloc some arrays to be used
-    uchar *IntensityCount = new uchar[(Intensity + 1)];
-
-    const KoColorSpace* cs = src->colorSpace();
-
-    QVector<float> channel(cs->channelCount());
-    QVector<float>* AverageChannels = new QVector<float>[(Intensity + 1)];
-
-    // Erase the array
-    memset(IntensityCount, 0, (Intensity + 1) * sizeof(uchar));
-
-    int startx = X - Radius;
-    int starty = Y - Radius;
-    int width = (2 * Radius) + 1;
-    int height = (2 * Radius) + 1;
-
-    qreal middlePointAlpha = 1;
-    {
-        // if the current pixel is transparent, the result must be transparent, too.
-        KisSequentialConstIterator middlePointIt(src, QRect(X, Y, 1, 1));
-        middlePointIt.nextPixel();
-        middlePointAlpha = cs->opacityF(middlePointIt.oldRawData());
-    }
-
+    const KoColorSpace *cs = src->colorSpace();
+    const int channelCount = cs->channelCount();
+    const int pixelSize = cs->pixelSize();
+
+    const int radius = BrushSize;
+    const int windowSize = 2 * radius + 1;
+    const int numBins = Smoothness + 1;
+    const double scale = Smoothness / 255.0;
+
+    // The cached rows cover the window of the whole scanline
+    const int cacheWidth = applyRect.width() + 2 * radius;
+
+    QVector<quint8> binCache(windowSize * cacheWidth);
+    QVector<quint8> usableCache(windowSize * cacheWidth);
+    QVector<float> channelCache(windowSize * cacheWidth * channelCount);
+    QVector<float> alphaCache(windowSize * cacheWidth);
+
+    QVector<int> counts(numBins);
+    QVector<float> sums(numBins * channelCount);
+    QVector<float> channel(channelCount);
+
+    // Decodes one source row into the given cache slot
+    const auto decodeRow = [&] (int row, int slot) {
+        quint8 *bins = binCache.data() + slot * cacheWidth;
+        quint8 *usable = usableCache.data() + slot * cacheWidth;
+        float *channels = channelCache.data() + slot * cacheWidth * channelCount;
+        float *alphas = alphaCache.data() + slot * cacheWidth;
+
+        KisHLineConstIteratorSP rowIt = src->createHLineConstIteratorNG(applyRect.x() - radius, row, cacheWidth);
+        int i = 0;
+        do {
+            const quint8 *data = rowIt->oldRawData();
+            cs->normalisedChannelsValue(data, channel);
+            memcpy(channels + i * channelCount, channel.constData(), channelCount * sizeof(float));
+            // transparent pixels are not going to provide any useful information
+            usable[i] = cs->opacityU8(data) != 0;
+            bins[i] = (quint8)(cs->intensity8(data) * scale);
+            alphas[i] = cs->opacityF(data);
+            i++;
+        } while (rowIt->nextPixel());
+    };
+
+    const auto addColumn = [&] (int slot, int column) {
+        if (!usableCache[slot * cacheWidth + column]) return;
+        const int bin = binCache[slot * cacheWidth + column];
+        const float *channels = channelCache.constData() + (slot * cacheWidth + column) * channelCount;
+        counts[bin]++;
+        for (int i = 0; i < channelCount; i++) {
+            sums[bin * channelCount + i] += channels[i];
+        }
+    };
+
+    const auto removeColumn = [&] (int slot, int column) {
+        if (!usableCache[slot * cacheWidth + column]) return;
+        const int bin = binCache[slot * cacheWidth + column];
+        const float *channels = channelCache.constData() + (slot * cacheWidth + column) * channelCount;
+        if (--counts[bin] == 0) {
+            // reset the sums so that float error doesn't accumulate
+            memset(sums.data() + bin * channelCount, 0, channelCount * sizeof(float));
+        } else {
+            for (int i = 0; i < channelCount; i++) {
+                sums[bin * channelCount + i] -= channels[i];
+            }
+        }
+    };
 
-    KisSequentialConstIterator srcIt(src, QRect(startx, starty, width, height));
-    while (middlePointAlpha > 0 && srcIt.nextPixel()) {
+    const auto slotForRow = [windowSize] (int row) {
+        return ((row % windowSize) + windowSize) % windowSize;
+    };
 
-        cs->normalisedChannelsValue(srcIt.oldRawData(), channel);
+    if (progressUpdater) progressUpdater->setRange(0, applyRect.height());
 
-        if (cs->opacityU8(srcIt.oldRawData()) == 0) {
-            // if the pixel is transparent, it's not going to provide any useful information
-            continue;
+    for (int y = applyRect.top(); y <= applyRect.bottom(); y++) {
+        if (y == applyRect.top()) {
+            for (int row = y - radius; row <= y + radius; row++) {
+                decodeRow(row, slotForRow(row));
+            }
+        } else {
+            decodeRow(y + radius, slotForRow(y + radius));
         }
 
-        I = (uint)(cs->intensity8(srcIt.oldRawData()) * Scale);
+        counts.fill(0);
+        sums.fill(0.0f);
 
-        IntensityCount[I]++;
-
-        if (IntensityCount[I] == 1) {
-            AverageChannels[I] = channel;
-        } else {
-            for (int i = 0; i < channel.size(); i++) {
-                AverageChannels[I][i] += channel[i];
+        // Fill the window for the first pixel of the scanline
+        for (int column = 0; column < windowSize; column++) {
+            for (int slot = 0; slot < windowSize; slot++) {
+                addColumn(slot, column);
             }
         }
-    }
 
-    I = 0;
-    int MaxInstance = 0;
+        const int middleSlot = slotForRow(y);
+        KisHLineIteratorSP dstIt = dst->createHLineIteratorNG(applyRect.x(), y, applyRect.width());
+        int outColumn = 0;
+        do {
+            // if the current pixel is transparent, the result must be transparent, too.
+            const qreal middlePointAlpha = alphaCache[middleSlot * cacheWidth + outColumn + radius];
+            quint8 *dstData = dstIt->rawData();
+
+            int maxBin = 0;
+            int maxInstance = 0;
+
+            if (middlePointAlpha > 0) {
+                for (int i = 0; i < numBins; i++) {
+                    if (counts[i] > maxInstance) {
+                        maxBin = i;
+                        maxInstance = counts[i];
+                    }
+                }
+            }
 
-    for (int i = 0 ; i <= Intensity ; ++i) {
-        if (IntensityCount[i] > MaxInstance) {
-            I = i;
-            MaxInstance = IntensityCount[i];
-        }
-    }
+            if (maxInstance != 0) {
+                for (int i = 0; i < channelCount; i++) {
+                    channel[i] = sums[maxBin * channelCount + i] / maxInstance;
+                }
+                cs->fromNormalisedChannelsValue(dstData, channel);
+                cs->setOpacity(dstData, OPACITY_OPAQUE_U8, middlePointAlpha);
+            } else {
+                memset(dstData, 0, pixelSize);
+                cs->setOpacity(dstData, OPACITY_OPAQUE_U8, middlePointAlpha);
+            }
 
-    if (MaxInstance != 0) {
-        channel = AverageChannels[I];
-        for (int i = 0; i < channel.size(); i++) {
-            channel[i] /= MaxInstance;
+            // Slide the window one pixel to the right
+            if (outColumn + 1 < applyRect.width()) {
+                for (int slot = 0; slot < windowSize; slot++) {
+                    removeColumn(slot, outColumn);
+                    addColumn(slot, outColumn + windowSize);
+                }
+            }
+            outColumn++;
+        } while (dstIt->nextPixel());
+
+        if (progressUpdater) {
+            if (progressUpdater->interrupted()) return;
+            progressUpdater->setValue(y - applyRect.top() + 1);
         }
-        cs->fromNormalisedChannelsValue(dst, channel);
-        cs->setOpacity(dst, OPACITY_OPAQUE_U8, middlePointAlpha);
-    } else {
-        memset(dst, 0, cs->pixelSize());
-        cs->setOpacity(dst, OPACITY_OPAQUE_U8, middlePointAlpha);
     }
-
-
-    delete [] IntensityCount;        // free all the arrays
-    delete [] AverageChannels;
 }
 
 QRect KisOilPaintFilter::neededRect(const QRect & rect, const KisFilterConfigurationSP _config, int /*lod*/) const
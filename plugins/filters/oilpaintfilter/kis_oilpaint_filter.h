@@ -37,7 +37,6 @@ public:
 private:
     void OilPaint(const KisPaintDeviceSP src, KisPaintDeviceSP dst, const QRect &applyRect,
                   int BrushSize, int Smoothness, KoUpdater* progressUpdater) const;
-    void MostFrequentColor(KisPaintDeviceSP src, quint8* dst, const QRect& bounds, int X, int Y, int Radius, int Intensity) const;
 };
 
 #endif
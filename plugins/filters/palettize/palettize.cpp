@@ -8,6 +8,8 @@
 
 #include "palettize.h"
 
+#include <QMutex>
+
 #include <kis_types.h>
 #include <kpluginfactory.h>
 #include <kis_config_widget.h>
@@ -42,6 +44,15 @@ Palettize::Palettize(QObject *parent, const QVariantList &)
 class KisFilterPalettizeConfiguration : public KisFilterConfiguration
 {
 public:
+    using SearchColor = boost::geometry::model::point<quint16, 3, boost::geometry::cs::cartesian>;
+    struct ColorCandidate {
+        KoColor color;
+        quint16 index;
+        double distance;
+    };
+    using SearchEntry = std::pair<SearchColor, ColorCandidate>;
+    using SearchTree = boost::geometry::index::rtree<SearchEntry, boost::geometry::index::quadratic<16>>;
+
     KisFilterPalettizeConfiguration(const QString & name, qint32 version, KisResourcesInterfaceSP resourcesInterface)
         : KisFilterConfiguration(name, version, resourcesInterface)
     {
@@ -81,6 +92,63 @@ public:
 
         return resources;
     }
+
+    // Returns the palette colors packed into the search tree, built
+    // lazily and shared between all the patches the filter is split
+    // into, so the tree is not rebuilt once per patch. Dropped whenever
+    // a property changes.
+    const SearchTree* searchTree(const KoColorSpace *colorspace, const KoColorSpace *workColorspace) const
+    {
+        QMutexLocker locker(&m_searchTreeMutex);
+
+        if (m_searchTree && m_searchTreeColorspace == colorspace && m_searchTreeWorkColorspace == workColorspace) {
+            return m_searchTree.data();
+        }
+
+        const KoColorSetSP palette = this->palette();
+        if (!palette) return nullptr;
+
+        m_searchTree.reset(new SearchTree());
+        m_searchTreeColorspace = colorspace;
+        m_searchTreeWorkColorspace = workColorspace;
+
+        quint16 index = 0;
+        for (int row = 0; row < palette->rowCount(); ++row) {
+            for (int column = 0; column < palette->columnCount(); ++column) {
+                KisSwatch swatch = palette->getColorGlobal(column, row);
+                if (swatch.isValid()) {
+                    KoColor color = swatch.color().convertedTo(colorspace);
+                    KoColor workColor = swatch.color().convertedTo(workColorspace);
+                    SearchColor searchColor;
+                    memcpy(&searchColor, workColor.data(), sizeof(SearchColor));
+                    // Don't add duplicates so won't dither between identical colors
+                    std::vector<SearchEntry> result;
+                    m_searchTree->query(boost::geometry::index::contains(searchColor), std::back_inserter(result));
+                    if (result.empty()) m_searchTree->insert(SearchEntry(searchColor, {color, index, 0.0}));
+                }
+                ++index;
+            }
+        }
+
+        return m_searchTree.data();
+    }
+
+    void setProperty(const QString &name, const QVariant &value) override
+    {
+        {
+            QMutexLocker locker(&m_searchTreeMutex);
+            m_searchTree.reset();
+            m_searchTreeColorspace = nullptr;
+            m_searchTreeWorkColorspace = nullptr;
+        }
+        KisFilterConfiguration::setProperty(name, value);
+    }
+
+private:
+    mutable QMutex m_searchTreeMutex;
+    mutable QScopedPointer<SearchTree> m_searchTree;
+    mutable const KoColorSpace *m_searchTreeColorspace {nullptr};
+    mutable const KoColorSpace *m_searchTreeWorkColorspace {nullptr};
 };
 
 /*******************************************************************************/
@@ -192,6 +260,8 @@ KisFilterPalettize::KisFilterPalettize() : KisFilter(id(), FiltersCategoryMapId,
     setColorSpaceIndependence(FULLY_INDEPENDENT);
     setSupportsPainting(true);
     setShowConfigurationWidget(true);
+    // a pure per-pixel mapping, so the LoD preview is exact
+    setSupportsLevelOfDetail(true);
 }
 
 KisFilterConfigurationSP KisFilterPalettize::factoryConfiguration(KisResourcesInterfaceSP resourcesInterface) const
@@ -225,8 +295,6 @@ void KisFilterPalettize::processImpl(KisPaintDeviceSP device, const QRect& apply
     KIS_SAFE_ASSERT_RECOVER_RETURN(config);
     KIS_SAFE_ASSERT_RECOVER_NOOP(config->hasLocalResourcesSnapshot());
 
-    const KoColorSetSP palette = config->palette();
-
     const int searchColorspace = config->getInt("colorspace");
     const bool ditherEnabled = config->getBool("ditherEnabled");
     const int colorMode = config->getInt("dither/colorMode");
@@ -243,35 +311,12 @@ void KisFilterPalettize::processImpl(KisPaintDeviceSP device, const QRect& apply
 
     const quint8 colorCount = ditherEnabled && colorMode == ColorMode::NearestColors ? 2 : 1;
 
-    using SearchColor = boost::geometry::model::point<quint16, 3, boost::geometry::cs::cartesian>;
-    struct ColorCandidate {
-        KoColor color;
-        quint16 index;
-        double distance;
-    };
-    using SearchEntry = std::pair<SearchColor, ColorCandidate>;
-    boost::geometry::index::rtree<SearchEntry, boost::geometry::index::quadratic<16>> rtree;
+    using SearchColor = KisFilterPalettizeConfiguration::SearchColor;
+    using ColorCandidate = KisFilterPalettizeConfiguration::ColorCandidate;
 
-    if (palette) {
-        // Add palette colors to search tree
-        quint16 index = 0;
-        for (int row = 0; row < palette->rowCount(); ++row) {
-            for (int column = 0; column < palette->columnCount(); ++column) {
-                KisSwatch swatch = palette->getColorGlobal(column, row);
-                if (swatch.isValid()) {
-                    KoColor color = swatch.color().convertedTo(colorspace);
-                    KoColor workColor = swatch.color().convertedTo(workColorspace);
-                    SearchColor searchColor;
-                    memcpy(&searchColor, workColor.data(), sizeof(SearchColor));
-                    // Don't add duplicates so won't dither between identical colors
-                    std::vector<SearchEntry> result;
-                    rtree.query(boost::geometry::index::contains(searchColor), std::back_inserter(result));
-                    if (result.empty()) rtree.insert(SearchEntry(searchColor, {color, index, 0.0}));
-                }
-                ++index;
-            }
-        }
+    const KisFilterPalettizeConfiguration::SearchTree *rtree = config->searchTree(colorspace, workColorspace);
 
+    if (rtree) {
         KisDitherUtil ditherUtil;
         if (ditherEnabled) ditherUtil.setConfiguration(*config, "dither/");
 
@@ -305,7 +350,7 @@ void KisFilterPalettize::processImpl(KisPaintDeviceSP device, const QRect& apply
             std::vector<ColorCandidate> candidateColors;
             candidateColors.reserve(size_t(colorCount));
             double distanceSum = 0.0;
-            for (auto it = rtree.qbegin(boost::geometry::index::nearest(searchColor, colorCount)); it != rtree.qend() && candidateColors.size() < colorCount; ++it) {
+            for (auto it = rtree->qbegin(boost::geometry::index::nearest(searchColor, colorCount)); it != rtree->qend() && candidateColors.size() < colorCount; ++it) {
                 ColorCandidate candidate = it->second;
                 candidate.distance = boost::geometry::distance(searchColor, it->first);
                 candidateColors.push_back(candidate);
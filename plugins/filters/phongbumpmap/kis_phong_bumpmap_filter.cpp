@@ -131,25 +131,23 @@ void KisFilterPhongBumpmap::processImpl(KisPaintDeviceSP device,
                 posright = y * inputArea.width() + x + 1;
 
 
-               memcpy(bumpmapDataPointer,
-                      tileRenderer.IlluminatePixelFromHeightmap(posup, posdown, posleft, posright).data(),
-                      pixelSize);
+               tileRenderer.IlluminatePixelFromHeightmap(reinterpret_cast<quint16*>(bumpmapDataPointer),
+                                                         posup, posdown, posleft, posright);
 
                bumpmapDataPointer += pixelSize;
             }
         }
     } else {
+        QVector <float> current_pixel_values(4);
         for (qint32 srcRow = 0; srcRow < inputArea.height(); ++srcRow) {
             do {
                 const quint8 *data = iterator->oldRawData();
                 tileRenderer.realheightmap[curPixel] = toDoubleFuncPtr[ki](data, channels[ki]->pos());
-                QVector <float> current_pixel_values(4);
                 device->colorSpace()->normalisedChannelsValue(data, current_pixel_values );
 
                 //dbgKrita<< "Vector:" << current_pixel_values[2] << "," << current_pixel_values[1] << "," << current_pixel_values[0];
-                memcpy(bumpmapDataPointer,
-                      tileRenderer.IlluminatePixelFromNormalmap(current_pixel_values[2], current_pixel_values[1], current_pixel_values[0]).data(),
-                      pixelSize);
+                tileRenderer.IlluminatePixelFromNormalmap(reinterpret_cast<quint16*>(bumpmapDataPointer),
+                                                          current_pixel_values[2], current_pixel_values[1], current_pixel_values[0]);
 
                 curPixel++;
                 //pointer that crashes here, but not in the other if statement.
@@ -92,12 +92,12 @@ void PhongPixelProcessor::setLightVector(QVector3D lightVector)
     light_vector = lightVector;
 }
 
-QVector<quint16> PhongPixelProcessor::IlluminatePixelFromHeightmap(quint32 posup, quint32 posdown, quint32 posleft, quint32 posright)
+void PhongPixelProcessor::IlluminatePixelFromHeightmap(quint16 *dst, quint32 posup, quint32 posdown, quint32 posleft, quint32 posright)
 {
-    QVector<quint16> finalPixel(4, 0xFFFF);
-
-    if (lightSources.size() == 0)
-        return finalPixel;
+    if (lightSources.size() == 0) {
+        dst[0] = dst[1] = dst[2] = dst[3] = 0xFFFF;
+        return;
+    }
 
     // Algorithm begins, Phong Illumination Model
     normal_vector.setX(- realheightmap[posright] + realheightmap[posleft]);
@@ -107,35 +107,35 @@ QVector<quint16> PhongPixelProcessor::IlluminatePixelFromHeightmap(quint32 posup
 
     // PREPARE ALGORITHM HERE
 
-    finalPixel = IlluminatePixel();
-
-    return finalPixel;
+    IlluminatePixel(dst);
 }
 
-QVector<quint16> PhongPixelProcessor::IlluminatePixel()
+void PhongPixelProcessor::IlluminatePixel(quint16 *dst)
 {
     qreal temp;
     quint8 channel = 0;
     const quint8 totalChannels = 3; // The 4th is alpha and we'll fill it with a nice 0xFFFF
     qreal computation[] = {0, 0, 0};
-    QVector<quint16> finalPixel(4, 0xFFFF);
+
+    dst[0] = dst[1] = dst[2] = dst[3] = 0xFFFF;
 
     if (lightSources.size() == 0)
-        return finalPixel;
+        return;
 
     // PREPARE ALGORITHM HERE
 
     for (int i = 0; i < size; i++) {
-        light_vector = lightSources.at(i).lightVector;
+        const Illuminant &illuminant = lightSources.at(i);
+        light_vector = illuminant.lightVector;
 
         for (channel = 0; channel < totalChannels; channel++) {
-            Ia = lightSources.at(i).RGBvalue.at(channel) * Ka;
+            Ia = illuminant.RGBvalue.at(channel) * Ka;
             computation[channel] += Ia;
         }
         if (diffuseLightIsEnabled) {
             temp = Kd * QVector3D::dotProduct(normal_vector, light_vector);
             for (channel = 0; channel < totalChannels; channel++) {
-                Id = lightSources.at(i).RGBvalue.at(channel) * temp;
+                Id = illuminant.RGBvalue.at(channel) * temp;
                 if (Id < 0)     Id = 0;
                 if (Id > 1)     Id = 1;
                 computation[channel] += Id;
@@ -146,7 +146,7 @@ QVector<quint16> PhongPixelProcessor::IlluminatePixel()
             reflection_vector = (2 * pow(QVector3D::dotProduct(normal_vector, light_vector), shiny_exp)) * normal_vector - light_vector;
             temp = Ks * QVector3D::dotProduct(vision_vector, reflection_vector);
             for (channel = 0; channel < totalChannels; channel++) {
-                Is = lightSources.at(i).RGBvalue.at(channel) * temp;
+                Is = illuminant.RGBvalue.at(channel) * temp;
                 if (Is < 0)     Is = 0;
                 if (Is > 1)     Is = 1;
                 computation[channel] += Is;
@@ -162,21 +162,18 @@ QVector<quint16> PhongPixelProcessor::IlluminatePixel()
     }
 
     //RGBA actually uses the BGRA order of channels, hence the disorder
-    finalPixel[2] = quint16(computation[0] * 0xFFFF);
-    finalPixel[1] = quint16(computation[1] * 0xFFFF);
-    finalPixel[0] = quint16(computation[2] * 0xFFFF);
-
-    return finalPixel;
+    dst[2] = quint16(computation[0] * 0xFFFF);
+    dst[1] = quint16(computation[1] * 0xFFFF);
+    dst[0] = quint16(computation[2] * 0xFFFF);
 }
 
-QVector<quint16> PhongPixelProcessor::IlluminatePixelFromNormalmap(qreal r, qreal g, qreal b)
+void PhongPixelProcessor::IlluminatePixelFromNormalmap(quint16 *dst, qreal r, qreal g, qreal b)
 {
-    QVector<quint16> finalPixel(4, 0xFFFF);
-
-    if (lightSources.size() == 0)
-        return finalPixel;
+    if (lightSources.size() == 0) {
+        dst[0] = dst[1] = dst[2] = dst[3] = 0xFFFF;
+        return;
+    }
 
-    //  if ()
     // Algorithm begins, Phong Illumination Model
     normal_vector.setX(r*2-1.0);
     normal_vector.setY(-(g*2-1.0));
@@ -185,7 +182,5 @@ QVector<quint16> PhongPixelProcessor::IlluminatePixelFromNormalmap(qreal r, qrea
 
     // PREPARE ALGORITHM HERE
 
-    finalPixel = IlluminatePixel();
-
-    return finalPixel;
+    IlluminatePixel(dst);
 }
@@ -64,9 +64,14 @@ public:
     ///Total specular light
     qreal Is;
 
-    QVector<quint16> IlluminatePixelFromHeightmap(quint32 posup, quint32 posdown, quint32 posleft, quint32 posright);
-    QVector<quint16> IlluminatePixel();
-    QVector<quint16> IlluminatePixelFromNormalmap(qreal r, qreal g, qreal b);
+    /**
+     * These write the resulting pixel into \p dst, which must point
+     * at four quint16 channels (BGRA). Filling a caller-provided
+     * buffer keeps the per-pixel loop free of heap allocations.
+     */
+    void IlluminatePixelFromHeightmap(quint16 *dst, quint32 posup, quint32 posdown, quint32 posleft, quint32 posright);
+    void IlluminatePixel(quint16 *dst);
+    void IlluminatePixelFromNormalmap(quint16 *dst, qreal r, qreal g, qreal b);
 
     void setLightVector(QVector3D light_vector);
 
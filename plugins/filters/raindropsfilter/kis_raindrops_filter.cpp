@@ -130,7 +130,19 @@ void KisRainDropsFilter::processImpl(KisPaintDeviceSP device,
 
     progressUpdater->setRange(0, number);
     KisRandomAccessorSP dstAccessor = device->createRandomAccessorNG();
-    
+
+    /**
+     * The drops are placed randomly over the whole applyRect and every
+     * drop reads back pixels written by the previous ones (the fisheye
+     * reads the already shadowed data and the blur reads its own
+     * output), so the filter can neither run tile-parallel nor replace
+     * the blur with running sums without changing the rendered result.
+     * The per-pixel temporaries are hoisted out of the loops instead.
+     */
+    QColor originalColor;
+    QColor newColor;
+    QColor blurColor;
+
     for (uint NumBlurs = 0; NumBlurs <= number; ++NumBlurs) {
         NewSize = 5 + static_cast<int>(rng.bounded(1.0) * (DropSize - 5));
         halfSize = NewSize / 2;
@@ -238,8 +250,6 @@ void KisRainDropsFilter::processImpl(KisPaintDeviceSP device,
 
                             BoolMatrix[n][m] = true;
 
-                            QColor originalColor;
-
                             dstAccessor->moveTo(srcTopLeft.x() + l, srcTopLeft.y() + k);
                             cs->toQColor(dstAccessor->oldRawData(), &originalColor);
 
@@ -247,7 +257,6 @@ void KisRainDropsFilter::processImpl(KisPaintDeviceSP device,
                             int newGreen = CLAMP(originalColor.green() + Bright, 0, quint8_MAX);
                             int newBlue = CLAMP(originalColor.blue() + Bright, 0, quint8_MAX);
 
-                            QColor newColor;
                             newColor.setRgb(newRed, newGreen, newBlue);
 
                             dstAccessor->moveTo(srcTopLeft.x() + n, srcTopLeft.y() + m);
@@ -274,13 +283,12 @@ void KisRainDropsFilter::processImpl(KisPaintDeviceSP device,
                             n = y + j + l;
 
                             if ((m >= 0) && (m < Height) && (n >= 0) && (n < Width)) {
-                                QColor color;
                                 dstAccessor->moveTo(srcTopLeft.x() + n, srcTopLeft.y() + m);
-                                cs->toQColor(dstAccessor->rawData(), &color);
+                                cs->toQColor(dstAccessor->rawData(), &blurColor);
 
-                                R += color.red();
-                                G += color.green();
-                                B += color.blue();
+                                R += blurColor.red();
+                                G += blurColor.green();
+                                B += blurColor.blue();
                                 BlurPixels++;
                             }
                         }
@@ -289,8 +297,6 @@ void KisRainDropsFilter::processImpl(KisPaintDeviceSP device,
                     n = y + j;
 
                     if ((m >= 0) && (m < Height) && (n >= 0) && (n < Width)) {
-                        QColor color;
-
                         if (BlurPixels == 0) {
                             // Coverity complains that it *is* possible
                             // for BlurPixels to be 0, so let's make sure
@@ -298,9 +304,9 @@ void KisRainDropsFilter::processImpl(KisPaintDeviceSP device,
                             BlurPixels = 1;
                         }
 
-                        color.setRgb((int)(R / BlurPixels), (int)(G / BlurPixels), (int)(B / BlurPixels));
+                        blurColor.setRgb((int)(R / BlurPixels), (int)(G / BlurPixels), (int)(B / BlurPixels));
                         dstAccessor->moveTo(srcTopLeft.x() + n, srcTopLeft.y() + m);
-                        cs->fromQColor(color, dstAccessor->rawData());
+                        cs->fromQColor(blurColor, dstAccessor->rawData());
                     }
                 }
             }
@@ -22,7 +22,10 @@
 #include <QApplication>
 #include <QMessageBox>
 #include <QDomDocument>
+#include <QRunnable>
+#include <QSemaphore>
 #include <QThread>
+#include <QThreadPool>
 
 #include <QFileInfo>
 
@@ -970,7 +973,7 @@ class Encoder
 public:
     virtual ~Encoder() {}
     virtual void prepareFrameBuffer(Imf::FrameBuffer*, int line) = 0;
-    virtual void encodeData(int line) = 0;
+    virtual void encodeData(int line, int rows) = 0;
 
 };
 
@@ -978,10 +981,10 @@ template<typename _T_, int size, int alphaPos>
 class EncoderImpl : public Encoder
 {
 public:
-    EncoderImpl(Imf::OutputFile* _file, const ExrPaintLayerSaveInfo* _info, int width) : file(_file), info(_info), pixels(width), m_width(width) {}
+    EncoderImpl(Imf::OutputFile* _file, const ExrPaintLayerSaveInfo* _info, int width, int bandHeight) : file(_file), info(_info), pixels(width * bandHeight), m_width(width) {}
     ~EncoderImpl() override {}
     void prepareFrameBuffer(Imf::FrameBuffer*, int line) override;
-    void encodeData(int line) override;
+    void encodeData(int line, int rows) override;
 private:
     typedef ExrPixel_<_T_, size> ExrPixel;
     Imf::OutputFile* file;
@@ -1005,56 +1008,58 @@ void EncoderImpl<_T_, size, alphaPos>::prepareFrameBuffer(Imf::FrameBuffer* fram
 }
 
 template<typename _T_, int size, int alphaPos>
-void EncoderImpl<_T_, size, alphaPos>::encodeData(int line)
+void EncoderImpl<_T_, size, alphaPos>::encodeData(int line, int rows)
 {
-    ExrPixel *rgba = pixels.data();
-    KisHLineConstIteratorSP it = info->layerDevice->createHLineConstIteratorNG(0, line, m_width);
-    do {
-        const _T_* dst = reinterpret_cast < const _T_* >(it->oldRawData());
+    for (int y = line; y < line + rows; ++y) {
+        ExrPixel *rgba = pixels.data() + (y - line) * m_width;
+        KisHLineConstIteratorSP it = info->layerDevice->createHLineConstIteratorNG(0, y, m_width);
+        do {
+            const _T_* dst = reinterpret_cast < const _T_* >(it->oldRawData());
 
-        for (int i = 0; i < size; ++i) {
-            rgba->data[i] = dst[i];
-        }
+            for (int i = 0; i < size; ++i) {
+                rgba->data[i] = dst[i];
+            }
 
-        if (alphaPos != -1) {
-            multiplyAlpha<_T_, ExrPixel, size, alphaPos>(rgba);
-        }
+            if (alphaPos != -1) {
+                multiplyAlpha<_T_, ExrPixel, size, alphaPos>(rgba);
+            }
 
-        ++rgba;
-    } while (it->nextPixel());
+            ++rgba;
+        } while (it->nextPixel());
+    }
 }
 
-Encoder* encoder(Imf::OutputFile& file, const ExrPaintLayerSaveInfo& info, int width)
+Encoder* encoder(Imf::OutputFile& file, const ExrPaintLayerSaveInfo& info, int width, int bandHeight)
 {
     dbgFile << "Create encoder for" << info.name << info.channels << info.layerDevice->colorSpace()->channelCount();
     switch (info.layerDevice->colorSpace()->channelCount()) {
     case 1: {
         if (info.layerDevice->colorSpace()->colorDepthId() == Float16BitsColorDepthID) {
             Q_ASSERT(info.pixelType == Imf::HALF);
-            return new EncoderImpl < half, 1, -1 > (&file, &info, width);
+            return new EncoderImpl < half, 1, -1 > (&file, &info, width, bandHeight);
         } else if (info.layerDevice->colorSpace()->colorDepthId() == Float32BitsColorDepthID) {
             Q_ASSERT(info.pixelType == Imf::FLOAT);
-            return new EncoderImpl < float, 1, -1 > (&file, &info, width);
+            return new EncoderImpl < float, 1, -1 > (&file, &info, width, bandHeight);
         }
         break;
     }
     case 2: {
         if (info.layerDevice->colorSpace()->colorDepthId() == Float16BitsColorDepthID) {
             Q_ASSERT(info.pixelType == Imf::HALF);
-            return new EncoderImpl<half, 2, 1>(&file, &info, width);
+            return new EncoderImpl<half, 2, 1>(&file, &info, width, bandHeight);
         } else if (info.layerDevice->colorSpace()->colorDepthId() == Float32BitsColorDepthID) {
             Q_ASSERT(info.pixelType == Imf::FLOAT);
-            return new EncoderImpl<float, 2, 1>(&file, &info, width);
+            return new EncoderImpl<float, 2, 1>(&file, &info, width, bandHeight);
         }
         break;
     }
     case 4: {
         if (info.layerDevice->colorSpace()->colorDepthId() == Float16BitsColorDepthID) {
             Q_ASSERT(info.pixelType == Imf::HALF);
-            return new EncoderImpl<half, 4, 3>(&file, &info, width);
+            return new EncoderImpl<half, 4, 3>(&file, &info, width, bandHeight);
         } else if (info.layerDevice->colorSpace()->colorDepthId() == Float32BitsColorDepthID) {
             Q_ASSERT(info.pixelType == Imf::FLOAT);
-            return new EncoderImpl<float, 4, 3>(&file, &info, width);
+            return new EncoderImpl<float, 4, 3>(&file, &info, width, bandHeight);
         }
         break;
     }
@@ -1064,23 +1069,76 @@ Encoder* encoder(Imf::OutputFile& file, const ExrPaintLayerSaveInfo& info, int w
     return 0;
 }
 
+/**
+ * Converts one band of scanlines of a single layer into its IlmImf
+ * frame buffer. The encoders read from different paint devices, so the
+ * tasks of one band can run concurrently.
+ */
+class EncodeBandTask : public QRunnable
+{
+public:
+    EncodeBandTask(Encoder *encoder, int line, int rows, QSemaphore *doneSemaphore)
+        : m_encoder(encoder),
+          m_line(line),
+          m_rows(rows),
+          m_doneSemaphore(doneSemaphore)
+    {
+        setAutoDelete(false);
+    }
+
+    void run() override {
+        m_encoder->encodeData(m_line, m_rows);
+        m_doneSemaphore->release();
+    }
+
+private:
+    Encoder *m_encoder;
+    int m_line;
+    int m_rows;
+    QSemaphore *m_doneSemaphore;
+};
+
 void encodeData(Imf::OutputFile& file, const QList<ExrPaintLayerSaveInfo>& informationObjects, int width, int height)
 {
+    /**
+     * Writing several scanlines per writePixels() call lets the IlmImf
+     * library compress the covered chunks on its own thread pool (one
+     * chunk is up to 32 scanlines, depending on the compression
+     * method). Writing line by line would serialize the compression
+     * again, however many threads the pool has.
+     */
+    const int bandHeight = qMin(height, 128);
+
     QList<Encoder*> encoders;
     Q_FOREACH (const ExrPaintLayerSaveInfo& info, informationObjects) {
-        encoders.push_back(encoder(file, info, width));
+        encoders.push_back(encoder(file, info, width, bandHeight));
     }
 
-    for (int y = 0; y < height; ++y) {
+    for (int y = 0; y < height; y += bandHeight) {
+        const int rows = qMin(bandHeight, height - y);
+
         Imf::FrameBuffer frameBuffer;
         Q_FOREACH (Encoder* encoder, encoders) {
             encoder->prepareFrameBuffer(&frameBuffer, y);
         }
         file.setFrameBuffer(frameBuffer);
+
+        QSemaphore doneSemaphore;
+        QVector<EncodeBandTask*> tasks;
+
         Q_FOREACH (Encoder* encoder, encoders) {
-            encoder->encodeData(y);
+            EncodeBandTask *task = new EncodeBandTask(encoder, y, rows, &doneSemaphore);
+            tasks << task;
+
+            if (!QThreadPool::globalInstance()->tryStart(task)) {
+                task->run();
+            }
         }
-        file.writePixels(1);
+
+        doneSemaphore.acquire(tasks.size());
+        qDeleteAll(tasks);
+
+        file.writePixels(rows);
     }
     qDeleteAll(encoders);
 }
@@ -93,6 +93,74 @@ void KisExrTest::testRoundTrip()
 
 }
 
+void KisExrTest::testMultiLayerRoundTrip()
+{
+    const KoColorSpace *cs =
+        KoColorSpaceRegistry::instance()->colorSpace(
+            RGBAColorModelID.id(), Float16BitsColorDepthID.id(), 0);
+
+    KisDocument *doc1 = KisPart::instance()->createDocument();
+    doc1->setFileBatchMode(true);
+
+    // taller than one encoding band, so the layers are converted and
+    // compressed in several chunks
+    KisImageSP image = new KisImage(0, 16, 300, cs, "exr multilayer test");
+
+    KisPaintLayerSP layer1 = new KisPaintLayer(image, "background", OPACITY_OPAQUE_U8);
+    KisPaintLayerSP layer2 = new KisPaintLayer(image, "foreground", OPACITY_OPAQUE_U8);
+
+    for (int y = 0; y < 300; y++) {
+        layer1->paintDevice()->fill(QRect(0, y, 16, 1), KoColor(QColor(y % 256, 255 - y % 256, 0), cs));
+        layer2->paintDevice()->fill(QRect(0, y, 8, 1), KoColor(QColor(0, y % 256, 255 - y % 256), cs));
+    }
+
+    image->addNode(layer1, image->root());
+    image->addNode(layer2, image->root());
+    image->initialRefreshGraph();
+    image->waitForDone();
+
+    doc1->setCurrentImage(image);
+
+    QTemporaryFile savedFile(QDir::tempPath() + QLatin1String("/krita_XXXXXX") + QLatin1String(".exr"));
+    savedFile.setAutoRemove(true);
+    savedFile.open();
+
+    QString savedFileName(savedFile.fileName());
+
+    bool r = doc1->exportDocumentSync(savedFileName, ExrMimetype.toLatin1());
+    QVERIFY(r);
+    QVERIFY(QFileInfo(savedFileName).exists());
+
+    {
+        KisDocument *doc2 = KisPart::instance()->createDocument();
+        doc2->setFileBatchMode(true);
+        r = doc2->importDocument(savedFileName);
+
+        QVERIFY(r);
+        QVERIFY(doc2->image());
+        QCOMPARE(doc2->image()->root()->childCount(), doc1->image()->root()->childCount());
+
+        KisNodeSP srcNode = doc1->image()->root()->firstChild();
+        KisNodeSP dstNode = doc2->image()->root()->firstChild();
+
+        while (srcNode && dstNode) {
+            QVERIFY(TestUtil::comparePaintDevicesClever<half>(
+                        srcNode->paintDevice(),
+                        dstNode->paintDevice(),
+                        0.01 /* meaningless alpha */));
+
+            srcNode = srcNode->nextSibling();
+            dstNode = dstNode->nextSibling();
+        }
+
+        delete doc2;
+    }
+
+    savedFile.close();
+
+    delete doc1;
+}
+
 KISTEST_MAIN(KisExrTest)
 
 
@@ -18,6 +18,7 @@ private Q_SLOTS:
     void testExportToReadonly();
     void testImportIncorrectFormat();
     void testRoundTrip();
+    void testMultiLayerRoundTrip();
 };
 
 #endif
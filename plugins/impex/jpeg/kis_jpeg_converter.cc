@@ -27,6 +27,7 @@ extern "C" {
 
 #include <QFile>
 #include <QBuffer>
+#include <QVector>
 #include <QApplication>
 
 #include <klocalizedstring.h>
@@ -251,46 +252,64 @@ KisImportExportErrorCode KisJPEGConverter::decode(QIODevice *io)
         // Read data
         JSAMPROW row_pointer = new JSAMPLE[cinfo.image_width*cinfo.num_components];
 
+        /**
+         * Decoded scanlines are swizzled into a row buffer in the
+         * destination pixel format, the profile conversion is applied
+         * to the whole row at once and the result is written into the
+         * paint device row-by-row. Compared to the historical per-pixel
+         * iterator loop this amortizes both the tile lookups and the
+         * color transform call over the full scanline.
+         */
+        KisPaintDeviceSP device = layer->paintDevice();
+        const qint32 pixelSize = cs->pixelSize();
+        QVector<quint8> rowBuffer(cinfo.image_width * pixelSize);
+
         for (; cinfo.output_scanline < cinfo.image_height;) {
-            KisHLineIteratorSP it = layer->paintDevice()->createHLineIteratorNG(0, cinfo.output_scanline, cinfo.image_width);
+            const int y = cinfo.output_scanline;
             jpeg_read_scanlines(&cinfo, &row_pointer, 1);
             quint8 *src = row_pointer;
+            quint8 *d = rowBuffer.data();
             switch (cinfo.out_color_space) {
             case JCS_GRAYSCALE:
-                do {
-                    quint8 *d = it->rawData();
+                for (unsigned int x = 0; x < cinfo.image_width; x++, d += pixelSize) {
                     d[0] = *(src++);
-                    if (transform) transform->transform(d, d, 1);
                     d[1] = quint8_MAX;
-
-                } while (it->nextPixel());
+                }
                 break;
             case JCS_RGB:
-                do {
-                    quint8 *d = it->rawData();
+                for (unsigned int x = 0; x < cinfo.image_width; x++, d += pixelSize) {
                     d[2] = *(src++);
                     d[1] = *(src++);
                     d[0] = *(src++);
-                    if (transform) transform->transform(d, d, 1);
                     d[3] = quint8_MAX;
-
-                } while (it->nextPixel());
+                }
                 break;
             case JCS_CMYK:
-                do {
-                    quint8 *d = it->rawData();
+                for (unsigned int x = 0; x < cinfo.image_width; x++, d += pixelSize) {
                     d[0] = quint8_MAX - *(src++);
                     d[1] = quint8_MAX - *(src++);
                     d[2] = quint8_MAX - *(src++);
                     d[3] = quint8_MAX - *(src++);
-                    if (transform) transform->transform(d, d, 1);
                     d[4] = quint8_MAX;
-
-                } while (it->nextPixel());
+                }
                 break;
             default:
+                delete [] row_pointer;
                 return ImportExportCodes::FormatFeaturesUnsupported;
             }
+
+            if (transform) {
+                transform->transform(rowBuffer.data(), rowBuffer.data(), cinfo.image_width);
+
+                // the alpha channel is fully opaque whatever the transform did to it
+                quint8 *pixel = rowBuffer.data();
+                const qint32 alphaOffset = pixelSize - 1;
+                for (unsigned int x = 0; x < cinfo.image_width; x++, pixel += pixelSize) {
+                    pixel[alphaOffset] = quint8_MAX;
+                }
+            }
+
+            device->writeBytes(rowBuffer.data(), 0, y, cinfo.image_width, 1);
         }
 
         m_d->image->addNode(KisNodeSP(layer.data()), m_d->image->rootLayer().data());
@@ -44,6 +44,7 @@
 
 #include "kis_config.h"
 #include "kis_store_paintdevice_writer.h"
+#include "KisLayerPayloadCache.h"
 #include "flake/kis_shape_selection.h"
 
 #include "kis_raster_keyframe_channel.h"
@@ -78,6 +79,11 @@ void KisKraSaveVisitor::setExternalUri(const QString &uri)
     m_uri = uri;
 }
 
+void KisKraSaveVisitor::setPayloadCache(KisLayerPayloadCache *payloadCache)
+{
+    m_payloadCache = payloadCache;
+}
+
 bool KisKraSaveVisitor::visit(KisExternalLayer * layer)
 {
     bool result = false;
@@ -318,6 +324,25 @@ struct SimpleDevicePolicy
     }
 };
 
+/**
+ * Collects the device payload into a memory buffer, so that it can be
+ * stored in the payload cache in addition to being written to the store
+ */
+struct BufferPaintDeviceWriter : KisPaintDeviceWriter
+{
+    bool write(const QByteArray &data) override {
+        buffer.append(data);
+        return true;
+    }
+
+    bool write(const char *data, qint64 length) override {
+        buffer.append(data, length);
+        return true;
+    }
+
+    QByteArray buffer;
+};
+
 struct FramedDevicePolicy
 {
     FramedDevicePolicy(int frameId)
@@ -349,7 +374,16 @@ bool KisKraSaveVisitor::savePaintDevice(KisPaintDeviceSP device,
     }
 
     if (!frameInterface || frames.count() <= 1) {
-        savePaintDeviceFrame(device, location, SimpleDevicePolicy());
+        /**
+         * The payload cache only recognizes plain devices: framed
+         * devices keep separate data per frame, so they are always
+         * serialized from scratch
+         */
+        if (m_payloadCache) {
+            saveCachedPaintDevice(device, location);
+        } else {
+            savePaintDeviceFrame(device, location, SimpleDevicePolicy());
+        }
     } else {
         KisRasterKeyframeChannel *keyframeChannel = device->keyframeChannel();
 
@@ -370,6 +404,35 @@ bool KisKraSaveVisitor::savePaintDevice(KisPaintDeviceSP device,
 }
 
 
+bool KisKraSaveVisitor::saveCachedPaintDevice(KisPaintDeviceSP device, const QString &location)
+{
+    QByteArray payload;
+
+    if (!m_payloadCache->tryFetchPayload(location, device, &payload)) {
+        BufferPaintDeviceWriter bufferWriter;
+
+        if (!device->write(bufferWriter)) {
+            device->disconnect();
+            return false;
+        }
+
+        payload = bufferWriter.buffer;
+        m_payloadCache->storePayload(location, device, payload);
+    }
+
+    if (m_store->open(location)) {
+        m_store->write(payload);
+        m_store->close();
+    }
+
+    if (m_store->open(location + ".defaultpixel")) {
+        m_store->write((char*)device->defaultPixel().data(), device->colorSpace()->pixelSize());
+        m_store->close();
+    }
+
+    return true;
+}
+
 template<class DevicePolicy>
 bool KisKraSaveVisitor::savePaintDeviceFrame(KisPaintDeviceSP device, QString location, DevicePolicy policy)
 {
@@ -17,6 +17,7 @@
 #include "kritalibkra_export.h"
 
 class KisPaintDeviceWriter;
+class KisLayerPayloadCache;
 class KoStore;
 
 class KRITALIBKRA_EXPORT KisKraSaveVisitor : public KisNodeVisitor
@@ -29,6 +30,14 @@ public:
 public:
     void setExternalUri(const QString &uri);
 
+    /**
+     * Sets the cache of layer payloads kept by the document between
+     * saves. When set, devices that have not changed since the
+     * previous save are written from the cached byte stream instead
+     * of being serialized again.
+     */
+    void setPayloadCache(KisLayerPayloadCache *payloadCache);
+
     bool visit(KisNode*) override {
         return true;
     }
@@ -61,6 +70,7 @@ public:
 private:
 
     bool savePaintDevice(KisPaintDeviceSP device, QString location);
+    bool saveCachedPaintDevice(KisPaintDeviceSP device, const QString &location);
 
     template<class DevicePolicy>
     bool savePaintDeviceFrame(KisPaintDeviceSP device, QString location, DevicePolicy policy);
@@ -81,6 +91,7 @@ private:
     QString m_name;
     QMap<const KisNode*, QString> m_nodeFileNames;
     KisPaintDeviceWriter *m_writer;
+    KisLayerPayloadCache *m_payloadCache {0};
     QStringList m_errorMessages;
 };
 
@@ -43,6 +43,7 @@
 #include "kis_keyframe_channel.h"
 #include <kis_time_span.h>
 #include "KisDocument.h"
+#include "KisLayerPayloadCache.h"
 #include <string>
 #include "kis_dom_utils.h"
 #include "kis_grid_config.h"
@@ -479,8 +480,20 @@ bool KisKraSaver::saveBinaryData(KoStore* store, KisImageSP image, const QString
     if (external)
         visitor.setExternalUri(uri);
 
+    KisLayerPayloadCache *payloadCache =
+        m_d->doc ? m_d->doc->layerPayloadCache() : 0;
+
+    if (payloadCache) {
+        visitor.setPayloadCache(payloadCache);
+        payloadCache->beginSave();
+    }
+
     image->rootLayer()->accept(visitor);
 
+    if (payloadCache) {
+        payloadCache->endSave();
+    }
+
     m_d->errorMessages.append(visitor.errorMessages());
     if (!m_d->errorMessages.isEmpty()) {
         return false;
@@ -165,5 +165,56 @@ void KisPngTest::testSaveHDR()
                     KoColorSpaceRegistry::instance()->p2020PQProfile()));
 }
 
+void KisPngTest::testBandedExport()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+
+    KisPaintDeviceSP referenceDevice;
+
+    {
+        QScopedPointer<KisDocument> doc(KisPart::instance()->createDocument());
+
+        // taller than one encoding band, so the rows are converted
+        // and written in several chunks
+        KisImageSP image = new KisImage(0, 16, 300, cs, "png band test");
+        KisPaintLayerSP paintLayer0 = new KisPaintLayer(image, "paint0", OPACITY_OPAQUE_U8);
+
+        for (int y = 0; y < 300; y++) {
+            const KoColor fillColor(QColor(y % 256, (y * 7) % 256, 255 - y % 256), cs);
+            paintLayer0->paintDevice()->fill(QRect(0, y, 16, 1), fillColor);
+        }
+
+        image->addNode(paintLayer0, image->root());
+        image->initialRefreshGraph();
+        image->waitForDone();
+
+        referenceDevice = new KisPaintDevice(*image->projection());
+
+        KisImportExportManager manager(doc.data());
+        doc->setFileBatchMode(true);
+        doc->setCurrentImage(image);
+        doc->exportDocumentSync("test_banded.png", "image/png");
+    }
+
+    {
+        QScopedPointer<KisDocument> doc(KisPart::instance()->createDocument());
+        KisImportExportManager manager(doc.data());
+        doc->setFileBatchMode(true);
+
+        KisImportExportErrorCode loadingStatus =
+            manager.importDocument("test_banded.png", QString());
+        QVERIFY(loadingStatus.isOk());
+
+        KisImageSP image = doc->image();
+        image->initialRefreshGraph();
+
+        QPoint errPoint;
+        if (!TestUtil::comparePaintDevices(errPoint, referenceDevice, image->projection())) {
+            QFAIL(qPrintable(QString("Roundtripped PNG differs, first different pixel: %1,%2")
+                             .arg(errPoint.x()).arg(errPoint.y())));
+        }
+    }
+}
+
 KISTEST_MAIN(KisPngTest)
 
@@ -0,0 +1,121 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisColorSmudgeOpKernels.h"
+
+#include <xsimd_extensions/xsimd.hpp>
+
+#include <KoColorSpaceMaths.h>
+
+#if XSIMD_UNIVERSAL_BUILD_PASS
+
+namespace KisColorSmudgeOpKernels
+{
+
+namespace
+{
+
+inline quint8 adjustGrayScalar(quint8 red, quint8 denormedPaintThickness)
+{
+    int gray = red - 127;
+
+    if (gray >= 0) {
+        gray = KoColorSpaceMaths<quint8>::multiply(quint8(gray), denormedPaintThickness);
+    } else {
+        gray = -KoColorSpaceMaths<quint8>::multiply(quint8(-gray), denormedPaintThickness);
+    }
+
+    return quint8(qBound(0, gray + 127, 255));
+}
+
+template<typename Arch,
+         typename std::enable_if_t<std::is_same<Arch, xsimd::generic>::value,
+                                   int> = 0>
+inline void applyThicknessAndExtractMask(quint8 *dabPtr, quint8 *maskPtr,
+                                         int numPixels, qreal paintThickness)
+{
+    const quint8 denormedPaintThickness = quint8(qRound(paintThickness * 255.0));
+
+    for (int i = 0; i < numPixels; i++) {
+        const quint8 gray = adjustGrayScalar(dabPtr[2], denormedPaintThickness);
+
+        dabPtr[0] = gray;
+        dabPtr[1] = gray;
+        dabPtr[2] = gray;
+        *maskPtr = dabPtr[3];
+
+        dabPtr += 4;
+        maskPtr++;
+    }
+}
+
+#if defined HAVE_XSIMD && !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE)
+template<typename Arch,
+         typename std::enable_if_t<!std::is_same<Arch, xsimd::generic>::value,
+                                   int> = 0>
+inline void applyThicknessAndExtractMask(quint8 *dabPtr, quint8 *maskPtr,
+                                         int numPixels, qreal paintThickness)
+{
+    using uint_v = xsimd::batch<unsigned int, Arch>;
+    using int_v = xsimd::batch<int, Arch>;
+    using float_v = xsimd::batch<float, Arch>;
+
+    /**
+     * One 32-bit lane per BGRA8 pixel, following the layout
+     * conventions of KoStreamedMath: the channels are extracted with
+     * shifts and the lightness math is done in floats
+     */
+    const int vectorSize = int(uint_v::size);
+    const float_v thickness(float(paintThickness));
+
+    alignas(Arch::alignment())
+        typename uint_v::value_type alphaScratch[uint_v::size];
+
+    int i = 0;
+
+    for (; i + vectorSize <= numPixels; i += vectorSize) {
+        const auto data =
+            uint_v::load_unaligned(reinterpret_cast<const unsigned int*>(dabPtr));
+
+        const auto alpha = data >> 24;
+        const auto red = (data >> 16) & uint_v(0xFF);
+
+        const float_v gray_f =
+            float_v(127.0f) +
+            (xsimd::to_float(xsimd::bitwise_cast_compat<int>(red)) - float_v(127.0f)) * thickness;
+
+        const auto gray = xsimd::bitwise_cast_compat<unsigned int>(
+            xsimd::max(int_v(0), xsimd::min(int_v(255), xsimd::nearbyint_as_int(gray_f))));
+
+        xsimd::store_unaligned(reinterpret_cast<unsigned int*>(dabPtr),
+                               (alpha << 24) | (gray << 16) | (gray << 8) | gray);
+
+        xsimd::store_aligned(alphaScratch, alpha);
+        for (int j = 0; j < vectorSize; j++) {
+            maskPtr[j] = quint8(alphaScratch[j]);
+        }
+
+        dabPtr += 4 * vectorSize;
+        maskPtr += vectorSize;
+    }
+
+    applyThicknessAndExtractMask<xsimd::generic>(dabPtr, maskPtr,
+                                                 numPixels - i, paintThickness);
+}
+#endif
+
+}
+
+template<>
+ApplyThicknessAndExtractMaskImpl::FuncType
+ApplyThicknessAndExtractMaskImpl::create<xsimd::current_arch>()
+{
+    return &applyThicknessAndExtractMask<xsimd::current_arch>;
+}
+
+}
+
+#endif /* XSIMD_UNIVERSAL_BUILD_PASS */
@@ -0,0 +1,39 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISCOLORSMUDGEOPKERNELS_H
+#define KISCOLORSMUDGEOPKERNELS_H
+
+#include <QtGlobal>
+
+/**
+ * Per-architecture kernels for the per-pixel loops of the colorsmudge
+ * engine. The implementations live in KisColorSmudgeOpKernels.cpp,
+ * which is compiled once for every supported instruction set; the
+ * factories return a pointer to the best available version, resolved
+ * at runtime with createOptimizedClass().
+ */
+namespace KisColorSmudgeOpKernels
+{
+
+struct ApplyThicknessAndExtractMaskImpl {
+    /**
+     * The returned kernel scales the lightness of \c numPixels BGRA8
+     * pixels of the dab towards middle gray by \c paintThickness
+     * (in-place) and writes the alpha channel of the pixels into
+     * \c maskPtr in the same pass, fusing what used to be a scalar
+     * lightness loop followed by a separate copyOpacityU8() sweep.
+     */
+    using FuncType = void (*)(quint8 *dabPtr, quint8 *maskPtr,
+                              int numPixels, qreal paintThickness);
+
+    template<typename Arch>
+    static FuncType create();
+};
+
+}
+
+#endif /* KISCOLORSMUDGEOPKERNELS_H */
@@ -119,6 +119,7 @@ void KisColorSmudgeStrategyBase::initializePaintingImpl(const KoColorSpace *dstC
                                                         const QString &colorRateCompositeOpId)
 {
     m_blendDevice = new KisFixedPaintDevice(dstColorSpace, m_memoryAllocator);
+    m_smearTempDevice = new KisFixedPaintDevice(dstColorSpace, m_memoryAllocator);
     m_smearOp = dstColorSpace->compositeOp(smearCompositeOp(smearAlpha));
     m_colorRateOp = dstColorSpace->compositeOp(colorRateCompositeOpId);
     m_preparedDullingColor.convertTo(dstColorSpace);
@@ -270,13 +271,15 @@ void KisColorSmudgeStrategyBase::blendInBackgroundWithSmearing(KisFixedPaintDevi
     } else {
         src->readBytes(dst->data(), dstRect);
 
-        KisFixedPaintDevice tempDevice(src->colorSpace(), m_memoryAllocator);
-        tempDevice.setRect(srcRect);
-        tempDevice.lazyGrowBufferWithoutInitialization();
+        // reused between the dabs to avoid reallocating a dab-sized
+        // buffer for every single dab
+        m_smearTempDevice->setColorSpace(src->colorSpace());
+        m_smearTempDevice->setRect(srcRect);
+        m_smearTempDevice->lazyGrowBufferWithoutInitialization();
 
-        src->readBytes(tempDevice.data(), srcRect);
+        src->readBytes(m_smearTempDevice->data(), srcRect);
         m_smearOp->composite(dst->data(), dstRect.width() * dst->pixelSize(),
-                             tempDevice.data(), dstRect.width() * tempDevice.pixelSize(), // stride should be random non-zero
+                             m_smearTempDevice->data(), dstRect.width() * m_smearTempDevice->pixelSize(), // stride should be random non-zero
                              0, 0,
                              1, dstRect.width() * dstRect.height(),
                              smudgeRateOpacity);
@@ -14,8 +14,9 @@
 #include "kis_selection.h"
 
 #include "KisColorSmudgeInterstrokeData.h"
+#include "KisColorSmudgeOpKernels.h"
 #include "kis_algebra_2d.h"
-#include <KoBgrColorSpaceTraits.h>
+#include <KoMultiArchBuildSupport.h>
 
 KisColorSmudgeStrategyLightness::KisColorSmudgeStrategyLightness(KisPainter *painter, bool smearAlpha,
                                                                  bool useDullingMode, KisPaintThicknessOptionData::ThicknessMode thicknessMode)
@@ -102,36 +103,23 @@ void KisColorSmudgeStrategyLightness::updateMask(KisDabCache *dabCache, const Ki
 
     const int numPixels = m_origDab->bounds().width() * m_origDab->bounds().height();
 
+    m_maskDab->setRect(m_origDab->bounds());
+    m_maskDab->lazyGrowBufferWithoutInitialization();
+
     if (paintThickness < 1.0) {
         if (m_shouldPreserveOriginalDab) {
             m_shouldPreserveOriginalDab = false;
             m_origDab = new KisFixedPaintDevice(*m_origDab);
         }
 
-        const int denormedPaintThickness = qRound(paintThickness * 255.0);
-        KoBgrU8Traits::Pixel *pixelPtr = reinterpret_cast<KoBgrU8Traits::Pixel *>(m_origDab->data());
-        for (int i = 0; i < numPixels; i++) {
-            int gray = pixelPtr->red - 127;
-
-            if (gray >= 0) {
-                gray = KoColorSpaceMaths<quint8>::multiply(gray, denormedPaintThickness);
-            } else {
-                gray = -KoColorSpaceMaths<quint8>::multiply(-gray, denormedPaintThickness);
-            }
-
-            gray = qBound(0, gray + 127, 255);
+        static const auto applyThicknessAndExtractMask =
+            createOptimizedClass<KisColorSmudgeOpKernels::ApplyThicknessAndExtractMaskImpl>();
 
-            pixelPtr->red = gray;
-            pixelPtr->green = gray;
-            pixelPtr->blue = gray;
-
-            pixelPtr++;
-        }
+        applyThicknessAndExtractMask(m_origDab->data(), m_maskDab->data(),
+                                     numPixels, paintThickness);
+    } else {
+        m_origDab->colorSpace()->copyOpacityU8(m_origDab->data(), m_maskDab->data(), numPixels);
     }
-
-    m_maskDab->setRect(m_origDab->bounds());
-    m_maskDab->lazyGrowBufferWithoutInitialization();
-    m_origDab->colorSpace()->copyOpacityU8(m_origDab->data(), m_maskDab->data(), numPixels);
 }
 
 QVector<QRect>
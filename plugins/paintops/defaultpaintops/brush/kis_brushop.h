@@ -21,14 +21,9 @@
 #include <KisRotationOption.h>
 #include <KisFlowOpacityOption.h>
 
-#include <KisRollingMeanAccumulatorWrapper.h>
-
-#include <QElapsedTimer>
-
 class KisPainter;
 class KisColorSource;
-class KisDabRenderingExecutor;
-struct KisRenderedDab;
+class KisDabRenderingUpdateHelper;
 class KisRunnableStrokeJobData;
 
 class KisBrushOp : public KisBrushBasedPaintOp
@@ -50,17 +45,6 @@ protected:
 
     KisTimingInformation updateTimingImpl(const KisPaintInformation &info) const override;
 
-    struct UpdateSharedState;
-    typedef QSharedPointer<UpdateSharedState> UpdateSharedStateSP;
-
-    void addMirroringJobs(Qt::Orientation direction,
-                          QVector<QRect> &rects,
-                          UpdateSharedStateSP state,
-                          QVector<KisRunnableStrokeJobData*> &jobs);
-
-    UpdateSharedStateSP m_updateSharedState;
-
-
 private:
     KisAirbrushOptionData m_airbrushData;
 
@@ -78,16 +62,7 @@ private:
 
     KisPaintDeviceSP m_lineCacheDevice;
 
-    QScopedPointer<KisDabRenderingExecutor> m_dabExecutor;
-    qreal m_currentUpdatePeriod = 20.0;
-    KisRollingMeanAccumulatorWrapper m_avgSpacing;
-    KisRollingMeanAccumulatorWrapper m_avgNumDabs;
-    KisRollingMeanAccumulatorWrapper m_avgUpdateTimePerDab;
-
-    const int m_idealNumRects;
-
-    const int m_minUpdatePeriod;
-    const int m_maxUpdatePeriod;
+    QScopedPointer<KisDabRenderingUpdateHelper> m_dabRenderingHelper;
 };
 
 #endif // KIS_BRUSHOP_H_
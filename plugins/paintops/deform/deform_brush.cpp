@@ -26,6 +26,7 @@ const qreal degToRad = M_PI / 180.0;
 
 
 DeformBrush::DeformBrush()
+    : m_maskAllocator(new KisOptimizedByteArray::PooledMemoryAllocator())
 {
     m_firstPaint = false;
     m_counter = 1;
@@ -161,7 +162,7 @@ KisFixedPaintDeviceSP DeformBrush::paintMask(KisFixedPaintDeviceSP dab,
         qreal rotation,
         QPointF pos, qreal subPixelX, qreal subPixelY, int dabX, int dabY)
 {
-    KisFixedPaintDeviceSP mask = new KisFixedPaintDevice(KoColorSpaceRegistry::instance()->alpha8());
+    KisFixedPaintDeviceSP mask = new KisFixedPaintDevice(KoColorSpaceRegistry::instance()->alpha8(), m_maskAllocator);
     KisCrossDeviceColorSampler colorSampler(layer, dab);
 
     qreal fWidth = maskWidth(scale);
@@ -9,6 +9,7 @@
 
 #include <kis_paint_device.h>
 #include <brushengine/kis_paint_information.h>
+#include <KisOptimizedByteArray.h>
 
 #include "KisBrushSizeOptionData.h"
 #include "KisDeformOptionData.h"
@@ -227,6 +228,9 @@ private:
 
     KisDeformOptionData * m_properties {0};
     KisBrushSizeOptionData * m_sizeProperties {0};
+
+    // reuses the mask buffers between the dabs of one stroke
+    KisOptimizedByteArray::MemoryAllocatorSP m_maskAllocator;
 };
 
 
@@ -21,6 +21,7 @@
 #include <kis_fixed_paint_device.h>
 
 #include <kis_global.h>
+#include <kis_algebra_2d.h>
 
 #include <cmath>
 #include <ctime>
@@ -128,6 +129,9 @@ void HairyBrush::paintLine(KisPaintDeviceSP dab, KisPaintDeviceSP layer, const K
 
     m_dab = dab;
 
+    m_tileWidth = m_dabAccessor->numContiguousColumns(0);
+    m_tileHeight = m_dabAccessor->numContiguousRows(0);
+
     // initialization block
     if (firstStroke()) {
         initAndCache();
@@ -232,10 +236,60 @@ void HairyBrush::paintLine(KisPaintDeviceSP dab, KisPaintDeviceSP layer, const K
         }
 
     }
+
+    flushPlots();
+
     m_dab = nullptr;
     m_dabAccessor = nullptr;
 }
 
+inline void HairyBrush::appendPlot(DeferredPlot::Type type, int wx, int wy, const KoColor &color, quint8 opacity)
+{
+    const int colorOffset = m_plotColors.size();
+    m_plotColors.resize(colorOffset + m_pixelSize);
+    memcpy(m_plotColors.data() + colorOffset, color.data(), m_pixelSize);
+
+    const qint32 col = KisAlgebra2D::divideFloor(wx, m_tileWidth);
+    const qint32 row = KisAlgebra2D::divideFloor(wy, m_tileHeight);
+    const quint64 tileKey = (quint64(quint32(row)) << 32) | quint32(col);
+
+    m_plotBuckets[tileKey].append(DeferredPlot{wx, wy, type, opacity, colorOffset});
+}
+
+void HairyBrush::flushPlots()
+{
+    const KoColorSpace *cs = m_dab->colorSpace();
+
+    for (auto it = m_plotBuckets.constBegin(); it != m_plotBuckets.constEnd(); ++it) {
+        Q_FOREACH (const DeferredPlot &plot, it.value()) {
+            const quint8 *colorData = m_plotColors.constData() + plot.colorOffset;
+
+            m_dabAccessor->moveTo(plot.x, plot.y);
+            quint8 *dabData = m_dabAccessor->rawData();
+
+            switch (plot.type) {
+            case DeferredPlot::Accumulate: {
+                const quint8 opacity = quint8(kisBoundFast<quint16>(OPACITY_TRANSPARENT_U8, plot.opacity + cs->opacityU8(dabData), OPACITY_OPAQUE_U8));
+                memcpy(dabData, colorData, m_pixelSize);
+                cs->setOpacity(dabData, opacity, 1);
+                break;
+            }
+            case DeferredPlot::Composite:
+                m_compositeOp->composite(dabData, m_pixelSize, colorData, m_pixelSize, 0, 0, 1, 1, OPACITY_OPAQUE_F);
+                break;
+            case DeferredPlot::Darken:
+                if (cs->opacityU8(dabData) < cs->opacityU8(colorData)) {
+                    memcpy(dabData, colorData, m_pixelSize);
+                }
+                break;
+            }
+        }
+    }
+
+    m_plotBuckets.clear();
+    m_plotColors.clear();
+}
+
 
 inline qreal HairyBrush::fetchInkDepletion(Bristle* bristle, int inkDepletionSize)
 {
@@ -332,27 +386,10 @@ void HairyBrush::paintParticle(QPointF pos, const KoColor& color, qreal weight)
     quint8 bbl = qRound((1.0 - fx) * (fy)  * opacity);
     quint8 bbr = qRound((fx)  * (fy)  * opacity);
 
-    const KoColorSpace * cs = m_dab->colorSpace();
-
-    m_dabAccessor->moveTo(ipx  , ipy);
-    btl = quint8(kisBoundFast<quint16>(OPACITY_TRANSPARENT_U8, btl + cs->opacityU8(m_dabAccessor->rawData()), OPACITY_OPAQUE_U8));
-    memcpy(m_dabAccessor->rawData(), color.data(), cs->pixelSize());
-    cs->setOpacity(m_dabAccessor->rawData(), btl, 1);
-
-    m_dabAccessor->moveTo(ipx + 1, ipy);
-    btr =  quint8(kisBoundFast<quint16>(OPACITY_TRANSPARENT_U8, btr + cs->opacityU8(m_dabAccessor->rawData()), OPACITY_OPAQUE_U8));
-    memcpy(m_dabAccessor->rawData(), color.data(), cs->pixelSize());
-    cs->setOpacity(m_dabAccessor->rawData(), btr, 1);
-
-    m_dabAccessor->moveTo(ipx, ipy + 1);
-    bbl = quint8(kisBoundFast<quint16>(OPACITY_TRANSPARENT_U8, bbl + cs->opacityU8(m_dabAccessor->rawData()), OPACITY_OPAQUE_U8));
-    memcpy(m_dabAccessor->rawData(), color.data(), cs->pixelSize());
-    cs->setOpacity(m_dabAccessor->rawData(), bbl, 1);
-
-    m_dabAccessor->moveTo(ipx + 1, ipy + 1);
-    bbr = quint8(kisBoundFast<quint16>(OPACITY_TRANSPARENT_U8, bbr + cs->opacityU8(m_dabAccessor->rawData()), OPACITY_OPAQUE_U8));
-    memcpy(m_dabAccessor->rawData(), color.data(), cs->pixelSize());
-    cs->setOpacity(m_dabAccessor->rawData(), bbr, 1);
+    appendPlot(DeferredPlot::Accumulate, ipx  , ipy, color, btl);
+    appendPlot(DeferredPlot::Accumulate, ipx + 1, ipy, color, btr);
+    appendPlot(DeferredPlot::Accumulate, ipx, ipy + 1, color, bbl);
+    appendPlot(DeferredPlot::Accumulate, ipx + 1, ipy + 1, color, bbr);
 }
 
 void HairyBrush::paintParticle(QPointF pos, const KoColor& color)
@@ -387,16 +424,12 @@ void HairyBrush::paintParticle(QPointF pos, const KoColor& color)
 
 inline void HairyBrush::plotPixel(int wx, int wy, const KoColor &color)
 {
-    m_dabAccessor->moveTo(wx, wy);
-    m_compositeOp->composite(m_dabAccessor->rawData(), m_pixelSize, color.data() , m_pixelSize, 0, 0, 1, 1, OPACITY_OPAQUE_F);
+    appendPlot(DeferredPlot::Composite, wx, wy, color, OPACITY_OPAQUE_U8);
 }
 
 inline void HairyBrush::darkenPixel(int wx, int wy, const KoColor &color)
 {
-    m_dabAccessor->moveTo(wx, wy);
-    if (m_dab->colorSpace()->opacityU8(m_dabAccessor->rawData()) < color.opacityU8()) {
-        memcpy(m_dabAccessor->rawData(), color.data(), m_pixelSize);
-    }
+    appendPlot(DeferredPlot::Darken, wx, wy, color, OPACITY_OPAQUE_U8);
 }
 
 double HairyBrush::computeMousePressure(double distance)
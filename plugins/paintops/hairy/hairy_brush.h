@@ -7,6 +7,7 @@
 #ifndef _HAIRY_BRUSH_H_
 #define _HAIRY_BRUSH_H_
 
+#include <QHash>
 #include <QVector>
 #include <QList>
 #include <QTransform>
@@ -74,6 +75,35 @@ public:
     void fromDabWithDensity(KisFixedPaintDeviceSP dab, qreal density);
 
 private:
+    /**
+     * A single deferred pixel write of a bristle. The bristle loop
+     * does not touch the dab device directly: the writes are bucketed
+     * by the tile they land in and applied tile by tile in
+     * flushPlots(), so that the random accessor does not thrash tile
+     * lookups when the bristles are scattered over many tiles. All
+     * the writes to one pixel land in the same bucket and keep their
+     * original order, so the composited result is exactly the same as
+     * with immediate writes.
+     */
+    struct DeferredPlot {
+        enum Type {
+            Accumulate, ///< add opacity to the present one (antialiased particles)
+            Composite,  ///< composite over with the cached composite op
+            Darken      ///< keep the most opaque of the two pixels
+        };
+
+        int x;
+        int y;
+        Type type;
+        quint8 opacity;  ///< used by Accumulate only
+        int colorOffset; ///< start of the pixel data in m_plotColors
+    };
+
+    /// queue a single pixel write into the bucket of its tile
+    void appendPlot(DeferredPlot::Type type, int wx, int wy, const KoColor &color, quint8 opacity);
+    /// apply all queued pixel writes, one tile bucket at a time
+    void flushPlots();
+
     /// paints single bristle
     void addBristleInk(Bristle *bristle,const QPointF &pos, const KoColor &color);
     /// composite single pixel to dab
@@ -115,6 +145,11 @@ private:
     const KoCompositeOp * m_compositeOp {nullptr};
     quint32 m_pixelSize {0};
 
+    QHash<quint64, QVector<DeferredPlot> > m_plotBuckets;
+    QVector<quint8> m_plotColors;
+    int m_tileWidth {64};
+    int m_tileHeight {64};
+
     int m_counter {0};
 
     double m_lastAngle {0.0};
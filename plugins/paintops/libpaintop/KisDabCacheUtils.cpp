@@ -6,10 +6,13 @@
 
 #include "KisDabCacheUtils.h"
 
+#include <QDomDocument>
+
 #include "kis_brush.h"
 #include "kis_paint_device.h"
 #include "kis_fixed_paint_device.h"
 #include "kis_color_source.h"
+#include "KisPersistentDabCache.h"
 
 #include <KisSharpnessOption.h>
 #include <kis_texture_option.h>
@@ -47,6 +50,53 @@ void generateDab(const DabGenerationInfo &di, DabRenderingResources *resources,
     KIS_SAFE_ASSERT_RECOVER_RETURN(*dab);
     const KoColorSpace *cs = (*dab)->colorSpace();
 
+    /**
+     * Solid-color dabs of cacheable brushes are shared across the
+     * strokes (and across presets using the same brush tip) through
+     * a global LRU cache, so that size/rotation jitter does not
+     * force regenerating a fresh mask for every single dab.
+     */
+    const bool persistentCacheIsApplicable =
+        !forceNormalizedRGBAImageStamp &&
+        resources->brush->brushApplication() != IMAGESTAMP &&
+        di.solidColorFill &&
+        resources->brush->supportsCaching();
+
+    KisPersistentDabCache::Key persistentKey;
+
+    if (persistentCacheIsApplicable) {
+        if (resources->persistentBrushKey.isEmpty()) {
+            /**
+             * The serialized form covers the brush parameters that
+             * are not part of the resource file (user scale, angle,
+             * lightness adjustments), the md5 covers the pixel
+             * contents of file-based brush tips
+             */
+            QDomDocument doc;
+            QDomElement e = doc.createElement("Brush");
+            resources->brush->toXML(doc, e);
+            doc.appendChild(e);
+            resources->persistentBrushKey =
+                doc.toString() + resources->brush->md5Sum(false);
+        }
+
+        persistentKey =
+            KisPersistentDabCache::makeKey(resources->persistentBrushKey,
+                                           di.paintColor,
+                                           resources->brush->brushIndex(),
+                                           di.dstDabRect.size(),
+                                           di.shape.rotation(),
+                                           di.subPixel,
+                                           di.softnessFactor,
+                                           di.lightnessStrength,
+                                           di.shape.ratio(),
+                                           di.mirrorProperties.horizontalMirror,
+                                           di.mirrorProperties.verticalMirror);
+
+        if (KisPersistentDabCache::instance()->fetchDab(persistentKey, *dab)) {
+            return;
+        }
+    }
 
     if (forceNormalizedRGBAImageStamp || resources->brush->brushApplication() == IMAGESTAMP) {
         *dab = resources->brush->paintDevice(cs, di.shape, di.info,
@@ -88,6 +138,10 @@ void generateDab(const DabGenerationInfo &di, DabRenderingResources *resources,
         (*dab)->mirror(di.mirrorProperties.horizontalMirror,
                        di.mirrorProperties.verticalMirror);
     }
+
+    if (persistentCacheIsApplicable) {
+        KisPersistentDabCache::instance()->storeDab(persistentKey, *dab);
+    }
 }
 
 void postProcessDab(KisFixedPaintDeviceSP dab,
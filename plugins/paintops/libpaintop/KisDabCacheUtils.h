@@ -46,6 +46,12 @@ struct PAINTOP_EXPORT DabRenderingResources
 
     KisPaintDeviceSP colorSourceDevice;
 
+    /**
+     * Identity of the brush tip contents for the persistent dab
+     * cache. Calculated lazily by generateDab() on the first dab.
+     */
+    QString persistentBrushKey;
+
 private:
     DabRenderingResources(const DabRenderingResources &rhs) = delete;
 };
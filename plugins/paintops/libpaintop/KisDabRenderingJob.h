@@ -11,12 +11,12 @@
 #include <KisDabCacheUtils.h>
 #include <kis_fixed_paint_device.h>
 #include <kis_types.h>
-#include "kritadefaultpaintops_export.h"
+#include "kritapaintop_export.h"
 
 class KisDabRenderingQueue;
 class KisRunnableStrokeJobsInterface;
 
-class KRITADEFAULTPAINTOPS_EXPORT KisDabRenderingJob
+class PAINTOP_EXPORT KisDabRenderingJob
 {
 public:
     enum JobType {
@@ -55,7 +55,7 @@ public:
 #include <QSharedPointer>
 typedef QSharedPointer<KisDabRenderingJob> KisDabRenderingJobSP;
 
-class KRITADEFAULTPAINTOPS_EXPORT KisDabRenderingJobRunner : public QRunnable
+class PAINTOP_EXPORT KisDabRenderingJobRunner : public QRunnable
 {
 public:
     KisDabRenderingJobRunner(KisDabRenderingJobSP job,
@@ -15,6 +15,7 @@
 #include <QMutex>
 #include <QMutexLocker>
 #include <KisRollingMeanAccumulatorWrapper.h>
+#include <KisStrokeLatencyTracer.h>
 
 #include "kis_algebra_2d.h"
 
@@ -175,6 +176,8 @@ KisDabRenderingJobSP KisDabRenderingQueue::addDab(const KisDabCacheUtils::DabReq
 
     m_d->jobs.append(job);
 
+    KisStrokeLatencyTracer::instance()->traceStage(KisStrokeLatencyTracer::DabQueued);
+
     KisDabRenderingJobSP jobToRun;
     if (job->status == KisDabRenderingJob::Running) {
         jobToRun = job;
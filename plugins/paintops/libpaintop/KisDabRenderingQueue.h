@@ -9,7 +9,7 @@
 
 #include <QScopedPointer>
 
-#include "kritadefaultpaintops_export.h"
+#include "kritapaintop_export.h"
 
 #include <QList>
 class KisDabRenderingJob;
@@ -17,7 +17,7 @@ struct KisRenderedDab;
 
 #include "KisDabCacheUtils.h"
 
-class KRITADEFAULTPAINTOPS_EXPORT KisDabRenderingQueue
+class PAINTOP_EXPORT KisDabRenderingQueue
 {
 public:
     struct CacheInterface {
@@ -0,0 +1,296 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisDabRenderingUpdateHelper.h"
+
+#include <QElapsedTimer>
+
+#include "kis_debug.h"
+#include "kis_painter.h"
+#include "kis_paint_device.h"
+#include "kis_default_bounds_base.h"
+#include "kis_image_config.h"
+#include "kis_wrapped_rect.h"
+#include "krita_utils.h"
+#include <brushengine/kis_paintop_utils.h>
+#include <KisRollingMeanAccumulatorWrapper.h>
+
+#include "KisDabRenderingExecutor.h"
+#include <KisRenderedDab.h>
+
+#include <KisRunnableStrokeJobData.h>
+#include <KisRunnableStrokeJobUtils.h>
+
+struct KisDabRenderingUpdateHelper::Private
+{
+    Private()
+        : avgSpacing(50),
+          avgNumDabs(50),
+          avgUpdateTimePerDab(50),
+          idealNumRects(KisImageConfig(true).maxNumberOfThreads()),
+          minUpdatePeriod(10),
+          maxUpdatePeriod(100)
+    {
+    }
+
+    QScopedPointer<KisDabRenderingExecutor> dabExecutor;
+    UpdateSharedStateSP updateSharedState;
+
+    qreal currentUpdatePeriod = 20.0;
+    KisRollingMeanAccumulatorWrapper avgSpacing;
+    KisRollingMeanAccumulatorWrapper avgNumDabs;
+    KisRollingMeanAccumulatorWrapper avgUpdateTimePerDab;
+
+    const int idealNumRects;
+
+    const int minUpdatePeriod;
+    const int maxUpdatePeriod;
+};
+
+struct KisDabRenderingUpdateHelper::UpdateSharedState
+{
+    // rendering data
+    KisPainter *painter = 0;
+    QList<KisRenderedDab> dabsQueue;
+
+    // speed metrics
+    QVector<QPointF> dabPoints;
+    QElapsedTimer dabRenderingTimer;
+
+    // final report
+    QVector<QRect> allDirtyRects;
+};
+
+KisDabRenderingUpdateHelper::KisDabRenderingUpdateHelper(const KoColorSpace *cs,
+                                                         KisDabCacheUtils::ResourcesFactory resourcesFactory,
+                                                         KisRunnableStrokeJobsInterface *runnableJobsInterface,
+                                                         KisMirrorOption *mirrorOption,
+                                                         KisPrecisionOption *precisionOption)
+    : m_d(new Private())
+{
+    m_d->dabExecutor.reset(
+        new KisDabRenderingExecutor(cs,
+                                    resourcesFactory,
+                                    runnableJobsInterface,
+                                    mirrorOption,
+                                    precisionOption));
+}
+
+KisDabRenderingUpdateHelper::~KisDabRenderingUpdateHelper()
+{
+}
+
+void KisDabRenderingUpdateHelper::addDab(const KisDabCacheUtils::DabRequestInfo &request,
+                                         qreal opacity, qreal flow)
+{
+    m_d->dabExecutor->addDab(request, opacity, flow);
+}
+
+void KisDabRenderingUpdateHelper::notifyDabSpacing(qreal spacingScalarApprox)
+{
+    m_d->avgSpacing(spacingScalarApprox);
+}
+
+void KisDabRenderingUpdateHelper::addMirroringJobs(Qt::Orientation direction,
+                                                   QVector<QRect> &rects,
+                                                   UpdateSharedStateSP state,
+                                                   QVector<KisRunnableStrokeJobData*> &jobs)
+{
+    KritaUtils::addJobSequential(jobs, nullptr);
+
+    /**
+     * Some KisRenderedDab may share their devices, so we should mirror them
+     * carefully, avoiding doing that twice. KisDabRenderingQueue is implemented in
+     * a way that duplicated dabs can go only sequentially, one after another, so
+     * we don't have to use complex deduplication algorithms here.
+     */
+    KisFixedPaintDeviceSP prevDabDevice = 0;
+    for (KisRenderedDab &dab : state->dabsQueue) {
+        const bool skipMirrorPixels = prevDabDevice && prevDabDevice == dab.device;
+
+        KritaUtils::addJobConcurrent(jobs,
+            [state, &dab, direction, skipMirrorPixels] () {
+                state->painter->mirrorDab(direction, &dab, skipMirrorPixels);
+            }
+        );
+
+        prevDabDevice = dab.device;
+    }
+
+    KritaUtils::addJobSequential(jobs, nullptr);
+
+    for (QRect &rc : rects) {
+        state->painter->mirrorRect(direction, &rc);
+
+        KritaUtils::addJobConcurrent(jobs,
+            [rc, state] () {
+                state->painter->bltFixed(rc, state->dabsQueue);
+            }
+        );
+    }
+
+    state->allDirtyRects.append(rects);
+}
+
+std::pair<int, bool> KisDabRenderingUpdateHelper::doAsynchronousUpdate(KisPainter *painter,
+                                                                       QVector<KisRunnableStrokeJobData*> &jobs)
+{
+    bool someDabsAreStillInQueue = false;
+    const bool hasPreparedDabsAtStart = m_d->dabExecutor->hasPreparedDabs();
+
+    if (!m_d->updateSharedState && hasPreparedDabsAtStart) {
+
+        m_d->updateSharedState = toQShared(new UpdateSharedState());
+        UpdateSharedStateSP state = m_d->updateSharedState;
+
+        state->painter = painter;
+
+        {
+            const qreal dabRenderingTime = m_d->dabExecutor->averageDabRenderingTime();
+            const qreal totalRenderingTimePerDab = dabRenderingTime + m_d->avgUpdateTimePerDab.rollingMeanSafe();
+
+            // we limit the number of fetched dabs to fit the maximum update period and not
+            // make visual hiccups
+            const int dabsLimit =
+                totalRenderingTimePerDab > 0 ?
+                    qMax(10, int(m_d->maxUpdatePeriod / totalRenderingTimePerDab * m_d->idealNumRects)) :
+                    -1;
+
+            state->dabsQueue = m_d->dabExecutor->takeReadyDabs(painter->hasMirroring(), dabsLimit, &someDabsAreStillInQueue);
+        }
+
+        KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(!state->dabsQueue.isEmpty(),
+                                             std::make_pair(int(m_d->currentUpdatePeriod), false));
+
+        const int diameter = m_d->dabExecutor->averageDabSize();
+        const qreal spacing = m_d->avgSpacing.rollingMean();
+
+        const int idealNumRects = m_d->idealNumRects;
+
+        QVector<QRect> rects;
+
+        // wrap the dabs if needed
+        if (painter->device()->defaultBounds()->wrapAroundMode()) {
+            /**
+             * In WA mode we do two things:
+             *
+             * 1) We ensure that the parallel threads do not access the same are on
+             *    the image. For normal updates that is ensured by the code in KisImage
+             *    and the scheduler. Here we should do that manually by adjusting 'rects'
+             *    so that they would not intersect in the wrapped space.
+             *
+             * 2) We duplicate dabs, to ensure that all the pieces of dabs are painted
+             *    inside the wrapped rect. No pieces are dabs are painted twice, because
+             *    we paint only the parts intersecting the wrap rect.
+             */
+
+            const QRect wrapRect = painter->device()->defaultBounds()->imageBorderRect();
+            const WrapAroundAxis wrapAroundModeAxis = painter->device()->defaultBounds()->wrapAroundModeAxis();
+
+            QList<KisRenderedDab> wrappedDabs;
+
+            Q_FOREACH (const KisRenderedDab &dab, state->dabsQueue) {
+                const QVector<QPoint> normalizationOrigins =
+                    KisWrappedRect::normalizationOriginsForRect(dab.realBounds(), wrapRect, wrapAroundModeAxis);
+
+                Q_FOREACH(const QPoint &pt, normalizationOrigins) {
+                    KisRenderedDab newDab = dab;
+
+                    newDab.offset = pt;
+                    rects.append(KisWrappedRect::clipToWrapRect(newDab.realBounds(), wrapRect, wrapAroundModeAxis));
+                    wrappedDabs.append(newDab);
+                }
+            }
+
+            state->dabsQueue = wrappedDabs;
+
+        } else {
+            // just get all rects
+            Q_FOREACH (const KisRenderedDab &dab, state->dabsQueue) {
+                rects.append(dab.realBounds());
+            }
+        }
+
+        // split/merge rects into non-overlapping areas
+        rects = KisPaintOpUtils::splitDabsIntoRects(rects,
+                                                    idealNumRects, diameter, spacing);
+
+        state->allDirtyRects = rects;
+
+        Q_FOREACH (const KisRenderedDab &dab, state->dabsQueue) {
+            state->dabPoints.append(dab.realBounds().center());
+        }
+
+        state->dabRenderingTimer.start();
+
+        Q_FOREACH (const QRect &rc, rects) {
+            KritaUtils::addJobConcurrent(jobs,
+                [rc, state] () {
+                    state->painter->bltFixed(rc, state->dabsQueue);
+                }
+            );
+        }
+
+        /**
+         * After the dab has been rendered once, we should mirror it either one
+         * (h __or__ v) or three (h __and__ v) times. This sequence of 'if's achieves
+         * the goal without any extra copying. Please note that it has __no__ 'else'
+         * branches, which is done intentionally!
+         */
+        if (state->painter->hasHorizontalMirroring()) {
+            addMirroringJobs(Qt::Horizontal, rects, state, jobs);
+        }
+
+        if (state->painter->hasVerticalMirroring()) {
+            addMirroringJobs(Qt::Vertical, rects, state, jobs);
+        }
+
+        if (state->painter->hasHorizontalMirroring() && state->painter->hasVerticalMirroring()) {
+            addMirroringJobs(Qt::Horizontal, rects, state, jobs);
+        }
+
+        KritaUtils::addJobSequential(jobs,
+                [state, this, someDabsAreStillInQueue] () {
+                    Q_FOREACH(const QRect &rc, state->allDirtyRects) {
+                        state->painter->addDirtyRect(rc);
+                    }
+
+                    state->painter->setAverageOpacity(state->dabsQueue.last().averageOpacity);
+
+                    const int updateRenderingTime = state->dabRenderingTimer.elapsed();
+                    const qreal dabRenderingTime = m_d->dabExecutor->averageDabRenderingTime();
+
+                    m_d->avgNumDabs(state->dabsQueue.size());
+
+                    const qreal currentUpdateTimePerDab = qreal(updateRenderingTime) / state->dabsQueue.size();
+                    m_d->avgUpdateTimePerDab(currentUpdateTimePerDab);
+
+                    /**
+                     * NOTE: using currentUpdateTimePerDab in the calculation for the next update time instead
+                     *       of the average one makes rendering speed about 40% faster. It happens because the
+                     *       adaptation period is shorter than if it used
+                     */
+                    const qreal totalRenderingTimePerDab = dabRenderingTime + currentUpdateTimePerDab;
+
+                    const int approxDabRenderingTime =
+                        qreal(totalRenderingTimePerDab) * m_d->avgNumDabs.rollingMean() / m_d->idealNumRects;
+
+                    m_d->currentUpdatePeriod =
+                        someDabsAreStillInQueue ? m_d->minUpdatePeriod :
+                        qBound(m_d->minUpdatePeriod, int(1.5 * approxDabRenderingTime), m_d->maxUpdatePeriod);
+
+                    // release all the dab devices
+                    state->dabsQueue.clear();
+
+                    m_d->updateSharedState.clear();
+                }
+        );
+    } else if (m_d->updateSharedState && hasPreparedDabsAtStart) {
+        someDabsAreStillInQueue = true;
+    }
+
+    return std::make_pair(int(m_d->currentUpdatePeriod), someDabsAreStillInQueue);
+}
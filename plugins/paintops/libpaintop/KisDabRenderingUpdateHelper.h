@@ -0,0 +1,85 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISDABRENDERINGUPDATEHELPER_H
+#define KISDABRENDERINGUPDATEHELPER_H
+
+#include "kritapaintop_export.h"
+
+#include <QScopedPointer>
+#include <QVector>
+#include <utility>
+
+#include "KisDabCacheUtils.h"
+
+class KoColorSpace;
+class KisPainter;
+class KisMirrorOption;
+class KisPrecisionOption;
+class KisRunnableStrokeJobData;
+class KisRunnableStrokeJobsInterface;
+
+/**
+ * A helper that drives KisDabRenderingExecutor on behalf of a
+ * brush-based paintop. It owns the executor, gathers the statistics
+ * about dab spacing and rendering times, and converts the dabs that
+ * the executor has prepared into concurrent composition and mirroring
+ * jobs inside doAsynchronousUpdate().
+ *
+ * The logic used to live inside KisBrushOp; it was extracted into
+ * libpaintop so that other engines can reuse the multithreaded dab
+ * pipeline: the paintop calls addDab() from its paintAt() override
+ * and forwards KisPaintOp::doAsynchronousUpdate() to the helper
+ * (which requires KisPaintOpSettings::needsAsynchronousUpdates() to
+ * return true for the engine's settings).
+ */
+class PAINTOP_EXPORT KisDabRenderingUpdateHelper
+{
+public:
+    KisDabRenderingUpdateHelper(const KoColorSpace *cs,
+                                KisDabCacheUtils::ResourcesFactory resourcesFactory,
+                                KisRunnableStrokeJobsInterface *runnableJobsInterface,
+                                KisMirrorOption *mirrorOption = 0,
+                                KisPrecisionOption *precisionOption = 0);
+    ~KisDabRenderingUpdateHelper();
+
+    /**
+     * Queues a dab for rendering in the executor's worker jobs
+     */
+    void addDab(const KisDabCacheUtils::DabRequestInfo &request,
+                qreal opacity, qreal flow);
+
+    /**
+     * Reports the effective spacing of the dab that has just been
+     * queued. The rolling mean of the spacing is used for splitting
+     * the dirty area into update rects.
+     */
+    void notifyDabSpacing(qreal spacingScalarApprox);
+
+    /**
+     * Implements KisPaintOp::doAsynchronousUpdate() for the owning
+     * paintop: composes the ready dabs onto \p painter's device using
+     * the passed jobs list. Returns the desired next update period
+     * and whether some dabs are still left in the queue.
+     */
+    std::pair<int, bool> doAsynchronousUpdate(KisPainter *painter,
+                                              QVector<KisRunnableStrokeJobData*> &jobs);
+
+private:
+    struct UpdateSharedState;
+    typedef QSharedPointer<UpdateSharedState> UpdateSharedStateSP;
+
+    void addMirroringJobs(Qt::Orientation direction,
+                          QVector<QRect> &rects,
+                          UpdateSharedStateSP state,
+                          QVector<KisRunnableStrokeJobData*> &jobs);
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISDABRENDERINGUPDATEHELPER_H
@@ -0,0 +1,182 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisPersistentDabCache.h"
+
+#include <climits>
+#include <cmath>
+
+#include <QCache>
+#include <QGlobalStatic>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <KoColorSpace.h>
+#include <kis_fixed_paint_device.h>
+#include <kis_image_config.h>
+
+namespace {
+
+struct CachedDab {
+    KisFixedPaintDeviceSP device;
+};
+
+inline int dabCostKiB(KisFixedPaintDeviceSP dab)
+{
+    const QRect bounds = dab->bounds();
+    const qint64 bytes =
+        qint64(bounds.width()) * bounds.height() * dab->pixelSize();
+    return int(qMin<qint64>(bytes / 1024 + 1, INT_MAX));
+}
+
+}
+
+struct KisPersistentDabCache::Private
+{
+    QMutex mutex;
+    QCache<Key, CachedDab> cache;
+};
+
+bool KisPersistentDabCache::Key::operator==(const Key &rhs) const
+{
+    return brushKey == rhs.brushKey &&
+        color == rhs.color &&
+        brushIndex == rhs.brushIndex &&
+        sizeBucketX == rhs.sizeBucketX &&
+        sizeBucketY == rhs.sizeBucketY &&
+        angleBucket == rhs.angleBucket &&
+        subPixelXBucket == rhs.subPixelXBucket &&
+        subPixelYBucket == rhs.subPixelYBucket &&
+        softnessBucket == rhs.softnessBucket &&
+        lightnessBucket == rhs.lightnessBucket &&
+        ratioBucket == rhs.ratioBucket &&
+        horizontalMirror == rhs.horizontalMirror &&
+        verticalMirror == rhs.verticalMirror;
+}
+
+uint qHash(const KisPersistentDabCache::Key &key)
+{
+    return qHash(key.brushKey) ^
+        qHashBits(key.color.data(), key.color.colorSpace()->pixelSize()) ^
+        (key.brushIndex << 1) ^
+        (uint(key.sizeBucketX) << 2) ^
+        (uint(key.sizeBucketY) << 10) ^
+        (uint(key.angleBucket) << 18) ^
+        uint(key.subPixelXBucket + (key.subPixelYBucket << 4)) ^
+        (uint(key.softnessBucket) << 24) ^
+        (uint(key.lightnessBucket) << 16) ^
+        (uint(key.ratioBucket) << 8) ^
+        (uint(key.horizontalMirror) << 30) ^
+        (uint(key.verticalMirror) << 31);
+}
+
+namespace {
+
+/**
+ * Small dabs are kept at exact integer size: a one-pixel difference
+ * is clearly visible there and subpixel positioning matters. Big dabs
+ * are grouped into 2% geometric buckets, which is below the size
+ * tolerance of the lower precision levels.
+ */
+inline int quantizeSize(int size)
+{
+    return size <= 50 ?
+        size :
+        1000 + qRound(std::log(qreal(size)) / std::log(1.02));
+}
+
+}
+
+KisPersistentDabCache::Key
+KisPersistentDabCache::makeKey(const QString &brushKey,
+                               const KoColor &color,
+                               quint32 brushIndex,
+                               const QSize &dabSize,
+                               qreal angle,
+                               const QPointF &subPixel,
+                               qreal softnessFactor,
+                               qreal lightnessStrength,
+                               qreal ratio,
+                               bool horizontalMirror,
+                               bool verticalMirror)
+{
+    Key key;
+    key.brushKey = brushKey;
+    key.color = color;
+    key.brushIndex = brushIndex;
+    key.sizeBucketX = quantizeSize(dabSize.width());
+    key.sizeBucketY = quantizeSize(dabSize.height());
+    key.angleBucket = qRound(angle / (M_PI / 180)); // 1 degree
+    key.subPixelXBucket = qRound(subPixel.x() * 2); // 0.5 pixel
+    key.subPixelYBucket = qRound(subPixel.y() * 2);
+    key.softnessBucket = qRound(softnessFactor * 100);
+    key.lightnessBucket = qRound(lightnessStrength * 100);
+    key.ratioBucket = qRound(ratio * 100);
+    key.horizontalMirror = horizontalMirror;
+    key.verticalMirror = verticalMirror;
+
+    return key;
+}
+
+KisPersistentDabCache::KisPersistentDabCache()
+    : m_d(new Private)
+{
+    // the cost of the entries is counted in KiB
+    m_d->cache.setMaxCost(qBound(8, KisImageConfig::totalRAM() / 128, 64) * 1024);
+}
+
+KisPersistentDabCache::~KisPersistentDabCache()
+{
+}
+
+Q_GLOBAL_STATIC(KisPersistentDabCache, s_instance)
+
+KisPersistentDabCache* KisPersistentDabCache::instance()
+{
+    return s_instance;
+}
+
+bool KisPersistentDabCache::fetchDab(const Key &key, KisFixedPaintDeviceSP dstDevice)
+{
+    QMutexLocker locker(&m_d->mutex);
+
+    CachedDab *entry = m_d->cache.object(key);
+    if (!entry) return false;
+
+    KisFixedPaintDeviceSP cachedDevice = entry->device;
+    if (*cachedDevice->colorSpace() != *dstDevice->colorSpace()) return false;
+
+    dstDevice->setRect(cachedDevice->bounds());
+    dstDevice->lazyGrowBufferWithoutInitialization();
+    memcpy(dstDevice->data(), cachedDevice->constData(),
+           size_t(cachedDevice->bounds().width()) *
+           cachedDevice->bounds().height() * cachedDevice->pixelSize());
+
+    return true;
+}
+
+void KisPersistentDabCache::storeDab(const Key &key, KisFixedPaintDeviceSP dab)
+{
+    const int cost = dabCostKiB(dab);
+
+    /**
+     * The copy is allocated with the default allocator on purpose:
+     * keeping a reference to the stroke's pooled buffer would keep
+     * the whole pool alive after the stroke has ended.
+     */
+    KisFixedPaintDeviceSP copy = new KisFixedPaintDevice(dab->colorSpace());
+    copy->setRect(dab->bounds());
+    copy->lazyGrowBufferWithoutInitialization();
+    memcpy(copy->data(), dab->constData(),
+           size_t(dab->bounds().width()) *
+           dab->bounds().height() * dab->pixelSize());
+
+    CachedDab *entry = new CachedDab{copy};
+
+    QMutexLocker locker(&m_d->mutex);
+    // insert() takes ownership and deletes the entry when it does not fit
+    m_d->cache.insert(key, entry, cost);
+}
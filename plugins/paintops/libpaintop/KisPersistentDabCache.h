@@ -0,0 +1,100 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISPERSISTENTDABCACHE_H
+#define KISPERSISTENTDABCACHE_H
+
+#include <QScopedPointer>
+#include <QString>
+
+#include <KoColor.h>
+#include <kis_types.h>
+
+#include "kritapaintop_export.h"
+
+/**
+ * A process-wide LRU cache of rendered dabs that survives the end of
+ * the stroke. KisDabCache itself remembers only the very last dab, so
+ * any size or rotation jitter makes it regenerate the mask for every
+ * single dab. This cache keys the dabs on the full set of mask
+ * parameters, quantized to a precision that is not visible in the
+ * result, so mildly jittered stamp brushes keep hitting dabs rendered
+ * during the previous strokes.
+ *
+ * The cached devices are deep copies allocated outside the stroke's
+ * memory pool, so they do not pin the pool after the stroke has
+ * ended. The total size of the cache is derived from the amount of
+ * RAM reported by KisImageConfig.
+ */
+class PAINTOP_EXPORT KisPersistentDabCache
+{
+public:
+    struct Key {
+        /// identifies the brush tip contents (md5 of the resource or
+        /// the serialized form of an auto brush)
+        QString brushKey;
+        KoColor color;
+        quint32 brushIndex = 0;
+        int sizeBucketX = 0;
+        int sizeBucketY = 0;
+        int angleBucket = 0;
+        int subPixelXBucket = 0;
+        int subPixelYBucket = 0;
+        int softnessBucket = 0;
+        int lightnessBucket = 0;
+        int ratioBucket = 0;
+        bool horizontalMirror = false;
+        bool verticalMirror = false;
+
+        bool operator==(const Key &rhs) const;
+    };
+
+    /**
+     * Builds a key with all the real-valued parameters quantized to
+     * buckets. Two parameter sets that fall into the same bucket
+     * produce dabs that are not distinguishable in the painted
+     * result (the tolerances match the lower precision levels of
+     * KisPrecisionOption).
+     */
+    static Key makeKey(const QString &brushKey,
+                       const KoColor &color,
+                       quint32 brushIndex,
+                       const QSize &dabSize,
+                       qreal angle,
+                       const QPointF &subPixel,
+                       qreal softnessFactor,
+                       qreal lightnessStrength,
+                       qreal ratio,
+                       bool horizontalMirror,
+                       bool verticalMirror);
+
+    KisPersistentDabCache();
+    ~KisPersistentDabCache();
+
+    static KisPersistentDabCache* instance();
+
+    /**
+     * Copies a cached dab into \p dstDevice. Returns false when no
+     * compatible dab is cached. \p dstDevice must exist and its color
+     * space defines what is considered "compatible".
+     */
+    bool fetchDab(const Key &key, KisFixedPaintDeviceSP dstDevice);
+
+    /**
+     * Stores a deep copy of \p dab in the cache, possibly evicting
+     * the least recently used entries to stay within the memory
+     * budget. Dabs bigger than the whole budget are silently skipped.
+     */
+    void storeDab(const Key &key, KisFixedPaintDeviceSP dab);
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+uint qHash(const KisPersistentDabCache::Key &key);
+
+#endif /* KISPERSISTENTDABCACHE_H */
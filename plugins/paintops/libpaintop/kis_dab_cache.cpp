@@ -10,6 +10,7 @@
 #include "kis_paint_device.h"
 #include "kis_brush.h"
 #include <kis_fixed_paint_device.h>
+#include <KisOptimizedByteArray.h>
 #include "kis_color_source.h"
 #include "KisSharpnessOption.h"
 #include "kis_texture_option.h"
@@ -19,7 +20,8 @@
 struct KisDabCache::Private {
 
     Private(KisBrushSP brush)
-        : brush(brush)
+        : brush(brush),
+          paintDeviceAllocator(new KisOptimizedByteArray::PooledMemoryAllocator())
     {}
 
     int seqNo = 0;
@@ -27,6 +29,13 @@ struct KisDabCache::Private {
     KisFixedPaintDeviceSP dab;
     KisFixedPaintDeviceSP dabOriginal;
 
+    /**
+     * The dab cache lives exactly as long as the stroke does, so the
+     * pooled buffers of the dab devices are released wholesale when
+     * the stroke ends
+     */
+    KisOptimizedByteArray::MemoryAllocatorSP paintDeviceAllocator;
+
     KisBrushSP brush;
     KisPaintDeviceSP colorSourceDevice;
 
@@ -167,7 +176,7 @@ KisFixedPaintDeviceSP KisDabCache::fetchDabCommon(const KoColorSpace *cs,
     bool hasDabInCache = true;
 
     if (!m_d->dab || *m_d->dab->colorSpace() != *cs) {
-        m_d->dab = new KisFixedPaintDevice(cs);
+        m_d->dab = new KisFixedPaintDevice(cs, m_d->paintDeviceAllocator);
         hasDabInCache = false;
     }
 
@@ -219,15 +228,25 @@ KisFixedPaintDeviceSP KisDabCache::fetchDabCommon(const KoColorSpace *cs,
 
     generateDab(di, &resources, &m_d->dab, forceNormalizedRGBAImageStamp);
 
+    /**
+     * A hit in the persistent dab cache may return a dab from a
+     * neighboring size bucket, so recenter the destination rect
+     * around the real dab size (the same way as the dab rendering
+     * queue does in KisDabRenderingJob::dstDabOffset())
+     */
+    if (m_d->dab->bounds().size() != di.dstDabRect.size()) {
+        *dstDabRect = correctDabRectWhenFetchedFromCache(*dstDabRect, m_d->dab->bounds().size());
+    }
+
     // 4. Do postprocessing
     if (di.needsPostprocessing) {
         if (!m_d->dabOriginal || *cs != *m_d->dabOriginal->colorSpace()) {
-            m_d->dabOriginal = new KisFixedPaintDevice(cs);
+            m_d->dabOriginal = new KisFixedPaintDevice(cs, m_d->paintDeviceAllocator);
         }
 
         *m_d->dabOriginal = *m_d->dab;
 
-        postProcessDab(m_d->dab, di.dstDabRect.topLeft(), info, &resources);
+        postProcessDab(m_d->dab, dstDabRect->topLeft(), info, &resources);
     }
 
     return m_d->dab;
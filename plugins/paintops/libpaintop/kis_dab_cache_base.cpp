@@ -276,6 +276,16 @@ void KisDabCacheBase::fetchDabGenerationInfo(bool hasDabInCache,
         const int effectiveDabSize = qMin(newParams.width, newParams.height);
         precisionLevel = m_d->precisionOption->effectivePrecisionLevel(effectiveDabSize) - 1;
     }
+
+    /**
+     * Precision levels 1..4 accept a cached dab whose angle deviates
+     * up to one degree from the requested one (see precisionLevels
+     * above), so the brush is also allowed to render the dab from its
+     * cache of prerotated tip images. The exact level 5 keeps the
+     * precise per-dab transform.
+     */
+    resources->brush->setApproximateTransformationsAllowed(precisionLevel < 4);
+
     *shouldUseCache = hasDabInCache && supportsCaching && di->solidColorFill &&
             newParams.compare(m_d->lastSavedDabParameters, precisionLevel);
 
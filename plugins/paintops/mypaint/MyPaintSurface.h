@@ -15,6 +15,7 @@
 #include <kis_paint_information.h>
 #include <kis_lod_transform.h>
 #include <KoColor.h>
+#include <kis_algebra_2d.h>
 #include <kis_marker_painter.h>
 #include <kis_sequential_iterator.h>
 #include <KisOverlayPaintDeviceWrapper.h>
@@ -53,6 +54,45 @@ public:
                                     float color_b, float opaque, float hardness, float color_a,
                                     float aspect_ratio, float angle, float lock_alpha, float colorize);
 
+    /**
+     * Per-dab constants shared by all the pixel spans of one
+     * draw_dab() call, precomputed once per dab instead of being
+     * recalculated per pixel.
+     */
+    struct DabSpanParams {
+        float x;
+        float y;
+        float color_r;
+        float color_g;
+        float color_b;
+        float color_a;
+        float opaque;
+        float hardness;
+        float aspect_ratio;
+        float sn;
+        float cs;
+        float one_over_radius2;
+        float r_aa_start;
+        float segment1_slope;
+        float segment2_slope;
+        float normal_mode;
+        float colorize;
+        bool eraser;
+        bool useAntialiasing;
+    };
+
+    /**
+     * Processes one run of consequent pixels of a dab that belongs to
+     * a single tile row: first the dab's opacity profile is calculated
+     * for the whole run in a tight loop, then the color blending is
+     * applied to the pixels the dab actually touches.
+     */
+    template <typename channelType>
+    void processDabSpan(channelType *nativeArray, quint8 *maskPointer,
+                        int startX, int y, int numPixels,
+                        const KisAlgebra2D::OuterCircle &outer,
+                        const DabSpanParams &params);
+
     template <typename channelType>
     void getColorImpl(MyPaintSurface *self, float x, float y, float radius,
                                 float * color_r, float * color_g, float * color_b, float * color_a);
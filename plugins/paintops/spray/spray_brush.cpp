@@ -8,6 +8,7 @@
 
 #include <KoColor.h>
 #include <KoColorSpace.h>
+#include <KoColorSpaceConstants.h>
 #include <KoColorTransformation.h>
 #include <KoCompositeOp.h>
 #include <KoMixColorsOp.h>
@@ -219,6 +220,25 @@ void SprayBrush::paintImpl(KisPaintDeviceSP dab, KisPaintDeviceSP source,
     m.rotateRadians(-rotation + deg2rad(m_sprayOpOption->data.brushRotation));
     m.scale(m_sprayOpOption->data.scale, m_sprayOpOption->data.scale);
 
+    /**
+     * When the particle color stays the same for the whole dab and is
+     * fully opaque, the geometric shapes can be accumulated into one
+     * winding-fill path and rasterized with a single fillPainterPath()
+     * call: repeated opaque fills of one color are equivalent to a
+     * single fill of their union, while the fill machinery setup is
+     * paid once per dab instead of once per particle. Translucent or
+     * per-particle colors keep the per-particle compositing, where
+     * overlapping particles accumulate.
+     */
+    const bool tryBatchShapeParticles =
+        m_shapeProperties->enabled &&
+        (m_shapeProperties->shape == 0 || m_shapeProperties->shape == 1) &&
+        !m_colorProperties->colorPerParticle &&
+        !m_colorProperties->useRandomOpacity;
+
+    QPainterPath batchedShapesPath;
+    batchedShapesPath.setFillRule(Qt::WindingFill);
+
     for (quint32 i = 0; i < m_particlesCount; i++) {
         // generate random angle
         angle = angularDistribution(randomSource) * M_PI * 2;
@@ -305,23 +325,39 @@ void SprayBrush::paintImpl(KisPaintDeviceSP dab, KisPaintDeviceSP source,
         qreal jitteredWidth = qMax(1.0 * additionalScale, effectiveSize.width() * particleScale * additionalScale);
         qreal jitteredHeight = qMax(1.0 * additionalScale, effectiveSize.height() * particleScale * additionalScale);
 
+        const bool batchShapeParticles =
+            tryBatchShapeParticles &&
+            m_inkColor.opacityU8() == OPACITY_OPAQUE_U8;
+
         if (m_shapeProperties->enabled){
         switch (m_shapeProperties->shape){
             // ellipse
             case 0:
             {
                 if (effectiveSize.width() == effectiveSize.height()){
-                    paintCircle(m_painter, nx + x, ny + y, jitteredWidth * 0.5);
+                    if (batchShapeParticles) {
+                        batchedShapesPath.addPath(makeCirclePath(nx + x, ny + y, jitteredWidth * 0.5));
+                    } else {
+                        paintCircle(m_painter, nx + x, ny + y, jitteredWidth * 0.5);
+                    }
                 }
                 else {
-                    paintEllipse(m_painter, nx + x, ny + y, jitteredWidth * 0.5 , jitteredHeight * 0.5, rotationZ);
+                    if (batchShapeParticles) {
+                        batchedShapesPath.addPath(makeEllipsePath(nx + x, ny + y, jitteredWidth * 0.5, jitteredHeight * 0.5, rotationZ));
+                    } else {
+                        paintEllipse(m_painter, nx + x, ny + y, jitteredWidth * 0.5 , jitteredHeight * 0.5, rotationZ);
+                    }
                 }
                 break;
             }
             // rectangle
             case 1:
             {
-                paintRectangle(m_painter, nx + x, ny + y, qRound(jitteredWidth) , qRound(jitteredHeight), rotationZ);
+                if (batchShapeParticles) {
+                    batchedShapesPath.addPath(makeRectanglePath(nx + x, ny + y, qRound(jitteredWidth), qRound(jitteredHeight), rotationZ));
+                } else {
+                    paintRectangle(m_painter, nx + x, ny + y, qRound(jitteredWidth) , qRound(jitteredHeight), rotationZ);
+                }
                 break;
             }
             // wu-particle
@@ -410,6 +446,11 @@ void SprayBrush::paintImpl(KisPaintDeviceSP dab, KisPaintDeviceSP source,
             m_inkColor=color;//reset color//
         }
     }
+
+    if (!batchedShapesPath.isEmpty()) {
+        m_painter->fillPainterPath(batchedShapesPath);
+    }
+
     // recover from jittering of color,
     // m_inkColor.opacity is recovered with every paint
 }
@@ -453,34 +494,47 @@ void SprayBrush::paintParticle(KisRandomAccessorSP &writeAccessor, const KoColor
     memcpy(writeAccessor->rawData(), pcolor.data(), m_dabPixelSize);
 }
 
-void SprayBrush::paintCircle(KisPainter* painter, qreal x, qreal y, qreal radius)
+QPainterPath SprayBrush::makeCirclePath(qreal x, qreal y, qreal radius) const
 {
     QPainterPath path;
     path.addEllipse(QPointF(x,y),radius,radius);
-    painter->fillPainterPath(path);
+    return path;
 }
 
-
-void SprayBrush::paintEllipse(KisPainter* painter, qreal x, qreal y, qreal a, qreal b, qreal angle)
+QPainterPath SprayBrush::makeEllipsePath(qreal x, qreal y, qreal a, qreal b, qreal angle) const
 {
     QPainterPath path;
     path.addEllipse(QPointF(), a, b);
     QTransform t;
     t.translate(x, y);
     t.rotateRadians(angle);
-    path = t.map(path);
-    painter->fillPainterPath(path);
+    return t.map(path);
 }
 
-void SprayBrush::paintRectangle(KisPainter* painter, qreal x, qreal y, qreal width, qreal height, qreal angle)
+QPainterPath SprayBrush::makeRectanglePath(qreal x, qreal y, qreal width, qreal height, qreal angle) const
 {
     QPainterPath path;
     path.addRect(QRectF(-0.5 * width, -0.5 * height, width, height));
     QTransform t;
     t.translate(x, y);
     t.rotateRadians(angle);
-    path = t.map(path);
-    painter->fillPainterPath(path);
+    return t.map(path);
+}
+
+void SprayBrush::paintCircle(KisPainter* painter, qreal x, qreal y, qreal radius)
+{
+    painter->fillPainterPath(makeCirclePath(x, y, radius));
+}
+
+
+void SprayBrush::paintEllipse(KisPainter* painter, qreal x, qreal y, qreal a, qreal b, qreal angle)
+{
+    painter->fillPainterPath(makeEllipsePath(x, y, a, b, angle));
+}
+
+void SprayBrush::paintRectangle(KisPainter* painter, qreal x, qreal y, qreal width, qreal height, qreal angle)
+{
+    painter->fillPainterPath(makeRectanglePath(x, y, width, height, angle));
 }
 
 
@@ -24,6 +24,7 @@
 
 
 #include <QImage>
+#include <QPainterPath>
 #include <kis_brush.h>
 
 class KisPaintInformation;
@@ -104,6 +105,10 @@ private:
     void paintEllipse(KisPainter * painter, qreal x, qreal y, qreal a, qreal b, qreal angle);
     void paintRectangle(KisPainter * painter, qreal x, qreal y, qreal width, qreal height, qreal angle);
 
+    QPainterPath makeCirclePath(qreal x, qreal y, qreal radius) const;
+    QPainterPath makeEllipsePath(qreal x, qreal y, qreal a, qreal b, qreal angle) const;
+    QPainterPath makeRectanglePath(qreal x, qreal y, qreal width, qreal height, qreal angle) const;
+
     void paintOutline(KisPaintDeviceSP dev, const KoColor& painterColor, qreal posX, qreal posY, qreal radius);
 
     /// mix a with b.b mix with weight and a with 1.0 - weight
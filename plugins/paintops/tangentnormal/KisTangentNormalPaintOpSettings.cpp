@@ -0,0 +1,17 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisTangentNormalPaintOpSettings.h"
+
+KisTangentNormalPaintOpSettings::KisTangentNormalPaintOpSettings(KisResourcesInterfaceSP resourcesInterface)
+    : KisBrushBasedPaintOpSettings(resourcesInterface)
+{
+}
+
+bool KisTangentNormalPaintOpSettings::needsAsynchronousUpdates() const
+{
+    return true;
+}
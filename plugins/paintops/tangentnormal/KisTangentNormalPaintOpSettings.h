@@ -0,0 +1,26 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita contributors
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISTANGENTNORMALPAINTOPSETTINGS_H
+#define KISTANGENTNORMALPAINTOPSETTINGS_H
+
+#include <kis_brush_based_paintop_settings.h>
+
+/**
+ * The settings of the tangent normal brush only differ from the
+ * generic brush-based ones in requesting asynchronous updates, which
+ * lets the engine render its dabs through the multithreaded dab
+ * rendering pipeline.
+ */
+class KisTangentNormalPaintOpSettings : public KisBrushBasedPaintOpSettings
+{
+public:
+    KisTangentNormalPaintOpSettings(KisResourcesInterfaceSP resourcesInterface);
+
+    bool needsAsynchronousUpdates() const override;
+};
+
+#endif // KISTANGENTNORMALPAINTOPSETTINGS_H
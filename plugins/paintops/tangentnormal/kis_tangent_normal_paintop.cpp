@@ -21,6 +21,23 @@
 #include <kis_lod_transform.h>
 #include <kis_paintop_plugin_utils.h>
 
+#include <KisDabRenderingUpdateHelper.h>
+#include <KisDabCacheUtils.h>
+#include <KisSharpnessOption.h>
+#include <KisRunnableStrokeJobData.h>
+
+namespace {
+
+struct TangentNormalOpResources : public KisDabCacheUtils::DabRenderingResources
+{
+    TangentNormalOpResources(const KisPaintOpSettingsSP settings)
+    {
+        sharpnessOption.reset(new KisSharpnessOption(settings.data()));
+    }
+};
+
+}
+
 
 KisTangentNormalPaintOp::KisTangentNormalPaintOp(const KisPaintOpSettingsSP settings, KisPainter* painter, KisNodeSP node, KisImageSP image)
     : KisBrushBasedPaintOp(settings, painter)
@@ -41,8 +58,43 @@ KisTangentNormalPaintOp::KisTangentNormalPaintOp(const KisPaintOpSettingsSP sett
     //Init, read settings, etc//
     m_airbrushData.read(settings.data());
 
-    m_dabCache->setSharpnessPostprocessing(&m_sharpnessOption);
     m_rotationOption.applyFanCornersInfo(this);
+
+    m_precisionOption.setHasImprecisePositionOptions(
+        m_precisionOption.hasImprecisePositionOptions()
+        || m_scatterOption.isChecked() || m_rotationOption.isChecked()
+        || m_airbrushData.isChecked);
+
+    /*
+     * For the color, the precision of tilt is only 60x60, and the precision of direction and rotation are 360 and 360*90.
+     * You can't get more precise than 8bit. Therefore, we will check if the current space is RGB,
+     * if so we request a profile with that space and 8bit bit depth, if not, just sRGB
+     */
+    const KoColor currentColor = painter->paintColor();
+    if (currentColor.colorSpace()->colorModelId().id() == "RGBA") {
+        m_dabColorSpace = currentColor.colorSpace();
+    } else {
+        m_dabColorSpace = KoColorSpaceRegistry::instance()->rgb8();
+    }
+
+    m_brush->notifyBrushIsGoingToBeClonedForStroke();
+
+    KisBrushSP baseBrush = m_brush;
+    auto resourcesFactory =
+        [baseBrush, settings] () {
+            KisDabCacheUtils::DabRenderingResources *resources =
+                new TangentNormalOpResources(settings);
+            resources->brush = baseBrush->clone().dynamicCast<KisBrush>();
+
+            return resources;
+        };
+
+    m_dabRenderingHelper.reset(
+        new KisDabRenderingUpdateHelper(m_dabColorSpace,
+                                        resourcesFactory,
+                                        painter->runnableStrokeJobsInterface(),
+                                        &m_mirrorOption,
+                                        &m_precisionOption));
 }
 
 KisTangentNormalPaintOp::~KisTangentNormalPaintOp()
@@ -52,22 +104,30 @@ KisTangentNormalPaintOp::~KisTangentNormalPaintOp()
 
 KisSpacingInformation KisTangentNormalPaintOp::paintAt(const KisPaintInformation& info)
 {
-    /*
-     * For the color, the precision of tilt is only 60x60, and the precision of direction and rotation are 360 and 360*90.
-     * You can't get more precise than 8bit. Therefore, we will check if the current space is RGB,
-     * if so we request a profile with that space and 8bit bit depth, if not, just sRGB
-     */
-    KoColor currentColor = painter()->paintColor();
-    QString currentSpace = currentColor.colorSpace()->colorModelId().id();
-    const KoColorSpace* rgbColorSpace = KoColorSpaceRegistry::instance()->rgb8();
-    if (currentSpace != "RGBA") {
-        rgbColorSpace = KoColorSpaceRegistry::instance()->rgb8();
-    } else {
-        rgbColorSpace = currentColor.colorSpace();
+    if (!painter()->device()) return KisSpacingInformation(1.0);
+
+    KisBrushSP brush = m_brush;
+
+    if (!brush || !brush->canPaintFor(info)) {
+        return KisSpacingInformation(1.0);
     }
+
+    qreal scale    = m_sizeOption.apply(info);
+    scale *= KisLodTransform::lodToScale(painter()->device());
+    qreal rotation = m_rotationOption.apply(info);
+    if (checkSizeTooSmall(scale)) return KisSpacingInformation();
+    KisDabShape shape(scale, 1.0, rotation);
+
+    QPointF cursorPos =
+            m_scatterOption.apply(info,
+                                  brush->maskWidth(shape, 0, 0, info),
+                                  brush->maskHeight(shape, 0, 0, info));
+
     QVector <float> channelValues(4);
     qreal r, g, b;
 
+    const KoColor currentColor = painter()->paintColor();
+
     if (currentColor.colorSpace()->colorDepthId().id()=="F16" || currentColor.colorSpace()->colorDepthId().id()=="F32"){
         channelValues[0] = 0.5;//red
         channelValues[1] = 0.5;//green
@@ -94,57 +154,32 @@ KisSpacingInformation KisTangentNormalPaintOp::paintAt(const KisPaintInformation
     }
 
     quint8 data[MAX_PIXEL_SIZE];
-    rgbColorSpace->fromNormalisedChannelsValue(data, channelValues);
-    KoColor color(data, rgbColorSpace);//Should be default RGB(0.5,0.5,1.0)
-    //draw stuff here, return kisspacinginformation.
-    KisBrushSP brush = m_brush;
+    m_dabColorSpace->fromNormalisedChannelsValue(data, channelValues);
+    KoColor color(data, m_dabColorSpace);//Should be default RGB(0.5,0.5,1.0)
 
-    if (!painter()->device() || !brush || !brush->canPaintFor(info)) {
-        return KisSpacingInformation(1.0);
-    }
-
-    qreal scale    = m_sizeOption.apply(info);
-    scale *= KisLodTransform::lodToScale(painter()->device());
-    qreal rotation = m_rotationOption.apply(info);
-    if (checkSizeTooSmall(scale)) return KisSpacingInformation();
-    KisDabShape shape(scale, 1.0, rotation);
+    qreal dabOpacity = OPACITY_OPAQUE_F;
+    qreal dabFlow = OPACITY_OPAQUE_F;
 
+    m_opacityOption.apply(info, &dabOpacity, &dabFlow);
 
-    QPointF cursorPos =
-            m_scatterOption.apply(info,
-                                  brush->maskWidth(shape, 0, 0, info),
-                                  brush->maskHeight(shape, 0, 0, info));
+    KisDabCacheUtils::DabRequestInfo request(color,
+                                             cursorPos,
+                                             shape,
+                                             info,
+                                             m_softnessOption.apply(info));
 
-    m_maskDab =
-            m_dabCache->fetchDab(rgbColorSpace, color, cursorPos,
-                                 shape,
-                                 info, m_softnessOption.apply(info),
-                                 &m_dstDabRect);
+    m_dabRenderingHelper->addDab(request, dabOpacity, dabFlow);
 
-    if (m_dstDabRect.isEmpty()) return KisSpacingInformation(1.0);
+    KisSpacingInformation spacingInfo = computeSpacing(info, scale, rotation);
 
-    QRect dabRect = m_maskDab->bounds();
+    m_dabRenderingHelper->notifyDabSpacing(spacingInfo.scalarApprox());
 
-    // sanity check
-    Q_ASSERT(m_dstDabRect.size() == dabRect.size());
-    Q_UNUSED(dabRect);
-
-    qreal  oldOpacityF = painter()->opacityF();
-    QString oldCompositeOpId = painter()->compositeOpId();
-
-
-    m_opacityOption.apply(painter(), info);
-    //paint with the default color? Copied this from color smudge.//
-    //painter()->setCompositeOp(COMPOSITE_COPY);
-    //painter()->fill(0, 0, m_dstDabRect.width(), m_dstDabRect.height(), color);
-    painter()->bltFixed(m_dstDabRect.topLeft(), m_maskDab, m_maskDab->bounds());
-    painter()->renderMirrorMaskSafe(m_dstDabRect, m_maskDab, !m_dabCache->needSeparateOriginal());
-
-    // restore original opacity and composite mode values
-    painter()->setOpacityF(oldOpacityF);
-    painter()->setCompositeOpId(oldCompositeOpId);
+    return spacingInfo;
+}
 
-    return computeSpacing(info, scale, rotation);
+std::pair<int, bool> KisTangentNormalPaintOp::doAsynchronousUpdate(QVector<KisRunnableStrokeJobData *> &jobs)
+{
+    return m_dabRenderingHelper->doAsynchronousUpdate(painter(), jobs);
 }
 
 KisSpacingInformation KisTangentNormalPaintOp::updateSpacingImpl(const KisPaintInformation &info) const
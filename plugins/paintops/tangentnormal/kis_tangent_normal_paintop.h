@@ -8,6 +8,7 @@
 #define _KIS_TANGENTNORMALPAINTOP_H_
 
 #include <QRect>
+#include <QScopedPointer>
 
 #include <kis_brush_based_paintop.h>
 #include <kis_types.h>
@@ -23,8 +24,11 @@
 #include <KisRotationOption.h>
 #include <KisAirbrushOptionData.h>
 
+class KoColorSpace;
 class KisBrushBasedPaintOpSettings;
 class KisPainter;
+class KisDabRenderingUpdateHelper;
+class KisRunnableStrokeJobData;
 
 class KisTangentNormalPaintOp: public KisBrushBasedPaintOp
 {
@@ -36,6 +40,7 @@ public:
     ~KisTangentNormalPaintOp() override;
 
     void paintLine(const KisPaintInformation &pi1, const KisPaintInformation &pi2, KisDistanceInformation *currentDistance) override;
+    std::pair<int, bool> doAsynchronousUpdate(QVector<KisRunnableStrokeJobData *> &jobs) override;
 
 protected:
     /*paint the dabs*/
@@ -64,10 +69,11 @@ private:
     KisAirbrushOptionData m_airbrushData;
     KisRateOption m_rateOption;
 
-    KisFixedPaintDeviceSP m_maskDab;
     KisPaintDeviceSP m_tempDev;
-    QRect m_dstDabRect;
 
     KisPaintDeviceSP m_lineCacheDevice;
+
+    const KoColorSpace *m_dabColorSpace {nullptr};
+    QScopedPointer<KisDabRenderingUpdateHelper> m_dabRenderingHelper;
 };
 #endif // _KIS_TANGENTNORMALPAINTOP_H_
@@ -16,6 +16,7 @@
 
 #include "kis_tangent_normal_paintop.h"
 #include "kis_tangent_normal_paintop_settings_widget.h"
+#include "KisTangentNormalPaintOpSettings.h"
 #include "kis_simple_paintop_factory.h"
 
 #include "kis_global.h"
@@ -25,7 +26,7 @@ K_PLUGIN_FACTORY_WITH_JSON(TangentNormalPaintOpPluginFactory, "kritatangentnorma
 TangentNormalPaintOpPlugin::TangentNormalPaintOpPlugin(QObject* parent, const QVariantList&):
     QObject(parent)
 {
-    KisPaintOpRegistry::instance()->add(new KisSimplePaintOpFactory<KisTangentNormalPaintOp, KisBrushBasedPaintOpSettings, KisTangentNormalPaintOpSettingsWidget>(
+    KisPaintOpRegistry::instance()->add(new KisSimplePaintOpFactory<KisTangentNormalPaintOp, KisTangentNormalPaintOpSettings, KisTangentNormalPaintOpSettingsWidget>(
                                             "tangentnormal", i18n("Tangent Normal"), KisPaintOpFactory::categoryStable(), "krita-tangentnormal.png",
                                             QString(), QStringList(), 16)
                                        );
@@ -45,6 +45,7 @@
 #include <kis_cmb_composite.h>
 
 #include <processing/fill_processing_visitor.h>
+#include <floodfill/kis_gap_map_cache.h>
 #include <kis_command_utils.h>
 #include <kis_layer_utils.h>
 #include <krita_utils.h>
@@ -117,6 +118,7 @@ void KisToolFill::deactivate()
 {
     m_referencePaintDevice = nullptr;
     m_referenceNodeList = nullptr;
+    m_gapMapCache = nullptr;
     KisCanvas2 *kisCanvas = static_cast<KisCanvas2*>(canvas());
     KisCanvasResourceProvider *resourceProvider = kisCanvas->viewManager()->canvasResourceProvider();
     if (resourceProvider) {
@@ -329,6 +331,17 @@ void KisToolFill::beginFilling(const QPoint &seedPoint)
         m_referenceColor = referenceColor;
 
         m_fillMask = new KisSelection;
+
+        if (m_closeGap > 0) {
+            // The cache persists between fills, so that consecutive fills
+            // over the same lineart reuse the computed gap distances. It
+            // detects stale content and parameter changes by itself.
+            if (!m_gapMapCache) {
+                m_gapMapCache = new KisGapMapCache();
+            }
+        } else {
+            m_gapMapCache = nullptr;
+        }
     }
 
     m_dirtyRect.reset(new QRect);
@@ -392,6 +405,7 @@ void KisToolFill::addFillingOperation(const QVector<QPoint> &seedPoints)
         visitor->setFillThreshold(m_threshold);
         visitor->setOpacitySpread(m_opacitySpread);
         visitor->setCloseGap(m_closeGap);
+        visitor->setGapMapCache(m_gapMapCache);
         visitor->setUseSelectionAsBoundary(m_useSelectionAsBoundary);
         visitor->setAntiAlias(m_antiAlias);
         visitor->setSizeMod(m_sizemod);
@@ -131,6 +131,7 @@ private:
     ContinuousFillMode m_continuousFillMode {ContinuousFillMode_FillAnyRegion};
     
     KisSelectionSP m_fillMask;
+    KisGapMapCacheSP m_gapMapCache;
     QSharedPointer<KoColor> m_referenceColor;
     KisPaintDeviceSP m_referencePaintDevice;
     KisMergeLabeledLayersCommand::ReferenceNodeInfoListSP m_referenceNodeList;
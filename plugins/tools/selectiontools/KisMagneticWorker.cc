@@ -10,6 +10,8 @@
 #include <lazybrush/kis_lazy_fill_tools.h>
 #include <kis_algebra_2d.h>
 #include <kis_painter.h>
+#include <kis_sequential_iterator.h>
+#include <KoColorSpace.h>
 
 #include <QtCore>
 #include <QPolygon>
@@ -137,6 +139,7 @@ private:
 
 KisMagneticLazyTiles::KisMagneticLazyTiles(KisPaintDeviceSP dev)
 {
+    m_srcDev = dev;
     m_dev = KisPainter::convertToAlphaAsGray(dev);
     QSize s = dev->defaultBounds()->bounds().size();
     m_tileSize    = KritaUtils::optimalPatchSize();
@@ -155,8 +158,46 @@ KisMagneticLazyTiles::KisMagneticLazyTiles(KisPaintDeviceSP dev)
     m_radiusRecord = QVector<qreal>(m_tiles.size(), -1);
 }
 
+void KisMagneticLazyTiles::invalidate(const QRect &rect)
+{
+    QMutexLocker locker(&m_dirtyRegionLock);
+    m_dirtyRegion += rect;
+}
+
+void KisMagneticLazyTiles::refreshDirtyTiles()
+{
+    QRegion dirtyRegion;
+    {
+        QMutexLocker locker(&m_dirtyRegionLock);
+        std::swap(dirtyRegion, m_dirtyRegion);
+    }
+
+    if (dirtyRegion.isEmpty()) return;
+
+    const KoColorSpace *srcCS = m_srcDev->colorSpace();
+
+    for (const QRect &rect : dirtyRegion) {
+        // refresh the grayscale copy of the changed area...
+        KisSequentialConstIterator srcIt(m_srcDev, rect);
+        KisSequentialIterator dstIt(m_dev, rect);
+
+        while (srcIt.nextPixel() && dstIt.nextPixel()) {
+            *dstIt.rawData() = srcCS->intensity8(srcIt.rawDataConst());
+        }
+
+        // ...and drop the cached filter response of the affected tiles
+        for (int i = 0; i < m_tiles.size(); i++) {
+            if (m_tiles[i].intersects(rect)) {
+                m_radiusRecord[i] = -1;
+            }
+        }
+    }
+}
+
 void KisMagneticLazyTiles::filter(qreal radius, QRect &rect)
 {
+    refreshDirtyTiles();
+
     auto divide = [](QPoint p, QSize s){
                       return QPoint(p.x() / s.width(), p.y() / s.height());
                   };
@@ -182,6 +223,16 @@ KisMagneticWorker::KisMagneticWorker(const KisPaintDeviceSP &dev) :
     m_lazyTileFilter(dev)
 { }
 
+KisMagneticWorker::~KisMagneticWorker()
+{
+    delete m_graph;
+}
+
+void KisMagneticWorker::notifyRegionChanged(const QRect &rect)
+{
+    m_lazyTileFilter.invalidate(rect);
+}
+
 QVector<QPointF> KisMagneticWorker::computeEdge(int bounds, QPoint begin, QPoint end, qreal radius)
 {
     QRect rect;
@@ -192,6 +243,7 @@ QVector<QPointF> KisMagneticWorker::computeEdge(int bounds, QPoint begin, QPoint
     VertexDescriptor goal(end);
     VertexDescriptor start(begin);
 
+    delete m_graph;
     m_graph = new KisMagneticGraph(m_lazyTileFilter.device(), rect);
 
     // How many maps does it require?
@@ -7,22 +7,37 @@
 #ifndef KISMAGNETICWORKER_H
 #define KISMAGNETICWORKER_H
 
+#include <QMutex>
+#include <QRegion>
+
 #include <kis_paint_device.h>
 #include <kritaselectiontools_export.h>
 
 struct KisMagneticGraph;
 
+/**
+ * Caches the edge map of the device tile by tile. A tile is filtered
+ * lazily, the first time a path search touches it, and is kept until
+ * invalidate() reports a change underneath it, so dropping further
+ * anchors over the same area reuses the cached response.
+ */
 class KisMagneticLazyTiles {
 private:
+    void refreshDirtyTiles();
+
     QVector<QRect> m_tiles;
     QVector<qreal> m_radiusRecord;
     KisPaintDeviceSP m_dev;
+    KisPaintDeviceSP m_srcDev;
     QSize m_tileSize;
     int m_tilesPerRow;
+    QRegion m_dirtyRegion;
+    QMutex m_dirtyRegionLock;
 
 public:
     KisMagneticLazyTiles(KisPaintDeviceSP dev);
     void filter(qreal radius, QRect &rect);
+    void invalidate(const QRect &rect);
     inline KisPaintDeviceSP device(){ return m_dev; }
     inline QVector<QRect> tiles(){ return m_tiles; }
 };
@@ -30,8 +45,17 @@ public:
 class KRITASELECTIONTOOLS_EXPORT KisMagneticWorker {
 public:
     KisMagneticWorker(const KisPaintDeviceSP &dev);
+    ~KisMagneticWorker();
 
     QVector<QPointF> computeEdge(int bounds, QPoint start, QPoint end, qreal radius);
+
+    /**
+     * Marks the given region of the source device as changed, so the
+     * cached edge map is recomputed there on the next search. Safe to
+     * call while computeEdge() runs in another thread.
+     */
+    void notifyRegionChanged(const QRect &rect);
+
     void saveTheImage(vQPointF points);
     qreal intensity(QPoint pt);
 
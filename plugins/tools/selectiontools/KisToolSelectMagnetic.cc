@@ -11,6 +11,7 @@
 #include <QPainterPath>
 #include <QPushButton>
 #include <QVBoxLayout>
+#include <QtConcurrent>
 
 #include <kis_debug.h>
 #include <klocalizedstring.h>
@@ -51,7 +52,9 @@ KisToolSelectMagnetic::KisToolSelectMagnetic(KoCanvasBase *canvas)
                     i18n("Magnetic Selection"))
   , m_worker(nullptr)
   , m_mouseHoverCompressor(100, KisSignalCompressor::FIRST_ACTIVE)
-{ }
+{
+    connect(&m_edgeFutureWatcher, SIGNAL(finished()), this, SLOT(slotEdgeCalculated()));
+}
 
 void KisToolSelectMagnetic::keyPressEvent(QKeyEvent *event)
 {
@@ -185,6 +188,8 @@ void KisToolSelectMagnetic::keyReleaseEvent(QKeyEvent *event)
 
 vQPointF KisToolSelectMagnetic::computeEdgeWrapper(QPoint a, QPoint b)
 {
+    // the synchronous callers may not overlap with the background search
+    m_edgeFuture.waitForFinished();
     return m_worker->computeEdge(m_searchRadius, a, b, m_filterRadius);
 }
 
@@ -332,8 +337,50 @@ void KisToolSelectMagnetic::slotCalculateEdge()
     if(kisDistance(m_lastAnchor, current) < m_anchorGap)
         return;
 
-    vQPointF pointSet = computeEdgeWrapper(m_lastAnchor, current);
-    calculateCheckPoints(pointSet);
+    // the path search runs in the background; while a search is still
+    // running only the latest request is kept for the next run
+    m_pendingEdgeStart   = m_lastAnchor;
+    m_pendingEdgeEnd     = current;
+    m_edgeRequestPending = true;
+    startPendingEdgeSearch();
+}
+
+void KisToolSelectMagnetic::startPendingEdgeSearch()
+{
+    if (!m_edgeRequestPending || m_edgeFuture.isRunning())
+        return;
+
+    m_edgeRequestPending = false;
+    m_runningEdgeStart   = m_pendingEdgeStart;
+
+    KisMagneticWorker *worker = m_worker.data();
+    const int bounds   = m_searchRadius;
+    const QPoint start = m_pendingEdgeStart;
+    const QPoint end   = m_pendingEdgeEnd;
+    const qreal radius = m_filterRadius;
+
+    m_edgeFuture = QtConcurrent::run([worker, bounds, start, end, radius]() {
+        return worker->computeEdge(bounds, start, end, radius);
+    });
+    m_edgeFutureWatcher.setFuture(m_edgeFuture);
+}
+
+void KisToolSelectMagnetic::slotEdgeCalculated()
+{
+    // drop the result when the anchors changed while the search was running
+    if (isSelecting() && !m_complete && !m_anchorPoints.isEmpty() &&
+        m_runningEdgeStart == m_lastAnchor) {
+        calculateCheckPoints(m_edgeFuture.result());
+    }
+
+    startPendingEdgeSearch();
+}
+
+void KisToolSelectMagnetic::slotImageEdgeMapDirty(const QRect &rect)
+{
+    if (m_worker) {
+        m_worker->notifyRegionChanged(rect);
+    }
 }
 
 // release primary mouse button
@@ -669,7 +716,17 @@ void KisToolSelectMagnetic::updateContinuedMode()
 
 void KisToolSelectMagnetic::activate(const QSet<KoShape *> &shapes)
 {
-    m_worker.reset(new KisMagneticWorker(image()->projection()));
+    /**
+     * The edge map is kept per document: when the tool is re-activated
+     * on the same image the cached tiles are reused, and the dirty
+     * rects of the image invalidate them as the layers change.
+     */
+    if (!m_worker || m_workerImage != image()) {
+        m_worker.reset(new KisMagneticWorker(image()->projection()));
+        m_workerImage = image();
+    }
+    connect(image().data(), SIGNAL(sigImageUpdated(QRect)),
+            this, SLOT(slotImageEdgeMapDirty(QRect)), Qt::UniqueConnection);
     m_configGroup = KSharedConfig::openConfig()->group(toolId());
     connect(action("undo_polygon_selection"), SIGNAL(triggered()), SLOT(undoPoints()), Qt::UniqueConnection);
     connect(&m_mouseHoverCompressor, SIGNAL(timeout()), this, SLOT(slotCalculateEdge()));
@@ -681,6 +738,8 @@ void KisToolSelectMagnetic::deactivate()
     KisCanvas2 *kisCanvas = dynamic_cast<KisCanvas2 *>(canvas());
     KIS_ASSERT_RECOVER_RETURN(kisCanvas);
     kisCanvas->updateCanvas();
+    m_edgeRequestPending = false;
+    m_edgeFuture.waitForFinished();
     resetVariables();
     m_continuedMode = false;
     disconnect(action("undo_polygon_selection"), nullptr, this, nullptr);
@@ -8,6 +8,8 @@
 #define KIS_TOOL_SELECT_MAGNETIC_H_
 
 #include <QPoint>
+#include <QFuture>
+#include <QFutureWatcher>
 #include "KisSelectionToolFactoryBase.h"
 #include <kis_tool_select_base.h>
 #include <kis_signal_compressor.h>
@@ -52,6 +54,8 @@ public Q_SLOTS:
     void slotSetSearchRadius(int);
     void slotSetAnchorGap(int);
     void slotCalculateEdge();
+    void slotEdgeCalculated();
+    void slotImageEdgeMapDirty(const QRect &rect);
 
 protected:
     using KisToolSelectBase::m_widgetHelper;
@@ -66,6 +70,7 @@ private:
     void drawAnchors(QPainter &gc);
     void checkIfAnchorIsSelected(QPointF pt);
     vQPointF computeEdgeWrapper(QPoint a, QPoint b);
+    void startPendingEdgeSearch();
     void reEvaluatePoints();
     void calculateCheckPoints(vQPointF points);
     void deleteSelectedAnchor();
@@ -82,6 +87,12 @@ private:
     bool m_selected {false};
     bool m_finished {false};
     QScopedPointer<KisMagneticWorker> m_worker;
+    KisImageWSP m_workerImage;
+    QFuture<vQPointF> m_edgeFuture;
+    QFutureWatcher<vQPointF> m_edgeFutureWatcher;
+    QPoint m_pendingEdgeStart, m_pendingEdgeEnd;
+    QPoint m_runningEdgeStart;
+    bool m_edgeRequestPending {false};
     int m_threshold {70};
     int m_searchRadius {30};
     int m_selectedAnchor {0};
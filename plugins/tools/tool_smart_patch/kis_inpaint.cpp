@@ -19,6 +19,12 @@
 #include <random>
 #include <iostream>
 #include <functional>
+#include <memory>
+
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
 
 
 #include "kis_paint_device.h"
@@ -511,21 +517,100 @@ struct Vote_elem {
 };
 typedef boost::multi_array<Vote_elem, 2> Vote_type;
 
+namespace {
+
+//how many concurrent jobs are worth spawning for the given extent
+int numberOfBands(int extent, int minBandExtent)
+{
+    return qBound(1, extent / minBandExtent, QThread::idealThreadCount());
+}
+
+class InpaintBandTask : public QRunnable
+{
+public:
+    InpaintBandTask(std::function<void()> func, QSemaphore *doneSemaphore)
+        : m_func(std::move(func)),
+          m_doneSemaphore(doneSemaphore)
+    {
+        setAutoDelete(false);
+    }
+
+    void run() override
+    {
+        m_func();
+        m_doneSemaphore->release();
+    }
+
+private:
+    std::function<void()> m_func;
+    QSemaphore *m_doneSemaphore;
+};
+
+//runs the band jobs on the global thread pool, falling back to the
+//calling thread when the pool is saturated
+void runBands(std::vector<std::function<void()>> bands)
+{
+    QSemaphore doneSemaphore;
+    std::vector<std::unique_ptr<InpaintBandTask>> tasks;
+    tasks.reserve(bands.size());
+
+    for (auto& band : bands) {
+        tasks.emplace_back(new InpaintBandTask(std::move(band), &doneSemaphore));
+    }
+
+    for (auto& task : tasks) {
+        if (!QThreadPool::globalInstance()->tryStart(task.get())) {
+            task->run();
+        }
+    }
+
+    doneSemaphore.acquire(tasks.size());
+}
+
+}
+
 
 
 class NearestNeighborField : public KisShared
 {
 
 private:
-    template< typename T> T randomInt(T range)
+    //the generator of the calling band; rand() is not thread safe
+    std::minstd_rand rng;
+
+    template< typename T> T randomInt(std::minstd_rand& gen, T range)
+    {
+        return gen() % range;
+    }
+
+    //the minimal band height/width for which spawning a job pays off
+    static int minBandExtent(void)
     {
-        return rand() % range;
+        return 32;
     }
 
     //compute initial value of the distance term
     void initialize(void)
     {
-        for (int y = 0; y < imSize.height(); y++) {
+        std::vector<std::function<void()>> bands;
+        const int numBands = numberOfBands(imSize.height(), minBandExtent());
+
+        for (int band = 0; band < numBands; band++) {
+            const int yBegin = band * imSize.height() / numBands;
+            const int yEnd = (band + 1) * imSize.height() / numBands;
+            std::minstd_rand bandRng(rng());
+
+            bands.push_back([this, yBegin, yEnd, bandRng]() mutable {
+                initializeBand(yBegin, yEnd, bandRng);
+            });
+        }
+
+        runBands(std::move(bands));
+    }
+
+    void initializeBand(int yBegin, int yEnd, std::minstd_rand& gen)
+    {
+        for (int y = yBegin; y < yEnd; y++) {
             for (int x = 0; x < imSize.width(); x++) {
                 field[x][y].distance = distance(x, y, field[x][y].x, field[x][y].y);
 
@@ -533,8 +618,8 @@ private:
                 int iter = 0;
                 const int maxretry = 20;
                 while (field[x][y].distance == MAX_DIST && iter < maxretry) {
-                    field[x][y].x = randomInt(imSize.width() + 1);
-                    field[x][y].y = randomInt(imSize.height() + 1);
+                    field[x][y].x = randomInt(gen, imSize.width() + 1);
+                    field[x][y].y = randomInt(gen, imSize.height() + 1);
                     field[x][y].distance = distance(x, y, field[x][y].x, field[x][y].y);
                     iter++;
                 }
@@ -582,13 +667,26 @@ public:
 
     void randomize(void)
     {
-        for (int y = 0; y < imSize.height(); y++) {
-            for (int x = 0; x < imSize.width(); x++) {
-                field[x][y].x = randomInt(imSize.width() + 1);
-                field[x][y].y = randomInt(imSize.height() + 1);
-                field[x][y].distance = MAX_DIST;
-            }
+        std::vector<std::function<void()>> bands;
+        const int numBands = numberOfBands(imSize.height(), minBandExtent());
+
+        for (int band = 0; band < numBands; band++) {
+            const int yBegin = band * imSize.height() / numBands;
+            const int yEnd = (band + 1) * imSize.height() / numBands;
+            std::minstd_rand bandRng(rng());
+
+            bands.push_back([this, yBegin, yEnd, bandRng]() mutable {
+                for (int y = yBegin; y < yEnd; y++) {
+                    for (int x = 0; x < imSize.width(); x++) {
+                        field[x][y].x = randomInt(bandRng, imSize.width() + 1);
+                        field[x][y].y = randomInt(bandRng, imSize.height() + 1);
+                        field[x][y].distance = MAX_DIST;
+                    }
+                }
+            });
         }
+
+        runBands(std::move(bands));
         initialize();
     }
 
@@ -612,29 +710,59 @@ public:
     }
 
     //multi-pass NN-field minimization (see "PatchMatch" paper referenced above - page 4)
+    //
+    //the field is split into horizontal bands minimized concurrently;
+    //a band reads at most one row beyond its seams, so the bands run
+    //in two waves (even-indexed, then odd-indexed) to keep the serial
+    //in-band propagation race-free, and the candidates cross the seams
+    //on the next wave or iteration
     void minimize(int pass)
     {
-        int min_x = 0;
-        int min_y = 0;
-        int max_x = imSize.width() - 1;
-        int max_y = imSize.height() - 1;
+        const int numBands = numberOfBands(imSize.height(), minBandExtent());
 
         for (int i = 0; i < pass; i++) {
             //scanline order
-            for (int y = min_y; y < max_y; y++)
-                for (int x = min_x; x <= max_x; x++)
-                    if (field[x][y].distance > 0)
-                        minimizeLink(x, y, 1);
+            minimizeWave(numBands, 0, 1);
+            minimizeWave(numBands, 1, 1);
 
             //reverse scanline order
-            for (int y = max_y; y >= min_y; y--)
-                for (int x = max_x; x >= min_x; x--)
-                    if (field[x][y].distance > 0)
-                        minimizeLink(x, y, -1);
+            minimizeWave(numBands, 0, -1);
+            minimizeWave(numBands, 1, -1);
+        }
+    }
+
+    void minimizeWave(int numBands, int parity, int dir)
+    {
+        std::vector<std::function<void()>> bands;
+
+        for (int band = parity; band < numBands; band += 2) {
+            const int yBegin = band * imSize.height() / numBands;
+            const int yEnd = (band + 1) * imSize.height() / numBands;
+            std::minstd_rand bandRng(rng());
+
+            bands.push_back([this, yBegin, yEnd, dir, bandRng]() mutable {
+                if (dir > 0) {
+                    //as in the original serial code, the scanline order
+                    //pass skips the last row of the image
+                    const int yLast = std::min(yEnd, imSize.height() - 1);
+
+                    for (int y = yBegin; y < yLast; y++)
+                        for (int x = 0; x < imSize.width(); x++)
+                            if (field[x][y].distance > 0)
+                                minimizeLink(x, y, 1, bandRng);
+                } else {
+                    for (int y = yEnd - 1; y >= yBegin; y--)
+                        for (int x = imSize.width() - 1; x >= 0; x--)
+                            if (field[x][y].distance > 0)
+                                minimizeLink(x, y, -1, bandRng);
+                }
+            });
         }
+
+        runBands(std::move(bands));
     }
 
-    void minimizeLink(int x, int y, int dir)
+    void minimizeLink(int x, int y, int dir, std::minstd_rand& gen)
     {
         int xp, yp, dp;
 
@@ -667,8 +795,8 @@ public:
         int xpi = field[x][y].x;
         int ypi = field[x][y].y;
         while (wi > 0) {
-            xp = xpi + randomInt(2 * wi) - wi;
-            yp = ypi + randomInt(2 * wi) - wi;
+            xp = xpi + randomInt(gen, 2 * wi) - wi;
+            yp = ypi + randomInt(gen, 2 * wi) - wi;
             xp = std::max(0, std::min(output->size().width() - 1, xp));
             yp = std::max(0, std::min(output->size().height() - 1, yp));
 
@@ -747,6 +875,8 @@ public:
 
     static void ExpectationStep(KisSharedPtr<NearestNeighborField> nnf, MaskedImageSP source, MaskedImageSP target, bool upscale);
 
+    static void ExpectationStepBand(KisSharedPtr<NearestNeighborField> nnf, MaskedImageSP source, MaskedImageSP target, bool upscale, int R, int xBegin, int xEnd);
+
     void EM_Step(MaskedImageSP source, MaskedImageSP target, int R, bool upscaled);
 };
 typedef KisSharedPtr<NearestNeighborField> NearestNeighborFieldSP;
@@ -845,14 +975,33 @@ MaskedImageSP NearestNeighborField::ExpectationMaximization(NearestNeighborField
             newtarget = nullptr;
         }
 
-        for (int x = 0; x < target->size().width(); ++x) {
-            for (int y = 0; y < target->size().height(); ++y) {
-                if (!source->containsMasked(x, y, radius)) {
-                    nnf_TargetToSource->field[x][y].x = x;
-                    nnf_TargetToSource->field[x][y].y = y;
-                    nnf_TargetToSource->field[x][y].distance = 0;
-                }
+        {
+            //pin the pixels outside of the masked area to themselves;
+            //every column is independent here
+            const int W = target->size().width();
+            const int H = target->size().height();
+
+            std::vector<std::function<void()>> bands;
+            const int numBands = numberOfBands(W, 32);
+
+            for (int band = 0; band < numBands; band++) {
+                const int xBegin = band * W / numBands;
+                const int xEnd = (band + 1) * W / numBands;
+
+                bands.push_back([=]() {
+                    for (int x = xBegin; x < xEnd; ++x) {
+                        for (int y = 0; y < H; ++y) {
+                            if (!source->containsMasked(x, y, radius)) {
+                                nnf_TargetToSource->field[x][y].x = x;
+                                nnf_TargetToSource->field[x][y].y = y;
+                                nnf_TargetToSource->field[x][y].distance = 0;
+                            }
+                        }
+                    }
+                });
             }
+
+            runBands(std::move(bands));
         }
 
         //minimize the NNF
@@ -892,10 +1041,30 @@ void NearestNeighborField::ExpectationStep(NearestNeighborFieldSP nnf, MaskedIma
     if (upscale)
         R *= 2;
 
+    int W_target = target->size().width();
+
+    //every target pixel is voted for independently, so the columns are
+    //simply split across the cores
+    std::vector<std::function<void()>> bands;
+    const int numBands = numberOfBands(W_target, 32);
+
+    for (int band = 0; band < numBands; band++) {
+        const int xBegin = band * W_target / numBands;
+        const int xEnd = (band + 1) * W_target / numBands;
+
+        bands.push_back([=]() {
+            ExpectationStepBand(nnf, source, target, upscale, R, xBegin, xEnd);
+        });
+    }
+
+    runBands(std::move(bands));
+}
+
+void NearestNeighborField::ExpectationStepBand(NearestNeighborFieldSP nnf, MaskedImageSP source, MaskedImageSP target, bool upscale, int R, int xBegin, int xEnd)
+{
     int H_nnf = nnf->input->size().height();
     int W_nnf = nnf->input->size().width();
     int H_target = target->size().height();
-    int W_target = target->size().width();
     int H_source = source->size().height();
     int W_source = source->size().width();
 
@@ -903,7 +1072,7 @@ void NearestNeighborField::ExpectationStep(NearestNeighborFieldSP nnf, MaskedIma
     std::vector< float > weights;
     pixels.reserve(R * R);
     weights.reserve(R * R);
-    for (int x = 0 ; x < W_target ; ++x) {
+    for (int x = xBegin ; x < xEnd ; ++x) {
         for (int y = 0 ; y < H_target; ++y) {
             float wsum = 0;
             pixels.clear();
@@ -23,6 +23,18 @@ struct KisCageTransformStrategy::Private
     }
 
     KisCageTransformStrategy * const q;
+
+    /**
+     * The worker is kept between the preview frames of a drag: the
+     * expensive green coordinates precalculation depends only on the
+     * source image and the original cage, while dragging only moves
+     * the transformed cage points.
+     */
+    QScopedPointer<KisCageTransformWorker> worker;
+    qint64 workerImageCacheKey {0};
+    QPointF workerSrcOffset;
+    QVector<QPointF> workerOrigPoints;
+    int workerPixelPrecision {0};
 };
 
 
@@ -79,12 +91,27 @@ QImage KisCageTransformStrategy::calculateTransformedImage(ToolTransformArgs &cu
                                                            const QPointF &srcOffset,
                                                            QPointF *dstOffset)
 {
-    KisCageTransformWorker worker(srcImage,
-                                  srcOffset,
-                                  origPoints,
-                                  0,
-                                  currentArgs.previewPixelPrecision());
-    worker.prepareTransform();
-    worker.setTransformedCage(transfPoints);
-    return worker.runOnQImage(dstOffset);
+    const int pixelPrecision = currentArgs.previewPixelPrecision();
+
+    if (!m_d->worker ||
+        m_d->workerImageCacheKey != srcImage.cacheKey() ||
+        m_d->workerSrcOffset != srcOffset ||
+        m_d->workerOrigPoints != origPoints ||
+        m_d->workerPixelPrecision != pixelPrecision) {
+
+        m_d->worker.reset(new KisCageTransformWorker(srcImage,
+                                                     srcOffset,
+                                                     origPoints,
+                                                     0,
+                                                     pixelPrecision));
+        m_d->worker->prepareTransform();
+
+        m_d->workerImageCacheKey = srcImage.cacheKey();
+        m_d->workerSrcOffset = srcOffset;
+        m_d->workerOrigPoints = origPoints;
+        m_d->workerPixelPrecision = pixelPrecision;
+    }
+
+    m_d->worker->setTransformedCage(transfPoints);
+    return m_d->worker->runOnQImage(dstOffset);
 }